@@ -1,33 +1,51 @@
 const express = require('express');
-const { exec } = require('child_process');
+const http = require('http');
+const path = require('path');
+
+// 실행 중인 Youth 의 포인트 클라우드 스트리밍 서버 (./Youth --stream [port])
+const STREAM_URL = process.env.YOUTH_STREAM_URL || 'http://127.0.0.1:8090';
 
 const app = express();
-app.use(express.static('public')); // public 폴더를 정적 파일 경로로 설정
+app.use(express.static(path.join(__dirname, '../../FrontEnd/public'))); // FrontEnd/public 을 정적 파일 경로로 설정
 
-app.get('/pointcloud', (req, res) => {
-    exec('../build/Release/Youth', (error, stdout, stderr) => {
-        if (error) {
-            console.error(`Error executing C++ code: ${error.message}`);
-            return res.status(500).send('Error executing C++ code');
-        }
-        if (stderr) {
-            console.error(`stderr: ${stderr}`);
-            return res.status(500).send('Error in C++ code');
+// 바이너리 프레임을 그대로 중계 (파싱 / 재인코딩 없음)
+function proxyBinary(upstreamPath, req, res) {
+    const upstream = http.get(STREAM_URL + upstreamPath, (upstreamRes) => {
+        res.status(upstreamRes.statusCode);
+        res.set({
+            'Content-Type': 'application/octet-stream',
+            'Cache-Control': 'no-cache',
+        });
+        if (upstreamRes.headers['content-length']) {
+            res.set('Content-Length', upstreamRes.headers['content-length']);
         }
-        
-        // JSON 데이터 출력
-        console.log('JSON Data:', stdout);
-        
-        try {
-            const pointCloudData = JSON.parse(stdout);
-            res.json(pointCloudData);
-        } catch (parseError) {
-            console.error('Failed to parse JSON:', parseError);
-            res.status(500).send('Failed to parse JSON');
+        res.flushHeaders();
+        upstreamRes.pipe(res);
+    });
+
+    upstream.on('error', (error) => {
+        console.error(`Point cloud stream unavailable: ${error.message}`);
+        if (!res.headersSent) {
+            res.status(502).send('Point cloud stream unavailable');
+        } else {
+            res.end();
         }
     });
+
+    // 브라우저가 끊으면 업스트림 연결도 닫음
+    res.on('close', () => upstream.destroy());
+}
+
+// 연속 프레임 스트림 (?format=xyz16 등 쿼리는 그대로 전달)
+app.get('/stream', (req, res) => {
+    const query = req.originalUrl.indexOf('?');
+    proxyBinary('/stream' + (query >= 0 ? req.originalUrl.slice(query) : ''), req, res);
 });
 
+// 최신 프레임 하나
+app.get('/pointcloud', (req, res) => proxyBinary('/frame', req, res));
+
 app.listen(3000, () => {
     console.log('Server is running on http://localhost:3000');
+    console.log(`Streaming from ${STREAM_URL}`);
 });
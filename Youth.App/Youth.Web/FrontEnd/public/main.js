@@ -1,13 +1,12 @@
-async function fetchPointCloudData() {
-    console.log('Requesting point cloud data...');
-    const response = await fetch('/pointcloud');
-    const data = await response.json();
-    
-    // 받은 데이터 출력
-    console.log('Received Point Cloud Data:', data);
-    
-    return data;
-}
+// 포인트 프레임 형식 (Youth.Source/StreamingModule/streamingModule.h, streamCodec.h, little-endian)
+// 헤더 32 바이트: magic, version(u16), format(u16), frameId, timestamp, pointCount, scale(f32), payloadBytes, reserved
+// 격자 형식 페이로드: fx, fy, cx, cy (f32) + 격자 프레임 (헤더 24 바이트, runs, 깊이 varint, RGB565)
+const FRAME_MAGIC = 0x31435059;
+const FRAME_HEADER_BYTES = 32;
+const FORMAT_GRID_DELTA = 2;
+const GRID_INFO_BYTES = 16;
+const GRID_HEADER_BYTES = 24;
+const GRID_FRAME_KEY = 0x1;
 
 const scene = new THREE.Scene();
 const camera = new THREE.PerspectiveCamera(75, window.innerWidth / window.innerHeight, 0.1, 1000);
@@ -15,37 +14,259 @@ const renderer = new THREE.WebGLRenderer();
 renderer.setSize(window.innerWidth, window.innerHeight);
 document.body.appendChild(renderer.domElement);
 
-camera.position.z = 5;
+camera.position.z = 0.5;
+
+// 격자 상태 (디코더 기준 프레임), 좌표는 셰이더가 광선 * 깊이로 복원
+const grid = {
+    width: 0,
+    height: 0,
+    fx: 0, fy: 0, cx: 0, cy: 0,
+    depth: null,    // Uint16Array, 0 은 무효
+    color: null,    // Uint8Array RGB
+};
+
+const geometry = new THREE.BufferGeometry();
+const material = new THREE.ShaderMaterial({
+    uniforms: {
+        depthScale: { value: 0.001 },
+        pointSize: { value: 3.0 },
+    },
+    vertexShader: `
+        uniform float depthScale;
+        uniform float pointSize;
+        attribute float depth;
+        attribute vec3 rgb;
+        varying vec3 vColor;
+        void main() {
+            vColor = rgb;
+            if (depth == 0.0) {
+                gl_Position = vec4(2.0, 2.0, 2.0, 1.0); // 클립 공간 밖 (무효 픽셀)
+                gl_PointSize = 0.0;
+                return;
+            }
+            // 카메라 좌표 (x 오른쪽, y 아래, z 앞) -> three.js (y 위, -z 앞)
+            float z = depth * depthScale;
+            vec4 mvPosition = modelViewMatrix * vec4(position.x * z, -position.y * z, -z, 1.0);
+            gl_Position = projectionMatrix * mvPosition;
+            gl_PointSize = max(1.0, pointSize / -mvPosition.z);
+        }`,
+    fragmentShader: `
+        varying vec3 vColor;
+        void main() {
+            gl_FragColor = vec4(vColor, 1.0);
+        }`,
+});
+const pointCloud = new THREE.Points(geometry, material);
+pointCloud.frustumCulled = false;
+scene.add(pointCloud);
+
+// 격자 크기나 내부 파라미터가 바뀌면 광선 / 깊이 / 색상 버퍼 재생성
+function resetGrid(width, height, fx, fy, cx, cy) {
+    const rays = new Float32Array(width * height * 3);
+    for (let v = 0, i = 0; v < height; v++) {
+        for (let u = 0; u < width; u++, i += 3) {
+            rays[i] = (u - cx) / fx;
+            rays[i + 1] = (v - cy) / fy;
+            rays[i + 2] = 1.0;
+        }
+    }
+
+    Object.assign(grid, { width, height, fx, fy, cx, cy });
+    grid.depth = new Uint16Array(width * height);
+    grid.color = new Uint8Array(width * height * 3);
+
+    geometry.setAttribute('position', new THREE.BufferAttribute(rays, 3));
+    geometry.setAttribute('depth', new THREE.BufferAttribute(grid.depth, 1).setUsage(THREE.DynamicDrawUsage));
+    geometry.setAttribute('rgb', new THREE.BufferAttribute(grid.color, 3, true).setUsage(THREE.DynamicDrawUsage));
+}
+
+// varint 읽기 (cursor 는 [offset] 배열, 읽은 만큼 전진)
+function readVarint(bytes, cursor) {
+    let value = 0;
+    let shift = 0;
+    for (;;) {
+        const byte = bytes[cursor[0]++];
+        value += (byte & 0x7f) * 2 ** shift;
+        if (byte < 0x80) {
+            return value;
+        }
+        shift += 7;
+    }
+}
+
+// 격자 프레임 적용 (streamCodec.c decodeGridFrame 과 같은 동작)
+// 바뀐 픽셀만 깊이 / 색상 배열을 갱신하고 GPU 로는 두 배열만 다시 올림
+function applyGridFrame(bytes, view, offset, header) {
+    const fx = view.getFloat32(offset, true);
+    const fy = view.getFloat32(offset + 4, true);
+    const cx = view.getFloat32(offset + 8, true);
+    const cy = view.getFloat32(offset + 12, true);
+    offset += GRID_INFO_BYTES;
+
+    const width = view.getUint16(offset, true);
+    const height = view.getUint16(offset + 2, true);
+    const flags = view.getUint16(offset + 4, true);
+    const runBytes = view.getUint32(offset + 12, true);
+    const depthBytes = view.getUint32(offset + 16, true);
 
-async function createPointCloud() {
-    const data = await fetchPointCloudData();
+    if (flags & GRID_FRAME_KEY) {
+        if (width !== grid.width || height !== grid.height || fx !== grid.fx || fy !== grid.fy ||
+            cx !== grid.cx || cy !== grid.cy) {
+            resetGrid(width, height, fx, fy, cx, cy);
+        } else {
+            grid.depth.fill(0);
+            grid.color.fill(0);
+        }
+    } else if (width !== grid.width || height !== grid.height) {
+        return false; // 키 프레임을 기다림
+    }
+
+    const runCursor = [offset + GRID_HEADER_BYTES];
+    const runEnd = runCursor[0] + runBytes;
+    const depthCursor = [runEnd];
+    let colorOffset = runEnd + depthBytes;
 
-    if (!data || data.length === 0) {
-        console.error("No data received from server");
-        return;
+    const depth = grid.depth;
+    const color = grid.color;
+    const pixels = width * height;
+    let i = 0;
+    let changed = false;
+    let lastDepth = 0;
+    while (i < pixels && runCursor[0] < runEnd) {
+        const run = readVarint(bytes, runCursor);
+        if (!changed) {
+            i += run;
+        } else {
+            for (const end = i + run; i < end; i++) {
+                const token = readVarint(bytes, depthCursor);
+                const zigzag = token >>> 1;
+                const residual = (zigzag >>> 1) ^ -(zigzag & 1);
+                const d = (depth[i] !== 0 ? depth[i] : lastDepth) + residual;
+                depth[i] = d;
+                if (d !== 0) {
+                    lastDepth = d;
+                }
+                if (token & 1) {
+                    const c = bytes[colorOffset] | (bytes[colorOffset + 1] << 8);
+                    colorOffset += 2;
+                    color[i * 3] = ((c >> 11) * 527 + 23) >> 6;
+                    color[i * 3 + 1] = (((c >> 5) & 63) * 259 + 33) >> 6;
+                    color[i * 3 + 2] = ((c & 31) * 527 + 23) >> 6;
+                }
+            }
+        }
+        changed = !changed;
     }
 
-    console.log("Point Cloud Data: ", data);  // 데이터를 확인하기 위한 로그
+    material.uniforms.depthScale.value = header.scale;
+    geometry.attributes.depth.needsUpdate = true;
+    geometry.attributes.rgb.needsUpdate = true;
+    return true;
+}
 
-    const geometry = new THREE.BufferGeometry();
-    const positions = new Float32Array(data.length * 3);
+function readHeader(view, offset) {
+    return {
+        magic: view.getUint32(offset, true),
+        version: view.getUint16(offset + 4, true),
+        format: view.getUint16(offset + 6, true),
+        frameId: view.getUint32(offset + 8, true),
+        timestamp: view.getUint32(offset + 12, true),
+        pointCount: view.getUint32(offset + 16, true),
+        scale: view.getFloat32(offset + 20, true),
+        payloadBytes: view.getUint32(offset + 24, true),
+    };
+}
 
-    for (let i = 0; i < data.length; i++) {
-        const point = data[i];
-        positions[i * 3] = point.x;
-        positions[i * 3 + 1] = point.y;
-        positions[i * 3 + 2] = point.z;
+// 스트림 수신: HTTP 청크 경계와 상관없이 바이트를 모아 헤더의 payloadBytes 로 프레임을 자름
+// 델타 프레임은 앞 프레임 위에 쌓이므로 도착한 프레임을 모두 순서대로 적용
+async function streamPointCloud() {
+    // 페이지 주소의 쿼리 (?level=1 이면 1/4 포인트) 를 그대로 스트림 요청에 붙임
+    const response = await fetch('/stream' + window.location.search);
+    if (!response.ok || !response.body) {
+        throw new Error(`Stream request failed: ${response.status}`);
     }
 
-    geometry.setAttribute('position', new THREE.BufferAttribute(positions, 3));
+    const reader = response.body.getReader();
+    let chunks = [];
+    let buffered = 0;
+    let needed = FRAME_HEADER_BYTES; // 다음 프레임을 자르는 데 필요한 바이트 수 (그 전에는 합치지 않음)
+    let frames = 0;
+    let bytesReceived = 0;
+    let lastReport = performance.now();
+
+    for (;;) {
+        const { value, done } = await reader.read();
+        if (done) {
+            break;
+        }
+
+        chunks.push(value);
+        buffered += value.length;
+        bytesReceived += value.length;
+        if (buffered < needed) {
+            continue;
+        }
+
+        const merged = new Uint8Array(buffered);
+        let position = 0;
+        for (const chunk of chunks) {
+            merged.set(chunk, position);
+            position += chunk.length;
+        }
 
-    const material = new THREE.PointsMaterial({ color: 0xffffff, size: 0.05 });
-    const pointCloud = new THREE.Points(geometry, material);
+        const view = new DataView(merged.buffer);
+        let offset = 0;
+        needed = FRAME_HEADER_BYTES;
+        while (merged.length - offset >= FRAME_HEADER_BYTES) {
+            const header = readHeader(view, offset);
+            if (header.magic !== FRAME_MAGIC || header.format !== FORMAT_GRID_DELTA) {
+                throw new Error('Invalid point frame');
+            }
+            const frameBytes = FRAME_HEADER_BYTES + header.payloadBytes;
+            if (merged.length - offset < frameBytes) {
+                needed = frameBytes;
+                break;
+            }
+            applyGridFrame(merged, view, offset + FRAME_HEADER_BYTES, header);
+            offset += frameBytes;
+            frames++;
+        }
 
-    scene.add(pointCloud);
+        const rest = merged.subarray(offset);
+        chunks = rest.length ? [rest] : [];
+        buffered = rest.length;
+
+        const now = performance.now();
+        if (now - lastReport > 1000) {
+            const seconds = (now - lastReport) / 1000;
+            document.title = `3D Point Cloud Viewer - ${(frames / seconds).toFixed(1)} fps, ` +
+                `${(bytesReceived / 1024 / Math.max(frames, 1)).toFixed(1)} KB/frame`;
+            frames = 0;
+            bytesReceived = 0;
+            lastReport = now;
+        }
+    }
+}
+
+// 연결이 끊기면 1 초 뒤 재접속 (서버가 새 연결에 키 프레임부터 보냄)
+async function connect() {
+    for (;;) {
+        try {
+            await streamPointCloud();
+        } catch (error) {
+            console.error('Point cloud stream error:', error);
+        }
+        await new Promise((resolve) => setTimeout(resolve, 1000));
+    }
 }
 
-createPointCloud();
+connect();
+
+window.addEventListener('resize', () => {
+    camera.aspect = window.innerWidth / window.innerHeight;
+    camera.updateProjectionMatrix();
+    renderer.setSize(window.innerWidth, window.innerHeight);
+});
 
 function animate() {
     requestAnimationFrame(animate);
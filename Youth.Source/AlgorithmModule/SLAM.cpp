@@ -1,8 +1,18 @@
 #include "SLAM.h"
+#include "icpOdometry.h"
+#include "pointCloudExporter.h"
+#include "tsdfFusion.h"
+#include "../KernelModule/kernelModule.h"
+#include "../MonitorModule/monitorModule.h"
+#include <cmath>
 #include <iostream>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
 #include <queue>
+#include <map>
 #include <memory>
 #include <opencv2/opencv.hpp>
 
@@ -10,121 +20,491 @@
 #include <System.h>
 #include <Tracking.h>
 #include <MapPoint.h>
+#include <KeyFrame.h>
 
-// SLAM 시스템 변수
-static std::shared_ptr<ORB_SLAM3::System> slam_system = nullptr;
-static std::mutex slam_mutex;
-static bool slam_running = false;
-static std::thread processing_thread;
-
-// 프레임 큐와 관련 변수
+// 프레임 큐 항목
 struct FrameData{
   cv::Mat depth;
   cv::Mat rgb;
   double timestamp;
+  cv::Mat depth_raw; // 덴스 맵 저장용 원본 16비트 깊이
+};
+
+// 락스텝 모드 (평가용: 프레임을 버리지 않고 추적이 끝날 때까지 생산자를 대기시킴)
+static const size_t kLockstepQueueDepth = 2;
+
+// 덴스 키프레임 기본 최대 개수 (VGA 깊이 + 색상이 키프레임당 약 1.5 MB 이므로 약 380 MB)
+static const size_t kDefaultMaxDenseKeyFrames = 256;
+
+// 덴스 키프레임 + 기준 ORB 키프레임
+// 저장할 때 가장 최근 ORB 키프레임에 대한 상대 자세를 기록해 두고, 내보낼 때 그 키프레임의 현재 자세
+// (루프 폐쇄 / 전역 BA 로 최적화된 값) 에 곱해 덴스 키프레임 자세를 다시 계산
+struct DenseKeyFrameEntry{
+  std::shared_ptr<const DenseKeyFrame> frame;
+  long anchor_id = -1;          // ORB 키프레임 mnId (-1 이면 없음, 저장된 자세 사용)
+  float anchor_to_frame[16];    // 기준 키프레임 -> 덴스 키프레임 (column-major)
+};
+
+// 통계 스냅샷 (추적 스레드가 기록, 임의의 스레드가 락 없이 읽음)
+// seqlock: 기록 중에는 sequence 가 홀수이며 읽는 쪽은 짝수이고 변하지 않은 값을 얻을 때까지 재시도
+struct SlamStatsSnapshot{
+  std::atomic<uint32_t> sequence{0};
+  std::atomic<int> trackingState{-1};
+  std::atomic<float> trackTimeMs{0.0f};
+  std::atomic<int> numFeatures{0};
+  std::atomic<int> numKeyFrames{0};
+  std::atomic<int> numMapPoints{0};
+  std::atomic<int> queueDepth{0};
+  std::atomic<uint32_t> frameCount{0};
+  std::atomic<double> timestamp{0.0};
 };
 
-static std::queue<FrameData> frame_queue;
-static std::mutex queue_mutex;
-static bool process_frames = true;
+// TSDF 융합 프레임 (최신 프레임만 유지하는 단일 슬롯 메일박스)
+struct FusionFrame{
+  cv::Mat depth_raw;
+  cv::Mat rgb;
+  float Twc[16];
+};
+
+// SLAM 인스턴스 하나의 상태 (ORB-SLAM3 시스템, 프레임 큐, 덴스 맵, TSDF, ICP)
+// 파이프라인마다 하나씩 만들면 한 프로세스에서 여러 SLAM 이 서로 독립적으로 동작
+struct SlamContext{
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  // SLAM 시스템 변수
+  std::shared_ptr<ORB_SLAM3::System> slam_system;
+  std::mutex slam_mutex;
+  bool slam_running = false;
+  std::thread processing_thread;
+
+  // 프레임 큐와 관련 변수
+  std::queue<FrameData> frame_queue;
+  std::mutex queue_mutex;
+  std::condition_variable queue_cv;
+  bool process_frames = true;
+  std::atomic<int> frame_queue_depth{0};
+
+  // 락스텝 모드
+  bool lockstep_mode = false;
+
+  // 시각화 (Pangolin 뷰어) 사용 여부
+  bool slam_visualization = true;
+
+  // 포즈 콜백
+  SlamPoseCallback pose_callback = nullptr;
+  void* pose_callback_user = nullptr;
+
+  SlamStatsSnapshot slam_stats;
+
+  // 덴스 맵 내보내기용 키프레임 저장소
+  std::vector<DenseKeyFrameEntry> dense_keyframes;
+  std::mutex dense_mutex;
+  size_t max_dense_keyframes = kDefaultMaxDenseKeyFrames;
+  DenseCameraIntrinsics dense_intrinsics;
+  DenseExportOptions dense_options;
+  float dense_keyframe_distance = 0.1f;  // 덴스 키프레임 저장 기준 이동 거리 (m)
+  float dense_keyframe_angle = 10.0f;    // 덴스 키프레임 저장 기준 회전 각도 (deg)
+  bool has_last_dense_pose = false;
+  Eigen::Matrix4f last_dense_pose;
+
+  // TSDF 융합
+  std::unique_ptr<TsdfVolume> tsdf_volume;
+  std::mutex tsdf_mutex;             // tsdf_volume 접근 보호 (통합 / 메쉬 추출)
+  std::thread fusion_thread;
+  std::mutex fusion_mutex;
+  std::condition_variable fusion_cv;
+  FusionFrame fusion_frame;
+  bool fusion_pending = false;
+  bool fusion_running = false;
+
+  // ICP 오도메트리 폴백 (ORB 추적 실패 시 깊이만으로 자세 추정, slam_mutex 로 보호)
+  std::unique_ptr<IcpOdometry> icp_odometry;
+  uint32_t icp_fallback_frames = 0;
+  bool icp_fallback_failed = false;   // 마지막 ICP 추적 실패 여부 (상태가 바뀔 때만 로그 출력)
+};
+
+static void publishSlamStats(SlamContext* s, int state, float track_ms, int features, int keyframes, int mappoints,
+                             double timestamp){
+  uint32_t seq = s->slam_stats.sequence.load(std::memory_order_relaxed);
+  s->slam_stats.sequence.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  s->slam_stats.trackingState.store(state, std::memory_order_relaxed);
+  s->slam_stats.trackTimeMs.store(track_ms, std::memory_order_relaxed);
+  s->slam_stats.numFeatures.store(features, std::memory_order_relaxed);
+  s->slam_stats.numKeyFrames.store(keyframes, std::memory_order_relaxed);
+  s->slam_stats.numMapPoints.store(mappoints, std::memory_order_relaxed);
+  s->slam_stats.queueDepth.store(s->frame_queue_depth.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  s->slam_stats.frameCount.store(s->slam_stats.frameCount.load(std::memory_order_relaxed) + 1,
+                                 std::memory_order_relaxed);
+  s->slam_stats.timestamp.store(timestamp, std::memory_order_relaxed);
+
+  s->slam_stats.sequence.store(seq + 2, std::memory_order_release);
+
+  // 뷰어 HUD 용 공유 카운터
+  monitorSetSlam(state, track_ms);
+}
+
+// 설정 파일에서 카메라 내부 파라미터 읽기
+static void loadDenseIntrinsics(SlamContext* s, const char* config_file){
+  CameraIntrinsics K;
+  setDefaultCameraIntrinsics(&K, 640, 480);
+  if(!loadCameraIntrinsics(config_file, &K)){
+    std::cerr << "Failed to load dense map intrinsics from " << config_file << ", using defaults" << std::endl;
+  }
+
+  s->dense_intrinsics.fx = K.fx;
+  s->dense_intrinsics.fy = K.fy;
+  s->dense_intrinsics.cx = K.cx;
+  s->dense_intrinsics.cy = K.cy;
+  s->dense_intrinsics.depthFactor = K.depthFactor;
+}
+
+// 추적된 프레임을 덴스 키프레임으로 저장할지 판단 후 저장
+static void updateDenseKeyFrames(SlamContext* s, const FrameData& frame, const Sophus::SE3f& Tcw){
+  Eigen::Matrix4f Twc = Tcw.inverse().matrix();
+
+  if(s->has_last_dense_pose){
+    Eigen::Matrix4f delta = s->last_dense_pose.inverse() * Twc;
+    float distance = delta.block<3, 1>(0, 3).norm();
+    float cosAngle = std::max(-1.0f, std::min(1.0f, (delta.block<3, 3>(0, 0).trace() - 1.0f) * 0.5f));
+    float angle = std::acos(cosAngle) * 180.0f / (float)M_PI;
+
+    // 저장 기준은 slamSetDenseMapOptions 가 다른 스레드에서 바꿀 수 있으므로 dense_mutex 안에서 읽음
+    float minDistance, minAngle;
+    {
+      std::lock_guard<std::mutex> lock(s->dense_mutex);
+      minDistance = s->dense_keyframe_distance;
+      minAngle = s->dense_keyframe_angle;
+    }
+    if(distance < minDistance && angle < minAngle){
+      return;
+    }
+  }
+
+  auto kf = std::make_shared<DenseKeyFrame>();
+  kf->timestamp = frame.timestamp;
+  memcpy(kf->Twc, Twc.data(), sizeof(kf->Twc));
+  kf->width = frame.depth_raw.cols;
+  kf->height = frame.depth_raw.rows;
+  kf->depth.assign((const uint16_t*)frame.depth_raw.data, (const uint16_t*)frame.depth_raw.data + kf->width * kf->height);
+  kf->color.assign(frame.rgb.data, frame.rgb.data + kf->width * kf->height * 3);
+  kf->colorIsBGR = true;
+
+  // 기준 키프레임: 맵에서 가장 최근에 만든 ORB 키프레임 (slam_mutex 를 잡은 추적 스레드에서 호출됨)
+  DenseKeyFrameEntry entry;
+  entry.frame = kf;
+  const auto map = s->slam_system->GetMap();
+  if(map){
+    ORB_SLAM3::KeyFrame* anchor = nullptr;
+    for(ORB_SLAM3::KeyFrame* pKF : map->GetAllKeyFrames()){
+      if(pKF && !pKF->isBad() && (!anchor || pKF->mnId > anchor->mnId)){
+        anchor = pKF;
+      }
+    }
+    if(anchor){
+      Eigen::Matrix4f anchorToFrame = anchor->GetPose().matrix() * Twc;
+      entry.anchor_id = (long)anchor->mnId;
+      memcpy(entry.anchor_to_frame, anchorToFrame.data(), sizeof(entry.anchor_to_frame));
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(s->dense_mutex);
+    s->dense_keyframes.push_back(entry);
+
+    // 최대 개수를 넘으면 하나 걸러 하나씩 버리고 (가장 최근 것은 유지) 저장 간격을 두 배로 늘림
+    // 긴 세션에서도 메모리가 제한되고, 남은 키프레임은 궤적 전체에 고르게 퍼져 있음
+    if(s->max_dense_keyframes > 0 && s->dense_keyframes.size() > s->max_dense_keyframes){
+      std::vector<DenseKeyFrameEntry>& frames = s->dense_keyframes;
+      size_t kept = 0;
+      for(size_t i = 0; i < frames.size(); ++i){
+        if(i % 2 == 0 || i + 1 == frames.size()){
+          frames[kept++] = frames[i];
+        }
+      }
+      frames.resize(kept);
+      s->dense_keyframe_distance *= 2.0f;
+      s->dense_keyframe_angle *= 2.0f;
+      std::cout << "Dense keyframes thinned to " << kept << ", spacing " << s->dense_keyframe_distance << " m / "
+                << s->dense_keyframe_angle << " deg" << std::endl;
+    }
+  }
+
+  s->last_dense_pose = Twc;
+  s->has_last_dense_pose = true;
+}
+
+// TSDF 융합 스레드 함수 (추적 스레드를 지연시키지 않도록 분리)
+static void fusionThread(SlamContext* s){
+  std::cout << "TSDF fusion thread started" << std::endl;
+
+  double total_ms = 0.0;
+  int frames = 0;
+
+  while(true){
+    FusionFrame frame;
+    {
+      std::unique_lock<std::mutex> lock(s->fusion_mutex);
+      s->fusion_cv.wait(lock, [s]{ return s->fusion_pending || !s->fusion_running; });
+      if(!s->fusion_running) break;
+      frame = s->fusion_frame;
+      s->fusion_pending = false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    {
+      std::lock_guard<std::mutex> lock(s->tsdf_mutex);
+      if(s->tsdf_volume){
+        s->tsdf_volume->integrate((const uint16_t*)frame.depth_raw.data, frame.rgb.data, true, frame.depth_raw.cols,
+                                  frame.depth_raw.rows, frame.Twc);
+      }
+    }
+    total_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // 주기적으로 통합 시간 출력
+    if(++frames == 100){
+      std::cout << "TSDF integration: " << total_ms / frames << " ms/frame, "
+                << (s->tsdf_volume ? s->tsdf_volume->allocatedBlocks() : 0) << " blocks" << std::endl;
+      total_ms = 0.0;
+      frames = 0;
+    }
+  }
+
+  std::cout << "TSDF fusion thread stopped" << std::endl;
+}
+
+// 추적된 프레임을 융합 스레드에 전달 (처리 중이면 이전 프레임을 덮어씀)
+// Twc: 카메라 -> 월드 변환 (column-major 4x4)
+static void submitFusionFrame(SlamContext* s, const FrameData& frame, const float Twc[16]){
+  std::lock_guard<std::mutex> lock(s->fusion_mutex);
+  if(!s->fusion_running) return;
+
+  s->fusion_frame.depth_raw = frame.depth_raw;
+  s->fusion_frame.rgb = frame.rgb;
+  memcpy(s->fusion_frame.Twc, Twc, sizeof(s->fusion_frame.Twc));
+  s->fusion_pending = true;
+  s->fusion_cv.notify_one();
+}
+
+// ORB 추적 결과에 따라 ICP 기준 프레임을 갱신하거나 ICP 로 자세를 추정
+// 반환값: ICP 자세를 사용했으면 true (Twc 에 카메라 -> 월드 변환 저장)
+static bool updateIcpOdometry(SlamContext* s, const FrameData& frame, int state, const Eigen::Matrix4f& orbTwc,
+                              float Twc[16], float* icp_ms){
+  if(!s->icp_odometry || frame.depth_raw.empty()){
+    return false;
+  }
+
+  const uint16_t* depth = (const uint16_t*)frame.depth_raw.data;
+  const int width = frame.depth_raw.cols, height = frame.depth_raw.rows;
+
+  // ORB 추적이 정상이면 기준 프레임과 포즈만 동기화
+  if(state == ORB_SLAM3::Tracking::OK){
+    s->icp_odometry->setReference(depth, width, height);
+    s->icp_odometry->setPose(orbTwc.data());
+    s->icp_fallback_frames = 0;
+    s->icp_fallback_failed = false;
+    return false;
+  }
+
+  if(!s->icp_odometry->hasReference()){
+    return false;
+  }
+
+  IcpResult result;
+  bool tracked = s->icp_odometry->track(depth, width, height, nullptr, &result);
+  *icp_ms = result.timeMs;
+  if(!tracked){
+    if(!s->icp_fallback_failed){
+      std::cout << "ICP fallback failed (inlier ratio " << result.inlierRatio << ")" << std::endl;
+      s->icp_fallback_failed = true;
+    }
+    return false;
+  }
+
+  if(s->icp_fallback_frames++ == 0){
+    std::cout << "ORB tracking lost, using ICP odometry fallback" << std::endl;
+  }else if(s->icp_fallback_failed){
+    std::cout << "ICP fallback recovered" << std::endl;
+  }
+  s->icp_fallback_failed = false;
+  s->icp_odometry->getPose(Twc);
+  return true;
+}
 
 // 프레임 처리 스레드 함수
-void processFramesThread(){
+static void processFramesThread(SlamContext* s){
   std::cout << "SLAM processing thread started" << std::endl;
+  monitorRegisterThread(MONITOR_THREAD_SLAM);
 
-  while(process_frames){
+  while(s->process_frames){
     FrameData current_frame;
     bool has_frame = false;
 
-    // 큐에서 프레임 가져오기
+    // 큐에서 프레임 가져오기 (프레임이 없으면 잠시 대기)
     {
-      std::lock_guard<std::mutex> lock(queue_mutex);
-      if(!frame_queue.empty()){
-        current_frame = frame_queue.front();
-        frame_queue.pop();
+      std::unique_lock<std::mutex> lock(s->queue_mutex);
+      s->queue_cv.wait_for(lock, std::chrono::milliseconds(5),
+                           [s]{ return !s->frame_queue.empty() || !s->process_frames; });
+      if(!s->frame_queue.empty()){
+        current_frame = s->frame_queue.front();
+        s->frame_queue.pop();
+        s->frame_queue_depth.store((int)s->frame_queue.size(), std::memory_order_relaxed);
         has_frame = true;
       }
     }
 
+    // 락스텝 모드에서 대기 중인 생산자 깨우기
+    if(has_frame){
+      s->queue_cv.notify_all();
+    }
+
     // 프레임 처리
     if(has_frame){
-      std::lock_guard<std::mutex> lock(slam_mutex);
-      if(slam_system && slam_running){
+      std::lock_guard<std::mutex> lock(s->slam_mutex);
+      if(s->slam_system && s->slam_running){
         // ORB-SLAM3 에 프레임 전달
-        slam_system->TrackRGBD(current_frame.rgb, current_frame.depth, current_frame.timestamp);
+        auto track_start = std::chrono::steady_clock::now();
+        Sophus::SE3f Tcw = s->slam_system->TrackRGBD(current_frame.rgb, current_frame.depth, current_frame.timestamp);
+        float track_ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - track_start).count();
+
+        int state = s->slam_system->GetTrackingState();
+        Eigen::Matrix4f Twc = Tcw.inverse().matrix();
+        if(state == ORB_SLAM3::Tracking::OK && !current_frame.depth_raw.empty()){
+          updateDenseKeyFrames(s, current_frame, Tcw);
+          submitFusionFrame(s, current_frame, Twc.data());
+        }
+
+        // ORB 추적 실패 시 ICP 자세로 대체 (TSDF 융합도 계속 진행)
+        float icp_twc[16];
+        float icp_ms = 0.0f;
+        if(updateIcpOdometry(s, current_frame, state, Twc, icp_twc, &icp_ms)){
+          state = SLAM_TRACKING_ICP_FALLBACK;
+          Twc = Eigen::Map<Eigen::Matrix4f>(icp_twc);
+          track_ms += icp_ms;
+          submitFusionFrame(s, current_frame, icp_twc);
+        }
+
+        // 통계 갱신 (맵 크기는 복사 없이 개수만 조회)
+        int keyframes = 0, mappoints = 0;
+        const auto map = s->slam_system->GetMap();
+        if(map){
+          keyframes = (int)map->KeyFramesInMap();
+          mappoints = (int)map->MapPointsInMap();
+        }
+        publishSlamStats(s, state, track_ms, (int)s->slam_system->GetTrackedKeyPointsUn().size(), keyframes,
+                         mappoints, current_frame.timestamp);
+
+        // 포즈 전달
+        if(s->pose_callback){
+          s->pose_callback(current_frame.timestamp, state, Twc.data(), track_ms, s->pose_callback_user);
+        }
       }
-    }else{
-        // 프레임이 없으면 잠시 대기
-        std::this_thread::sleep_for(std::chrono::milliseconds(5));
     }
   }
 
+  monitorUnregisterThread(MONITOR_THREAD_SLAM);
   std::cout << "SLAM processing thread stopped" << std::endl;
 }
 
 extern "C" {
 
-void initSlamModule(const char* config_file, const char* vocabulary_file){
+SlamContext* createSlamContext(void){
+  return new (std::nothrow) SlamContext();
+}
+
+void destroySlamContext(SlamContext* s){
+  if(!s){
+    return;
+  }
+  if(s->slam_running){
+    slamStop(s);
+  }
+  // slamStart 전이나 초기화 실패 후에도 융합을 켤 수 있으므로 실행 여부와 무관하게 융합 스레드 정리
+  // (joinable 한 std::thread 를 소멸시키면 std::terminate)
+  slamDisableTsdfFusion(s);
+  delete s;
+}
+
+void slamStart(SlamContext* s, const char* config_file, const char* vocabulary_file){
   std::cout << "Initializing ORB-SLAM3 module..." << std::endl;
 
-  if(slam_running){
+  if(s->slam_running){
     std::cout <<"SLAM module is already running" << std::endl;
     return;
   }
 
   try{
     // ORB-SLAM3 시스템 초기화
-    std::lock_guard<std::mutex> lock(slam_mutex);
-    slam_system = std::make_shared<ORB_SLAM3::System>(
+    std::lock_guard<std::mutex> lock(s->slam_mutex);
+    s->slam_system = std::make_shared<ORB_SLAM3::System>(
         vocabulary_file,           // ORB 어휘 파일
         config_file,               // 설정 파일
-        ORB_SLAM::System::RGBD,    // 센서 타입
-        true                       // 시각화 활성화
+        ORB_SLAM3::System::RGBD,   // 센서 타입
+        s->slam_visualization      // 시각화 활성화
     );
 
+    // 덴스 맵 내보내기 준비
+    loadDenseIntrinsics(s, config_file);
+    {
+      std::lock_guard<std::mutex> dense_lock(s->dense_mutex);
+      s->dense_keyframes.clear();
+    }
+    s->has_last_dense_pose = false;
+
     // 프레임 처리 스레드 시작
-    process_frames = true;
-    processing_thread = std::thread(processFramesThread);
+    s->process_frames = true;
+    s->processing_thread = std::thread(processFramesThread, s);
 
-    slam_running = true;
+    s->slam_running = true;
     std::cout << "ORB-SLAM3 initialized successfully" << std::endl;
   }catch (const std::exception& e){
     std::cerr << "Failed to initialize ORB-SLAM3: " << e.what() << std::endl;
-    slam_system = nullptr;
+    s->slam_system = nullptr;
   }
 }
 
-void stopSlamModule() {
+void slamStop(SlamContext* s){
   std::cout << "Stopping ORB-SLAM3 module..." << std::endl;
 
+  // TSDF 융합 중지
+  slamDisableTsdfFusion(s);
+
   // 프레임 처리 스레드 중지
-  process_frames = false;
-  if(processing_thread.joinable()){
-    processing_thread.join();
+  {
+    std::lock_guard<std::mutex> lock(s->queue_mutex);
+    s->process_frames = false;
+  }
+  s->queue_cv.notify_all();
+  if(s->processing_thread.joinable()){
+    s->processing_thread.join();
   }
 
   // ORB-SLAM3 시스템 종료
   {
-    std::lock_guard<std::mutex> lock(slam_mutex);
-    if(slam_system){
-      slam_system->Shutdown();
-      slam_system = nullptr;
+    std::lock_guard<std::mutex> lock(s->slam_mutex);
+    if(s->slam_system){
+      s->slam_system->Shutdown();
+      s->slam_system = nullptr;
     }
+    s->icp_odometry.reset();
   }
 
   // 큐 비우기
   {
-    std::lock_guard<std::mutex> lock(queue_mutex);
+    std::lock_guard<std::mutex> lock(s->queue_mutex);
     std::queue<FrameData> empty;
-    std::swap(frame_queue, empty);
+    std::swap(s->frame_queue, empty);
+    s->frame_queue_depth.store(0, std::memory_order_relaxed);
   }
 
-  slam_running = false;
+  s->slam_running = false;
   std::cout << "ORB-SLAM3 module stopped" << std::endl;
 }
 
-int processSlamFrame(const int16_t* depth_data, const uint8_t* color_data, int width, int height, uint32_t timestamp){
-  if(!slam_running || !slam_system){
+int slamProcessFrame(SlamContext* s, const int16_t* depth_data, const uint8_t* color_data, int width, int height,
+                     uint32_t timestamp){
+  if(!s->slam_running || !s->slam_system){
     return 0;
   }
 
@@ -142,53 +522,68 @@ int processSlamFrame(const int16_t* depth_data, const uint8_t* color_data, int w
 
         // RGB -> BGR 순서 변환
         rgb_mat.data[dst_idx + 2] = color_data[src_idx];     // R -> B
-        rbg_mat.data[dst_idx + 1] = color_data[src_idx + 1]; // G -> G
+        rgb_mat.data[dst_idx + 1] = color_data[src_idx + 1]; // G -> G
         rgb_mat.data[dst_idx] = color_data[src_idx +2];      // B -> R
       }
     }
 
     // 타임스템프를 초 단위로 변환
-    double timestamp_sec = timestamp; 
+    double timestamp_sec = timestamp / 1000.0;
 
     // 깊이 이미지를 32비트 부동소수점으로 변환 (mm -> m 단위 변환)
     cv::Mat depth_float;
-    depth_map.convertTo(depth_float, CV_32F, 1.0/1000.0);
+    depth_mat.convertTo(depth_float, CV_32F, 1.0/1000.0);
 
     // 프레임 큐에 추가
     {
-      std::lock_guard<std::mutex> lock(queue_mutex);
-      frame_queue.push({depth_float, rgb_mat, timestamp_sec});
+      std::unique_lock<std::mutex> lock(s->queue_mutex);
+
+      // 락스텝 모드에서는 추적이 따라올 때까지 대기 (프레임을 버리지 않음)
+      if(s->lockstep_mode){
+        s->queue_cv.wait(lock, [s]{ return s->frame_queue.size() < kLockstepQueueDepth || !s->process_frames; });
+        if(!s->process_frames){
+          return 0;
+        }
+      }
+
+      s->frame_queue.push({depth_float, rgb_mat, timestamp_sec, depth_mat});
 
       // 큐가 너무 커지지 않도록 오래된 프레임 제거
-      if(frame_queue.size() > 10){
-        std::cout << "Warning: Frame queue is getting large (" << frame_queue.size() << ")" << std::endl;
-        while(frame_queue.size() > 5){
-          frame_queue.pop();
+      if(!s->lockstep_mode && s->frame_queue.size() > 10){
+        std::cout << "Warning: Frame queue is getting large (" << s->frame_queue.size() << ")" << std::endl;
+        while(s->frame_queue.size() > 5){
+          s->frame_queue.pop();
         }
       }
+      s->frame_queue_depth.store((int)s->frame_queue.size(), std::memory_order_relaxed);
     }
+    s->queue_cv.notify_all();
 
     return 1;
   } catch(const std::exception& e){
     std::cerr << "Error processing frame: " << e.what() << std::endl;
   }
+  return 0;
 }
 
-int saveSlamMap(const char* map_file){
-  if(!slam_running || !slam_system){
+int slamSaveMap(SlamContext* s, const char* map_file){
+  if(!s->slam_running || !s->slam_system){
     std::cerr << "SLAM system is not running" << std::endl;
     return 0;
   }
 
   try{
-    std::lock_guard<std::mutex> lock(slam_mutex);
+    {
+      std::lock_guard<std::mutex> lock(s->slam_mutex);
 
-    // 맵 저장 (ORB-SLAM3 형식)
-    slam_system->SaveTrajectoryTUM(std::string(map_file) + "_trajectory.txt");
-    slam_system->SaveKeyFrameTrajectoryTUM(std::string(map_file) + "_keyframes.txt");
+      // 맵 저장 (ORB-SLAM3 형식)
+      s->slam_system->SaveTrajectoryTUM(std::string(map_file) + "_trajectory.txt");
+      s->slam_system->SaveKeyFrameTrajectoryTUM(std::string(map_file) + "_keyframes.txt");
+    }
+
+    // 포인트 클라우드 저장 (덴스 키프레임 역투영 + 복셀 다운샘플링)
+    slamExportDenseMap(s, (std::string(map_file) + "_dense.ply").c_str());
 
-    // 포인트 클라우드 저장 (추가 구현 필요)
-    // ORB-SLAM3의 맵 포인트를 PCL 포인트 클라우드로 변환하여 저장
     std::cout << "Map saved to " << map_file << std::endl;
     return 1;
   }catch(const std::exception& e){
@@ -197,34 +592,288 @@ int saveSlamMap(const char* map_file){
   }
 }
 
-int isSlamModuleRunning(){
-  return slam_running ? 1 : 0;
+void slamSetDenseMapOptions(SlamContext* s, float leaf_size, float keyframe_distance, float keyframe_angle_deg){
+  std::lock_guard<std::mutex> lock(s->dense_mutex);
+  if(leaf_size > 0.0f) s->dense_options.leafSize = leaf_size;
+  if(keyframe_distance > 0.0f) s->dense_keyframe_distance = keyframe_distance;
+  if(keyframe_angle_deg > 0.0f) s->dense_keyframe_angle = keyframe_angle_deg;
 }
 
-int getSlamMapPoints(){
-  if(!slam_running || !slam_system){
+int slamExportDenseMap(SlamContext* s, const char* file){
+  std::vector<DenseKeyFrameEntry> entries;
+  DenseExportOptions options;
+  {
+    std::lock_guard<std::mutex> lock(s->dense_mutex);
+    entries = s->dense_keyframes;
+    options = s->dense_options;
+  }
+
+  if(entries.empty()){
+    std::cerr << "No dense keyframes to export" << std::endl;
+    return 0;
+  }
+
+  std::vector<std::shared_ptr<const DenseKeyFrame>> keyframes(entries.size());
+  std::vector<float> poses(entries.size() * 16);
+  for(size_t i = 0; i < entries.size(); ++i){
+    keyframes[i] = entries[i].frame;
+    memcpy(&poses[i * 16], entries[i].frame->Twc, 16 * sizeof(float));
+  }
+
+  // 기준 ORB 키프레임의 현재 자세 (최적화 반영) * 저장 당시 상대 자세
+  // 기준 키프레임이 지워졌거나 다른 맵에 있으면 추적 당시 자세를 그대로 사용
+  size_t refined = 0;
+  {
+    std::lock_guard<std::mutex> lock(s->slam_mutex);
+    const auto map = s->slam_system ? s->slam_system->GetMap() : nullptr;
+    if(map){
+      std::map<long, Eigen::Matrix4f> optimized;
+      for(ORB_SLAM3::KeyFrame* pKF : map->GetAllKeyFrames()){
+        if(pKF && !pKF->isBad()){
+          optimized[(long)pKF->mnId] = pKF->GetPoseInverse().matrix();
+        }
+      }
+
+      for(size_t i = 0; i < entries.size(); ++i){
+        auto it = optimized.find(entries[i].anchor_id);
+        if(it != optimized.end()){
+          Eigen::Matrix4f Twc = it->second * Eigen::Map<const Eigen::Matrix4f>(entries[i].anchor_to_frame);
+          memcpy(&poses[i * 16], Twc.data(), 16 * sizeof(float));
+          refined++;
+        }
+      }
+    }
+  }
+  std::cout << "Dense map: " << refined << " of " << entries.size() << " keyframes use optimized poses" << std::endl;
+
+  options.format = denseMapFormatFromPath(file);
+  return exportDensePointCloud(keyframes, poses, s->dense_intrinsics, options, file, nullptr);
+}
+
+void slamSetDenseKeyFrameLimit(SlamContext* s, int max_keyframes){
+  std::lock_guard<std::mutex> lock(s->dense_mutex);
+  s->max_dense_keyframes = max_keyframes > 0 ? (size_t)max_keyframes : 0;
+}
+
+int slamEnableTsdfFusion(SlamContext* s, float voxel_size, float truncation){
+  if(s->fusion_running){
+    std::cout << "TSDF fusion is already running" << std::endl;
+    return 1;
+  }
+
+  TsdfConfig config;
+  if(voxel_size > 0.0f) config.voxelSize = voxel_size;
+  config.truncation = truncation > 0.0f ? truncation : config.voxelSize * 4.0f;
+
+  {
+    std::lock_guard<std::mutex> lock(s->tsdf_mutex);
+    s->tsdf_volume.reset(new TsdfVolume(config, s->dense_intrinsics));
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(s->fusion_mutex);
+    s->fusion_running = true;
+    s->fusion_pending = false;
+  }
+  s->fusion_thread = std::thread(fusionThread, s);
+
+  std::cout << "TSDF fusion enabled (voxel " << config.voxelSize << " m, truncation " << config.truncation << " m)"
+            << std::endl;
+  return 1;
+}
+
+void slamDisableTsdfFusion(SlamContext* s){
+  {
+    std::lock_guard<std::mutex> lock(s->fusion_mutex);
+    if(!s->fusion_running) return;
+    s->fusion_running = false;
+    s->fusion_cv.notify_one();
+  }
+
+  if(s->fusion_thread.joinable()){
+    s->fusion_thread.join();
+  }
+}
+
+int slamExportTsdfMesh(SlamContext* s, const char* file){
+  std::lock_guard<std::mutex> lock(s->tsdf_mutex);
+  if(!s->tsdf_volume){
+    std::cerr << "TSDF fusion is not enabled" << std::endl;
     return 0;
   }
 
-  std::lock_guard<std::mutex> lock(slam_mutex);
-  // ORB-SLAM3의 맵 포인트 수 얻기 (이 부분은 ORB-SLAM3 API 에 따라 달라질 수 있음)
-  // 참고로 이 부분은 ORB-SLAM3의 실제 API 에 따라 수정 필요
-  const auto map = slam_system->GetMap();
-  if(!map){
+  return s->tsdf_volume->extractMesh(file, nullptr);
+}
+
+int slamEnableIcpFallback(SlamContext* s, int num_threads){
+  std::lock_guard<std::mutex> lock(s->slam_mutex);
+  if(s->icp_odometry){
+    return 1;
+  }
+
+  IcpConfig config;
+  config.numThreads = num_threads;
+  s->icp_odometry.reset(new IcpOdometry(config, s->dense_intrinsics));
+  s->icp_fallback_frames = 0;
+  s->icp_fallback_failed = false;
+  std::cout << "ICP odometry fallback enabled" << std::endl;
+  return 1;
+}
+
+void slamDisableIcpFallback(SlamContext* s){
+  std::lock_guard<std::mutex> lock(s->slam_mutex);
+  s->icp_odometry.reset();
+}
+
+void slamSetVisualization(SlamContext* s, int enabled){
+  s->slam_visualization = enabled != 0;
+}
+
+void slamSetLockstepMode(SlamContext* s, int enabled){
+  {
+    std::lock_guard<std::mutex> lock(s->queue_mutex);
+    s->lockstep_mode = enabled != 0;
+  }
+  s->queue_cv.notify_all();
+}
+
+void slamSetPoseCallback(SlamContext* s, SlamPoseCallback callback, void* user_data){
+  std::lock_guard<std::mutex> lock(s->slam_mutex);
+  s->pose_callback = callback;
+  s->pose_callback_user = user_data;
+}
+
+int slamIsRunning(SlamContext* s){
+  return s->slam_running ? 1 : 0;
+}
+
+int slamGetMapPoints(SlamContext* s){
+  if(!s->slam_running || !s->slam_system){
     return 0;
   }
 
-  return map->GetAllMapPoints().size();
+  // 추적 스레드가 기록한 스냅샷에서 읽음 (slam_mutex 를 잡지 않음)
+  SlamStats stats;
+  slamGetStats(s, &stats);
+  return stats.mapPoints;
 }
 
-void resetSlam(){
-  if(!slam_running || !slam_system){
+int slamGetStats(SlamContext* s, SlamStats* stats){
+  if(!stats){
+    return 0;
+  }
+
+  uint32_t begin, end;
+  do{
+    begin = s->slam_stats.sequence.load(std::memory_order_acquire);
+    stats->trackingState = s->slam_stats.trackingState.load(std::memory_order_relaxed);
+    stats->trackTimeMs = s->slam_stats.trackTimeMs.load(std::memory_order_relaxed);
+    stats->features = s->slam_stats.numFeatures.load(std::memory_order_relaxed);
+    stats->keyFrames = s->slam_stats.numKeyFrames.load(std::memory_order_relaxed);
+    stats->mapPoints = s->slam_stats.numMapPoints.load(std::memory_order_relaxed);
+    stats->queueDepth = s->slam_stats.queueDepth.load(std::memory_order_relaxed);
+    stats->frameCount = s->slam_stats.frameCount.load(std::memory_order_relaxed);
+    stats->timestamp = s->slam_stats.timestamp.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    end = s->slam_stats.sequence.load(std::memory_order_relaxed);
+  }while((begin & 1) || begin != end);
+
+  return s->slam_running ? 1 : 0;
+}
+
+void slamReset(SlamContext* s){
+
+  if(!s->slam_running || !s->slam_system){
     return;
   }
 
-  std::lock_guard<std::mutex> lock(slam_mutex);
-  slam_system->Reset();
+  std::lock_guard<std::mutex> lock(s->slam_mutex);
+  s->slam_system->Reset();
   std::cout << "SLAM system reset" << std::endl;
 }
 
+// ---------------------------------------------------------------------------
+// 기본 컨텍스트 (기존 함수가 사용, 종료 시 스레드 소멸자가 호출되지 않도록 해제하지 않음)
+
+static SlamContext* defaultSlamContext(){
+  static SlamContext* context = new SlamContext();
+  return context;
+}
+
+void initSlamModule(const char* config_file, const char* vocabulary_file){
+  slamStart(defaultSlamContext(), config_file, vocabulary_file);
+}
+
+void setSlamVisualization(int enabled){
+  slamSetVisualization(defaultSlamContext(), enabled);
+}
+
+void setSlamLockstepMode(int enabled){
+  slamSetLockstepMode(defaultSlamContext(), enabled);
+}
+
+void setSlamPoseCallback(SlamPoseCallback callback, void* user_data){
+  slamSetPoseCallback(defaultSlamContext(), callback, user_data);
+}
+
+void stopSlamModule(){
+  slamStop(defaultSlamContext());
+}
+
+int processSlamFrame(const int16_t* depth_data, const uint8_t* color_data, int width, int height, uint32_t timestamp){
+  return slamProcessFrame(defaultSlamContext(), depth_data, color_data, width, height, timestamp);
+}
+
+int saveSlamMap(const char* map_file){
+  return slamSaveMap(defaultSlamContext(), map_file);
+}
+
+void setSlamDenseMapOptions(float leaf_size, float keyframe_distance, float keyframe_angle_deg){
+  slamSetDenseMapOptions(defaultSlamContext(), leaf_size, keyframe_distance, keyframe_angle_deg);
+}
+
+int exportSlamDenseMap(const char* file){
+  return slamExportDenseMap(defaultSlamContext(), file);
+}
+
+void setSlamDenseKeyFrameLimit(int max_keyframes){
+  slamSetDenseKeyFrameLimit(defaultSlamContext(), max_keyframes);
+}
+
+int enableSlamTsdfFusion(float voxel_size, float truncation){
+  return slamEnableTsdfFusion(defaultSlamContext(), voxel_size, truncation);
+}
+
+void disableSlamTsdfFusion(){
+  slamDisableTsdfFusion(defaultSlamContext());
+}
+
+int exportSlamTsdfMesh(const char* file){
+  return slamExportTsdfMesh(defaultSlamContext(), file);
+}
+
+int enableSlamIcpFallback(int num_threads){
+  return slamEnableIcpFallback(defaultSlamContext(), num_threads);
+}
+
+void disableSlamIcpFallback(){
+  slamDisableIcpFallback(defaultSlamContext());
+}
+
+int isSlamModuleRunning(){
+  return slamIsRunning(defaultSlamContext());
+}
+
+int getSlamMapPoints(){
+  return slamGetMapPoints(defaultSlamContext());
+}
+
+int getSlamStats(SlamStats* stats){
+  return slamGetStats(defaultSlamContext(), stats);
+}
+
+void resetSlam(){
+  slamReset(defaultSlamContext());
+}
+
 } // extern "C"
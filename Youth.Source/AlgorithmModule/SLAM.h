@@ -1,15 +1,51 @@
 #ifndef SLAM_H
 #define SLAM_H
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// 추적 상태 (ORB_SLAM3::Tracking::eTrackingState 와 동일한 값)
+#define SLAM_TRACKING_NOT_INITIALIZED 1
+#define SLAM_TRACKING_OK 2
+#define SLAM_TRACKING_RECENTLY_LOST 3
+#define SLAM_TRACKING_LOST 4
+#define SLAM_TRACKING_ICP_FALLBACK 6  // ORB 추적 실패, ICP 오도메트리 자세 사용
+
+// SLAM 통계 스냅샷 (추적 스레드가 프레임마다 갱신)
+typedef struct{
+  int trackingState;    // ORB_SLAM3::Tracking::eTrackingState (-1: 아직 프레임 없음)
+  float trackTimeMs;    // 마지막 프레임 TrackRGBD 소요 시간 (ms)
+  int features;         // 마지막 프레임 특징점 수
+  int keyFrames;        // 현재 맵의 키프레임 수
+  int mapPoints;        // 현재 맵의 맵 포인트 수
+  int queueDepth;       // 처리 대기 중인 프레임 수
+  uint32_t frameCount;  // 처리된 프레임 수
+  double timestamp;     // 마지막 프레임 타임스템프
+} SlamStats;
+
+// 포즈 콜백 (추적 스레드에서 프레임마다 호출)
+// timestamp: 프레임 타임스템프 (초), tracking_state: ORB_SLAM3::Tracking::eTrackingState 또는 SLAM_TRACKING_ICP_FALLBACK
+// Twc: 카메라 -> 월드 변환 (column-major 4x4), track_ms: TrackRGBD (+ ICP) 소요 시간
+typedef void (*SlamPoseCallback)(double timestamp, int tracking_state, const float* Twc, float track_ms,
+                                 void* user_data);
+
 // SLAM 모듈 초기화
 // config_file: ORB_SLAM3 설정 파일 경로
 // vocabulary_file: ORB 어휘 파일 경로
 void initSlamModule(const char* config_file, const char* vocabulary_file);
 
+// ORB-SLAM3 시각화 창 사용 여부 (initSlamModule 이전에 호출, 기본값 1)
+void setSlamVisualization(int enabled);
+
+// 락스텝 모드 설정 (1 이면 processSlamFrame 이 프레임을 버리지 않고 추적이 따라올 때까지 대기)
+void setSlamLockstepMode(int enabled);
+
+// 포즈 콜백 등록 (NULL 이면 해제)
+void setSlamPoseCallback(SlamPoseCallback callback, void* user_data);
+
 // SLAM 모듈 종료
 void stopSlamModule();
 
@@ -26,6 +62,41 @@ int processSlamFrame(const int16_t* depth_data, const uint8_t* color_data, int w
 // 반환값: 성공 시 1, 실패 시 0
 int saveSlamMap(const char* map_file);
 
+// 덴스 포인트 클라우드 내보내기 설정
+// leaf_size: 복셀 다운샘플링 크기 (m)
+// keyframe_distance, keyframe_angle_deg: 덴스 키프레임 저장 기준 이동 거리 (m) / 회전 각도 (deg)
+// 0 이하의 값은 기존 설정 유지
+void setSlamDenseMapOptions(float leaf_size, float keyframe_distance, float keyframe_angle_deg);
+
+// 덴스 키프레임 최대 개수 (기본 256, 0 이면 제한 없음)
+// 넘으면 하나 걸러 하나씩 버리고 저장 기준 거리 / 각도를 두 배로 늘림
+void setSlamDenseKeyFrameLimit(int max_keyframes);
+
+// 덴스 포인트 클라우드 저장 (확장자가 .pcd 이면 PCD, 그 외에는 바이너리 PLY)
+// 반환값: 성공 시 1, 실패 시 0
+int exportSlamDenseMap(const char* file);
+
+// TSDF 볼륨 융합 시작 (추적된 프레임을 해시 블록 그리드에 통합)
+// voxel_size: 복셀 크기 (m), truncation: 절단 거리 (m, 0 이하이면 복셀 크기의 4배)
+// 반환값: 성공 시 1, 실패 시 0
+int enableSlamTsdfFusion(float voxel_size, float truncation);
+
+// TSDF 볼륨 융합 중지 (볼륨은 메쉬 추출을 위해 유지됨)
+void disableSlamTsdfFusion();
+
+// TSDF 볼륨에서 메쉬를 추출하여 바이너리 PLY 로 저장
+// 반환값: 성공 시 1, 실패 시 0
+int exportSlamTsdfMesh(const char* file);
+
+// ICP 오도메트리 폴백 사용 (ORB 추적 실패 시 깊이만으로 자세 추정)
+// 폴백 자세는 포즈 콜백에 SLAM_TRACKING_ICP_FALLBACK 상태로 전달되고 TSDF 융합에도 사용됨
+// num_threads: ICP 작업 스레드 수 (0 이면 하드웨어 코어 수)
+// 반환값: 성공 시 1, 실패 시 0
+int enableSlamIcpFallback(int num_threads);
+
+// ICP 오도메트리 폴백 중지
+void disableSlamIcpFallback();
+
 // SLAM 상태 확인
 // 반환값: 동작 중이면 1, 아니면 0
 int isSlamModuleRunning();
@@ -34,9 +105,46 @@ int isSlamModuleRunning();
 // 반환값: 맵 포인트 수
 int getSlamMapPoints();
 
+// SLAM 통계 스냅샷 읽기 (락 없이 임의의 스레드에서 호출 가능, SLAM 을 멈추지 않음)
+// 반환값: SLAM 동작 중이면 1, 아니면 0
+int getSlamStats(SlamStats* stats);
+
 // 맵핑 리셋
 void resetSlam();
 
+// SLAM 인스턴스 (ORB-SLAM3 시스템 + 프레임 큐 + 덴스 맵 / TSDF / ICP 상태)
+// 위의 함수들은 프로세스 기본 인스턴스를 사용하고, 아래 함수들은 같은 동작을 지정한 인스턴스에 대해 수행
+// 인스턴스마다 추적 스레드가 따로 돌아 파이프라인 여러 개가 한 프로세스에서 독립적으로 SLAM 을 실행
+// (ORB 어휘 파일은 인스턴스마다 따로 읽으므로 메모리 사용량도 인스턴스 수에 비례)
+typedef struct SlamContext SlamContext;
+
+// 반환값: 할당 실패 시 NULL
+SlamContext* createSlamContext(void);
+
+// 동작 중이면 정지 후 해제
+void destroySlamContext(SlamContext* slam);
+
+void slamStart(SlamContext* slam, const char* config_file, const char* vocabulary_file);
+void slamStop(SlamContext* slam);
+void slamSetVisualization(SlamContext* slam, int enabled);
+void slamSetLockstepMode(SlamContext* slam, int enabled);
+void slamSetPoseCallback(SlamContext* slam, SlamPoseCallback callback, void* user_data);
+int slamProcessFrame(SlamContext* slam, const int16_t* depth_data, const uint8_t* color_data, int width, int height,
+                     uint32_t timestamp);
+int slamSaveMap(SlamContext* slam, const char* map_file);
+void slamSetDenseMapOptions(SlamContext* slam, float leaf_size, float keyframe_distance, float keyframe_angle_deg);
+void slamSetDenseKeyFrameLimit(SlamContext* slam, int max_keyframes);
+int slamExportDenseMap(SlamContext* slam, const char* file);
+int slamEnableTsdfFusion(SlamContext* slam, float voxel_size, float truncation);
+void slamDisableTsdfFusion(SlamContext* slam);
+int slamExportTsdfMesh(SlamContext* slam, const char* file);
+int slamEnableIcpFallback(SlamContext* slam, int num_threads);
+void slamDisableIcpFallback(SlamContext* slam);
+int slamIsRunning(SlamContext* slam);
+int slamGetMapPoints(SlamContext* slam);
+int slamGetStats(SlamContext* slam, SlamStats* stats);
+void slamReset(SlamContext* slam);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,174 @@
+// ICP 오도메트리 처리량 / 정확도 벤치마크
+// 사용법: IcpBenchmark [frames] [max_threads] [dropout_period]
+// 합성 방 (4 x 3 x 4 m) 모서리를 내려다보며 움직이는 카메라의 640x480 깊이 프레임을 추적하고
+// 스레드 수 (1, 2, 4, ... max_threads) 별 프레임당 추적 시간 / FPS 와 정답 궤적 대비 누적 오차 출력
+// dropout_period 를 주면 그 주기마다 빈 깊이 프레임 (센서 끊김) 을 넣어 추적 실패 후 복귀도 확인
+
+#include "icpOdometry.h"
+#include <Eigen/Dense>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#define ROOM_HALF_WIDTH 2.0f
+#define ROOM_HALF_HEIGHT 1.5f
+#define FRAME_WIDTH 640
+#define FRAME_HEIGHT 480
+#define FRAME_BUDGET_MS (1000.0 / 30.0)
+
+static double nowSeconds(){
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// 카메라 자세 (반지름 0.5 m 원 위를 돌며 +x +z 모서리를 20도 내려다봄, 좌우로 흔들림), column-major
+// 두 벽 + 바닥이 항상 보이도록 해 점-평면 ICP 의 6 자유도가 모두 구속되게 함 (월드 y 축이 아래)
+static void roomPose(int frame, Eigen::Matrix4f& Twc){
+  float angle = frame * 0.02f;
+  float yaw = 0.785f + 0.3f * sinf(angle * 1.7f);
+  Eigen::Matrix3f R = (Eigen::AngleAxisf(yaw, Eigen::Vector3f::UnitY()) *
+                       Eigen::AngleAxisf(-0.35f, Eigen::Vector3f::UnitX())).toRotationMatrix();
+  Twc.setIdentity();
+  Twc.topLeftCorner<3, 3>() = R;
+  Twc.topRightCorner<3, 1>() = Eigen::Vector3f(0.5f * sinf(angle), -0.3f, 0.5f * cosf(angle));
+}
+
+// 방 벽 / 바닥 / 천장까지의 깊이 (광선 추적), 모서리 앞 바닥에 놓인 상자
+static void renderRoom(const DenseCameraIntrinsics& K, const Eigen::Matrix4f& Twc, uint16_t* depth){
+  const float o[3] = {Twc(0, 3), Twc(1, 3), Twc(2, 3)};
+  const float half[3] = {ROOM_HALF_WIDTH, ROOM_HALF_HEIGHT, ROOM_HALF_WIDTH};
+  const float boxMin[3] = {0.8f, 0.9f, 0.8f}, boxMax[3] = {1.3f, ROOM_HALF_HEIGHT, 1.3f};
+
+  for(int v = 0; v < FRAME_HEIGHT; ++v){
+    for(int u = 0; u < FRAME_WIDTH; ++u){
+      // 광선의 카메라 z 성분이 1 이므로 t 가 곧 깊이
+      Eigen::Vector3f dir = Twc.topLeftCorner<3, 3>() * Eigen::Vector3f((u - K.cx) / K.fx, (v - K.cy) / K.fy, 1.0f);
+      const float d[3] = {dir.x(), dir.y(), dir.z()};
+
+      float t = 1e9f;
+      for(int a = 0; a < 3; ++a){
+        if(d[a] > 1e-6f) t = fminf(t, (half[a] - o[a]) / d[a]);
+        if(d[a] < -1e-6f) t = fminf(t, (-half[a] - o[a]) / d[a]);
+      }
+
+      // 상자 (slab 교차)
+      float tNear = 0.0f, tFar = 1e9f;
+      for(int a = 0; a < 3 && tNear <= tFar; ++a){
+        if(fabsf(d[a]) < 1e-6f){
+          if(o[a] < boxMin[a] || o[a] > boxMax[a]) tNear = 1e9f;
+          continue;
+        }
+        float t0 = (boxMin[a] - o[a]) / d[a], t1 = (boxMax[a] - o[a]) / d[a];
+        tNear = fmaxf(tNear, fminf(t0, t1));
+        tFar = fminf(tFar, fmaxf(t0, t1));
+      }
+      if(tNear <= tFar && tNear < t) t = tNear;
+
+      size_t i = (size_t)v * FRAME_WIDTH + u;
+      depth[i] = t < 6.0f ? (uint16_t)(t * K.depthFactor) : 0;
+    }
+  }
+}
+
+// 정답 대비 이동 오차 (m) / 회전 오차 (도)
+static void poseError(const Eigen::Matrix4f& estimate, const Eigen::Matrix4f& truth, float* translation,
+                      float* rotationDeg){
+  Eigen::Matrix4f delta = truth.inverse() * estimate;
+  *translation = delta.topRightCorner<3, 1>().norm();
+  float c = std::min(1.0f, std::max(-1.0f, (delta.topLeftCorner<3, 3>().trace() - 1.0f) * 0.5f));
+  *rotationDeg = acosf(c) * 180.0f / 3.14159265f;
+}
+
+int main(int argc, char** argv){
+  int frames = argc > 1 ? atoi(argv[1]) : 300;
+  int maxThreads = argc > 2 ? atoi(argv[2]) : (int)std::thread::hardware_concurrency();
+  int dropoutPeriod = argc > 3 ? atoi(argv[3]) : 0;
+  if(maxThreads < 1) maxThreads = 1;
+  if(frames < 2 || dropoutPeriod < 0){
+    fprintf(stderr, "Usage: %s [frames] [max_threads] [dropout_period]\n", argv[0]);
+    return 1;
+  }
+
+  DenseCameraIntrinsics K;
+  IcpConfig config;
+  std::vector<uint16_t> depth((size_t)FRAME_WIDTH * FRAME_HEIGHT);
+  printf("ICP: %d levels, iterations %d/%d/%d, %dx%d frames, %d hardware cores", config.levels,
+         config.iterations[0], config.iterations[1], config.iterations[2], FRAME_WIDTH, FRAME_HEIGHT,
+         (int)std::thread::hardware_concurrency());
+  if(dropoutPeriod > 0) printf(", empty frame every %d frames", dropoutPeriod);
+  printf("\n");
+
+  // 궤적 길이 (누적 오차를 이동 거리 대비 비율로도 출력)
+  float pathLength = 0.0f;
+  Eigen::Matrix4f previous, truth;
+  roomPose(0, previous);
+  for(int frame = 1; frame < frames; ++frame){
+    roomPose(frame, truth);
+    pathLength += (truth.topRightCorner<3, 1>() - previous.topRightCorner<3, 1>()).norm();
+    previous = truth;
+  }
+
+  double singleThreadMs = 0.0;
+  int budgetThreads = 0;
+  for(int threads = 1;; threads = std::min(threads * 2, maxThreads)){
+    config.numThreads = threads;
+    IcpOdometry icp(config, K);
+    roomPose(0, truth);
+    icp.setPose(truth.data());
+
+    // 프레임 생성 시간은 제외하고 track 만 측정 (첫 프레임은 기준 프레임 설정)
+    double trackSeconds = 0.0, worstMs = 0.0;
+    int failed = 0;
+    float maxTranslation = 0.0f, translation = 0.0f, rotationDeg = 0.0f;
+    for(int frame = 0; frame < frames; ++frame){
+      roomPose(frame, truth);
+      bool dropout = frame > 0 && dropoutPeriod > 0 && frame % dropoutPeriod == 0;
+      if(dropout){
+        std::fill(depth.begin(), depth.end(), 0);
+      }else{
+        renderRoom(K, truth, depth.data());
+      }
+
+      IcpResult result;
+      double start = nowSeconds();
+      bool tracked = icp.track(depth.data(), FRAME_WIDTH, FRAME_HEIGHT, nullptr, &result);
+      double elapsed = nowSeconds() - start;
+      if(frame == 0) continue;
+
+      trackSeconds += elapsed;
+      if(elapsed * 1000.0 > worstMs) worstMs = elapsed * 1000.0;
+      if(!tracked){
+        failed++;
+        continue;
+      }
+
+      Eigen::Matrix4f estimate;
+      icp.getPose(estimate.data());
+      poseError(estimate, truth, &translation, &rotationDeg);
+      maxTranslation = std::max(maxTranslation, translation);
+    }
+
+    double meanMs = trackSeconds * 1000.0 / (frames - 1);
+    printf("%2d threads: %.3f ms/frame (worst %.3f ms), %.1f FPS, %d failed, "
+           "final drift %.1f mm / %.2f deg (%.2f%% of %.2f m path), max %.1f mm\n",
+           threads, meanMs, worstMs, 1000.0 / meanMs, failed, translation * 1000.0f, rotationDeg,
+           translation / pathLength * 100.0f, pathLength, maxTranslation * 1000.0f);
+
+    if(threads == 1) singleThreadMs = meanMs;
+    if(budgetThreads == 0 && meanMs <= FRAME_BUDGET_MS) budgetThreads = threads;
+    if(threads == maxThreads) break;
+  }
+
+  // 30 FPS 예산을 채우는 스레드 수, 못 채우면 1 스레드 시간에서 선형 확장을 가정한 최소 코어 수
+  if(budgetThreads > 0){
+    printf("30 FPS (%.1f ms/frame) reached with %d threads\n", FRAME_BUDGET_MS, budgetThreads);
+  }else{
+    printf("30 FPS (%.1f ms/frame) not reached, needs at least %d cores at linear scaling\n", FRAME_BUDGET_MS,
+           (int)std::ceil(singleThreadMs / FRAME_BUDGET_MS));
+  }
+  return 0;
+}
@@ -0,0 +1,514 @@
+#include "icpOdometry.h"
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// 정규방정식 원소 수 (JtJ 상삼각 21 + Jtr 6 + 잔차 제곱합 1)
+static const int kSumCount = 28;
+
+// 행 밴드 단위 작업 크기
+static const int kRowsPerTask = 8;
+
+static void setIdentity(float T[16]){
+  memset(T, 0, sizeof(float) * 16);
+  T[0] = T[5] = T[10] = T[15] = 1.0f;
+}
+
+IcpOdometry::IcpOdometry(const IcpConfig& config, const DenseCameraIntrinsics& intrinsics) :
+    config_(config), intrinsics_(intrinsics){
+  config_.levels = std::max(1, std::min(config_.levels, ICP_MAX_LEVELS));
+  setIdentity(pose_);
+
+  int numThreads = config_.numThreads > 0 ? config_.numThreads : (int)std::thread::hardware_concurrency();
+  numThreads = std::max(1, numThreads);
+  partial_sums_.assign(numThreads, std::vector<double>(kSumCount, 0.0));
+  partial_counts_.assign(numThreads, 0);
+  partial_valid_.assign(numThreads, 0);
+
+  for(int i = 1; i < numThreads; ++i){
+    workers_.emplace_back(&IcpOdometry::workerLoop, this, i);
+  }
+}
+
+IcpOdometry::~IcpOdometry(){
+  {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    stop_ = true;
+  }
+  pool_cv_.notify_all();
+  for(auto& worker : workers_){
+    worker.join();
+  }
+}
+
+void IcpOdometry::workerLoop(int index){
+  uint64_t seen = 0;
+  while(true){
+    const std::function<void(int, int)>* job;
+    int tasks;
+    {
+      std::unique_lock<std::mutex> lock(pool_mutex_);
+      pool_cv_.wait(lock, [&]{ return stop_ || job_generation_ != seen; });
+      if(stop_) return;
+      seen = job_generation_;
+      job = job_;
+      tasks = job_tasks_;
+    }
+
+    int task;
+    while((task = next_task_.fetch_add(1)) < tasks){
+      (*job)(index, task);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(pool_mutex_);
+      if(--active_workers_ == 0){
+        done_cv_.notify_one();
+      }
+    }
+  }
+}
+
+void IcpOdometry::parallelFor(int numTasks, const std::function<void(int, int)>& func){
+  if(workers_.empty()){
+    for(int task = 0; task < numTasks; ++task){
+      func(0, task);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    job_ = &func;
+    job_tasks_ = numTasks;
+    next_task_ = 0;
+    active_workers_ = (int)workers_.size();
+    job_generation_++;
+  }
+  pool_cv_.notify_all();
+
+  // 호출 스레드도 작업에 참여
+  int task;
+  while((task = next_task_.fetch_add(1)) < numTasks){
+    func(0, task);
+  }
+
+  std::unique_lock<std::mutex> lock(pool_mutex_);
+  done_cv_.wait(lock, [&]{ return active_workers_ == 0; });
+  job_ = nullptr;
+}
+
+// 정점 맵과 법선 맵 계산
+// 법선을 구할 수 없는 픽셀은 vz = 0 으로 무효 처리해 이후 단계에서 한 번만 검사하도록 함
+void IcpOdometry::computeVertexNormal(IcpLevel& level){
+  const int w = level.width, h = level.height;
+  const size_t n = (size_t)w * h;
+  level.vx.resize(n);
+  level.vy.resize(n);
+  level.vz.resize(n);
+  level.nx.resize(n);
+  level.ny.resize(n);
+  level.nz.resize(n);
+
+  const float invFx = 1.0f / level.fx, invFy = 1.0f / level.fy;
+  const float cx = level.cx, cy = level.cy;
+  const float* depth = level.depth.data();
+  float* vx = level.vx.data();
+  float* vy = level.vy.data();
+  float* vz = level.vz.data();
+  float* nxOut = level.nx.data();
+  float* nyOut = level.ny.data();
+  float* nzOut = level.nz.data();
+
+  int numTasks = (h + kRowsPerTask - 1) / kRowsPerTask;
+  parallelFor(numTasks, [&](int, int task){
+    int rowEnd = std::min(h, (task + 1) * kRowsPerTask);
+    for(int v = task * kRowsPerTask; v < rowEnd; ++v){
+      const float ry0 = (v - cy) * invFy;
+      const float ry1 = (v + 1 - cy) * invFy;
+      for(int u = 0; u < w; ++u){
+        size_t i = (size_t)v * w + u;
+        float z = depth[i];
+        float zr = u + 1 < w ? depth[i + 1] : 0.0f;
+        float zd = v + 1 < h ? depth[i + w] : 0.0f;
+
+        vx[i] = vy[i] = vz[i] = 0.0f;
+        nxOut[i] = nyOut[i] = nzOut[i] = 0.0f;
+        if(z <= 0.0f || zr <= 0.0f || zd <= 0.0f) continue;
+
+        const float rx0 = (u - cx) * invFx, rx1 = (u + 1 - cx) * invFx;
+        float px = rx0 * z, py = ry0 * z;
+        float ax = rx1 * zr - px, ay = ry0 * zr - py, az = zr - z;
+        float bx = rx0 * zd - px, by = ry1 * zd - py, bz = zd - z;
+        float nx = ay * bz - az * by;
+        float ny = az * bx - ax * bz;
+        float nz = ax * by - ay * bx;
+        float normSq = nx * nx + ny * ny + nz * nz;
+        if(normSq <= 1e-20f) continue;
+
+        // 카메라를 향하도록 방향 정렬
+        float inv = 1.0f / std::sqrt(normSq);
+        if(nx * px + ny * py + nz * z > 0.0f) inv = -inv;
+        vx[i] = px;
+        vy[i] = py;
+        vz[i] = z;
+        nxOut[i] = nx * inv;
+        nyOut[i] = ny * inv;
+        nzOut[i] = nz * inv;
+      }
+    }
+  });
+}
+
+// 원본 깊이 -> coarse-to-fine 피라미드
+void IcpOdometry::buildPyramid(const uint16_t* depth, int width, int height, std::vector<IcpLevel>& pyramid){
+  pyramid.resize(config_.levels);
+  const float invFactor = 1.0f / intrinsics_.depthFactor;
+
+  IcpLevel& base = pyramid[0];
+  base.width = width;
+  base.height = height;
+  base.fx = intrinsics_.fx;
+  base.fy = intrinsics_.fy;
+  base.cx = intrinsics_.cx;
+  base.cy = intrinsics_.cy;
+  base.depth.resize((size_t)width * height);
+
+  int numTasks = (height + kRowsPerTask - 1) / kRowsPerTask;
+  parallelFor(numTasks, [&](int, int task){
+    int rowEnd = std::min(height, (task + 1) * kRowsPerTask);
+    for(int v = task * kRowsPerTask; v < rowEnd; ++v){
+      for(int u = 0; u < width; ++u){
+        size_t i = (size_t)v * width + u;
+        float z = depth[i] * invFactor;
+        base.depth[i] = (z >= config_.minDepth && z <= config_.maxDepth) ? z : 0.0f;
+      }
+    }
+  });
+
+  for(int l = 1; l < config_.levels; ++l){
+    const IcpLevel& src = pyramid[l - 1];
+    IcpLevel& dst = pyramid[l];
+    dst.width = src.width / 2;
+    dst.height = src.height / 2;
+    dst.fx = src.fx * 0.5f;
+    dst.fy = src.fy * 0.5f;
+    dst.cx = (src.cx + 0.5f) * 0.5f - 0.5f;
+    dst.cy = (src.cy + 0.5f) * 0.5f - 0.5f;
+    dst.depth.assign((size_t)dst.width * dst.height, 0.0f);
+
+    // 2x2 평균 (깊이 불연속 픽셀 제외)
+    int levelTasks = (dst.height + kRowsPerTask - 1) / kRowsPerTask;
+    parallelFor(levelTasks, [&](int, int task){
+      int rowEnd = std::min(dst.height, (task + 1) * kRowsPerTask);
+      for(int v = task * kRowsPerTask; v < rowEnd; ++v){
+        const float* row0 = src.depth.data() + (size_t)(v * 2) * src.width;
+        const float* row1 = row0 + src.width;
+        for(int u = 0; u < dst.width; ++u){
+          float d[4] = {row0[u * 2], row0[u * 2 + 1], row1[u * 2], row1[u * 2 + 1]};
+          float ref = 0.0f;
+          for(int k = 0; k < 4 && ref <= 0.0f; ++k) ref = d[k];
+          if(ref <= 0.0f) continue;
+
+          float sum = 0.0f;
+          int count = 0;
+          for(int k = 0; k < 4; ++k){
+            if(d[k] > 0.0f && std::fabs(d[k] - ref) < config_.depthDiscontinuity){
+              sum += d[k];
+              count++;
+            }
+          }
+          dst.depth[(size_t)v * dst.width + u] = sum / count;
+        }
+      }
+    });
+  }
+
+  for(int l = 0; l < config_.levels; ++l){
+    computeVertexNormal(pyramid[l]);
+  }
+}
+
+// 투영 연관으로 대응점을 찾고 점-평면 정규방정식을 스레드별로 누적한 뒤 합산
+void IcpOdometry::reduce(int level, const float T[12], double* sums, int* count, int* valid){
+  const IcpLevel& cur = current_[level];
+  const IcpLevel& ref = reference_[level];
+  const int w = cur.width, h = cur.height;
+  const int refW = ref.width, refH = ref.height;
+  const float distSq = config_.distanceThreshold * config_.distanceThreshold;
+  const float normalThreshold = config_.normalThreshold;
+
+  const float r00 = T[0], r01 = T[1], r02 = T[2], t0 = T[3];
+  const float r10 = T[4], r11 = T[5], r12 = T[6], t1 = T[7];
+  const float r20 = T[8], r21 = T[9], r22 = T[10], t2 = T[11];
+  const float fx = ref.fx, fy = ref.fy, cx = ref.cx + 0.5f, cy = ref.cy + 0.5f;
+
+  const float* cvx = cur.vx.data();
+  const float* cvy = cur.vy.data();
+  const float* cvz = cur.vz.data();
+  const float* cnx = cur.nx.data();
+  const float* cny = cur.ny.data();
+  const float* cnz = cur.nz.data();
+  const float* qvx = ref.vx.data();
+  const float* qvy = ref.vy.data();
+  const float* qvz = ref.vz.data();
+  const float* qnx = ref.nx.data();
+  const float* qny = ref.ny.data();
+  const float* qnz = ref.nz.data();
+
+  for(size_t t = 0; t < partial_sums_.size(); ++t){
+    std::fill(partial_sums_[t].begin(), partial_sums_[t].end(), 0.0);
+    partial_counts_[t] = 0;
+    partial_valid_[t] = 0;
+  }
+
+  int numTasks = (h + kRowsPerTask - 1) / kRowsPerTask;
+  parallelFor(numTasks, [&](int thread, int task){
+    // 행 밴드 내에서는 float 로 누적하고 스레드 합계는 double 로 유지
+    float acc[kSumCount] = {0.0f};
+    int inliers = 0, validPoints = 0;
+
+    int32_t ui[4], vi[4];
+    float px[4], py[4], pz[4];
+    int32_t inside[4];
+
+    int rowEnd = std::min(h, (task + 1) * kRowsPerTask);
+    for(int v = task * kRowsPerTask; v < rowEnd; ++v){
+      const size_t rowOffset = (size_t)v * w;
+      for(int u0 = 0; u0 < w; u0 += 4){
+        int lanes = std::min(4, w - u0);
+        const size_t i0 = rowOffset + u0;
+
+#if defined(__SSE2__)
+        if(lanes == 4){
+          // 4개 정점 변환 및 기준 프레임 투영
+          __m128 vx = _mm_loadu_ps(cvx + i0);
+          __m128 vy = _mm_loadu_ps(cvy + i0);
+          __m128 vz = _mm_loadu_ps(cvz + i0);
+          __m128 valid4 = _mm_cmpgt_ps(vz, _mm_setzero_ps());
+          if(_mm_movemask_ps(valid4) == 0) continue;
+
+          __m128 qx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(r00), vx), _mm_mul_ps(_mm_set1_ps(r01), vy)),
+                                 _mm_add_ps(_mm_mul_ps(_mm_set1_ps(r02), vz), _mm_set1_ps(t0)));
+          __m128 qy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(r10), vx), _mm_mul_ps(_mm_set1_ps(r11), vy)),
+                                 _mm_add_ps(_mm_mul_ps(_mm_set1_ps(r12), vz), _mm_set1_ps(t1)));
+          __m128 qz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(r20), vx), _mm_mul_ps(_mm_set1_ps(r21), vy)),
+                                 _mm_add_ps(_mm_mul_ps(_mm_set1_ps(r22), vz), _mm_set1_ps(t2)));
+
+          __m128 ok = _mm_and_ps(valid4, _mm_cmpgt_ps(qz, _mm_set1_ps(1e-4f)));
+          __m128 invz = _mm_div_ps(_mm_set1_ps(1.0f), _mm_max_ps(qz, _mm_set1_ps(1e-4f)));
+          __m128 uf = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(qx, invz), _mm_set1_ps(fx)), _mm_set1_ps(cx));
+          __m128 vf = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(qy, invz), _mm_set1_ps(fy)), _mm_set1_ps(cy));
+          ok = _mm_and_ps(ok, _mm_cmpge_ps(uf, _mm_setzero_ps()));
+          ok = _mm_and_ps(ok, _mm_cmplt_ps(uf, _mm_set1_ps((float)refW)));
+          ok = _mm_and_ps(ok, _mm_cmpge_ps(vf, _mm_setzero_ps()));
+          ok = _mm_and_ps(ok, _mm_cmplt_ps(vf, _mm_set1_ps((float)refH)));
+
+          validPoints += __builtin_popcount(_mm_movemask_ps(valid4));
+          if(_mm_movemask_ps(ok) == 0) continue;
+
+          _mm_storeu_si128((__m128i*)ui, _mm_cvttps_epi32(uf));
+          _mm_storeu_si128((__m128i*)vi, _mm_cvttps_epi32(vf));
+          _mm_storeu_ps(px, qx);
+          _mm_storeu_ps(py, qy);
+          _mm_storeu_ps(pz, qz);
+          _mm_storeu_si128((__m128i*)inside, _mm_castps_si128(ok));
+        }else
+#endif
+        {
+          for(int k = 0; k < lanes; ++k){
+            size_t i = i0 + k;
+            inside[k] = 0;
+            if(cvz[i] <= 0.0f) continue;
+            validPoints++;
+            px[k] = r00 * cvx[i] + r01 * cvy[i] + r02 * cvz[i] + t0;
+            py[k] = r10 * cvx[i] + r11 * cvy[i] + r12 * cvz[i] + t1;
+            pz[k] = r20 * cvx[i] + r21 * cvy[i] + r22 * cvz[i] + t2;
+            if(pz[k] <= 1e-4f) continue;
+            float uf = px[k] / pz[k] * fx + cx;
+            float vf = py[k] / pz[k] * fy + cy;
+            if(uf < 0.0f || uf >= refW || vf < 0.0f || vf >= refH) continue;
+            ui[k] = (int32_t)uf;
+            vi[k] = (int32_t)vf;
+            inside[k] = -1;
+          }
+        }
+
+        for(int k = 0; k < lanes; ++k){
+          if(!inside[k]) continue;
+
+          size_t i = i0 + k;
+          size_t j = (size_t)vi[k] * refW + ui[k];
+          if(qvz[j] <= 0.0f) continue;
+
+          float dx = px[k] - qvx[j], dy = py[k] - qvy[j], dz = pz[k] - qvz[j];
+          if(dx * dx + dy * dy + dz * dz > distSq) continue;
+
+          // 법선 호환성 검사 (현재 법선을 기준 프레임으로 회전)
+          const float nx = qnx[j], ny = qny[j], nz = qnz[j];
+          float rnx = r00 * cnx[i] + r01 * cny[i] + r02 * cnz[i];
+          float rny = r10 * cnx[i] + r11 * cny[i] + r12 * cnz[i];
+          float rnz = r20 * cnx[i] + r21 * cny[i] + r22 * cnz[i];
+          if(rnx * nx + rny * ny + rnz * nz < normalThreshold) continue;
+
+          // r = n . (p - q), J = [p x n, n]
+          float r = nx * dx + ny * dy + nz * dz;
+          const float J[6] = {py[k] * nz - pz[k] * ny, pz[k] * nx - px[k] * nz, px[k] * ny - py[k] * nx, nx, ny, nz};
+
+          float* a = acc;
+          for(int row = 0; row < 6; ++row){
+            for(int col = row; col < 6; ++col){
+              *a++ += J[row] * J[col];
+            }
+          }
+          for(int row = 0; row < 6; ++row){
+            *a++ += J[row] * r;
+          }
+          *a += r * r;
+          inliers++;
+        }
+      }
+    }
+
+    std::vector<double>& sum = partial_sums_[thread];
+    for(int e = 0; e < kSumCount; ++e){
+      sum[e] += acc[e];
+    }
+    partial_counts_[thread] += inliers;
+    partial_valid_[thread] += validPoints;
+  });
+
+  std::fill(sums, sums + kSumCount, 0.0);
+  *count = 0;
+  *valid = 0;
+  for(size_t t = 0; t < partial_sums_.size(); ++t){
+    for(int e = 0; e < kSumCount; ++e){
+      sums[e] += partial_sums_[t][e];
+    }
+    *count += partial_counts_[t];
+    *valid += partial_valid_[t];
+  }
+}
+
+void IcpOdometry::setReference(const uint16_t* depth, int width, int height){
+  reference_depth_.assign(depth, depth + (size_t)width * height);
+  reference_width_ = width;
+  reference_height_ = height;
+  reference_pending_ = true;
+  has_reference_ = true;
+}
+
+bool IcpOdometry::track(const uint16_t* depth, int width, int height, const float* prior, IcpResult* result){
+  auto start = std::chrono::steady_clock::now();
+  IcpResult local;
+  IcpResult& res = result ? *result : local;
+  res = IcpResult();
+  setIdentity(res.relative);
+
+  if(!has_reference_ || reference_width_ != width || reference_height_ != height){
+    setReference(depth, width, height);
+    return false;
+  }
+
+  // ORB 추적이 정상인 동안 미뤄 둔 기준 피라미드를 ICP 가 실제로 필요할 때 한 번만 만듦
+  if(reference_pending_){
+    buildPyramid(reference_depth_.data(), width, height, reference_);
+    reference_pending_ = false;
+  }
+  buildPyramid(depth, width, height, current_);
+
+  // 이전 <- 현재 변환 (초기값: prior)
+  Eigen::Matrix4d T = Eigen::Matrix4d::Identity();
+  if(prior){
+    T = Eigen::Map<const Eigen::Matrix4f>(prior).cast<double>();
+  }
+
+  bool solved = false;
+  double sums[kSumCount];
+  int inliers = 0, validPoints = 0;
+
+  for(int level = config_.levels - 1; level >= 0; --level){
+    for(int iter = 0; iter < config_.iterations[level]; ++iter){
+      float Tr[12];
+      for(int r = 0; r < 3; ++r){
+        for(int c = 0; c < 4; ++c){
+          Tr[r * 4 + c] = (float)T(r, c);
+        }
+      }
+
+      reduce(level, Tr, sums, &inliers, &validPoints);
+      res.iterations++;
+      if(inliers < 6){
+        break;
+      }
+
+      Eigen::Matrix<double, 6, 6> A;
+      Eigen::Matrix<double, 6, 1> b;
+      int e = 0;
+      for(int i = 0; i < 6; ++i){
+        for(int j = i; j < 6; ++j){
+          A(i, j) = A(j, i) = sums[e++];
+        }
+        b(i) = sums[21 + i];
+      }
+
+      Eigen::LDLT<Eigen::Matrix<double, 6, 6>> ldlt(A);
+      if(ldlt.info() != Eigen::Success){
+        break;
+      }
+      Eigen::Matrix<double, 6, 1> delta = ldlt.solve(-b);
+      if(!delta.allFinite()){
+        break;
+      }
+
+      // T <- exp(delta) * T
+      Eigen::Vector3d omega = delta.head<3>();
+      double angle = omega.norm();
+      Eigen::Matrix3d dR = angle > 1e-12 ? Eigen::AngleAxisd(angle, omega / angle).toRotationMatrix()
+                                         : Eigen::Matrix3d::Identity();
+      Eigen::Matrix4d dT = Eigen::Matrix4d::Identity();
+      dT.block<3, 3>(0, 0) = dR;
+      dT.block<3, 1>(0, 3) = delta.tail<3>();
+      T = dT * T;
+      solved = true;
+
+      if(angle < 1e-5 && delta.tail<3>().norm() < 1e-5){
+        break;
+      }
+    }
+  }
+
+  // 원본 해상도 마지막 반복의 인라이어 비율로 성공 여부 판단 (별도 검증 패스 생략)
+  res.inlierRatio = validPoints > 0 ? (float)inliers / validPoints : 0.0f;
+  res.residualRms = inliers > 0 ? (float)std::sqrt(sums[27] / inliers) : 0.0f;
+  res.success = solved && res.inlierRatio >= config_.minInlierRatio;
+
+  Eigen::Matrix4f Tf = T.cast<float>();
+  memcpy(res.relative, Tf.data(), sizeof(res.relative));
+
+  // 성공한 경우에만 포즈와 기준 프레임을 함께 갱신
+  // 실패한 프레임을 기준으로 삼으면 다음 상대 변환이 마지막 성공 포즈가 아닌 다른 프레임 기준이 됨
+  if(res.success){
+    Eigen::Map<Eigen::Matrix4f> pose(pose_);
+    pose = pose * Tf;
+    std::swap(reference_, current_);
+  }
+
+  res.timeMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+  return res.success;
+}
+
+void IcpOdometry::setPose(const float Twc[16]){
+  memcpy(pose_, Twc, sizeof(pose_));
+}
+
+void IcpOdometry::getPose(float Twc[16]) const{
+  memcpy(Twc, pose_, sizeof(pose_));
+}
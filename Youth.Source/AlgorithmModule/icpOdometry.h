@@ -0,0 +1,113 @@
+#ifndef ICP_ODOMETRY_H
+#define ICP_ODOMETRY_H
+
+#include "pointCloudExporter.h"
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define ICP_MAX_LEVELS 4
+
+// ICP 오도메트리 설정
+struct IcpConfig{
+  int levels = 3;                                      // 피라미드 단계 수
+  int iterations[ICP_MAX_LEVELS] = {4, 5, 10, 10};      // 단계별 반복 횟수 (0: 원본 해상도)
+  float distanceThreshold = 0.1f;                      // 대응점 최대 거리 (m)
+  float normalThreshold = 0.8f;                        // 대응점 법선 내적 최소값 (cos)
+  float minDepth = 0.2f;                               // 유효 깊이 범위 (m)
+  float maxDepth = 4.0f;
+  float depthDiscontinuity = 0.05f;                    // 다운샘플링 시 불연속 판단 기준 (m)
+  float minInlierRatio = 0.1f;                         // 추적 성공 판단 최소 인라이어 비율
+  int numThreads = 0;                                  // 0 이면 하드웨어 코어 수 사용
+};
+
+// 추적 결과
+struct IcpResult{
+  bool success = false;
+  float relative[16];      // 이전 프레임 <- 현재 프레임 변환 (column-major)
+  float inlierRatio = 0.0f;
+  float residualRms = 0.0f; // 점-평면 잔차 RMS (m)
+  int iterations = 0;
+  float timeMs = 0.0f;
+};
+
+// 피라미드 한 단계 (SoA 정점/법선 맵)
+struct IcpLevel{
+  int width = 0;
+  int height = 0;
+  float fx, fy, cx, cy;
+  std::vector<float> depth;
+  std::vector<float> vx, vy, vz;  // 카메라 좌표 정점 (vz == 0 이면 무효)
+  std::vector<float> nx, ny, nz;  // 법선 (법선을 구할 수 없으면 정점도 무효)
+};
+
+// 깊이 전용 점-평면 ICP 오도메트리
+// 원본 16비트 깊이로 coarse-to-fine 피라미드를 만들고 투영 연관 + 병렬 정규방정식 축적으로 자세를 추정
+class IcpOdometry{
+public:
+  IcpOdometry(const IcpConfig& config, const DenseCameraIntrinsics& intrinsics);
+  ~IcpOdometry();
+
+  IcpOdometry(const IcpOdometry&) = delete;
+  IcpOdometry& operator=(const IcpOdometry&) = delete;
+
+  // 정렬 없이 기준 프레임만 갱신 (다른 포즈 소스가 정상일 때 사용)
+  // 원본 깊이만 복사해 두고 피라미드는 다음 track 에서 필요할 때 만듦
+  void setReference(const uint16_t* depth, int width, int height);
+
+  // 현재 프레임을 기준 프레임에 정렬
+  // prior: 이전 <- 현재 초기 추정 (NULL 이면 단위 행렬)
+  // 성공 시 내부 누적 포즈를 갱신하고 현재 프레임을 새 기준으로 삼음 (실패 시 기준 프레임 유지)
+  bool track(const uint16_t* depth, int width, int height, const float* prior, IcpResult* result);
+
+  // 누적 포즈 (카메라 -> 월드, column-major) 설정/조회
+  void setPose(const float Twc[16]);
+  void getPose(float Twc[16]) const;
+
+  bool hasReference() const{
+    return has_reference_;
+  }
+
+private:
+  void buildPyramid(const uint16_t* depth, int width, int height, std::vector<IcpLevel>& pyramid);
+  void computeVertexNormal(IcpLevel& level);
+  void reduce(int level, const float T[12], double* sums, int* count, int* valid);
+  void parallelFor(int numTasks, const std::function<void(int, int)>& func);
+  void workerLoop(int index);
+
+  IcpConfig config_;
+  DenseCameraIntrinsics intrinsics_;
+  std::vector<IcpLevel> reference_;
+  std::vector<IcpLevel> current_;
+  bool has_reference_ = false;
+
+  // setReference 로 받은 원본 깊이 (reference_ 피라미드가 아직 만들어지지 않았을 때만 유효)
+  std::vector<uint16_t> reference_depth_;
+  int reference_width_ = 0;
+  int reference_height_ = 0;
+  bool reference_pending_ = false;
+  float pose_[16];
+
+  // 상주 작업 스레드 (프레임마다 스레드를 만들지 않음)
+  std::vector<std::thread> workers_;
+  std::mutex pool_mutex_;
+  std::condition_variable pool_cv_;
+  std::condition_variable done_cv_;
+  const std::function<void(int, int)>* job_ = nullptr;
+  int job_tasks_ = 0;
+  std::atomic<int> next_task_{0};
+  int active_workers_ = 0;
+  uint64_t job_generation_ = 0;
+  bool stop_ = false;
+
+  // 스레드별 정규방정식 부분합 (JtJ 21 + Jtr 6 + r^2 1)
+  std::vector<std::vector<double>> partial_sums_;
+  std::vector<int> partial_counts_;
+  std::vector<int> partial_valid_;
+};
+
+#endif // ICP_ODOMETRY_H
@@ -0,0 +1,392 @@
+#include "pointCloudExporter.h"
+#include "../KernelModule/kernelModule.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+// 복셀 해시 샤드 수 (스레드 간 락 경합 분산)
+static const int kVoxelShards = 64;
+
+// 작업 단위 (키프레임 하나를 행 단위 밴드로 분할)
+static const int kRowsPerTask = 32;
+
+// 샤드 버킷을 비우는 기준 포인트 수
+static const size_t kFlushPoints = 4096;
+
+// 복셀 좌표 인덱스 오프셋 (축당 21비트)
+static const int64_t kVoxelOffset = 1 << 20;
+
+// 복셀 누적 값
+struct VoxelAccum{
+  float x, y, z;
+  uint32_t r, g, b;
+  uint32_t count;
+};
+
+struct VoxelShard{
+  std::mutex mutex;
+  std::unordered_map<uint64_t, VoxelAccum> voxels;
+};
+
+// 역투영된 포인트 (샤드로 보내기 전 임시)
+struct LocalPoint{
+  uint64_t key;
+  float x, y, z;
+  uint8_t r, g, b;
+};
+
+struct ExportTask{
+  int keyframe;
+  int rowBegin;
+  int rowEnd;
+};
+
+// 64비트 키 혼합 (샤드 분배용)
+static inline uint64_t mixVoxelKey(uint64_t key){
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdULL;
+  key ^= key >> 33;
+  return key;
+}
+
+static inline uint64_t makeVoxelKey(float x, float y, float z, float invLeaf){
+  uint64_t ix = (uint64_t)((int64_t)std::floor(x * invLeaf) + kVoxelOffset) & 0x1FFFFF;
+  uint64_t iy = (uint64_t)((int64_t)std::floor(y * invLeaf) + kVoxelOffset) & 0x1FFFFF;
+  uint64_t iz = (uint64_t)((int64_t)std::floor(z * invLeaf) + kVoxelOffset) & 0x1FFFFF;
+  return (ix << 42) | (iy << 21) | iz;
+}
+
+// 버킷의 포인트를 샤드에 병합
+static void flushBucket(VoxelShard& shard, std::vector<LocalPoint>& bucket){
+  if(bucket.empty()) return;
+
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  for(const LocalPoint& p : bucket){
+    auto it = shard.voxels.find(p.key);
+    if(it == shard.voxels.end()){
+      VoxelAccum acc = {p.x, p.y, p.z, p.r, p.g, p.b, 1};
+      shard.voxels.emplace(p.key, acc);
+    }else{
+      VoxelAccum& acc = it->second;
+      acc.x += p.x;
+      acc.y += p.y;
+      acc.z += p.z;
+      acc.r += p.r;
+      acc.g += p.g;
+      acc.b += p.b;
+      acc.count++;
+    }
+  }
+  bucket.clear();
+}
+
+// 키프레임 일부 행을 역투영하여 샤드에 누적 (T: 키프레임 자세, column-major Twc)
+// 카메라 좌표 역투영은 KernelModule 의 광선 테이블 + SIMD 커널 사용 (무효 깊이는 압축으로 제거)
+static uint64_t backProjectTask(const DenseKeyFrame& kf, const float* T, const ExportTask& task,
+                                const RayTable& table, const DenseExportOptions& options, PointBuffer& points,
+                                std::vector<VoxelShard>& shards, std::vector<std::vector<LocalPoint>>& buckets){
+  const float invLeaf = 1.0f / options.leafSize;
+  const bool hasColor = kf.color.size() >= (size_t)kf.width * kf.height * 3;
+
+  points.count = 0;
+  unprojectDepthRows(&table, kf.depth.data(), hasColor ? kf.color.data() : nullptr, options.minDepth,
+                     options.maxDepth, task.rowBegin, task.rowEnd, KERNEL_UNPROJECT_COMPACT, &points);
+
+  // 커널은 RGB 순서로 채우므로 BGR 키프레임은 채널을 바꿔 읽음
+  const uint8_t* red = kf.colorIsBGR ? points.b : points.r;
+  const uint8_t* blue = kf.colorIsBGR ? points.r : points.b;
+
+  for(size_t i = 0; i < points.count; ++i){
+    const float xc = points.x[i], yc = points.y[i], zc = points.z[i];
+
+    // 월드 좌표계 (column-major)
+    float xw = T[0] * xc + T[4] * yc + T[8] * zc + T[12];
+    float yw = T[1] * xc + T[5] * yc + T[9] * zc + T[13];
+    float zw = T[2] * xc + T[6] * yc + T[10] * zc + T[14];
+
+    LocalPoint p;
+    p.key = makeVoxelKey(xw, yw, zw, invLeaf);
+    p.x = xw;
+    p.y = yw;
+    p.z = zw;
+    if(hasColor){
+      p.r = red[i];
+      p.g = points.g[i];
+      p.b = blue[i];
+    }else{
+      p.r = p.g = p.b = 255;
+    }
+
+    int s = (int)(mixVoxelKey(p.key) % kVoxelShards);
+    buckets[s].push_back(p);
+    if(buckets[s].size() >= kFlushPoints){
+      flushBucket(shards[s], buckets[s]);
+    }
+  }
+
+  return points.count;
+}
+
+// 큰 버퍼를 사용하는 순차 파일 쓰기
+class StreamWriter{
+public:
+  explicit StreamWriter(FILE* file) : file_(file){
+    buffer_.reserve(1 << 20);
+  }
+
+  ~StreamWriter(){
+    flush();
+  }
+
+  void write(const void* data, size_t size){
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    buffer_.insert(buffer_.end(), bytes, bytes + size);
+    if(buffer_.size() >= (1 << 20)){
+      flush();
+    }
+  }
+
+  void flush(){
+    if(!buffer_.empty()){
+      if(fwrite(buffer_.data(), 1, buffer_.size(), file_) != buffer_.size()){
+        ok_ = false;
+      }
+      buffer_.clear();
+    }
+  }
+
+  bool ok() const{
+    return ok_;
+  }
+
+private:
+  FILE* file_;
+  std::vector<uint8_t> buffer_;
+  bool ok_ = true;
+};
+
+static void writeHeader(FILE* file, DenseMapFormat format, uint64_t count){
+  if(format == DENSE_MAP_FORMAT_PCD){
+    fprintf(file,
+            "# .PCD v0.7 - Point Cloud Data file format\n"
+            "VERSION 0.7\n"
+            "FIELDS x y z rgb\n"
+            "SIZE 4 4 4 4\n"
+            "TYPE F F F F\n"
+            "COUNT 1 1 1 1\n"
+            "WIDTH %llu\n"
+            "HEIGHT 1\n"
+            "VIEWPOINT 0 0 0 1 0 0 0\n"
+            "POINTS %llu\n"
+            "DATA binary\n",
+            (unsigned long long)count, (unsigned long long)count);
+  }else{
+    fprintf(file,
+            "ply\n"
+            "format binary_little_endian 1.0\n"
+            "comment Youth dense map\n"
+            "element vertex %llu\n"
+            "property float x\n"
+            "property float y\n"
+            "property float z\n"
+            "property uchar red\n"
+            "property uchar green\n"
+            "property uchar blue\n"
+            "end_header\n",
+            (unsigned long long)count);
+  }
+}
+
+DenseMapFormat denseMapFormatFromPath(const std::string& path){
+  if(path.size() >= 4){
+    std::string ext = path.substr(path.size() - 4);
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    if(ext == ".pcd"){
+      return DENSE_MAP_FORMAT_PCD;
+    }
+  }
+  return DENSE_MAP_FORMAT_PLY;
+}
+
+int exportDensePointCloud(const std::vector<std::shared_ptr<const DenseKeyFrame>>& keyframes,
+                          const DenseCameraIntrinsics& intrinsics, const DenseExportOptions& options,
+                          const std::string& path, DenseExportStats* stats){
+  return exportDensePointCloud(keyframes, std::vector<float>(), intrinsics, options, path, stats);
+}
+
+int exportDensePointCloud(const std::vector<std::shared_ptr<const DenseKeyFrame>>& keyframes,
+                          const std::vector<float>& poses, const DenseCameraIntrinsics& intrinsics,
+                          const DenseExportOptions& options, const std::string& path, DenseExportStats* stats){
+  const bool overridePoses = poses.size() == keyframes.size() * 16;
+  if(options.leafSize <= 0.0f){
+    std::cerr << "Invalid voxel leaf size: " << options.leafSize << std::endl;
+    return 0;
+  }
+
+  auto startTime = std::chrono::steady_clock::now();
+
+  // 해상도별 광선 테이블 (키프레임마다 다시 계산하지 않음)
+  CameraIntrinsics K = {};
+  K.fx = intrinsics.fx;
+  K.fy = intrinsics.fy;
+  K.cx = intrinsics.cx;
+  K.cy = intrinsics.cy;
+  K.depthFactor = intrinsics.depthFactor;
+  std::map<std::pair<int, int>, RayTable> rayTables;
+  int maxWidth = 0;
+
+  // 작업 목록 생성
+  std::vector<ExportTask> tasks;
+  for(size_t i = 0; i < keyframes.size(); ++i){
+    const DenseKeyFrame* kf = keyframes[i].get();
+    if(!kf || kf->width <= 0 || kf->height <= 0 || kf->depth.size() < (size_t)kf->width * kf->height){
+      continue;
+    }
+
+    // 내부 파라미터는 키프레임 해상도 기준이므로 스케일 조정 없이 그대로 사용
+    std::pair<int, int> resolution(kf->width, kf->height);
+    if(rayTables.find(resolution) == rayTables.end()){
+      K.width = kf->width;
+      K.height = kf->height;
+      RayTable table;
+      if(!createRayTable(&table, &K, kf->width, kf->height)){
+        continue;
+      }
+      rayTables[resolution] = table;
+    }
+    maxWidth = std::max(maxWidth, kf->width);
+
+    for(int row = 0; row < kf->height; row += kRowsPerTask){
+      tasks.push_back({(int)i, row, std::min(row + kRowsPerTask, kf->height)});
+    }
+  }
+
+  int numThreads = options.numThreads > 0 ? options.numThreads : (int)std::thread::hardware_concurrency();
+  numThreads = std::max(1, std::min(numThreads, (int)std::max<size_t>(tasks.size(), 1)));
+
+  // 병렬 역투영 + 복셀 누적
+  std::vector<VoxelShard> shards(kVoxelShards);
+  std::atomic<size_t> nextTask(0);
+  std::atomic<uint64_t> inputPoints(0);
+
+  auto worker = [&](){
+    std::vector<std::vector<LocalPoint>> buckets(kVoxelShards);
+    for(auto& bucket : buckets){
+      bucket.reserve(kFlushPoints);
+    }
+
+    // 작업 하나 (kRowsPerTask 행) 분량의 SoA 포인트 버퍼
+    PointBuffer points;
+    if(!allocPointBuffer(&points, (size_t)kRowsPerTask * std::max(maxWidth, 1))){
+      std::cerr << "Failed to allocate point buffer" << std::endl;
+      return;
+    }
+
+    uint64_t produced = 0;
+    size_t index;
+    while((index = nextTask.fetch_add(1)) < tasks.size()){
+      const ExportTask& task = tasks[index];
+      const DenseKeyFrame& kf = *keyframes[task.keyframe];
+      const RayTable& table = rayTables.at(std::make_pair(kf.width, kf.height));
+      const float* T = overridePoses ? &poses[(size_t)task.keyframe * 16] : kf.Twc;
+      produced += backProjectTask(kf, T, task, table, options, points, shards, buckets);
+    }
+
+    for(int s = 0; s < kVoxelShards; ++s){
+      flushBucket(shards[s], buckets[s]);
+    }
+    freePointBuffer(&points);
+    inputPoints += produced;
+  };
+
+  std::vector<std::thread> workers;
+  for(int t = 1; t < numThreads; ++t){
+    workers.emplace_back(worker);
+  }
+  worker();
+  for(auto& th : workers){
+    th.join();
+  }
+
+  auto projectTime = std::chrono::steady_clock::now();
+
+  for(auto& entry : rayTables){
+    destroyRayTable(&entry.second);
+  }
+
+  uint64_t outputPoints = 0;
+  for(const VoxelShard& shard : shards){
+    outputPoints += shard.voxels.size();
+  }
+
+  // 스트리밍 쓰기
+  FILE* file = fopen(path.c_str(), "wb");
+  if(!file){
+    perror("Failed to open dense map file");
+    return 0;
+  }
+
+  writeHeader(file, options.format, outputPoints);
+
+  bool writeOk;
+  {
+    StreamWriter writer(file);
+    for(VoxelShard& shard : shards){
+      for(const auto& entry : shard.voxels){
+        const VoxelAccum& acc = entry.second;
+        float inv = 1.0f / acc.count;
+        float xyz[3] = {acc.x * inv, acc.y * inv, acc.z * inv};
+        uint8_t r = (uint8_t)(acc.r / acc.count);
+        uint8_t g = (uint8_t)(acc.g / acc.count);
+        uint8_t b = (uint8_t)(acc.b / acc.count);
+
+        writer.write(xyz, sizeof(xyz));
+        if(options.format == DENSE_MAP_FORMAT_PCD){
+          uint32_t packed = ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+          writer.write(&packed, sizeof(packed));
+        }else{
+          uint8_t rgb[3] = {r, g, b};
+          writer.write(rgb, sizeof(rgb));
+        }
+      }
+
+      // 쓰기가 끝난 샤드는 즉시 해제
+      std::unordered_map<uint64_t, VoxelAccum>().swap(shard.voxels);
+    }
+    writer.flush();
+    writeOk = writer.ok();
+  }
+
+  fclose(file);
+
+  auto endTime = std::chrono::steady_clock::now();
+  double projectSec = std::chrono::duration<double>(projectTime - startTime).count();
+  double totalSec = std::chrono::duration<double>(endTime - startTime).count();
+
+  std::cout << "Dense map export: " << keyframes.size() << " keyframes, " << inputPoints.load() << " points -> "
+            << outputPoints << " voxels (leaf " << options.leafSize << " m, " << numThreads << " threads)" << std::endl;
+  std::cout << "  back-projection " << (projectSec > 0.0 ? inputPoints.load() / projectSec : 0.0) << " points/s, total "
+            << (totalSec > 0.0 ? inputPoints.load() / totalSec : 0.0) << " points/s (" << totalSec << " s)" << std::endl;
+
+  if(stats){
+    stats->inputPoints = inputPoints.load();
+    stats->outputPoints = outputPoints;
+    stats->seconds = totalSec;
+  }
+
+  if(!writeOk){
+    std::cerr << "Error writing dense map to " << path << std::endl;
+    return 0;
+  }
+
+  std::cout << "Dense map saved to " << path << std::endl;
+  return 1;
+}
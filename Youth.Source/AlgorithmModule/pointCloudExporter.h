@@ -0,0 +1,67 @@
+#ifndef POINT_CLOUD_EXPORTER_H
+#define POINT_CLOUD_EXPORTER_H
+
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+// 카메라 내부 파라미터 (핀홀 모델)
+struct DenseCameraIntrinsics{
+  float fx = 570.3f;
+  float fy = 570.3f;
+  float cx = 320.0f;
+  float cy = 240.0f;
+  float depthFactor = 1000.0f; // 깊이 값 -> 미터 변환 계수 (DepthMapFactor)
+};
+
+// 덴스 키프레임 (포즈 + 깊이 + 색상)
+struct DenseKeyFrame{
+  double timestamp = 0.0;
+  float Twc[16];              // 카메라 -> 월드 변환 (column-major 4x4)
+  int width = 0;
+  int height = 0;
+  std::vector<uint16_t> depth; // 원본 16비트 깊이
+  std::vector<uint8_t> color;  // 픽셀당 3바이트 색상
+  bool colorIsBGR = true;      // OpenCV 순서로 저장된 경우 true
+};
+
+// 출력 파일 형식
+enum DenseMapFormat{
+  DENSE_MAP_FORMAT_PLY = 0,
+  DENSE_MAP_FORMAT_PCD = 1
+};
+
+// 내보내기 옵션
+struct DenseExportOptions{
+  float leafSize = 0.01f;  // 복셀 다운샘플링 크기 (m)
+  float minDepth = 0.2f;   // 유효 깊이 범위 (m)
+  float maxDepth = 5.0f;
+  int numThreads = 0;      // 0 이면 하드웨어 코어 수 사용
+  DenseMapFormat format = DENSE_MAP_FORMAT_PLY;
+};
+
+// 내보내기 결과 통계
+struct DenseExportStats{
+  uint64_t inputPoints = 0;   // 역투영된 유효 포인트 수
+  uint64_t outputPoints = 0;  // 다운샘플링 후 저장된 포인트 수
+  double seconds = 0.0;       // 전체 소요 시간
+};
+
+// 키프레임들을 병렬로 역투영하고 복셀 해시로 다운샘플링하여 바이너리 PLY/PCD 로 저장
+// 원본 포인트는 작은 청크 단위로만 존재하므로 전체 맵을 메모리에 올리지 않음
+// 반환값: 성공 시 1, 실패 시 0
+int exportDensePointCloud(const std::vector<std::shared_ptr<const DenseKeyFrame>>& keyframes,
+                          const DenseCameraIntrinsics& intrinsics, const DenseExportOptions& options,
+                          const std::string& path, DenseExportStats* stats);
+
+// 키프레임에 저장된 자세 대신 poses (키프레임마다 column-major Twc 16 개) 로 내보냄
+// 루프 폐쇄 등으로 다시 계산한 자세를 영상 복사 없이 적용할 때 사용 (크기가 맞지 않으면 저장된 자세 사용)
+int exportDensePointCloud(const std::vector<std::shared_ptr<const DenseKeyFrame>>& keyframes,
+                          const std::vector<float>& poses, const DenseCameraIntrinsics& intrinsics,
+                          const DenseExportOptions& options, const std::string& path, DenseExportStats* stats);
+
+// 파일 확장자로 출력 형식 결정 (.pcd 이면 PCD, 나머지는 PLY)
+DenseMapFormat denseMapFormatFromPath(const std::string& path);
+
+#endif // POINT_CLOUD_EXPORTER_H
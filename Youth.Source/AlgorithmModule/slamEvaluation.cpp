@@ -0,0 +1,399 @@
+// SLAM 오프라인 평가 도구
+// .bin 녹화 파일을 락스텝 모드로 processSlamFrame 에 최대 속도로 입력하고
+// ATE/RPE (정답 궤적이 있는 경우) 및 프레임당 추적 시간, 처리 FPS 를 JSON 으로 저장
+// (ORB-SLAM3 가 표준 출력에 로그를 남기므로 리포트는 항상 파일로, 기본 slam_evaluation.json)
+//
+// 사용법: SlamEvaluation <recording.bin> [--config file] [--vocab file] [--gt groundtruth.txt]
+//                        [--out report.json] [--traj estimated.txt] [--rpe-delta seconds]
+
+#include "SLAM.h"
+#include "../frameDefinitions.h"
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// 녹화 타임스템프는 uint32 밀리초라 약 49.7 일마다 0 으로 돌아감
+static const double kTimestampWrapMs = 4294967296.0;
+
+// 추적된 포즈 기록
+struct PoseRecord{
+  double timestamp;
+  int state;
+  float trackMs;
+  Eigen::Matrix4d Twc;
+};
+
+struct EvalState{
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<PoseRecord> poses;
+};
+
+static void onSlamPose(double timestamp, int tracking_state, const float* Twc, float track_ms, void* user_data){
+  EvalState* state = static_cast<EvalState*>(user_data);
+
+  PoseRecord record;
+  record.timestamp = timestamp;
+  record.state = tracking_state;
+  record.trackMs = track_ms;
+  record.Twc = Eigen::Map<const Eigen::Matrix4f>(Twc).cast<double>();
+
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->poses.push_back(record);
+  }
+  state->cv.notify_all();
+}
+
+// TUM 형식 궤적 읽기 (timestamp tx ty tz qx qy qz qw)
+static bool loadTumTrajectory(const std::string& path, std::vector<std::pair<double, Eigen::Matrix4d>>* trajectory){
+  std::ifstream file(path);
+  if(!file.is_open()){
+    std::cerr << "Failed to open ground truth: " << path << std::endl;
+    return false;
+  }
+
+  std::string line;
+  while(std::getline(file, line)){
+    if(line.empty() || line[0] == '#') continue;
+
+    std::istringstream iss(line);
+    double t, tx, ty, tz, qx, qy, qz, qw;
+    if(!(iss >> t >> tx >> ty >> tz >> qx >> qy >> qz >> qw)) continue;
+
+    Eigen::Matrix4d T = Eigen::Matrix4d::Identity();
+    T.block<3, 3>(0, 0) = Eigen::Quaterniond(qw, qx, qy, qz).normalized().toRotationMatrix();
+    T.block<3, 1>(0, 3) = Eigen::Vector3d(tx, ty, tz);
+    trajectory->emplace_back(t, T);
+  }
+
+  std::sort(trajectory->begin(), trajectory->end(),
+            [](const std::pair<double, Eigen::Matrix4d>& a, const std::pair<double, Eigen::Matrix4d>& b){
+              return a.first < b.first;
+            });
+  return !trajectory->empty();
+}
+
+// 녹화 파일 타임스템프 (돌아감을 푼 밀리초) -> 정답 궤적과 같은 기준의 초
+// 녹화에는 밀리초의 하위 32 비트만 있으므로, 정답 궤적 시작과 가장 가까워지는 돌아감 횟수를 더해 복원
+// gtStart 가 0 이면 (정답 궤적 없음) 녹화 타임스템프 그대로
+static std::vector<double> recordingSeconds(const std::vector<double>& frameMs, double gtStart){
+  double wraps = 0.0;
+  if(!frameMs.empty() && gtStart > 0.0){
+    wraps = std::round((gtStart * 1000.0 - frameMs.front()) / kTimestampWrapMs);
+  }
+  std::vector<double> seconds(frameMs.size());
+  for(size_t i = 0; i < frameMs.size(); ++i){
+    seconds[i] = (frameMs[i] + wraps * kTimestampWrapMs) / 1000.0;
+  }
+  return seconds;
+}
+
+static void saveTumTrajectory(const std::string& path, const std::vector<PoseRecord>& poses){
+  std::ofstream file(path);
+  if(!file.is_open()){
+    std::cerr << "Failed to open trajectory output: " << path << std::endl;
+    return;
+  }
+
+  file.setf(std::ios::fixed);
+  for(const PoseRecord& p : poses){
+    Eigen::Quaterniond q(p.Twc.block<3, 3>(0, 0));
+    Eigen::Vector3d t = p.Twc.block<3, 1>(0, 3);
+    file.precision(6);
+    file << p.timestamp << " ";
+    file.precision(7);
+    file << t.x() << " " << t.y() << " " << t.z() << " " << q.x() << " " << q.y() << " " << q.z() << " " << q.w()
+         << "\n";
+  }
+}
+
+static double percentile(std::vector<double> values, double p){
+  if(values.empty()) return 0.0;
+  std::sort(values.begin(), values.end());
+  double rank = p / 100.0 * (values.size() - 1);
+  size_t lo = (size_t)std::floor(rank);
+  size_t hi = std::min(lo + 1, values.size() - 1);
+  return values[lo] + (values[hi] - values[lo]) * (rank - lo);
+}
+
+static double rotationAngleDeg(const Eigen::Matrix3d& R){
+  double c = std::max(-1.0, std::min(1.0, (R.trace() - 1.0) * 0.5));
+  return std::acos(c) * 180.0 / M_PI;
+}
+
+struct ErrorSummary{
+  int count = 0;
+  double rmse = 0.0;
+  double mean = 0.0;
+  double median = 0.0;
+  double max = 0.0;
+};
+
+static ErrorSummary summarize(const std::vector<double>& errors){
+  ErrorSummary s;
+  s.count = (int)errors.size();
+  if(errors.empty()) return s;
+
+  double sum = 0.0, sq = 0.0;
+  for(double e : errors){
+    sum += e;
+    sq += e * e;
+    s.max = std::max(s.max, e);
+  }
+  s.mean = sum / errors.size();
+  s.rmse = std::sqrt(sq / errors.size());
+  s.median = percentile(errors, 50.0);
+  return s;
+}
+
+static void writeSummary(std::ostream& out, const char* name, const ErrorSummary& s, bool last){
+  out << "    \"" << name << "\": {\"count\": " << s.count << ", \"rmse\": " << s.rmse << ", \"mean\": " << s.mean
+      << ", \"median\": " << s.median << ", \"max\": " << s.max << "}" << (last ? "\n" : ",\n");
+}
+
+int main(int argc, char** argv){
+  if(argc < 2){
+    std::cerr << "Usage: " << argv[0] << " <recording.bin> [--config file] [--vocab file] [--gt groundtruth.txt]"
+              << " [--out report.json] [--traj estimated.txt] [--rpe-delta seconds]" << std::endl;
+    return 1;
+  }
+
+  std::string recordingPath = argv[1];
+  std::string configPath = "config/astra_orb_slam3_rgbd.yaml";
+  std::string vocabPath = "config/ORBvoc.txt";
+  std::string outPath = "slam_evaluation.json";
+  std::string gtPath, trajPath;
+  double rpeDelta = 1.0;
+  const double maxTimeDiff = 0.02;
+
+  for(int i = 2; i < argc; ++i){
+    std::string arg = argv[i];
+    if(i + 1 >= argc){
+      std::cerr << "Missing value for " << arg << std::endl;
+      return 1;
+    }
+    if(arg == "--config") configPath = argv[++i];
+    else if(arg == "--vocab") vocabPath = argv[++i];
+    else if(arg == "--gt") gtPath = argv[++i];
+    else if(arg == "--out") outPath = argv[++i];
+    else if(arg == "--traj") trajPath = argv[++i];
+    else if(arg == "--rpe-delta") rpeDelta = atof(argv[++i]);
+    else{
+      std::cerr << "Unknown option: " << arg << std::endl;
+      return 1;
+    }
+  }
+
+  FILE* recording = fopen(recordingPath.c_str(), "rb");
+  if(!recording){
+    perror("Failed to open recording");
+    return 1;
+  }
+
+  // 비대화형 설정: 시각화 끄고 락스텝 모드 사용
+  EvalState state;
+  setSlamVisualization(0);
+  initSlamModule(configPath.c_str(), vocabPath.c_str());
+  if(!isSlamModuleRunning()){
+    fclose(recording);
+    return 1;
+  }
+  setSlamLockstepMode(1);
+  setSlamPoseCallback(onSlamPose, &state);
+
+  // 녹화 파일 스트리밍
+  std::vector<char> depthBuffer, colorBuffer;
+  FrameHeader header;
+  size_t submitted = 0;
+  std::vector<double> frameMs;   // 제출한 프레임의 타임스템프 (돌아감을 푼 밀리초, 제출 순서)
+  double wrapOffset = 0.0;
+  uint32_t lastTimestamp = 0;
+  auto start = std::chrono::steady_clock::now();
+
+  while(fread(&header, sizeof(FrameHeader), 1, recording) == 1){
+    if(header.frameType == FRAME_TYPE_END_OF_FILE) break;
+    if(header.frameType != FRAME_TYPE_DEPTH_COLOR) continue;
+
+    depthBuffer.resize(header.depthDataSize);
+    colorBuffer.resize(header.colorDataSize);
+    if(fread(depthBuffer.data(), 1, header.depthDataSize, recording) != header.depthDataSize ||
+       fread(colorBuffer.data(), 1, header.colorDataSize, recording) != header.colorDataSize){
+      std::cerr << "Truncated frame " << header.frameId << std::endl;
+      break;
+    }
+
+    if(processSlamFrame((const int16_t*)depthBuffer.data(), (const uint8_t*)colorBuffer.data(), header.width,
+                        header.height, header.timestamp)){
+      // 절반 이상 뒤로 가면 돌아간 것으로 봄
+      if(!frameMs.empty() && header.timestamp < lastTimestamp && lastTimestamp - header.timestamp > 0x80000000u){
+        wrapOffset += kTimestampWrapMs;
+      }
+      lastTimestamp = header.timestamp;
+      frameMs.push_back(header.timestamp + wrapOffset);
+      submitted++;
+    }
+  }
+  fclose(recording);
+
+  // 남은 프레임 추적 완료 대기
+  {
+    std::unique_lock<std::mutex> lock(state.mutex);
+    state.cv.wait_for(lock, std::chrono::seconds(30), [&]{ return state.poses.size() >= submitted; });
+  }
+  double wallSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  setSlamPoseCallback(NULL, NULL);
+  stopSlamModule();
+
+  std::vector<PoseRecord> poses;
+  {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    poses = state.poses;
+  }
+
+  // 정답 궤적 읽기 (포즈 타임스템프를 정답 궤적 기준 초로 바꾸는 데도 사용)
+  std::vector<std::pair<double, Eigen::Matrix4d>> gt;
+  bool hasGroundTruth = !gtPath.empty() && loadTumTrajectory(gtPath, &gt);
+
+  // 포즈 콜백의 타임스템프는 돌아간 uint32 밀리초를 초로 바꾼 값이므로 녹화 타임스템프로 교체
+  // 락스텝 모드는 프레임을 버리지 않고 추적 스레드 하나가 순서대로 처리하므로 i 번째 포즈가 i 번째 프레임
+  std::vector<double> seconds = recordingSeconds(frameMs, hasGroundTruth ? gt.front().first : 0.0);
+  size_t mismatched = 0;
+  for(size_t i = 0; i < poses.size() && i < seconds.size(); ++i){
+    uint32_t wrapped = (uint32_t)std::llround(std::fmod(frameMs[i], kTimestampWrapMs));
+    if((uint32_t)std::llround(poses[i].timestamp * 1000.0) != wrapped){
+      mismatched++;
+    }
+    poses[i].timestamp = seconds[i];
+  }
+  if(mismatched > 0){
+    std::cerr << mismatched << " poses do not match their recording frame timestamps" << std::endl;
+  }
+  if(hasGroundTruth && !seconds.empty() &&
+     (seconds.back() < gt.front().first - 1.0 || seconds.front() > gt.back().first + 1.0)){
+    std::cerr << "Recording " << seconds.front() << " ~ " << seconds.back() << " s does not overlap ground truth "
+              << gt.front().first << " ~ " << gt.back().first << " s" << std::endl;
+  }
+
+  // 추적 시간 통계
+  std::vector<double> trackTimes;
+  std::vector<PoseRecord> tracked;
+  for(const PoseRecord& p : poses){
+    trackTimes.push_back(p.trackMs);
+    if(p.state == SLAM_TRACKING_OK){
+      tracked.push_back(p);
+    }
+  }
+  double trackMean = 0.0;
+  for(double t : trackTimes) trackMean += t;
+  if(!trackTimes.empty()) trackMean /= trackTimes.size();
+
+  if(!trajPath.empty()){
+    saveTumTrajectory(trajPath, tracked);
+  }
+
+  // 정답 궤적 기반 ATE / RPE
+  ErrorSummary ate, rpeTrans, rpeRot;
+  if(hasGroundTruth){
+    // 타임스템프 연관 (가장 가까운 정답 포즈)
+    std::vector<const PoseRecord*> estAssoc;
+    std::vector<const Eigen::Matrix4d*> gtAssoc;
+    for(const PoseRecord& p : tracked){
+      auto it = std::lower_bound(gt.begin(), gt.end(), p.timestamp,
+                                 [](const std::pair<double, Eigen::Matrix4d>& g, double t){ return g.first < t; });
+      const std::pair<double, Eigen::Matrix4d>* best = nullptr;
+      if(it != gt.end()) best = &*it;
+      if(it != gt.begin() && (!best || std::fabs((it - 1)->first - p.timestamp) < std::fabs(best->first - p.timestamp))){
+        best = &*(it - 1);
+      }
+      if(best && std::fabs(best->first - p.timestamp) <= maxTimeDiff){
+        estAssoc.push_back(&p);
+        gtAssoc.push_back(&best->second);
+      }
+    }
+
+    if(estAssoc.size() >= 3){
+      // 강체 정렬 (Umeyama, 스케일 없음)
+      Eigen::Matrix3Xd src(3, estAssoc.size()), dst(3, estAssoc.size());
+      for(size_t i = 0; i < estAssoc.size(); ++i){
+        src.col(i) = estAssoc[i]->Twc.block<3, 1>(0, 3);
+        dst.col(i) = gtAssoc[i]->block<3, 1>(0, 3);
+      }
+      Eigen::Matrix4d align = Eigen::umeyama(src, dst, false);
+
+      std::vector<double> ateErrors;
+      for(size_t i = 0; i < estAssoc.size(); ++i){
+        Eigen::Vector3d aligned = align.block<3, 3>(0, 0) * src.col(i) + align.block<3, 1>(0, 3);
+        ateErrors.push_back((aligned - dst.col(i)).norm());
+      }
+      ate = summarize(ateErrors);
+
+      // 상대 포즈 오차 (rpeDelta 초 간격)
+      std::vector<double> transErrors, rotErrors;
+      size_t j = 0;
+      for(size_t i = 0; i < estAssoc.size(); ++i){
+        j = std::max(j, i + 1);
+        while(j < estAssoc.size() && estAssoc[j]->timestamp - estAssoc[i]->timestamp < rpeDelta) j++;
+        if(j >= estAssoc.size()) break;
+
+        Eigen::Matrix4d estDelta = estAssoc[i]->Twc.inverse() * estAssoc[j]->Twc;
+        Eigen::Matrix4d gtDelta = gtAssoc[i]->inverse() * (*gtAssoc[j]);
+        Eigen::Matrix4d error = gtDelta.inverse() * estDelta;
+        transErrors.push_back(error.block<3, 1>(0, 3).norm());
+        rotErrors.push_back(rotationAngleDeg(error.block<3, 3>(0, 0)));
+      }
+      rpeTrans = summarize(transErrors);
+      rpeRot = summarize(rotErrors);
+    }else{
+      std::cerr << "Not enough associated poses for ATE/RPE (" << estAssoc.size() << ")" << std::endl;
+    }
+  }
+
+  // JSON 리포트
+  std::ostringstream json;
+  json.setf(std::ios::fixed);
+  json.precision(6);
+  json << "{\n";
+  json << "  \"recording\": \"" << recordingPath << "\",\n";
+  json << "  \"frames_submitted\": " << submitted << ",\n";
+  json << "  \"frames_processed\": " << poses.size() << ",\n";
+  json << "  \"frames_tracked\": " << tracked.size() << ",\n";
+  json << "  \"wall_time_s\": " << wallSec << ",\n";
+  json << "  \"fps\": " << (wallSec > 0.0 ? poses.size() / wallSec : 0.0) << ",\n";
+  json << "  \"track_time_ms\": {\"mean\": " << trackMean << ", \"p50\": " << percentile(trackTimes, 50.0)
+       << ", \"p90\": " << percentile(trackTimes, 90.0) << ", \"p95\": " << percentile(trackTimes, 95.0)
+       << ", \"p99\": " << percentile(trackTimes, 99.0) << ", \"max\": " << percentile(trackTimes, 100.0) << "},\n";
+  if(hasGroundTruth){
+    json << "  \"accuracy\": {\n";
+    writeSummary(json, "ate_m", ate, false);
+    writeSummary(json, "rpe_trans_m", rpeTrans, false);
+    writeSummary(json, "rpe_rot_deg", rpeRot, false);
+    json << "    \"rpe_delta_s\": " << rpeDelta << "\n";
+    json << "  }\n";
+  }else{
+    json << "  \"accuracy\": null\n";
+  }
+  json << "}\n";
+
+  std::ofstream out(outPath);
+  if(!out.is_open()){
+    std::cerr << "Failed to open report output: " << outPath << std::endl;
+    return 1;
+  }
+  out << json.str();
+  std::cout << "Evaluation report written to " << outPath << std::endl;
+
+  return submitted == poses.size() ? 0 : 2;
+}
@@ -0,0 +1,92 @@
+// 원격 SLAM 수신기
+// 캡처 보드의 Youth --offload 가 보낸 RGB-D 프레임을 processSlamFrame 으로 추적하고 자세를 같은 연결로 돌려줌
+//
+// 사용법: SlamReceiver <ORBvoc.txt> [port] [--config file] [--viewer]
+
+#include "SLAM.h"
+#include "../TransportModule/transportModule.h"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static volatile int keepRunning = 1;
+
+static void intHandler(int dummy){
+  (void)dummy;
+  keepRunning = 0;
+}
+
+static void forwardFrameToSlam(const int16_t* depth, const uint8_t* color, int width, int height, uint32_t frame_id,
+                               uint32_t timestamp, void* user_data){
+  (void)frame_id;
+  (void)user_data;
+  processSlamFrame(depth, color, width, height, timestamp);
+}
+
+static void forwardSlamPose(double timestamp, int tracking_state, const float* Twc, float track_ms, void* user_data){
+  (void)user_data;
+  sendReceiverPose(timestamp, tracking_state, Twc, track_ms);
+}
+
+int main(int argc, char** argv){
+  if(argc < 2){
+    fprintf(stderr, "Usage: %s <ORBvoc.txt> [port] [--config file] [--viewer]\n", argv[0]);
+    return 1;
+  }
+
+  const char* vocabularyFile = argv[1];
+  const char* configFile = "config/astra_orb_slam3_rgbd.yaml";
+  int port = TRANSPORT_DEFAULT_PORT;
+  int visualization = 0;
+  for(int i = 2; i < argc; ++i){
+    if(strcmp(argv[i], "--config") == 0 && i + 1 < argc){
+      configFile = argv[++i];
+    }else if(strcmp(argv[i], "--viewer") == 0){
+      visualization = 1;
+    }else{
+      port = atoi(argv[i]);
+    }
+  }
+
+  struct sigaction sa;
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = intHandler;
+  sigaction(SIGINT, &sa, NULL);
+  sigaction(SIGTERM, &sa, NULL);
+
+  setSlamVisualization(visualization);
+  initSlamModule(configFile, vocabularyFile);
+  if(!isSlamModuleRunning()){
+    fprintf(stderr, "SLAM failed to initialize\n");
+    return 1;
+  }
+  setSlamPoseCallback(forwardSlamPose, NULL);
+
+  // 추적이 따라올 때까지 수신 스레드를 막음 (SLAM 큐에서 프레임을 버리지 않고, 밀린 만큼 송신 측 보관함이
+  // 오래된 프레임을 버리게 함)
+  setSlamLockstepMode(1);
+
+  if(!initFrameReceiver(port, forwardFrameToSlam, NULL)){
+    stopSlamModule();
+    return 1;
+  }
+
+  // 5 초마다 추적 상태 출력
+  int seconds = 0;
+  while(keepRunning){
+    sleep(1);
+    SlamStats stats;
+    if(++seconds % 5 == 0 && getSlamStats(&stats)){
+      printf("SLAM: %u frames, state %d, track %.1f ms, %d keyframes, %d map points, queue %d\n", stats.frameCount,
+             stats.trackingState, stats.trackTimeMs, stats.keyFrames, stats.mapPoints, stats.queueDepth);
+    }
+  }
+
+  // 수신을 먼저 멈춰 종료 중인 SLAM 에 프레임이 들어가지 않게 함
+  stopFrameReceiver();
+  setSlamPoseCallback(NULL, NULL);
+  stopSlamModule();
+  return 0;
+}
@@ -0,0 +1,130 @@
+// TSDF 융합 처리량 벤치마크
+// 사용법: TsdfBenchmark [frames] [threads] [voxel_size]
+// 합성 방 (6 x 3 x 6 m) 안에서 카메라가 원을 그리며 돌 때의 640x480 깊이 프레임을 통합하고
+// 프레임당 통합 시간 / FPS / 갱신 블록 수, 빈 프레임의 작업 분배 비용, 메쉬 추출 시간 출력
+
+#include "tsdfFusion.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#define ROOM_HALF_WIDTH 3.0f
+#define ROOM_HALF_HEIGHT 1.5f
+#define FRAME_WIDTH 640
+#define FRAME_HEIGHT 480
+
+static double nowSeconds(){
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// 카메라 자세 (반지름 1 m 원 위에서 바깥쪽을 보며 회전), column-major
+static void roomPose(int frame, float Twc[16]){
+  float angle = frame * 0.02f;
+  float c = cosf(angle), s = sinf(angle);
+  memset(Twc, 0, 16 * sizeof(float));
+  Twc[0] = c;   Twc[2] = -s;
+  Twc[5] = 1.0f;
+  Twc[8] = s;   Twc[10] = c;
+  Twc[12] = sinf(angle);
+  Twc[13] = 0.0f;
+  Twc[14] = cosf(angle);
+  Twc[15] = 1.0f;
+}
+
+// 방 벽 / 바닥 / 천장까지의 깊이 (광선 추적) + 벽 가운데 상자, 색상은 월드 좌표 체크 무늬
+static void renderRoom(const DenseCameraIntrinsics& K, const float Twc[16], uint16_t* depth, uint8_t* rgb){
+  for(int v = 0; v < FRAME_HEIGHT; ++v){
+    for(int u = 0; u < FRAME_WIDTH; ++u){
+      size_t i = (size_t)v * FRAME_WIDTH + u;
+      float cx = (u - K.cx) / K.fx, cy = (v - K.cy) / K.fy;
+      float dx = Twc[0] * cx + Twc[4] * cy + Twc[8];
+      float dy = Twc[1] * cx + Twc[5] * cy + Twc[9];
+      float dz = Twc[2] * cx + Twc[6] * cy + Twc[10];
+      const float o[3] = {Twc[12], Twc[13], Twc[14]};
+      const float d[3] = {dx, dy, dz};
+      const float half[3] = {ROOM_HALF_WIDTH, ROOM_HALF_HEIGHT, ROOM_HALF_WIDTH};
+
+      float t = 1e9f;
+      for(int a = 0; a < 3; ++a){
+        if(d[a] > 1e-6f) t = fminf(t, (half[a] - o[a]) / d[a]);
+        if(d[a] < -1e-6f) t = fminf(t, (-half[a] - o[a]) / d[a]);
+      }
+
+      // 광선의 카메라 z 성분이 1 이므로 t 가 곧 깊이 (상자: x = 2.5 m 벽 앞 0.5 m 두께)
+      float wx = o[0] + dx * t, wy = o[1] + dy * t, wz = o[2] + dz * t;
+      if(wx > 2.5f && fabsf(wy) < 0.5f && fabsf(wz) < 0.5f && dx > 1e-6f){
+        t = (2.5f - o[0]) / dx;
+        wx = 2.5f;
+        wy = o[1] + dy * t;
+        wz = o[2] + dz * t;
+      }
+      depth[i] = t < 6.0f ? (uint16_t)(t * K.depthFactor) : 0;
+      int checker = ((int)floorf(wx * 4.0f) + (int)floorf(wy * 4.0f) + (int)floorf(wz * 4.0f)) & 1;
+      rgb[i * 3] = checker ? 200 : 60;
+      rgb[i * 3 + 1] = (uint8_t)(128 + 100 * sinf(wz));
+      rgb[i * 3 + 2] = checker ? 60 : 200;
+    }
+  }
+}
+
+int main(int argc, char** argv){
+  int frames = argc > 1 ? atoi(argv[1]) : 300;
+  TsdfConfig config;
+  config.numThreads = argc > 2 ? atoi(argv[2]) : 0;
+  if(argc > 3) config.voxelSize = (float)atof(argv[3]);
+  config.truncation = config.voxelSize * 4.0f;
+  config.maxBlocks = 65536;
+  if(frames < 1 || config.voxelSize <= 0.0f){
+    fprintf(stderr, "Usage: %s [frames] [threads] [voxel_size]\n", argv[0]);
+    return 1;
+  }
+
+  DenseCameraIntrinsics K;
+  size_t pixels = (size_t)FRAME_WIDTH * FRAME_HEIGHT;
+  std::vector<uint16_t> depth(pixels);
+  std::vector<uint8_t> rgb(pixels * 3);
+
+  TsdfVolume volume(config, K);
+  printf("TSDF: voxel %.3f m, truncation %.3f m, %dx%d frames, %d threads requested (0 = all cores)\n",
+         config.voxelSize, config.truncation, FRAME_WIDTH, FRAME_HEIGHT, config.numThreads);
+
+  // 프레임 생성 시간은 제외하고 integrate 만 측정
+  double integrateSeconds = 0.0, worstMs = 0.0;
+  long long updatedBlocks = 0;
+  float Twc[16];
+  for(int frame = 0; frame < frames; ++frame){
+    roomPose(frame, Twc);
+    renderRoom(K, Twc, depth.data(), rgb.data());
+
+    double start = nowSeconds();
+    updatedBlocks += volume.integrate(depth.data(), rgb.data(), false, FRAME_WIDTH, FRAME_HEIGHT, Twc);
+    double elapsed = nowSeconds() - start;
+    integrateSeconds += elapsed;
+    if(elapsed * 1000.0 > worstMs) worstMs = elapsed * 1000.0;
+  }
+
+  double meanMs = integrateSeconds * 1000.0 / frames;
+  printf("Integrate: %.3f ms/frame (worst %.3f ms), %.1f FPS, %lld blocks/frame, %d blocks allocated\n", meanMs,
+         worstMs, 1000.0 / meanMs, updatedBlocks / frames, volume.allocatedBlocks());
+
+  // 빈 프레임 (유효 깊이 없음): 블록 할당 / 통합 작업 분배 비용만 남음
+  std::fill(depth.begin(), depth.end(), 0);
+  const int emptyFrames = 1000;
+  double start = nowSeconds();
+  for(int i = 0; i < emptyFrames; ++i){
+    volume.integrate(depth.data(), rgb.data(), false, FRAME_WIDTH, FRAME_HEIGHT, Twc);
+  }
+  printf("Empty frame: %.3f ms/frame (work dispatch overhead)\n", (nowSeconds() - start) * 1000.0 / emptyFrames);
+
+  TsdfMeshStats stats;
+  if(!volume.extractMesh("/tmp/tsdf_benchmark.ply", &stats)){
+    return 1;
+  }
+  printf("Mesh: %llu vertices, %llu triangles, %.1f ms\n", (unsigned long long)stats.vertices,
+         (unsigned long long)stats.triangles, stats.seconds * 1000.0);
+  return 0;
+}
@@ -0,0 +1,581 @@
+#include "tsdfFusion.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// 블록 좌표 인덱스 오프셋 (축당 21비트)
+static const int64_t kBlockOffset = 1 << 20;
+
+// 행 밴드 단위 작업 크기 (블록 할당)
+static const int kAllocRowsPerTask = 16;
+
+static inline uint64_t makeBlockKey(int32_t bx, int32_t by, int32_t bz){
+  uint64_t x = (uint64_t)(bx + kBlockOffset) & 0x1FFFFF;
+  uint64_t y = (uint64_t)(by + kBlockOffset) & 0x1FFFFF;
+  uint64_t z = (uint64_t)(bz + kBlockOffset) & 0x1FFFFF;
+  return (x << 42) | (y << 21) | z;
+}
+
+static inline void splitBlockKey(uint64_t key, int32_t* bx, int32_t* by, int32_t* bz){
+  *bx = (int32_t)((int64_t)((key >> 42) & 0x1FFFFF) - kBlockOffset);
+  *by = (int32_t)((int64_t)((key >> 21) & 0x1FFFFF) - kBlockOffset);
+  *bz = (int32_t)((int64_t)(key & 0x1FFFFF) - kBlockOffset);
+}
+
+static inline int voxelIndex(int x, int y, int z){
+  return (z * TSDF_BLOCK_SIZE + y) * TSDF_BLOCK_SIZE + x;
+}
+
+TsdfVolume::TsdfVolume(const TsdfConfig& config, const DenseCameraIntrinsics& intrinsics) :
+    config_(config), intrinsics_(intrinsics){
+  // 주소가 바뀌지 않도록 풀 용량을 미리 예약 (페이지는 실제 사용 시에만 할당됨)
+  pool_.reserve(config_.maxBlocks);
+  block_map_.reserve(config_.maxBlocks);
+
+  num_threads_ = config_.numThreads > 0 ? config_.numThreads : (int)std::thread::hardware_concurrency();
+  num_threads_ = std::max(1, num_threads_);
+  thread_keys_.resize(num_threads_);
+  for(int i = 1; i < num_threads_; ++i){
+    workers_.emplace_back(&TsdfVolume::workerLoop, this, i);
+  }
+}
+
+TsdfVolume::~TsdfVolume(){
+  {
+    std::lock_guard<std::mutex> lock(worker_mutex_);
+    stop_ = true;
+  }
+  worker_cv_.notify_all();
+  for(auto& worker : workers_){
+    worker.join();
+  }
+}
+
+void TsdfVolume::workerLoop(int index){
+  uint64_t seen = 0;
+  while(true){
+    const std::function<void(int, size_t)>* job;
+    size_t tasks;
+    {
+      std::unique_lock<std::mutex> lock(worker_mutex_);
+      worker_cv_.wait(lock, [&]{ return stop_ || job_generation_ != seen; });
+      if(stop_) return;
+      seen = job_generation_;
+      job = job_;
+      tasks = job_tasks_;
+    }
+
+    size_t task;
+    while((task = next_task_.fetch_add(1)) < tasks){
+      (*job)(index, task);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(worker_mutex_);
+      if(--active_workers_ == 0){
+        done_cv_.notify_one();
+      }
+    }
+  }
+}
+
+// 작업 인덱스를 상주 스레드와 호출 스레드가 나눠 가짐 (func 의 첫 인자는 스레드 번호, 0 이 호출 스레드)
+void TsdfVolume::parallelFor(size_t numTasks, const std::function<void(int, size_t)>& func){
+  // 작업이 하나뿐이면 깨우지 않고 바로 실행
+  if(workers_.empty() || numTasks <= 1){
+    for(size_t task = 0; task < numTasks; ++task){
+      func(0, task);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(worker_mutex_);
+    job_ = &func;
+    job_tasks_ = numTasks;
+    next_task_ = 0;
+    active_workers_ = (int)workers_.size();
+    job_generation_++;
+  }
+  worker_cv_.notify_all();
+
+  size_t task;
+  while((task = next_task_.fetch_add(1)) < numTasks){
+    func(0, task);
+  }
+
+  std::unique_lock<std::mutex> lock(worker_mutex_);
+  done_cv_.wait(lock, [&]{ return active_workers_ == 0; });
+  job_ = nullptr;
+}
+
+void TsdfVolume::reset(){
+  pool_.clear();
+  block_map_.clear();
+  visible_blocks_.clear();
+  blocks_used_ = 0;
+  pool_full_reported_ = false;
+}
+
+int32_t TsdfVolume::findBlock(int32_t bx, int32_t by, int32_t bz) const{
+  auto it = block_map_.find(makeBlockKey(bx, by, bz));
+  return it == block_map_.end() ? -1 : it->second;
+}
+
+int32_t TsdfVolume::allocateBlock(int32_t bx, int32_t by, int32_t bz){
+  if(pool_.size() >= (size_t)config_.maxBlocks){
+    if(!pool_full_reported_){
+      std::cerr << "TSDF block pool exhausted (" << config_.maxBlocks << " blocks)" << std::endl;
+      pool_full_reported_ = true;
+    }
+    return -1;
+  }
+
+  pool_.emplace_back();
+  TsdfBlock& block = pool_.back();
+  block.bx = bx;
+  block.by = by;
+  block.bz = bz;
+  for(int i = 0; i < TSDF_BLOCK_VOXELS; ++i){
+    block.voxels[i].tsdf = 1.0f;
+    block.voxels[i].weight = 0.0f;
+    block.voxels[i].r = block.voxels[i].g = block.voxels[i].b = 0;
+    block.voxels[i].pad = 0;
+  }
+
+  int32_t index = (int32_t)pool_.size() - 1;
+  block_map_.emplace(makeBlockKey(bx, by, bz), index);
+  blocks_used_ = pool_.size();
+  return index;
+}
+
+// 깊이 픽셀의 절단 구간이 지나는 블록을 수집하여 할당
+void TsdfVolume::collectBlocks(const uint16_t* depth, int width, int height, const float Twc[16]){
+  const float blockLength = config_.voxelSize * TSDF_BLOCK_SIZE;
+  const float invBlock = 1.0f / blockLength;
+  const float invFactor = 1.0f / intrinsics_.depthFactor;
+  const float step = blockLength * 0.5f;
+  const int stride = std::max(1, config_.allocationStride);
+
+  size_t numTasks = (height + kAllocRowsPerTask - 1) / kAllocRowsPerTask;
+  for(auto& keys : thread_keys_){
+    keys.clear();
+  }
+
+  parallelFor(numTasks, [&](int t, size_t task){
+    std::vector<uint64_t>& keys = thread_keys_[t];
+
+    // 최근 키 캐시 (인접 픽셀이 같은 블록을 반복해서 내보내는 것을 방지)
+    uint64_t recent[256];
+    std::fill(recent, recent + 256, ~0ULL);
+    int rowEnd = std::min(height, (int)(task + 1) * kAllocRowsPerTask);
+
+    for(int v = (int)task * kAllocRowsPerTask; v < rowEnd; v += stride){
+      const float yn = (v - intrinsics_.cy) / intrinsics_.fy;
+      for(int u = 0; u < width; u += stride){
+        float z = depth[v * width + u] * invFactor;
+        if(z < config_.minDepth || z > config_.maxDepth) continue;
+
+        const float xn = (u - intrinsics_.cx) / intrinsics_.fx;
+        for(float s = z - config_.truncation; s <= z + config_.truncation; s += step){
+          float xc = xn * s, yc = yn * s;
+          float xw = Twc[0] * xc + Twc[4] * yc + Twc[8] * s + Twc[12];
+          float yw = Twc[1] * xc + Twc[5] * yc + Twc[9] * s + Twc[13];
+          float zw = Twc[2] * xc + Twc[6] * yc + Twc[10] * s + Twc[14];
+          uint64_t key = makeBlockKey((int32_t)std::floor(xw * invBlock), (int32_t)std::floor(yw * invBlock),
+                                      (int32_t)std::floor(zw * invBlock));
+          uint64_t& slot = recent[(key ^ (key >> 21) ^ (key >> 42)) & 255];
+          if(slot != key){
+            keys.push_back(key);
+            slot = key;
+          }
+        }
+      }
+    }
+  });
+
+  // 후보 키 병합 및 중복 제거
+  std::vector<uint64_t> merged;
+  for(auto& keys : thread_keys_){
+    merged.insert(merged.end(), keys.begin(), keys.end());
+  }
+  std::sort(merged.begin(), merged.end());
+  merged.erase(std::unique(merged.begin(), merged.end()), merged.end());
+
+  visible_blocks_.clear();
+  for(uint64_t key : merged){
+    auto it = block_map_.find(key);
+    int32_t index;
+    if(it != block_map_.end()){
+      index = it->second;
+    }else{
+      int32_t bx, by, bz;
+      splitBlockKey(key, &bx, &by, &bz);
+      index = allocateBlock(bx, by, bz);
+    }
+    if(index >= 0){
+      visible_blocks_.push_back(index);
+    }
+  }
+}
+
+// 블록 하나의 복셀을 현재 프레임에 투영하여 갱신
+void TsdfVolume::integrateBlock(TsdfBlock& block, const uint16_t* depth, const uint8_t* color, bool colorIsBGR,
+                                int width, int height, const float Tcw[12]){
+  const float vs = config_.voxelSize;
+  const float invTrunc = 1.0f / config_.truncation;
+  const float invFactor = 1.0f / intrinsics_.depthFactor;
+  const float fx = intrinsics_.fx, fy = intrinsics_.fy;
+  const float cx = intrinsics_.cx, cy = intrinsics_.cy;
+  const int ri = colorIsBGR ? 2 : 0;
+  const int bi = colorIsBGR ? 0 : 2;
+
+  // x 방향 한 칸 이동 시 카메라 좌표 증가량
+  const float stepX = Tcw[0] * vs, stepY = Tcw[4] * vs, stepZ = Tcw[8] * vs;
+
+  int32_t ui[TSDF_BLOCK_SIZE];
+  int32_t vi[TSDF_BLOCK_SIZE];
+  float pz[TSDF_BLOCK_SIZE];
+  int32_t valid[TSDF_BLOCK_SIZE];
+
+  for(int z = 0; z < TSDF_BLOCK_SIZE; ++z){
+    for(int y = 0; y < TSDF_BLOCK_SIZE; ++y){
+      // 행의 첫 복셀 월드/카메라 좌표
+      float wx = (block.bx * TSDF_BLOCK_SIZE) * vs;
+      float wy = (block.by * TSDF_BLOCK_SIZE + y) * vs;
+      float wz = (block.bz * TSDF_BLOCK_SIZE + z) * vs;
+      float cx0 = Tcw[0] * wx + Tcw[1] * wy + Tcw[2] * wz + Tcw[3];
+      float cy0 = Tcw[4] * wx + Tcw[5] * wy + Tcw[6] * wz + Tcw[7];
+      float cz0 = Tcw[8] * wx + Tcw[9] * wy + Tcw[10] * wz + Tcw[11];
+
+#if defined(__SSE2__)
+      // 4개 복셀씩 투영
+      for(int x = 0; x < TSDF_BLOCK_SIZE; x += 4){
+        __m128 offs = _mm_add_ps(_mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f), _mm_set1_ps((float)x));
+        __m128 px = _mm_add_ps(_mm_set1_ps(cx0), _mm_mul_ps(offs, _mm_set1_ps(stepX)));
+        __m128 py = _mm_add_ps(_mm_set1_ps(cy0), _mm_mul_ps(offs, _mm_set1_ps(stepY)));
+        __m128 pzv = _mm_add_ps(_mm_set1_ps(cz0), _mm_mul_ps(offs, _mm_set1_ps(stepZ)));
+
+        __m128 positive = _mm_cmpgt_ps(pzv, _mm_set1_ps(1e-4f));
+        __m128 invz = _mm_div_ps(_mm_set1_ps(1.0f), _mm_max_ps(pzv, _mm_set1_ps(1e-4f)));
+        __m128 uf = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(px, invz), _mm_set1_ps(fx)), _mm_set1_ps(cx + 0.5f));
+        __m128 vf = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(py, invz), _mm_set1_ps(fy)), _mm_set1_ps(cy + 0.5f));
+
+        __m128 inside = _mm_and_ps(positive, _mm_cmpge_ps(uf, _mm_setzero_ps()));
+        inside = _mm_and_ps(inside, _mm_cmplt_ps(uf, _mm_set1_ps((float)width)));
+        inside = _mm_and_ps(inside, _mm_cmpge_ps(vf, _mm_setzero_ps()));
+        inside = _mm_and_ps(inside, _mm_cmplt_ps(vf, _mm_set1_ps((float)height)));
+
+        _mm_storeu_si128((__m128i*)(ui + x), _mm_cvttps_epi32(uf));
+        _mm_storeu_si128((__m128i*)(vi + x), _mm_cvttps_epi32(vf));
+        _mm_storeu_ps(pz + x, pzv);
+        _mm_storeu_si128((__m128i*)(valid + x), _mm_castps_si128(inside));
+      }
+#else
+      for(int x = 0; x < TSDF_BLOCK_SIZE; ++x){
+        float px = cx0 + x * stepX, py = cy0 + x * stepY, pzv = cz0 + x * stepZ;
+        valid[x] = 0;
+        pz[x] = pzv;
+        if(pzv <= 1e-4f) continue;
+        float uf = px / pzv * fx + cx + 0.5f;
+        float vf = py / pzv * fy + cy + 0.5f;
+        if(uf < 0.0f || uf >= width || vf < 0.0f || vf >= height) continue;
+        ui[x] = (int32_t)uf;
+        vi[x] = (int32_t)vf;
+        valid[x] = -1;
+      }
+#endif
+
+      TsdfVoxel* row = block.voxels + voxelIndex(0, y, z);
+      for(int x = 0; x < TSDF_BLOCK_SIZE; ++x){
+        if(!valid[x]) continue;
+
+        int pixel = vi[x] * width + ui[x];
+        float d = depth[pixel] * invFactor;
+        if(d < config_.minDepth || d > config_.maxDepth) continue;
+
+        float sdf = d - pz[x];
+        if(sdf < -config_.truncation) continue;
+
+        float tsdf = std::min(1.0f, sdf * invTrunc);
+        TsdfVoxel& voxel = row[x];
+        float w = voxel.weight;
+        float nw = w + 1.0f;
+        voxel.tsdf = (voxel.tsdf * w + tsdf) / nw;
+
+        if(color && sdf < config_.truncation){
+          const uint8_t* c = color + pixel * 3;
+          voxel.r = (uint8_t)((voxel.r * w + c[ri]) / nw);
+          voxel.g = (uint8_t)((voxel.g * w + c[1]) / nw);
+          voxel.b = (uint8_t)((voxel.b * w + c[bi]) / nw);
+        }
+        voxel.weight = std::min(nw, config_.maxWeight);
+      }
+    }
+  }
+}
+
+int TsdfVolume::integrate(const uint16_t* depth, const uint8_t* color, bool colorIsBGR, int width, int height,
+                          const float Twc[16]){
+  if(!depth || width <= 0 || height <= 0) return 0;
+
+  // Twc (column-major) -> Tcw (row-major 3x4)
+  float Tcw[12];
+  for(int r = 0; r < 3; ++r){
+    Tcw[r * 4 + 0] = Twc[r * 4 + 0];
+    Tcw[r * 4 + 1] = Twc[r * 4 + 1];
+    Tcw[r * 4 + 2] = Twc[r * 4 + 2];
+    Tcw[r * 4 + 3] = -(Twc[r * 4 + 0] * Twc[12] + Twc[r * 4 + 1] * Twc[13] + Twc[r * 4 + 2] * Twc[14]);
+  }
+
+  collectBlocks(depth, width, height, Twc);
+
+  // 블록 단위 병렬 통합
+  parallelFor(visible_blocks_.size(), [&](int, size_t i){
+    integrateBlock(pool_[visible_blocks_[i]], depth, color, colorIsBGR, width, height, Tcw);
+  });
+
+  return (int)visible_blocks_.size();
+}
+
+// 메쉬 추출용 정점
+struct MeshVertex{
+  float x, y, z;
+  uint8_t r, g, b;
+};
+
+int TsdfVolume::extractMesh(const std::string& path, TsdfMeshStats* stats){
+  auto startTime = std::chrono::steady_clock::now();
+  const size_t numBlocks = pool_.size();
+  const float vs = config_.voxelSize;
+
+  // 블록별 27개 이웃 블록 인덱스
+  std::vector<int32_t> neighbors(numBlocks * 27);
+  parallelFor(numBlocks, [&](int, size_t b){
+    const TsdfBlock& block = pool_[b];
+    for(int dz = -1; dz <= 1; ++dz){
+      for(int dy = -1; dy <= 1; ++dy){
+        for(int dx = -1; dx <= 1; ++dx){
+          neighbors[b * 27 + (dz + 1) * 9 + (dy + 1) * 3 + (dx + 1)] =
+              (dx | dy | dz) ? findBlock(block.bx + dx, block.by + dy, block.bz + dz) : (int32_t)b;
+        }
+      }
+    }
+  });
+
+  // 블록 내부 좌표 (-1 ~ 8 범위) 로 복셀 조회
+  auto lookup = [&](size_t b, int x, int y, int z, size_t* outBlock, int* outIndex) -> const TsdfVoxel*{
+    int dx = x < 0 ? -1 : (x >= TSDF_BLOCK_SIZE ? 1 : 0);
+    int dy = y < 0 ? -1 : (y >= TSDF_BLOCK_SIZE ? 1 : 0);
+    int dz = z < 0 ? -1 : (z >= TSDF_BLOCK_SIZE ? 1 : 0);
+    int32_t nb = neighbors[b * 27 + (dz + 1) * 9 + (dy + 1) * 3 + (dx + 1)];
+    if(nb < 0) return nullptr;
+    int index = voxelIndex(x - dx * TSDF_BLOCK_SIZE, y - dy * TSDF_BLOCK_SIZE, z - dz * TSDF_BLOCK_SIZE);
+    if(outBlock) *outBlock = (size_t)nb;
+    if(outIndex) *outIndex = index;
+    return &pool_[nb].voxels[index];
+  };
+
+  // 1단계: 셀마다 표면 정점 계산 (surface nets)
+  std::vector<std::vector<MeshVertex>> blockVertices(numBlocks);
+  std::vector<int32_t> cellVertex(numBlocks * TSDF_BLOCK_VOXELS, -1);
+
+  static const int kCorners[8][3] = {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {1, 1, 0},
+                                     {0, 0, 1}, {1, 0, 1}, {0, 1, 1}, {1, 1, 1}};
+  static const int kEdges[12][2] = {{0, 1}, {2, 3}, {4, 5}, {6, 7}, {0, 2}, {1, 3},
+                                    {4, 6}, {5, 7}, {0, 4}, {1, 5}, {2, 6}, {3, 7}};
+
+  parallelFor(numBlocks, [&](int, size_t b){
+    const TsdfBlock& block = pool_[b];
+    std::vector<MeshVertex>& vertices = blockVertices[b];
+
+    for(int z = 0; z < TSDF_BLOCK_SIZE; ++z){
+      for(int y = 0; y < TSDF_BLOCK_SIZE; ++y){
+        for(int x = 0; x < TSDF_BLOCK_SIZE; ++x){
+          float values[8];
+          const TsdfVoxel* corner[8];
+          bool complete = true;
+          int inside = 0;
+
+          for(int c = 0; c < 8 && complete; ++c){
+            corner[c] = lookup(b, x + kCorners[c][0], y + kCorners[c][1], z + kCorners[c][2], nullptr, nullptr);
+            if(!corner[c] || corner[c]->weight <= 0.0f){
+              complete = false;
+              break;
+            }
+            values[c] = corner[c]->tsdf;
+            if(values[c] < 0.0f) inside |= 1 << c;
+          }
+          if(!complete || inside == 0 || inside == 0xFF) continue;
+
+          // 부호가 바뀌는 모서리 교차점 평균
+          float sx = 0.0f, sy = 0.0f, sz = 0.0f;
+          int crossings = 0;
+          for(int e = 0; e < 12; ++e){
+            int a = kEdges[e][0], c = kEdges[e][1];
+            if(((inside >> a) & 1) == ((inside >> c) & 1)) continue;
+            if(std::fabs(values[a]) >= 0.999f && std::fabs(values[c]) >= 0.999f) continue;
+            float t = values[a] / (values[a] - values[c]);
+            sx += kCorners[a][0] + t * (kCorners[c][0] - kCorners[a][0]);
+            sy += kCorners[a][1] + t * (kCorners[c][1] - kCorners[a][1]);
+            sz += kCorners[a][2] + t * (kCorners[c][2] - kCorners[a][2]);
+            crossings++;
+          }
+          if(crossings == 0) continue;
+
+          MeshVertex vertex;
+          vertex.x = (block.bx * TSDF_BLOCK_SIZE + x + sx / crossings) * vs;
+          vertex.y = (block.by * TSDF_BLOCK_SIZE + y + sy / crossings) * vs;
+          vertex.z = (block.bz * TSDF_BLOCK_SIZE + z + sz / crossings) * vs;
+          vertex.r = corner[0]->r;
+          vertex.g = corner[0]->g;
+          vertex.b = corner[0]->b;
+
+          cellVertex[b * TSDF_BLOCK_VOXELS + voxelIndex(x, y, z)] = (int32_t)vertices.size();
+          vertices.push_back(vertex);
+        }
+      }
+    }
+  });
+
+  // 블록별 정점 오프셋 (전역 인덱스)
+  std::vector<uint32_t> vertexOffset(numBlocks + 1, 0);
+  for(size_t b = 0; b < numBlocks; ++b){
+    vertexOffset[b + 1] = vertexOffset[b] + (uint32_t)blockVertices[b].size();
+  }
+
+  auto cellIndex = [&](size_t b, int x, int y, int z) -> int64_t{
+    size_t nb;
+    int index;
+    if(!lookup(b, x, y, z, &nb, &index)) return -1;
+    int32_t local = cellVertex[nb * TSDF_BLOCK_VOXELS + index];
+    return local < 0 ? -1 : (int64_t)vertexOffset[nb] + local;
+  };
+
+  // 2단계: 부호가 바뀌는 복셀 모서리마다 주변 4개 셀을 잇는 사각형 생성
+  std::vector<std::vector<uint32_t>> blockTriangles(numBlocks);
+  parallelFor(numBlocks, [&](int, size_t b){
+    const TsdfBlock& block = pool_[b];
+    std::vector<uint32_t>& triangles = blockTriangles[b];
+
+    for(int z = 0; z < TSDF_BLOCK_SIZE; ++z){
+      for(int y = 0; y < TSDF_BLOCK_SIZE; ++y){
+        for(int x = 0; x < TSDF_BLOCK_SIZE; ++x){
+          const TsdfVoxel& p = block.voxels[voxelIndex(x, y, z)];
+          if(p.weight <= 0.0f) continue;
+
+          for(int axis = 0; axis < 3; ++axis){
+            int e[3] = {0, 0, 0};
+            e[axis] = 1;
+            const TsdfVoxel* q = lookup(b, x + e[0], y + e[1], z + e[2], nullptr, nullptr);
+            if(!q || q->weight <= 0.0f) continue;
+            if((p.tsdf < 0.0f) == (q->tsdf < 0.0f)) continue;
+
+            // 모서리를 공유하는 셀 (다른 두 축 방향으로 -1)
+            int bAxis = (axis + 1) % 3, cAxis = (axis + 2) % 3;
+            int o1[3] = {0, 0, 0}, o2[3] = {0, 0, 0};
+            o1[bAxis] = -1;
+            o2[cAxis] = -1;
+
+            int64_t c00 = cellIndex(b, x, y, z);
+            int64_t c10 = cellIndex(b, x + o1[0], y + o1[1], z + o1[2]);
+            int64_t c11 = cellIndex(b, x + o1[0] + o2[0], y + o1[1] + o2[1], z + o1[2] + o2[2]);
+            int64_t c01 = cellIndex(b, x + o2[0], y + o2[1], z + o2[2]);
+            if(c00 < 0 || c10 < 0 || c11 < 0 || c01 < 0) continue;
+
+            if(p.tsdf < 0.0f){
+              triangles.insert(triangles.end(), {(uint32_t)c00, (uint32_t)c10, (uint32_t)c11,
+                                                 (uint32_t)c00, (uint32_t)c11, (uint32_t)c01});
+            }else{
+              triangles.insert(triangles.end(), {(uint32_t)c00, (uint32_t)c11, (uint32_t)c10,
+                                                 (uint32_t)c00, (uint32_t)c01, (uint32_t)c11});
+            }
+          }
+        }
+      }
+    }
+  });
+
+  uint64_t numVertices = vertexOffset[numBlocks];
+  uint64_t numTriangles = 0;
+  for(const auto& triangles : blockTriangles){
+    numTriangles += triangles.size() / 3;
+  }
+
+  // 바이너리 PLY 저장
+  FILE* file = fopen(path.c_str(), "wb");
+  if(!file){
+    perror("Failed to open mesh file");
+    return 0;
+  }
+
+  fprintf(file,
+          "ply\n"
+          "format binary_little_endian 1.0\n"
+          "comment Youth TSDF mesh\n"
+          "element vertex %llu\n"
+          "property float x\n"
+          "property float y\n"
+          "property float z\n"
+          "property uchar red\n"
+          "property uchar green\n"
+          "property uchar blue\n"
+          "element face %llu\n"
+          "property list uchar int vertex_indices\n"
+          "end_header\n",
+          (unsigned long long)numVertices, (unsigned long long)numTriangles);
+
+  bool ok = true;
+  std::vector<uint8_t> buffer;
+  buffer.reserve(1 << 20);
+  auto flush = [&](){
+    if(!buffer.empty() && fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()){
+      ok = false;
+    }
+    buffer.clear();
+  };
+
+  for(const auto& vertices : blockVertices){
+    for(const MeshVertex& v : vertices){
+      const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&v);
+      buffer.insert(buffer.end(), bytes, bytes + 15);
+    }
+    if(buffer.size() >= (1 << 20)) flush();
+  }
+
+  for(const auto& triangles : blockTriangles){
+    for(size_t i = 0; i < triangles.size(); i += 3){
+      uint8_t face[13];
+      face[0] = 3;
+      memcpy(face + 1, &triangles[i], 12);
+      buffer.insert(buffer.end(), face, face + 13);
+    }
+    if(buffer.size() >= (1 << 20)) flush();
+  }
+  flush();
+  fclose(file);
+
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+  std::cout << "TSDF mesh: " << numBlocks << " blocks -> " << numVertices << " vertices, " << numTriangles
+            << " triangles in " << seconds * 1000.0 << " ms (" << num_threads_ << " threads)" << std::endl;
+
+  if(stats){
+    stats->vertices = numVertices;
+    stats->triangles = numTriangles;
+    stats->seconds = seconds;
+  }
+
+  if(!ok){
+    std::cerr << "Error writing mesh to " << path << std::endl;
+    return 0;
+  }
+  return 1;
+}
@@ -0,0 +1,116 @@
+#ifndef TSDF_FUSION_H
+#define TSDF_FUSION_H
+
+#include "pointCloudExporter.h"
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// 블록 한 변의 복셀 수 (8^3 블록)
+#define TSDF_BLOCK_SIZE 8
+#define TSDF_BLOCK_VOXELS (TSDF_BLOCK_SIZE * TSDF_BLOCK_SIZE * TSDF_BLOCK_SIZE)
+
+// TSDF 복셀
+struct TsdfVoxel{
+  float tsdf;      // 정규화된 부호 거리 [-1, 1]
+  float weight;    // 누적 가중치
+  uint8_t r, g, b; // 평균 색상
+  uint8_t pad;
+};
+
+// 해시 그리드에 저장되는 복셀 블록
+struct TsdfBlock{
+  int32_t bx, by, bz; // 블록 좌표
+  TsdfVoxel voxels[TSDF_BLOCK_VOXELS];
+};
+
+// TSDF 볼륨 설정
+struct TsdfConfig{
+  float voxelSize = 0.02f;    // 복셀 크기 (m)
+  float truncation = 0.08f;   // 절단 거리 (m)
+  float minDepth = 0.2f;      // 유효 깊이 범위 (m)
+  float maxDepth = 4.0f;
+  float maxWeight = 64.0f;    // 가중치 상한 (동적 변화 반영)
+  int maxBlocks = 32768;      // 블록 풀 크기 (블록당 약 6KB)
+  int allocationStride = 2;   // 블록 할당 시 픽셀 샘플링 간격
+  int numThreads = 0;         // 0 이면 하드웨어 코어 수 사용
+};
+
+// 메쉬 추출 결과 통계
+struct TsdfMeshStats{
+  uint64_t vertices = 0;
+  uint64_t triangles = 0;
+  double seconds = 0.0;
+};
+
+// 복셀 해싱 기반 CPU TSDF 볼륨
+// integrate() 와 extractMesh() 는 같은 스레드(또는 외부 락)에서 호출해야 함
+class TsdfVolume{
+public:
+  TsdfVolume(const TsdfConfig& config, const DenseCameraIntrinsics& intrinsics);
+  ~TsdfVolume();
+
+  TsdfVolume(const TsdfVolume&) = delete;
+  TsdfVolume& operator=(const TsdfVolume&) = delete;
+
+  // 깊이 프레임 통합
+  // depth: 16비트 깊이 (intrinsics.depthFactor 단위), color: 픽셀당 3바이트 (NULL 가능)
+  // Twc: 카메라 -> 월드 변환 (column-major 4x4)
+  // 반환값: 이번 프레임에서 갱신된 블록 수
+  int integrate(const uint16_t* depth, const uint8_t* color, bool colorIsBGR, int width, int height,
+                const float Twc[16]);
+
+  // 병렬 메쉬 추출 후 바이너리 PLY 로 저장 (surface nets)
+  // 반환값: 성공 시 1, 실패 시 0
+  int extractMesh(const std::string& path, TsdfMeshStats* stats);
+
+  // 볼륨 초기화
+  void reset();
+
+  int allocatedBlocks() const{
+    return (int)blocks_used_;
+  }
+
+  const TsdfConfig& config() const{
+    return config_;
+  }
+
+private:
+  int32_t findBlock(int32_t bx, int32_t by, int32_t bz) const;
+  int32_t allocateBlock(int32_t bx, int32_t by, int32_t bz);
+  void collectBlocks(const uint16_t* depth, int width, int height, const float Twc[16]);
+  void integrateBlock(TsdfBlock& block, const uint16_t* depth, const uint8_t* color, bool colorIsBGR,
+                      int width, int height, const float Tcw[12]);
+  void parallelFor(size_t numTasks, const std::function<void(int, size_t)>& func);
+  void workerLoop(int index);
+
+  TsdfConfig config_;
+  DenseCameraIntrinsics intrinsics_;
+  std::vector<TsdfBlock> pool_;                         // 미리 할당된 블록 풀
+  size_t blocks_used_ = 0;
+  std::unordered_map<uint64_t, int32_t> block_map_;     // 블록 좌표 -> 풀 인덱스
+  std::vector<int32_t> visible_blocks_;                 // 현재 프레임에서 갱신할 블록
+  std::vector<std::vector<uint64_t>> thread_keys_;      // 스레드별 할당 후보 키
+  bool pool_full_reported_ = false;
+
+  // 상주 작업 스레드 (프레임마다 블록 할당 / 통합 두 번씩 스레드를 만들고 합치지 않음)
+  int num_threads_ = 1;
+  std::vector<std::thread> workers_;
+  std::mutex worker_mutex_;
+  std::condition_variable worker_cv_;
+  std::condition_variable done_cv_;
+  const std::function<void(int, size_t)>* job_ = nullptr;
+  size_t job_tasks_ = 0;
+  std::atomic<size_t> next_task_{0};
+  int active_workers_ = 0;
+  uint64_t job_generation_ = 0;
+  bool stop_ = false;
+};
+
+#endif // TSDF_FUSION_H
@@ -0,0 +1,62 @@
+#include "benchmarkUtil.h"
+#include <math.h>
+#include <stddef.h>
+#include <time.h>
+
+double benchmarkNow(void){
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+uint32_t benchmarkRandom(uint32_t* state){
+  *state ^= *state << 13;
+  *state ^= *state >> 17;
+  *state ^= *state << 5;
+  return *state;
+}
+
+float benchmarkGaussian(uint32_t* state){
+  float sum = 0.0f;
+  for(int i = 0; i < 4; ++i) sum += (benchmarkRandom(state) & 0xFFFF) / 65535.0f;
+  return (sum - 2.0f) * 1.732f;
+}
+
+void renderBenchmarkBoxScene(int width, int height, uint16_t* depth, uint8_t* rgb){
+  for(int v = 0; v < height; ++v){
+    for(int u = 0; u < width; ++u){
+      size_t i = (size_t)v * width + u;
+      int z = 2500 + u * 2000 / width;
+      if(u > width / 3 && u < width * 2 / 3 && v > height / 3 && v < height * 2 / 3) z = 800;
+      int hole = ((u * 7 + v * 13) % 29) == 0;
+      depth[i] = hole ? 0 : (uint16_t)(z + (u ^ v) % 5);
+      if(rgb){
+        rgb[i * 3 + 0] = (uint8_t)(u * 255 / width);
+        rgb[i * 3 + 1] = (uint8_t)((((u / 8) + (v / 8)) & 1) ? 250 : v);
+        rgb[i * 3 + 2] = (uint8_t)(u * 13 + v * 7);
+      }
+    }
+  }
+}
+
+void renderBenchmarkWaveScene(uint32_t frame, int width, int height, int noise_mm, int hole_period, int16_t* depth,
+                              uint8_t* rgb){
+  uint32_t state = frame * 2654435761u + 1u;
+  const float phase = frame * 0.1f;
+  for(int v = 0; v < height; ++v){
+    for(int u = 0; u < width; ++u){
+      size_t i = (size_t)v * width + u;
+      float z = 1800.0f + u * 1.5f + 150.0f * sinf(u * 0.03f + phase) * cosf(v * 0.02f);
+      int noise = 0;
+      if(noise_mm > 0){
+        state = state * 1664525u + 1013904223u;
+        noise = (int)((state >> 16) % (uint32_t)(2 * noise_mm)) - noise_mm;
+      }
+      int hole = hole_period > 0 && ((u * 7 + v * 13 + (int)frame) % hole_period) == 0;
+      depth[i] = hole ? 0 : (int16_t)(z + noise);
+      rgb[i * 3] = (uint8_t)(u >> 2);
+      rgb[i * 3 + 1] = (uint8_t)(v >> 1);
+      rgb[i * 3 + 2] = (uint8_t)(frame * 4);
+    }
+  }
+}
@@ -0,0 +1,34 @@
+#ifndef BENCHMARK_UTIL_H
+#define BENCHMARK_UTIL_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 벤치마크 / 도구 공용 시간 측정 (CLOCK_MONOTONIC, 초)
+double benchmarkNow(void);
+
+// 재현 가능한 xorshift 난수 (state 는 0 이 아니어야 함)
+uint32_t benchmarkRandom(uint32_t* state);
+
+// 평균 0, 표준편차 약 1 인 정규 분포 근사 (균등 분포 4 개 합)
+float benchmarkGaussian(uint32_t* state);
+
+// 합성 장면: 기울어진 벽 (2.5 ~ 4.5 m) 앞 0.8 m 상자 + 군데군데 무효 픽셀 (깊이 mm), 색상은 격자 무늬
+// 상자 경계에서 깊이 불연속 / 가려짐이 생기므로 줄임 / 정합 / 왜곡 보정 결과 검증에 사용 (rgb 가 NULL 이면 깊이만)
+void renderBenchmarkBoxScene(int width, int height, uint16_t* depth, uint8_t* rgb);
+
+// 합성 장면: 물결 치는 기울어진 벽 (약 1.8 m, 깊이 mm), frame 마다 물결이 움직임
+// 같은 인자면 같은 영상이므로 송신 측과 수신 측이 각자 만들어 비교할 수 있음
+// noise_mm: 픽셀별 균등 노이즈 (-noise_mm ~ noise_mm - 1 mm, 0 이면 없음)
+// hole_period: 대략 hole_period 픽셀마다 무효 픽셀 하나 (0 이면 없음)
+void renderBenchmarkWaveScene(uint32_t frame, int width, int height, int noise_mm, int hole_period, int16_t* depth,
+                              uint8_t* rgb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BENCHMARK_UTIL_H
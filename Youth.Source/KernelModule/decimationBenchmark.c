@@ -0,0 +1,105 @@
+// 관심 영역 / 해상도 줄임 벤치마크
+// 사용법: DecimationBenchmark [width] [height] [iterations]
+// SIMD 2x2 줄임이 스칼라 기준 구현과 같은지 (홀수 크기, 관심 영역 포함) 확인한 뒤
+// 피라미드 단계별 계산 시간과 프레임당 전송 바이트 출력
+
+#include "frameDecimation.h"
+#include "benchmarkUtil.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int checkHalve(const uint16_t* depth, const uint8_t* rgb, int stride, int width, int height){
+  int ow = width / 2, oh = height / 2;
+  size_t pixels = (size_t)ow * oh;
+  uint16_t* d0 = (uint16_t*)malloc(pixels * sizeof(uint16_t) + 2);
+  uint16_t* d1 = (uint16_t*)malloc(pixels * sizeof(uint16_t) + 2);
+  uint8_t* c0 = (uint8_t*)malloc(pixels * 3 + 1);
+  uint8_t* c1 = (uint8_t*)malloc(pixels * 3 + 1);
+  halveDepthScalar(depth, stride, width, height, d0);
+  halveDepth(depth, stride, width, height, d1);
+  halveColorScalar(rgb, stride, width, height, c0);
+  halveColor(rgb, stride, width, height, c1);
+  int ok = memcmp(d0, d1, pixels * sizeof(uint16_t)) == 0 && memcmp(c0, c1, pixels * 3) == 0;
+  if(!ok){
+    fprintf(stderr, "SIMD output differs from scalar reference (%dx%d, stride %d)\n", width, height, stride);
+  }
+  free(d0);
+  free(d1);
+  free(c0);
+  free(c1);
+  return ok;
+}
+
+int main(int argc, char** argv){
+  int width = argc > 1 ? atoi(argv[1]) : 640;
+  int height = argc > 2 ? atoi(argv[2]) : 480;
+  int iterations = argc > 3 ? atoi(argv[3]) : 200;
+  if(width < 2 || height < 2 || iterations < 1){
+    fprintf(stderr, "Usage: %s [width] [height] [iterations]\n", argv[0]);
+    return 1;
+  }
+
+  size_t pixels = (size_t)width * height;
+  uint16_t* depth = (uint16_t*)malloc(pixels * sizeof(uint16_t));
+  uint8_t* rgb = (uint8_t*)malloc(pixels * 3);
+  if(!depth || !rgb){
+    return 1;
+  }
+  renderBenchmarkBoxScene(width, height, depth, rgb);
+
+  // 전체, 홀수 크기, 관심 영역 (입력 행 간격이 출력 너비와 다름)
+  if(!checkHalve(depth, rgb, width, width, height) ||
+     !checkHalve(depth, rgb, width, width - 1, height - 1) ||
+     !checkHalve(depth + width * 3 + 5, rgb + (width * 3 + 5) * 3, width, width / 2 + 3, height / 2)){
+    return 1;
+  }
+  printf("SIMD output matches scalar reference\n");
+
+  // 스칼라 / SIMD 한 단계 시간
+  uint16_t* halfDepth = (uint16_t*)malloc(pixels / 4 * sizeof(uint16_t) + 2);
+  uint8_t* halfColor = (uint8_t*)malloc(pixels / 4 * 3 + 3);
+  double start = benchmarkNow();
+  for(int i = 0; i < iterations; ++i){
+    halveDepthScalar(depth, width, width, height, halfDepth);
+    halveColorScalar(rgb, width, width, height, halfColor);
+  }
+  double scalarMs = (benchmarkNow() - start) * 1000.0 / iterations;
+  start = benchmarkNow();
+  for(int i = 0; i < iterations; ++i){
+    halveDepth(depth, width, width, height, halfDepth);
+    halveColor(rgb, width, width, height, halfColor);
+  }
+  double simdMs = (benchmarkNow() - start) * 1000.0 / iterations;
+  printf("%-16s %8.3f ms/frame\n%-16s %8.3f ms/frame\n", "halve scalar", scalarMs, "halve simd", simdMs);
+
+  // 피라미드 (소비자마다 다시 줄이지 않고 한 번 계산), 관심 영역은 가운데 절반
+  FramePyramid pyramid;
+  initFramePyramid(&pyramid);
+  FrameRoi center = {width / 4, height / 4, width / 2, height / 2};
+  const FrameRoi* rois[2] = {NULL, &center};
+  const char* roiNames[2] = {"full", "center roi"};
+  for(int r = 0; r < 2; ++r){
+    for(int levels = 1; levels <= FRAME_PYRAMID_LEVELS; ++levels){
+      start = benchmarkNow();
+      for(int i = 0; i < iterations; ++i){
+        if(!buildFramePyramid(&pyramid, depth, rgb, width, height, rois[r], levels)){
+          return 1;
+        }
+      }
+      double ms = (benchmarkNow() - start) * 1000.0 / iterations;
+      const FrameLevel* level = &pyramid.level[pyramid.levels - 1];
+      size_t bytes = (size_t)level->width * level->height * (sizeof(uint16_t) + 3);
+      printf("%-10s 1/%d  %4dx%-4d %8.3f ms/frame  %8.1f KB/frame (%5.1f%% of full)\n", roiNames[r],
+             1 << (pyramid.levels - 1), level->width, level->height, ms, bytes / 1024.0,
+             100.0 * bytes / (pixels * (sizeof(uint16_t) + 3)));
+    }
+  }
+
+  freeFramePyramid(&pyramid);
+  free(halfDepth);
+  free(halfColor);
+  free(depth);
+  free(rgb);
+  return 0;
+}
@@ -0,0 +1,504 @@
+#include "depthFilter.h"
+#include "kernelModule.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define MAX_FILTER_STAGES 5
+
+// 행 양쪽 여백 (0), 3x3 이웃을 8 픽셀 단위로 읽을 때 경계 검사 없이 읽기 위함
+#define ROW_PAD 8
+
+// 공간 평균 나눗셈 (sum / 9 = sum * 7282 >> 16)
+#define RECIPROCAL_9_Q16 7282
+
+// 3x3 이웃 (행 버퍼 번호, 열 오프셋)
+static const int NEIGHBOR_ROW[8] = {0, 0, 0, 1, 1, 2, 2, 2};
+static const int NEIGHBOR_COL[8] = {-1, 0, 1, -1, 1, -1, 0, 1};
+
+typedef struct{
+  int type;          // DEPTH_FILTER_*
+  int radius;        // 세로 이웃 반경 (0 또는 1)
+  int lag;           // 원본 행 대비 지연 (이전 단계 반경 합)
+  int ringRows;      // 입력 행 버퍼 수 (2 * radius + 1)
+  uint16_t* ring;    // 입력 행 버퍼 (이전 단계 출력, 첫 단계는 원본 복사)
+} FilterStage;
+
+struct DepthFilter{
+  DepthFilterOptions options;
+  int width, height;
+  int stride;        // 행 버퍼 간격 (여백 포함)
+  int stageCount;
+  FilterStage stages[MAX_FILTER_STAGES];
+  uint16_t* rowMemory;
+  uint16_t* zeroRow; // 영상 밖의 행
+  uint16_t* history; // 시간 평활 이력 (width * height, 0 = 없음)
+};
+
+void setDefaultDepthFilterOptions(DepthFilterOptions* options){
+  options->stages = DEPTH_FILTER_ALL;
+  options->minDepth = 300;
+  options->maxDepth = 8000;
+  options->speckleRatio = 8;        // 3%
+  options->speckleMinNeighbors = 2;
+  options->spatialRatio = 5;        // 2%
+  options->temporalRatio = 8;       // 3%
+  options->temporalAlpha = 102;     // 0.4
+  options->holeRatio = 8;           // 3%
+  options->holeMinNeighbors = 4;
+}
+
+int parseDepthFilterStages(const char* names){
+  int stages = 0;
+  const struct{ const char* name; int bit; } table[] = {
+    {"range", DEPTH_FILTER_RANGE}, {"speckle", DEPTH_FILTER_SPECKLE}, {"spatial", DEPTH_FILTER_SPATIAL},
+    {"temporal", DEPTH_FILTER_TEMPORAL}, {"holes", DEPTH_FILTER_HOLES}, {"all", DEPTH_FILTER_ALL}, {"none", 0}};
+
+  const char* p = names;
+  while(*p){
+    while(*p == ',' || *p == ' ' || *p == '\t' || *p == '"') p++;
+    size_t length = 0;
+    while(p[length] && p[length] != ',' && !isspace((unsigned char)p[length]) && p[length] != '"') length++;
+    if(length == 0) break;
+    for(size_t i = 0; i < sizeof(table) / sizeof(table[0]); ++i){
+      if(strlen(table[i].name) == length && strncmp(p, table[i].name, length) == 0){
+        stages |= table[i].bit;
+      }
+    }
+    p += length;
+  }
+  return stages;
+}
+
+int loadDepthFilterOptions(const char* yaml_file, DepthFilterOptions* options){
+  FILE* file = fopen(yaml_file, "r");
+  if(!file){
+    return 0;
+  }
+
+  const struct{ const char* key; int* value; } keys[] = {
+    {"minDepth", &options->minDepth}, {"maxDepth", &options->maxDepth},
+    {"speckleRatio", &options->speckleRatio}, {"speckleMinNeighbors", &options->speckleMinNeighbors},
+    {"spatialRatio", &options->spatialRatio}, {"temporalRatio", &options->temporalRatio},
+    {"temporalAlpha", &options->temporalAlpha}, {"holeRatio", &options->holeRatio},
+    {"holeMinNeighbors", &options->holeMinNeighbors}};
+  const char prefix[] = "DepthFilter.";
+
+  char line[512];
+  int found = 0;
+  while(fgets(line, sizeof(line), file)){
+    char* p = line;
+    while(isspace((unsigned char)*p)) p++;
+    if(strncmp(p, prefix, sizeof(prefix) - 1) != 0) continue;
+    p += sizeof(prefix) - 1;
+
+    char* colon = strchr(p, ':');
+    if(!colon) continue;
+    char* key = p;
+    char* end = colon;
+    while(end > key && isspace((unsigned char)end[-1])) end--;
+    *end = '\0';
+    char* value = colon + 1;
+    while(isspace((unsigned char)*value)) value++;
+
+    if(strcmp(key, "stages") == 0){
+      options->stages = parseDepthFilterStages(value);
+      found = 1;
+      continue;
+    }
+    for(size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); ++i){
+      if(strcmp(key, keys[i].key) == 0){
+        char* parsedEnd;
+        long parsed = strtol(value, &parsedEnd, 10);
+        if(parsedEnd != value){
+          *keys[i].value = (int)parsed;
+          found = 1;
+        }
+      }
+    }
+  }
+  fclose(file);
+  return found;
+}
+
+static int clampInt(int value, int low, int high){
+  return value < low ? low : value > high ? high : value;
+}
+
+// 깊이에 비례하는 임계값 (d * ratio >> 8, SIMD 의 mulhi(d, ratio << 8) 과 같은 값)
+static inline int depthThreshold(int d, int ratio){
+  return (d * ratio) >> 8;
+}
+
+//------------------------------------------------------------------------------
+// 행 커널 (rows: 위 / 현재 / 아래 행, 스칼라는 [begin, width) 처리)
+//------------------------------------------------------------------------------
+
+static void rangeRowScalar(const uint16_t* in, uint16_t* out, int begin, int width, int min_depth, int max_depth){
+  for(int u = begin; u < width; ++u){
+    int d = in[u];
+    out[u] = (d >= min_depth && d <= max_depth) ? (uint16_t)d : 0;
+  }
+}
+
+static void speckleRowScalar(const uint16_t* const* rows, uint16_t* out, int begin, int width, int ratio,
+                             int min_neighbors){
+  for(int u = begin; u < width; ++u){
+    int c = rows[1][u];
+    int threshold = depthThreshold(c, ratio);
+    int connected = 0;
+    for(int k = 0; k < 8; ++k){
+      int n = rows[NEIGHBOR_ROW[k]][u + NEIGHBOR_COL[k]];
+      connected += n != 0 && abs(n - c) <= threshold;
+    }
+    out[u] = connected >= min_neighbors ? (uint16_t)c : 0;
+  }
+}
+
+// 범위 안 이웃만 평균 (범위 밖 / 무효 이웃은 중심 값으로 대신해 항상 9 로 나눔)
+static void spatialRowScalar(const uint16_t* const* rows, uint16_t* out, int begin, int width, int ratio){
+  for(int u = begin; u < width; ++u){
+    int c = rows[1][u];
+    int threshold = depthThreshold(c, ratio);
+    int sum = 0;
+    for(int k = 0; k < 8; ++k){
+      int n = rows[NEIGHBOR_ROW[k]][u + NEIGHBOR_COL[k]];
+      if(n != 0 && abs(n - c) <= threshold) sum += n - c;
+    }
+    out[u] = c ? (uint16_t)(c + ((sum * RECIPROCAL_9_Q16) >> 16)) : 0;
+  }
+}
+
+// 이력과 가까우면 지수 평균, 멀면 (움직임) 새 값으로 초기화, 무효 픽셀은 이력 유지
+static void temporalRowScalar(const uint16_t* in, uint16_t* out, uint16_t* history, int begin, int width,
+                              int ratio, int alpha){
+  for(int u = begin; u < width; ++u){
+    int c = in[u], h = history[u];
+    if(c == 0){
+      out[u] = 0;
+      continue;
+    }
+    int value = c;
+    if(h != 0 && abs(c - h) <= depthThreshold(c, ratio)){
+      value = h + (((c - h) * alpha + 128) >> 8);
+    }
+    out[u] = history[u] = (uint16_t)value;
+  }
+}
+
+// 유효한 이웃이 충분하고 고르면 (최대 - 최소 <= 임계값) 최소 / 최대의 중간 값으로 채움
+static void holeRowScalar(const uint16_t* const* rows, uint16_t* out, int begin, int width, int ratio,
+                          int min_neighbors){
+  for(int u = begin; u < width; ++u){
+    int c = rows[1][u];
+    if(c != 0){
+      out[u] = (uint16_t)c;
+      continue;
+    }
+    int count = 0, low = 0xFFFF, high = 0;
+    for(int k = 0; k < 8; ++k){
+      int n = rows[NEIGHBOR_ROW[k]][u + NEIGHBOR_COL[k]];
+      if(n == 0) continue;
+      count++;
+      if(n < low) low = n;
+      if(n > high) high = n;
+    }
+    int fill = count >= min_neighbors && high - low <= depthThreshold(low, ratio);
+    out[u] = fill ? (uint16_t)((low + high + 1) >> 1) : 0;
+  }
+}
+
+#if defined(__SSE2__)
+// 부호 없는 16비트 |a - b|, a <= b, min, max (SSE2 에는 부호 없는 비교가 없어 포화 뺄셈으로 구현)
+static inline __m128i absDiffU16(__m128i a, __m128i b){
+  return _mm_or_si128(_mm_subs_epu16(a, b), _mm_subs_epu16(b, a));
+}
+
+static inline __m128i lessEqualU16(__m128i a, __m128i b){
+  return _mm_cmpeq_epi16(_mm_subs_epu16(a, b), _mm_setzero_si128());
+}
+
+static inline __m128i minU16(__m128i a, __m128i b){
+  return _mm_sub_epi16(a, _mm_subs_epu16(a, b));
+}
+
+static inline __m128i maxU16(__m128i a, __m128i b){
+  return _mm_add_epi16(_mm_subs_epu16(a, b), b);
+}
+#endif
+
+static void rangeRow(const uint16_t* in, uint16_t* out, int width, int min_depth, int max_depth){
+  int u = 0;
+#if defined(__SSE2__)
+  const __m128i low = _mm_set1_epi16((short)min_depth), high = _mm_set1_epi16((short)max_depth);
+  for(; u + 8 <= width; u += 8){
+    __m128i d = _mm_loadu_si128((const __m128i*)(in + u));
+    __m128i valid = _mm_and_si128(lessEqualU16(low, d), lessEqualU16(d, high));
+    _mm_storeu_si128((__m128i*)(out + u), _mm_and_si128(d, valid));
+  }
+#endif
+  rangeRowScalar(in, out, u, width, min_depth, max_depth);
+}
+
+static void speckleRow(const uint16_t* const* rows, uint16_t* out, int width, int ratio, int min_neighbors){
+  int u = 0;
+#if defined(__SSE2__)
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i ratio8 = _mm_set1_epi16((short)(ratio << 8));
+  const __m128i minCount = _mm_set1_epi16((short)(min_neighbors - 1));
+  for(; u + 8 <= width; u += 8){
+    __m128i c = _mm_loadu_si128((const __m128i*)(rows[1] + u));
+    __m128i threshold = _mm_mulhi_epu16(c, ratio8);
+    __m128i count = zero;
+    for(int k = 0; k < 8; ++k){
+      __m128i n = _mm_loadu_si128((const __m128i*)(rows[NEIGHBOR_ROW[k]] + u + NEIGHBOR_COL[k]));
+      __m128i close = lessEqualU16(absDiffU16(n, c), threshold);
+      count = _mm_sub_epi16(count, _mm_andnot_si128(_mm_cmpeq_epi16(n, zero), close));
+    }
+    __m128i keep = _mm_cmpgt_epi16(count, minCount);
+    _mm_storeu_si128((__m128i*)(out + u), _mm_and_si128(c, keep));
+  }
+#endif
+  speckleRowScalar(rows, out, u, width, ratio, min_neighbors);
+}
+
+static void spatialRow(const uint16_t* const* rows, uint16_t* out, int width, int ratio){
+  int u = 0;
+#if defined(__SSE2__)
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i ratio8 = _mm_set1_epi16((short)(ratio << 8));
+  const __m128i reciprocal = _mm_set1_epi16(RECIPROCAL_9_Q16);
+  for(; u + 8 <= width; u += 8){
+    __m128i c = _mm_loadu_si128((const __m128i*)(rows[1] + u));
+    __m128i threshold = _mm_mulhi_epu16(c, ratio8);
+    // 차이 합은 8 * threshold 이하 (ratio 제한으로 16비트 안)
+    __m128i sum = zero;
+    for(int k = 0; k < 8; ++k){
+      __m128i n = _mm_loadu_si128((const __m128i*)(rows[NEIGHBOR_ROW[k]] + u + NEIGHBOR_COL[k]));
+      __m128i accept = _mm_andnot_si128(_mm_cmpeq_epi16(n, zero), lessEqualU16(absDiffU16(n, c), threshold));
+      sum = _mm_add_epi16(sum, _mm_and_si128(_mm_sub_epi16(n, c), accept));
+    }
+    __m128i value = _mm_add_epi16(c, _mm_mulhi_epi16(sum, reciprocal));
+    _mm_storeu_si128((__m128i*)(out + u), _mm_andnot_si128(_mm_cmpeq_epi16(c, zero), value));
+  }
+#endif
+  spatialRowScalar(rows, out, u, width, ratio);
+}
+
+static void temporalRow(const uint16_t* in, uint16_t* out, uint16_t* history, int width, int ratio, int alpha){
+  int u = 0;
+#if defined(__SSE2__)
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i ratio8 = _mm_set1_epi16((short)(ratio << 8));
+  const __m128i weight = _mm_set1_epi16((short)alpha);
+  const __m128i round = _mm_set1_epi32(128);
+  for(; u + 8 <= width; u += 8){
+    __m128i c = _mm_loadu_si128((const __m128i*)(in + u));
+    __m128i h = _mm_loadu_si128((const __m128i*)(history + u));
+    __m128i invalid = _mm_cmpeq_epi16(c, zero);
+    __m128i similar = _mm_andnot_si128(_mm_cmpeq_epi16(h, zero),
+                                       lessEqualU16(absDiffU16(c, h), _mm_mulhi_epu16(c, ratio8)));
+
+    // (c - h) * alpha 를 32비트로 계산 (ratio 제한으로 차이는 16비트 부호 범위 안)
+    __m128i diff = _mm_sub_epi16(c, h);
+    __m128i lo = _mm_mullo_epi16(diff, weight), hi = _mm_mulhi_epi16(diff, weight);
+    __m128i p0 = _mm_srai_epi32(_mm_add_epi32(_mm_unpacklo_epi16(lo, hi), round), 8);
+    __m128i p1 = _mm_srai_epi32(_mm_add_epi32(_mm_unpackhi_epi16(lo, hi), round), 8);
+    __m128i smooth = _mm_add_epi16(h, _mm_packs_epi32(p0, p1));
+
+    __m128i value = _mm_or_si128(_mm_and_si128(similar, smooth), _mm_andnot_si128(similar, c));
+    _mm_storeu_si128((__m128i*)(out + u), _mm_andnot_si128(invalid, value));
+    _mm_storeu_si128((__m128i*)(history + u),
+                     _mm_or_si128(_mm_and_si128(invalid, h), _mm_andnot_si128(invalid, value)));
+  }
+#endif
+  temporalRowScalar(in, out, history, u, width, ratio, alpha);
+}
+
+static void holeRow(const uint16_t* const* rows, uint16_t* out, int width, int ratio, int min_neighbors){
+  int u = 0;
+#if defined(__SSE2__)
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i ratio8 = _mm_set1_epi16((short)(ratio << 8));
+  const __m128i minCount = _mm_set1_epi16((short)(min_neighbors - 1));
+  for(; u + 8 <= width; u += 8){
+    __m128i c = _mm_loadu_si128((const __m128i*)(rows[1] + u));
+    __m128i empty = _mm_cmpeq_epi16(c, zero);
+    if(_mm_movemask_epi8(empty) == 0){
+      _mm_storeu_si128((__m128i*)(out + u), c);
+      continue;
+    }
+
+    __m128i count = zero, low = _mm_set1_epi16(-1), high = zero;
+    for(int k = 0; k < 8; ++k){
+      __m128i n = _mm_loadu_si128((const __m128i*)(rows[NEIGHBOR_ROW[k]] + u + NEIGHBOR_COL[k]));
+      __m128i invalid = _mm_cmpeq_epi16(n, zero);
+      count = _mm_sub_epi16(count, _mm_andnot_si128(invalid, _mm_set1_epi16(-1)));
+      low = minU16(low, _mm_or_si128(n, invalid));
+      high = maxU16(high, n);
+    }
+    __m128i even = lessEqualU16(_mm_sub_epi16(high, low), _mm_mulhi_epu16(low, ratio8));
+    __m128i fill = _mm_and_si128(_mm_and_si128(empty, even), _mm_cmpgt_epi16(count, minCount));
+    _mm_storeu_si128((__m128i*)(out + u), _mm_or_si128(c, _mm_and_si128(fill, _mm_avg_epu16(low, high))));
+  }
+#endif
+  holeRowScalar(rows, out, u, width, ratio, min_neighbors);
+}
+
+//------------------------------------------------------------------------------
+// 필터 체인
+//------------------------------------------------------------------------------
+
+DepthFilter* createDepthFilter(const DepthFilterOptions* options, int width, int height){
+  if(width <= 0 || height <= 0){
+    return NULL;
+  }
+  DepthFilter* filter = (DepthFilter*)calloc(1, sizeof(DepthFilter));
+  if(!filter){
+    return NULL;
+  }
+
+  // 16비트 커널 범위에 맞게 제한 (공간 평균은 차이 합, 시간 평활은 차이가 16비트 부호 범위 안이어야 함)
+  filter->options = *options;
+  DepthFilterOptions* o = &filter->options;
+  o->minDepth = clampInt(o->minDepth, 1, 0xFFFF);
+  o->maxDepth = clampInt(o->maxDepth, o->minDepth, 0xFFFF);
+  o->speckleRatio = clampInt(o->speckleRatio, 0, 255);
+  o->speckleMinNeighbors = clampInt(o->speckleMinNeighbors, 1, 8);
+  o->spatialRatio = clampInt(o->spatialRatio, 0, 15);
+  o->temporalRatio = clampInt(o->temporalRatio, 0, 127);
+  o->temporalAlpha = clampInt(o->temporalAlpha, 1, 256);
+  o->holeRatio = clampInt(o->holeRatio, 0, 255);
+  o->holeMinNeighbors = clampInt(o->holeMinNeighbors, 1, 8);
+
+  filter->width = width;
+  filter->height = height;
+  filter->stride = ROW_PAD + ((width + 7) & ~7) + ROW_PAD;
+
+  const int order[MAX_FILTER_STAGES] = {DEPTH_FILTER_RANGE, DEPTH_FILTER_SPECKLE, DEPTH_FILTER_SPATIAL,
+                                        DEPTH_FILTER_TEMPORAL, DEPTH_FILTER_HOLES};
+  int rows = 1, lag = 0;
+  for(int i = 0; i < MAX_FILTER_STAGES; ++i){
+    if(!(o->stages & order[i])) continue;
+    FilterStage* stage = &filter->stages[filter->stageCount++];
+    stage->type = order[i];
+    stage->radius = order[i] == DEPTH_FILTER_RANGE || order[i] == DEPTH_FILTER_TEMPORAL ? 0 : 1;
+    stage->ringRows = 2 * stage->radius + 1;
+    lag += stage->radius;
+    stage->lag = lag;
+    rows += stage->ringRows;
+  }
+
+  filter->rowMemory = (uint16_t*)alignedAlloc((size_t)rows * filter->stride * sizeof(uint16_t));
+  if(o->stages & DEPTH_FILTER_TEMPORAL){
+    filter->history = (uint16_t*)alignedAlloc((size_t)width * height * sizeof(uint16_t));
+  }
+  if(!filter->rowMemory || ((o->stages & DEPTH_FILTER_TEMPORAL) && !filter->history)){
+    destroyDepthFilter(filter);
+    return NULL;
+  }
+  memset(filter->rowMemory, 0, (size_t)rows * filter->stride * sizeof(uint16_t));
+  resetDepthFilter(filter);
+
+  uint16_t* row = filter->rowMemory + ROW_PAD;
+  filter->zeroRow = row;
+  row += filter->stride;
+  for(int i = 0; i < filter->stageCount; ++i){
+    filter->stages[i].ring = row;
+    row += (size_t)filter->stages[i].ringRows * filter->stride;
+  }
+  return filter;
+}
+
+void destroyDepthFilter(DepthFilter* filter){
+  if(!filter) return;
+  free(filter->rowMemory);
+  free(filter->history);
+  free(filter);
+}
+
+void resetDepthFilter(DepthFilter* filter){
+  if(filter->history){
+    memset(filter->history, 0, (size_t)filter->width * filter->height * sizeof(uint16_t));
+  }
+}
+
+static uint16_t* ringRow(const DepthFilter* filter, const FilterStage* stage, int y){
+  return stage->ring + (size_t)(y % stage->ringRows) * filter->stride;
+}
+
+static void runStage(DepthFilter* filter, const FilterStage* stage, const uint16_t* const* rows, uint16_t* out,
+                     int y, int simd){
+  const DepthFilterOptions* o = &filter->options;
+  const int width = filter->width;
+  switch(stage->type){
+    case DEPTH_FILTER_RANGE:
+      if(simd) rangeRow(rows[0], out, width, o->minDepth, o->maxDepth);
+      else rangeRowScalar(rows[0], out, 0, width, o->minDepth, o->maxDepth);
+      break;
+    case DEPTH_FILTER_SPECKLE:
+      if(simd) speckleRow(rows, out, width, o->speckleRatio, o->speckleMinNeighbors);
+      else speckleRowScalar(rows, out, 0, width, o->speckleRatio, o->speckleMinNeighbors);
+      break;
+    case DEPTH_FILTER_SPATIAL:
+      if(simd) spatialRow(rows, out, width, o->spatialRatio);
+      else spatialRowScalar(rows, out, 0, width, o->spatialRatio);
+      break;
+    case DEPTH_FILTER_TEMPORAL: {
+      uint16_t* history = filter->history + (size_t)y * width;
+      if(simd) temporalRow(rows[0], out, history, width, o->temporalRatio, o->temporalAlpha);
+      else temporalRowScalar(rows[0], out, history, 0, width, o->temporalRatio, o->temporalAlpha);
+      break;
+    }
+    case DEPTH_FILTER_HOLES:
+      if(simd) holeRow(rows, out, width, o->holeRatio, o->holeMinNeighbors);
+      else holeRowScalar(rows, out, 0, width, o->holeRatio, o->holeMinNeighbors);
+      break;
+  }
+}
+
+// 행 단위 파이프라인: 원본 i 행을 넣을 때마다 각 단계가 (i - lag) 행을 출력
+// 단계 사이에는 이웃 반경만큼의 행 버퍼만 두므로 한 프레임을 한 번만 읽고 씀 (중간 프레임 없음)
+static void runChain(DepthFilter* filter, const uint16_t* src, uint16_t* dst, int simd){
+  const int width = filter->width, height = filter->height;
+  if(filter->stageCount == 0){
+    if(dst != src) memcpy(dst, src, (size_t)width * height * sizeof(uint16_t));
+    return;
+  }
+
+  const FilterStage* last = &filter->stages[filter->stageCount - 1];
+  for(int i = 0; i < height + last->lag; ++i){
+    // 원본 행 복사 (dst == src 여도 i 행까지 읽은 뒤에만 그보다 위의 행을 씀)
+    if(i < height){
+      memcpy(ringRow(filter, &filter->stages[0], i), src + (size_t)i * width, width * sizeof(uint16_t));
+    }
+
+    for(int s = 0; s < filter->stageCount; ++s){
+      const FilterStage* stage = &filter->stages[s];
+      const int y = i - stage->lag;
+      if(y < 0 || y >= height) continue;
+
+      const uint16_t* rows[3];
+      for(int k = -stage->radius; k <= stage->radius; ++k){
+        const int r = y + k;
+        rows[k + stage->radius] = r < 0 || r >= height ? filter->zeroRow : ringRow(filter, stage, r);
+      }
+      uint16_t* out = s + 1 < filter->stageCount ? ringRow(filter, &filter->stages[s + 1], y)
+                                                 : dst + (size_t)y * width;
+      runStage(filter, stage, rows, out, y, simd);
+    }
+  }
+}
+
+void applyDepthFilter(DepthFilter* filter, const uint16_t* src, uint16_t* dst){
+  runChain(filter, src, dst, 1);
+}
+
+void applyDepthFilterScalar(DepthFilter* filter, const uint16_t* src, uint16_t* dst){
+  runChain(filter, src, dst, 0);
+}
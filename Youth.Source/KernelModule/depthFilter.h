@@ -0,0 +1,63 @@
+#ifndef DEPTH_FILTER_H
+#define DEPTH_FILTER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 깊이 전처리 단계 (stages 비트, 적용 순서도 아래 순서)
+#define DEPTH_FILTER_RANGE    0x01  // 범위 밖 깊이 제거
+#define DEPTH_FILTER_SPECKLE  0x02  // 주변과 이어지지 않은 점 (speckle, flying pixel) 제거
+#define DEPTH_FILTER_SPATIAL  0x04  // 3x3 범위 제한 평균 (경계 보존)
+#define DEPTH_FILTER_TEMPORAL 0x08  // 픽셀별 이력으로 시간 평활 (움직이면 초기화)
+#define DEPTH_FILTER_HOLES    0x10  // 주변이 고른 작은 구멍 채우기
+#define DEPTH_FILTER_ALL      0x1F
+
+// 깊이는 mm (0 = 무효), 임계값 비율은 Q8 (깊이 * ratio / 256, Astra 노이즈는 거리에 비례해 커짐)
+typedef struct{
+  int stages;               // DEPTH_FILTER_* 조합 (0 이면 적용 안 함)
+  int minDepth, maxDepth;   // 유효 범위 (mm)
+  int speckleRatio;         // 이웃이 "이어진" 것으로 보는 깊이 차이
+  int speckleMinNeighbors;  // 이어진 이웃이 이보다 적으면 제거 (1 ~ 8)
+  int spatialRatio;         // 평균에 넣는 이웃의 깊이 차이
+  int temporalRatio;        // 이력과 이보다 차이 나면 이력 초기화
+  int temporalAlpha;        // 새 값 비중 (Q8, 256 이면 평활 없음)
+  int holeRatio;            // 채울 때 주변 깊이 최대 - 최소 허용치
+  int holeMinNeighbors;     // 유효한 이웃이 이보다 적으면 채우지 않음 (1 ~ 8)
+} DepthFilterOptions;
+
+// 모든 단계 사용, 0.3 ~ 8 m
+void setDefaultDepthFilterOptions(DepthFilterOptions* options);
+
+// "range,speckle,spatial,temporal,holes" (또는 all, none) 형식의 단계 목록 -> DEPTH_FILTER_* 조합
+int parseDepthFilterStages(const char* names);
+
+// 설정 파일 (ORB-SLAM3 YAML) 의 DepthFilter.xxx 항목 읽기 (예: DepthFilter.maxDepth: 6000)
+// DepthFilter.stages 는 range,speckle,spatial,temporal,holes 중 쉼표 목록 (또는 all, none)
+// 없는 항목은 기존 값 유지, 반환값: 항목을 하나라도 읽으면 1
+int loadDepthFilterOptions(const char* yaml_file, DepthFilterOptions* options);
+
+// 필터 체인 (시간 평활 이력 포함, 카메라마다 하나)
+// 모든 단계를 행 버퍼로 이어서 한 번에 처리하므로 중간 결과는 몇 행 (L1) 만 사용
+typedef struct DepthFilter DepthFilter;
+
+// 반환값: 실패 시 NULL
+DepthFilter* createDepthFilter(const DepthFilterOptions* options, int width, int height);
+void destroyDepthFilter(DepthFilter* filter);
+
+// 시간 평활 이력 초기화 (장면이 바뀌었을 때)
+void resetDepthFilter(DepthFilter* filter);
+
+// src -> dst (같은 버퍼 가능), 크기는 생성할 때와 같아야 함
+void applyDepthFilter(DepthFilter* filter, const uint16_t* src, uint16_t* dst);
+
+// 스칼라 기준 구현 (검증 및 벤치마크용, 시간 평활 이력도 갱신)
+void applyDepthFilterScalar(DepthFilter* filter, const uint16_t* src, uint16_t* dst);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DEPTH_FILTER_H
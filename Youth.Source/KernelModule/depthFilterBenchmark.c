@@ -0,0 +1,202 @@
+// 깊이 필터 체인 벤치마크
+// 사용법: DepthFilterBenchmark [camera.yaml] [width] [height] [iterations]
+// 합성 깊이 영상 (거리 제곱에 비례하는 노이즈, 튀는 점, 작은 구멍, 범위 밖 배경) 으로
+// SIMD 와 스칼라 결과가 같은지 확인한 뒤 단계별 / 전체 처리 시간 (ms/frame) 과 실제 깊이 대비 오차를 출력
+
+#include "depthFilter.h"
+#include "benchmarkUtil.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SEQUENCE_FRAMES 8
+#define BUDGET_MS 3.0
+
+// 장면: 기울어진 벽 앞에 상자, 오른쪽 위는 센서 범위 밖 (실제 깊이 truth, 관측 depth)
+static void renderScene(int frame, int width, int height, uint16_t* truth, uint16_t* depth){
+  uint32_t rng = 0x9E3779B9u ^ (uint32_t)(frame * 7919 + 1);
+  for(int v = 0; v < height; ++v){
+    for(int u = 0; u < width; ++u){
+      size_t i = (size_t)v * width + u;
+      float z = 2000.0f + u * 3000.0f / width + v * 500.0f / height;
+      if(u > width / 4 && u < width / 2 && v > height / 3 && v < height * 2 / 3) z = 1200.0f;
+      if(u > width * 3 / 4 && v < height / 4) z = 12000.0f;
+      truth[i] = (uint16_t)z;
+
+      // Astra 노이즈는 거리 제곱에 비례 (2 m 에서 약 4 mm)
+      float observed = z + benchmarkGaussian(&rng) * z * z * 1e-6f;
+      uint32_t r = benchmarkRandom(&rng) % 1000;
+      if(r < 5) observed = 500.0f + benchmarkRandom(&rng) % 6000;    // 튀는 점 0.5%
+      else if(r < 20) observed = 0.0f;                           // 구멍 1.5%
+      depth[i] = observed > 65535.0f ? 65535 : (uint16_t)observed;
+    }
+  }
+}
+
+typedef struct{
+  const char* name;
+  int stages;
+} StageSet;
+
+// SIMD / 스칼라 필터에 같은 영상 순서를 넣고 결과가 모두 같은지 확인 (시간 평활 이력 포함)
+static int verify(const DepthFilterOptions* base, const StageSet* set, int width, int height, uint16_t** frames,
+                  uint16_t* a, uint16_t* b){
+  DepthFilterOptions options = *base;
+  options.stages = set->stages;
+  DepthFilter* simd = createDepthFilter(&options, width, height);
+  DepthFilter* scalar = createDepthFilter(&options, width, height);
+  int ok = simd && scalar;
+  size_t pixels = (size_t)width * height;
+  for(int f = 0; ok && f < SEQUENCE_FRAMES * 2; ++f){
+    const uint16_t* src = frames[f % SEQUENCE_FRAMES];
+    applyDepthFilter(simd, src, a);
+    applyDepthFilterScalar(scalar, src, b);
+    for(size_t i = 0; i < pixels; ++i){
+      if(a[i] != b[i]){
+        fprintf(stderr, "%s: frame %d pixel %zu mismatch (simd %u, scalar %u)\n", set->name, f, i, a[i], b[i]);
+        ok = 0;
+        break;
+      }
+    }
+  }
+
+  // 제자리 처리 (dst == src) 도 같은 결과인지 확인
+  if(ok){
+    resetDepthFilter(simd);
+    resetDepthFilter(scalar);
+    memcpy(a, frames[0], pixels * sizeof(uint16_t));
+    applyDepthFilter(simd, a, a);
+    applyDepthFilterScalar(scalar, frames[0], b);
+    if(memcmp(a, b, pixels * sizeof(uint16_t)) != 0){
+      fprintf(stderr, "%s: in-place output mismatch\n", set->name);
+      ok = 0;
+    }
+  }
+  destroyDepthFilter(simd);
+  destroyDepthFilter(scalar);
+  return ok;
+}
+
+typedef void (*FilterFunc)(DepthFilter*, const uint16_t*, uint16_t*);
+
+static double runBenchmark(const char* name, FilterFunc func, const DepthFilterOptions* base, int stages, int width,
+                           int height, int iterations, uint16_t** frames, uint16_t* out){
+  DepthFilterOptions options = *base;
+  options.stages = stages;
+  DepthFilter* filter = createDepthFilter(&options, width, height);
+  if(!filter){
+    return 0.0;
+  }
+
+  // 워밍업
+  func(filter, frames[0], out);
+
+  double start = benchmarkNow();
+  for(int i = 0; i < iterations; ++i){
+    func(filter, frames[i % SEQUENCE_FRAMES], out);
+  }
+  double elapsed = benchmarkNow() - start;
+  destroyDepthFilter(filter);
+
+  double ms = elapsed * 1000.0 / iterations;
+  printf("%-20s %8.3f ms/frame  %8.1f Mpixels/s\n", name, ms, (double)width * height * iterations / elapsed / 1e6);
+  return ms;
+}
+
+// 실제 깊이 대비 평균 절대 오차 (센서 범위 안, 양쪽 모두 유효한 픽셀), 큰 오차 (5% 초과) / 무효 픽셀 비율
+static void measure(const char* name, const uint16_t* truth, const uint16_t* depth, size_t pixels, int max_depth){
+  double errorSum = 0.0;
+  size_t valid = 0, outliers = 0, missing = 0, inRange = 0;
+  for(size_t i = 0; i < pixels; ++i){
+    if(truth[i] > max_depth) continue;
+    inRange++;
+    if(depth[i] == 0){
+      missing++;
+      continue;
+    }
+    double error = fabs((double)depth[i] - truth[i]);
+    if(error > truth[i] * 0.05){
+      outliers++;
+      continue;
+    }
+    errorSum += error;
+    valid++;
+  }
+  printf("%-10s error %6.2f mm avg, outliers %5.2f%%, missing %5.2f%%\n", name, valid ? errorSum / valid : 0.0,
+         100.0 * outliers / inRange, 100.0 * missing / inRange);
+}
+
+int main(int argc, char** argv){
+  int width = argc > 2 ? atoi(argv[2]) : 640;
+  int height = argc > 3 ? atoi(argv[3]) : 480;
+  int iterations = argc > 4 ? atoi(argv[4]) : 200;
+  if(width < 1 || height < 1 || iterations < 1){
+    fprintf(stderr, "Usage: %s [camera.yaml] [width] [height] [iterations]\n", argv[0]);
+    return 1;
+  }
+
+  DepthFilterOptions options;
+  setDefaultDepthFilterOptions(&options);
+  if(argc > 1 && loadDepthFilterOptions(argv[1], &options)){
+    printf("Depth filter options from %s\n", argv[1]);
+  }
+  printf("Frame %dx%d, range %d~%d mm, speckle %d/256 (%d neighbors), spatial %d/256, temporal %d/256 "
+         "(alpha %d/256), holes %d/256 (%d neighbors)\n", width, height, options.minDepth, options.maxDepth,
+         options.speckleRatio, options.speckleMinNeighbors, options.spatialRatio, options.temporalRatio,
+         options.temporalAlpha, options.holeRatio, options.holeMinNeighbors);
+
+  size_t pixels = (size_t)width * height;
+  uint16_t* truth = (uint16_t*)malloc(pixels * sizeof(uint16_t));
+  uint16_t* frames[SEQUENCE_FRAMES];
+  uint16_t* a = (uint16_t*)malloc(pixels * sizeof(uint16_t));
+  uint16_t* b = (uint16_t*)malloc(pixels * sizeof(uint16_t));
+  if(!truth || !a || !b){
+    return 1;
+  }
+  for(int f = 0; f < SEQUENCE_FRAMES; ++f){
+    frames[f] = (uint16_t*)malloc(pixels * sizeof(uint16_t));
+    if(!frames[f]) return 1;
+    renderScene(f, width, height, truth, frames[f]);
+  }
+
+  const StageSet sets[] = {
+    {"range", DEPTH_FILTER_RANGE},       {"speckle", DEPTH_FILTER_SPECKLE},   {"spatial", DEPTH_FILTER_SPATIAL},
+    {"temporal", DEPTH_FILTER_TEMPORAL}, {"holes", DEPTH_FILTER_HOLES},       {"chain", options.stages}};
+  const int setCount = sizeof(sets) / sizeof(sets[0]);
+
+  for(int s = 0; s < setCount; ++s){
+    if(!verify(&options, &sets[s], width, height, frames, a, b)){
+      return 1;
+    }
+  }
+  printf("SIMD output matches scalar reference\n");
+
+  for(int s = 0; s < setCount - 1; ++s){
+    runBenchmark(sets[s].name, applyDepthFilter, &options, sets[s].stages, width, height, iterations, frames, a);
+  }
+  runBenchmark("chain (scalar)", applyDepthFilterScalar, &options, options.stages, width, height, iterations,
+               frames, a);
+  double chainMs = runBenchmark("chain", applyDepthFilter, &options, options.stages, width, height, iterations,
+                                frames, a);
+  printf("Chain %.3f ms/frame, %s %.1f ms budget\n", chainMs, chainMs <= BUDGET_MS ? "within" : "OVER", BUDGET_MS);
+
+  // 정적 장면 순서를 전부 거친 뒤의 결과로 품질 비교 (시간 평활이 수렴한 상태)
+  DepthFilter* filter = createDepthFilter(&options, width, height);
+  if(filter){
+    for(int f = 0; f < SEQUENCE_FRAMES; ++f){
+      applyDepthFilter(filter, frames[f], a);
+    }
+    measure("raw", truth, frames[SEQUENCE_FRAMES - 1], pixels, options.maxDepth);
+    measure("filtered", truth, a, pixels, options.maxDepth);
+    destroyDepthFilter(filter);
+  }
+
+  for(int f = 0; f < SEQUENCE_FRAMES; ++f){
+    free(frames[f]);
+  }
+  free(truth);
+  free(a);
+  free(b);
+  return 0;
+}
@@ -0,0 +1,341 @@
+#include "depthRegistration.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define MAX_REGISTRATION_THREADS 16
+
+typedef struct{
+  DepthRegistration* registration;
+  int band;
+  pthread_t thread;
+} RegistrationWorker;
+
+struct DepthRegistration{
+  int depthWidth, depthHeight;
+  int colorWidth, colorHeight;
+
+  // 깊이 픽셀별 투영 계수: 색상 좌표 = (z * map + offset) / (z * mapZ + offsetZ)
+  float* mapU;
+  float* mapV;
+  float* mapZ;
+  float offsetU, offsetV, offsetZ;
+  float zLow, zHigh;      // 정합할 깊이 값 범위 (깊이 단위)
+
+  // 결과 행 구간과 그 구간에 투영될 수 있는 입력 행 범위
+  int bands;
+  int* destBegin;         // bands + 1
+  int* srcBegin;
+  int* srcEnd;
+
+  // 상주 작업 스레드 (프레임마다 스레드를 만들지 않음, 구간 0 은 호출 스레드)
+  RegistrationWorker* workers;
+  int workerCount;
+  pthread_mutex_t mutex;
+  pthread_cond_t startCond;
+  pthread_cond_t doneCond;
+  uint64_t generation;
+  int pending;
+  int stop;
+  const uint16_t* jobDepth;
+  uint16_t* jobOut;
+};
+
+// 가까운 깊이만 남김 (구간 밖의 행은 다른 스레드 담당)
+static inline void splat(uint16_t* out, int width, int dest_begin, int dest_end, int u, int v, int z){
+  if((unsigned)u >= (unsigned)width || v < dest_begin || v >= dest_end || z <= 0){
+    return;
+  }
+  uint16_t* pixel = out + (size_t)v * width + u;
+  uint16_t depth = z > 0xFFFF ? 0xFFFF : (uint16_t)z;
+  if(*pixel == 0 || depth < *pixel){
+    *pixel = depth;
+  }
+}
+
+static void registerPixelsScalar(const DepthRegistration* r, const uint16_t* depth, uint16_t* out, int v,
+                                 int u_begin, int dest_begin, int dest_end){
+  const size_t rowOffset = (size_t)v * r->depthWidth;
+  for(int u = u_begin; u < r->depthWidth; ++u){
+    const size_t i = rowOffset + u;
+    const float z = (float)depth[i];
+    if(!(z >= r->zLow && z <= r->zHigh)) continue;
+
+    const float zc = z * r->mapZ[i] + r->offsetZ;
+    if(!(zc > 0.0f)) continue;
+    const float inv = 1.0f / zc;
+    const float uc = (z * r->mapU[i] + r->offsetU) * inv;
+    const float vc = (z * r->mapV[i] + r->offsetV) * inv;
+    if(!(uc > -1e9f && uc < 1e9f && vc > -1e9f && vc < 1e9f)) continue;
+
+    splat(out, r->colorWidth, dest_begin, dest_end, (int)lrintf(uc), (int)lrintf(vc), (int)lrintf(zc));
+  }
+}
+
+static void registerBand(DepthRegistration* r, const uint16_t* depth, uint16_t* out, int band, int simd){
+  const int destBegin = r->destBegin[band], destEnd = r->destBegin[band + 1];
+  memset(out + (size_t)destBegin * r->colorWidth, 0,
+         (size_t)(destEnd - destBegin) * r->colorWidth * sizeof(uint16_t));
+
+  for(int v = r->srcBegin[band]; v < r->srcEnd[band]; ++v){
+    int u = 0;
+#if defined(__SSE2__)
+    if(simd){
+      const __m128i zero = _mm_setzero_si128();
+      const __m128 zLow = _mm_set1_ps(r->zLow), zHigh = _mm_set1_ps(r->zHigh);
+      const __m128 offsetU = _mm_set1_ps(r->offsetU), offsetV = _mm_set1_ps(r->offsetV);
+      const __m128 offsetZ = _mm_set1_ps(r->offsetZ), one = _mm_set1_ps(1.0f), zeroPs = _mm_setzero_ps();
+      const size_t rowOffset = (size_t)v * r->depthWidth;
+
+      // 4 픽셀씩 투영 (나눗셈 포함 모두 SIMD), 쓰기는 z-buffer 비교가 필요해 픽셀마다
+      for(; u + 4 <= r->depthWidth; u += 4){
+        const size_t i = rowOffset + u;
+        __m128i d16 = _mm_loadl_epi64((const __m128i*)(depth + i));
+        __m128 z = _mm_cvtepi32_ps(_mm_unpacklo_epi16(d16, zero));
+        __m128 zc = _mm_add_ps(_mm_mul_ps(z, _mm_loadu_ps(r->mapZ + i)), offsetZ);
+        __m128 valid = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(z, zLow), _mm_cmple_ps(z, zHigh)),
+                                  _mm_cmpgt_ps(zc, zeroPs));
+        int mask = _mm_movemask_ps(valid);
+        if(mask == 0) continue;
+
+        __m128 inv = _mm_div_ps(one, zc);
+        __m128 uc = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(z, _mm_loadu_ps(r->mapU + i)), offsetU), inv);
+        __m128 vc = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(z, _mm_loadu_ps(r->mapV + i)), offsetV), inv);
+
+        int32_t pu[4], pv[4], pz[4];
+        _mm_storeu_si128((__m128i*)pu, _mm_cvtps_epi32(uc));
+        _mm_storeu_si128((__m128i*)pv, _mm_cvtps_epi32(vc));
+        _mm_storeu_si128((__m128i*)pz, _mm_cvtps_epi32(zc));
+        for(int k = 0; k < 4; ++k){
+          if((mask >> k) & 1){
+            splat(out, r->colorWidth, destBegin, destEnd, pu[k], pv[k], pz[k]);
+          }
+        }
+      }
+    }
+#else
+    (void)simd;
+#endif
+    registerPixelsScalar(r, depth, out, v, u, destBegin, destEnd);
+  }
+}
+
+static void* registrationWorkerLoop(void* arg){
+  RegistrationWorker* worker = (RegistrationWorker*)arg;
+  DepthRegistration* r = worker->registration;
+  uint64_t seen = 0;
+
+  pthread_mutex_lock(&r->mutex);
+  while(1){
+    while(!r->stop && r->generation == seen){
+      pthread_cond_wait(&r->startCond, &r->mutex);
+    }
+    if(r->stop) break;
+    seen = r->generation;
+    const uint16_t* depth = r->jobDepth;
+    uint16_t* out = r->jobOut;
+    pthread_mutex_unlock(&r->mutex);
+
+    registerBand(r, depth, out, worker->band, 1);
+
+    pthread_mutex_lock(&r->mutex);
+    if(--r->pending == 0){
+      pthread_cond_signal(&r->doneCond);
+    }
+  }
+  pthread_mutex_unlock(&r->mutex);
+  return NULL;
+}
+
+// 입력 행마다 투영될 수 있는 결과 행 범위 (투영은 깊이에 대해 단조이므로 범위 양 끝 깊이만 확인)
+static void projectRowRange(const DepthRegistration* r, int v, int* low, int* high){
+  const float depths[2] = {r->zLow, r->zHigh};
+  float minRow = 1e30f, maxRow = -1e30f;
+  for(int u = 0; u < r->depthWidth; ++u){
+    const size_t i = (size_t)v * r->depthWidth + u;
+    for(int k = 0; k < 2; ++k){
+      float zc = depths[k] * r->mapZ[i] + r->offsetZ;
+      if(zc <= 0.0f) continue;
+      float vc = (depths[k] * r->mapV[i] + r->offsetV) / zc;
+      if(vc < minRow) minRow = vc;
+      if(vc > maxRow) maxRow = vc;
+    }
+  }
+  // 반올림 여유 1 행
+  *low = minRow > maxRow ? r->colorHeight : (int)fmaxf(floorf(minRow) - 1.0f, -1.0f);
+  *high = minRow > maxRow ? -1 : (int)fminf(ceilf(maxRow) + 1.0f, (float)r->colorHeight);
+}
+
+DepthRegistration* createDepthRegistration(const DepthColorCalibration* calibration, int depth_width,
+                                           int depth_height, int color_width, int color_height, float min_depth,
+                                           float max_depth, int threads){
+  if(depth_width <= 0 || depth_height <= 0 || color_width <= 0 || color_height <= 0 ||
+     calibration->depth.fx <= 0.0f || calibration->depth.fy <= 0.0f || calibration->color.fx <= 0.0f ||
+     calibration->color.fy <= 0.0f){
+    return NULL;
+  }
+  DepthRegistration* r = (DepthRegistration*)calloc(1, sizeof(DepthRegistration));
+  if(!r){
+    return NULL;
+  }
+  pthread_mutex_init(&r->mutex, NULL);
+  pthread_cond_init(&r->startCond, NULL);
+  pthread_cond_init(&r->doneCond, NULL);
+  r->depthWidth = depth_width;
+  r->depthHeight = depth_height;
+  r->colorWidth = color_width;
+  r->colorHeight = color_height;
+
+  CameraIntrinsics Kd, Kc;
+  scaleCameraIntrinsics(&calibration->depth, depth_width, depth_height, &Kd);
+  scaleCameraIntrinsics(&calibration->color, color_width, color_height, &Kc);
+
+  // 이동은 깊이 값 단위 (mm) 로 바꿔 결과 깊이도 같은 단위
+  const float* R = calibration->rotation;
+  const float factor = Kd.depthFactor > 0.0f ? Kd.depthFactor : 1000.0f;
+  const float t[3] = {calibration->translation[0] * factor, calibration->translation[1] * factor,
+                      calibration->translation[2] * factor};
+  r->offsetU = Kc.fx * t[0] + Kc.cx * t[2];
+  r->offsetV = Kc.fy * t[1] + Kc.cy * t[2];
+  r->offsetZ = t[2];
+  r->zLow = fmaxf(ceilf(min_depth * factor), 1.0f);
+  r->zHigh = fminf(floorf(max_depth * factor), 65535.0f);
+
+  size_t pixels = (size_t)depth_width * depth_height;
+  r->mapU = (float*)alignedAlloc(pixels * sizeof(float));
+  r->mapV = (float*)alignedAlloc(pixels * sizeof(float));
+  r->mapZ = (float*)alignedAlloc(pixels * sizeof(float));
+
+  if(threads < 1) threads = 1;
+  if(threads > MAX_REGISTRATION_THREADS) threads = MAX_REGISTRATION_THREADS;
+  if(threads > color_height) threads = color_height;
+  r->bands = threads;
+  r->destBegin = (int*)calloc(threads + 1, sizeof(int));
+  r->srcBegin = (int*)calloc(threads, sizeof(int));
+  r->srcEnd = (int*)calloc(threads, sizeof(int));
+  int* rowLow = (int*)malloc(depth_height * sizeof(int));
+  int* rowHigh = (int*)malloc(depth_height * sizeof(int));
+  if(!r->mapU || !r->mapV || !r->mapZ || !r->destBegin || !r->srcBegin || !r->srcEnd || !rowLow || !rowHigh){
+    free(rowLow);
+    free(rowHigh);
+    destroyDepthRegistration(r);
+    return NULL;
+  }
+
+  // 광선 (깊이 카메라) 을 회전하고 색상 내부 파라미터를 미리 곱해 둠
+  for(int v = 0; v < depth_height; ++v){
+    for(int u = 0; u < depth_width; ++u){
+      const size_t i = (size_t)v * depth_width + u;
+      const float rx = (u - Kd.cx) / Kd.fx, ry = (v - Kd.cy) / Kd.fy;
+      const float ax = R[0] * rx + R[1] * ry + R[2];
+      const float ay = R[3] * rx + R[4] * ry + R[5];
+      const float az = R[6] * rx + R[7] * ry + R[8];
+      r->mapU[i] = Kc.fx * ax + Kc.cx * az;
+      r->mapV[i] = Kc.fy * ay + Kc.cy * az;
+      r->mapZ[i] = az;
+    }
+  }
+
+  for(int v = 0; v < depth_height; ++v){
+    projectRowRange(r, v, &rowLow[v], &rowHigh[v]);
+  }
+  for(int b = 0; b <= threads; ++b){
+    r->destBegin[b] = (int)((int64_t)color_height * b / threads);
+  }
+  for(int b = 0; b < threads; ++b){
+    int first = depth_height, last = -1;
+    for(int v = 0; v < depth_height; ++v){
+      if(rowHigh[v] >= r->destBegin[b] && rowLow[v] < r->destBegin[b + 1]){
+        if(v < first) first = v;
+        last = v;
+      }
+    }
+    r->srcBegin[b] = first;
+    r->srcEnd[b] = last + 1 > first ? last + 1 : first;
+  }
+  free(rowLow);
+  free(rowHigh);
+
+  if(threads > 1){
+    r->workers = (RegistrationWorker*)calloc(threads - 1, sizeof(RegistrationWorker));
+    if(!r->workers){
+      destroyDepthRegistration(r);
+      return NULL;
+    }
+    for(int w = 0; w < threads - 1; ++w){
+      RegistrationWorker* worker = &r->workers[w];
+      worker->registration = r;
+      worker->band = w + 1;
+      if(pthread_create(&worker->thread, NULL, registrationWorkerLoop, worker) != 0){
+        perror("Failed to create registration worker");
+        destroyDepthRegistration(r);
+        return NULL;
+      }
+      r->workerCount++;
+    }
+  }
+  return r;
+}
+
+void destroyDepthRegistration(DepthRegistration* registration){
+  if(!registration) return;
+  DepthRegistration* r = registration;
+  if(r->workerCount > 0){
+    pthread_mutex_lock(&r->mutex);
+    r->stop = 1;
+    pthread_cond_broadcast(&r->startCond);
+    pthread_mutex_unlock(&r->mutex);
+    for(int w = 0; w < r->workerCount; ++w){
+      pthread_join(r->workers[w].thread, NULL);
+    }
+  }
+  pthread_mutex_destroy(&r->mutex);
+  pthread_cond_destroy(&r->startCond);
+  pthread_cond_destroy(&r->doneCond);
+  free(r->workers);
+  free(r->mapU);
+  free(r->mapV);
+  free(r->mapZ);
+  free(r->destBegin);
+  free(r->srcBegin);
+  free(r->srcEnd);
+  free(r);
+}
+
+void registerDepthToColor(DepthRegistration* registration, const uint16_t* depth, uint16_t* out){
+  DepthRegistration* r = registration;
+  if(r->workerCount == 0){
+    for(int b = 0; b < r->bands; ++b){
+      registerBand(r, depth, out, b, 1);
+    }
+    return;
+  }
+
+  pthread_mutex_lock(&r->mutex);
+  r->jobDepth = depth;
+  r->jobOut = out;
+  r->pending = r->workerCount;
+  r->generation++;
+  pthread_cond_broadcast(&r->startCond);
+  pthread_mutex_unlock(&r->mutex);
+
+  registerBand(r, depth, out, 0, 1);
+
+  pthread_mutex_lock(&r->mutex);
+  while(r->pending > 0){
+    pthread_cond_wait(&r->doneCond, &r->mutex);
+  }
+  pthread_mutex_unlock(&r->mutex);
+}
+
+void registerDepthToColorScalar(DepthRegistration* registration, const uint16_t* depth, uint16_t* out){
+  for(int b = 0; b < registration->bands; ++b){
+    registerBand(registration, depth, out, b, 0);
+  }
+}
@@ -0,0 +1,34 @@
+#ifndef DEPTH_REGISTRATION_H
+#define DEPTH_REGISTRATION_H
+
+#include "kernelModule.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 깊이 -> 색상 정합 (깊이 영상을 색상 카메라 시점으로 다시 투영)
+// 픽셀별 투영 계수를 미리 계산해 두고, 프레임마다 4 픽셀씩 SIMD 로 투영한 뒤 가까운 깊이만 남김 (z-buffer)
+// 결과 영상을 행 구간으로 나눠 상주 작업 스레드가 한 구간씩 맡으므로 쓰기 충돌이 없고 스레드 수와 관계없이 결과가 같음
+typedef struct DepthRegistration DepthRegistration;
+
+// depth_*: 입력 깊이 해상도, color_*: 결과 해상도 (보정 해상도와 다르면 내부 파라미터를 스케일 조정)
+// min_depth, max_depth: 정합할 깊이 범위 (m), threads: 작업 스레드 수 (호출 스레드 포함, 1 이면 호출 스레드만)
+// 반환값: 실패 시 NULL
+DepthRegistration* createDepthRegistration(const DepthColorCalibration* calibration, int depth_width,
+                                           int depth_height, int color_width, int color_height, float min_depth,
+                                           float max_depth, int threads);
+void destroyDepthRegistration(DepthRegistration* registration);
+
+// depth (depth_width * depth_height) -> out (color_width * color_height, 투영되지 않은 픽셀은 0)
+void registerDepthToColor(DepthRegistration* registration, const uint16_t* depth, uint16_t* out);
+
+// 스칼라 기준 구현 (검증 및 벤치마크용, 호출 스레드만 사용)
+void registerDepthToColorScalar(DepthRegistration* registration, const uint16_t* depth, uint16_t* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DEPTH_REGISTRATION_H
@@ -0,0 +1,237 @@
+#include "frameDecimation.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+int decimationLevel(int factor){
+  for(int level = 0; level < FRAME_PYRAMID_LEVELS; ++level){
+    if(factor == 1 << level) return level;
+  }
+  return -1;
+}
+
+int clampFrameRoi(const FrameRoi* roi, int width, int height, FrameRoi* out){
+  FrameRoi r = {0, 0, width, height};
+  if(roi && roi->width > 0 && roi->height > 0){
+    int x0 = roi->x < 0 ? 0 : roi->x, y0 = roi->y < 0 ? 0 : roi->y;
+    int x1 = roi->x + roi->width, y1 = roi->y + roi->height;
+    if(x1 > width) x1 = width;
+    if(y1 > height) y1 = height;
+    r.x = x0;
+    r.y = y0;
+    r.width = (x1 - x0) & ~1;
+    r.height = (y1 - y0) & ~1;
+  }
+  *out = r;
+  return r.width > 0 && r.height > 0;
+}
+
+void cropCameraIntrinsics(const CameraIntrinsics* src, int width, int height, const FrameRoi* roi, int factor,
+                          CameraIntrinsics* dst){
+  CameraIntrinsics K;
+  scaleCameraIntrinsics(src, width, height, &K);
+  FrameRoi r;
+  if(clampFrameRoi(roi, width, height, &r)){
+    K.cx -= r.x;
+    K.cy -= r.y;
+    K.width = r.width;
+    K.height = r.height;
+  }
+  if(factor < 1) factor = 1;
+  // 2x2 블록 평균이므로 픽셀 중심 기준 스케일 조정과 같음
+  scaleCameraIntrinsics(&K, K.width / factor, K.height / factor, dst);
+}
+
+void initFramePyramid(FramePyramid* pyramid){
+  memset(pyramid, 0, sizeof(FramePyramid));
+}
+
+void freeFramePyramid(FramePyramid* pyramid){
+  for(int i = 0; i < FRAME_PYRAMID_LEVELS; ++i){
+    free(pyramid->depthBuffer[i]);
+    free(pyramid->colorBuffer[i]);
+  }
+  initFramePyramid(pyramid);
+}
+
+static int reserveLevel(FramePyramid* pyramid, int level, size_t pixels){
+  if(pyramid->capacity[level] >= pixels){
+    return 1;
+  }
+  uint16_t* depth = (uint16_t*)realloc(pyramid->depthBuffer[level], pixels * sizeof(uint16_t));
+  if(depth) pyramid->depthBuffer[level] = depth;
+  uint8_t* color = (uint8_t*)realloc(pyramid->colorBuffer[level], pixels * 3);
+  if(color) pyramid->colorBuffer[level] = color;
+  if(!depth || !color){
+    return 0;
+  }
+  pyramid->capacity[level] = pixels;
+  return 1;
+}
+
+int buildFramePyramid(FramePyramid* pyramid, const uint16_t* depth, const uint8_t* color, int width, int height,
+                      const FrameRoi* roi, int levels){
+  pyramid->levels = 0;
+  FrameRoi r;
+  if(!clampFrameRoi(roi, width, height, &r)){
+    return 0;
+  }
+  if(levels < 1) levels = 1;
+  if(levels > FRAME_PYRAMID_LEVELS) levels = FRAME_PYRAMID_LEVELS;
+
+  // 0 단계: 전체 영상이면 입력을 그대로, 관심 영역이면 행 단위 복사
+  FrameLevel* base = &pyramid->level[0];
+  base->width = r.width;
+  base->height = r.height;
+  if(r.width == width && r.height == height){
+    base->depth = depth;
+    base->color = color;
+  }else{
+    if(!reserveLevel(pyramid, 0, (size_t)r.width * r.height)){
+      return 0;
+    }
+    for(int y = 0; y < r.height; ++y){
+      size_t src = (size_t)(r.y + y) * width + r.x;
+      size_t dst = (size_t)y * r.width;
+      memcpy(pyramid->depthBuffer[0] + dst, depth + src, (size_t)r.width * sizeof(uint16_t));
+      memcpy(pyramid->colorBuffer[0] + dst * 3, color + src * 3, (size_t)r.width * 3);
+    }
+    base->depth = pyramid->depthBuffer[0];
+    base->color = pyramid->colorBuffer[0];
+  }
+  pyramid->levels = 1;
+
+  // 1 단계부터: 바로 위 단계를 2x2 로 줄임 (같은 프레임에서 한 번만)
+  for(int level = 1; level < levels; ++level){
+    const FrameLevel* prev = &pyramid->level[level - 1];
+    int w = prev->width / 2, h = prev->height / 2;
+    if(w < 1 || h < 1 || !reserveLevel(pyramid, level, (size_t)w * h)){
+      break;
+    }
+    halveDepth(prev->depth, prev->width, prev->width, prev->height, pyramid->depthBuffer[level]);
+    halveColor(prev->color, prev->width, prev->width, prev->height, pyramid->colorBuffer[level]);
+    FrameLevel* next = &pyramid->level[level];
+    next->width = w;
+    next->height = h;
+    next->depth = pyramid->depthBuffer[level];
+    next->color = pyramid->colorBuffer[level];
+    pyramid->levels = level + 1;
+  }
+  return 1;
+}
+
+const FrameLevel* framePyramidLevel(const FramePyramid* pyramid, int factor){
+  int level = decimationLevel(factor);
+  if(level < 0) level = 0;
+  if(level >= pyramid->levels) level = pyramid->levels - 1;
+  return &pyramid->level[level < 0 ? 0 : level];
+}
+
+// 0 (무효) 을 가장 큰 값으로 보고 최소값을 고른 뒤 되돌림 (유효한 깊이가 없으면 0)
+static inline uint16_t nearestDepth(uint16_t a, uint16_t b, uint16_t c, uint16_t d){
+  uint16_t m = (uint16_t)(a - 1), v;
+  v = (uint16_t)(b - 1); if(v < m) m = v;
+  v = (uint16_t)(c - 1); if(v < m) m = v;
+  v = (uint16_t)(d - 1); if(v < m) m = v;
+  return (uint16_t)(m + 1);
+}
+
+static void halveDepthRow(const uint16_t* r0, const uint16_t* r1, int x, int out_width, uint16_t* out){
+  for(; x < out_width; ++x){
+    out[x] = nearestDepth(r0[2 * x], r0[2 * x + 1], r1[2 * x], r1[2 * x + 1]);
+  }
+}
+
+void halveDepthScalar(const uint16_t* src, int src_stride, int width, int height, uint16_t* dst){
+  const int ow = width / 2, oh = height / 2;
+  for(int y = 0; y < oh; ++y){
+    const uint16_t* r0 = src + (size_t)(2 * y) * src_stride;
+    halveDepthRow(r0, r0 + src_stride, 0, ow, dst + (size_t)y * ow);
+  }
+}
+
+void halveDepth(const uint16_t* src, int src_stride, int width, int height, uint16_t* dst){
+#if defined(__SSE2__)
+  const int ow = width / 2, oh = height / 2;
+  const __m128i one = _mm_set1_epi16(1);
+  const __m128i bias = _mm_set1_epi16((short)0x8000);
+  for(int y = 0; y < oh; ++y){
+    const uint16_t* r0 = src + (size_t)(2 * y) * src_stride;
+    const uint16_t* r1 = r0 + src_stride;
+    uint16_t* out = dst + (size_t)y * ow;
+    int x = 0;
+
+    // 출력 8 픽셀씩: (값 - 1) ^ 0x8000 으로 부호 있는 최소값 비교, 세로 -> 가로 짝 순서
+    for(; x + 8 <= ow; x += 8){
+      __m128i a0 = _mm_xor_si128(_mm_sub_epi16(_mm_loadu_si128((const __m128i*)(r0 + 2 * x)), one), bias);
+      __m128i a1 = _mm_xor_si128(_mm_sub_epi16(_mm_loadu_si128((const __m128i*)(r0 + 2 * x + 8)), one), bias);
+      __m128i b0 = _mm_xor_si128(_mm_sub_epi16(_mm_loadu_si128((const __m128i*)(r1 + 2 * x)), one), bias);
+      __m128i b1 = _mm_xor_si128(_mm_sub_epi16(_mm_loadu_si128((const __m128i*)(r1 + 2 * x + 8)), one), bias);
+      __m128i m0 = _mm_min_epi16(a0, b0), m1 = _mm_min_epi16(a1, b1);
+
+      // 32비트 칸의 짝 / 홀 16비트를 부호 확장해 비교 (결과도 부호 확장된 값이라 packs 가 그대로 모음)
+      __m128i h0 = _mm_min_epi16(_mm_srai_epi32(_mm_slli_epi32(m0, 16), 16), _mm_srai_epi32(m0, 16));
+      __m128i h1 = _mm_min_epi16(_mm_srai_epi32(_mm_slli_epi32(m1, 16), 16), _mm_srai_epi32(m1, 16));
+      __m128i result = _mm_add_epi16(_mm_xor_si128(_mm_packs_epi32(h0, h1), bias), one);
+      _mm_storeu_si128((__m128i*)(out + x), result);
+    }
+    halveDepthRow(r0, r1, x, ow, out);
+  }
+#else
+  halveDepthScalar(src, src_stride, width, height, dst);
+#endif
+}
+
+// 세로 평균 후 가로 평균 (둘 다 올림 반올림, _mm_avg_epu8 과 같은 결과)
+static void halveColorRow(const uint8_t* r0, const uint8_t* r1, int x, int out_width, uint8_t* out){
+  for(; x < out_width; ++x){
+    for(int c = 0; c < 3; ++c){
+      const int i = 6 * x + c;
+      const int left = (r0[i] + r1[i] + 1) >> 1, right = (r0[i + 3] + r1[i + 3] + 1) >> 1;
+      out[3 * x + c] = (uint8_t)((left + right + 1) >> 1);
+    }
+  }
+}
+
+void halveColorScalar(const uint8_t* src, int src_stride, int width, int height, uint8_t* dst){
+  const int ow = width / 2, oh = height / 2;
+  for(int y = 0; y < oh; ++y){
+    const uint8_t* r0 = src + (size_t)(2 * y) * src_stride * 3;
+    halveColorRow(r0, r0 + (size_t)src_stride * 3, 0, ow, dst + (size_t)y * ow * 3);
+  }
+}
+
+void halveColor(const uint8_t* src, int src_stride, int width, int height, uint8_t* dst){
+#if defined(__SSE2__)
+  const int ow = width / 2, oh = height / 2;
+  uint8_t rows[96] __attribute__((aligned(16)));
+  for(int y = 0; y < oh; ++y){
+    const uint8_t* r0 = src + (size_t)(2 * y) * src_stride * 3;
+    const uint8_t* r1 = r0 + (size_t)src_stride * 3;
+    uint8_t* out = dst + (size_t)y * ow * 3;
+    int x = 0;
+
+    // 입력 32 픽셀 (96바이트) 씩 세로 평균은 SIMD, 3바이트 픽셀 짝의 가로 평균은 스칼라
+    for(; x + 16 <= ow; x += 16){
+      const uint8_t* p0 = r0 + 6 * x;
+      const uint8_t* p1 = r1 + 6 * x;
+      for(int k = 0; k < 96; k += 16){
+        __m128i v = _mm_avg_epu8(_mm_loadu_si128((const __m128i*)(p0 + k)), _mm_loadu_si128((const __m128i*)(p1 + k)));
+        _mm_store_si128((__m128i*)(rows + k), v);
+      }
+      uint8_t* o = out + 3 * x;
+      for(int i = 0; i < 16; ++i){
+        o[3 * i + 0] = (uint8_t)((rows[6 * i + 0] + rows[6 * i + 3] + 1) >> 1);
+        o[3 * i + 1] = (uint8_t)((rows[6 * i + 1] + rows[6 * i + 4] + 1) >> 1);
+        o[3 * i + 2] = (uint8_t)((rows[6 * i + 2] + rows[6 * i + 5] + 1) >> 1);
+      }
+    }
+    halveColorRow(r0, r1, x, ow, out);
+  }
+#else
+  halveColorScalar(src, src_stride, width, height, dst);
+#endif
+}
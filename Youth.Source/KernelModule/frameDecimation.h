@@ -0,0 +1,71 @@
+#ifndef FRAME_DECIMATION_H
+#define FRAME_DECIMATION_H
+
+#include "kernelModule.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 1, 1/2, 1/4, 1/8 해상도
+#define FRAME_PYRAMID_LEVELS 4
+
+// 관심 영역 (width 또는 height 가 0 이면 전체 영상)
+typedef struct{
+  int x, y, width, height;
+} FrameRoi;
+
+// 해상도 단계 하나 (깊이 / 색상은 빈틈없이 이어진 width * height 영상)
+typedef struct{
+  int width, height;
+  const uint16_t* depth;
+  const uint8_t* color;
+} FrameLevel;
+
+// 영상 피라미드 (프레임마다 필요한 단계까지만 한 번 계산해 여러 소비자가 같이 읽음)
+// 0 단계는 관심 영역이 없으면 입력 영상을 그대로 가리키고, 1 단계부터는 바로 위 단계를 2x2 로 줄임
+typedef struct{
+  FrameLevel level[FRAME_PYRAMID_LEVELS];
+  int levels;            // 계산된 단계 수
+  uint16_t* depthBuffer[FRAME_PYRAMID_LEVELS];
+  uint8_t* colorBuffer[FRAME_PYRAMID_LEVELS];
+  size_t capacity[FRAME_PYRAMID_LEVELS];
+} FramePyramid;
+
+// 줄임 배율 (1, 2, 4, 8) -> 피라미드 단계, 지원하지 않는 배율이면 -1
+int decimationLevel(int factor);
+
+// 관심 영역을 영상 안으로 자르고 짝수 크기로 맞춤 (줄임 단계에서 버리는 픽셀이 없도록)
+// 반환값: 유효한 영역이면 1, 비어 있으면 0 (roi 가 NULL 이거나 크기가 0 이면 전체 영상)
+int clampFrameRoi(const FrameRoi* roi, int width, int height, FrameRoi* out);
+
+// 관심 영역 + 줄임 후의 내부 파라미터 (src 는 입력 해상도로 스케일 조정 후 영역 원점만큼 주점 이동)
+void cropCameraIntrinsics(const CameraIntrinsics* src, int width, int height, const FrameRoi* roi, int factor,
+                          CameraIntrinsics* dst);
+
+void initFramePyramid(FramePyramid* pyramid);
+void freeFramePyramid(FramePyramid* pyramid);
+
+// levels 단계까지 계산 (영상이 너무 작으면 그 전에 멈춤), 입력 포인터는 다음 호출 전까지 유효해야 함
+// 반환값: 성공 시 1, 메모리 할당 실패 시 0
+int buildFramePyramid(FramePyramid* pyramid, const uint16_t* depth, const uint8_t* color, int width, int height,
+                      const FrameRoi* roi, int levels);
+
+// factor 배율 단계 (계산되지 않았으면 가장 작은 단계)
+const FrameLevel* framePyramidLevel(const FramePyramid* pyramid, int factor);
+
+// 2x2 줄임 (src_stride: 입력 한 행의 픽셀 수), 결과는 (width / 2) x (height / 2)
+// 깊이는 블록 안의 가장 가까운 유효 깊이 (평균하면 경계에 없는 깊이가 생김), 색상은 세로 / 가로 순서의 반올림 평균
+void halveDepth(const uint16_t* src, int src_stride, int width, int height, uint16_t* dst);
+void halveColor(const uint8_t* src, int src_stride, int width, int height, uint8_t* dst);
+
+// 스칼라 기준 구현 (검증 및 벤치마크용)
+void halveDepthScalar(const uint16_t* src, int src_stride, int width, int height, uint16_t* dst);
+void halveColorScalar(const uint8_t* src, int src_stride, int width, int height, uint8_t* dst);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FRAME_DECIMATION_H
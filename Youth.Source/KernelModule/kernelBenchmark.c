@@ -0,0 +1,112 @@
+// 역투영 커널 벤치마크
+// 사용법: KernelBenchmark [camera.yaml] [width] [height] [iterations]
+// 합성 깊이 영상 (약 20% 무효 픽셀) 으로 스칼라 / SIMD, 압축 / 비압축 처리량 (points/s) 측정
+
+#include "kernelModule.h"
+#include "benchmarkUtil.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef size_t (*UnprojectFunc)(const RayTable*, const uint16_t*, const uint8_t*, float, float, int, int, int,
+                                PointBuffer*);
+
+static void runBenchmark(const char* name, UnprojectFunc func, const RayTable* table, const uint16_t* depth,
+                         const uint8_t* rgb, int flags, int iterations, PointBuffer* out){
+  // 워밍업
+  out->count = 0;
+  func(table, depth, rgb, 0.2f, 8.0f, 0, table->height, flags, out);
+
+  double start = benchmarkNow();
+  size_t points = 0;
+  for(int i = 0; i < iterations; ++i){
+    out->count = 0;
+    points += func(table, depth, rgb, 0.2f, 8.0f, 0, table->height, flags, out);
+  }
+  double elapsed = benchmarkNow() - start;
+
+  double pixels = (double)table->width * table->height * iterations;
+  printf("%-24s %8.3f ms/frame  %8.1f Mpixels/s  %8.1f Mpoints/s\n", name, elapsed * 1000.0 / iterations,
+         pixels / elapsed / 1e6, points / elapsed / 1e6);
+}
+
+// SIMD 결과가 스칼라 기준 구현과 같은지 확인
+static int verify(const RayTable* table, const uint16_t* depth, const uint8_t* rgb, int flags, PointBuffer* a,
+                  PointBuffer* b){
+  a->count = b->count = 0;
+  unprojectDepthRowsScalar(table, depth, rgb, 0.2f, 8.0f, 0, table->height, flags, a);
+  unprojectDepthRows(table, depth, rgb, 0.2f, 8.0f, 0, table->height, flags, b);
+  if(a->count != b->count){
+    fprintf(stderr, "Point count mismatch: %zu vs %zu\n", a->count, b->count);
+    return 0;
+  }
+  for(size_t i = 0; i < a->count; ++i){
+    if(fabsf(a->x[i] - b->x[i]) > 1e-5f || fabsf(a->y[i] - b->y[i]) > 1e-5f || a->z[i] != b->z[i] ||
+       a->pixel[i] != b->pixel[i] || a->r[i] != b->r[i] || a->g[i] != b->g[i] || a->b[i] != b->b[i]){
+      fprintf(stderr, "Point %zu mismatch\n", i);
+      return 0;
+    }
+  }
+  return 1;
+}
+
+int main(int argc, char** argv){
+  int width = argc > 2 ? atoi(argv[2]) : 640;
+  int height = argc > 3 ? atoi(argv[3]) : 480;
+  int iterations = argc > 4 ? atoi(argv[4]) : 200;
+
+  CameraIntrinsics K;
+  setDefaultCameraIntrinsics(&K, width, height);
+  if(argc > 1 && !loadCameraIntrinsics(argv[1], &K)){
+    fprintf(stderr, "Using default intrinsics\n");
+  }
+  printf("Intrinsics: fx %.2f fy %.2f cx %.2f cy %.2f depthFactor %.1f (%dx%d), frame %dx%d\n", K.fx, K.fy, K.cx,
+         K.cy, K.depthFactor, K.width, K.height, width, height);
+
+  RayTable table;
+  if(!createRayTable(&table, &K, width, height)){
+    fprintf(stderr, "Failed to create ray table\n");
+    return 1;
+  }
+
+  size_t pixels = (size_t)width * height;
+  uint16_t* depth = (uint16_t*)malloc(pixels * sizeof(uint16_t));
+  uint8_t* rgb = (uint8_t*)malloc(pixels * 3);
+  srand(1);
+  for(size_t i = 0; i < pixels; ++i){
+    // 무효 픽셀은 덩어리로 생기도록 (실제 센서와 비슷하게)
+    int invalid = ((i / 16) * 2654435761u >> 16) % 5 == 0;
+    depth[i] = invalid ? 0 : (uint16_t)(500 + rand() % 4000);
+    rgb[i * 3] = (uint8_t)rand();
+    rgb[i * 3 + 1] = (uint8_t)rand();
+    rgb[i * 3 + 2] = (uint8_t)rand();
+  }
+
+  PointBuffer reference, out;
+  if(!allocPointBuffer(&reference, pixels) || !allocPointBuffer(&out, pixels)){
+    fprintf(stderr, "Failed to allocate point buffers\n");
+    return 1;
+  }
+
+  if(!verify(&table, depth, rgb, 0, &reference, &out) ||
+     !verify(&table, depth, rgb, KERNEL_UNPROJECT_COMPACT, &reference, &out)){
+    return 1;
+  }
+  printf("SIMD output matches scalar reference\n");
+
+  runBenchmark("scalar", unprojectDepthRowsScalar, &table, depth, rgb, 0, iterations, &out);
+  runBenchmark("scalar compact", unprojectDepthRowsScalar, &table, depth, rgb, KERNEL_UNPROJECT_COMPACT, iterations,
+               &out);
+  runBenchmark("simd", unprojectDepthRows, &table, depth, rgb, 0, iterations, &out);
+  runBenchmark("simd compact", unprojectDepthRows, &table, depth, rgb, KERNEL_UNPROJECT_COMPACT, iterations, &out);
+  runBenchmark("simd compact (no color)", unprojectDepthRows, &table, depth, rgb,
+               KERNEL_UNPROJECT_COMPACT | KERNEL_UNPROJECT_NO_COLOR, iterations, &out);
+
+  freePointBuffer(&reference);
+  freePointBuffer(&out);
+  destroyRayTable(&table);
+  free(depth);
+  free(rgb);
+  return 0;
+}
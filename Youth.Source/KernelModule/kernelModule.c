@@ -0,0 +1,408 @@
+#include "kernelModule.h"
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Astra 기본 초점 거리 (640x480 기준)
+#define ASTRA_DEFAULT_FOCAL 570.3f
+
+void setDefaultCameraIntrinsics(CameraIntrinsics* intrinsics, int width, int height){
+  float scale = width / 640.0f;
+  intrinsics->fx = ASTRA_DEFAULT_FOCAL * scale;
+  intrinsics->fy = ASTRA_DEFAULT_FOCAL * scale;
+  intrinsics->cx = width / 2;
+  intrinsics->cy = height / 2;
+  intrinsics->depthFactor = 1000.0f; // mm
+  intrinsics->width = width;
+  intrinsics->height = height;
+}
+
+// "키: 값" 한 줄 파싱 (Camera.xx 와 Camera1.xx 형식 모두 허용)
+static int matchYamlKey(const char* line, const char* key, float* value){
+  const char* prefixes[] = {"Camera.", "Camera1.", ""};
+  for(size_t i = 0; i < sizeof(prefixes) / sizeof(prefixes[0]); ++i){
+    size_t prefixLength = strlen(prefixes[i]);
+    size_t keyLength = strlen(key);
+    if(strncmp(line, prefixes[i], prefixLength) != 0) continue;
+    if(strncmp(line + prefixLength, key, keyLength) != 0) continue;
+
+    const char* p = line + prefixLength + keyLength;
+    while(*p == ' ' || *p == '\t') p++;
+    if(*p != ':') continue;
+
+    char* end;
+    float parsed = strtof(p + 1, &end);
+    if(end == p + 1) return 0;
+    *value = parsed;
+    return 1;
+  }
+  return 0;
+}
+
+int loadCameraIntrinsics(const char* yaml_file, CameraIntrinsics* intrinsics){
+  FILE* file = fopen(yaml_file, "r");
+  if(!file){
+    perror("Failed to open camera config");
+    return 0;
+  }
+
+  char line[512];
+  int found = 0;
+  while(fgets(line, sizeof(line), file)){
+    char* p = line;
+    while(isspace((unsigned char)*p)) p++;
+    if(*p == '#' || *p == '\0') continue;
+
+    float value;
+    if(matchYamlKey(p, "fx", &value)){ intrinsics->fx = value; found++; }
+    else if(matchYamlKey(p, "fy", &value)){ intrinsics->fy = value; found++; }
+    else if(matchYamlKey(p, "cx", &value)){ intrinsics->cx = value; found++; }
+    else if(matchYamlKey(p, "cy", &value)){ intrinsics->cy = value; found++; }
+    else if(matchYamlKey(p, "width", &value)){ intrinsics->width = (int)value; }
+    else if(matchYamlKey(p, "height", &value)){ intrinsics->height = (int)value; }
+    else if(matchYamlKey(p, "DepthMapFactor", &value)){ intrinsics->depthFactor = value; }
+  }
+  fclose(file);
+
+  if(found < 4){
+    fprintf(stderr, "Camera config %s is missing fx/fy/cx/cy\n", yaml_file);
+    return 0;
+  }
+  return 1;
+}
+
+void setDefaultDepthColorCalibration(DepthColorCalibration* calibration, int width, int height){
+  memset(calibration, 0, sizeof(DepthColorCalibration));
+  setDefaultCameraIntrinsics(&calibration->depth, width, height);
+  setDefaultCameraIntrinsics(&calibration->color, width, height);
+  calibration->rotation[0] = calibration->rotation[4] = calibration->rotation[8] = 1.0f;
+}
+
+// 회전 벡터 -> 회전 행렬 (Rodrigues)
+static void rotationFromVector(const float r[3], float R[9]){
+  double theta = sqrt((double)r[0] * r[0] + (double)r[1] * r[1] + (double)r[2] * r[2]);
+  double c = cos(theta), s = sin(theta), k = 1.0 - c;
+  double x = 0.0, y = 0.0, z = 0.0;
+  if(theta > 1e-12){
+    x = r[0] / theta;
+    y = r[1] / theta;
+    z = r[2] / theta;
+  }
+  R[0] = (float)(c + x * x * k);     R[1] = (float)(x * y * k - z * s); R[2] = (float)(x * z * k + y * s);
+  R[3] = (float)(y * x * k + z * s); R[4] = (float)(c + y * y * k);     R[5] = (float)(y * z * k - x * s);
+  R[6] = (float)(z * x * k - y * s); R[7] = (float)(z * y * k + x * s); R[8] = (float)(c + z * z * k);
+}
+
+int loadDepthColorCalibration(const char* yaml_file, DepthColorCalibration* calibration){
+  if(!loadCameraIntrinsics(yaml_file, &calibration->color)){
+    return 0;
+  }
+  FILE* file = fopen(yaml_file, "r");
+  if(!file){
+    return 0;
+  }
+
+  // 깊이 카메라 항목이 없으면 색상 카메라와 같다고 봄 (외부 파라미터만 보정)
+  CameraIntrinsics depth = calibration->color;
+  LensDistortion* color = &calibration->colorDistortion;
+  LensDistortion depthDistortion = {0};
+  int depthDistortionFound = 0;
+  float rvec[3] = {0.0f, 0.0f, 0.0f};
+  char line[512];
+  while(fgets(line, sizeof(line), file)){
+    char* p = line;
+    while(isspace((unsigned char)*p)) p++;
+    if(*p == '#' || *p == '\0') continue;
+
+    float value;
+    if(matchYamlKey(p, "Depth.fx", &value)) depth.fx = value;
+    else if(matchYamlKey(p, "Depth.fy", &value)) depth.fy = value;
+    else if(matchYamlKey(p, "Depth.cx", &value)) depth.cx = value;
+    else if(matchYamlKey(p, "Depth.cy", &value)) depth.cy = value;
+    else if(matchYamlKey(p, "Depth.width", &value)) depth.width = (int)value;
+    else if(matchYamlKey(p, "Depth.height", &value)) depth.height = (int)value;
+    else if(matchYamlKey(p, "k1", &value)) color->k1 = value;
+    else if(matchYamlKey(p, "k2", &value)) color->k2 = value;
+    else if(matchYamlKey(p, "p1", &value)) color->p1 = value;
+    else if(matchYamlKey(p, "p2", &value)) color->p2 = value;
+    else if(matchYamlKey(p, "k3", &value)) color->k3 = value;
+    else if(matchYamlKey(p, "Depth.k1", &value)){ depthDistortion.k1 = value; depthDistortionFound |= 1; }
+    else if(matchYamlKey(p, "Depth.k2", &value)){ depthDistortion.k2 = value; depthDistortionFound |= 2; }
+    else if(matchYamlKey(p, "Depth.p1", &value)){ depthDistortion.p1 = value; depthDistortionFound |= 4; }
+    else if(matchYamlKey(p, "Depth.p2", &value)){ depthDistortion.p2 = value; depthDistortionFound |= 8; }
+    else if(matchYamlKey(p, "Depth.k3", &value)){ depthDistortion.k3 = value; depthDistortionFound |= 16; }
+    else if(matchYamlKey(p, "DepthToColor.rx", &value)) rvec[0] = value;
+    else if(matchYamlKey(p, "DepthToColor.ry", &value)) rvec[1] = value;
+    else if(matchYamlKey(p, "DepthToColor.rz", &value)) rvec[2] = value;
+    else if(matchYamlKey(p, "DepthToColor.tx", &value)) calibration->translation[0] = value;
+    else if(matchYamlKey(p, "DepthToColor.ty", &value)) calibration->translation[1] = value;
+    else if(matchYamlKey(p, "DepthToColor.tz", &value)) calibration->translation[2] = value;
+  }
+  fclose(file);
+
+  calibration->depth = depth;
+  calibration->depthDistortion = *color;
+  if(depthDistortionFound & 1) calibration->depthDistortion.k1 = depthDistortion.k1;
+  if(depthDistortionFound & 2) calibration->depthDistortion.k2 = depthDistortion.k2;
+  if(depthDistortionFound & 4) calibration->depthDistortion.p1 = depthDistortion.p1;
+  if(depthDistortionFound & 8) calibration->depthDistortion.p2 = depthDistortion.p2;
+  if(depthDistortionFound & 16) calibration->depthDistortion.k3 = depthDistortion.k3;
+  rotationFromVector(rvec, calibration->rotation);
+  return 1;
+}
+
+void scaleCameraIntrinsics(const CameraIntrinsics* src, int width, int height, CameraIntrinsics* dst){
+  CameraIntrinsics scaled = *src;
+  if(src->width > 0 && src->height > 0 && (src->width != width || src->height != height)){
+    float sx = (float)width / src->width;
+    float sy = (float)height / src->height;
+    scaled.fx = src->fx * sx;
+    scaled.fy = src->fy * sy;
+    scaled.cx = (src->cx + 0.5f) * sx - 0.5f;
+    scaled.cy = (src->cy + 0.5f) * sy - 0.5f;
+  }
+  scaled.width = width;
+  scaled.height = height;
+  *dst = scaled;
+}
+
+void* alignedAlloc(size_t bytes){
+  void* ptr = NULL;
+  if(posix_memalign(&ptr, 16, bytes > 0 ? bytes : 16) != 0){
+    return NULL;
+  }
+  return ptr;
+}
+
+int createRayTable(RayTable* table, const CameraIntrinsics* intrinsics, int width, int height){
+  memset(table, 0, sizeof(RayTable));
+  if(width <= 0 || height <= 0 || intrinsics->fx <= 0.0f || intrinsics->fy <= 0.0f){
+    return 0;
+  }
+
+  CameraIntrinsics K;
+  scaleCameraIntrinsics(intrinsics, width, height, &K);
+
+  size_t pixels = (size_t)width * height;
+  table->rayX = (float*)alignedAlloc(pixels * sizeof(float));
+  table->rayY = (float*)alignedAlloc(pixels * sizeof(float));
+  if(!table->rayX || !table->rayY){
+    destroyRayTable(table);
+    return 0;
+  }
+
+  const float invFx = 1.0f / K.fx, invFy = 1.0f / K.fy;
+  for(int v = 0; v < height; ++v){
+    float ry = (v - K.cy) * invFy;
+    for(int u = 0; u < width; ++u){
+      table->rayX[(size_t)v * width + u] = (u - K.cx) * invFx;
+      table->rayY[(size_t)v * width + u] = ry;
+    }
+  }
+
+  table->width = width;
+  table->height = height;
+  table->depthScale = K.depthFactor > 0.0f ? 1.0f / K.depthFactor : 0.001f;
+  return 1;
+}
+
+void destroyRayTable(RayTable* table){
+  free(table->rayX);
+  free(table->rayY);
+  memset(table, 0, sizeof(RayTable));
+}
+
+int allocPointBuffer(PointBuffer* buffer, size_t capacity){
+  memset(buffer, 0, sizeof(PointBuffer));
+  buffer->x = (float*)alignedAlloc(capacity * sizeof(float));
+  buffer->y = (float*)alignedAlloc(capacity * sizeof(float));
+  buffer->z = (float*)alignedAlloc(capacity * sizeof(float));
+  buffer->r = (uint8_t*)alignedAlloc(capacity);
+  buffer->g = (uint8_t*)alignedAlloc(capacity);
+  buffer->b = (uint8_t*)alignedAlloc(capacity);
+  buffer->pixel = (uint32_t*)alignedAlloc(capacity * sizeof(uint32_t));
+  if(!buffer->x || !buffer->y || !buffer->z || !buffer->r || !buffer->g || !buffer->b || !buffer->pixel){
+    freePointBuffer(buffer);
+    return 0;
+  }
+  buffer->capacity = capacity;
+  return 1;
+}
+
+void freePointBuffer(PointBuffer* buffer){
+  free(buffer->x);
+  free(buffer->y);
+  free(buffer->z);
+  free(buffer->r);
+  free(buffer->g);
+  free(buffer->b);
+  free(buffer->pixel);
+  memset(buffer, 0, sizeof(PointBuffer));
+}
+
+// 출력 버퍼에 남은 공간 확인 (압축하지 않으면 픽셀 수만큼 필요)
+static int checkCapacity(const RayTable* table, int row_begin, int row_end, const PointBuffer* out){
+  size_t needed = (size_t)(row_end - row_begin) * table->width;
+  if(out->count + needed > out->capacity){
+    fprintf(stderr, "Point buffer too small (%zu + %zu > %zu)\n", out->count, needed, out->capacity);
+    return 0;
+  }
+  return 1;
+}
+
+size_t unprojectDepthRowsScalar(const RayTable* table, const uint16_t* depth, const uint8_t* rgb, float min_depth,
+                                float max_depth, int row_begin, int row_end, int flags, PointBuffer* out){
+  if(!checkCapacity(table, row_begin, row_end, out)) return 0;
+
+  const int compact = flags & KERNEL_UNPROJECT_COMPACT;
+  const int withColor = rgb && !(flags & KERNEL_UNPROJECT_NO_COLOR);
+  const size_t start = out->count;
+  size_t n = start;
+
+  for(int v = row_begin; v < row_end; ++v){
+    size_t rowOffset = (size_t)v * table->width;
+    for(int u = 0; u < table->width; ++u){
+      size_t i = rowOffset + u;
+      float z = depth[i] * table->depthScale;
+      int valid = z >= min_depth && z <= max_depth;
+      if(compact && !valid) continue;
+      if(!valid) z = 0.0f;
+
+      out->x[n] = z * table->rayX[i];
+      out->y[n] = z * table->rayY[i];
+      out->z[n] = z;
+      out->pixel[n] = (uint32_t)i;
+      if(withColor){
+        out->r[n] = rgb[i * 3];
+        out->g[n] = rgb[i * 3 + 1];
+        out->b[n] = rgb[i * 3 + 2];
+      }
+      n++;
+    }
+  }
+
+  out->count = n;
+  return n - start;
+}
+
+size_t unprojectDepthRows(const RayTable* table, const uint16_t* depth, const uint8_t* rgb, float min_depth,
+                          float max_depth, int row_begin, int row_end, int flags, PointBuffer* out){
+#if defined(__SSE2__)
+  if(!checkCapacity(table, row_begin, row_end, out)) return 0;
+
+  const int compact = flags & KERNEL_UNPROJECT_COMPACT;
+  const int withColor = rgb && !(flags & KERNEL_UNPROJECT_NO_COLOR);
+  const int width = table->width;
+  const size_t start = out->count;
+  size_t n = start;
+
+  const __m128 scale = _mm_set1_ps(table->depthScale);
+  const __m128 minZ = _mm_set1_ps(min_depth);
+  const __m128 maxZ = _mm_set1_ps(max_depth);
+  const __m128i zero = _mm_setzero_si128();
+
+  float* ox = out->x;
+  float* oy = out->y;
+  float* oz = out->z;
+  uint32_t* op = out->pixel;
+
+  for(int v = row_begin; v < row_end; ++v){
+    const size_t rowOffset = (size_t)v * width;
+    const uint16_t* drow = depth + rowOffset;
+    const float* rx = table->rayX + rowOffset;
+    const float* ry = table->rayY + rowOffset;
+    int u = 0;
+
+    // 8 픽셀씩 처리 (16비트 깊이 8개 -> float 4개 x 2)
+    for(; u + 8 <= width; u += 8){
+      __m128i d16 = _mm_loadu_si128((const __m128i*)(drow + u));
+      __m128i halves[2] = {_mm_unpacklo_epi16(d16, zero), _mm_unpackhi_epi16(d16, zero)};
+
+      for(int h = 0; h < 2; ++h){
+        const int base = u + h * 4;
+        __m128 z = _mm_mul_ps(_mm_cvtepi32_ps(halves[h]), scale);
+        __m128 valid = _mm_and_ps(_mm_cmpge_ps(z, minZ), _mm_cmple_ps(z, maxZ));
+        int mask = _mm_movemask_ps(valid);
+        if(compact && mask == 0) continue;
+
+        z = _mm_and_ps(z, valid);
+        __m128 x = _mm_mul_ps(z, _mm_loadu_ps(rx + base));
+        __m128 y = _mm_mul_ps(z, _mm_loadu_ps(ry + base));
+
+        if(!compact || mask == 0xF){
+          // 4개 모두 유효하거나 압축하지 않는 경우 그대로 저장
+          _mm_storeu_ps(ox + n, x);
+          _mm_storeu_ps(oy + n, y);
+          _mm_storeu_ps(oz + n, z);
+          for(int k = 0; k < 4; ++k){
+            size_t i = rowOffset + base + k;
+            op[n + k] = (uint32_t)i;
+            if(withColor){
+              out->r[n + k] = rgb[i * 3];
+              out->g[n + k] = rgb[i * 3 + 1];
+              out->b[n + k] = rgb[i * 3 + 2];
+            }
+          }
+          n += 4;
+        }else{
+          // 분기 없는 압축: 항상 쓰고 유효할 때만 출력 위치 증가
+          float tx[4], ty[4], tz[4];
+          _mm_storeu_ps(tx, x);
+          _mm_storeu_ps(ty, y);
+          _mm_storeu_ps(tz, z);
+          for(int k = 0; k < 4; ++k){
+            size_t i = rowOffset + base + k;
+            ox[n] = tx[k];
+            oy[n] = ty[k];
+            oz[n] = tz[k];
+            op[n] = (uint32_t)i;
+            if(withColor){
+              out->r[n] = rgb[i * 3];
+              out->g[n] = rgb[i * 3 + 1];
+              out->b[n] = rgb[i * 3 + 2];
+            }
+            n += (mask >> k) & 1;
+          }
+        }
+      }
+    }
+
+    // 나머지 픽셀
+    for(; u < width; ++u){
+      size_t i = rowOffset + u;
+      float z = drow[u] * table->depthScale;
+      int valid = z >= min_depth && z <= max_depth;
+      if(compact && !valid) continue;
+      if(!valid) z = 0.0f;
+
+      ox[n] = z * rx[u];
+      oy[n] = z * ry[u];
+      oz[n] = z;
+      op[n] = (uint32_t)i;
+      if(withColor){
+        out->r[n] = rgb[i * 3];
+        out->g[n] = rgb[i * 3 + 1];
+        out->b[n] = rgb[i * 3 + 2];
+      }
+      n++;
+    }
+  }
+
+  out->count = n;
+  return n - start;
+#else
+  return unprojectDepthRowsScalar(table, depth, rgb, min_depth, max_depth, row_begin, row_end, flags, out);
+#endif
+}
+
+size_t unprojectDepth(const RayTable* table, const uint16_t* depth, const uint8_t* rgb, float min_depth,
+                      float max_depth, int flags, PointBuffer* out){
+  out->count = 0;
+  return unprojectDepthRows(table, depth, rgb, min_depth, max_depth, 0, table->height, flags, out);
+}
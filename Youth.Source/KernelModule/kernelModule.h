@@ -0,0 +1,113 @@
+#ifndef KERNEL_MODULE_H
+#define KERNEL_MODULE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 카메라 내부 파라미터
+typedef struct{
+  float fx, fy;        // 초점 거리 (픽셀)
+  float cx, cy;        // 주점 (픽셀)
+  float depthFactor;   // 깊이 값 / depthFactor = 미터 (DepthMapFactor)
+  int width, height;   // 보정 해상도
+} CameraIntrinsics;
+
+// 픽셀별 광선 테이블 (z = 1 평면 위의 광선 방향)
+// 광선을 미리 계산해 두면 역투영이 곱셈 두 번으로 끝나고, 왜곡 보정 광선도 같은 형식으로 담을 수 있음
+typedef struct{
+  int width, height;
+  float depthScale;    // 1 / depthFactor
+  float* rayX;         // (u - cx) / fx, width * height
+  float* rayY;         // (v - cy) / fy, width * height
+} RayTable;
+
+// 구조체 배열(SoA) 포인트 버퍼
+typedef struct{
+  float* x;
+  float* y;
+  float* z;
+  uint8_t* r;
+  uint8_t* g;
+  uint8_t* b;
+  uint32_t* pixel;     // 원본 픽셀 인덱스 (v * width + u)
+  size_t count;        // 유효한 포인트 수
+  size_t capacity;
+} PointBuffer;
+
+// 역투영 옵션 플래그
+#define KERNEL_UNPROJECT_COMPACT 0x1  // 유효 범위 밖의 깊이를 제거하고 앞으로 채움 (stream compaction)
+#define KERNEL_UNPROJECT_NO_COLOR 0x2 // 색상 채널 채우지 않음
+
+// Astra 기본 내부 파라미터 (설정 파일이 없을 때)
+void setDefaultCameraIntrinsics(CameraIntrinsics* intrinsics, int width, int height);
+
+// ORB-SLAM3 YAML 설정 파일에서 Camera.fx/fy/cx/cy/width/height, DepthMapFactor 읽기
+// 없는 항목은 기존 값 유지
+// 반환값: 성공 시 1, 실패 시 0
+int loadCameraIntrinsics(const char* yaml_file, CameraIntrinsics* intrinsics);
+
+// 다른 해상도에 맞게 내부 파라미터 스케일 조정
+void scaleCameraIntrinsics(const CameraIntrinsics* src, int width, int height, CameraIntrinsics* dst);
+
+// 렌즈 왜곡 계수 (OpenCV 방사 / 접선 모델)
+typedef struct{
+  float k1, k2, p1, p2, k3;
+} LensDistortion;
+
+// 깊이 / 색상 카메라 보정 (왜곡 보정, 깊이 -> 색상 정합용)
+typedef struct{
+  CameraIntrinsics depth;  // 깊이 (IR) 카메라, depthFactor 는 깊이 값 단위
+  CameraIntrinsics color;  // 색상 카메라 (정합 결과의 좌표계)
+  LensDistortion depthDistortion;
+  LensDistortion colorDistortion;
+  float rotation[9];       // 깊이 -> 색상 회전 (행 우선)
+  float translation[3];    // 깊이 -> 색상 이동 (m)
+} DepthColorCalibration;
+
+// 두 카메라 모두 Astra 기본 내부 파라미터, 왜곡 없음, 외부 파라미터는 항등
+void setDefaultDepthColorCalibration(DepthColorCalibration* calibration, int width, int height);
+
+// 색상은 Camera.xx, 깊이는 Depth.fx/fy/cx/cy/width/height 와 Depth.k1/k2/p1/p2/k3 (없으면 색상과 같음),
+// 외부 파라미터는 DepthToColor.rx/ry/rz (회전 벡터, rad) 와 DepthToColor.tx/ty/tz (m)
+// 반환값: 성공 시 1, 실패 시 0 (색상 내부 파라미터가 없을 때)
+int loadDepthColorCalibration(const char* yaml_file, DepthColorCalibration* calibration);
+
+// 광선 테이블 생성 (해상도가 보정 해상도와 다르면 내부 파라미터를 스케일 조정)
+// 반환값: 성공 시 1, 실패 시 0
+int createRayTable(RayTable* table, const CameraIntrinsics* intrinsics, int width, int height);
+void destroyRayTable(RayTable* table);
+
+// SSE 로드 / 저장용 16바이트 정렬 할당 (bytes 가 0 이어도 유효한 포인터), free() 로 해제
+// 반환값: 실패 시 NULL
+void* alignedAlloc(size_t bytes);
+
+// 포인트 버퍼 할당 / 해제 (16바이트 정렬)
+// 반환값: 성공 시 1, 실패 시 0
+int allocPointBuffer(PointBuffer* buffer, size_t capacity);
+void freePointBuffer(PointBuffer* buffer);
+
+// 깊이 + 색상 역투영 (SIMD)
+// depth: 16비트 깊이, rgb: 픽셀당 3바이트 RGB (NULL 가능)
+// min_depth, max_depth: 유효 깊이 범위 (m), 범위 밖의 픽셀은 압축 모드에서 제거, 아니면 0 으로 출력
+// row_begin, row_end: 처리할 행 범위 (병렬 분할용), 결과는 out 뒤에 이어서 추가됨
+// 반환값: 이번 호출에서 추가된 포인트 수
+size_t unprojectDepthRows(const RayTable* table, const uint16_t* depth, const uint8_t* rgb, float min_depth,
+                          float max_depth, int row_begin, int row_end, int flags, PointBuffer* out);
+
+// 전체 영상 역투영 (out->count 를 0 으로 초기화한 뒤 실행)
+size_t unprojectDepth(const RayTable* table, const uint16_t* depth, const uint8_t* rgb, float min_depth,
+                      float max_depth, int flags, PointBuffer* out);
+
+// 스칼라 기준 구현 (검증 및 벤치마크용)
+size_t unprojectDepthRowsScalar(const RayTable* table, const uint16_t* depth, const uint8_t* rgb, float min_depth,
+                                float max_depth, int row_begin, int row_end, int flags, PointBuffer* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KERNEL_MODULE_H
@@ -0,0 +1,159 @@
+// 깊이 -> 색상 정합 벤치마크
+// 사용법: RegistrationBenchmark [camera.yaml] [width] [height] [iterations]
+// 설정 파일이 없으면 깊이 / 색상 초점 거리가 다르고 25 mm 떨어진 가상 보정을 사용
+// SIMD + 다중 스레드 결과가 스칼라 기준 구현과 같은지, 배정밀도 투영과 맞는지 확인한 뒤 스레드 수별 ms/frame 출력
+
+#include "depthRegistration.h"
+#include "benchmarkUtil.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define FRAME_BUDGET_MS 33.3
+
+// 배정밀도로 직접 투영한 위치의 결과 깊이가 기대값과 같거나 더 가까운지 (가려짐) 확인
+static int checkGeometry(const DepthColorCalibration* calibration, int width, int height, const uint16_t* depth,
+                         const uint16_t* out){
+  CameraIntrinsics Kd, Kc;
+  scaleCameraIntrinsics(&calibration->depth, width, height, &Kd);
+  scaleCameraIntrinsics(&calibration->color, width, height, &Kc);
+  const float* R = calibration->rotation;
+  const float* t = calibration->translation;
+
+  int checked = 0, wrong = 0;
+  for(int v = 1; v < height; v += 7){
+    for(int u = 3; u < width; u += 11){
+      double z = depth[(size_t)v * width + u] / (double)Kd.depthFactor;
+      if(z <= 0.0) continue;
+      double x = (u - Kd.cx) / Kd.fx * z, y = (v - Kd.cy) / Kd.fy * z;
+      double X = R[0] * x + R[1] * y + R[2] * z + t[0];
+      double Y = R[3] * x + R[4] * y + R[5] * z + t[1];
+      double Z = R[6] * x + R[7] * y + R[8] * z + t[2];
+      int uc = (int)lrint(Kc.fx * X / Z + Kc.cx), vc = (int)lrint(Kc.fy * Y / Z + Kc.cy);
+      if(uc < 0 || uc >= width || vc < 0 || vc >= height) continue;
+
+      // 반올림 경계에서 1 픽셀 어긋날 수 있으므로 이웃까지 확인
+      double expected = Z * Kd.depthFactor;
+      int found = 0;
+      for(int dv = -1; dv <= 1 && !found; ++dv){
+        for(int du = -1; du <= 1 && !found; ++du){
+          int pu = uc + du, pv = vc + dv;
+          if(pu < 0 || pu >= width || pv < 0 || pv >= height) continue;
+          uint16_t d = out[(size_t)pv * width + pu];
+          found = d != 0 && d <= expected + 1.0;
+        }
+      }
+      checked++;
+      wrong += !found;
+    }
+  }
+  printf("Geometry check: %d pixels, %d wrong\n", checked, wrong);
+  return wrong == 0;
+}
+
+typedef void (*RegisterFunc)(DepthRegistration*, const uint16_t*, uint16_t*);
+
+static double runBenchmark(const char* name, RegisterFunc func, DepthRegistration* registration,
+                           const uint16_t* depth, uint16_t* out, int iterations){
+  // 워밍업
+  func(registration, depth, out);
+
+  double start = benchmarkNow();
+  for(int i = 0; i < iterations; ++i){
+    func(registration, depth, out);
+  }
+  double ms = (benchmarkNow() - start) * 1000.0 / iterations;
+  printf("%-16s %8.3f ms/frame  %8.1f FPS max\n", name, ms, 1000.0 / ms);
+  return ms;
+}
+
+int main(int argc, char** argv){
+  int width = argc > 2 ? atoi(argv[2]) : 640;
+  int height = argc > 3 ? atoi(argv[3]) : 480;
+  int iterations = argc > 4 ? atoi(argv[4]) : 200;
+  if(width < 1 || height < 1 || iterations < 1){
+    fprintf(stderr, "Usage: %s [camera.yaml] [width] [height] [iterations]\n", argv[0]);
+    return 1;
+  }
+
+  DepthColorCalibration calibration;
+  setDefaultDepthColorCalibration(&calibration, 640, 480);
+  if(argc > 1 && argv[1][0] && loadDepthColorCalibration(argv[1], &calibration)){
+    printf("Calibration from %s\n", argv[1]);
+  }else{
+    calibration.color.fx = calibration.color.fy = 520.0f;
+    calibration.color.cx = 318.0f;
+    calibration.color.cy = 243.0f;
+    calibration.translation[0] = -0.025f;
+    printf("Synthetic calibration\n");
+  }
+  printf("Depth fx %.1f cx %.1f cy %.1f, color fx %.1f cx %.1f cy %.1f, t %.4f %.4f %.4f m, frame %dx%d\n",
+         calibration.depth.fx, calibration.depth.cx, calibration.depth.cy, calibration.color.fx,
+         calibration.color.cx, calibration.color.cy, calibration.translation[0], calibration.translation[1],
+         calibration.translation[2], width, height);
+
+  size_t pixels = (size_t)width * height;
+  uint16_t* depth = (uint16_t*)malloc(pixels * sizeof(uint16_t));
+  uint16_t* reference = (uint16_t*)malloc(pixels * sizeof(uint16_t));
+  uint16_t* out = (uint16_t*)malloc(pixels * sizeof(uint16_t));
+  if(!depth || !reference || !out){
+    return 1;
+  }
+  renderBenchmarkBoxScene(width, height, depth, NULL);
+
+  int cores = (int)sysconf(_SC_NPROCESSORS_ONLN);
+  if(cores < 1) cores = 1;
+  int maxThreads = cores > 8 ? 8 : cores;
+
+  // 스레드 수에 관계없이 스칼라 기준 구현과 같아야 함
+  DepthRegistration* scalar = createDepthRegistration(&calibration, width, height, width, height, 0.2f, 10.0f, 1);
+  if(!scalar){
+    fprintf(stderr, "Failed to create registration\n");
+    return 1;
+  }
+  registerDepthToColorScalar(scalar, depth, reference);
+  for(int threads = 1; threads <= (maxThreads > 4 ? maxThreads : 4); threads *= 2){
+    DepthRegistration* registration =
+      createDepthRegistration(&calibration, width, height, width, height, 0.2f, 10.0f, threads);
+    if(!registration){
+      return 1;
+    }
+    registerDepthToColor(registration, depth, out);
+    destroyDepthRegistration(registration);
+    if(memcmp(out, reference, pixels * sizeof(uint16_t)) != 0){
+      fprintf(stderr, "Output with %d threads differs from scalar reference\n", threads);
+      return 1;
+    }
+  }
+  printf("SIMD output matches scalar reference\n");
+  if(!checkGeometry(&calibration, width, height, depth, reference)){
+    return 1;
+  }
+
+  size_t covered = 0;
+  for(size_t i = 0; i < pixels; ++i) covered += reference[i] != 0;
+  printf("Registered pixels: %.1f%%\n", 100.0 * covered / pixels);
+
+  runBenchmark("scalar", registerDepthToColorScalar, scalar, depth, out, iterations);
+  destroyDepthRegistration(scalar);
+
+  double best = 0.0;
+  for(int threads = 1; threads <= maxThreads; threads *= 2){
+    DepthRegistration* registration =
+      createDepthRegistration(&calibration, width, height, width, height, 0.2f, 10.0f, threads);
+    char name[32];
+    snprintf(name, sizeof(name), "simd %d thread%s", threads, threads > 1 ? "s" : "");
+    double ms = runBenchmark(name, registerDepthToColor, registration, depth, out, iterations);
+    if(best == 0.0 || ms < best) best = ms;
+    destroyDepthRegistration(registration);
+  }
+  printf("Best %.3f ms/frame, %s %.1f ms (30 FPS) budget\n", best, best <= FRAME_BUDGET_MS ? "within" : "OVER",
+         FRAME_BUDGET_MS);
+
+  free(depth);
+  free(reference);
+  free(out);
+  return 0;
+}
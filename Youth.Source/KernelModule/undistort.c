@@ -0,0 +1,209 @@
+#include "undistort.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define FRACTION_TABLE_SIZE (UNDISTORT_FRACTION_STEPS * UNDISTORT_FRACTION_STEPS)
+
+// 원본 좌표 -> 왼쪽 위 정수 좌표 + 1/32 소수부 (오른쪽 / 아래 끝은 마지막 칸 안으로)
+static void splitCoordinate(double value, int size, int* base, int* fraction){
+  int integer = (int)floor(value);
+  int steps = (int)lrint((value - integer) * UNDISTORT_FRACTION_STEPS);
+  if(steps == UNDISTORT_FRACTION_STEPS){
+    integer++;
+    steps = 0;
+  }
+  if(integer >= size - 1){
+    integer = size - 2;
+    steps = UNDISTORT_FRACTION_STEPS - 1;
+  }
+  *base = integer;
+  *fraction = steps;
+}
+
+int createUndistortMap(UndistortMap* map, const CameraIntrinsics* intrinsics, const LensDistortion* distortion,
+                       int width, int height){
+  memset(map, 0, sizeof(UndistortMap));
+  if(width < 2 || height < 2 || intrinsics->fx <= 0.0f || intrinsics->fy <= 0.0f){
+    return 0;
+  }
+  map->width = width;
+  map->height = height;
+
+  const LensDistortion* d = distortion;
+  if(d->k1 == 0.0f && d->k2 == 0.0f && d->p1 == 0.0f && d->p2 == 0.0f && d->k3 == 0.0f){
+    map->identity = 1;
+    return 1;
+  }
+
+  size_t pixels = (size_t)width * height;
+  map->source = (int32_t*)alignedAlloc(pixels * sizeof(int32_t));
+  map->fraction = (uint16_t*)alignedAlloc(pixels * sizeof(uint16_t));
+  map->weights = (int16_t*)alignedAlloc(FRACTION_TABLE_SIZE * 16 * sizeof(int16_t));
+  if(!map->source || !map->fraction || !map->weights){
+    destroyUndistortMap(map);
+    return 0;
+  }
+
+  CameraIntrinsics K;
+  scaleCameraIntrinsics(intrinsics, width, height, &K);
+
+  // 출력 (핀홀) 픽셀의 정규 좌표에 왜곡을 적용해 원본에서 읽을 위치 계산
+  for(int v = 0; v < height; ++v){
+    for(int u = 0; u < width; ++u){
+      const size_t i = (size_t)v * width + u;
+      const double x = (u - K.cx) / K.fx, y = (v - K.cy) / K.fy;
+      const double r2 = x * x + y * y;
+      const double radial = 1.0 + r2 * (d->k1 + r2 * (d->k2 + r2 * d->k3));
+      const double xd = x * radial + 2.0 * d->p1 * x * y + d->p2 * (r2 + 2.0 * x * x);
+      const double yd = y * radial + d->p1 * (r2 + 2.0 * y * y) + 2.0 * d->p2 * x * y;
+      const double us = K.fx * xd + K.cx, vs = K.fy * yd + K.cy;
+
+      if(!(us >= 0.0 && vs >= 0.0 && us <= width - 1 && vs <= height - 1)){
+        map->source[i] = -1;
+        map->fraction[i] = 0;
+        continue;
+      }
+      int x0, y0, fx, fy;
+      splitCoordinate(us, width, &x0, &fx);
+      splitCoordinate(vs, height, &y0, &fy);
+      map->source[i] = y0 * width + x0;
+      map->fraction[i] = (uint16_t)(fy << UNDISTORT_FRACTION_BITS | fx);
+    }
+  }
+
+  // 소수부별 가중치 (합이 256 이 되도록 w00 을 맞춤), SIMD 용으로 RGB 채널마다 반복
+  for(int fy = 0; fy < UNDISTORT_FRACTION_STEPS; ++fy){
+    for(int fx = 0; fx < UNDISTORT_FRACTION_STEPS; ++fx){
+      const int f = fy << UNDISTORT_FRACTION_BITS | fx;
+      const double n = UNDISTORT_FRACTION_STEPS;
+      int w01 = (int)lrint(256.0 * fx * (n - fy) / (n * n));
+      int w10 = (int)lrint(256.0 * (n - fx) * fy / (n * n));
+      int w11 = (int)lrint(256.0 * fx * fy / (n * n));
+      int w00 = 256 - w01 - w10 - w11;
+      int16_t* w = map->weights + f * 16;
+      for(int c = 0; c < 3; ++c){
+        w[c] = (int16_t)w00;
+        w[3 + c] = (int16_t)w01;
+        w[8 + c] = (int16_t)w10;
+        w[11 + c] = (int16_t)w11;
+      }
+      w[6] = w[7] = w[14] = w[15] = 0;
+      map->nearest[f] = (fx >= UNDISTORT_FRACTION_STEPS / 2) + (fy >= UNDISTORT_FRACTION_STEPS / 2) * width;
+    }
+  }
+  return 1;
+}
+
+void destroyUndistortMap(UndistortMap* map){
+  free(map->source);
+  free(map->fraction);
+  free(map->weights);
+  map->source = NULL;
+  map->fraction = NULL;
+  map->weights = NULL;
+}
+
+static inline void undistortColorPixel(const UndistortMap* map, const uint8_t* rgb, uint8_t* out, size_t i){
+  const int32_t s = map->source[i];
+  uint8_t* o = out + i * 3;
+  if(s < 0){
+    o[0] = o[1] = o[2] = 0;
+    return;
+  }
+  const int16_t* w = map->weights + map->fraction[i] * 16;
+  const uint8_t* p00 = rgb + (size_t)s * 3;
+  const uint8_t* p10 = p00 + (size_t)map->width * 3;
+  for(int c = 0; c < 3; ++c){
+    o[c] = (uint8_t)((p00[c] * w[0] + p00[3 + c] * w[3] + p10[c] * w[8] + p10[3 + c] * w[11] + 128) >> 8);
+  }
+}
+
+void undistortColorScalar(const UndistortMap* map, const uint8_t* rgb, uint8_t* out){
+  const size_t pixels = (size_t)map->width * map->height;
+  if(map->identity){
+    memcpy(out, rgb, pixels * 3);
+    return;
+  }
+  for(size_t i = 0; i < pixels; ++i){
+    undistortColorPixel(map, rgb, out, i);
+  }
+}
+
+#if defined(__SSE2__)
+// 픽셀 하나의 이중 선형 보간 (위 / 아래 행에서 두 픽셀씩 8바이트 읽기), 결과는 16비트 0 ~ 2 번 채널
+static inline __m128i blendPixel(const UndistortMap* map, const uint8_t* rgb, int32_t s, uint16_t fraction){
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i* w = (const __m128i*)(map->weights + fraction * 16);
+  const uint8_t* p = rgb + (size_t)s * 3;
+  __m128i top = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)p), zero);
+  __m128i bottom = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(p + (size_t)map->width * 3)), zero);
+  __m128i sum = _mm_add_epi16(_mm_mullo_epi16(top, _mm_load_si128(w)),
+                              _mm_mullo_epi16(bottom, _mm_load_si128(w + 1)));
+  return _mm_add_epi16(sum, _mm_srli_si128(sum, 6));
+}
+#endif
+
+void undistortColor(const UndistortMap* map, const uint8_t* rgb, uint8_t* out){
+#if defined(__SSE2__)
+  const size_t pixels = (size_t)map->width * map->height;
+  if(map->identity){
+    memcpy(out, rgb, pixels * 3);
+    return;
+  }
+
+  // 아래 행 8바이트 읽기가 버퍼 끝을 넘는 마지막 칸은 스칼라로
+  const uint32_t limit = (uint32_t)((map->height - 1) * map->width - 2);
+  const __m128i round = _mm_set1_epi16(128);
+  size_t i = 0;
+
+  // 두 픽셀씩 (4바이트 저장이 다음 픽셀 자리를 덮으므로 마지막 두 픽셀은 스칼라)
+  for(; i + 3 <= pixels; i += 2){
+    const int32_t a = map->source[i], b = map->source[i + 1];
+    if((uint32_t)a >= limit || (uint32_t)b >= limit){
+      undistortColorPixel(map, rgb, out, i);
+      undistortColorPixel(map, rgb, out, i + 1);
+      continue;
+    }
+    __m128i pa = blendPixel(map, rgb, a, map->fraction[i]);
+    __m128i pb = blendPixel(map, rgb, b, map->fraction[i + 1]);
+    __m128i both = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(pa, pb), round), 8);
+    __m128i packed = _mm_packus_epi16(both, both);
+    uint32_t va = (uint32_t)_mm_cvtsi128_si32(packed);
+    uint32_t vb = (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(packed, 4));
+    memcpy(out + i * 3, &va, 4);
+    memcpy(out + i * 3 + 3, &vb, 4);
+  }
+  for(; i < pixels; ++i){
+    undistortColorPixel(map, rgb, out, i);
+  }
+#else
+  undistortColorScalar(map, rgb, out);
+#endif
+}
+
+void undistortDepth(const UndistortMap* map, const uint16_t* depth, uint16_t* out){
+  const size_t pixels = (size_t)map->width * map->height;
+  if(map->identity){
+    memcpy(out, depth, pixels * sizeof(uint16_t));
+    return;
+  }
+  // 임의 위치 읽기 (gather) 라 SSE2 로는 이득이 없어 4 픽셀씩 펼쳐서 처리
+  const int32_t* source = map->source;
+  const uint16_t* fraction = map->fraction;
+  size_t i = 0;
+  for(; i + 4 <= pixels; i += 4){
+    for(int k = 0; k < 4; ++k){
+      const int32_t s = source[i + k];
+      out[i + k] = s < 0 ? 0 : depth[s + map->nearest[fraction[i + k]]];
+    }
+  }
+  for(; i < pixels; ++i){
+    const int32_t s = source[i];
+    out[i] = s < 0 ? 0 : depth[s + map->nearest[fraction[i]]];
+  }
+}
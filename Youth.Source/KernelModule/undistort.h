@@ -0,0 +1,45 @@
+#ifndef UNDISTORT_H
+#define UNDISTORT_H
+
+#include "kernelModule.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 소수부 비트 수 (원본 좌표를 1/32 픽셀 단위로 저장)
+#define UNDISTORT_FRACTION_BITS 5
+#define UNDISTORT_FRACTION_STEPS (1 << UNDISTORT_FRACTION_BITS)
+
+// 왜곡 보정 리맵 테이블 (출력 픽셀 -> 왜곡된 원본 위치, 고정 소수점)
+// 출력은 같은 내부 파라미터의 핀홀 영상이므로 이후 단계 (역투영, 정합, SLAM) 는 왜곡을 몰라도 됨
+typedef struct{
+  int width, height;
+  int identity;          // 왜곡 계수가 모두 0 (복사만 함)
+  int32_t* source;       // 원본 왼쪽 위 픽셀 인덱스 (v * width + u, 영상 밖이면 -1)
+  uint16_t* fraction;    // 소수부 (y << 5 | x)
+  int32_t nearest[UNDISTORT_FRACTION_STEPS * UNDISTORT_FRACTION_STEPS]; // 소수부 -> 가장 가까운 픽셀 오프셋
+  int16_t* weights;      // 소수부별 이중 선형 가중치 (Q8, SIMD 용 위 / 아래 행 8 개씩)
+} UndistortMap;
+
+// 리맵 테이블 생성 (해상도가 보정 해상도와 다르면 내부 파라미터를 스케일 조정)
+// 반환값: 성공 시 1, 실패 시 0
+int createUndistortMap(UndistortMap* map, const CameraIntrinsics* intrinsics, const LensDistortion* distortion,
+                       int width, int height);
+void destroyUndistortMap(UndistortMap* map);
+
+// 색상 (RGB 3바이트) 이중 선형 보간, 영상 밖은 검은색 (SIMD)
+void undistortColor(const UndistortMap* map, const uint8_t* rgb, uint8_t* out);
+
+// 깊이 최근접 (보간하면 경계에서 없는 깊이가 생김), 영상 밖은 0
+void undistortDepth(const UndistortMap* map, const uint16_t* depth, uint16_t* out);
+
+// 스칼라 기준 구현 (검증 및 벤치마크용)
+void undistortColorScalar(const UndistortMap* map, const uint8_t* rgb, uint8_t* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UNDISTORT_H
@@ -0,0 +1,137 @@
+// 렌즈 왜곡 보정 벤치마크
+// 사용법: UndistortBenchmark [camera.yaml] [width] [height] [iterations]
+// 설정 파일에 왜곡 계수가 없으면 Astra 색상 카메라 수준의 가상 계수를 사용
+// SIMD 결과가 스칼라 기준 구현과 같은지, 배정밀도 보간과 2 이하로 맞는지 확인한 뒤 색상 / 깊이 ms/frame 출력
+
+#include "undistort.h"
+#include "benchmarkUtil.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FRAME_BUDGET_MS 2.0
+
+// 리맵 테이블 위치에서 배정밀도 이중 선형 보간한 값과 비교 (가중치 반올림 오차만 허용)
+static int checkInterpolation(const UndistortMap* map, const uint8_t* rgb, const uint8_t* out){
+  const int width = map->width;
+  int checked = 0, wrong = 0;
+  for(size_t i = 0; i < (size_t)width * map->height; i += 97){
+    int32_t s = map->source[i];
+    if(s < 0){
+      wrong += out[i * 3] != 0 || out[i * 3 + 1] != 0 || out[i * 3 + 2] != 0;
+      continue;
+    }
+    double fx = (map->fraction[i] & (UNDISTORT_FRACTION_STEPS - 1)) / (double)UNDISTORT_FRACTION_STEPS;
+    double fy = (map->fraction[i] >> UNDISTORT_FRACTION_BITS) / (double)UNDISTORT_FRACTION_STEPS;
+    const uint8_t* p00 = rgb + (size_t)s * 3;
+    const uint8_t* p10 = p00 + (size_t)width * 3;
+    for(int c = 0; c < 3; ++c){
+      double expected = (1 - fy) * ((1 - fx) * p00[c] + fx * p00[3 + c]) + fy * ((1 - fx) * p10[c] + fx * p10[3 + c]);
+      wrong += fabs(out[i * 3 + c] - expected) > 2.0;
+    }
+    checked++;
+  }
+  printf("Interpolation check: %d pixels, %d wrong\n", checked, wrong);
+  return wrong == 0;
+}
+
+typedef void (*ColorFunc)(const UndistortMap*, const uint8_t*, uint8_t*);
+
+static double runColor(const char* name, ColorFunc func, const UndistortMap* map, const uint8_t* rgb, uint8_t* out,
+                       int iterations){
+  // 워밍업
+  func(map, rgb, out);
+
+  double start = benchmarkNow();
+  for(int i = 0; i < iterations; ++i){
+    func(map, rgb, out);
+  }
+  double ms = (benchmarkNow() - start) * 1000.0 / iterations;
+  printf("%-16s %8.3f ms/frame  %8.1f FPS max\n", name, ms, 1000.0 / ms);
+  return ms;
+}
+
+int main(int argc, char** argv){
+  int width = argc > 2 ? atoi(argv[2]) : 640;
+  int height = argc > 3 ? atoi(argv[3]) : 480;
+  int iterations = argc > 4 ? atoi(argv[4]) : 200;
+  if(width < 2 || height < 2 || iterations < 1){
+    fprintf(stderr, "Usage: %s [camera.yaml] [width] [height] [iterations]\n", argv[0]);
+    return 1;
+  }
+
+  DepthColorCalibration calibration;
+  setDefaultDepthColorCalibration(&calibration, 640, 480);
+  LensDistortion* distortion = &calibration.colorDistortion;
+  if(argc > 1 && argv[1][0] && loadDepthColorCalibration(argv[1], &calibration) &&
+     (distortion->k1 != 0.0f || distortion->k2 != 0.0f || distortion->p1 != 0.0f || distortion->p2 != 0.0f)){
+    printf("Distortion from %s\n", argv[1]);
+  }else{
+    distortion->k1 = -0.2f;
+    distortion->k2 = 0.05f;
+    distortion->p1 = 0.001f;
+    distortion->p2 = -0.001f;
+    distortion->k3 = 0.0f;
+    printf("Synthetic distortion\n");
+  }
+  printf("fx %.1f cx %.1f cy %.1f, k1 %.4f k2 %.4f p1 %.4f p2 %.4f k3 %.4f, frame %dx%d\n", calibration.color.fx,
+         calibration.color.cx, calibration.color.cy, distortion->k1, distortion->k2, distortion->p1, distortion->p2,
+         distortion->k3, width, height);
+
+  size_t pixels = (size_t)width * height;
+  uint8_t* rgb = (uint8_t*)malloc(pixels * 3);
+  uint8_t* reference = (uint8_t*)malloc(pixels * 3);
+  uint8_t* out = (uint8_t*)malloc(pixels * 3);
+  uint16_t* depth = (uint16_t*)malloc(pixels * sizeof(uint16_t));
+  uint16_t* depthOut = (uint16_t*)malloc(pixels * sizeof(uint16_t));
+  if(!rgb || !reference || !out || !depth || !depthOut){
+    return 1;
+  }
+  renderBenchmarkBoxScene(width, height, depth, rgb);
+
+  UndistortMap map;
+  double start = benchmarkNow();
+  if(!createUndistortMap(&map, &calibration.color, distortion, width, height)){
+    fprintf(stderr, "Failed to create undistort map\n");
+    return 1;
+  }
+  printf("Map build: %.1f ms (once per stream)\n", (benchmarkNow() - start) * 1000.0);
+
+  undistortColorScalar(&map, rgb, reference);
+  undistortColor(&map, rgb, out);
+  if(memcmp(out, reference, pixels * 3) != 0){
+    fprintf(stderr, "SIMD output differs from scalar reference\n");
+    return 1;
+  }
+  printf("SIMD output matches scalar reference\n");
+  if(!map.identity && !checkInterpolation(&map, rgb, reference)){
+    return 1;
+  }
+
+  size_t covered = 0;
+  for(size_t i = 0; i < pixels; ++i) covered += map.identity || map.source[i] >= 0;
+  printf("Covered pixels: %.1f%%\n", 100.0 * covered / pixels);
+
+  runColor("color scalar", undistortColorScalar, &map, rgb, out, iterations);
+  double colorMs = runColor("color simd", undistortColor, &map, rgb, out, iterations);
+
+  undistortDepth(&map, depth, depthOut);
+  start = benchmarkNow();
+  for(int i = 0; i < iterations; ++i){
+    undistortDepth(&map, depth, depthOut);
+  }
+  double depthMs = (benchmarkNow() - start) * 1000.0 / iterations;
+  printf("%-16s %8.3f ms/frame  %8.1f FPS max\n", "depth nearest", depthMs, 1000.0 / depthMs);
+
+  printf("Color + depth %.3f ms/frame, %s %.1f ms budget\n", colorMs + depthMs,
+         colorMs + depthMs <= FRAME_BUDGET_MS ? "within" : "OVER", FRAME_BUDGET_MS);
+
+  destroyUndistortMap(&map);
+  free(rgb);
+  free(reference);
+  free(out);
+  free(depth);
+  free(depthOut);
+  return 0;
+}
@@ -1,5 +1,7 @@
 #include "loggingModule.h"
 #include "../frameDefinitions.h"
+#include "../MonitorModule/monitorModule.h"
+#include "../KernelModule/frameDecimation.h"
 #include <pthread.h>
 #include <stdlib.h>
 #include <string.h>
@@ -12,49 +14,120 @@
 #include <time.h>
 #include <sys/time.h>
 
-// 스레드 제어 변수
-static int loggingIsRunning = 1;
-static int isRecordingData = 0;
-static int isPlaybackActive = 0;
-static int isPassThroughEnabled = 1; // 기본적으로 패스스루 활성화
-uint32_t playbackFrameCounter = 0;
-
-
-// 스레드 ID 
-static pthread_t logger_thread_id;
-static pthread_t playback_thread_id;
-
-// 메세지 큐 핸들
-static mqd_t mqFromSensor = -1;
-static mqd_t mqToViewer = -1;
-static mqd_t mqControl = -1;
-
-// 파일 핸들
-static FILE* recordFile = NULL;
-static FILE* playbackFile = NULL;
-
-// 뮤텍스
-static pthread_mutex_t recordMutex = PTHREAD_MUTEX_INITIALIZER;
-static pthread_mutex_t playbackMutex = PTHREAD_MUTEX_INITIALIZER;
+// 로거 / 재생 단계 하나의 상태 (파이프라인마다 하나)
+struct LoggingContext{
+  LoggingOptions options;
+  char pipeline[MAX_PIPELINE_NAME];
+  PipelineQueueNames queues;
+
+  // 스레드 제어 변수
+  int running;
+  int threadsStarted;
+  int isRecordingData;
+  int isPlaybackActive;
+  int isPassThroughEnabled; // 기본적으로 패스스루 활성화
+  uint32_t playbackFrameCounter;
+
+  // 스레드 ID
+  pthread_t loggerThreadId;
+  pthread_t playbackThreadId;
+
+  // 메세지 큐 핸들
+  mqd_t mqFromSensor;
+  mqd_t mqToViewer;
+  mqd_t mqControl;
+
+  // 파일 핸들
+  FILE* recordFile;
+  FILE* playbackFile;
+
+  // 뮤텍스
+  pthread_mutex_t recordMutex;
+  pthread_mutex_t playbackMutex;
+
+  // 파일명 저장 변수
+  char currentRecordFilename[256];
+  char currentPlaybackFilename[256];
+
+  // 프레임 카운터
+  uint32_t frameCounter;
+
+  // 기타 상태 변수
+  int receivedDepthFrame;
+  int receivedColorFrame;
+
+  // 버퍼
+  char* depthBuffer;
+  char* colorBuffer;
+  int currentWidth;
+  int currentHeight;
+  int currentCameraId;
+  int depthBufferSize;
+  int colorBufferSize;
+
+  // 소비자별 해상도 (녹화 / 뷰어 / 콜백이 필요한 가장 작은 단계까지 프레임마다 한 번 계산)
+  FramePyramid pyramid;         // 로거 스레드
+  FramePyramid playbackPyramid; // 재생 스레드
+
+  // 완성된 프레임 콜백
+  LoggerFrameCallback frameCallback;
+  void* frameCallbackUser;
+};
+
+// 기본 컨텍스트 (Youth 프로세스의 파이프라인, initLoggingModule 등 기존 함수가 사용)
+static LoggingContext defaultLogging;
+static pthread_once_t defaultLoggingOnce = PTHREAD_ONCE_INIT;
+
+void setDefaultLoggingOptions(LoggingOptions* options){
+  options->pipeline = NULL;
+  options->sensorInput = 1;
+  options->forwardToViewer = 1;
+  options->playbackFps = 30;
+  options->recordDecimation = 1;
+  options->viewerDecimation = 1;
+  options->callbackDecimation = 1;
+}
 
-// 파일명 저장 변수
-static char currentRecordFilename[256];
-static char currentPlaybackFilename[256];
+// 옵션 적용 (파이프라인 이름은 컨텍스트에 복사)
+static void applyLoggingOptions(LoggingContext* logging, const LoggingOptions* options){
+  logging->options = *options;
+  snprintf(logging->pipeline, sizeof(logging->pipeline), "%s", options->pipeline ? options->pipeline : "");
+  logging->options.pipeline = logging->pipeline;
+  makePipelineQueueNames(&logging->queues, logging->pipeline);
+
+  // 지원하지 않는 배율은 원본 해상도 (main 은 시작 전에 검사하므로 다른 호출자용)
+  int* decimations[3] = {&logging->options.recordDecimation, &logging->options.viewerDecimation,
+                         &logging->options.callbackDecimation};
+  const char* consumers[3] = {"record", "viewer", "callback"};
+  for(int i = 0; i < 3; ++i){
+    if(decimationLevel(*decimations[i]) < 0){
+      printf("Unsupported %s decimation %d, using full resolution\n", consumers[i], *decimations[i]);
+      *decimations[i] = 1;
+    }
+  }
+}
 
-// 프레임 카운터
-static uint32_t frameCounter = 0;
+static void initLoggingContext(LoggingContext* logging, const LoggingOptions* options){
+  memset(logging, 0, sizeof(*logging));
+  applyLoggingOptions(logging, options);
+  logging->isPassThroughEnabled = 1;
+  logging->mqFromSensor = (mqd_t)-1;
+  logging->mqToViewer = (mqd_t)-1;
+  logging->mqControl = (mqd_t)-1;
+  pthread_mutex_init(&logging->recordMutex, NULL);
+  pthread_mutex_init(&logging->playbackMutex, NULL);
+}
 
-// 기타 상태 변수
-static int receivedDepthFrame = 0;
-static int receivedColorFrame = 0;
+static void initDefaultLogging(void){
+  LoggingOptions options;
+  setDefaultLoggingOptions(&options);
+  initLoggingContext(&defaultLogging, &options);
+}
 
-// 버퍼
-static char* depthBuffer = NULL;
-static char* colorBuffer = NULL;
-static int currentWidth = 0;
-static int currentHeight = 0;
-static int depthBufferSize = 0;
-static int colorBufferSize = 0;
+static LoggingContext* defaultLoggingContext(void){
+  pthread_once(&defaultLoggingOnce, initDefaultLogging);
+  return &defaultLogging;
+}
 
 // 현재 시간 가져오기 (밀리초)
 static uint32_t getCurrentTimeMS(){
@@ -64,103 +137,244 @@ static uint32_t getCurrentTimeMS(){
   return (uint32_t)(tv.tv_sec * 1000 + tv.tv_usec / 1000);
 }
 
+// 최대 timeout_ms 동안 기다리는 수신 (센서가 없어도 종료 플래그와 제어 메세지를 확인할 수 있도록)
+static ssize_t receiveWithTimeout(mqd_t mqdes, char* buffer, int timeout_ms){
+  struct timespec deadline;
+  clock_gettime(CLOCK_REALTIME, &deadline);
+  deadline.tv_nsec += timeout_ms * 1000000L;
+  if(deadline.tv_nsec >= 1000000000L){
+    deadline.tv_sec++;
+    deadline.tv_nsec -= 1000000000L;
+  }
+  return mq_timedreceive(mqdes, buffer, MAX_MSG_SIZE, NULL, &deadline);
+}
+
 // 버퍼 재할당 함수
-static int reallocateBuffers(int width, int height){
+static int reallocateBuffers(LoggingContext* logging, int width, int height){
   int depthSize = width * height * sizeof(int16_t);
   int colorSize = width * height * 3 * sizeof(uint8_t);
 
   // 깊이 버퍼 할당/재할당
-  if(depthBuffer == NULL || depthBufferSize < depthSize){
-    char* newBuffer = (char*)realloc(depthBuffer, depthSize);
+  if(logging->depthBuffer == NULL || logging->depthBufferSize < depthSize){
+    char* newBuffer = (char*)realloc(logging->depthBuffer, depthSize);
     if(newBuffer == NULL){
       perror("Failed to allocate depth buffer");
       return 0;
     }
-    depthBuffer = newBuffer;
-    depthBufferSize = depthSize;
+    logging->depthBuffer = newBuffer;
+    logging->depthBufferSize = depthSize;
   }
 
   // 색상 버퍼 할당/재할당
-  if(colorBuffer == NULL || colorBufferSize < colorSize){
-    char* newBuffer = (char*)realloc(colorBuffer, colorSize);
+  if(logging->colorBuffer == NULL || logging->colorBufferSize < colorSize){
+    char* newBuffer = (char*)realloc(logging->colorBuffer, colorSize);
     if(newBuffer == NULL){
       perror("Failed to allocate color buffer");
       return 0;
     }
-    colorBuffer = newBuffer;
-    colorBufferSize = colorSize;
+    logging->colorBuffer = newBuffer;
+    logging->colorBufferSize = colorSize;
   }
 
-  currentWidth = width;
-  currentHeight = height;
+  logging->currentWidth = width;
+  logging->currentHeight = height;
 
   return 1;
 }
 
-// 데이터 저장 함수
-static void saveFrameToFile(int frameId, uint32_t timestamp){
-  if(!recordFile) return;
+// 데이터 저장 함수 (level: 녹화 해상도의 프레임)
+static void saveFrameToFile(LoggingContext* logging, const FrameLevel* level, int frameId, uint32_t timestamp){
+  if(!logging->recordFile) return;
 
-  pthread_mutex_lock(&recordMutex);
+  pthread_mutex_lock(&logging->recordMutex);
 
   // 프레임 헤더 생성
   FrameHeader header;
   header.frameId = frameId;
   header.timestamp = timestamp;
   header.frameType = FRAME_TYPE_DEPTH_COLOR;
-  header.width = currentWidth;
-  header.height = currentHeight;
-  header.depthDataSize = currentWidth * currentHeight * sizeof(int16_t);
-  header.colorDataSize = currentWidth * currentHeight * 3 * sizeof(uint8_t);
+  header.width = level->width;
+  header.height = level->height;
+  header.depthDataSize = level->width * level->height * sizeof(int16_t);
+  header.colorDataSize = level->width * level->height * 3 * sizeof(uint8_t);
+  header.cameraId = (uint16_t)logging->currentCameraId;
   header.reserved = 0;
 
   // 헤더 쓰기
-  fwrite(&header, sizeof(FrameHeader), 1, recordFile);
+  fwrite(&header, sizeof(FrameHeader), 1, logging->recordFile);
 
   // 깊이 데이터 쓰기
-  fwrite(depthBuffer, header.depthDataSize, 1, recordFile);
+  fwrite(level->depth, header.depthDataSize, 1, logging->recordFile);
 
   // 색상 데이터 쓰기
-  fwrite(colorBuffer, header.colorDataSize, 1, recordFile);
+  fwrite(level->color, header.colorDataSize, 1, logging->recordFile);
 
   // 파일 버퍼 플러시
-  fflush(recordFile);
+  fflush(logging->recordFile);
+  monitorAdd(MONITOR_RECORDED_BYTES, sizeof(FrameHeader) + header.depthDataSize + header.colorDataSize);
+  monitorAdd(MONITOR_RECORDED_FRAMES, 1);
+
+  pthread_mutex_unlock(&logging->recordMutex);
+}
+
+// 제어 메세지 처리 (로거 스레드)
+static void handleControlMessage(LoggingContext* logging, const MessageHeader* header){
+  printf("Ctrl Command Receive: %d\n", header->ctrlCommand);
+
+  switch(header->ctrlCommand){
+    case CTRL_CMD_START_RECORD:
+      // 녹화 시작 명령 처리
+      if(!logging->isRecordingData){
+
+        pthread_mutex_lock(&logging->recordMutex);
+        strncpy(logging->currentRecordFilename, header->filename, sizeof(logging->currentRecordFilename) -1);
+        logging->currentRecordFilename[sizeof(logging->currentRecordFilename) - 1] = '\0';
+
+        logging->recordFile = fopen(logging->currentRecordFilename, "wb");
+        if(logging->recordFile){
+          logging->isRecordingData = 1;
+          logging->frameCounter = 0;
+          printf("Started recording to: %s\n", logging->currentRecordFilename);
+        }else{
+          perror("Failed to open record file");
+        }
+
+        pthread_mutex_unlock(&logging->recordMutex);
+      }
+      break;
+
+    case CTRL_CMD_STOP_RECORD:
+      // 녹화 중지 명령 처리
+      if(logging->isRecordingData){
+        pthread_mutex_lock(&logging->recordMutex);
+        logging->isRecordingData = 0;
+        if(logging->recordFile){
+          // 종료 마커 쓰기
+          FrameHeader endHeader = {0};
+          endHeader.frameType = FRAME_TYPE_END_OF_FILE;
+          fwrite(&endHeader, sizeof(FrameHeader), 1, logging->recordFile);
+
+          fclose(logging->recordFile);
+          logging->recordFile = NULL;
+          printf("Stopped recording. %u frames saved.\n", logging->frameCounter);
+        }
+        pthread_mutex_unlock(&logging->recordMutex);
+      }
+      break;
+
+    case CTRL_CMD_START_PLAYBACK:
+      printf("Receive Command\n");
+
+      // 플레이백 시작 명령 처리
+      pthread_mutex_lock(&logging->playbackMutex);
+      strncpy(logging->currentPlaybackFilename, header->filename, sizeof(logging->currentPlaybackFilename) - 1);
+      logging->currentPlaybackFilename[sizeof(logging->currentPlaybackFilename) - 1] = '\0';
+
+      // 패스스루 비활성화
+      logging->isPassThroughEnabled = 0;
+
+      // 플레이백 활성화
+      logging->isPlaybackActive = 1;
+
+      // 프레임 카운터 초기화
+      logging->playbackFrameCounter = 0;
+
+      printf("Starting playback from: %s\n", logging->currentPlaybackFilename);
+      pthread_mutex_unlock(&logging->playbackMutex);
+      break;
+
+    case CTRL_CMD_STOP_PLAYBACK:
+      // 플레이백 중지 명령 처리
+      pthread_mutex_lock(&logging->playbackMutex);
+
+      logging->isPlaybackActive = 0;
+      if(logging->playbackFile){
+        fclose(logging->playbackFile);
+        logging->playbackFile = NULL;
+      }
+
+      // 패스스루 다시 활성화
+      logging->isPassThroughEnabled = 1;
+
+      printf("Playback stopped\n");
+      pthread_mutex_unlock(&logging->playbackMutex);
+      break;
+  }
+}
+
+static void sendFrameLevel(mqd_t mqdes, const FrameLevel* level, int frameId, uint32_t timestamp, int cameraId);
+
+// 가장 작은 배율이 필요한 소비자까지 피라미드 단계 수
+static int pyramidLevels(int a, int b, int c){
+  int factor = a > b ? a : b;
+  if(c > factor) factor = c;
+  return decimationLevel(factor) + 1;
+}
+
+// 완성된 라이브 프레임을 소비자별 해상도로 녹화 / 뷰어 전달 / 콜백 (줄인 단계는 한 번만 계산)
+static void dispatchLiveFrame(LoggingContext* logging, int frameId, uint32_t timestamp){
+  const LoggingOptions* options = &logging->options;
+  const int recording = logging->isRecordingData;
+  const int forwarding = logging->isPassThroughEnabled && logging->mqToViewer != (mqd_t)-1 &&
+                         options->viewerDecimation > 1;
+  LoggerFrameCallback callback = logging->isPassThroughEnabled ? logging->frameCallback : NULL;
+  if(!recording && !forwarding && !callback){
+    return;
+  }
+
+  const int levels = pyramidLevels(recording ? options->recordDecimation : 1,
+                                   forwarding ? options->viewerDecimation : 1,
+                                   callback ? options->callbackDecimation : 1);
+  if(!buildFramePyramid(&logging->pyramid, (const uint16_t*)logging->depthBuffer, (const uint8_t*)logging->colorBuffer,
+                        logging->currentWidth, logging->currentHeight, NULL, levels)){
+    return;
+  }
 
-  pthread_mutex_unlock(&recordMutex);
+  if(recording){
+    saveFrameToFile(logging, framePyramidLevel(&logging->pyramid, options->recordDecimation), frameId, timestamp);
+    logging->frameCounter++;
+  }
+  if(forwarding){
+    sendFrameLevel(logging->mqToViewer, framePyramidLevel(&logging->pyramid, options->viewerDecimation), frameId,
+                   timestamp, logging->currentCameraId);
+  }
+  if(callback){
+    const FrameLevel* level = framePyramidLevel(&logging->pyramid, options->callbackDecimation);
+    callback((const int16_t*)level->depth, level->color, level->width, level->height, frameId, timestamp,
+             logging->currentCameraId, logging->frameCallbackUser);
+  }
 }
 
 // 로거 스레드 함수
 static void* loggerThread(void* arg){
+  LoggingContext* logging = (LoggingContext*)arg;
   printf("Logger thread started...\n");
 
-  // 메세지 큐 속성 설정
-  struct mq_attr attr;
-  attr.mq_flags = 0;
-  attr.mq_maxmsg = 10;
-  attr.mq_msgsize = MAX_MSG_SIZE;
-  attr.mq_curmsgs = 0;
-
   // 센서로부터 데이터를 받는 메세지 큐 열기
-  mqFromSensor = mq_open(MQ_SENSOR_TO_LOGGER, O_RDONLY, 0644, &attr);
-  if(mqFromSensor == (mqd_t) - 1){
-    perror("mq_open from sensor");
-    return NULL;
+  if(logging->options.sensorInput){
+    logging->mqFromSensor = mq_open(logging->queues.sensorToLogger, O_RDONLY);
+    if(logging->mqFromSensor == (mqd_t) - 1){
+      perror("mq_open from sensor");
+      return NULL;
+    }
   }
 
-  // 뷰어로 데이터를 보내는 메세지 큐 열기
-  mqToViewer = mq_open(MQ_LOGGER_TO_VIEWER, O_WRONLY, 0644, &attr);
-  if(mqToViewer == (mqd_t)-1){
-    perror("mq_open to viewer");
-    mq_close(mqFromSensor);
-    return NULL;
+  // 뷰어로 데이터를 보내는 메세지 큐 열기 (센서 프레임 패스스루)
+  if(logging->options.sensorInput && logging->options.forwardToViewer){
+    logging->mqToViewer = mq_open(logging->queues.loggerToViewer, O_WRONLY);
+    if(logging->mqToViewer == (mqd_t)-1){
+      perror("mq_open to viewer");
+      mq_close(logging->mqFromSensor);
+      return NULL;
+    }
   }
 
-  // 제어 메세지 큐 열기
-  mqControl = mq_open(MQ_CONTROL_QUEUE, O_RDONLY | O_NONBLOCK, 0644, &attr);
-  if(mqControl == (mqd_t) - 1){
+  // 제어 메세지 큐 열기 (센서 입력이 없으면 제어 큐에서 대기)
+  logging->mqControl = mq_open(logging->queues.control, logging->options.sensorInput ? O_RDONLY | O_NONBLOCK : O_RDONLY);
+  if(logging->mqControl == (mqd_t) - 1){
     perror("mq_open control");
-    mq_close(mqFromSensor);
-    mq_close(mqToViewer);
+    if(logging->mqFromSensor != (mqd_t)-1) mq_close(logging->mqFromSensor);
+    if(logging->mqToViewer != (mqd_t)-1) mq_close(logging->mqToViewer);
     return NULL;
   }
 
@@ -168,122 +382,49 @@ static void* loggerThread(void* arg){
   char* msgBuffer = (char*)malloc(MAX_MSG_SIZE);
   if(!msgBuffer){
     perror("malloc message buffer");
-    mq_close(mqFromSensor);
-    mq_close(mqToViewer);
-    mq_close(mqControl);
+    if(logging->mqFromSensor != (mqd_t)-1) mq_close(logging->mqFromSensor);
+    if(logging->mqToViewer != (mqd_t)-1) mq_close(logging->mqToViewer);
+    mq_close(logging->mqControl);
     return NULL;
   }
 
   // 깊이 및 색상 데이터 버퍼 초기화
-  depthBuffer = NULL;
-  colorBuffer = NULL;
-  depthBufferSize = 0;
-  colorBufferSize = 0;
-
-  // 메인 루프
-  while(loggingIsRunning){
-    // 제어 메세지 확인(non-blocking)
-    ssize_t ctrlBytes = mq_receive(mqControl, msgBuffer, MAX_MSG_SIZE, NULL);
-    // printf("ctrlBytes : %d\n", ctrlBytes);
+  logging->depthBuffer = NULL;
+  logging->colorBuffer = NULL;
+  logging->depthBufferSize = 0;
+  logging->colorBufferSize = 0;
+
+  // 메인 루프 (CPU 사용률 측정은 큐를 모두 연 뒤부터)
+  monitorRegisterThread(MONITOR_THREAD_LOGGER);
+  while(logging->running){
+    // 제어 메세지 확인 (센서 입력이 있으면 non-blocking, 없으면 100ms 대기)
+    ssize_t ctrlBytes = logging->mqFromSensor != (mqd_t)-1 ? mq_receive(logging->mqControl, msgBuffer, MAX_MSG_SIZE, NULL)
+                                                            : receiveWithTimeout(logging->mqControl, msgBuffer, 100);
     if(ctrlBytes > 0){
-      // printf("testsets\n");
       MessageHeader* header = (MessageHeader*)msgBuffer;
 
       if(header->msgType == MSG_TYPE_CONTROL){
-        printf("Ctrl Command Receive: %d\n", header->ctrlCommand);
-
-        switch(header->ctrlCommand){
-          case CTRL_CMD_START_RECORD:
-            // 녹화 시작 명령 처리
-            if(!isRecordingData){
-
-              pthread_mutex_lock(&recordMutex);
-              strncpy(currentRecordFilename, header->filename, sizeof(currentRecordFilename) -1);
-              currentRecordFilename[sizeof(currentRecordFilename) - 1] = '\0';
-
-              recordFile = fopen(currentRecordFilename, "wb");
-              if(recordFile){
-                isRecordingData = 1;
-                frameCounter = 0;
-                printf("Started recording to: %s\n", currentRecordFilename);
-              }else{
-                perror("Failed to open record file");
-              }
-
-              pthread_mutex_unlock(&recordMutex);
-            }
-            break;
-
-          case CTRL_CMD_STOP_RECORD:
-            // 녹화 중지 명령 처리
-            if(isRecordingData){
-              pthread_mutex_lock(&recordMutex);
-              isRecordingData = 0;
-              if(recordFile){
-                // 종료 마커 쓰기
-                FrameHeader endHeader = {0};
-                endHeader.frameType = FRAME_TYPE_END_OF_FILE;
-                fwrite(&endHeader, sizeof(FrameHeader), 1, recordFile);
-
-                fclose(recordFile);
-                recordFile = NULL;
-                printf("Stopped recording. %u frames saved.\n", frameCounter);
-              }
-              pthread_mutex_unlock(&recordMutex);
-            }
-            break;
-
-          case CTRL_CMD_START_PLAYBACK:
-            printf("Receive Command\n");
-
-            // 플레이백 시작 명령 처리
-            pthread_mutex_lock(&playbackMutex);
-            strncpy(currentPlaybackFilename, header->filename, sizeof(currentPlaybackFilename) - 1);
-            currentPlaybackFilename[sizeof(currentPlaybackFilename) - 1] = '\0';
-
-            // 패스스루 비활성화
-            isPassThroughEnabled = 0;
-
-            // 플레이백 활성화
-            isPlaybackActive = 1;
-
-            // 프레임 카운터 초기화
-            playbackFrameCounter = 0;
-
-            printf("Starting playback from: %s\n", currentPlaybackFilename);
-            pthread_mutex_unlock(&playbackMutex);
-            break;
-
-          case CTRL_CMD_STOP_PLAYBACK:
-            // 플레이백 중지 명령 처리
-            pthread_mutex_lock(&playbackMutex);
-
-            isPlaybackActive = 0;
-            if(playbackFile){
-              fclose(playbackFile);
-              playbackFile = NULL;
-            }
-
-            // 패스스루 다시 활성화
-            isPassThroughEnabled = 1;
-
-            printf("Playback stopped\n");
-            pthread_mutex_unlock(&playbackMutex);
-            break;
-        }
+        handleControlMessage(logging, header);
       }
     }
 
-    // 센서 데이터 수신 (blocking)
-    ssize_t bytesRead = mq_receive(mqFromSensor, msgBuffer, MAX_MSG_SIZE, NULL);
+    if(logging->mqFromSensor == (mqd_t)-1){
+      continue;
+    }
+
+    // 센서 데이터 수신 (센서가 멈춰도 종료할 수 있도록 100ms 제한)
+    ssize_t bytesRead = receiveWithTimeout(logging->mqFromSensor, msgBuffer, 100);
 
     if(bytesRead > 0){
       MessageHeader* header = (MessageHeader*)msgBuffer;
 
-      // 뷰어로 데이터 직접 전달 (패스스루)
-      if(isPassThroughEnabled){
-        if(mq_send(mqToViewer, msgBuffer, bytesRead, 0) == -1){
+      // 뷰어로 데이터 직접 전달 (패스스루, 뷰어가 원본 해상도를 구독할 때)
+      if(logging->isPassThroughEnabled && logging->mqToViewer != (mqd_t)-1 && logging->options.viewerDecimation == 1){
+        if(mq_send(logging->mqToViewer, msgBuffer, bytesRead, 0) == -1){
           perror("mq_send to viewer");
+          monitorAdd(MONITOR_LOGGER_DROPPED, 1);
+        }else if(header->msgType != MSG_TYPE_METADATA){
+          monitorAdd(MONITOR_VIEWER_BYTES, bytesRead - sizeof(MessageHeader));
         }
       }
 
@@ -291,13 +432,14 @@ static void* loggerThread(void* arg){
       switch(header->msgType){
         case MSG_TYPE_METADATA:
           // 메타데이터 메세지 처리
-          if(!reallocateBuffers(header->width, header->height)){
+          if(!reallocateBuffers(logging, header->width, header->height)){
             continue;
           }
 
           // 프레임 수신 상태 초기화
-          receivedDepthFrame = 0;
-          receivedColorFrame = 0;
+          logging->currentCameraId = header->cameraId;
+          logging->receivedDepthFrame = 0;
+          logging->receivedColorFrame = 0;
           break;
 
         case MSG_TYPE_DEPTH_DATA:
@@ -305,23 +447,21 @@ static void* loggerThread(void* arg){
           if(header->chunkIndex == 0){
 
             // 새 프레임 시작
-            receivedDepthFrame = 0;
+            logging->receivedDepthFrame = 0;
           }
 
-          if(depthBuffer){
+          if(logging->depthBuffer){
             // 데이터 복사
             int offset = header->chunkIndex * (MAX_MSG_SIZE - sizeof(MessageHeader));
             int copySize = header->dataSize;
 
-            // printf("width : %d, height : %d\n", header->width, header->height);
-
-            if(offset + copySize <= depthBufferSize){
-              memcpy(depthBuffer + offset, msgBuffer + sizeof(MessageHeader), copySize);
+            if(offset + copySize <= logging->depthBufferSize){
+              memcpy(logging->depthBuffer + offset, msgBuffer + sizeof(MessageHeader), copySize);
             }
 
             // 마지막 청크 확인
             if(header->chunkIndex == header->totalChunks - 1){
-              receivedDepthFrame = 1;
+              logging->receivedDepthFrame = 1;
             }
           }
           break;
@@ -330,30 +470,29 @@ static void* loggerThread(void* arg){
           // 색상 데이터 청크 처리
           if(header->chunkIndex == 0){
             // 새 프레임 시작
-            receivedColorFrame = 0;
+            logging->receivedColorFrame = 0;
           }
 
-          if(colorBuffer){
+          if(logging->colorBuffer){
             // 데이터 복사
             int offset = header->chunkIndex * (MAX_MSG_SIZE - sizeof(MessageHeader));
             int copySize = header->dataSize;
 
-            if(offset + copySize <= colorBufferSize){
-              memcpy(colorBuffer + offset, msgBuffer + sizeof(MessageHeader), copySize);
+            if(offset + copySize <= logging->colorBufferSize){
+              memcpy(logging->colorBuffer + offset, msgBuffer + sizeof(MessageHeader), copySize);
             }
 
             // 마지막 청크 확인
             if(header->chunkIndex == header->totalChunks - 1){
-               receivedColorFrame = 1;
+               logging->receivedColorFrame = 1;
             } 
           }
           break;
       }
 
-      // 깊이 및 색상 데이터가 모두 수신되면 프레임 저장 (녹화 모드인 경우)
-      if(receivedDepthFrame && receivedColorFrame && isRecordingData){
-        saveFrameToFile(header->frameId, header->timestamp);
-        frameCounter++;
+      // 깊이 및 색상 데이터가 모두 수신되면 (색상 마지막 청크에서 한 번) 녹화 / 줄인 뷰어 전달 / 구독자 전달
+      if(logging->receivedDepthFrame && logging->receivedColorFrame && header->msgType == MSG_TYPE_COLOR_DATA){
+        dispatchLiveFrame(logging, header->frameId, header->timestamp);
       }
     }
   }
@@ -361,40 +500,45 @@ static void* loggerThread(void* arg){
   // 정리
   free(msgBuffer);
 
-  if(depthBuffer){
-    free(depthBuffer);
-    depthBuffer = NULL;
+  if(logging->depthBuffer){
+    free(logging->depthBuffer);
+    logging->depthBuffer = NULL;
   }
 
-  if(colorBuffer){
-    free(colorBuffer);
-    colorBuffer = NULL;
+  if(logging->colorBuffer){
+    free(logging->colorBuffer);
+    logging->colorBuffer = NULL;
   }
+  freeFramePyramid(&logging->pyramid);
 
   // 메세지 큐 닫기
-  if(mqFromSensor != (mqd_t)-1){
-    mq_close(mqFromSensor);
+  if(logging->mqFromSensor != (mqd_t)-1){
+    mq_close(logging->mqFromSensor);
+    logging->mqFromSensor = (mqd_t)-1;
   }
 
-  if(mqToViewer != (mqd_t) - 1){
-    mq_close(mqToViewer);
+  if(logging->mqToViewer != (mqd_t) - 1){
+    mq_close(logging->mqToViewer);
+    logging->mqToViewer = (mqd_t)-1;
   }
 
-  if(mqControl != (mqd_t) - 1){
-    mq_close(mqControl);
+  if(logging->mqControl != (mqd_t) - 1){
+    mq_close(logging->mqControl);
+    logging->mqControl = (mqd_t)-1;
   }
 
   // 녹화 중이었다면 파일 닫기
-  pthread_mutex_lock(&recordMutex);
+  pthread_mutex_lock(&logging->recordMutex);
 
-  if(recordFile){
-    fclose(recordFile);
-    recordFile = NULL;
-    isRecordingData = 0;
+  if(logging->recordFile){
+    fclose(logging->recordFile);
+    logging->recordFile = NULL;
+    logging->isRecordingData = 0;
   }
 
-  pthread_mutex_unlock(&recordMutex);
+  pthread_mutex_unlock(&logging->recordMutex);
 
+  monitorUnregisterThread(MONITOR_THREAD_LOGGER);
   printf("Logger thread termninated\n");
 
   return NULL;
@@ -442,9 +586,8 @@ static int readFrameFromFile(FILE* file, FrameHeader* header, char* depthData, c
 
   return 1;
 }
-
 // 청크로 나누어 데이터 전송
-static void sendDataInChunks(mqd_t mqdes, int msgType, int frameId, uint32_t timestamp, int width, int height, const char* data, int dataSize){
+static void sendDataInChunks(mqd_t mqdes, int msgType, int frameId, uint32_t timestamp, int cameraId, int width, int height, const char* data, int dataSize){
 
   char* msgBuffer = (char*)malloc(MAX_MSG_SIZE);
   if(!msgBuffer){
@@ -464,6 +607,7 @@ static void sendDataInChunks(mqd_t mqdes, int msgType, int frameId, uint32_t tim
     header->totalChunks = totalChunks;
     header->frameId = frameId;
     header->timestamp = timestamp;
+    header->cameraId = cameraId;
 
     int offset = i * maxDataPerMsg;
     int chunkSize = (i == totalChunks - 1) ? (dataSize - offset) : maxDataPerMsg;
@@ -485,7 +629,7 @@ static void sendDataInChunks(mqd_t mqdes, int msgType, int frameId, uint32_t tim
 }
 
 // 메타 데이터 전송
-static void sendMetadata(mqd_t mqdes, int frameId, uint32_t timestamp, int width, int height){
+static void sendMetadata(mqd_t mqdes, int frameId, uint32_t timestamp, int cameraId, int width, int height){
   MessageHeader header;
   header.msgType = MSG_TYPE_METADATA;
   header.width = width;
@@ -495,33 +639,40 @@ static void sendMetadata(mqd_t mqdes, int frameId, uint32_t timestamp, int width
   header.dataSize = 0;
   header.frameId = frameId;
   header.timestamp = timestamp;
+  header.cameraId = cameraId;
 
   if(mq_send(mqdes, (char*)&header, sizeof(MessageHeader), 0) == -1){
     perror("mq_send metadata");
   }
 }
 
+// 프레임 하나 (메타데이터, 깊이 청크, 색상 청크) 를 주어진 해상도로 전송
+static void sendFrameLevel(mqd_t mqdes, const FrameLevel* level, int frameId, uint32_t timestamp, int cameraId){
+  const int depthDataSize = level->width * level->height * sizeof(int16_t);
+  const int colorDataSize = level->width * level->height * 3 * sizeof(uint8_t);
+  sendMetadata(mqdes, frameId, timestamp, cameraId, level->width, level->height);
+  sendDataInChunks(mqdes, MSG_TYPE_DEPTH_DATA, frameId, timestamp, cameraId, level->width, level->height,
+                   (const char*)level->depth, depthDataSize);
+  sendDataInChunks(mqdes, MSG_TYPE_COLOR_DATA, frameId, timestamp, cameraId, level->width, level->height,
+                   (const char*)level->color, colorDataSize);
+  monitorAdd(MONITOR_VIEWER_BYTES, depthDataSize + colorDataSize);
+}
+
 // 재생 스레드 함수
 static void* playbackThread(void* arg){
+  LoggingContext* logging = (LoggingContext*)arg;
   printf("Playback thread started...\n");
 
-  // 메세지 큐 속성 설정
-  struct mq_attr attr;
-  attr.mq_flags = 0;
-  attr.mq_maxmsg = 10;
-  attr.mq_msgsize = MAX_MSG_SIZE;
-  attr.mq_curmsgs = 0;
-
   // 뷰어로 데이터를 보내는 메세지 큐 열기
-  mqd_t mqPlaybackToViewer = mq_open(MQ_LOGGER_TO_VIEWER, O_WRONLY, 0644, &attr);
-  if(mqPlaybackToViewer == (mqd_t) - 1){
-    perror("mq_open playback to viewer");
-    return NULL;
+  mqd_t mqPlaybackToViewer = (mqd_t)-1;
+  if(logging->options.forwardToViewer){
+    mqPlaybackToViewer = mq_open(logging->queues.loggerToViewer, O_WRONLY);
+    if(mqPlaybackToViewer == (mqd_t) - 1){
+      perror("mq_open playback to viewer");
+      return NULL;
+    }
   }
 
-  // 제어 메세지를 위한 임시 버퍼
-  char controlBuffer[MAX_MSG_SIZE];
-
   // 데이터 버퍼
   char* playbackDepthBuffer = NULL;
   char* playbackColorBuffer = NULL;
@@ -535,214 +686,290 @@ static void* playbackThread(void* arg){
     perror("malloc playback buffers");
     free(playbackDepthBuffer);
     free(playbackColorBuffer);
-    mq_close(mqPlaybackToViewer);
+    if(mqPlaybackToViewer != (mqd_t)-1) mq_close(mqPlaybackToViewer);
     return NULL;
   }
 
-  while(loggingIsRunning){
+  // 프레임 간격 (playbackFps 가 0 이면 대기 없음)
+  const int frameIntervalUs = logging->options.playbackFps > 0 ? 1000000 / logging->options.playbackFps : 0;
+
+  monitorRegisterThread(MONITOR_THREAD_PLAYBACK);
+  while(logging->running){
     // 플레이백 모드가 아니면 대기
-    if(!isPlaybackActive){
-      // printf("Playback is Not Activated!\n");
+    if(!logging->isPlaybackActive){
       usleep(100000); // 100ms 대기
       continue;
     }
 
-    pthread_mutex_lock(&playbackMutex);
+    pthread_mutex_lock(&logging->playbackMutex);
 
     // 파일 열기
-    if(!playbackFile){
-      playbackFile = fopen(currentPlaybackFilename, "rb");
-      if(!playbackFile){
+    if(!logging->playbackFile){
+      logging->playbackFile = fopen(logging->currentPlaybackFilename, "rb");
+      if(!logging->playbackFile){
         perror("Failed to open playback file");
-        isPlaybackActive = 0;
-        pthread_mutex_unlock(&playbackMutex);
+        logging->isPlaybackActive = 0;
+        pthread_mutex_unlock(&logging->playbackMutex);
         continue;
       }
 
-      printf("Started playback from: %s\n", currentPlaybackFilename);
+      printf("Started playback from: %s\n", logging->currentPlaybackFilename);
     }
 
     // 프레임 읽기
     FrameHeader header;
-    if(!readFrameFromFile(playbackFile, &header, playbackDepthBuffer, playbackColorBuffer, maxBufferSize)){
+    if(!readFrameFromFile(logging->playbackFile, &header, playbackDepthBuffer, playbackColorBuffer, maxBufferSize)){
       // 파일 끝이거나 오류 발생
-      fclose(playbackFile);
-      playbackFile = NULL;
-      isPlaybackActive = 0;
-      printf("Playback completed or error occurred. Total frames played: %u\n", playbackFrameCounter);
-      pthread_mutex_unlock(&playbackMutex);
+      fclose(logging->playbackFile);
+      logging->playbackFile = NULL;
+      logging->isPlaybackActive = 0;
+      printf("Playback completed or error occurred. Total frames played: %u\n", logging->playbackFrameCounter);
+      pthread_mutex_unlock(&logging->playbackMutex);
       continue;
     }
 
-    // 프레임 카운터 증가 및 출력
-    playbackFrameCounter++;
-    printf("Playing frame #%u (ID: %u, timestamp: %u)\n", playbackFrameCounter, header.frameId, header.timestamp);
+    // 프레임 카운터 증가 및 출력 (최대 속도 재생에서는 출력 생략)
+    logging->playbackFrameCounter++;
+    if(frameIntervalUs > 0){
+      printf("Playing frame #%u (ID: %u, timestamp: %u)\n", logging->playbackFrameCounter, header.frameId, header.timestamp);
+    }
 
-    pthread_mutex_unlock(&playbackMutex);
+    pthread_mutex_unlock(&logging->playbackMutex);
 
-    // 메타데이터 전송
-    sendMetadata(mqPlaybackToViewer, header.frameId, header.timestamp, header.width, header.height);
+    // 뷰어 / 구독자 해상도 (줄인 단계는 한 번만 계산, 원본이면 복사 없이 재생 버퍼 그대로)
+    LoggerFrameCallback callback = logging->frameCallback;
+    const int levels = pyramidLevels(mqPlaybackToViewer != (mqd_t)-1 ? logging->options.viewerDecimation : 1,
+                                     callback ? logging->options.callbackDecimation : 1, 1);
+    if(!buildFramePyramid(&logging->playbackPyramid, (const uint16_t*)playbackDepthBuffer,
+                          (const uint8_t*)playbackColorBuffer, header.width, header.height, NULL, levels)){
+      continue;
+    }
 
-    // 깊이 데이터 전송
-    sendDataInChunks(mqPlaybackToViewer, MSG_TYPE_DEPTH_DATA, header.frameId, header.timestamp, header.width, header.height, playbackDepthBuffer, header.depthDataSize);
+    if(mqPlaybackToViewer != (mqd_t)-1){
+      // 메타데이터, 깊이, 색상 데이터 전송
+      const FrameLevel* level = framePyramidLevel(&logging->playbackPyramid, logging->options.viewerDecimation);
+      sendFrameLevel(mqPlaybackToViewer, level, header.frameId, header.timestamp, header.cameraId);
+    }
 
-    // 색상 데이터 전송
-    sendDataInChunks(mqPlaybackToViewer, MSG_TYPE_COLOR_DATA, header.frameId, header.timestamp, header.width, header.height, playbackColorBuffer, header.colorDataSize);
+    // 구독자에게 재생 프레임 전달
+    if(callback){
+      const FrameLevel* level = framePyramidLevel(&logging->playbackPyramid, logging->options.callbackDecimation);
+      callback((const int16_t*)level->depth, level->color, level->width, level->height, header.frameId,
+               header.timestamp, header.cameraId, logging->frameCallbackUser);
+    }
 
-    // 프레임 레이트 조절 (30fps, 약 33ms)
-    usleep(33333);
+    // 프레임 레이트 조절 (기본 30fps, 약 33ms)
+    if(frameIntervalUs > 0){
+      usleep(frameIntervalUs);
+    }
   }
 
   // 정리
   free(playbackDepthBuffer);
   free(playbackColorBuffer);
+  freeFramePyramid(&logging->playbackPyramid);
 
-  mq_close(mqPlaybackToViewer);
+  if(mqPlaybackToViewer != (mqd_t)-1){
+    mq_close(mqPlaybackToViewer);
+  }
 
-  pthread_mutex_lock(&playbackMutex);
-  if(playbackFile){
-    fclose(playbackFile);
-    playbackFile = NULL;
+  pthread_mutex_lock(&logging->playbackMutex);
+  if(logging->playbackFile){
+    fclose(logging->playbackFile);
+    logging->playbackFile = NULL;
 
   }
-  isPlaybackActive = 0;
-  pthread_mutex_unlock(&playbackMutex);
+  logging->isPlaybackActive = 0;
+  pthread_mutex_unlock(&logging->playbackMutex);
 
+  monitorUnregisterThread(MONITOR_THREAD_PLAYBACK);
   printf("Playback thread terminated\n");
   return NULL;
 }
 
-// 초기화 함수
-void initLoggingModule(){
-  printf("Initializing logging module...\n");
-
-  // 메세지 큐 생성/열기 (다른 모듈에서 사용할 수 있도록)
+// 메세지 큐 생성 (이미 있으면 그대로 사용)
+static int createQueue(const char* name, long msgsize){
   struct mq_attr attr;
   attr.mq_flags = 0;
   attr.mq_maxmsg = 10;
-  attr.mq_msgsize = MAX_MSG_SIZE;
+  attr.mq_msgsize = msgsize;
   attr.mq_curmsgs = 0;
 
-  /*
-   * Generate Message Queues.
-   */
-  
-  // 센서->로거 큐 생성
-  mqd_t mqTemp = mq_open(MQ_SENSOR_TO_LOGGER, O_CREAT, 0644, &attr);
-  if(mqTemp != (mqd_t) - 1){
-    mq_close(mqTemp);
+  mqd_t mqTemp = mq_open(name, O_CREAT, 0644, &attr);
+  if(mqTemp == (mqd_t) - 1){
+    perror(name);
+    return 0;
+  }
+  mq_close(mqTemp);
+  return 1;
+}
+
+LoggingContext* createLoggingContext(const LoggingOptions* options){
+  LoggingOptions defaults;
+  if(!options){
+    setDefaultLoggingOptions(&defaults);
+    options = &defaults;
+  }
+
+  LoggingContext* logging = (LoggingContext*)malloc(sizeof(LoggingContext));
+  if(!logging){
+    perror("malloc logging context");
+    return NULL;
+  }
+  initLoggingContext(logging, options);
+  return logging;
+}
+
+// 정지 후 해제, 이 컨텍스트가 만든 큐도 제거
+void destroyLoggingContext(LoggingContext* logging){
+  if(!logging || logging == &defaultLogging){
+    return;
+  }
+  loggingStop(logging);
+
+  if(logging->options.sensorInput){
+    mq_unlink(logging->queues.sensorToLogger);
   }
+  if(logging->options.forwardToViewer){
+    mq_unlink(logging->queues.loggerToViewer);
+  }
+  mq_unlink(logging->queues.control);
 
-  // 로거->뷰어 큐 생성
-  mqTemp = mq_open(MQ_LOGGER_TO_VIEWER, O_CREAT, 0644, &attr);
-  if(mqTemp != (mqd_t) - 1){
+  pthread_mutex_destroy(&logging->recordMutex);
+  pthread_mutex_destroy(&logging->playbackMutex);
+  free(logging);
+}
 
-    mq_close(mqTemp);
+// 초기화 함수
+int loggingStart(LoggingContext* logging){
+  if(logging->threadsStarted){
+    return 1;
   }
 
-  // 제어 큐 생성
-  mqTemp = mq_open(MQ_CONTROL_QUEUE, O_CREAT, 0644, &attr);
-  if(mqTemp != (mqd_t) - 1){
-    mq_close(mqTemp);
+  /*
+   * Generate Message Queues (다른 모듈에서 사용할 수 있도록, 필요한 큐만)
+   * 제어 큐는 헤더만 오가므로 메세지 크기를 헤더로 줄여 파이프라인이 많아도 RLIMIT_MSGQUEUE 를 넘지 않게 함
+   */
+  if((logging->options.sensorInput && !createQueue(logging->queues.sensorToLogger, MAX_MSG_SIZE)) ||
+     (logging->options.forwardToViewer && !createQueue(logging->queues.loggerToViewer, MAX_MSG_SIZE)) ||
+     !createQueue(logging->queues.control, sizeof(MessageHeader))){
+    return 0;
   }
 
   // 변수 초기화
-  loggingIsRunning = 1;
-  isRecordingData = 0;
-  isPlaybackActive = 0;
-  recordFile = NULL;
-  playbackFile = NULL;
-  currentRecordFilename[0] = '\0';
-  currentPlaybackFilename[0] = '\0';
+  logging->running = 1;
+  logging->isRecordingData = 0;
+  logging->isPlaybackActive = 0;
+  logging->isPassThroughEnabled = 1;
+  logging->recordFile = NULL;
+  logging->playbackFile = NULL;
+  logging->currentRecordFilename[0] = '\0';
+  logging->currentPlaybackFilename[0] = '\0';
 
   // 로거 스레드 시작
-  pthread_create(&logger_thread_id, NULL, loggerThread, NULL);
+  if(pthread_create(&logging->loggerThreadId, NULL, loggerThread, logging) != 0){
+    perror("Failed to create logger thread");
+    logging->running = 0;
+    return 0;
+  }
 
   // 재생 스레드 시작
-  pthread_create(&playback_thread_id, NULL, playbackThread, NULL);
+  if(pthread_create(&logging->playbackThreadId, NULL, playbackThread, logging) != 0){
+    perror("Failed to create playback thread");
+    logging->running = 0;
+    pthread_join(logging->loggerThreadId, NULL);
+    return 0;
+  }
 
-  printf("Logging module initialized\n");
+  logging->threadsStarted = 1;
+  return 1;
 }
 
 // 종료 함수
-void stopLoggingModule(){
-  printf("Stopping logging module...\n");
+void loggingStop(LoggingContext* logging){
+  if(!logging->threadsStarted){
+    return;
+  }
 
   // 스레드 종료 플레그 설정
-  loggingIsRunning = 0;
+  logging->running = 0;
 
   // 녹화 중지
-  stopRecording();
+  loggingStopRecording(logging);
 
   // 재생 중지
-  stopPlayback();
+  loggingStopPlayback(logging);
 
   // 스레드 종료 대기
   printf("Waiting for logger thread to terminate...\n");
-  pthread_join(logger_thread_id, NULL);
+  pthread_join(logging->loggerThreadId, NULL);
 
   printf("Waiting for playback thread to terminate...\n");
-  pthread_join(playback_thread_id, NULL);
+  pthread_join(logging->playbackThreadId, NULL);
 
-  printf("Logging module stopped\n");
+  logging->threadsStarted = 0;
+}
+
+int loggingIsRunning(LoggingContext* logging){
+  return logging->running;
 }
 
 // 녹화 시작 함수
-int startRecording(const char* filename){
-  if(isRecordingData){
-    printf("Already recording to: %s\n", currentRecordFilename);
+int loggingStartRecording(LoggingContext* logging, const char* filename){
+  if(logging->isRecordingData){
+    printf("Already recording to: %s\n", logging->currentRecordFilename);
     return 0;
   }
 
   // 제어 명령 전송
-  sendControlCommand(CTRL_CMD_START_RECORD, filename);
+  loggingSendControlCommand(logging, CTRL_CMD_START_RECORD, filename);
   return 1;
 }
 
 // 녹화 중지 함수
-void stopRecording(){
-  if(!isRecordingData){
-    sendControlCommand(CTRL_CMD_STOP_RECORD, NULL);
+void loggingStopRecording(LoggingContext* logging){
+  if(!logging->isRecordingData){
+    loggingSendControlCommand(logging, CTRL_CMD_STOP_RECORD, NULL);
   }
 }
 
 // 재생 시작 함수
-int startPlayback(const char* filename){
-  if(isPlaybackActive){
-    printf("Already playing: %s\n", currentPlaybackFilename);
+int loggingStartPlayback(LoggingContext* logging, const char* filename){
+  if(logging->isPlaybackActive){
+    printf("Already playing: %s\n", logging->currentPlaybackFilename);
     return 0;
   }
 
   // 제어 명령 전송
-  sendControlCommand(CTRL_CMD_START_PLAYBACK, filename);
+  loggingSendControlCommand(logging, CTRL_CMD_START_PLAYBACK, filename);
   return 1;
 }
 
 // 재생 중지 함수
-void stopPlayback(){
-  if(isPlaybackActive){
-    sendControlCommand(CTRL_CMD_STOP_PLAYBACK, NULL);
+void loggingStopPlayback(LoggingContext* logging){
+  if(logging->isPlaybackActive){
+    loggingSendControlCommand(logging, CTRL_CMD_STOP_PLAYBACK, NULL);
   }
 }
 
 // 녹화 상태 확인
-int isRecording(){
-  return isRecordingData;
+int loggingIsRecording(LoggingContext* logging){
+  return logging->isRecordingData;
 }
 
 // 재생 상태 확인
-int isPlayingBack(){
-  return isPlaybackActive;
+int loggingIsPlayingBack(LoggingContext* logging){
+  return logging->isPlaybackActive;
 }
 
-int isLoggingModuleRunning(void){
-  return loggingIsRunning;
+uint32_t loggingPlaybackFrames(LoggingContext* logging){
+  return logging->playbackFrameCounter;
 }
 
 // 제어 명령 전송 함수
-void sendControlCommand(int command, const char* filename){
+void loggingSendControlCommand(LoggingContext* logging, int command, const char* filename){
   // 메세지 큐 열기
-  mqd_t mqCtrl = mq_open(MQ_CONTROL_QUEUE, O_WRONLY, 0644, NULL);
+  mqd_t mqCtrl = mq_open(logging->queues.control, O_WRONLY, 0644, NULL);
   if(mqCtrl == (mqd_t) - 1){
     perror("mq_open control for command");
     return;
@@ -768,3 +995,70 @@ void sendControlCommand(int command, const char* filename){
   // 메세지 큐 닫기
   mq_close(mqCtrl);
 }
+
+// 완성된 프레임 콜백 등록
+void loggingSetFrameCallback(LoggingContext* logging, LoggerFrameCallback callback, void* user_data){
+  logging->frameCallbackUser = user_data;
+  logging->frameCallback = callback;
+}
+
+// ---------------------------------------------------------------------------
+// 기본 컨텍스트
+
+void setLoggingModuleOptions(const LoggingOptions* options){
+  LoggingContext* logging = defaultLoggingContext();
+  if(logging->threadsStarted){
+    printf("Logging module is already running, options ignored\n");
+    return;
+  }
+  applyLoggingOptions(logging, options);
+}
+
+void initLoggingModule(){
+  printf("Initializing logging module...\n");
+  if(loggingStart(defaultLoggingContext())){
+    printf("Logging module initialized\n");
+  }
+}
+
+void stopLoggingModule(){
+  printf("Stopping logging module...\n");
+  loggingStop(defaultLoggingContext());
+  printf("Logging module stopped\n");
+}
+
+int startRecording(const char* filename){
+  return loggingStartRecording(defaultLoggingContext(), filename);
+}
+
+void stopRecording(){
+  loggingStopRecording(defaultLoggingContext());
+}
+
+int startPlayback(const char* filename){
+  return loggingStartPlayback(defaultLoggingContext(), filename);
+}
+
+void stopPlayback(){
+  loggingStopPlayback(defaultLoggingContext());
+}
+
+int isRecording(){
+  return loggingIsRecording(defaultLoggingContext());
+}
+
+int isPlayingBack(){
+  return loggingIsPlayingBack(defaultLoggingContext());
+}
+
+int isLoggingModuleRunning(void){
+  return loggingIsRunning(defaultLoggingContext());
+}
+
+void sendControlCommand(int command, const char* filename){
+  loggingSendControlCommand(defaultLoggingContext(), command, filename);
+}
+
+void setLoggerFrameCallback(LoggerFrameCallback callback, void* user_data){
+  loggingSetFrameCallback(defaultLoggingContext(), callback, user_data);
+}
@@ -1,10 +1,63 @@
 #ifndef LOGGING_MODULE_H
 #define LOGGING_MODULE_h
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// Complete frame callback (called from the logger thread for live frames and from the playback thread)
+// depth: 16-bit depth, color: RGB 3 bytes per pixel, both valid only during the call
+// camera_id: camera of the frame (several cameras share a frame_id per synchronized set, 0 for a single camera)
+typedef void (*LoggerFrameCallback)(const int16_t* depth, const uint8_t* color, int width, int height,
+                                    uint32_t frame_id, uint32_t timestamp, int camera_id, void* user_data);
+
+// Logging context options
+typedef struct{
+  const char* pipeline;  // Queue name suffix (NULL or "" for the default queues, see makePipelineQueueNames)
+  int sensorInput;       // 1: receive live frames from the sensor -> logger queue (default 1)
+  int forwardToViewer;   // 1: forward frames to the logger -> viewer queue (default 1, 0 for headless batch runs)
+  int playbackFps;       // Playback rate (default 30, 0 plays as fast as the frame callback allows)
+  int recordDecimation;  // 1, 2, 4 or 8: record 1/n of the received resolution in each direction (default 1)
+  int viewerDecimation;  // Resolution forwarded to the viewer (default 1: raw messages passed through)
+  int callbackDecimation; // Resolution passed to the frame callback (default 1)
+} LoggingOptions;
+
+// One logger / playback pipeline stage with its own queues, files, buffers and threads
+// Several contexts with different pipeline names run side by side in one process
+typedef struct LoggingContext LoggingContext;
+
+void setDefaultLoggingOptions(LoggingOptions* options);
+
+// Create / destroy a context (destroy stops it first)
+// Returns NULL on allocation failure
+LoggingContext* createLoggingContext(const LoggingOptions* options);
+void destroyLoggingContext(LoggingContext* logging);
+
+// Create the context queues and start the logger / playback threads
+// Returns 1 on success, 0 on failure
+int loggingStart(LoggingContext* logging);
+void loggingStop(LoggingContext* logging);
+int loggingIsRunning(LoggingContext* logging);
+
+int loggingStartRecording(LoggingContext* logging, const char* filename);
+void loggingStopRecording(LoggingContext* logging);
+int loggingStartPlayback(LoggingContext* logging, const char* filename);
+void loggingStopPlayback(LoggingContext* logging);
+int loggingIsRecording(LoggingContext* logging);
+int loggingIsPlayingBack(LoggingContext* logging);
+
+// Frames played back since the last playback start
+uint32_t loggingPlaybackFrames(LoggingContext* logging);
+
+void loggingSendControlCommand(LoggingContext* logging, int command, const char* filename);
+void loggingSetFrameCallback(LoggingContext* logging, LoggerFrameCallback callback, void* user_data);
+
+// Default context used by the functions below (the single pipeline of the Youth process)
+// Call setLoggingModuleOptions before initLoggingModule to change its pipeline name
+void setLoggingModuleOptions(const LoggingOptions* options);
+
 // Initialize Logging Module
 void initLoggingModule();
 
@@ -26,7 +79,7 @@ void stopPlayback();
 // Check Recording Status 
 int isRecording();
 
-// Check Play Status
+// Check Play Status 
 int isPlayingBack();
 
 // Check Logging Module Execution Status 
@@ -34,6 +87,9 @@ int isLoggingModuleRunning();
 
 void sendControlCommand(int command, const char* filename);
 
+// Register complete frame callback (NULL to clear), same frames as sent to the viewer at callbackDecimation
+void setLoggerFrameCallback(LoggerFrameCallback callback, void* user_data);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,214 @@
+// 병렬 재생 벤치마크 (한 프로세스 안의 독립 파이프라인 N 개)
+// 사용법: ReplayBenchmark [max pipelines] [frames] [recording ...]
+// 녹화 파일을 주지 않으면 합성 녹화 파일 (640x480, frames 장) 을 만들어 사용
+// 파이프라인마다 LoggingContext 하나 (뷰어 전달 없음, 최대 속도 재생) 와 역투영 작업을 붙이고
+// 1, 2, 4 ... N 개를 동시에 재생해 전체 FPS 와 1 개 대비 확장 효율을 출력
+
+#include "loggingModule.h"
+#include "../frameDefinitions.h"
+#include "../KernelModule/kernelModule.h"
+#include "../KernelModule/benchmarkUtil.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define SOURCE_WIDTH 640
+#define SOURCE_HEIGHT 480
+#define MAX_PIPELINES 64
+
+// 녹화 모듈과 같은 형식 (FrameHeader + 깊이 + 색상, 종료 마커) 으로 합성 녹화 파일 작성
+static int writeRecording(const char* filename, int frames){
+  FILE* file = fopen(filename, "wb");
+  if(!file){
+    perror("Failed to create recording");
+    return 0;
+  }
+
+  int16_t* depth = (int16_t*)malloc(SOURCE_WIDTH * SOURCE_HEIGHT * sizeof(int16_t));
+  uint8_t* rgb = (uint8_t*)malloc(SOURCE_WIDTH * SOURCE_HEIGHT * 3);
+  if(!depth || !rgb){
+    free(depth);
+    free(rgb);
+    fclose(file);
+    return 0;
+  }
+
+  for(int f = 0; f < frames; ++f){
+    renderBenchmarkWaveScene((uint32_t)f, SOURCE_WIDTH, SOURCE_HEIGHT, 0, 97, depth, rgb);
+    FrameHeader header = {0};
+    header.frameId = f;
+    header.timestamp = (uint32_t)f * 33;
+    header.frameType = FRAME_TYPE_DEPTH_COLOR;
+    header.width = SOURCE_WIDTH;
+    header.height = SOURCE_HEIGHT;
+    header.depthDataSize = SOURCE_WIDTH * SOURCE_HEIGHT * sizeof(int16_t);
+    header.colorDataSize = SOURCE_WIDTH * SOURCE_HEIGHT * 3;
+    fwrite(&header, sizeof(FrameHeader), 1, file);
+    fwrite(depth, header.depthDataSize, 1, file);
+    fwrite(rgb, header.colorDataSize, 1, file);
+  }
+
+  FrameHeader endHeader = {0};
+  endHeader.frameType = FRAME_TYPE_END_OF_FILE;
+  fwrite(&endHeader, sizeof(FrameHeader), 1, file);
+
+  free(depth);
+  free(rgb);
+  return fclose(file) == 0;
+}
+
+// 파이프라인 하나의 작업 상태 (재생 스레드에서만 갱신)
+typedef struct{
+  LoggingContext* logging;
+  RayTable table;
+  PointBuffer points;
+  int tableReady;
+  uint32_t frames;
+  uint64_t pointCount;
+  double firstFrame, lastFrame;
+} ReplayWorker;
+
+// 프레임마다 역투영 (배치 처리의 대표 작업)
+static void onFrame(const int16_t* depth, const uint8_t* color, int width, int height, uint32_t frame_id,
+                    uint32_t timestamp, int camera_id, void* user_data){
+  (void)frame_id;
+  (void)timestamp;
+  (void)camera_id;
+  ReplayWorker* worker = (ReplayWorker*)user_data;
+  double now = benchmarkNow();
+  if(worker->frames == 0){
+    worker->firstFrame = now;
+  }
+
+  if(!worker->tableReady || worker->table.width != width || worker->table.height != height){
+    CameraIntrinsics intrinsics;
+    setDefaultCameraIntrinsics(&intrinsics, width, height);
+    if(worker->tableReady){
+      destroyRayTable(&worker->table);
+      freePointBuffer(&worker->points);
+    }
+    worker->tableReady = createRayTable(&worker->table, &intrinsics, width, height) &&
+                         allocPointBuffer(&worker->points, (size_t)width * height);
+  }
+  if(worker->tableReady){
+    worker->pointCount += unprojectDepth(&worker->table, (const uint16_t*)depth, color, 0.2f, 8.0f,
+                                         KERNEL_UNPROJECT_COMPACT, &worker->points);
+  }
+
+  worker->frames++;
+  worker->lastFrame = benchmarkNow();
+}
+
+// 파이프라인 count 개를 동시에 재생, 반환값: 전체 FPS (실패 시 0)
+static double runReplay(int count, char** recordings, int recordingCount){
+  ReplayWorker* workers = (ReplayWorker*)calloc(count, sizeof(ReplayWorker));
+  if(!workers){
+    return 0.0;
+  }
+
+  int started = 0;
+  for(int i = 0; i < count; ++i){
+    char pipeline[MAX_PIPELINE_NAME];
+    snprintf(pipeline, sizeof(pipeline), "replay%d", i);
+
+    LoggingOptions options;
+    setDefaultLoggingOptions(&options);
+    options.pipeline = pipeline;
+    options.sensorInput = 0;
+    options.forwardToViewer = 0;
+    options.playbackFps = 0;
+
+    workers[i].logging = createLoggingContext(&options);
+    if(!workers[i].logging || !loggingStart(workers[i].logging)){
+      fprintf(stderr, "Pipeline %s failed to start\n", pipeline);
+      break;
+    }
+    loggingSetFrameCallback(workers[i].logging, onFrame, &workers[i]);
+    started++;
+  }
+
+  // 모든 파이프라인이 준비된 뒤 한꺼번에 재생 시작
+  for(int i = 0; i < started; ++i){
+    loggingStartPlayback(workers[i].logging, recordings[i % recordingCount]);
+  }
+
+  // 재생이 시작되었다가 끝날 때까지 (파일을 못 열면 시작 없이 끝남)
+  const double deadline = benchmarkNow() + 600.0;
+  for(int i = 0; i < started; ++i){
+    const double startDeadline = benchmarkNow() + 2.0;
+    while(benchmarkNow() < deadline){
+      int playing = loggingIsPlayingBack(workers[i].logging);
+      int begun = playing || loggingPlaybackFrames(workers[i].logging) > 0;
+      if(begun ? !playing : benchmarkNow() > startDeadline){
+        break;
+      }
+      usleep(10000);
+    }
+  }
+
+  // 첫 프레임부터 마지막 프레임까지 (제어 큐 / 재생 대기 지연 제외)
+  double first = 0.0, last = 0.0;
+  uint64_t frames = 0, points = 0;
+  for(int i = 0; i < started; ++i){
+    ReplayWorker* worker = &workers[i];
+    destroyLoggingContext(worker->logging);
+    if(worker->frames > 0){
+      if(frames == 0 || worker->firstFrame < first) first = worker->firstFrame;
+      if(worker->lastFrame > last) last = worker->lastFrame;
+    }
+    frames += worker->frames;
+    points += worker->pointCount;
+    if(worker->tableReady){
+      destroyRayTable(&worker->table);
+      freePointBuffer(&worker->points);
+    }
+  }
+  free(workers);
+
+  const double elapsed = last - first;
+  const double fps = frames > 0 && elapsed > 0.0 ? frames / elapsed : 0.0;
+  printf("%3d pipelines: %6llu frames in %7.3f s  %8.1f FPS  %6.1f Mpoints/s\n", started,
+         (unsigned long long)frames, elapsed, fps, elapsed > 0.0 ? points / elapsed / 1e6 : 0.0);
+  return started == count ? fps : 0.0;
+}
+
+int main(int argc, char** argv){
+  int maxPipelines = argc > 1 ? atoi(argv[1]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+  int frames = argc > 2 ? atoi(argv[2]) : 300;
+  if(maxPipelines < 1) maxPipelines = 1;
+  if(maxPipelines > MAX_PIPELINES) maxPipelines = MAX_PIPELINES;
+  if(frames < 1) frames = 1;
+
+  char syntheticName[] = "/tmp/youth_replay_benchmark.bin";
+  char* synthetic[1] = {syntheticName};
+  char** recordings = argc > 3 ? argv + 3 : synthetic;
+  int recordingCount = argc > 3 ? argc - 3 : 1;
+  if(argc <= 3 && !writeRecording(syntheticName, frames)){
+    return 1;
+  }
+
+  printf("%d pipelines max, %ld cores, %d recording(s)\n", maxPipelines, sysconf(_SC_NPROCESSORS_ONLN),
+         recordingCount);
+
+  double baseline = 0.0;
+  int ok = 1;
+  for(int count = 1;; count = count * 2 < maxPipelines ? count * 2 : maxPipelines){
+    double fps = runReplay(count, recordings, recordingCount);
+    if(fps <= 0.0){
+      ok = 0;
+      break;
+    }
+    if(count == 1){
+      baseline = fps;
+    }else{
+      printf("    speedup %.2fx, efficiency %.0f%%\n", fps / baseline, 100.0 * fps / baseline / count);
+    }
+    if(count == maxPipelines) break;
+  }
+
+  if(argc <= 3){
+    unlink(syntheticName);
+  }
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,136 @@
+// 녹화 파일 렌즈 왜곡 보정 (오프라인)
+// 사용법: UndistortRecording <camera.yaml> <input.bin> <output.bin>
+// 설정 파일의 Camera.k1 ~ p2 (색상), Depth.k1 ~ p2 (깊이, 없으면 색상과 같음) 로 모든 프레임의 깊이 / 색상을 보정해
+// 같은 형식으로 저장 (라이브 --undistort 와 같은 리맵 테이블이므로 결과도 같음)
+
+#include "../frameDefinitions.h"
+#include "../KernelModule/undistort.h"
+#include "../KernelModule/benchmarkUtil.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 해상도가 바뀌면 리맵 테이블 / 버퍼를 다시 생성
+typedef struct{
+  int width, height;
+  UndistortMap depthMap, colorMap;
+  uint8_t *depthIn, *colorIn, *depthOut, *colorOut;
+} UndistortState;
+
+static void releaseState(UndistortState* state){
+  destroyUndistortMap(&state->depthMap);
+  destroyUndistortMap(&state->colorMap);
+  free(state->depthIn);
+  free(state->colorIn);
+  free(state->depthOut);
+  free(state->colorOut);
+  memset(state, 0, sizeof(UndistortState));
+}
+
+static int prepareState(UndistortState* state, const DepthColorCalibration* calibration, int width, int height){
+  if(state->depthIn && state->width == width && state->height == height){
+    return 1;
+  }
+  releaseState(state);
+  size_t pixels = (size_t)width * height;
+  int ok = createUndistortMap(&state->depthMap, &calibration->depth, &calibration->depthDistortion, width, height);
+  ok = createUndistortMap(&state->colorMap, &calibration->color, &calibration->colorDistortion, width, height) && ok;
+  state->depthIn = (uint8_t*)malloc(pixels * sizeof(uint16_t));
+  state->depthOut = (uint8_t*)malloc(pixels * sizeof(uint16_t));
+  state->colorIn = (uint8_t*)malloc(pixels * 3);
+  state->colorOut = (uint8_t*)malloc(pixels * 3);
+  state->width = width;
+  state->height = height;
+  if(!ok || !state->depthIn || !state->depthOut || !state->colorIn || !state->colorOut){
+    releaseState(state);
+    return 0;
+  }
+  return 1;
+}
+
+int main(int argc, char** argv){
+  if(argc < 4){
+    fprintf(stderr, "Usage: %s <camera.yaml> <input.bin> <output.bin>\n", argv[0]);
+    return 1;
+  }
+
+  DepthColorCalibration calibration;
+  setDefaultDepthColorCalibration(&calibration, 640, 480);
+  if(!loadDepthColorCalibration(argv[1], &calibration)){
+    fprintf(stderr, "Failed to read calibration from %s\n", argv[1]);
+    return 1;
+  }
+  const LensDistortion* dc = &calibration.colorDistortion;
+  const LensDistortion* dd = &calibration.depthDistortion;
+  printf("Color k1 %.4f k2 %.4f p1 %.4f p2 %.4f k3 %.4f, depth k1 %.4f k2 %.4f p1 %.4f p2 %.4f k3 %.4f\n", dc->k1,
+         dc->k2, dc->p1, dc->p2, dc->k3, dd->k1, dd->k2, dd->p1, dd->p2, dd->k3);
+
+  FILE* input = fopen(argv[2], "rb");
+  if(!input){
+    fprintf(stderr, "Failed to open %s\n", argv[2]);
+    return 1;
+  }
+  FILE* output = fopen(argv[3], "wb");
+  if(!output){
+    fprintf(stderr, "Failed to create %s\n", argv[3]);
+    fclose(input);
+    return 1;
+  }
+
+  UndistortState state;
+  memset(&state, 0, sizeof(UndistortState));
+  FrameHeader header;
+  uint32_t frames = 0;
+  double processing = 0.0;
+  int status = 0;
+
+  while(fread(&header, sizeof(FrameHeader), 1, input) == 1){
+    if(header.frameType == FRAME_TYPE_END_OF_FILE){
+      break;
+    }
+    const size_t pixels = (size_t)header.width * header.height;
+    if(header.frameType != FRAME_TYPE_DEPTH_COLOR || header.depthDataSize != pixels * sizeof(uint16_t) ||
+       header.colorDataSize != pixels * 3){
+      fprintf(stderr, "Unsupported frame %u (type %u, %ux%u)\n", header.frameId, header.frameType, header.width,
+              header.height);
+      status = 1;
+      break;
+    }
+    if(!prepareState(&state, &calibration, header.width, header.height)){
+      fprintf(stderr, "Failed to create undistort maps for %ux%u\n", header.width, header.height);
+      status = 1;
+      break;
+    }
+    if(fread(state.depthIn, 1, header.depthDataSize, input) != header.depthDataSize ||
+       fread(state.colorIn, 1, header.colorDataSize, input) != header.colorDataSize){
+      fprintf(stderr, "Truncated frame %u\n", header.frameId);
+      status = 1;
+      break;
+    }
+
+    double start = benchmarkNow();
+    undistortDepth(&state.depthMap, (const uint16_t*)state.depthIn, (uint16_t*)state.depthOut);
+    undistortColor(&state.colorMap, state.colorIn, state.colorOut);
+    processing += benchmarkNow() - start;
+
+    fwrite(&header, sizeof(FrameHeader), 1, output);
+    fwrite(state.depthOut, header.depthDataSize, 1, output);
+    fwrite(state.colorOut, header.colorDataSize, 1, output);
+    frames++;
+  }
+
+  // 재생 모듈이 파일 끝을 알 수 있도록 종료 헤더 기록
+  FrameHeader endHeader;
+  memset(&endHeader, 0, sizeof(FrameHeader));
+  endHeader.frameType = FRAME_TYPE_END_OF_FILE;
+  fwrite(&endHeader, sizeof(FrameHeader), 1, output);
+
+  fclose(input);
+  fclose(output);
+  releaseState(&state);
+
+  if(frames > 0){
+    printf("Undistorted %u frames, %.3f ms/frame (depth + color)\n", frames, processing * 1000.0 / frames);
+  }
+  return status;
+}
@@ -0,0 +1,205 @@
+// 누적 지도 벤치마크
+// 사용법: MapBenchmark [frames] [point_budget] [render_budget]
+// 합성 복도 (폭 4 m, 높이 2.8 m) 를 걸으며 프레임을 누적하고, 통합 시간 / 지도 크기 / 컬링 시간 측정
+// 기본값은 2000 프레임 (100 m) 에 포인트 예산 100 만 개로, 지도가 예산을 넘어 병합 / 비우기가 실제로 일어남
+// 할당 메모리 최대값이 예산 (포인트당 MAX_BYTES_PER_POINT 바이트) 을 넘으면 실패
+
+#include "mapModule.h"
+#include "../KernelModule/benchmarkUtil.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CORRIDOR_HALF_WIDTH 2.0f
+#define CORRIDOR_HALF_HEIGHT 1.4f
+#define STEP_PER_FRAME 0.05f
+#define DEFAULT_POINT_BUDGET 1000000
+
+// 포인트 하나의 정점 + 복셀 키 + 가중치 (21 바이트) 를 배열 두 배 확장과 적재율 1/4 ~ 1/2 해시까지 포함해 넉넉히 잡은 값
+#define MAX_BYTES_PER_POINT 64
+
+// 카메라 자세 (월드 z 축으로 걸으며 좌우로 고개를 돌림), column-major
+static void corridorPose(int frame, float Twc[16]){
+  float yaw = 0.6f * sinf(frame * 0.05f);
+  float c = cosf(yaw), s = sinf(yaw);
+  memset(Twc, 0, 16 * sizeof(float));
+  Twc[0] = c;   Twc[2] = -s;
+  Twc[5] = 1.0f;
+  Twc[8] = s;   Twc[10] = c;
+  Twc[12] = 0.0f;
+  Twc[13] = 0.0f;
+  Twc[14] = frame * STEP_PER_FRAME;
+  Twc[15] = 1.0f;
+}
+
+// 복도 벽까지의 깊이 영상 (광선 추적), 벽 무늬는 월드 좌표 체크 무늬
+static void renderCorridor(const RayTable* rays, const float Twc[16], uint16_t* depth, uint8_t* rgb){
+  for(int v = 0; v < rays->height; ++v){
+    for(int u = 0; u < rays->width; ++u){
+      size_t i = (size_t)v * rays->width + u;
+      float cx = rays->rayX[i], cy = rays->rayY[i];
+      float dx = Twc[0] * cx + Twc[4] * cy + Twc[8];
+      float dy = Twc[1] * cx + Twc[5] * cy + Twc[9];
+      float dz = Twc[2] * cx + Twc[6] * cy + Twc[10];
+
+      float t = 1e9f;
+      if(dx > 1e-6f) t = fminf(t, (CORRIDOR_HALF_WIDTH - Twc[12]) / dx);
+      if(dx < -1e-6f) t = fminf(t, (-CORRIDOR_HALF_WIDTH - Twc[12]) / dx);
+      if(dy > 1e-6f) t = fminf(t, (CORRIDOR_HALF_HEIGHT - Twc[13]) / dy);
+      if(dy < -1e-6f) t = fminf(t, (-CORRIDOR_HALF_HEIGHT - Twc[13]) / dy);
+
+      // 광선의 카메라 z 성분이 1 이므로 t 가 곧 깊이
+      uint16_t d = t < 6.0f ? (uint16_t)(t / rays->depthScale) : 0;
+      depth[i] = d;
+      float wx = Twc[12] + dx * t, wy = Twc[13] + dy * t, wz = Twc[14] + dz * t;
+      int checker = ((int)floorf(wx * 2.0f) + (int)floorf(wy * 2.0f) + (int)floorf(wz * 2.0f)) & 1;
+      rgb[i * 3] = checker ? 200 : 60;
+      rgb[i * 3 + 1] = (uint8_t)(128 + 100 * sinf(wz * 0.3f));
+      rgb[i * 3 + 2] = checker ? 60 : 200;
+    }
+  }
+}
+
+// 투영 * 시점 행렬 (column-major, 시점은 +z 방향을 봄)
+static void viewProjection(const float eye[3], float yaw, float aspect, float out[16]){
+  float f = 1.0f / tanf(45.0f * 0.5f * 3.14159265f / 180.0f);
+  float zn = 0.1f, zf = 500.0f;
+  float P[16] = {f / aspect, 0, 0, 0, 0, f, 0, 0, 0, 0, (zf + zn) / (zn - zf), -1, 0, 0, 2 * zf * zn / (zn - zf), 0};
+
+  // 월드 -> 시점: 시점 -z 가 월드 방향 (sin yaw, 0, cos yaw)
+  float c = cosf(yaw), s = sinf(yaw);
+  float R[9] = {-c, 0, s, 0, 1, 0, -s, 0, -c}; // 행 우선: 오른쪽, 위, 뒤
+  float V[16] = {0};
+  for(int r = 0; r < 3; ++r){
+    for(int k = 0; k < 3; ++k){
+      V[k * 4 + r] = R[r * 3 + k];
+    }
+    V[12 + r] = -(R[r * 3] * eye[0] + R[r * 3 + 1] * eye[1] + R[r * 3 + 2] * eye[2]);
+  }
+  V[15] = 1.0f;
+
+  for(int col = 0; col < 4; ++col){
+    for(int row = 0; row < 4; ++row){
+      float sum = 0.0f;
+      for(int k = 0; k < 4; ++k){
+        sum += P[k * 4 + row] * V[col * 4 + k];
+      }
+      out[col * 4 + row] = sum;
+    }
+  }
+}
+
+int main(int argc, char** argv){
+  int frames = argc > 1 ? atoi(argv[1]) : 2000;
+
+  PointMapOptions options;
+  setDefaultPointMapOptions(&options);
+  options.pointBudget = argc > 2 ? (size_t)atol(argv[2]) : DEFAULT_POINT_BUDGET;
+  if(argc > 3) options.renderBudget = (size_t)atol(argv[3]);
+  printf("Map: voxel %.3f m, chunk %.1f m, point budget %zu, render budget %zu, stride %d, walk %.0f m\n",
+         options.voxelSize, options.chunkSize, options.pointBudget, options.renderBudget, options.pixelStride,
+         frames * STEP_PER_FRAME);
+
+  CameraIntrinsics K;
+  setDefaultCameraIntrinsics(&K, 640, 480);
+  RayTable rays;
+  if(!createRayTable(&rays, &K, 640, 480)){
+    fprintf(stderr, "Failed to create ray table\n");
+    return 1;
+  }
+
+  size_t pixels = (size_t)rays.width * rays.height;
+  uint16_t* depth = (uint16_t*)malloc(pixels * sizeof(uint16_t));
+  uint8_t* rgb = (uint8_t*)malloc(pixels * 3);
+  PointMap* map = createPointMap(&options);
+  MapOctree* tree = createMapOctree(options.chunkSize);
+  if(!depth || !rgb || !map || !tree){
+    fprintf(stderr, "Allocation failed\n");
+    return 1;
+  }
+
+  double integrateSeconds = 0.0, packSeconds = 0.0;
+  size_t uploadedBytes = 0, peakBytes = 0, lastPoints = 0;
+  int mergedFrames = 0;
+  float Twc[16];
+  for(int frame = 0; frame < frames; ++frame){
+    corridorPose(frame, Twc);
+    renderCorridor(&rays, Twc, depth, rgb);
+
+    double start = benchmarkNow();
+    size_t added = integratePointMap(map, &rays, depth, rgb, Twc);
+    double packed = benchmarkNow();
+    integrateSeconds += packed - start;
+
+    // 렌더러 쪽 옥트리 갱신 (GPU 버퍼 대신 포인트 수만 기록)
+    PointMapChunkData* updates;
+    size_t count = takePointMapUpdates(map, &updates);
+    for(size_t i = 0; i < count; ++i){
+      MapOctreeLeaf* leaf = findMapOctreeLeaf(tree, updates[i].key, 1);
+      if(leaf){
+        leaf->buffer = 1;
+        leaf->count = updates[i].count;
+      }
+      uploadedBytes += updates[i].count * sizeof(PointMapVertex);
+      freePointMapChunkData(&updates[i]);
+    }
+    free(updates);
+    packSeconds += benchmarkNow() - packed;
+
+    size_t bytes = getPointMapMemory(map);
+    if(bytes > peakBytes) peakBytes = bytes;
+    // 지도 크기가 줄었으면 예산 때문에 병합 / 비우기가 일어난 프레임
+    mergedFrames += added > 0 && getPointMapSize(map) < lastPoints;
+    lastPoints = getPointMapSize(map);
+    if((frame + 1) % 100 == 0){
+      printf("frame %4d: %9zu points in %5zu chunks (%.1f MB allocated)\n", frame + 1, getPointMapSize(map),
+             getPointMapChunkCount(map), bytes / (1024.0 * 1024.0));
+    }
+  }
+  printf("Integrate: %.3f ms/frame, pack: %.3f ms/frame, upload %.1f MB/frame\n", integrateSeconds * 1000.0 / frames,
+         packSeconds * 1000.0 / frames, uploadedBytes / (1024.0 * 1024.0) / frames);
+
+  // 예산 검사: 한 프레임이 더하는 포인트만큼은 병합 전에 잠시 넘을 수 있음
+  if(options.pointBudget > 0){
+    size_t framePoints = (size_t)((rays.width + options.pixelStride - 1) / options.pixelStride) *
+                         ((rays.height + options.pixelStride - 1) / options.pixelStride);
+    size_t limit = (options.pointBudget + framePoints) * MAX_BYTES_PER_POINT;
+    printf("Budget enforced on %d frames, peak %.1f MB allocated (limit %.1f MB) %s\n", mergedFrames,
+           peakBytes / (1024.0 * 1024.0), limit / (1024.0 * 1024.0), peakBytes <= limit ? "OK" : "OVER BUDGET");
+    if(mergedFrames == 0){
+      printf("Point budget was never reached, run more frames to exercise merging\n");
+    }
+    if(peakBytes > limit){
+      return 1;
+    }
+  }
+
+  // 복도 입구에서 안쪽을 볼 때 (대부분의 청크가 보이고 멀리 있음) / 복도 중간에서 옆을 볼 때
+  const struct { const char* name; float eye[3]; float yaw; } views[] = {
+    {"entrance", {0.0f, 0.0f, -2.0f}, 0.0f},
+    {"middle side", {0.0f, 0.0f, frames * STEP_PER_FRAME * 0.5f}, 1.4f},
+    {"far end", {0.0f, 0.0f, -40.0f}, 0.0f},
+  };
+  for(size_t v = 0; v < sizeof(views) / sizeof(views[0]); ++v){
+    float viewProj[16];
+    viewProjection(views[v].eye, views[v].yaw, 16.0f / 9.0f, viewProj);
+
+    size_t items = 0, points = 0;
+    double start = benchmarkNow();
+    const int iterations = 1000;
+    for(int i = 0; i < iterations; ++i){
+      cullMapOctree(tree, viewProj, views[v].eye, options.lodDistance, options.renderBudget, &items, &points);
+    }
+    double elapsed = benchmarkNow() - start;
+    printf("Cull %-12s %8.3f ms, %5zu chunks, %9zu points drawn\n", views[v].name, elapsed * 1000.0 / iterations,
+           items, points);
+  }
+
+  destroyMapOctree(tree);
+  destroyPointMap(map);
+  destroyRayTable(&rays);
+  free(depth);
+  free(rgb);
+  return 0;
+}
@@ -0,0 +1,954 @@
+#include "mapModule.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 청크 안의 복셀 좌표는 축마다 10 비트 (한 청크에 기본 복셀 최대 1024 개)
+#define MAP_VOXEL_AXIS_BITS 10
+#define MAP_VOXEL_AXIS_MAX (1 << MAP_VOXEL_AXIS_BITS)
+#define MAP_VOXEL_AXIS_MASK (MAP_VOXEL_AXIS_MAX - 1)
+#define MAP_COARSEST_AXIS 8      // 병합해도 청크 한 변에 복셀 8 개는 유지
+#define MAP_MAX_WEIGHT 32        // 평균 가중치 상한 (오래된 관측에 너무 묶이지 않도록)
+#define MAP_MIN_LOD_POINTS 64    // 멀리 있어도 청크마다 최소한 그리는 포인트 수
+
+void setDefaultPointMapOptions(PointMapOptions* options){
+  options->voxelSize = 0.02f;
+  options->chunkSize = 2.0f;
+  options->pointBudget = 10000000;
+  options->renderBudget = 3000000;
+  options->lodDistance = 4.0f;
+  options->minDepth = 0.3f;
+  options->maxDepth = 4.0f;
+  options->pixelStride = 2;
+}
+
+// 청크 (chunkSize 격자 한 칸의 복셀 병합 포인트)
+typedef struct{
+  int32_t key[3];
+  float origin[3];
+  int level;                 // 병합 단계 (복셀 크기 = voxelSize << level)
+  PointMapVertex* vertices;
+  uint32_t* voxelKeys;       // 현재 단계 복셀 좌표 (x << 20 | y << 10 | z)
+  uint8_t* weights;
+  uint32_t count;
+  uint32_t capacity;
+  uint32_t* slots;           // 복셀 해시 (포인트 인덱스 + 1, 0 이면 빈칸)
+  uint32_t slotMask;
+  int dirty;
+} MapChunk;
+
+struct PointMap{
+  PointMapOptions options;
+  float invChunkSize;
+  float invVoxelSize;
+  int voxelAxis;             // 청크 한 변의 기본 복셀 수
+  int maxLevel;
+
+  MapChunk** chunks;
+  size_t chunkCount;
+  size_t chunkCapacity;
+
+  // 청크 좌표 -> chunks 인덱스 (선형 탐사 해시)
+  uint64_t* tableKeys;
+  int32_t* tableChunks;
+  size_t tableMask;
+
+  int32_t* dirty;
+  size_t dirtyCount;
+  size_t dirtyCapacity;
+
+  size_t totalPoints;
+};
+
+static uint32_t hashVoxelKey(uint32_t key){
+  key *= 2654435761u;
+  return key ^ (key >> 16);
+}
+
+static uint64_t packChunkKey(const int32_t key[3]){
+  return (1ull << 63) | ((uint64_t)((key[0] + (1 << 20)) & 0x1FFFFF) << 42) |
+         ((uint64_t)((key[1] + (1 << 20)) & 0x1FFFFF) << 21) | (uint64_t)((key[2] + (1 << 20)) & 0x1FFFFF);
+}
+
+static size_t hashChunkKey(uint64_t key){
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdull;
+  key ^= key >> 33;
+  return (size_t)key;
+}
+
+PointMap* createPointMap(const PointMapOptions* options){
+  PointMap* map = (PointMap*)calloc(1, sizeof(PointMap));
+  if(!map){
+    perror("calloc point map");
+    return NULL;
+  }
+
+  if(options){
+    map->options = *options;
+  }else{
+    setDefaultPointMapOptions(&map->options);
+  }
+  PointMapOptions* o = &map->options;
+  if(o->chunkSize <= 0.0f) o->chunkSize = 2.0f;
+  if(o->voxelSize <= 0.0f) o->voxelSize = 0.02f;
+  if(o->pixelStride < 1) o->pixelStride = 1;
+
+  // 청크 한 변의 복셀 수가 키 비트 수를 넘지 않도록 복셀 크기 조정
+  if(o->chunkSize / o->voxelSize > MAP_VOXEL_AXIS_MAX){
+    o->voxelSize = o->chunkSize / MAP_VOXEL_AXIS_MAX;
+  }
+  map->voxelAxis = (int)ceilf(o->chunkSize / o->voxelSize);
+  if(map->voxelAxis > MAP_VOXEL_AXIS_MAX) map->voxelAxis = MAP_VOXEL_AXIS_MAX;
+  map->invChunkSize = 1.0f / o->chunkSize;
+  map->invVoxelSize = 1.0f / o->voxelSize;
+  while((map->voxelAxis >> (map->maxLevel + 1)) >= MAP_COARSEST_AXIS){
+    map->maxLevel++;
+  }
+
+  map->tableMask = 1023;
+  map->tableKeys = (uint64_t*)calloc(map->tableMask + 1, sizeof(uint64_t));
+  map->tableChunks = (int32_t*)malloc((map->tableMask + 1) * sizeof(int32_t));
+  if(!map->tableKeys || !map->tableChunks){
+    perror("malloc point map table");
+    destroyPointMap(map);
+    return NULL;
+  }
+  return map;
+}
+
+static void freeChunkPoints(MapChunk* chunk){
+  free(chunk->vertices);
+  free(chunk->voxelKeys);
+  free(chunk->weights);
+  free(chunk->slots);
+  chunk->vertices = NULL;
+  chunk->voxelKeys = NULL;
+  chunk->weights = NULL;
+  chunk->slots = NULL;
+  chunk->slotMask = 0;
+  chunk->count = chunk->capacity = 0;
+}
+
+void resetPointMap(PointMap* map){
+  for(size_t i = 0; i < map->chunkCount; ++i){
+    freeChunkPoints(map->chunks[i]);
+    free(map->chunks[i]);
+  }
+  map->chunkCount = 0;
+  memset(map->tableKeys, 0, (map->tableMask + 1) * sizeof(uint64_t));
+  map->dirtyCount = 0;
+  map->totalPoints = 0;
+}
+
+void destroyPointMap(PointMap* map){
+  if(!map){
+    return;
+  }
+  if(map->tableKeys){
+    resetPointMap(map);
+  }
+  free(map->chunks);
+  free(map->tableKeys);
+  free(map->tableChunks);
+  free(map->dirty);
+  free(map);
+}
+
+size_t getPointMapSize(const PointMap* map){
+  return map->totalPoints;
+}
+
+size_t getPointMapChunkCount(const PointMap* map){
+  return map->chunkCount;
+}
+
+size_t getPointMapMemory(const PointMap* map){
+  size_t bytes = sizeof(PointMap) + map->chunkCapacity * sizeof(MapChunk*) + map->dirtyCapacity * sizeof(int32_t) +
+                 (map->tableMask + 1) * (sizeof(uint64_t) + sizeof(int32_t));
+  for(size_t i = 0; i < map->chunkCount; ++i){
+    const MapChunk* chunk = map->chunks[i];
+    bytes += sizeof(MapChunk) + (size_t)chunk->capacity * (sizeof(PointMapVertex) + sizeof(uint32_t) + 1);
+    if(chunk->slots){
+      bytes += ((size_t)chunk->slotMask + 1) * sizeof(uint32_t);
+    }
+  }
+  return bytes;
+}
+
+static void markChunkDirty(PointMap* map, int32_t index){
+  MapChunk* chunk = map->chunks[index];
+  if(chunk->dirty){
+    return;
+  }
+  if(map->dirtyCount == map->dirtyCapacity){
+    size_t capacity = map->dirtyCapacity ? map->dirtyCapacity * 2 : 256;
+    int32_t* dirty = (int32_t*)realloc(map->dirty, capacity * sizeof(int32_t));
+    if(!dirty){
+      return; // 다음 변경 때 다시 시도
+    }
+    map->dirty = dirty;
+    map->dirtyCapacity = capacity;
+  }
+  map->dirty[map->dirtyCount++] = index;
+  chunk->dirty = 1;
+}
+
+static int growChunkTable(PointMap* map){
+  size_t mask = map->tableMask * 2 + 1;
+  uint64_t* keys = (uint64_t*)calloc(mask + 1, sizeof(uint64_t));
+  int32_t* chunks = (int32_t*)malloc((mask + 1) * sizeof(int32_t));
+  if(!keys || !chunks){
+    free(keys);
+    free(chunks);
+    return 0;
+  }
+  for(size_t i = 0; i < map->chunkCount; ++i){
+    uint64_t key = packChunkKey(map->chunks[i]->key);
+    size_t slot = hashChunkKey(key) & mask;
+    while(keys[slot]){
+      slot = (slot + 1) & mask;
+    }
+    keys[slot] = key;
+    chunks[slot] = (int32_t)i;
+  }
+  free(map->tableKeys);
+  free(map->tableChunks);
+  map->tableKeys = keys;
+  map->tableChunks = chunks;
+  map->tableMask = mask;
+  return 1;
+}
+
+// 청크 좌표의 청크 인덱스 (없으면 생성), 실패 시 -1
+static int32_t getChunk(PointMap* map, const int32_t key[3]){
+  uint64_t packed = packChunkKey(key);
+  size_t slot = hashChunkKey(packed) & map->tableMask;
+  while(map->tableKeys[slot]){
+    if(map->tableKeys[slot] == packed){
+      return map->tableChunks[slot];
+    }
+    slot = (slot + 1) & map->tableMask;
+  }
+
+  if((map->chunkCount + 1) * 2 > map->tableMask + 1){
+    if(!growChunkTable(map)){
+      return -1;
+    }
+    slot = hashChunkKey(packed) & map->tableMask;
+    while(map->tableKeys[slot]){
+      slot = (slot + 1) & map->tableMask;
+    }
+  }
+  if(map->chunkCount == map->chunkCapacity){
+    size_t capacity = map->chunkCapacity ? map->chunkCapacity * 2 : 256;
+    MapChunk** chunks = (MapChunk**)realloc(map->chunks, capacity * sizeof(MapChunk*));
+    if(!chunks){
+      return -1;
+    }
+    map->chunks = chunks;
+    map->chunkCapacity = capacity;
+  }
+
+  MapChunk* chunk = (MapChunk*)calloc(1, sizeof(MapChunk));
+  if(!chunk){
+    return -1;
+  }
+  for(int a = 0; a < 3; ++a){
+    chunk->key[a] = key[a];
+    chunk->origin[a] = key[a] * map->options.chunkSize;
+  }
+
+  int32_t index = (int32_t)map->chunkCount++;
+  map->chunks[index] = chunk;
+  map->tableKeys[slot] = packed;
+  map->tableChunks[slot] = index;
+  return index;
+}
+
+// 복셀 해시를 size 칸으로 다시 만듦
+static int rehashChunk(MapChunk* chunk, uint32_t size){
+  uint32_t* slots = (uint32_t*)calloc(size, sizeof(uint32_t));
+  if(!slots){
+    return 0;
+  }
+  uint32_t mask = size - 1;
+  for(uint32_t i = 0; i < chunk->count; ++i){
+    uint32_t slot = hashVoxelKey(chunk->voxelKeys[i]) & mask;
+    while(slots[slot]){
+      slot = (slot + 1) & mask;
+    }
+    slots[slot] = i + 1;
+  }
+  free(chunk->slots);
+  chunk->slots = slots;
+  chunk->slotMask = mask;
+  return 1;
+}
+
+static int reserveChunkPoints(MapChunk* chunk, uint32_t count){
+  if(count > chunk->capacity){
+    uint32_t capacity = chunk->capacity ? chunk->capacity * 2 : 1024;
+    while(capacity < count) capacity *= 2;
+    PointMapVertex* vertices = (PointMapVertex*)realloc(chunk->vertices, capacity * sizeof(PointMapVertex));
+    if(!vertices) return 0;
+    chunk->vertices = vertices;
+    uint32_t* keys = (uint32_t*)realloc(chunk->voxelKeys, capacity * sizeof(uint32_t));
+    if(!keys) return 0;
+    chunk->voxelKeys = keys;
+    uint8_t* weights = (uint8_t*)realloc(chunk->weights, capacity);
+    if(!weights) return 0;
+    chunk->weights = weights;
+    chunk->capacity = capacity;
+  }
+
+  // 적재율 1/2 이하 유지
+  if(!chunk->slots || (uint64_t)count * 2 > (uint64_t)chunk->slotMask + 1){
+    uint32_t size = chunk->slots ? (chunk->slotMask + 1) * 2 : 2048;
+    while((uint64_t)count * 2 > size) size *= 2;
+    return rehashChunk(chunk, size);
+  }
+  return 1;
+}
+
+// 복셀에 포인트 추가 (같은 복셀이 있으면 가중 평균)
+// 반환값: 새 복셀이면 1, 병합했거나 실패하면 0
+static int addChunkPoint(MapChunk* chunk, uint32_t key, float x, float y, float z, const uint8_t* rgb){
+  if(!reserveChunkPoints(chunk, chunk->count + 1)){
+    return 0;
+  }
+
+  uint32_t slot = hashVoxelKey(key) & chunk->slotMask;
+  uint32_t entry;
+  while((entry = chunk->slots[slot]) != 0){
+    uint32_t index = entry - 1;
+    if(chunk->voxelKeys[index] == key){
+      uint8_t weight = chunk->weights[index];
+      if(weight < MAP_MAX_WEIGHT){
+        chunk->weights[index] = ++weight;
+      }
+      float inv = 1.0f / weight;
+      PointMapVertex* v = &chunk->vertices[index];
+      v->x += (x - v->x) * inv;
+      v->y += (y - v->y) * inv;
+      v->z += (z - v->z) * inv;
+      if(rgb){
+        v->r = (uint8_t)(v->r + ((int)rgb[0] - v->r) / (int)weight);
+        v->g = (uint8_t)(v->g + ((int)rgb[1] - v->g) / (int)weight);
+        v->b = (uint8_t)(v->b + ((int)rgb[2] - v->b) / (int)weight);
+      }
+      return 0;
+    }
+    slot = (slot + 1) & chunk->slotMask;
+  }
+
+  uint32_t index = chunk->count++;
+  PointMapVertex* v = &chunk->vertices[index];
+  v->x = x;
+  v->y = y;
+  v->z = z;
+  v->r = rgb ? rgb[0] : 255;
+  v->g = rgb ? rgb[1] : 255;
+  v->b = rgb ? rgb[2] : 255;
+  v->a = 255;
+  chunk->voxelKeys[index] = key;
+  chunk->weights[index] = 1;
+  chunk->slots[slot] = index + 1;
+  return 1;
+}
+
+// 병합 뒤 배열을 남은 포인트 수로 줄이고 복셀 해시도 그 크기에 맞게 다시 만듦
+// (줄이지 않으면 병합 전 최대 크기가 그대로 남아 포인트 예산이 메모리를 제한하지 못함)
+static void shrinkChunk(MapChunk* chunk){
+  if(chunk->count == 0){
+    freeChunkPoints(chunk);
+    return;
+  }
+  if(chunk->count < chunk->capacity){
+    PointMapVertex* vertices = (PointMapVertex*)realloc(chunk->vertices, chunk->count * sizeof(PointMapVertex));
+    uint32_t* keys = (uint32_t*)realloc(chunk->voxelKeys, chunk->count * sizeof(uint32_t));
+    uint8_t* weights = (uint8_t*)realloc(chunk->weights, chunk->count);
+    // 줄이는 realloc 이 실패하면 원래 (더 큰) 블록이 그대로 남으므로 어느 쪽이든 count 개는 들어 있음
+    if(vertices) chunk->vertices = vertices;
+    if(keys) chunk->voxelKeys = keys;
+    if(weights) chunk->weights = weights;
+    chunk->capacity = chunk->count;
+  }
+
+  uint32_t size = 16;
+  while((uint64_t)chunk->count * 2 > size) size *= 2;
+  if(size < chunk->slotMask + 1){
+    rehashChunk(chunk, size); // 실패하면 기존 해시를 그대로 사용
+  }
+}
+
+// 복셀 크기를 두 배로 키워 이웃 복셀 병합 (순서는 유지, 제자리에서 압축)
+static void mergeChunk(PointMap* map, MapChunk* chunk){
+  uint32_t oldCount = chunk->count;
+  memset(chunk->slots, 0, ((size_t)chunk->slotMask + 1) * sizeof(uint32_t));
+  chunk->level++;
+  chunk->count = 0;
+
+  for(uint32_t i = 0; i < oldCount; ++i){
+    uint32_t k = chunk->voxelKeys[i];
+    uint32_t key = ((((k >> 20) & MAP_VOXEL_AXIS_MASK) >> 1) << 20) |
+                   ((((k >> 10) & MAP_VOXEL_AXIS_MASK) >> 1) << 10) | ((k & MAP_VOXEL_AXIS_MASK) >> 1);
+    PointMapVertex v = chunk->vertices[i];
+    uint32_t weight = chunk->weights[i];
+
+    uint32_t slot = hashVoxelKey(key) & chunk->slotMask;
+    uint32_t entry;
+    while((entry = chunk->slots[slot]) != 0 && chunk->voxelKeys[entry - 1] != key){
+      slot = (slot + 1) & chunk->slotMask;
+    }
+    if(entry){
+      PointMapVertex* dst = &chunk->vertices[entry - 1];
+      uint32_t dstWeight = chunk->weights[entry - 1];
+      float total = (float)(dstWeight + weight);
+      float a = dstWeight / total, b = weight / total;
+      dst->x = dst->x * a + v.x * b;
+      dst->y = dst->y * a + v.y * b;
+      dst->z = dst->z * a + v.z * b;
+      dst->r = (uint8_t)((dst->r * dstWeight + v.r * weight) / (dstWeight + weight));
+      dst->g = (uint8_t)((dst->g * dstWeight + v.g * weight) / (dstWeight + weight));
+      dst->b = (uint8_t)((dst->b * dstWeight + v.b * weight) / (dstWeight + weight));
+      chunk->weights[entry - 1] = (uint8_t)(dstWeight + weight < MAP_MAX_WEIGHT ? dstWeight + weight : MAP_MAX_WEIGHT);
+      continue;
+    }
+
+    uint32_t index = chunk->count++;
+    chunk->vertices[index] = v;
+    chunk->voxelKeys[index] = key;
+    chunk->weights[index] = (uint8_t)weight;
+    chunk->slots[slot] = index + 1;
+  }
+
+  map->totalPoints -= oldCount - chunk->count;
+  shrinkChunk(chunk);
+}
+
+typedef struct{
+  float distance;
+  int32_t index;
+} ChunkDistance;
+
+static int compareFarthestFirst(const void* a, const void* b){
+  float da = ((const ChunkDistance*)a)->distance;
+  float db = ((const ChunkDistance*)b)->distance;
+  return (da < db) - (da > db);
+}
+
+// 포인트 예산 유지: 카메라에서 먼 청크부터 복셀을 병합하고, 더 병합할 수 없으면 먼 청크를 비움
+// 예산의 7/8 까지 줄여 두어 매 프레임 병합이 반복되지 않게 함
+static void enforcePointBudget(PointMap* map, const float eye[3]){
+  size_t budget = map->options.pointBudget;
+  if(budget == 0 || map->totalPoints <= budget){
+    return;
+  }
+  size_t target = budget - budget / 8;
+
+  ChunkDistance* order = (ChunkDistance*)malloc(map->chunkCount * sizeof(ChunkDistance));
+  if(!order){
+    return;
+  }
+
+  float half = map->options.chunkSize * 0.5f;
+  int evict = 0;
+  while(map->totalPoints > target){
+    size_t n = 0;
+    for(size_t i = 0; i < map->chunkCount; ++i){
+      MapChunk* chunk = map->chunks[i];
+      if(chunk->count == 0 || (!evict && chunk->level >= map->maxLevel)){
+        continue;
+      }
+      float dx = chunk->origin[0] + half - eye[0];
+      float dy = chunk->origin[1] + half - eye[1];
+      float dz = chunk->origin[2] + half - eye[2];
+      order[n].distance = dx * dx + dy * dy + dz * dz;
+      order[n].index = (int32_t)i;
+      n++;
+    }
+    if(n == 0){
+      if(evict){
+        break;
+      }
+      evict = 1; // 모든 청크가 가장 거친 단계
+      continue;
+    }
+    qsort(order, n, sizeof(ChunkDistance), compareFarthestFirst);
+
+    for(size_t i = 0; i < n && map->totalPoints > target; ++i){
+      MapChunk* chunk = map->chunks[order[i].index];
+      if(evict){
+        map->totalPoints -= chunk->count;
+        freeChunkPoints(chunk);
+        chunk->level = 0;
+      }else{
+        mergeChunk(map, chunk);
+      }
+      markChunkDirty(map, order[i].index);
+    }
+  }
+  free(order);
+}
+
+size_t integratePointMap(PointMap* map, const RayTable* rays, const uint16_t* depth, const uint8_t* rgb,
+                         const float* Twc){
+  if(!map || !rays || !rays->rayX || !depth || !Twc){
+    return 0;
+  }
+
+  const PointMapOptions* o = &map->options;
+  const float r00 = Twc[0], r10 = Twc[1], r20 = Twc[2];
+  const float r01 = Twc[4], r11 = Twc[5], r21 = Twc[6];
+  const float r02 = Twc[8], r12 = Twc[9], r22 = Twc[10];
+  const float tx = Twc[12], ty = Twc[13], tz = Twc[14];
+  const int stride = o->pixelStride;
+  const int axisMax = map->voxelAxis - 1;
+
+  int32_t cachedKey[3] = {0, 0, 0};
+  int32_t cachedIndex = -1;
+  size_t added = 0;
+
+  for(int v = 0; v < rays->height; v += stride){
+    for(int u = 0; u < rays->width; u += stride){
+      size_t i = (size_t)v * rays->width + u;
+      uint16_t d = depth[i];
+      if(d == 0){
+        continue;
+      }
+      float z = d * rays->depthScale;
+      if(z < o->minDepth || z > o->maxDepth){
+        continue;
+      }
+      float xc = rays->rayX[i] * z;
+      float yc = rays->rayY[i] * z;
+      float wx = r00 * xc + r01 * yc + r02 * z + tx;
+      float wy = r10 * xc + r11 * yc + r12 * z + ty;
+      float wz = r20 * xc + r21 * yc + r22 * z + tz;
+
+      int32_t key[3] = {(int32_t)floorf(wx * map->invChunkSize), (int32_t)floorf(wy * map->invChunkSize),
+                        (int32_t)floorf(wz * map->invChunkSize)};
+      if(cachedIndex < 0 || key[0] != cachedKey[0] || key[1] != cachedKey[1] || key[2] != cachedKey[2]){
+        cachedIndex = getChunk(map, key);
+        if(cachedIndex < 0){
+          continue;
+        }
+        memcpy(cachedKey, key, sizeof(key));
+      }
+      MapChunk* chunk = map->chunks[cachedIndex];
+
+      int bx = (int)((wx - chunk->origin[0]) * map->invVoxelSize);
+      int by = (int)((wy - chunk->origin[1]) * map->invVoxelSize);
+      int bz = (int)((wz - chunk->origin[2]) * map->invVoxelSize);
+      bx = bx < 0 ? 0 : (bx > axisMax ? axisMax : bx);
+      by = by < 0 ? 0 : (by > axisMax ? axisMax : by);
+      bz = bz < 0 ? 0 : (bz > axisMax ? axisMax : bz);
+      uint32_t voxel = ((uint32_t)(bx >> chunk->level) << 20) | ((uint32_t)(by >> chunk->level) << 10) |
+                       (uint32_t)(bz >> chunk->level);
+
+      map->totalPoints += addChunkPoint(chunk, voxel, wx, wy, wz, rgb ? rgb + i * 3 : NULL);
+      markChunkDirty(map, cachedIndex);
+      added++;
+    }
+  }
+
+  const float eye[3] = {tx, ty, tz};
+  enforcePointBudget(map, eye);
+  return added;
+}
+
+static uint32_t gcd(uint32_t a, uint32_t b){
+  while(b){
+    uint32_t t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+// LOD 순서: 황금비 간격으로 인덱스를 건너뛰며 나열 (n 과 서로소인 간격이면 모든 인덱스를 한 번씩 방문)
+// 포인트는 스캔 순서로 쌓여 공간적으로 이어져 있으므로 앞쪽 일부만 그려도 청크 전체에 고르게 퍼짐
+static void writeLodOrder(const MapChunk* chunk, PointMapVertex* out){
+  uint32_t n = chunk->count;
+  uint32_t step = (uint32_t)(n * 0.6180339887);
+  if(step == 0){
+    step = 1;
+  }
+  while(gcd(step, n) != 1){
+    step++;
+  }
+
+  uint32_t index = 0;
+  for(uint32_t j = 0; j < n; ++j){
+    out[j] = chunk->vertices[index];
+    index += step;
+    if(index >= n){
+      index -= n;
+    }
+  }
+}
+
+size_t takePointMapUpdates(PointMap* map, PointMapChunkData** updates){
+  *updates = NULL;
+  if(map->dirtyCount == 0){
+    return 0;
+  }
+
+  PointMapChunkData* out = (PointMapChunkData*)calloc(map->dirtyCount, sizeof(PointMapChunkData));
+  if(!out){
+    return 0;
+  }
+
+  size_t n = 0;
+  for(size_t i = 0; i < map->dirtyCount; ++i){
+    MapChunk* chunk = map->chunks[map->dirty[i]];
+    PointMapChunkData* data = &out[n];
+    memcpy(data->key, chunk->key, sizeof(data->key));
+    if(chunk->count > 0){
+      data->vertices = (PointMapVertex*)malloc(chunk->count * sizeof(PointMapVertex));
+      if(!data->vertices){
+        continue; // 변경 표시를 남겨 다음 호출에서 다시 시도
+      }
+      writeLodOrder(chunk, data->vertices);
+      data->count = chunk->count;
+    }
+    chunk->dirty = 0;
+    n++;
+  }
+
+  // 실패한 청크만 남김
+  size_t remaining = 0;
+  for(size_t i = 0; i < map->dirtyCount; ++i){
+    if(map->chunks[map->dirty[i]]->dirty){
+      map->dirty[remaining++] = map->dirty[i];
+    }
+  }
+  map->dirtyCount = remaining;
+
+  *updates = out;
+  return n;
+}
+
+void freePointMapChunkData(PointMapChunkData* data){
+  free(data->vertices);
+  data->vertices = NULL;
+  data->count = 0;
+}
+
+// 옥트리 노드 (청크 단위 정수 좌표, 한 변은 2 의 거듭제곱)
+typedef struct{
+  int32_t min[3];
+  int32_t size;
+  int32_t child[8];
+  int32_t leaf;              // size == 1 인 노드의 잎 인덱스 (-1 이면 없음)
+} MapOctreeNode;
+
+struct MapOctree{
+  float chunkSize;
+  MapOctreeNode* nodes;
+  size_t nodeCount;
+  size_t nodeCapacity;
+  int32_t root;
+  MapOctreeLeaf** leaves;
+  size_t leafCount;
+  size_t leafCapacity;
+  MapDrawItem* items;
+  size_t itemCount;
+  size_t itemCapacity;
+};
+
+MapOctree* createMapOctree(float chunk_size){
+  MapOctree* tree = (MapOctree*)calloc(1, sizeof(MapOctree));
+  if(!tree){
+    perror("calloc map octree");
+    return NULL;
+  }
+  tree->chunkSize = chunk_size > 0.0f ? chunk_size : 2.0f;
+  tree->root = -1;
+  return tree;
+}
+
+void resetMapOctree(MapOctree* tree){
+  for(size_t i = 0; i < tree->leafCount; ++i){
+    free(tree->leaves[i]);
+  }
+  tree->leafCount = 0;
+  tree->nodeCount = 0;
+  tree->root = -1;
+}
+
+void destroyMapOctree(MapOctree* tree){
+  if(!tree){
+    return;
+  }
+  resetMapOctree(tree);
+  free(tree->nodes);
+  free(tree->leaves);
+  free(tree->items);
+  free(tree);
+}
+
+static int32_t newOctreeNode(MapOctree* tree, const int32_t min[3], int32_t size){
+  if(tree->nodeCount == tree->nodeCapacity){
+    size_t capacity = tree->nodeCapacity ? tree->nodeCapacity * 2 : 256;
+    MapOctreeNode* nodes = (MapOctreeNode*)realloc(tree->nodes, capacity * sizeof(MapOctreeNode));
+    if(!nodes){
+      return -1;
+    }
+    tree->nodes = nodes;
+    tree->nodeCapacity = capacity;
+  }
+  MapOctreeNode* node = &tree->nodes[tree->nodeCount];
+  memcpy(node->min, min, sizeof(node->min));
+  node->size = size;
+  for(int i = 0; i < 8; ++i){
+    node->child[i] = -1;
+  }
+  node->leaf = -1;
+  return (int32_t)tree->nodeCount++;
+}
+
+static int nodeContains(const MapOctreeNode* node, const int32_t key[3]){
+  for(int a = 0; a < 3; ++a){
+    if(key[a] < node->min[a] || key[a] >= node->min[a] + node->size){
+      return 0;
+    }
+  }
+  return 1;
+}
+
+MapOctreeLeaf* findMapOctreeLeaf(MapOctree* tree, const int32_t key[3], int create){
+  if(tree->root < 0){
+    if(!create){
+      return NULL;
+    }
+    tree->root = newOctreeNode(tree, key, 1);
+    if(tree->root < 0){
+      return NULL;
+    }
+  }
+
+  // 루트가 청크를 포함할 때까지 한 변을 두 배로 키움 (기존 루트는 새 루트의 자식)
+  while(!nodeContains(&tree->nodes[tree->root], key)){
+    if(!create){
+      return NULL;
+    }
+    MapOctreeNode old = tree->nodes[tree->root];
+    if(old.size >= (1 << 30)){
+      return NULL;
+    }
+    int32_t min[3];
+    int childIndex = 0;
+    for(int a = 0; a < 3; ++a){
+      min[a] = key[a] < old.min[a] ? old.min[a] - old.size : old.min[a];
+      if(min[a] != old.min[a]){
+        childIndex |= 1 << a;
+      }
+    }
+    int32_t root = newOctreeNode(tree, min, old.size * 2);
+    if(root < 0){
+      return NULL;
+    }
+    tree->nodes[root].child[childIndex] = tree->root;
+    tree->root = root;
+  }
+
+  int32_t index = tree->root;
+  while(tree->nodes[index].size > 1){
+    MapOctreeNode* node = &tree->nodes[index];
+    int32_t half = node->size / 2;
+    int childIndex = 0;
+    int32_t min[3];
+    for(int a = 0; a < 3; ++a){
+      min[a] = node->min[a];
+      if(key[a] >= node->min[a] + half){
+        childIndex |= 1 << a;
+        min[a] += half;
+      }
+    }
+    int32_t child = node->child[childIndex];
+    if(child < 0){
+      if(!create){
+        return NULL;
+      }
+      child = newOctreeNode(tree, min, half); // node 포인터는 여기서 무효화될 수 있음
+      if(child < 0){
+        return NULL;
+      }
+      tree->nodes[index].child[childIndex] = child;
+    }
+    index = child;
+  }
+
+  MapOctreeNode* node = &tree->nodes[index];
+  if(node->leaf < 0){
+    if(!create){
+      return NULL;
+    }
+    if(tree->leafCount == tree->leafCapacity){
+      size_t capacity = tree->leafCapacity ? tree->leafCapacity * 2 : 256;
+      MapOctreeLeaf** leaves = (MapOctreeLeaf**)realloc(tree->leaves, capacity * sizeof(MapOctreeLeaf*));
+      if(!leaves){
+        return NULL;
+      }
+      tree->leaves = leaves;
+      tree->leafCapacity = capacity;
+    }
+    MapOctreeLeaf* leaf = (MapOctreeLeaf*)calloc(1, sizeof(MapOctreeLeaf));
+    if(!leaf){
+      return NULL;
+    }
+    memcpy(leaf->key, key, sizeof(leaf->key));
+    node->leaf = (int32_t)tree->leafCount;
+    tree->leaves[tree->leafCount++] = leaf;
+  }
+  return tree->leaves[node->leaf];
+}
+
+void forEachMapOctreeLeaf(MapOctree* tree, void (*visit)(MapOctreeLeaf* leaf, void* user_data), void* user_data){
+  for(size_t i = 0; i < tree->leafCount; ++i){
+    visit(tree->leaves[i], user_data);
+  }
+}
+
+typedef struct{
+  float planes[6][4];
+  float eye[3];
+  float lodDistance2;
+  size_t points;
+} CullState;
+
+static int pushDrawItem(MapOctree* tree, MapOctreeLeaf* leaf, uint32_t count){
+  if(tree->itemCount == tree->itemCapacity){
+    size_t capacity = tree->itemCapacity ? tree->itemCapacity * 2 : 256;
+    MapDrawItem* items = (MapDrawItem*)realloc(tree->items, capacity * sizeof(MapDrawItem));
+    if(!items){
+      return 0;
+    }
+    tree->items = items;
+    tree->itemCapacity = capacity;
+  }
+  tree->items[tree->itemCount].leaf = leaf;
+  tree->items[tree->itemCount].count = count;
+  tree->itemCount++;
+  return 1;
+}
+
+// inside: 부모가 절두체 안에 완전히 들어 있으면 평면 검사 생략
+static void cullOctreeNode(MapOctree* tree, int32_t index, CullState* state, int inside){
+  const MapOctreeNode* node = &tree->nodes[index];
+  float mn[3], mx[3];
+  for(int a = 0; a < 3; ++a){
+    mn[a] = node->min[a] * tree->chunkSize;
+    mx[a] = (node->min[a] + node->size) * tree->chunkSize;
+  }
+
+  if(!inside){
+    inside = 1;
+    for(int p = 0; p < 6; ++p){
+      const float* plane = state->planes[p];
+      // 평면 법선 방향으로 가장 먼 꼭짓점이 바깥이면 상자 전체가 바깥
+      float far = plane[3], near = plane[3];
+      for(int a = 0; a < 3; ++a){
+        far += plane[a] * (plane[a] > 0.0f ? mx[a] : mn[a]);
+        near += plane[a] * (plane[a] > 0.0f ? mn[a] : mx[a]);
+      }
+      if(far < 0.0f){
+        return;
+      }
+      if(near < 0.0f){
+        inside = 0;
+      }
+    }
+  }
+
+  if(node->size > 1){
+    for(int i = 0; i < 8; ++i){
+      if(node->child[i] >= 0){
+        cullOctreeNode(tree, node->child[i], state, inside);
+        node = &tree->nodes[index];
+      }
+    }
+    return;
+  }
+
+  if(node->leaf < 0){
+    return;
+  }
+  MapOctreeLeaf* leaf = tree->leaves[node->leaf];
+  if(leaf->count == 0 || !leaf->buffer){
+    return;
+  }
+
+  // 카메라에서 상자까지 거리 (상자 안이면 0)
+  float distance2 = 0.0f;
+  for(int a = 0; a < 3; ++a){
+    float d = state->eye[a] < mn[a] ? mn[a] - state->eye[a] : (state->eye[a] > mx[a] ? state->eye[a] - mx[a] : 0.0f);
+    distance2 += d * d;
+  }
+  uint32_t count = leaf->count;
+  if(distance2 > state->lodDistance2){
+    count = (uint32_t)(leaf->count * (state->lodDistance2 / distance2));
+    uint32_t minimum = leaf->count < MAP_MIN_LOD_POINTS ? leaf->count : MAP_MIN_LOD_POINTS;
+    if(count < minimum){
+      count = minimum;
+    }
+  }
+  if(pushDrawItem(tree, leaf, count)){
+    state->points += count;
+  }
+}
+
+const MapDrawItem* cullMapOctree(MapOctree* tree, const float* view_proj, const float* eye, float lod_distance,
+                                 size_t render_budget, size_t* count, size_t* points){
+  tree->itemCount = 0;
+  *count = 0;
+  *points = 0;
+  if(tree->root < 0){
+    return tree->items;
+  }
+
+  // 클립 좌표 = view_proj * 월드 좌표, 행 i 는 view_proj[j * 4 + i]
+  CullState state;
+  const float* m = view_proj;
+  for(int p = 0; p < 6; ++p){
+    int row = p / 2;
+    float sign = (p & 1) ? -1.0f : 1.0f;
+    float length2 = 0.0f;
+    for(int j = 0; j < 4; ++j){
+      state.planes[p][j] = m[j * 4 + 3] + sign * m[j * 4 + row];
+      if(j < 3){
+        length2 += state.planes[p][j] * state.planes[p][j];
+      }
+    }
+    float inv = length2 > 0.0f ? 1.0f / sqrtf(length2) : 1.0f;
+    for(int j = 0; j < 4; ++j){
+      state.planes[p][j] *= inv;
+    }
+  }
+  memcpy(state.eye, eye, sizeof(state.eye));
+  state.lodDistance2 = lod_distance * lod_distance;
+  state.points = 0;
+
+  cullOctreeNode(tree, tree->root, &state, 0);
+
+  // 예산을 넘으면 모든 청크를 같은 비율로 줄임 (청크마다 최소 포인트는 유지)
+  if(render_budget > 0 && state.points > render_budget){
+    double scale = (double)render_budget / state.points;
+    state.points = 0;
+    for(size_t i = 0; i < tree->itemCount; ++i){
+      MapDrawItem* item = &tree->items[i];
+      uint32_t minimum = item->count < MAP_MIN_LOD_POINTS ? item->count : MAP_MIN_LOD_POINTS;
+      uint32_t scaled = (uint32_t)(item->count * scale);
+      item->count = scaled < minimum ? minimum : scaled;
+      state.points += item->count;
+    }
+  }
+
+  *count = tree->itemCount;
+  *points = state.points;
+  return tree->items;
+}
@@ -0,0 +1,105 @@
+#ifndef MAP_MODULE_H
+#define MAP_MODULE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../KernelModule/kernelModule.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 누적 포인트 지도 옵션
+typedef struct{
+  float voxelSize;        // 기본 복셀 크기 (m), 같은 복셀에 들어온 포인트는 평균으로 병합
+  float chunkSize;        // 청크 (옥트리 잎 노드, GPU 버퍼 단위) 한 변 길이 (m)
+  size_t pointBudget;     // 지도 전체 최대 포인트 수, 넘으면 카메라에서 먼 청크부터 복셀을 두 배로 키워 병합
+  size_t renderBudget;    // 프레임당 최대 렌더링 포인트 수
+  float lodDistance;      // 이 거리 (m) 안의 청크는 모두 그리고, 밖은 거리 제곱에 반비례해 줄임
+  float minDepth;         // 통합할 깊이 범위 (m)
+  float maxDepth;
+  int pixelStride;        // 통합할 때 픽셀 간격 (1 이면 모든 픽셀)
+} PointMapOptions;
+
+void setDefaultPointMapOptions(PointMapOptions* options);
+
+// GPU 로 그대로 올리는 정점 형식 (16 바이트)
+typedef struct{
+  float x, y, z;
+  uint8_t r, g, b, a;
+} PointMapVertex;
+
+// 변경된 청크의 정점 배열 (LOD 순서: 앞쪽 일부만 그려도 청크 전체에 고르게 퍼져 있음)
+typedef struct{
+  int32_t key[3];            // 청크 격자 좌표 (월드 좌표 / chunkSize 내림)
+  PointMapVertex* vertices;  // count 개, freePointMapChunkData 로 해제
+  uint32_t count;
+} PointMapChunkData;
+
+typedef struct PointMap PointMap;
+
+// 지도 생성 / 해제 (스레드 안전하지 않음, 한 스레드에서만 사용)
+PointMap* createPointMap(const PointMapOptions* options);
+void destroyPointMap(PointMap* map);
+
+// 모든 포인트 제거 (청크 메모리도 해제)
+void resetPointMap(PointMap* map);
+
+// 깊이 + 색상 프레임을 Twc (카메라 -> 월드, column-major 4x4) 로 변환해 누적
+// rays 는 프레임 해상도의 광선 테이블, 누적 뒤 포인트 예산을 넘으면 먼 청크부터 복셀 병합
+// 반환값: 누적한 포인트 수
+size_t integratePointMap(PointMap* map, const RayTable* rays, const uint16_t* depth, const uint8_t* rgb,
+                         const float* Twc);
+
+// 지도 전체 포인트 수 / 청크 수
+size_t getPointMapSize(const PointMap* map);
+size_t getPointMapChunkCount(const PointMap* map);
+
+// 지도가 할당한 전체 바이트 수 (청크 배열 용량 + 복셀 해시 + 청크 표)
+size_t getPointMapMemory(const PointMap* map);
+
+// 마지막 호출 이후 바뀐 청크를 LOD 순서 정점 배열로 내보냄
+// 반환값: *updates 에 담긴 개수 (배열과 각 정점 배열은 호출한 쪽이 해제)
+size_t takePointMapUpdates(PointMap* map, PointMapChunkData** updates);
+void freePointMapChunkData(PointMapChunkData* data);
+
+// 청크 옥트리 (렌더링 쪽 전용, 잎 노드마다 GPU 버퍼 하나)
+// 청크는 chunkSize 격자에 고정되어 있으므로 잎 노드를 추가하기만 하고 옮기지 않음
+typedef struct{
+  int32_t key[3];
+  uint32_t buffer;        // 렌더러의 버퍼 이름 (0 이면 없음)
+  uint32_t count;         // 버퍼의 포인트 수
+} MapOctreeLeaf;
+
+// 이번 프레임에 그릴 잎 노드와 포인트 수 (LOD 적용)
+typedef struct{
+  MapOctreeLeaf* leaf;
+  uint32_t count;
+} MapDrawItem;
+
+typedef struct MapOctree MapOctree;
+
+MapOctree* createMapOctree(float chunk_size);
+void destroyMapOctree(MapOctree* tree);
+
+// 청크 좌표의 잎 노드 찾기 (create 가 1 이면 없을 때 만들고, 필요하면 루트를 키움)
+// 반환된 포인터는 트리를 해제하거나 초기화할 때까지 유효
+MapOctreeLeaf* findMapOctreeLeaf(MapOctree* tree, const int32_t key[3], int create);
+
+// 모든 잎 노드 방문 (GPU 버퍼 해제용)
+void forEachMapOctreeLeaf(MapOctree* tree, void (*visit)(MapOctreeLeaf* leaf, void* user_data), void* user_data);
+
+// 모든 노드 제거
+void resetMapOctree(MapOctree* tree);
+
+// 절두체 컬링 + 거리 LOD
+// view_proj: 투영 * 모델뷰 (column-major, 월드 좌표 기준), eye: 월드 좌표 카메라 위치
+// 반환값: 그릴 항목 배열 (트리 소유, 다음 호출까지 유효), *count 항목 수, *points 전체 포인트 수
+const MapDrawItem* cullMapOctree(MapOctree* tree, const float* view_proj, const float* eye, float lod_distance,
+                                 size_t render_budget, size_t* count, size_t* points);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MAP_MODULE_H
@@ -0,0 +1,180 @@
+#include "monitorModule.h"
+#include "../frameDefinitions.h"
+
+#include <fcntl.h>
+#include <mqueue.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <time.h>
+
+// 공유 카운터 블록 (모든 갱신은 relaxed, 읽는 쪽은 근사 값이면 충분)
+static atomic_uint_fast64_t monitorCounters[MONITOR_COUNTER_COUNT];
+static atomic_int slamState = -1;
+static atomic_uint slamTrackUs = 0;
+
+// 스레드별 CPU 시계 (등록할 때마다 세대 증가, 홀수 세대만 유효)
+static clockid_t threadClocks[MONITOR_THREAD_COUNT];
+static atomic_uint threadGenerations[MONITOR_THREAD_COUNT];
+
+void monitorAdd(MonitorCounter counter, uint64_t value){
+  if(counter < 0 || counter >= MONITOR_COUNTER_COUNT){
+    return;
+  }
+  atomic_fetch_add_explicit(&monitorCounters[counter], value, memory_order_relaxed);
+}
+
+void monitorSetSlam(int tracking_state, float track_ms){
+  atomic_store_explicit(&slamTrackUs, track_ms > 0.0f ? (unsigned)(track_ms * 1000.0f) : 0u, memory_order_relaxed);
+  atomic_store_explicit(&slamState, tracking_state, memory_order_relaxed);
+  monitorAdd(MONITOR_SLAM_FRAMES, 1);
+}
+
+void monitorRegisterThread(MonitorThread thread){
+  if(thread < 0 || thread >= MONITOR_THREAD_COUNT){
+    return;
+  }
+  clockid_t clock;
+  if(pthread_getcpuclockid(pthread_self(), &clock) != 0){
+    return;
+  }
+
+  // 짝수 세대 -> 시계 기록 -> 홀수 세대 게시 (읽는 쪽은 세대가 같을 때만 시계 사용)
+  unsigned generation = atomic_load_explicit(&threadGenerations[thread], memory_order_relaxed);
+  if(generation & 1u){
+    generation++;
+    atomic_store_explicit(&threadGenerations[thread], generation, memory_order_relaxed);
+  }
+  atomic_thread_fence(memory_order_release);
+  threadClocks[thread] = clock;
+  atomic_store_explicit(&threadGenerations[thread], generation + 1, memory_order_release);
+}
+
+void monitorUnregisterThread(MonitorThread thread){
+  if(thread < 0 || thread >= MONITOR_THREAD_COUNT){
+    return;
+  }
+  // 다른 파이프라인의 같은 종류 스레드가 나중에 등록했으면 그대로 둠
+  clockid_t clock;
+  if(pthread_getcpuclockid(pthread_self(), &clock) != 0 || clock != threadClocks[thread]){
+    return;
+  }
+  unsigned generation = atomic_load_explicit(&threadGenerations[thread], memory_order_relaxed);
+  if(generation & 1u){
+    atomic_store_explicit(&threadGenerations[thread], generation + 1, memory_order_release);
+  }
+}
+
+static double monitorNow(void){
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// 큐를 읽기 전용으로 열어 둠 (메세지는 꺼내지 않고 mq_getattr 로 길이만 확인)
+static int queueDepth(int* queue, const char* name, int* capacity){
+  if(*queue == -1){
+    *queue = (int)mq_open(name, O_RDONLY | O_NONBLOCK);
+    if(*queue == -1){
+      return -1;
+    }
+  }
+  struct mq_attr attr;
+  if(mq_getattr((mqd_t)*queue, &attr) != 0){
+    mq_close((mqd_t)*queue);
+    *queue = -1;
+    return -1;
+  }
+  *capacity = (int)attr.mq_maxmsg;
+  return (int)attr.mq_curmsgs;
+}
+
+void initMonitorSampler(MonitorSampler* sampler){
+  memset(sampler, 0, sizeof(*sampler));
+  sampler->sensorQueue = -1;
+  sampler->viewerQueue = -1;
+  setMonitorSamplerPipeline(sampler, NULL);
+}
+
+void setMonitorSamplerPipeline(MonitorSampler* sampler, const char* pipeline){
+  closeMonitorSampler(sampler);
+  PipelineQueueNames names;
+  makePipelineQueueNames(&names, pipeline);
+  snprintf(sampler->sensorQueueName, sizeof(sampler->sensorQueueName), "%s", names.sensorToLogger);
+  snprintf(sampler->viewerQueueName, sizeof(sampler->viewerQueueName), "%s", names.loggerToViewer);
+}
+
+void closeMonitorSampler(MonitorSampler* sampler){
+  if(sampler->sensorQueue != -1){
+    mq_close((mqd_t)sampler->sensorQueue);
+  }
+  if(sampler->viewerQueue != -1){
+    mq_close((mqd_t)sampler->viewerQueue);
+  }
+  sampler->sensorQueue = sampler->viewerQueue = -1;
+}
+
+void sampleMonitor(MonitorSampler* sampler, MonitorStats* stats){
+  memset(stats, 0, sizeof(*stats));
+
+  double now = monitorNow();
+  double interval = sampler->time > 0.0 ? now - sampler->time : 0.0;
+  sampler->time = now;
+  stats->interval = interval;
+
+  uint64_t delta[MONITOR_COUNTER_COUNT];
+  for(int i = 0; i < MONITOR_COUNTER_COUNT; ++i){
+    uint64_t value = atomic_load_explicit(&monitorCounters[i], memory_order_relaxed);
+    delta[i] = value - sampler->counters[i];
+    sampler->counters[i] = value;
+  }
+
+  double rate = interval > 0.0 ? 1.0 / interval : 0.0;
+  stats->captureFps = (float)(delta[MONITOR_CAPTURED_FRAMES] * rate);
+  stats->viewerFps = (float)(delta[MONITOR_VIEWER_FRAMES] * rate);
+  stats->renderFps = (float)(delta[MONITOR_RENDERED_FRAMES] * rate);
+  stats->slamFps = (float)(delta[MONITOR_SLAM_FRAMES] * rate);
+  stats->recordMBps = (float)(delta[MONITOR_RECORDED_BYTES] * rate / (1024.0 * 1024.0));
+  stats->sensorMBps = (float)(delta[MONITOR_SENSOR_BYTES] * rate / (1024.0 * 1024.0));
+  stats->viewerMBps = (float)(delta[MONITOR_VIEWER_BYTES] * rate / (1024.0 * 1024.0));
+  stats->captureDropped = sampler->counters[MONITOR_CAPTURE_DROPPED];
+  stats->loggerDropped = sampler->counters[MONITOR_LOGGER_DROPPED];
+  stats->viewerDropped = sampler->counters[MONITOR_VIEWER_DROPPED];
+
+  stats->queueCapacity = 0;
+  stats->sensorQueueDepth = queueDepth(&sampler->sensorQueue, sampler->sensorQueueName, &stats->queueCapacity);
+  stats->viewerQueueDepth = queueDepth(&sampler->viewerQueue, sampler->viewerQueueName, &stats->queueCapacity);
+
+  stats->slamState = atomic_load_explicit(&slamState, memory_order_relaxed);
+  stats->slamTrackMs = atomic_load_explicit(&slamTrackUs, memory_order_relaxed) / 1000.0f;
+
+  for(int i = 0; i < MONITOR_THREAD_COUNT; ++i){
+    stats->threadCpu[i] = -1.0f;
+
+    unsigned generation = atomic_load_explicit(&threadGenerations[i], memory_order_acquire);
+    if(!(generation & 1u)){
+      sampler->threadGeneration[i] = generation;
+      continue;
+    }
+    clockid_t clock = threadClocks[i];
+    atomic_thread_fence(memory_order_acquire);
+    if(atomic_load_explicit(&threadGenerations[i], memory_order_relaxed) != generation){
+      continue; // 등록이 바뀌는 중, 다음 샘플에서 측정
+    }
+
+    struct timespec ts;
+    if(clock_gettime(clock, &ts) != 0){
+      continue;
+    }
+    uint64_t cpuNs = (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+
+    // 새로 등록된 스레드는 이번 샘플을 기준점으로 사용
+    if(sampler->threadGeneration[i] == generation && interval > 0.0){
+      stats->threadCpu[i] = (float)((cpuNs - sampler->cpuTimeNs[i]) / (interval * 1e7));
+    }else{
+      stats->threadCpu[i] = 0.0f;
+    }
+    sampler->cpuTimeNs[i] = cpuNs;
+    sampler->threadGeneration[i] = generation;
+  }
+}
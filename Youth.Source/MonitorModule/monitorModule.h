@@ -0,0 +1,96 @@
+#ifndef MONITOR_MODULE_H
+#define MONITOR_MODULE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 파이프라인 공유 카운터 (각 모듈이 락 없이 갱신, 뷰어 HUD 가 주기적으로 읽음)
+// 갱신은 relaxed 원자 연산 하나이므로 프레임 경로에서 호출해도 비용이 거의 없음
+typedef enum{
+  MONITOR_CAPTURED_FRAMES = 0,   // 센서가 전송한 프레임
+  MONITOR_CAPTURE_DROPPED,       // 센서 전송 실패로 버린 프레임
+  MONITOR_LOGGER_DROPPED,        // 로거 -> 뷰어 전달 실패 메세지
+  MONITOR_RECORDED_FRAMES,       // 녹화된 프레임
+  MONITOR_RECORDED_BYTES,        // 녹화된 바이트
+  MONITOR_VIEWER_FRAMES,         // 뷰어가 완성한 프레임
+  MONITOR_VIEWER_DROPPED,        // 뷰어가 버린 불완전 프레임
+  MONITOR_RENDERED_FRAMES,       // 뷰어가 그린 프레임
+  MONITOR_SLAM_FRAMES,           // SLAM 이 추적한 프레임
+  MONITOR_SENSOR_BYTES,          // 센서 -> 로거 큐로 보낸 영상 바이트
+  MONITOR_VIEWER_BYTES,          // 로거 -> 뷰어 큐로 보낸 영상 바이트
+  MONITOR_COUNTER_COUNT
+} MonitorCounter;
+
+// CPU 사용률을 측정하는 스레드
+typedef enum{
+  MONITOR_THREAD_SENSOR = 0,
+  MONITOR_THREAD_LOGGER,
+  MONITOR_THREAD_PLAYBACK,
+  MONITOR_THREAD_VIEWER,
+  MONITOR_THREAD_VIEWER_RECEIVE,
+  MONITOR_THREAD_SLAM,
+  MONITOR_THREAD_COUNT
+} MonitorThread;
+
+// 카운터 증가 (임의의 스레드)
+void monitorAdd(MonitorCounter counter, uint64_t value);
+
+// SLAM 마지막 프레임 상태 (SLAM.h 의 추적 상태 값) 및 추적 시간
+void monitorSetSlam(int tracking_state, float track_ms);
+
+// 호출한 스레드를 CPU 사용률 측정 대상으로 등록 / 해제 (스레드 시작과 종료 시 호출)
+// 같은 종류의 스레드가 여러 개면 (파이프라인 여러 개) 마지막으로 등록한 스레드를 측정
+void monitorRegisterThread(MonitorThread thread);
+void monitorUnregisterThread(MonitorThread thread);
+
+// 샘플링 결과 (직전 샘플 이후의 비율)
+typedef struct{
+  double interval;          // 직전 샘플 이후 경과 시간 (초)
+  float captureFps;
+  float viewerFps;          // 뷰어가 수신한 프레임
+  float renderFps;          // 뷰어가 그린 프레임
+  float slamFps;
+  float recordMBps;
+  float sensorMBps;         // 센서 -> 로거 큐
+  float viewerMBps;         // 로거 -> 뷰어 큐
+  int sensorQueueDepth;     // 센서 -> 로거 큐 메세지 수 (-1: 큐 없음)
+  int viewerQueueDepth;     // 로거 -> 뷰어 큐 메세지 수
+  int queueCapacity;
+  uint64_t captureDropped;  // 누적 값
+  uint64_t loggerDropped;
+  uint64_t viewerDropped;
+  int slamState;            // -1: 프레임 없음
+  float slamTrackMs;
+  float threadCpu[MONITOR_THREAD_COUNT]; // 한 코어 대비 %, 실행 중이 아니면 -1
+} MonitorStats;
+
+// 샘플러 (읽는 쪽 스레드 전용 상태)
+typedef struct{
+  uint64_t counters[MONITOR_COUNTER_COUNT];
+  uint64_t cpuTimeNs[MONITOR_THREAD_COUNT];
+  uint32_t threadGeneration[MONITOR_THREAD_COUNT];
+  double time;
+  int sensorQueue;
+  int viewerQueue;
+  char sensorQueueName[64];  // 길이를 확인할 큐 (기본 파이프라인의 MQ_*)
+  char viewerQueueName[64];
+} MonitorSampler;
+
+void initMonitorSampler(MonitorSampler* sampler);
+
+// 큐 길이를 확인할 파이프라인 (NULL 또는 "" 이면 기본 큐, makePipelineQueueNames 참고)
+// 카운터와 스레드 CPU 사용률은 프로세스 전체 값
+void setMonitorSamplerPipeline(MonitorSampler* sampler, const char* pipeline);
+void closeMonitorSampler(MonitorSampler* sampler);
+
+// 카운터와 스레드 CPU 시간을 읽어 비율 계산 (첫 호출은 기준점만 잡고 비율은 0)
+void sampleMonitor(MonitorSampler* sampler, MonitorStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MONITOR_MODULE_H
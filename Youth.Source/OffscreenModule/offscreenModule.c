@@ -0,0 +1,270 @@
+#include "offscreenModule.h"
+
+#define EGL_NO_X11
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
+// 서피스 없는 EGL 디스플레이 얻기 (X / Wayland 서버 불필요)
+static EGLDisplay getOffscreenDisplay(){
+  const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+  PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+    (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+
+  if(getPlatformDisplay && clientExtensions && strstr(clientExtensions, "EGL_MESA_platform_surfaceless")){
+    EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+    if(display != EGL_NO_DISPLAY){
+      return display;
+    }
+  }
+  return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+int createOffscreenContext(OffscreenContext* ctx, int major, int minor, int profile){
+  memset(ctx, 0, sizeof(*ctx));
+
+  EGLDisplay display = getOffscreenDisplay();
+  if(display == EGL_NO_DISPLAY){
+    fprintf(stderr, "Offscreen: no EGL display\n");
+    return 0;
+  }
+
+  EGLint eglMajor, eglMinor;
+  if(!eglInitialize(display, &eglMajor, &eglMinor)){
+    fprintf(stderr, "Offscreen: eglInitialize failed (0x%x)\n", eglGetError());
+    return 0;
+  }
+
+  if(!eglBindAPI(EGL_OPENGL_API)){
+    fprintf(stderr, "Offscreen: desktop OpenGL not supported by EGL\n");
+    eglTerminate(display);
+    return 0;
+  }
+
+  // 서피스를 만들지 않으므로 서피스 타입은 상관없음 (FBO 에만 그림)
+  const EGLint configAttribs[] = {
+    EGL_SURFACE_TYPE, 0,
+    EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+    EGL_NONE
+  };
+  EGLConfig config = NULL;
+  EGLint numConfigs = 0;
+  if(!eglChooseConfig(display, configAttribs, &config, 1, &numConfigs) || numConfigs < 1){
+    config = NULL; // EGL_KHR_no_config_context
+  }
+
+  EGLint contextAttribs[7];
+  int n = 0;
+  if(major > 0){
+    contextAttribs[n++] = EGL_CONTEXT_MAJOR_VERSION;
+    contextAttribs[n++] = major;
+    contextAttribs[n++] = EGL_CONTEXT_MINOR_VERSION;
+    contextAttribs[n++] = minor;
+    contextAttribs[n++] = EGL_CONTEXT_OPENGL_PROFILE_MASK;
+    contextAttribs[n++] = profile == OFFSCREEN_PROFILE_CORE ? EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT
+                                                            : EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT;
+  }
+  contextAttribs[n] = EGL_NONE;
+
+  EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+  if(context == EGL_NO_CONTEXT){
+    fprintf(stderr, "Offscreen: eglCreateContext failed (0x%x)\n", eglGetError());
+    eglTerminate(display);
+    return 0;
+  }
+
+  // EGL_KHR_surfaceless_context
+  if(!eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)){
+    fprintf(stderr, "Offscreen: eglMakeCurrent failed (0x%x)\n", eglGetError());
+    eglDestroyContext(display, context);
+    eglTerminate(display);
+    return 0;
+  }
+
+  printf("Offscreen EGL %d.%d context created\n", eglMajor, eglMinor);
+  ctx->display = display;
+  ctx->context = context;
+  return 1;
+}
+
+void destroyOffscreenContext(OffscreenContext* ctx){
+  if(!ctx->display){
+    return;
+  }
+  eglMakeCurrent(ctx->display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+  if(ctx->context){
+    eglDestroyContext(ctx->display, ctx->context);
+  }
+  eglTerminate(ctx->display);
+  ctx->display = NULL;
+  ctx->context = NULL;
+}
+
+int createOffscreenTarget(OffscreenTarget* target, int width, int height){
+  memset(target, 0, sizeof(*target));
+
+  if(width > 0 && height > 0){
+    glGenFramebuffers(1, &target->fbo);
+    glGenRenderbuffers(1, &target->colorBuffer);
+    glGenRenderbuffers(1, &target->depthBuffer);
+
+    glBindRenderbuffer(GL_RENDERBUFFER, target->colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, target->depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, target->fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, target->colorBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, target->depthBuffer);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if(status != GL_FRAMEBUFFER_COMPLETE){
+      fprintf(stderr, "Offscreen: framebuffer incomplete (0x%x)\n", status);
+      destroyOffscreenTarget(target);
+      return 0;
+    }
+    target->width = width;
+    target->height = height;
+  }
+
+  glGenBuffers(OFFSCREEN_READBACK_SLOTS, target->pbo);
+  return 1;
+}
+
+void destroyOffscreenTarget(OffscreenTarget* target){
+  for(int i = 0; i < OFFSCREEN_READBACK_SLOTS; ++i){
+    if(target->fence[i]){
+      glDeleteSync(target->fence[i]);
+    }
+  }
+  if(target->pbo[0]){
+    glDeleteBuffers(OFFSCREEN_READBACK_SLOTS, target->pbo);
+  }
+  if(target->fbo){
+    glDeleteFramebuffers(1, &target->fbo);
+  }
+  if(target->colorBuffer){
+    glDeleteRenderbuffers(1, &target->colorBuffer);
+  }
+  if(target->depthBuffer){
+    glDeleteRenderbuffers(1, &target->depthBuffer);
+  }
+  memset(target, 0, sizeof(*target));
+}
+
+void bindOffscreenTarget(const OffscreenTarget* target){
+  glBindFramebuffer(GL_FRAMEBUFFER, target->fbo);
+}
+
+int queueOffscreenReadback(OffscreenTarget* target, int width, int height, uint32_t frame_id){
+  if(width <= 0 || height <= 0){
+    return 0;
+  }
+
+  // 링이 가득 차면 렌더링 루프를 멈추지 않고 이번 프레임 읽기를 건너뜀
+  if(target->pending == OFFSCREEN_READBACK_SLOTS){
+    target->dropped++;
+    return 0;
+  }
+
+  int slot = target->head;
+  size_t size = (size_t)width * height * 4;
+
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, target->pbo[slot]);
+  if(target->pboSize[slot] != size){
+    glBufferData(GL_PIXEL_PACK_BUFFER, size, NULL, GL_STREAM_READ);
+    target->pboSize[slot] = size;
+  }
+  glPixelStorei(GL_PACK_ALIGNMENT, 4);
+  glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, 0); // PBO 로 복사, 즉시 반환
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  target->fence[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  target->readWidth[slot] = width;
+  target->readHeight[slot] = height;
+  target->frameId[slot] = frame_id;
+  target->head = (slot + 1) % OFFSCREEN_READBACK_SLOTS;
+  target->pending++;
+  return 1;
+}
+
+int collectOffscreenReadbacks(OffscreenTarget* target, int wait, OffscreenImageCallback callback, void* user_data){
+  int delivered = 0;
+
+  while(target->pending > 0){
+    int slot = (target->head - target->pending + OFFSCREEN_READBACK_SLOTS) % OFFSCREEN_READBACK_SLOTS;
+
+    GLenum result = glClientWaitSync(target->fence[slot], GL_SYNC_FLUSH_COMMANDS_BIT,
+                                     wait ? (GLuint64)1000000000 : 0);
+    if(result == GL_TIMEOUT_EXPIRED){
+      break; // 아직 GPU 작업 중 - 다음 프레임에서 다시 확인
+    }
+    glDeleteSync(target->fence[slot]);
+    target->fence[slot] = 0;
+    target->pending--;
+
+    if(result == GL_WAIT_FAILED || !callback){
+      continue;
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, target->pbo[slot]);
+    const uint8_t* pixels = (const uint8_t*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, target->pboSize[slot],
+                                                             GL_MAP_READ_BIT);
+    if(pixels){
+      callback(pixels, target->readWidth[slot], target->readHeight[slot], target->frameId[slot], user_data);
+      glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+      delivered++;
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  }
+
+  return delivered;
+}
+
+int writeOffscreenImagePPM(const char* file, const uint8_t* rgba, int width, int height){
+  char tempFile[512];
+  snprintf(tempFile, sizeof(tempFile), "%s.tmp", file);
+
+  FILE* fp = fopen(tempFile, "wb");
+  if(!fp){
+    perror("Offscreen: fopen");
+    return 0;
+  }
+
+  uint8_t* row = (uint8_t*)malloc((size_t)width * 3);
+  if(!row){
+    fclose(fp);
+    return 0;
+  }
+
+  fprintf(fp, "P6\n%d %d\n255\n", width, height);
+  for(int y = height - 1; y >= 0; --y){
+    const uint8_t* src = rgba + (size_t)y * width * 4;
+    for(int x = 0; x < width; ++x){
+      row[x * 3] = src[x * 4];
+      row[x * 3 + 1] = src[x * 4 + 1];
+      row[x * 3 + 2] = src[x * 4 + 2];
+    }
+    fwrite(row, 1, (size_t)width * 3, fp);
+  }
+  free(row);
+
+  int ok = !ferror(fp);
+  if(fclose(fp) != 0){
+    ok = 0;
+  }
+  if(!ok || rename(tempFile, file) != 0){
+    perror("Offscreen: write image");
+    remove(tempFile);
+    return 0;
+  }
+  return 1;
+}
@@ -0,0 +1,79 @@
+#ifndef OFFSCREEN_MODULE_H
+#define OFFSCREEN_MODULE_H
+
+#include <GL/glew.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// EGL 오프스크린 GL 컨텍스트 (X 서버 없이 렌더링, 서피스 없이 FBO 에만 그림)
+typedef struct{
+  void* display;  // EGLDisplay
+  void* context;  // EGLContext
+} OffscreenContext;
+
+#define OFFSCREEN_PROFILE_COMPAT 0  // 고정 파이프라인 사용 가능 (viewerModule)
+#define OFFSCREEN_PROFILE_CORE 1    // 코어 프로파일 (Youth::Viewer)
+
+// 오프스크린 컨텍스트 생성 후 현재 스레드에 바인딩
+// EGL_MESA_platform_surfaceless 가 있으면 사용하고, 없으면 기본 EGL 디스플레이 사용
+// major, minor: 요청 GL 버전 (0 이면 드라이버 기본값)
+// 반환값: 성공 시 1, 실패 시 0
+int createOffscreenContext(OffscreenContext* ctx, int major, int minor, int profile);
+void destroyOffscreenContext(OffscreenContext* ctx);
+
+// 비동기 읽기 링 크기 (렌더링 후 최대 이만큼의 프레임 뒤에 결과가 나옴)
+#define OFFSCREEN_READBACK_SLOTS 3
+
+// FBO 렌더 타깃 + PBO 비동기 읽기 링
+typedef struct{
+  GLuint fbo;
+  GLuint colorBuffer;
+  GLuint depthBuffer;
+  int width, height;                           // FBO 크기 (0 이면 FBO 없음, 기본 프레임버퍼에서 읽기)
+
+  GLuint pbo[OFFSCREEN_READBACK_SLOTS];
+  size_t pboSize[OFFSCREEN_READBACK_SLOTS];
+  GLsync fence[OFFSCREEN_READBACK_SLOTS];
+  int readWidth[OFFSCREEN_READBACK_SLOTS];
+  int readHeight[OFFSCREEN_READBACK_SLOTS];
+  uint32_t frameId[OFFSCREEN_READBACK_SLOTS];
+  int head;                                    // 다음에 채울 슬롯
+  int pending;                                 // 완료를 기다리는 읽기 수
+  uint32_t dropped;                            // 링이 가득 차 건너뛴 읽기 수
+} OffscreenTarget;
+
+// 읽기 완료 콜백 (렌더링 스레드에서 호출, rgba 는 콜백 동안만 유효, 행 순서는 OpenGL 과 같이 아래에서 위로)
+typedef void (*OffscreenImageCallback)(const uint8_t* rgba, int width, int height, uint32_t frame_id,
+                                       void* user_data);
+
+// 렌더 타깃 생성 (GL 컨텍스트가 현재 스레드에 바인딩되어 있어야 함)
+// width, height 가 0 이면 FBO 없이 읽기 링만 생성 (창 모드에서 백 버퍼 읽기용)
+// 반환값: 성공 시 1, 실패 시 0
+int createOffscreenTarget(OffscreenTarget* target, int width, int height);
+void destroyOffscreenTarget(OffscreenTarget* target);
+
+// FBO 를 그리기/읽기 대상으로 바인딩 (FBO 가 없으면 기본 프레임버퍼)
+void bindOffscreenTarget(const OffscreenTarget* target);
+
+// 현재 읽기 프레임버퍼의 (0, 0, width, height) 영역을 PBO 로 비동기 복사 시작 (대기 없음)
+// 반환값: 시작하면 1, 링이 가득 차 건너뛰면 0
+int queueOffscreenReadback(OffscreenTarget* target, int width, int height, uint32_t frame_id);
+
+// 완료된 읽기를 오래된 순서로 콜백에 전달
+// wait: 1 이면 남은 읽기가 모두 끝날 때까지 대기, 0 이면 완료된 것만 처리
+// 반환값: 전달한 프레임 수
+int collectOffscreenReadbacks(OffscreenTarget* target, int wait, OffscreenImageCallback callback, void* user_data);
+
+// RGBA (아래에서 위로) 영상을 바이너리 PPM 으로 저장 (임시 파일에 쓴 뒤 rename, 읽는 쪽이 반쯤 쓴 파일을 보지 않음)
+// 반환값: 성공 시 1, 실패 시 0
+int writeOffscreenImagePPM(const char* file, const uint8_t* rgba, int width, int height);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OFFSCREEN_MODULE_H
@@ -3,10 +3,26 @@
 #include "astra_wrapper.h"
 #include <astra/astra.hpp>
 #include <iostream>
+#include <mutex>
 
 // For WebGL
 // #include <nlohmann/json.hpp>
 
+// Pick a stream mode by size, fps and pixel format from the modes the device reports
+template <typename Stream>
+static bool selectStreamMode(Stream& stream, int width, int height, int fps, astra_pixel_format_t format)
+{
+    for (const astra::ImageStreamMode& mode : stream.available_modes())
+    {
+        if (mode.width() == width && mode.height() == height && mode.fps() == fps && mode.pixel_format() == format)
+        {
+            stream.set_mode(mode);
+            return true;
+        }
+    }
+    return false;
+}
+
 extern "C" {
 
 struct AstraContext {
@@ -14,24 +30,87 @@ struct AstraContext {
     astra::StreamReader* reader;
 };
 
+// Astra SDK is process-wide, count open devices
+static std::mutex astraMutex;
+static int astraOpenCount = 0;
+
 AstraContext_t* InitializeAstraObj()
 {
+    return InitializeAstraDevice(NULL);
+}
+
+AstraContext_t* InitializeAstraDevice(const char* uri)
+{
+    return InitializeAstraDeviceMode(uri, 0, 0, 0);
+}
+
+AstraContext_t* InitializeAstraDeviceMode(const char* uri, int width, int height, int fps)
+{
+    std::lock_guard<std::mutex> lock(astraMutex);
+
     // Initial Astra SDK
-    astra::initialize();
+    if (astraOpenCount++ == 0)
+    {
+        astra::initialize();
+    }
     AstraContext_t* context = new AstraContext_t;
-    context->streamSet = new astra::StreamSet();
+    context->streamSet = uri ? new astra::StreamSet(uri) : new astra::StreamSet();
     context->reader = new astra::StreamReader(context->streamSet->create_reader());
-    context->reader->stream<astra::DepthStream>().start();
-    context->reader->stream<astra::ColorStream>().start();
+    auto depthStream = context->reader->stream<astra::DepthStream>();
+    auto colorStream = context->reader->stream<astra::ColorStream>();
+    if (width > 0 && height > 0)
+    {
+        if (!selectStreamMode(depthStream, width, height, fps, ASTRA_PIXEL_FORMAT_DEPTH_MM) ||
+            !selectStreamMode(colorStream, width, height, fps, ASTRA_PIXEL_FORMAT_RGB888))
+        {
+            std::cout << "Stream mode " << width << "x" << height << "@" << fps
+                      << " not supported, using the default mode" << std::endl;
+        }
+    }
+    depthStream.start();
+    colorStream.start();
     return context;
 }
 
 void TerminateAstraObj(AstraContext_t* context)
 {
+    std::lock_guard<std::mutex> lock(astraMutex);
     delete context->reader;
     delete context->streamSet;
     delete context;
-    astra::terminate();
+    if (--astraOpenCount == 0)
+    {
+        astra::terminate();
+    }
+}
+
+int GetFrameAstra(AstraContext_t* context, int timeout_ms, const int16_t** depth, const uint8_t** color, int* width,
+                  int* height, uint32_t* frame_index)
+{
+    astra::Frame frame = context->reader->get_latest_frame(timeout_ms);
+    if (!frame.is_valid())
+    {
+        return 0;
+    }
+    auto depthFrame = frame.get<astra::DepthFrame>();
+    auto colorFrame = frame.get<astra::ColorFrame>();
+
+    if (!depthFrame.is_valid() || !colorFrame.is_valid())
+    {
+        return 0;
+    }
+    if (depthFrame.width() != colorFrame.width() || depthFrame.height() != colorFrame.height())
+    {
+        std::cout << "Depth / color size mismatch...!" << std::endl;
+        return 0;
+    }
+
+    *width = depthFrame.width();
+    *height = depthFrame.height();
+    *depth = depthFrame.data();
+    *color = reinterpret_cast<const uint8_t*>(colorFrame.data());
+    *frame_index = static_cast<uint32_t>(depthFrame.frame_index());
+    return 1;
 }
 
 // For OpenGL - Depth
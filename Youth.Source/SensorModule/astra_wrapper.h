@@ -14,6 +14,20 @@ void TerminateAstraObj(AstraContext_t* context);
 const int16_t* GetDepthDataAstraOpenGL(AstraContext_t* context, int* width, int* height);
 const uint8_t* GetColorDataAstraOpenGL(AstraContext_t* context, int* width, int* height);
 
+// Open a specific device ("device/sensor0", "device/sensor1", ... NULL for "device/default")
+// Several devices can be open at once, the SDK is initialized with the first and terminated with the last
+AstraContext_t* InitializeAstraDevice(const char* uri);
+
+// Same as InitializeAstraDevice with a depth / color stream mode (width, height, fps)
+// width 0 keeps the SDK default mode, an unsupported mode is reported and the default is used
+AstraContext_t* InitializeAstraDeviceMode(const char* uri, int width, int height, int fps);
+
+// Wait up to timeout_ms for the next frame and return depth and color of the same frame
+// frame_index: device frame counter (for device clock recovery)
+// Returns 1 on success, 0 on timeout, invalid frame or depth / color size mismatch
+int GetFrameAstra(AstraContext_t* context, int timeout_ms, const int16_t** depth, const uint8_t** color, int* width,
+                  int* height, uint32_t* frame_index);
+
 #ifdef __cplusplus
 }
 #endif
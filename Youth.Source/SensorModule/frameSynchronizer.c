@@ -0,0 +1,324 @@
+#include "frameSynchronizer.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// 장치와 호스트 시계 차이 허용량 (프레임당 us, 30 FPS 에서 약 60 ppm)
+#define DEVICE_CLOCK_DRIFT_US 2
+
+// 대기열 칸 상태
+enum{
+  SLOT_FREE = 0,
+  SLOT_FILLING,   // 캡처 스레드가 복사 중
+  SLOT_QUEUED,    // 묶음 대기
+  SLOT_HELD       // 묶음으로 보내는 중
+};
+
+typedef struct{
+  SyncFrame slots[SYNC_QUEUE_DEPTH];
+  int state[SYNC_QUEUE_DEPTH];
+  size_t capacity[SYNC_QUEUE_DEPTH];   // 칸별 할당된 픽셀 수
+  int order[SYNC_QUEUE_DEPTH];         // 대기 중인 칸 (오래된 순)
+  int queued;
+  int active;
+  uint64_t lastPushUs;
+} SyncCamera;
+
+struct FrameSynchronizer{
+  int cameraCount;
+  uint64_t toleranceUs;
+  uint64_t staleUs;
+  SyncCamera cameras[MAX_SENSOR_CAMERAS];
+  uint32_t nextSetId;
+  int wake;
+  FrameSyncStats stats;
+
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+};
+
+uint64_t syncNowUs(void){
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000ull + ts.tv_nsec / 1000;
+}
+
+void initDeviceClock(DeviceClock* clock, int fps){
+  memset(clock, 0, sizeof(*clock));
+  clock->periodUs = 1000000 / (fps > 0 ? fps : 30);
+}
+
+uint64_t deviceClockStamp(DeviceClock* clock, uint32_t device_frame, uint64_t arrival_us){
+  int64_t offset = (int64_t)arrival_us - (int64_t)device_frame * clock->periodUs;
+  if(!clock->valid || device_frame <= clock->lastFrame){
+    // 첫 프레임이거나 장치가 다시 시작됨
+    clock->offsetUs = offset;
+    clock->valid = 1;
+  }else{
+    int64_t drifted = clock->offsetUs + (int64_t)(device_frame - clock->lastFrame) * DEVICE_CLOCK_DRIFT_US;
+    clock->offsetUs = offset < drifted ? offset : drifted;
+  }
+  clock->lastFrame = device_frame;
+  return (uint64_t)(clock->offsetUs + (int64_t)device_frame * clock->periodUs);
+}
+
+FrameSynchronizer* createFrameSynchronizer(int camera_count, uint64_t tolerance_us, uint64_t stale_us){
+  if(camera_count < 1 || camera_count > MAX_SENSOR_CAMERAS){
+    fprintf(stderr, "Camera count %d out of range (1 ~ %d)\n", camera_count, MAX_SENSOR_CAMERAS);
+    return NULL;
+  }
+
+  FrameSynchronizer* sync = (FrameSynchronizer*)calloc(1, sizeof(FrameSynchronizer));
+  if(!sync){
+    perror("calloc frame synchronizer");
+    return NULL;
+  }
+
+  sync->cameraCount = camera_count;
+  sync->toleranceUs = tolerance_us;
+  sync->staleUs = stale_us ? stale_us : tolerance_us * 10;
+  // 아직 프레임이 없는 카메라도 생성 시각부터 stale 판정 (장치 열기에 실패한 카메라를 기다리지 않음)
+  const uint64_t now = syncNowUs();
+  for(int c = 0; c < camera_count; ++c){
+    sync->cameras[c].active = 1;
+    sync->cameras[c].lastPushUs = now;
+  }
+
+  // 대기 시간은 syncNowUs 와 같은 단조 시계로 계산
+  pthread_condattr_t attr;
+  pthread_condattr_init(&attr);
+  pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+  pthread_mutex_init(&sync->mutex, NULL);
+  pthread_cond_init(&sync->cond, &attr);
+  pthread_condattr_destroy(&attr);
+  return sync;
+}
+
+void destroyFrameSynchronizer(FrameSynchronizer* sync){
+  if(!sync){
+    return;
+  }
+  for(int c = 0; c < sync->cameraCount; ++c){
+    for(int i = 0; i < SYNC_QUEUE_DEPTH; ++i){
+      free(sync->cameras[c].slots[i].depth);
+      free(sync->cameras[c].slots[i].color);
+    }
+  }
+  pthread_mutex_destroy(&sync->mutex);
+  pthread_cond_destroy(&sync->cond);
+  free(sync);
+}
+
+// 대기열 맨 앞 칸 제거 (잠금 상태에서 호출)
+static void popQueued(SyncCamera* camera, int next_state){
+  camera->state[camera->order[0]] = next_state;
+  camera->queued--;
+  memmove(camera->order, camera->order + 1, camera->queued * sizeof(int));
+}
+
+int frameSyncPush(FrameSynchronizer* sync, int camera_id, uint32_t device_frame, uint64_t timestamp_us,
+                  const int16_t* depth, const uint8_t* color, int width, int height){
+  if(camera_id < 0 || camera_id >= sync->cameraCount || width <= 0 || height <= 0){
+    return 0;
+  }
+  SyncCamera* camera = &sync->cameras[camera_id];
+
+  // 빈 칸 확보 (없으면 가장 오래된 대기 프레임을 버림)
+  pthread_mutex_lock(&sync->mutex);
+  int slot = -1;
+  for(int i = 0; i < SYNC_QUEUE_DEPTH && slot < 0; ++i){
+    if(camera->state[i] == SLOT_FREE) slot = i;
+  }
+  if(slot < 0 && camera->queued > 0){
+    slot = camera->order[0];
+    popQueued(camera, SLOT_FREE);
+    sync->stats.dropped[camera_id]++;
+  }
+  if(slot < 0){
+    pthread_mutex_unlock(&sync->mutex);
+    return 0;
+  }
+  camera->state[slot] = SLOT_FILLING;
+  pthread_mutex_unlock(&sync->mutex);
+
+  // 복사는 잠금 밖에서
+  SyncFrame* frame = &camera->slots[slot];
+  size_t pixels = (size_t)width * height;
+  int ok = 1;
+  if(camera->capacity[slot] < pixels){
+    int16_t* newDepth = (int16_t*)realloc(frame->depth, pixels * sizeof(int16_t));
+    if(newDepth) frame->depth = newDepth;
+    uint8_t* newColor = (uint8_t*)realloc(frame->color, pixels * 3);
+    if(newColor) frame->color = newColor;
+    ok = newDepth && newColor;
+    if(ok) camera->capacity[slot] = pixels;
+  }
+  if(ok){
+    frame->cameraId = camera_id;
+    frame->deviceFrame = device_frame;
+    frame->timestampUs = timestamp_us;
+    frame->width = width;
+    frame->height = height;
+    memcpy(frame->depth, depth, pixels * sizeof(int16_t));
+    memcpy(frame->color, color, pixels * 3);
+  }
+
+  pthread_mutex_lock(&sync->mutex);
+  if(ok){
+    camera->state[slot] = SLOT_QUEUED;
+    camera->order[camera->queued++] = slot;
+    camera->lastPushUs = syncNowUs();
+    sync->stats.pushed[camera_id]++;
+    pthread_cond_signal(&sync->cond);
+  }else{
+    camera->state[slot] = SLOT_FREE;
+  }
+  pthread_mutex_unlock(&sync->mutex);
+  return ok;
+}
+
+void frameSyncSetActive(FrameSynchronizer* sync, int camera_id, int active){
+  if(camera_id < 0 || camera_id >= sync->cameraCount){
+    return;
+  }
+  pthread_mutex_lock(&sync->mutex);
+  sync->cameras[camera_id].active = active;
+  pthread_cond_signal(&sync->cond);
+  pthread_mutex_unlock(&sync->mutex);
+}
+
+static uint64_t headTimestamp(const SyncCamera* camera){
+  return camera->slots[camera->order[0]].timestampUs;
+}
+
+static uint64_t distanceUs(uint64_t a, uint64_t b){
+  return a > b ? a - b : b - a;
+}
+
+// 묶음 만들기 시도 (잠금 상태에서 호출)
+// 반환값: 1 묶음 완성, 0 프레임을 더 기다려야 함
+static int tryMatch(FrameSynchronizer* sync, SyncSet* set){
+  const uint64_t now = syncNowUs();
+  int members[MAX_SENSOR_CAMERAS];
+  int memberCount = 0;
+  int stalled = 0;
+  for(int c = 0; c < sync->cameraCount; ++c){
+    SyncCamera* camera = &sync->cameras[c];
+    if(!camera->active) continue;
+    if(camera->queued > 0){
+      members[memberCount++] = c;
+    }else if(now - camera->lastPushUs < sync->staleUs){
+      // 곧 프레임이 올 카메라 (대기)
+      return 0;
+    }else{
+      stalled = 1;
+    }
+  }
+  if(memberCount == 0){
+    return 0;
+  }
+
+  // 가장 늦은 맨 앞 프레임을 기준으로, 기준보다 tolerance 이상 이른 프레임은 짝이 없으므로 버리고
+  // 기준에 더 가까운 다음 프레임이 있으면 그쪽을 사용 (기준이 바뀌면 다시 계산)
+  for(;;){
+    uint64_t reference = 0;
+    for(int m = 0; m < memberCount; ++m){
+      uint64_t head = headTimestamp(&sync->cameras[members[m]]);
+      if(head > reference) reference = head;
+    }
+
+    int changed = 0;
+    for(int m = 0; m < memberCount; ++m){
+      const int c = members[m];
+      SyncCamera* camera = &sync->cameras[c];
+      while(camera->queued > 0){
+        uint64_t head = headTimestamp(camera);
+        int tooEarly = head + sync->toleranceUs < reference;
+        int closerNext = camera->queued > 1 &&
+                         distanceUs(camera->slots[camera->order[1]].timestampUs, reference) <= distanceUs(head, reference);
+        if(!tooEarly && !closerNext) break;
+        popQueued(camera, SLOT_FREE);
+        sync->stats.dropped[c]++;
+        changed = 1;
+      }
+      if(camera->queued == 0){
+        return 0;
+      }
+    }
+    if(!changed) break;
+  }
+
+  // 묶음 완성
+  memset(set, 0, sizeof(*set));
+  uint64_t earliest = UINT64_MAX;
+  for(int m = 0; m < memberCount; ++m){
+    SyncCamera* camera = &sync->cameras[members[m]];
+    SyncFrame* frame = &camera->slots[camera->order[0]];
+    popQueued(camera, SLOT_HELD);
+    set->frames[members[m]] = frame;
+    set->count++;
+    if(frame->timestampUs > set->timestampUs) set->timestampUs = frame->timestampUs;
+    if(frame->timestampUs < earliest) earliest = frame->timestampUs;
+  }
+  set->spreadUs = set->timestampUs - earliest;
+  set->setId = sync->nextSetId++;
+
+  sync->stats.sets++;
+  sync->stats.partialSets += stalled;
+  sync->stats.spreadSumUs += set->spreadUs;
+  if(set->spreadUs > sync->stats.spreadMaxUs) sync->stats.spreadMaxUs = set->spreadUs;
+  return 1;
+}
+
+int frameSyncWait(FrameSynchronizer* sync, SyncSet* set, int timeout_ms){
+  const uint64_t deadline = syncNowUs() + (uint64_t)timeout_ms * 1000;
+
+  int matched = 0;
+  pthread_mutex_lock(&sync->mutex);
+  while(!sync->wake){
+    matched = tryMatch(sync, set);
+    if(matched) break;
+
+    uint64_t now = syncNowUs();
+    if(now >= deadline) break;
+
+    // 멈춘 카메라를 판정할 수 있도록 stale 시간보다 길게 자지 않음
+    uint64_t until = now + sync->staleUs < deadline ? now + sync->staleUs : deadline;
+    struct timespec wait;
+    wait.tv_sec = until / 1000000ull;
+    wait.tv_nsec = (until % 1000000ull) * 1000;
+    pthread_cond_timedwait(&sync->cond, &sync->mutex, &wait);
+  }
+  sync->wake = 0;
+  pthread_mutex_unlock(&sync->mutex);
+  return matched;
+}
+
+void frameSyncRelease(FrameSynchronizer* sync, SyncSet* set){
+  pthread_mutex_lock(&sync->mutex);
+  for(int c = 0; c < sync->cameraCount; ++c){
+    SyncFrame* frame = set->frames[c];
+    if(frame){
+      SyncCamera* camera = &sync->cameras[c];
+      camera->state[frame - camera->slots] = SLOT_FREE;
+      set->frames[c] = NULL;
+    }
+  }
+  set->count = 0;
+  pthread_mutex_unlock(&sync->mutex);
+}
+
+void frameSyncWake(FrameSynchronizer* sync){
+  pthread_mutex_lock(&sync->mutex);
+  sync->wake = 1;
+  pthread_cond_broadcast(&sync->cond);
+  pthread_mutex_unlock(&sync->mutex);
+}
+
+void getFrameSyncStats(FrameSynchronizer* sync, FrameSyncStats* stats){
+  pthread_mutex_lock(&sync->mutex);
+  *stats = sync->stats;
+  pthread_mutex_unlock(&sync->mutex);
+}
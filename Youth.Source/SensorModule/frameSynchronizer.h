@@ -0,0 +1,92 @@
+#ifndef FRAME_SYNCHRONIZER_H
+#define FRAME_SYNCHRONIZER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MAX_SENSOR_CAMERAS 4
+#define SYNC_QUEUE_DEPTH 4      // 카메라별 대기 프레임 수 (묶음으로 보내는 중인 프레임 포함)
+
+// 단조 시계 (us), 캡처 타임스템프 기준
+uint64_t syncNowUs(void);
+
+// 장치 시계 복원
+// 장치 프레임 번호는 간격이 정확하고 도착 시각은 USB 전달 지연만큼 늦게 흔들리므로
+// 도착 시각 - 번호 * 간격 의 최솟값을 오프셋으로 잡아 번호 * 간격 + 오프셋 을 노출 시각으로 사용
+// 오프셋은 프레임마다 조금씩 늘려 장치와 호스트 시계의 차이 (drift) 를 따라감
+typedef struct{
+  int64_t periodUs;     // 공칭 프레임 간격
+  int64_t offsetUs;
+  uint32_t lastFrame;
+  int valid;
+} DeviceClock;
+
+void initDeviceClock(DeviceClock* clock, int fps);
+
+// device_frame: 장치 프레임 번호 (건너뛴 번호 허용, 줄어들면 장치 재시작으로 보고 다시 맞춤)
+// arrival_us: 프레임을 받은 시각 (syncNowUs)
+// 반환값: 복원된 장치 타임스템프 (us, syncNowUs 기준)
+uint64_t deviceClockStamp(DeviceClock* clock, uint32_t device_frame, uint64_t arrival_us);
+
+// 동기화 대기열의 프레임 (버퍼는 동기화기가 소유)
+typedef struct{
+  int cameraId;
+  uint32_t deviceFrame;
+  uint64_t timestampUs;
+  int width, height;
+  int16_t* depth;
+  uint8_t* color;
+} SyncFrame;
+
+// 시간이 맞춰진 프레임 묶음 (카메라 번호 순서, 늦거나 멈춘 카메라는 NULL)
+typedef struct{
+  uint32_t setId;
+  uint64_t timestampUs;   // 묶음 기준 시각 (가장 늦은 프레임)
+  uint64_t spreadUs;      // 묶음 안 최대 - 최소 타임스템프
+  int count;
+  SyncFrame* frames[MAX_SENSOR_CAMERAS];
+} SyncSet;
+
+typedef struct{
+  uint64_t pushed[MAX_SENSOR_CAMERAS];
+  uint64_t dropped[MAX_SENSOR_CAMERAS];   // 짝이 없거나 대기열이 넘쳐 버린 프레임
+  uint64_t sets;
+  uint64_t partialSets;                   // 멈춘 카메라를 빼고 만든 묶음
+  uint64_t spreadSumUs;
+  uint64_t spreadMaxUs;
+} FrameSyncStats;
+
+typedef struct FrameSynchronizer FrameSynchronizer;
+
+// 타임스템프가 tolerance_us 안에 드는 카메라별 프레임을 하나씩 묶음
+// stale_us 동안 프레임이 없는 카메라는 묶음에서 빼고 나머지만 묶음 (0 이면 tolerance_us * 10)
+// 반환값: 실패 시 NULL
+FrameSynchronizer* createFrameSynchronizer(int camera_count, uint64_t tolerance_us, uint64_t stale_us);
+void destroyFrameSynchronizer(FrameSynchronizer* sync);
+
+// 캡처 스레드: 프레임을 복사해 카메라 대기열에 추가 (빈 칸이 없으면 가장 오래된 프레임을 버림)
+// 반환값: 성공 시 1, 잘못된 카메라 번호나 할당 실패 시 0
+int frameSyncPush(FrameSynchronizer* sync, int camera_id, uint32_t device_frame, uint64_t timestamp_us,
+                  const int16_t* depth, const uint8_t* color, int width, int height);
+
+// 캡처를 멈춘 카메라는 비활성으로 표시해 기다리지 않도록 함
+void frameSyncSetActive(FrameSynchronizer* sync, int camera_id, int active);
+
+// 다음 묶음을 최대 timeout_ms 동안 대기
+// 반환값: 묶음이 있으면 1 (frameSyncRelease 로 반납), 시간 초과나 frameSyncWake 이면 0
+int frameSyncWait(FrameSynchronizer* sync, SyncSet* set, int timeout_ms);
+void frameSyncRelease(FrameSynchronizer* sync, SyncSet* set);
+
+// 대기 중인 frameSyncWait 깨우기 (종료용)
+void frameSyncWake(FrameSynchronizer* sync);
+
+void getFrameSyncStats(FrameSynchronizer* sync, FrameSyncStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FRAME_SYNCHRONIZER_H
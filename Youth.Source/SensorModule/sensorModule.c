@@ -1,6 +1,9 @@
 #include "sensorModule.h"
 #include "astra_wrapper.h"
+#include "frameSynchronizer.h"
+#include "syntheticCamera.h"
 #include "../frameDefinitions.h"
+#include "../MonitorModule/monitorModule.h"
 #include <pthread.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -9,29 +12,160 @@
 #include <fcntl.h>
 #include <sys/stat.h>
 #include <unistd.h>
-#include <sys/time.h>
+#include <time.h>
+
+// 캡처 스레드 처리 단계 시간
+typedef struct{
+  uint64_t frames;
+  uint64_t usSum;
+  uint64_t usMax;
+} StageTiming;
+
+// 카메라 하나의 캡처 상태 (캡처 스레드 전용)
+typedef struct{
+  SensorContext* sensor;
+  int cameraId;
+
+  // Astra Context (합성 카메라면 NULL)
+  AstraContext_t* astra;
+  SyntheticCamera synthetic;
+
+  // 장치 프레임 번호 -> 타임스템프
+  DeviceClock clock;
+
+  // 렌즈 왜곡 보정 리맵 테이블 (첫 프레임 크기로 생성)
+  UndistortMap depthUndistort, colorUndistort;
+  uint16_t* undistortedDepth;
+  uint8_t* undistortedColor;
+  int undistortWidth, undistortHeight;
+  StageTiming undistortTiming;
+
+  // 깊이 필터 (시간 평활 이력 포함, 첫 프레임 크기로 생성)
+  DepthFilter* depthFilter;
+  uint16_t* filteredDepth;
+  int filterWidth, filterHeight;
+  StageTiming filterTiming;
+
+  // 깊이 -> 색상 정합 (첫 프레임 크기로 생성)
+  DepthRegistration* registration;
+  uint16_t* registeredDepth;
+  int registrationWidth, registrationHeight;
+  StageTiming registrationTiming;
+
+  // 관심 영역 / 해상도 줄임 (전송 직전)
+  FramePyramid pyramid;
+  StageTiming decimationTiming;
+
+  pthread_t threadId;
+  int threadStarted;
+
+  // 에러 카운터
+  int errorCounter;
+} SensorCamera;
+
+// Sensor Context (파이프라인마다 하나)
+struct SensorContext{
+  SensorOptions options;
+  char pipeline[MAX_PIPELINE_NAME];
+  PipelineQueueNames queues;
+
+  // 카메라별 캡처 스레드 -> 동기화기 -> 전송 스레드
+  SensorCamera cameras[MAX_SENSOR_CAMERAS];
+  FrameSynchronizer* sync;
+  int openCameras;      // 아직 캡처 중인 카메라 수
+
+  // Message Queue Handle
+  mqd_t mqSend;
+
+  // Thread Control Variable
+  int running;
+  int threadStarted;
+  pthread_t threadId;
+
+  // 뮤텍스 (openCameras)
+  pthread_mutex_t mutex;
+};
 
-// Sensor Context
-AstraContext_t* sensorContext = NULL;
+static const int MAX_CONSECUTIVE_ERRORS = 5;
 
-// Message Queue Handle
-mqd_t mqSend = -1;
+// 장치 프레임 대기 시간 (ms)
+#define SENSOR_FRAME_TIMEOUT_MS 100
+
+// 캡처 프로필 (Astra 가 지원하는 깊이 / 색상 공통 모드)
+static const SensorCaptureProfile captureProfiles[] = {
+  {"vga", 640, 480, 30},
+  {"qvga", 320, 240, 30},
+  {"qvga60", 320, 240, 60},
+};
+
+// 정합할 깊이 범위 (m)
+#define SENSOR_REGISTRATION_MIN_DEPTH 0.1f
+#define SENSOR_REGISTRATION_MAX_DEPTH 20.0f
+
+// 기본 컨텍스트 (initSensorModule 등 기존 함수가 사용)
+static SensorContext defaultSensor;
+static pthread_once_t defaultSensorOnce = PTHREAD_ONCE_INIT;
+
+int findSensorCaptureProfile(const char* name, SensorCaptureProfile* profile){
+  for(size_t i = 0; i < sizeof(captureProfiles) / sizeof(captureProfiles[0]); ++i){
+    if(name && strcmp(name, captureProfiles[i].name) == 0){
+      *profile = captureProfiles[i];
+      return 1;
+    }
+  }
+  return 0;
+}
 
-// Thread Control Variable;
-static int sensorIsRunning = 1;
+void setDefaultSensorOptions(SensorOptions* options){
+  options->pipeline = NULL;
+  options->cameraCount = 1;
+  options->synthetic = 0;
+  options->syncToleranceMs = 17;
+  setDefaultDepthFilterOptions(&options->depthFilter);
+  options->depthFilter.stages = 0;
+  options->undistort = 0;
+  options->registerDepth = 0;
+  setDefaultDepthColorCalibration(&options->calibration, 640, 480);
+  options->registrationThreads = 2;
+  options->capture = captureProfiles[0];
+  memset(&options->roi, 0, sizeof(FrameRoi));
+  options->decimation = 1;
+}
 
-// 에러 카운터
-static int errorCounter = 0;
-static const int MAX_CONSECUTIVE_ERRORS = 5;
+// 옵션 적용 (파이프라인 이름은 컨텍스트에 복사)
+static void applySensorOptions(SensorContext* sensor, const SensorOptions* options){
+  sensor->options = *options;
+  snprintf(sensor->pipeline, sizeof(sensor->pipeline), "%s", options->pipeline ? options->pipeline : "");
+  sensor->options.pipeline = sensor->pipeline;
+  if(sensor->options.cameraCount < 1) sensor->options.cameraCount = 1;
+  if(sensor->options.cameraCount > MAX_SENSOR_CAMERAS) sensor->options.cameraCount = MAX_SENSOR_CAMERAS;
+  if(sensor->options.syncToleranceMs < 1) sensor->options.syncToleranceMs = 1;
+  if(sensor->options.capture.width <= 0 || sensor->options.capture.height <= 0 || sensor->options.capture.fps <= 0){
+    sensor->options.capture = captureProfiles[0];
+  }
+  if(decimationLevel(sensor->options.decimation) < 0){
+    printf("Unsupported decimation %d, sending full resolution\n", sensor->options.decimation);
+    sensor->options.decimation = 1;
+  }
+  makePipelineQueueNames(&sensor->queues, sensor->pipeline);
+}
 
-// 뮤텍스
-static pthread_mutex_t sensorMutex = PTHREAD_MUTEX_INITIALIZER;
+static void initSensorContext(SensorContext* sensor, const SensorOptions* options){
+  memset(sensor, 0, sizeof(*sensor));
+  applySensorOptions(sensor, options);
+  sensor->mqSend = (mqd_t)-1;
+  pthread_mutex_init(&sensor->mutex, NULL);
+}
 
-// Get Current Time (ms)
-static uint32_t getCurrentTimeMs(){
-  struct timeval tv;
-  gettimeofday(&tv, NULL);
-  return (uint32_t)(tv.tv_sec * 1000 + tv.tv_usec / 1000);
+static void initDefaultSensor(void){
+  SensorOptions options;
+  setDefaultSensorOptions(&options);
+  initSensorContext(&defaultSensor, &options);
+}
+
+static SensorContext* defaultSensorContext(void){
+  pthread_once(&defaultSensorOnce, initDefaultSensor);
+  return &defaultSensor;
 }
 
 // 안전한 메모리 할당 헬퍼 함수
@@ -46,13 +180,18 @@ static void* safe_malloc(size_t size){
   return ptr;
 }
 
-// 안전한 Astra 센서 초기화
-static AstraContext_t* safeInitializeAstraObj(){
-  printf("Attempting to initialize Astra sensor...\n");
+// 안전한 Astra 센서 초기화 (카메라가 여러 대면 device/sensor<번호>, 한 대면 기본 장치)
+static AstraContext_t* safeInitializeAstraObj(SensorCamera* camera){
+  char uri[32];
+  const int multiple = camera->sensor->options.cameraCount > 1;
+  snprintf(uri, sizeof(uri), "device/sensor%d", camera->cameraId);
+  printf("Attempting to initialize Astra sensor %s...\n", multiple ? uri : "device/default");
 
   // 여러 번 시도
   for(int attempt = 1; attempt <= 3; attempt++){
-    AstraContext_t* context = InitializeAstraObj();
+    const SensorCaptureProfile* capture = &camera->sensor->options.capture;
+    AstraContext_t* context = InitializeAstraDeviceMode(multiple ? uri : NULL, capture->width, capture->height,
+                                                        capture->fps);
     if(context){
       printf("Astra sensor initialized successfully on attempt %d\n", attempt);
       return context;
@@ -66,250 +205,591 @@ static AstraContext_t* safeInitializeAstraObj(){
   return NULL;
 }
 
-void* sensorLoop(void* arg){
-  printf("Sensor thread started...\n");
+// 왜곡 보정 리맵 테이블 해제
+static void releaseUndistortMaps(SensorCamera* camera){
+  destroyUndistortMap(&camera->depthUndistort);
+  destroyUndistortMap(&camera->colorUndistort);
+  free(camera->undistortedDepth);
+  camera->undistortedDepth = NULL;
+  free(camera->undistortedColor);
+  camera->undistortedColor = NULL;
+}
 
-  // Message Queue Feature Setting
-  struct mq_attr attr;
-  attr.mq_flags = 0;
-  attr.mq_maxmsg = 10;
-  attr.mq_msgsize = MAX_MSG_SIZE;
-  attr.mq_curmsgs = 0;
+// 왜곡 보정 / 깊이 필터 / 정합 해제
+static void releaseDepthStages(SensorCamera* camera){
+  releaseUndistortMaps(camera);
+  destroyDepthFilter(camera->depthFilter);
+  camera->depthFilter = NULL;
+  free(camera->filteredDepth);
+  camera->filteredDepth = NULL;
+  destroyDepthRegistration(camera->registration);
+  camera->registration = NULL;
+  free(camera->registeredDepth);
+  camera->registeredDepth = NULL;
+  freeFramePyramid(&camera->pyramid);
+}
 
-  // Message Queue
-  mqSend = mq_open(MQ_SENSOR_TO_LOGGER, O_WRONLY, 0644, &attr);
-  if(mqSend == (mqd_t) - 1){
-    perror("mq_open send");
-    sensorIsRunning = 0;
-    return NULL;
+// 캡처를 끝낸 카메라 정리, 마지막 카메라면 컨텍스트도 멈춤
+static void closeSensorCamera(SensorCamera* camera){
+  SensorContext* sensor = camera->sensor;
+  frameSyncSetActive(sensor->sync, camera->cameraId, 0);
+
+  if(camera->astra){
+    TerminateAstraObj(camera->astra);
+    camera->astra = NULL;
   }
+  closeSyntheticCamera(&camera->synthetic);
+  releaseDepthStages(camera);
 
-  // Initialize Sensor
-  printf("Initializing Astra sensor ...\n");
-  sensorContext = safeInitializeAstraObj();
-  
-  if(!sensorContext){
-    printf("Failed to initialize Astra sensor\n");
-    mq_close(mqSend);
-    sensorIsRunning = 0;
-    return NULL;
+  pthread_mutex_lock(&sensor->mutex);
+  if(--sensor->openCameras == 0){
+    sensor->running = 0;
+    frameSyncWake(sensor->sync);
   }
+  pthread_mutex_unlock(&sensor->mutex);
+}
 
-  // 데이터 청크를 위한 버퍼 할당
-  char* msgBuffer = safe_malloc(MAX_MSG_SIZE);
-  if(!msgBuffer){
-    perror("malloc message buffer");
-    TerminateAstraObj(sensorContext);
-    mq_close(mqSend);
-    sensorIsRunning = 0;
-    return NULL;
+static void recordStageTiming(StageTiming* timing, uint64_t start_us){
+  const uint64_t elapsed = syncNowUs() - start_us;
+  timing->frames++;
+  timing->usSum += elapsed;
+  if(elapsed > timing->usMax) timing->usMax = elapsed;
+}
+
+static void printStageTiming(int camera_id, const char* name, const StageTiming* timing){
+  if(timing->frames > 0){
+    printf("Camera %d %s: %llu frames, %.3f ms avg / %.3f ms max\n", camera_id, name,
+           (unsigned long long)timing->frames, timing->usSum / 1000.0 / timing->frames, timing->usMax / 1000.0);
   }
+}
 
-  int frameId = 0;
-  errorCounter = 0;
+// 깊이 / 색상 렌즈 왜곡 보정 (해상도가 바뀌면 리맵 테이블을 다시 생성)
+// 실패하면 원본을 그대로 둠
+static void undistortSensorFrame(SensorCamera* camera, const int16_t** depth, const uint8_t** color, int width,
+                                 int height){
+  const SensorOptions* options = &camera->sensor->options;
+  if(!options->undistort){
+    return;
+  }
 
-  // Main Loop
-  while(sensorIsRunning){
-    int width = 0, height = 0;
+  if(!camera->undistortedDepth || camera->undistortWidth != width || camera->undistortHeight != height){
+    releaseUndistortMaps(camera);
+    const DepthColorCalibration* calibration = &options->calibration;
+    int ok = createUndistortMap(&camera->depthUndistort, &calibration->depth, &calibration->depthDistortion, width,
+                                height);
+    ok = createUndistortMap(&camera->colorUndistort, &calibration->color, &calibration->colorDistortion, width,
+                            height) && ok;
+    camera->undistortedDepth = (uint16_t*)malloc((size_t)width * height * sizeof(uint16_t));
+    camera->undistortedColor = (uint8_t*)malloc((size_t)width * height * 3);
+    camera->undistortWidth = width;
+    camera->undistortHeight = height;
+    if(!ok || !camera->undistortedDepth || !camera->undistortedColor){
+      printf("Failed to create undistort maps for camera %d\n", camera->cameraId);
+      releaseUndistortMaps(camera);
+      return;
+    }
+  }
 
-    pthread_mutex_lock(&sensorMutex);
-    // Get Data from Sensor
-    const int16_t* depthData = GetDepthDataAstraOpenGL(sensorContext, &width, &height);
-    const uint8_t* colorData = GetColorDataAstraOpenGL(sensorContext, &width, &height);
-    pthread_mutex_unlock(&sensorMutex);
-
-    if(depthData && colorData && width > 0 && height > 0){
-      errorCounter = 0; // 성공적으로 데이터를 받았으므로 에러 카운터 리셋
-
-      frameId++;
-      uint32_t timestamp = getCurrentTimeMs();
-
-      // 1. 메타데이터 메세지 전송
-      MessageHeader* header = (MessageHeader*)msgBuffer;
-      header->msgType = MSG_TYPE_METADATA;
-      header->width = width;
-      header->height = height;
-      header->chunkIndex = 0;
-      header->totalChunks = 0; // 메타데이터에는 의미 없음
-      header->dataSize = 0;
-      header->frameId = frameId;
-      header->timestamp = timestamp;
-
-      if(mq_send(mqSend, msgBuffer, sizeof(MessageHeader), 0) == -1){
-        perror("mq_send metadata");
-        continue;
-      }
+  const uint64_t start = syncNowUs();
+  undistortDepth(&camera->depthUndistort, (const uint16_t*)*depth, camera->undistortedDepth);
+  undistortColor(&camera->colorUndistort, *color, camera->undistortedColor);
+  recordStageTiming(&camera->undistortTiming, start);
+  *depth = (const int16_t*)camera->undistortedDepth;
+  *color = camera->undistortedColor;
+}
 
-      // 2. 깊이 데이터 청크 전송
-      int depthDataSize = width * height * sizeof(int16_t);
-      int maxDataPerMsg = MAX_MSG_SIZE - sizeof(MessageHeader);
-      int totalDepthChunks = (depthDataSize + maxDataPerMsg - 1) / maxDataPerMsg;
-
-      int depthChunkesSuccess = 1;
-      for(int i = 0; i < totalDepthChunks && depthChunkesSuccess; i++){
-        header->msgType = MSG_TYPE_DEPTH_DATA;
-        header->chunkIndex = i;
-        header->totalChunks = totalDepthChunks;
-        header->frameId = frameId;
-        header->timestamp = timestamp;
-
-        int offset = i * maxDataPerMsg;
-        int chunkSize = (i == totalDepthChunks - 1) ? (depthDataSize - offset) : maxDataPerMsg;
-
-        // 안전성 검사 추가
-        if(offset < 0 || offset + chunkSize > depthDataSize){
-          printf("Error: depth chunk offset calculation error\n");
-          depthChunkesSuccess = 0;
-          break;
-        }
+// 깊이 필터 적용 (해상도가 바뀌면 다시 생성), 반환값: 필터 결과 (실패하면 원본)
+static const int16_t* filterSensorDepth(SensorCamera* camera, const int16_t* depth, int width, int height){
+  const DepthFilterOptions* options = &camera->sensor->options.depthFilter;
+  if(options->stages == 0){
+    return depth;
+  }
 
-        header->dataSize = chunkSize;
+  if(!camera->depthFilter || camera->filterWidth != width || camera->filterHeight != height){
+    destroyDepthFilter(camera->depthFilter);
+    free(camera->filteredDepth);
+    camera->depthFilter = createDepthFilter(options, width, height);
+    camera->filteredDepth = (uint16_t*)malloc((size_t)width * height * sizeof(uint16_t));
+    camera->filterWidth = width;
+    camera->filterHeight = height;
+    if(!camera->depthFilter || !camera->filteredDepth){
+      printf("Failed to create depth filter for camera %d\n", camera->cameraId);
+      destroyDepthFilter(camera->depthFilter);
+      camera->depthFilter = NULL;
+      free(camera->filteredDepth);
+      camera->filteredDepth = NULL;
+      return depth;
+    }
+  }
 
-        // 데이터 복사
-        memcpy(msgBuffer + sizeof(MessageHeader), ((const char*)depthData) + offset, chunkSize);
+  const uint64_t start = syncNowUs();
+  applyDepthFilter(camera->depthFilter, (const uint16_t*)depth, camera->filteredDepth);
+  recordStageTiming(&camera->filterTiming, start);
+  return (const int16_t*)camera->filteredDepth;
+}
 
-        if(mq_send(mqSend, msgBuffer, sizeof(MessageHeader) + chunkSize, 0) == -1){
-          perror("mq_send depth chunk");
-          depthChunkesSuccess = 0;
-          break;
-        }
-      }
+// 깊이를 색상 카메라 시점으로 정합 (깊이와 색상 해상도가 같음), 반환값: 정합 결과 (실패하면 원본)
+static const int16_t* registerSensorDepth(SensorCamera* camera, const int16_t* depth, int width, int height){
+  const SensorOptions* options = &camera->sensor->options;
+  if(!options->registerDepth){
+    return depth;
+  }
 
-      // 깊이 데이터 전송에 실패했으면 다음 반복으로
-      if(!depthChunkesSuccess) continue;
+  if(!camera->registration || camera->registrationWidth != width || camera->registrationHeight != height){
+    destroyDepthRegistration(camera->registration);
+    free(camera->registeredDepth);
+    camera->registration = createDepthRegistration(&options->calibration, width, height, width, height,
+                                                   SENSOR_REGISTRATION_MIN_DEPTH, SENSOR_REGISTRATION_MAX_DEPTH,
+                                                   options->registrationThreads);
+    camera->registeredDepth = (uint16_t*)malloc((size_t)width * height * sizeof(uint16_t));
+    camera->registrationWidth = width;
+    camera->registrationHeight = height;
+    if(!camera->registration || !camera->registeredDepth){
+      printf("Failed to create depth registration for camera %d\n", camera->cameraId);
+      destroyDepthRegistration(camera->registration);
+      camera->registration = NULL;
+      free(camera->registeredDepth);
+      camera->registeredDepth = NULL;
+      return depth;
+    }
+  }
 
-      // 3. 색상 데이터 청크 전송
-      int colorDataSize = width * height * 3 * sizeof(uint8_t);
-      int totalColorChunks = (colorDataSize + maxDataPerMsg - 1) / maxDataPerMsg;
+  const uint64_t start = syncNowUs();
+  registerDepthToColor(camera->registration, (const uint16_t*)depth, camera->registeredDepth);
+  recordStageTiming(&camera->registrationTiming, start);
+  return (const int16_t*)camera->registeredDepth;
+}
 
-      for(int i = 0; i < totalColorChunks; i++){
-        header->msgType = MSG_TYPE_COLOR_DATA;
-        header->chunkIndex = i;
-        header->totalChunks = totalColorChunks;
-        header->frameId = frameId;
-        header->timestamp = timestamp;
+// 관심 영역 자르기 / 해상도 줄임 (전송 직전, 설정이 없으면 그대로)
+static void decimateSensorFrame(SensorCamera* camera, const int16_t** depth, const uint8_t** color, int* width,
+                                int* height){
+  const SensorOptions* options = &camera->sensor->options;
+  if(options->decimation <= 1 && (options->roi.width <= 0 || options->roi.height <= 0)){
+    return;
+  }
 
-        int offset = i * maxDataPerMsg;
-        int chunkSize = (i == totalColorChunks - 1) ? (colorDataSize - offset) : maxDataPerMsg;
+  const uint64_t start = syncNowUs();
+  const int levels = decimationLevel(options->decimation) + 1;
+  if(!buildFramePyramid(&camera->pyramid, (const uint16_t*)*depth, *color, *width, *height, &options->roi, levels)){
+    return;
+  }
+  const FrameLevel* level = framePyramidLevel(&camera->pyramid, options->decimation);
+  recordStageTiming(&camera->decimationTiming, start);
+  *depth = (const int16_t*)level->depth;
+  *color = level->color;
+  *width = level->width;
+  *height = level->height;
+}
 
-        // 안전성 검사 추가
-        if(offset < 0 || offset + chunkSize > colorDataSize){
-          printf("Error: color chunk offset calculation error\n");
-          break;
-        }
+// 카메라 캡처 스레드: 장치 프레임을 받아 장치 타임스템프를 붙여 동기화기로
+static void* captureLoop(void* arg){
+  SensorCamera* camera = (SensorCamera*)arg;
+  SensorContext* sensor = camera->sensor;
+  printf("Camera %d capture thread started...\n", camera->cameraId);
 
-        header->dataSize = chunkSize;
+  // Initialize Sensor
+  int opened;
+  if(sensor->options.synthetic){
+    const SensorCaptureProfile* capture = &sensor->options.capture;
+    opened = openSyntheticCamera(&camera->synthetic, camera->cameraId, capture->width, capture->height, capture->fps);
+  }else{
+    camera->astra = safeInitializeAstraObj(camera);
+    opened = camera->astra != NULL;
+  }
+  if(!opened){
+    printf("Failed to initialize camera %d\n", camera->cameraId);
+    closeSensorCamera(camera);
+    return NULL;
+  }
 
-        // 데이터 복사
-        memcpy(msgBuffer + sizeof(MessageHeader), ((const char*)colorData) + offset, chunkSize);
+  initDeviceClock(&camera->clock, sensor->options.capture.fps);
+  camera->errorCounter = 0;
+  uint32_t lastFrameIndex = 0;
+  int haveFrame = 0;
 
-        if(mq_send(mqSend, msgBuffer, sizeof(MessageHeader) + chunkSize, 0) == -1){
-          perror("mq_send color chunk");
-          break;
-        }
-      }
+  // Main Loop
+  while(sensor->running){
+    int width = 0, height = 0;
+    const int16_t* depthData = NULL;
+    const uint8_t* colorData = NULL;
+    uint32_t frameIndex = 0;
+
+    // Get Data from Sensor (다음 프레임까지 대기)
+    int ok;
+    if(camera->astra){
+      ok = GetFrameAstra(camera->astra, SENSOR_FRAME_TIMEOUT_MS, &depthData, &colorData, &width, &height, &frameIndex);
     }else{
+      uint64_t exposure;
+      readSyntheticFrame(&camera->synthetic, &frameIndex, &exposure);
+      depthData = camera->synthetic.depth;
+      colorData = camera->synthetic.color;
+      width = camera->synthetic.width;
+      height = camera->synthetic.height;
+      ok = 1;
+    }
+    const uint64_t arrival = syncNowUs();
+
+    if(ok && width > 0 && height > 0){
+      camera->errorCounter = 0; // 성공적으로 데이터를 받았으므로 에러 카운터 리셋
+
+      // 같은 프레임을 다시 받았으면 건너뜀
+      if(haveFrame && frameIndex == lastFrameIndex){
+        usleep(1000);
+        continue;
+      }
+      lastFrameIndex = frameIndex;
+      haveFrame = 1;
+
+      uint64_t timestamp = deviceClockStamp(&camera->clock, frameIndex, arrival);
+      undistortSensorFrame(camera, &depthData, &colorData, width, height);
+      depthData = filterSensorDepth(camera, depthData, width, height);
+      depthData = registerSensorDepth(camera, depthData, width, height);
+      decimateSensorFrame(camera, &depthData, &colorData, &width, &height);
+      frameSyncPush(sensor->sync, camera->cameraId, frameIndex, timestamp, depthData, colorData, width, height);
+    }else if(camera->astra){
       // 데이터를 가져오는데 실패
-      errorCounter++;
-      printf("Failed to get data from sensor (attempt %d/%d)\n", errorCounter, MAX_CONSECUTIVE_ERRORS);
+      camera->errorCounter++;
+      printf("Failed to get data from camera %d (attempt %d/%d)\n", camera->cameraId, camera->errorCounter,
+             MAX_CONSECUTIVE_ERRORS);
 
-      if(errorCounter >= MAX_CONSECUTIVE_ERRORS){
+      if(camera->errorCounter >= MAX_CONSECUTIVE_ERRORS){
         printf("Too many consecutive failures, attempting to reinitialize sensor...\n");
 
         // 센서 재초기화 시도
-        pthread_mutex_lock(&sensorMutex);
-        if(sensorContext){
-          TerminateAstraObj(sensorContext);
-          sensorContext = NULL;
-        }
+        TerminateAstraObj(camera->astra);
+        camera->astra = NULL;
 
         // 5초 정도 대기 후 재시도
         usleep(5000000);
 
-        sensorContext = safeInitializeAstraObj();
-        pthread_mutex_unlock(&sensorMutex);
-
-        if(!sensorContext){
-          printf("Failed to reinitialize sensor, terminating sensor thread\n");
-          sensorIsRunning = 0;
+        camera->astra = safeInitializeAstraObj(camera);
+        if(!camera->astra){
+          printf("Failed to reinitialize camera %d, terminating capture thread\n", camera->cameraId);
           break;
         }
 
-        errorCounter = 0;
+        camera->errorCounter = 0;
+        haveFrame = 0;
       }
     }
+  }
+
+  // Terminate Sensor
+  closeSensorCamera(camera);
+  printf("Camera %d capture thread termination\n", camera->cameraId);
+  return NULL;
+}
 
-    // Data Collection Speed Control (About 30 FPS)
-    usleep(33333);
+// 프레임 하나 (메타데이터, 깊이 청크, 색상 청크) 전송
+// 반환값: 성공 시 1, 실패 시 0
+static int sendSensorFrame(SensorContext* sensor, char* msgBuffer, const SyncFrame* frame, int frameId){
+  const int width = frame->width, height = frame->height;
+  const uint32_t timestamp = (uint32_t)(frame->timestampUs / 1000);
+
+  // 1. 메타데이터 메세지 전송
+  MessageHeader* header = (MessageHeader*)msgBuffer;
+  header->msgType = MSG_TYPE_METADATA;
+  header->width = width;
+  header->height = height;
+  header->chunkIndex = 0;
+  header->totalChunks = 0; // 메타데이터에는 의미 없음
+  header->dataSize = 0;
+  header->frameId = frameId;
+  header->timestamp = timestamp;
+  header->cameraId = frame->cameraId;
+
+  if(mq_send(sensor->mqSend, msgBuffer, sizeof(MessageHeader), 0) == -1){
+    perror("mq_send metadata");
+    return 0;
   }
 
-  // 메모리 해제
-  free(msgBuffer);
+  // 2. 깊이 데이터 청크 전송
+  int depthDataSize = width * height * sizeof(int16_t);
+  int maxDataPerMsg = MAX_MSG_SIZE - sizeof(MessageHeader);
+  int totalDepthChunks = (depthDataSize + maxDataPerMsg - 1) / maxDataPerMsg;
 
-  // Terminate Sensor
-  pthread_mutex_lock(&sensorMutex);
-  if(sensorContext){
-    TerminateAstraObj(sensorContext);
-    sensorContext = NULL;
+  for(int i = 0; i < totalDepthChunks; i++){
+    header->msgType = MSG_TYPE_DEPTH_DATA;
+    header->chunkIndex = i;
+    header->totalChunks = totalDepthChunks;
+
+    int offset = i * maxDataPerMsg;
+    int chunkSize = (i == totalDepthChunks - 1) ? (depthDataSize - offset) : maxDataPerMsg;
+
+    // 안전성 검사 추가
+    if(offset < 0 || offset + chunkSize > depthDataSize){
+      printf("Error: depth chunk offset calculation error\n");
+      return 0;
+    }
+
+    header->dataSize = chunkSize;
+
+    // 데이터 복사
+    memcpy(msgBuffer + sizeof(MessageHeader), ((const char*)frame->depth) + offset, chunkSize);
+
+    if(mq_send(sensor->mqSend, msgBuffer, sizeof(MessageHeader) + chunkSize, 0) == -1){
+      perror("mq_send depth chunk");
+      return 0;
+    }
   }
 
-  // Close Message Queue
-  if(mqSend != (mqd_t) - 1){
-    mq_close(mqSend);
-    mqSend = (mqd_t) - 1;
+  // 3. 색상 데이터 청크 전송
+  int colorDataSize = width * height * 3 * sizeof(uint8_t);
+  int totalColorChunks = (colorDataSize + maxDataPerMsg - 1) / maxDataPerMsg;
+
+  for(int i = 0; i < totalColorChunks; i++){
+    header->msgType = MSG_TYPE_COLOR_DATA;
+    header->chunkIndex = i;
+    header->totalChunks = totalColorChunks;
+
+    int offset = i * maxDataPerMsg;
+    int chunkSize = (i == totalColorChunks - 1) ? (colorDataSize - offset) : maxDataPerMsg;
+
+    // 안전성 검사 추가
+    if(offset < 0 || offset + chunkSize > colorDataSize){
+      printf("Error: color chunk offset calculation error\n");
+      return 0;
+    }
+
+    header->dataSize = chunkSize;
+
+    // 데이터 복사
+    memcpy(msgBuffer + sizeof(MessageHeader), ((const char*)frame->color) + offset, chunkSize);
+
+    if(mq_send(sensor->mqSend, msgBuffer, sizeof(MessageHeader) + chunkSize, 0) == -1){
+      perror("mq_send color chunk");
+      return 0;
+    }
   }
+  monitorAdd(MONITOR_SENSOR_BYTES, depthDataSize + colorDataSize);
+  return 1;
+}
+
+// 전송 스레드: 동기화된 묶음을 카메라 순서대로 로거 큐에 전송
+// 한 큐를 공유하므로 프레임 하나의 메세지는 끊기지 않고 이어서 보냄
+static void* sensorLoop(void* arg){
+  SensorContext* sensor = (SensorContext*)arg;
+  printf("Sensor thread started...\n");
 
+  // 데이터 청크를 위한 버퍼 할당
+  char* msgBuffer = safe_malloc(MAX_MSG_SIZE);
+  if(!msgBuffer){
+    perror("malloc message buffer");
+    sensor->running = 0;
+    return NULL;
+  }
+
+  int frameId = 0;
+  uint64_t reportedDrops = 0;
+
+  // Main Loop
+  monitorRegisterThread(MONITOR_THREAD_SENSOR);
+  while(sensor->running){
+    SyncSet set;
+    if(!frameSyncWait(sensor->sync, &set, SENSOR_FRAME_TIMEOUT_MS)){
+      continue;
+    }
+
+    frameId++;
+    for(int c = 0; c < sensor->options.cameraCount; ++c){
+      if(set.frames[c]){
+        int sent = sendSensorFrame(sensor, msgBuffer, set.frames[c], frameId);
+        monitorAdd(sent ? MONITOR_CAPTURED_FRAMES : MONITOR_CAPTURE_DROPPED, 1);
+      }
+    }
+    frameSyncRelease(sensor->sync, &set);
+
+    // 동기화기에서 짝이 없어 버린 프레임
+    FrameSyncStats stats;
+    getFrameSyncStats(sensor->sync, &stats);
+    uint64_t drops = 0;
+    for(int c = 0; c < sensor->options.cameraCount; ++c){
+      drops += stats.dropped[c];
+    }
+    monitorAdd(MONITOR_CAPTURE_DROPPED, drops - reportedDrops);
+    reportedDrops = drops;
+  }
+
+  // 메모리 해제
+  free(msgBuffer);
+
+  monitorUnregisterThread(MONITOR_THREAD_SENSOR);
   printf("Sensor thread termination\n");
   return NULL;
 }
 
-pthread_t sensor_thread_id;
+SensorContext* createSensorContext(const SensorOptions* options){
+  SensorContext* sensor = (SensorContext*)malloc(sizeof(SensorContext));
+  if(!sensor){
+    perror("malloc sensor context");
+    return NULL;
+  }
+  initSensorContext(sensor, options);
+  return sensor;
+}
 
-void initSensorModule(){
-  printf("Initializing sensor module...\n");
-  sensorIsRunning = 1;
-  if(pthread_create(&sensor_thread_id, NULL, sensorLoop, NULL) != 0){
-    perror("Failed to create sensor thread");
-    sensorIsRunning = 0;
+void destroySensorContext(SensorContext* sensor){
+  if(!sensor || sensor == &defaultSensor){
+    return;
   }
+  sensorStop(sensor);
+  pthread_mutex_destroy(&sensor->mutex);
+  free(sensor);
 }
 
-void stopSensorModule(){
-  printf("Stopping sensor module...\n");
-  sensorIsRunning = 0;
+void sensorStart(SensorContext* sensor){
+  if(sensor->threadStarted){
+    return;
+  }
 
-  // 스레드가 적절히 종료될 때까지 대기
+  // Message Queue
+  sensor->mqSend = mq_open(sensor->queues.sensorToLogger, O_WRONLY);
+  if(sensor->mqSend == (mqd_t) - 1){
+    perror("mq_open send");
+    return;
+  }
+
+  const int cameraCount = sensor->options.cameraCount;
+  sensor->sync = createFrameSynchronizer(cameraCount, (uint64_t)sensor->options.syncToleranceMs * 1000, 0);
+  if(!sensor->sync){
+    mq_close(sensor->mqSend);
+    sensor->mqSend = (mqd_t) - 1;
+    return;
+  }
+  if(cameraCount > 1){
+    printf("%d %s cameras, sync tolerance %d ms\n", cameraCount, sensor->options.synthetic ? "synthetic" : "Astra",
+           sensor->options.syncToleranceMs);
+  }
+
+  sensor->running = 1;
+  sensor->openCameras = cameraCount;
+  if(pthread_create(&sensor->threadId, NULL, sensorLoop, sensor) != 0){
+    perror("Failed to create sensor thread");
+    sensor->running = 0;
+    destroyFrameSynchronizer(sensor->sync);
+    sensor->sync = NULL;
+    mq_close(sensor->mqSend);
+    sensor->mqSend = (mqd_t) - 1;
+    return;
+  }
+  sensor->threadStarted = 1;
+
+  for(int c = 0; c < cameraCount; ++c){
+    SensorCamera* camera = &sensor->cameras[c];
+    memset(camera, 0, sizeof(*camera));
+    camera->sensor = sensor;
+    camera->cameraId = c;
+    if(pthread_create(&camera->threadId, NULL, captureLoop, camera) != 0){
+      perror("Failed to create capture thread");
+      closeSensorCamera(camera);
+      continue;
+    }
+    camera->threadStarted = 1;
+  }
+}
+
+// 스레드가 적절히 종료될 때까지 대기 (3초 타임아웃 후 강제 종료)
+static void joinSensorThread(pthread_t thread, const char* name){
   struct timespec timeout;
   clock_gettime(CLOCK_REALTIME, &timeout);
-  timeout.tv_sec += 3; // 3초 타임아웃 
+  timeout.tv_sec += 3; // 3초 타임아웃
 
-  if(pthread_timedjoin_np(sensor_thread_id, NULL, &timeout) != 0){
-    printf("Sensor thread did not terminate within timeout, forcing...\n");
-    pthread_cancel(sensor_thread_id);
-    pthread_join(sensor_thread_id, NULL);
+  if(pthread_timedjoin_np(thread, NULL, &timeout) != 0){
+    printf("%s thread did not terminate within timeout, forcing...\n", name);
+    pthread_cancel(thread);
+    pthread_join(thread, NULL);
   }
+}
 
-  // 센서 컨텍스트 정리
-  pthread_mutex_lock(&sensorMutex);
-  if(sensorContext){
-    TerminateAstraObj(sensorContext);
-    sensorContext = NULL;
+void sensorStop(SensorContext* sensor){
+  if(!sensor->threadStarted){
+    return;
   }
-  pthread_mutex_unlock(&sensorMutex);
+  sensor->running = 0;
+  frameSyncWake(sensor->sync);
+
+  for(int c = 0; c < sensor->options.cameraCount; ++c){
+    SensorCamera* camera = &sensor->cameras[c];
+    if(camera->threadStarted){
+      joinSensorThread(camera->threadId, "Capture");
+      camera->threadStarted = 0;
+
+      // 강제 종료된 경우 센서 정리
+      if(camera->astra){
+        TerminateAstraObj(camera->astra);
+        camera->astra = NULL;
+      }
+      releaseDepthStages(camera);
+    }
+  }
+  joinSensorThread(sensor->threadId, "Sensor");
+  sensor->threadStarted = 0;
+
+  // 카메라별 왜곡 보정 / 깊이 필터 / 정합 / 줄임 처리 시간
+  for(int c = 0; c < sensor->options.cameraCount; ++c){
+    printStageTiming(c, "undistort", &sensor->cameras[c].undistortTiming);
+    printStageTiming(c, "depth filter", &sensor->cameras[c].filterTiming);
+    printStageTiming(c, "registration", &sensor->cameras[c].registrationTiming);
+    printStageTiming(c, "decimation", &sensor->cameras[c].decimationTiming);
+  }
+
+  // 카메라별 수신 / 버린 프레임과 묶음 시간 차
+  FrameSyncStats stats;
+  getFrameSyncStats(sensor->sync, &stats);
+  if(sensor->options.cameraCount > 1){
+    for(int c = 0; c < sensor->options.cameraCount; ++c){
+      printf("Camera %d: %llu frames, %llu dropped\n", c, (unsigned long long)stats.pushed[c],
+             (unsigned long long)stats.dropped[c]);
+    }
+    printf("%llu synchronized sets (%llu partial), spread %.2f ms avg / %.2f ms max\n",
+           (unsigned long long)stats.sets, (unsigned long long)stats.partialSets,
+           stats.sets ? stats.spreadSumUs / 1000.0 / stats.sets : 0.0, stats.spreadMaxUs / 1000.0);
+  }
+  destroyFrameSynchronizer(sensor->sync);
+  sensor->sync = NULL;
 
   // 메세지 큐 정리
-  if(mqSend != (mqd_t) - 1){
-    mq_close(mqSend);
-    mqSend = (mqd_t) - 1;
+  if(sensor->mqSend != (mqd_t) - 1){
+    mq_close(sensor->mqSend);
+    sensor->mqSend = (mqd_t) - 1;
+  }
+}
+
+int sensorIsRunning(SensorContext* sensor){
+  return sensor->running;
+}
+
+void sensorRequestStop(SensorContext* sensor){
+  sensor->running = 0;
+}
+
+// ---------------------------------------------------------------------------
+// 기본 컨텍스트
+
+void setSensorModuleOptions(const SensorOptions* options){
+  SensorContext* sensor = defaultSensorContext();
+  if(sensor->threadStarted){
+    printf("Sensor module is already running, options ignored\n");
+    return;
   }
+  applySensorOptions(sensor, options);
+}
+
+void initSensorModule(){
+  printf("Initializing sensor module...\n");
+  sensorStart(defaultSensorContext());
+}
 
+void stopSensorModule(){
+  printf("Stopping sensor module...\n");
+  sensorStop(defaultSensorContext());
   printf("Sensor module stopped\n");
 }
 
 int isSensorModuleRunning(void){
-  return sensorIsRunning;
+  return sensorIsRunning(defaultSensorContext());
 }
 
 void requestStopSensorModule(){
-  sensorIsRunning = 0;
+  sensorRequestStop(defaultSensorContext());
 }
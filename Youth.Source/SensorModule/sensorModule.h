@@ -1,6 +1,59 @@
 #ifndef SENSOR_MODULE_H
 #define SENSOR_MODULE_H
 
+#include "../KernelModule/depthFilter.h"
+#include "../KernelModule/depthRegistration.h"
+#include "../KernelModule/undistort.h"
+#include "../KernelModule/frameDecimation.h"
+
+// Astra stream mode (depth and color use the same mode)
+typedef struct{
+  const char* name;
+  int width, height, fps;
+} SensorCaptureProfile;
+
+// Named capture profiles: "vga" 640x480@30 (default), "qvga" 320x240@30, "qvga60" 320x240@60
+// Returns 1 and fills profile when the name is known
+int findSensorCaptureProfile(const char* name, SensorCaptureProfile* profile);
+
+// Sensor context options
+typedef struct{
+  const char* pipeline;  // Queue name suffix (NULL or "" for the default queues, see makePipelineQueueNames)
+  int cameraCount;       // Cameras captured in parallel, one capture thread each (default 1, max MAX_SENSOR_CAMERAS)
+  int synthetic;         // 1: synthetic cameras instead of Astra devices (default 0)
+  int syncToleranceMs;   // Max device timestamp difference inside a synchronized set (default 17, half a 30 FPS frame)
+  int undistort;         // 1: remove lens distortion from depth and color before filtering (default 0)
+  DepthFilterOptions depthFilter; // Depth filter chain run by each capture thread (default stages 0: off)
+  int registerDepth;     // 1: warp depth into the color camera after filtering (default 0)
+  DepthColorCalibration calibration; // Intrinsics, distortion and extrinsics used by undistort / registerDepth
+  int registrationThreads; // Threads per camera for registration, including the capture thread (default 2)
+  SensorCaptureProfile capture; // Astra stream mode, also the synthetic camera size (default "vga")
+  FrameRoi roi;          // Region sent to the logger, cropped after registration (default width 0: full frame)
+  int decimation;        // 1, 2, 4 or 8: send 1/n of the (cropped) frame in each direction (default 1)
+} SensorOptions;
+
+// Sensor capture context (cameras feeding one pipeline's sensor -> logger queue)
+// Frames of all cameras are grouped into time-aligned sets and sent one camera after another,
+// with the set number as frame id and the camera number as camera id
+typedef struct SensorContext SensorContext;
+
+void setDefaultSensorOptions(SensorOptions* options);
+
+// Returns NULL on allocation failure
+SensorContext* createSensorContext(const SensorOptions* options);
+void destroySensorContext(SensorContext* sensor);
+
+// Start / stop the capture threads (the logging context must have created the queues)
+// The context stops running by itself when every camera failed to open
+void sensorStart(SensorContext* sensor);
+void sensorStop(SensorContext* sensor);
+int sensorIsRunning(SensorContext* sensor);
+void sensorRequestStop(SensorContext* sensor);
+
+// Default context (the cameras of the Youth process)
+// Call setSensorModuleOptions before initSensorModule to change its pipeline name or cameras
+void setSensorModuleOptions(const SensorOptions* options);
+
 void* sensorModule(void* id);
 
 // Initialize Sensor Module
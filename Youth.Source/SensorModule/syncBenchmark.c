@@ -0,0 +1,158 @@
+// 다중 카메라 동기화 벤치마크 (합성 카메라, 장치 없이 실행)
+// 사용법: SyncBenchmark [cameras] [seconds] [tolerance ms]
+// 카메라마다 캡처 스레드가 장치 시계 복원 타임스템프로 동기화기에 넣고, 묶음마다 실제 노출 시각의 차이를 측정
+// 도착 시각을 그대로 쓸 때와 비교해 타임스템프 오차, 묶음 안 노출 시각 차이, 버린 프레임 수를 출력
+
+#include "frameSynchronizer.h"
+#include "syntheticCamera.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define EXPOSURE_SLOTS 64
+
+typedef struct{
+  SyntheticCamera camera;
+  DeviceClock clock;
+  FrameSynchronizer* sync;
+  volatile int* running;
+  pthread_t thread;
+
+  // 장치 프레임 번호 -> 실제 노출 시각 (묶음 검증용)
+  pthread_mutex_t mutex;
+  uint32_t exposureFrame[EXPOSURE_SLOTS];
+  uint64_t exposureUs[EXPOSURE_SLOTS];
+
+  // 타임스템프 오차 (복원 / 도착 시각)
+  double recoveredErrorSum, arrivalErrorSum;
+  uint64_t recoveredErrorMax, arrivalErrorMax;
+  uint64_t frames;
+} BenchCamera;
+
+static uint64_t absDiff(uint64_t a, uint64_t b){
+  return a > b ? a - b : b - a;
+}
+
+static void* captureThread(void* arg){
+  BenchCamera* bench = (BenchCamera*)arg;
+  while(*bench->running){
+    uint32_t frame;
+    uint64_t exposure;
+    readSyntheticFrame(&bench->camera, &frame, &exposure);
+    const uint64_t arrival = syncNowUs();
+    const uint64_t timestamp = deviceClockStamp(&bench->clock, frame, arrival);
+
+    pthread_mutex_lock(&bench->mutex);
+    bench->exposureFrame[frame % EXPOSURE_SLOTS] = frame;
+    bench->exposureUs[frame % EXPOSURE_SLOTS] = exposure;
+    pthread_mutex_unlock(&bench->mutex);
+
+    // 시계 복원은 처음 1초 동안 수렴하므로 이후만 집계
+    if(bench->frames++ >= 30){
+      uint64_t recovered = absDiff(timestamp, exposure), late = arrival - exposure;
+      bench->recoveredErrorSum += recovered;
+      bench->arrivalErrorSum += late;
+      if(recovered > bench->recoveredErrorMax) bench->recoveredErrorMax = recovered;
+      if(late > bench->arrivalErrorMax) bench->arrivalErrorMax = late;
+    }
+
+    frameSyncPush(bench->sync, bench->camera.cameraId, frame, timestamp, bench->camera.depth, bench->camera.color,
+                  bench->camera.width, bench->camera.height);
+  }
+  return NULL;
+}
+
+int main(int argc, char** argv){
+  int cameras = argc > 1 ? atoi(argv[1]) : 3;
+  int seconds = argc > 2 ? atoi(argv[2]) : 10;
+  int toleranceMs = argc > 3 ? atoi(argv[3]) : 17;
+  if(cameras < 1 || cameras > MAX_SENSOR_CAMERAS){
+    fprintf(stderr, "Usage: %s [cameras 1~%d] [seconds] [tolerance ms]\n", argv[0], MAX_SENSOR_CAMERAS);
+    return 1;
+  }
+  if(seconds < 2) seconds = 2;
+
+  FrameSynchronizer* sync = createFrameSynchronizer(cameras, (uint64_t)toleranceMs * 1000, 0);
+  BenchCamera* benches = (BenchCamera*)calloc(cameras, sizeof(BenchCamera));
+  if(!sync || !benches){
+    return 1;
+  }
+
+  volatile int running = 1;
+  for(int c = 0; c < cameras; ++c){
+    BenchCamera* bench = &benches[c];
+    if(!openSyntheticCamera(&bench->camera, c, 640, 480, 30)){
+      return 1;
+    }
+    initDeviceClock(&bench->clock, 30);
+    bench->sync = sync;
+    bench->running = &running;
+    pthread_mutex_init(&bench->mutex, NULL);
+    pthread_create(&bench->thread, NULL, captureThread, bench);
+  }
+
+  // 묶음마다 실제 노출 시각 차이
+  double exposureSpreadSum = 0.0;
+  uint64_t exposureSpreadMax = 0, sets = 0;
+  const uint64_t end = syncNowUs() + (uint64_t)seconds * 1000000;
+  while(syncNowUs() < end){
+    SyncSet set;
+    if(!frameSyncWait(sync, &set, 100)){
+      continue;
+    }
+
+    uint64_t earliest = UINT64_MAX, latest = 0;
+    int known = 0;
+    for(int c = 0; c < cameras; ++c){
+      const SyncFrame* frame = set.frames[c];
+      if(!frame) continue;
+      BenchCamera* bench = &benches[c];
+      pthread_mutex_lock(&bench->mutex);
+      if(bench->exposureFrame[frame->deviceFrame % EXPOSURE_SLOTS] == frame->deviceFrame){
+        uint64_t exposure = bench->exposureUs[frame->deviceFrame % EXPOSURE_SLOTS];
+        if(exposure < earliest) earliest = exposure;
+        if(exposure > latest) latest = exposure;
+        known++;
+      }
+      pthread_mutex_unlock(&bench->mutex);
+    }
+    frameSyncRelease(sync, &set);
+
+    if(known == cameras){
+      exposureSpreadSum += latest - earliest;
+      if(latest - earliest > exposureSpreadMax) exposureSpreadMax = latest - earliest;
+      sets++;
+    }
+  }
+
+  running = 0;
+  frameSyncWake(sync);
+  for(int c = 0; c < cameras; ++c){
+    pthread_join(benches[c].thread, NULL);
+  }
+
+  FrameSyncStats stats;
+  getFrameSyncStats(sync, &stats);
+  printf("%d cameras, %d s, tolerance %d ms\n", cameras, seconds, toleranceMs);
+  for(int c = 0; c < cameras; ++c){
+    BenchCamera* bench = &benches[c];
+    uint64_t counted = bench->frames > 30 ? bench->frames - 30 : 1;
+    printf("camera %d: %llu frames, %llu dropped, timestamp error %.3f ms avg / %.3f ms max "
+           "(arrival time %.3f / %.3f ms)\n",
+           c, (unsigned long long)stats.pushed[c], (unsigned long long)stats.dropped[c],
+           bench->recoveredErrorSum / counted / 1000.0, bench->recoveredErrorMax / 1000.0,
+           bench->arrivalErrorSum / counted / 1000.0, bench->arrivalErrorMax / 1000.0);
+    closeSyntheticCamera(&bench->camera);
+    pthread_mutex_destroy(&bench->mutex);
+  }
+  printf("%llu sets (%.1f /s, %llu partial), timestamp spread %.3f ms avg / %.3f ms max, "
+         "exposure spread %.3f ms avg / %.3f ms max\n",
+         (unsigned long long)stats.sets, stats.sets / (double)seconds, (unsigned long long)stats.partialSets,
+         stats.sets ? stats.spreadSumUs / 1000.0 / stats.sets : 0.0, stats.spreadMaxUs / 1000.0,
+         sets ? exposureSpreadSum / 1000.0 / sets : 0.0, exposureSpreadMax / 1000.0);
+
+  destroyFrameSynchronizer(sync);
+  free(benches);
+  return exposureSpreadMax <= (uint64_t)toleranceMs * 1000 + 2000 ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+#include "syntheticCamera.h"
+#include "frameSynchronizer.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// 약 1% 의 프레임은 장치에서 사라짐 (번호는 건너뜀)
+#define SYNTHETIC_LOST_FRAME_RATE 100
+
+static uint32_t nextRandom(SyntheticCamera* camera){
+  camera->rng = camera->rng * 1664525u + 1013904223u;
+  return camera->rng >> 8;
+}
+
+int openSyntheticCamera(SyntheticCamera* camera, int camera_id, int width, int height, int fps){
+  memset(camera, 0, sizeof(*camera));
+  camera->depth = (int16_t*)malloc((size_t)width * height * sizeof(int16_t));
+  camera->color = (uint8_t*)malloc((size_t)width * height * 3);
+  if(!camera->depth || !camera->color){
+    perror("malloc synthetic camera");
+    closeSyntheticCamera(camera);
+    return 0;
+  }
+
+  camera->cameraId = camera_id;
+  camera->width = width;
+  camera->height = height;
+  camera->rng = 0x9e3779b9u * (uint32_t)(camera_id + 1);
+
+  // 카메라마다 다른 위상 (프레임 간격 안에서 임의) 과 시계 오차 (-40 ~ +40 ppm)
+  const int64_t nominal = 1000000 / (fps > 0 ? fps : 30);
+  const int ppm = (int)(nextRandom(camera) % 81) - 40;
+  camera->periodUs = nominal + nominal * ppm / 1000000;
+  camera->startUs = syncNowUs() + nominal + nextRandom(camera) % nominal;
+  camera->maxLatencyUs = 2000 + 2000 * camera_id;
+  camera->firstFrame = nextRandom(camera) % 1000;
+  camera->deviceFrame = camera->firstFrame;
+  return 1;
+}
+
+void closeSyntheticCamera(SyntheticCamera* camera){
+  free(camera->depth);
+  free(camera->color);
+  camera->depth = NULL;
+  camera->color = NULL;
+}
+
+// 카메라마다 조금씩 다른 방향에서 본 물결치는 벽 (깊이 mm)
+static void renderSyntheticFrame(SyntheticCamera* camera, uint64_t exposure_us){
+  const float phase = (float)(exposure_us % 100000000ull) * 3e-6f;
+  const float yaw = camera->cameraId * 0.4f;
+  for(int v = 0; v < camera->height; ++v){
+    const float wave = 150.0f * cosf(v * 0.02f);
+    for(int u = 0; u < camera->width; ++u){
+      size_t i = (size_t)v * camera->width + u;
+      float z = 1800.0f + (u - camera->width / 2) * yaw + wave * sinf(u * 0.03f + phase);
+      int hole = ((u * 7 + v * 13) % 97) == 0;
+      camera->depth[i] = hole ? 0 : (int16_t)z;
+      camera->color[i * 3] = (uint8_t)(u >> 2);
+      camera->color[i * 3 + 1] = (uint8_t)(v >> 1);
+      camera->color[i * 3 + 2] = (uint8_t)(64 * camera->cameraId);
+    }
+  }
+}
+
+void readSyntheticFrame(SyntheticCamera* camera, uint32_t* device_frame, uint64_t* exposure_us){
+  // 잃어버린 프레임은 번호만 건너뜀
+  uint32_t frame = camera->deviceFrame++;
+  if(nextRandom(camera) % SYNTHETIC_LOST_FRAME_RATE == 0){
+    frame = camera->deviceFrame++;
+  }
+
+  const uint64_t exposure = camera->startUs + (uint64_t)camera->periodUs * (frame - camera->firstFrame);
+  renderSyntheticFrame(camera, exposure);
+
+  // 전달 지연 흉내
+  const uint64_t arrival = exposure + nextRandom(camera) % (uint32_t)camera->maxLatencyUs;
+  uint64_t now = syncNowUs();
+  if(arrival > now){
+    usleep((useconds_t)(arrival - now));
+  }
+
+  *device_frame = frame;
+  *exposure_us = exposure;
+}
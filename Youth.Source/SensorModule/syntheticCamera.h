@@ -0,0 +1,37 @@
+#ifndef SYNTHETIC_CAMERA_H
+#define SYNTHETIC_CAMERA_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 합성 카메라 (Astra 없이 다중 카메라 캡처 / 동기화 확인용 가짜 장치)
+// 카메라마다 노출 위상, 시계 오차 (ppm), 전달 지연 흔들림이 다르고 가끔 프레임을 잃어버림
+typedef struct{
+  int cameraId;
+  int width, height;
+  int64_t periodUs;      // 장치 시계 기준 프레임 간격 (ppm 오차 반영)
+  uint64_t startUs;      // 첫 노출 시각 (syncNowUs 기준)
+  int maxLatencyUs;      // 노출 -> 전달 지연 최대값
+  uint32_t firstFrame;   // startUs 에 노출된 프레임 번호
+  uint32_t deviceFrame;  // 다음 프레임 번호
+  uint32_t rng;
+  int16_t* depth;
+  uint8_t* color;
+} SyntheticCamera;
+
+// 반환값: 성공 시 1, 실패 시 0
+int openSyntheticCamera(SyntheticCamera* camera, int camera_id, int width, int height, int fps);
+void closeSyntheticCamera(SyntheticCamera* camera);
+
+// 다음 프레임이 전달될 때까지 대기한 뒤 렌더링 (camera->depth / color)
+// device_frame: 장치 프레임 번호, exposure_us: 실제 노출 시각 (검증용, 실제 장치에서는 알 수 없음)
+void readSyntheticFrame(SyntheticCamera* camera, uint32_t* device_frame, uint64_t* exposure_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SYNTHETIC_CAMERA_H
@@ -0,0 +1,196 @@
+// 격자 코덱 벤치마크
+// 사용법: CodecBenchmark [record.bin | frames] [stride]
+// LoggingModule 녹화 파일 또는 합성 장면 (고정 카메라, 깊이 노이즈 + 움직이는 물체) 으로
+// 프레임당 바이트 (float32 / int16 XYZ 대비), 인코딩 / 디코딩 시간 (us), 복원 오차 측정
+
+#include "streamCodec.h"
+#include "../frameDefinitions.h"
+#include "../KernelModule/benchmarkUtil.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SOURCE_WIDTH 640
+#define SOURCE_HEIGHT 480
+
+static uint32_t randomState = 12345;
+
+// 합성 장면: 3 m 뒤 벽, 왼쪽 벽, 바닥 + 좌우로 움직이는 공 (깊이 mm, 노이즈 1 mm * z^2)
+static void renderScene(int frame, uint16_t* depth, uint8_t* rgb){
+  const float fx = 570.3f, fy = 570.3f, cx = 320.0f, cy = 240.0f;
+  const float ballX = 0.8f * sinf(frame * 0.08f), ballZ = 1.8f, ballR = 0.35f;
+
+  for(int v = 0; v < SOURCE_HEIGHT; ++v){
+    for(int u = 0; u < SOURCE_WIDTH; ++u){
+      float rx = (u - cx) / fx, ry = (v - cy) / fy;
+      float z = 3.0f;
+      uint8_t r = 180, g = 170, b = 150;
+      if(ry > 1e-3f && 1.2f / ry < z){ z = 1.2f / ry; r = 90; g = 80; b = 70; }           // 바닥 (y = 1.2 m)
+      if(rx < -1e-3f && -1.5f / rx < z){ z = -1.5f / rx; r = 120; g = 150; b = 180; }     // 왼쪽 벽 (x = -1.5 m)
+
+      // 공과 광선 교차
+      float a = rx * rx + ry * ry + 1.0f;
+      float bb = -2.0f * (rx * ballX + ballZ);
+      float c = ballX * ballX + ballZ * ballZ - ballR * ballR;
+      float disc = bb * bb - 4.0f * a * c;
+      if(disc > 0.0f){
+        float t = (-bb - sqrtf(disc)) / (2.0f * a);
+        if(t > 0.0f && t < z){ z = t; r = 220; g = 40; b = 40; }
+      }
+
+      size_t i = (size_t)v * SOURCE_WIDTH + u;
+      float noisy = z * 1000.0f + benchmarkGaussian(&randomState) * z * z;
+      depth[i] = (u & 31) == 0 && (v & 15) == 0 ? 0 : (uint16_t)lrintf(noisy); // 군데군데 무효 픽셀
+      rgb[i * 3] = r;
+      rgb[i * 3 + 1] = g;
+      rgb[i * 3 + 2] = b;
+    }
+  }
+}
+
+// 녹화 파일에서 다음 프레임 읽기
+static int readRecordedFrame(FILE* file, uint16_t* depth, uint8_t* rgb){
+  FrameHeader header;
+  if(fread(&header, sizeof(header), 1, file) != 1 || header.frameType != FRAME_TYPE_DEPTH_COLOR){
+    return 0;
+  }
+  if(header.width != SOURCE_WIDTH || header.height != SOURCE_HEIGHT){
+    fprintf(stderr, "Unsupported frame size %dx%d\n", header.width, header.height);
+    return 0;
+  }
+  return fread(depth, 1, header.depthDataSize, file) == header.depthDataSize &&
+         fread(rgb, 1, header.colorDataSize, file) == header.colorDataSize;
+}
+
+int main(int argc, char** argv){
+  FILE* record = NULL;
+  int frames = 300;
+  if(argc > 1){
+    record = fopen(argv[1], "rb");
+    if(!record){
+      frames = atoi(argv[1]);
+    }
+  }
+  int stride = argc > 2 ? atoi(argv[2]) : 2;
+  if(stride < 1) stride = 1;
+
+  const int gridWidth = (SOURCE_WIDTH + stride - 1) / stride;
+  const int gridHeight = (SOURCE_HEIGHT + stride - 1) / stride;
+  const size_t gridPixels = (size_t)gridWidth * gridHeight;
+
+  uint16_t* depth = (uint16_t*)malloc(SOURCE_WIDTH * SOURCE_HEIGHT * sizeof(uint16_t));
+  uint8_t* rgb = (uint8_t*)malloc(SOURCE_WIDTH * SOURCE_HEIGHT * 3);
+  uint16_t* gridDepth = (uint16_t*)malloc(gridPixels * sizeof(uint16_t));
+  uint8_t* gridRgb = (uint8_t*)malloc(gridPixels * 3);
+  uint16_t* gridColor = (uint16_t*)malloc(gridPixels * sizeof(uint16_t));
+  size_t capacity = maxGridFrameBytes(gridWidth, gridHeight);
+  uint8_t* encoded = (uint8_t*)malloc(capacity);
+
+  GridEncoder encoder;
+  GridDecoder decoder;
+  if(!depth || !rgb || !gridDepth || !gridRgb || !gridColor || !encoded ||
+     !initGridEncoder(&encoder, gridWidth, gridHeight)){
+    fprintf(stderr, "Allocation failed\n");
+    return 1;
+  }
+  initGridDecoder(&decoder);
+
+  printf("Grid %dx%d (stride %d), depth tolerance %d + z >> %d, color tolerance %d\n", gridWidth, gridHeight, stride,
+         encoder.depthTolerance, encoder.depthToleranceShift, encoder.colorTolerance);
+
+  double encodeSeconds = 0.0, decodeSeconds = 0.0;
+  size_t deltaBytes = 0, deltaFrames = 0, keyBytes = 0, validPoints = 0, changedPixels = 0;
+  int maxError = 0, maxAllowed = 0, count = 0;
+  for(; record ? 1 : count < frames; ++count){
+    if(record){
+      if(!readRecordedFrame(record, depth, rgb)) break;
+    }else{
+      renderScene(count, depth, rgb);
+    }
+
+    // 격자 샘플링 (스트리밍 서버와 같은 방식)
+    size_t valid = 0;
+    for(int v = 0, j = 0; v < gridHeight; ++v){
+      for(int u = 0; u < gridWidth; ++u, ++j){
+        size_t i = (size_t)v * stride * SOURCE_WIDTH + (size_t)u * stride;
+        uint16_t d = depth[i];
+        gridDepth[j] = d >= 300 && d <= 8000 ? d : 0;
+        valid += gridDepth[j] != 0;
+        memcpy(gridRgb + (size_t)j * 3, rgb + i * 3, 3);
+      }
+    }
+    validPoints += valid;
+    packRGB565(gridRgb, gridColor, gridPixels);
+
+    // 1 초마다 키 프레임 (새 클라이언트 접속과 같은 비용)
+    if(count % 30 == 0){
+      resetGridEncoder(&encoder);
+    }
+
+    GridEncodeStats stats;
+    double start = benchmarkNow();
+    size_t bytes = encodeGridFrame(&encoder, gridDepth, gridColor, encoded, capacity, &stats);
+    double encoded_at = benchmarkNow();
+    int ok = decodeGridFrame(&decoder, encoded, bytes);
+    double decoded_at = benchmarkNow();
+    if(!bytes || !ok){
+      fprintf(stderr, "Frame %d: encode/decode failed\n", count);
+      return 1;
+    }
+    encodeSeconds += encoded_at - start;
+    decodeSeconds += decoded_at - encoded_at;
+    if(stats.keyFrame){
+      keyBytes += bytes;
+    }else{
+      deltaBytes += bytes;
+      deltaFrames++;
+      changedPixels += stats.changed;
+    }
+
+    // 복원 오차는 허용 오차 이내여야 함
+    for(size_t j = 0; j < gridPixels; ++j){
+      int error = abs((int)decoder.depth[j] - (int)gridDepth[j]);
+      int allowed = encoder.depthTolerance + (decoder.depth[j] >> encoder.depthToleranceShift);
+      if(error > allowed){
+        fprintf(stderr, "Frame %d pixel %zu: error %d > %d\n", count, j, error, allowed);
+        return 1;
+      }
+      if(error > maxError){
+        maxError = error;
+        maxAllowed = allowed;
+      }
+    }
+  }
+
+  if(count == 0){
+    fprintf(stderr, "No frames\n");
+    return 1;
+  }
+  const int keyFrames = count - (int)deltaFrames;
+  const double points = (double)validPoints / count;
+  printf("Frames %d, %.0f points/frame\n", count, points);
+  printf("float32 XYZ+RGB8  %9.1f KB/frame (full resolution %.1f KB)\n", points * 15 / 1024.0,
+         SOURCE_WIDTH * SOURCE_HEIGHT * 15 / 1024.0);
+  printf("int16 XYZ+RGB8    %9.1f KB/frame\n", points * 9 / 1024.0);
+  printf("grid key frame    %9.1f KB/frame\n", keyFrames ? keyBytes / 1024.0 / keyFrames : 0.0);
+  if(deltaFrames){
+    printf("grid delta frame  %9.1f KB/frame (%.1f%% pixels changed)\n", deltaBytes / 1024.0 / deltaFrames,
+           100.0 * changedPixels / deltaFrames / gridPixels);
+  }
+  printf("grid average      %9.1f KB/frame, %.1f Mbit/s at 30 FPS\n", (keyBytes + deltaBytes) / 1024.0 / count,
+         (keyBytes + deltaBytes) * 8.0 * 30.0 / count / 1e6);
+  printf("encode %.1f us/frame, decode %.1f us/frame, max depth error %d (allowed %d)\n", encodeSeconds * 1e6 / count,
+         decodeSeconds * 1e6 / count, maxError, maxAllowed);
+
+  if(record) fclose(record);
+  freeGridEncoder(&encoder);
+  freeGridDecoder(&decoder);
+  free(depth);
+  free(rgb);
+  free(gridDepth);
+  free(gridRgb);
+  free(gridColor);
+  free(encoded);
+  return 0;
+}
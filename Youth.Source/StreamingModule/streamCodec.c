@@ -0,0 +1,375 @@
+#include "streamCodec.h"
+#include "../KernelModule/kernelModule.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// 8 픽셀 블록 단위로 처리하므로 기준 버퍼는 8 의 배수로 할당
+static size_t paddedPixels(int width, int height){
+  return ((size_t)width * height + 7) & ~(size_t)7;
+}
+
+int initGridEncoder(GridEncoder* encoder, int width, int height){
+  memset(encoder, 0, sizeof(*encoder));
+
+  size_t pixels = paddedPixels(width, height);
+  encoder->width = width;
+  encoder->height = height;
+  encoder->depth = (uint16_t*)alignedAlloc(pixels * sizeof(uint16_t));
+  encoder->color = (uint16_t*)alignedAlloc(pixels * sizeof(uint16_t));
+  encoder->changeMask = (uint8_t*)alignedAlloc(pixels / 8);
+  encoder->colorMask = (uint8_t*)alignedAlloc(pixels / 8);
+  encoder->scratch = (uint8_t*)malloc(pixels * 5);
+  encoder->depthTolerance = 2;
+  encoder->depthToleranceShift = 8;
+  encoder->colorTolerance = 1;
+
+  if(!encoder->depth || !encoder->color || !encoder->changeMask || !encoder->colorMask ||
+     !encoder->scratch){
+    freeGridEncoder(encoder);
+    return 0;
+  }
+  return 1;
+}
+
+void freeGridEncoder(GridEncoder* encoder){
+  free(encoder->depth);
+  free(encoder->color);
+  free(encoder->changeMask);
+  free(encoder->colorMask);
+  free(encoder->scratch);
+  encoder->depth = NULL;
+  encoder->color = NULL;
+  encoder->changeMask = NULL;
+  encoder->colorMask = NULL;
+  encoder->scratch = NULL;
+  encoder->width = 0;
+  encoder->height = 0;
+  encoder->hasReference = 0;
+}
+
+void resetGridEncoder(GridEncoder* encoder){
+  encoder->hasReference = 0;
+}
+
+void primeGridEncoder(GridEncoder* encoder, const uint16_t* depth, const uint16_t* color){
+  // 키 프레임은 기준이 0 이므로 depthTolerance 보다 큰 깊이만 보내고, 그 픽셀은 색상도 항상 보냄
+  const size_t pixels = (size_t)encoder->width * encoder->height;
+  const size_t padded = paddedPixels(encoder->width, encoder->height);
+  for(size_t i = 0; i < pixels; ++i){
+    const int valid = depth[i] > encoder->depthTolerance;
+    encoder->depth[i] = valid ? depth[i] : 0;
+    encoder->color[i] = valid ? color[i] : 0;
+  }
+  memset(encoder->depth + pixels, 0, (padded - pixels) * sizeof(uint16_t));
+  memset(encoder->color + pixels, 0, (padded - pixels) * sizeof(uint16_t));
+  encoder->hasReference = 1;
+}
+
+size_t maxGridFrameBytes(int width, int height){
+  size_t pixels = (size_t)width * height;
+  // run varint 는 최대 3 바이트 (2^21 픽셀 미만), 깊이 잔차 최대 3 바이트, 색상 2 바이트
+  return sizeof(GridFrameHeader) + (pixels + 2) * 3 + pixels * 3 + pixels * 2;
+}
+
+static inline uint8_t* writeVarint(uint8_t* out, uint32_t value){
+  while(value >= 0x80){
+    *out++ = (uint8_t)(value | 0x80);
+    value >>= 7;
+  }
+  *out++ = (uint8_t)value;
+  return out;
+}
+
+static inline const uint8_t* readVarint(const uint8_t* in, const uint8_t* end, uint32_t* value){
+  uint32_t result = 0;
+  for(int shift = 0; shift < 35 && in < end; shift += 7){
+    uint8_t byte = *in++;
+    result |= (uint32_t)(byte & 0x7F) << shift;
+    if(!(byte & 0x80)){
+      *value = result;
+      return in;
+    }
+  }
+  return NULL;
+}
+
+void packRGB565(const uint8_t* rgb, uint16_t* out, size_t count){
+  for(size_t i = 0; i < count; ++i){
+    out[i] = (uint16_t)(((rgb[i * 3] >> 3) << 11) | ((rgb[i * 3 + 1] >> 2) << 5) | (rgb[i * 3 + 2] >> 3));
+  }
+}
+
+static inline int absDiff(int a, int b){
+  return a > b ? a - b : b - a;
+}
+
+// 픽셀 하나의 변화 여부 (SIMD 경로의 꼬리 처리 및 기준 구현)
+// 반환값: bit 0 깊이 또는 색상 변화, bit 1 색상 변화
+static inline int pixelChanged(const GridEncoder* e, size_t i, uint16_t depth, uint16_t color){
+  uint16_t ref = e->depth[i];
+  int tolerance = e->depthTolerance + (e->depthToleranceShift ? ref >> e->depthToleranceShift : 0);
+  int depthChanged = absDiff(depth, ref) > tolerance;
+  if(depth == 0){
+    return depthChanged; // 무효 픽셀의 색상은 의미 없음
+  }
+
+  uint16_t refColor = e->color[i];
+  int colorChanged = absDiff(color >> 11, refColor >> 11) > e->colorTolerance ||
+                     absDiff((color >> 5) & 63, (refColor >> 5) & 63) > e->colorTolerance * 2 ||
+                     absDiff(color & 31, refColor & 31) > e->colorTolerance;
+  return (depthChanged | colorChanged) | (colorChanged << 1);
+}
+
+// 8 픽셀당 1 바이트 변화 마스크 생성 (깊이 또는 색상 / 색상만)
+static void computeChangeMask(GridEncoder* e, const uint16_t* depth, const uint16_t* color){
+  const size_t pixels = (size_t)e->width * e->height;
+  size_t b = 0;
+
+#if defined(__SSE2__)
+  const size_t blocks = pixels / 8;
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i depthTolerance = _mm_set1_epi16((short)e->depthTolerance);
+  const __m128i shift = _mm_cvtsi32_si128(e->depthToleranceShift ? e->depthToleranceShift : 16);
+  const __m128i colorTolerance = _mm_set1_epi16((short)e->colorTolerance);
+  const __m128i greenTolerance = _mm_set1_epi16((short)(e->colorTolerance * 2));
+  const __m128i mask6 = _mm_set1_epi16(63);
+  const __m128i mask5 = _mm_set1_epi16(31);
+
+  for(; b < blocks; ++b){
+    const size_t i = b * 8;
+    __m128i cur = _mm_loadu_si128((const __m128i*)(depth + i));
+    __m128i ref = _mm_load_si128((const __m128i*)(e->depth + i));
+
+    // |cur - ref| > tolerance + (ref >> shift), 부호 없는 포화 뺄셈으로 비교
+    __m128i diff = _mm_or_si128(_mm_subs_epu16(cur, ref), _mm_subs_epu16(ref, cur));
+    __m128i tolerance = _mm_adds_epu16(depthTolerance, _mm_srl_epi16(ref, shift));
+    __m128i over = _mm_subs_epu16(diff, tolerance);
+
+    // RGB565 채널별 차이 (현재 깊이가 유효한 픽셀만)
+    __m128i c = _mm_loadu_si128((const __m128i*)(color + i));
+    __m128i rc = _mm_load_si128((const __m128i*)(e->color + i));
+    __m128i cr = _mm_srli_epi16(c, 11), rr = _mm_srli_epi16(rc, 11);
+    __m128i cg = _mm_and_si128(_mm_srli_epi16(c, 5), mask6), rg = _mm_and_si128(_mm_srli_epi16(rc, 5), mask6);
+    __m128i cb = _mm_and_si128(c, mask5), rb = _mm_and_si128(rc, mask5);
+    __m128i colorOver = _mm_subs_epu16(_mm_or_si128(_mm_subs_epu16(cr, rr), _mm_subs_epu16(rr, cr)), colorTolerance);
+    colorOver = _mm_or_si128(colorOver, _mm_subs_epu16(_mm_or_si128(_mm_subs_epu16(cg, rg), _mm_subs_epu16(rg, cg)),
+                                                       greenTolerance));
+    colorOver = _mm_or_si128(colorOver, _mm_subs_epu16(_mm_or_si128(_mm_subs_epu16(cb, rb), _mm_subs_epu16(rb, cb)),
+                                                       colorTolerance));
+    colorOver = _mm_andnot_si128(_mm_cmpeq_epi16(cur, zero), colorOver);
+
+    __m128i unchanged = _mm_cmpeq_epi16(_mm_or_si128(over, colorOver), zero);
+    __m128i colorSame = _mm_cmpeq_epi16(colorOver, zero);
+    e->changeMask[b] = (uint8_t)~_mm_movemask_epi8(_mm_packs_epi16(unchanged, unchanged));
+    e->colorMask[b] = (uint8_t)~_mm_movemask_epi8(_mm_packs_epi16(colorSame, colorSame));
+  }
+#endif
+
+  for(; b * 8 < pixels; ++b){
+    uint8_t bits = 0, colorBits = 0;
+    for(size_t i = b * 8; i < b * 8 + 8 && i < pixels; ++i){
+      int changed = pixelChanged(e, i, depth[i], color[i]);
+      bits |= (uint8_t)((changed & 1) << (i - b * 8));
+      colorBits |= (uint8_t)((changed >> 1) << (i - b * 8));
+    }
+    e->changeMask[b] = bits;
+    e->colorMask[b] = colorBits;
+  }
+}
+
+size_t encodeGridFrame(GridEncoder* encoder, const uint16_t* depth, const uint16_t* color, uint8_t* out,
+                       size_t capacity, GridEncodeStats* stats){
+  GridEncoder* e = encoder;
+  const size_t pixels = (size_t)e->width * e->height;
+  if(!e->depth || capacity < maxGridFrameBytes(e->width, e->height)){
+    return 0;
+  }
+
+  const int keyFrame = !e->hasReference;
+  if(keyFrame){
+    memset(e->depth, 0, paddedPixels(e->width, e->height) * sizeof(uint16_t));
+    memset(e->color, 0, paddedPixels(e->width, e->height) * sizeof(uint16_t));
+  }
+
+  computeChangeMask(e, depth, color);
+
+  // 바뀐 픽셀만 잔차 / 색상 기록하고 기준 갱신 (디코더와 같은 값 유지)
+  uint8_t* runOut = out + sizeof(GridFrameHeader);
+  uint8_t* depthStart = e->scratch;
+  uint8_t* depthOut = depthStart;
+  uint8_t* colorStart = e->scratch + pixels * 3;
+  uint8_t* colorOut = colorStart;
+
+  uint32_t runLength = 0, runs = 0, changed = 0;
+  int inChanged = 0;
+  int lastDepth = 0;
+  for(size_t b = 0; b * 8 < pixels; ++b){
+    const uint32_t bits = e->changeMask[b];
+    const uint32_t colorBits = e->colorMask[b];
+    const size_t begin = b * 8;
+    const uint32_t n = begin + 8 < pixels ? 8 : (uint32_t)(pixels - begin);
+
+    // 바뀌지 않은 블록은 한 번에 건너뜀
+    if(bits == 0 && !inChanged){
+      runLength += n;
+      continue;
+    }
+
+    // 이전 픽셀과 상태가 다른 위치마다 run 종료 (픽셀별 분기 대신 비트 스캔)
+    uint32_t edges = (bits ^ ((bits << 1) | (uint32_t)inChanged)) & ((1u << n) - 1);
+    uint32_t position = 0;
+    while(edges){
+      uint32_t k = (uint32_t)__builtin_ctz(edges);
+      edges &= edges - 1;
+      runOut = writeVarint(runOut, runLength + k - position);
+      runs++;
+      runLength = 0;
+      position = k;
+    }
+    runLength += n - position;
+    inChanged = (bits >> (n - 1)) & 1;
+
+    for(uint32_t m = bits; m; m &= m - 1){
+      const uint32_t k = (uint32_t)__builtin_ctz(m);
+      const size_t i = begin + k;
+
+      // 색상은 바뀌었거나 새로 유효해진 픽셀만 보냄 (깊이 토큰 최하위 비트로 표시)
+      const int d = depth[i];
+      const int prediction = e->depth[i] ? e->depth[i] : lastDepth;
+      const int residual = d - prediction;
+      const int sendColor = d != 0 && (((colorBits >> k) & 1) || e->depth[i] == 0);
+      const uint32_t zigzag = (uint32_t)((residual << 1) ^ (residual >> 31));
+      depthOut = writeVarint(depthOut, (zigzag << 1) | (uint32_t)sendColor);
+      e->depth[i] = (uint16_t)d;
+      if(d != 0){
+        lastDepth = d;
+      }
+      if(sendColor){
+        uint16_t c = color[i];
+        colorOut[0] = (uint8_t)c;
+        colorOut[1] = (uint8_t)(c >> 8);
+        colorOut += 2;
+        e->color[i] = c;
+      }
+      changed++;
+    }
+  }
+  runOut = writeVarint(runOut, runLength);
+  runs++;
+
+  GridFrameHeader header;
+  header.width = (uint16_t)e->width;
+  header.height = (uint16_t)e->height;
+  header.flags = keyFrame ? GRID_FRAME_KEY : 0;
+  header.reserved = 0;
+  header.changed = changed;
+  header.runBytes = (uint32_t)(runOut - (out + sizeof(GridFrameHeader)));
+  header.depthBytes = (uint32_t)(depthOut - depthStart);
+  header.colorBytes = (uint32_t)(colorOut - colorStart);
+  memcpy(out, &header, sizeof(header));
+
+  memcpy(runOut, depthStart, header.depthBytes);
+  memcpy(runOut + header.depthBytes, colorStart, header.colorBytes);
+  e->hasReference = 1;
+
+  size_t bytes = sizeof(GridFrameHeader) + header.runBytes + header.depthBytes + header.colorBytes;
+  if(stats){
+    stats->bytes = bytes;
+    stats->changed = changed;
+    stats->runs = runs;
+    stats->keyFrame = keyFrame;
+  }
+  return bytes;
+}
+
+void initGridDecoder(GridDecoder* decoder){
+  memset(decoder, 0, sizeof(*decoder));
+}
+
+void freeGridDecoder(GridDecoder* decoder){
+  free(decoder->depth);
+  free(decoder->color);
+  initGridDecoder(decoder);
+}
+
+int decodeGridFrame(GridDecoder* decoder, const uint8_t* data, size_t size){
+  GridFrameHeader header;
+  if(size < sizeof(header)){
+    return 0;
+  }
+  memcpy(&header, data, sizeof(header));
+  if(sizeof(header) + (size_t)header.runBytes + header.depthBytes + header.colorBytes > size){
+    return 0;
+  }
+
+  const size_t pixels = (size_t)header.width * header.height;
+  if(header.flags & GRID_FRAME_KEY){
+    if(decoder->width != header.width || decoder->height != header.height){
+      free(decoder->depth);
+      free(decoder->color);
+      decoder->depth = (uint16_t*)malloc(pixels * sizeof(uint16_t));
+      decoder->color = (uint16_t*)malloc(pixels * sizeof(uint16_t));
+      decoder->width = header.width;
+      decoder->height = header.height;
+      if(!decoder->depth || !decoder->color){
+        freeGridDecoder(decoder);
+        return 0;
+      }
+    }
+    memset(decoder->depth, 0, pixels * sizeof(uint16_t));
+    memset(decoder->color, 0, pixels * sizeof(uint16_t));
+  }else if(!decoder->depth || decoder->width != header.width || decoder->height != header.height){
+    return 0;
+  }
+
+  const uint8_t* runIn = data + sizeof(header);
+  const uint8_t* runEnd = runIn + header.runBytes;
+  const uint8_t* depthIn = runEnd;
+  const uint8_t* depthEnd = depthIn + header.depthBytes;
+  const uint8_t* colorIn = depthEnd;
+  const uint8_t* colorEnd = colorIn + header.colorBytes;
+
+  size_t i = 0;
+  int inChanged = 0;
+  int lastDepth = 0;
+  while(i < pixels){
+    uint32_t run;
+    runIn = readVarint(runIn, runEnd, &run);
+    if(!runIn || run > pixels - i){
+      return 0;
+    }
+
+    if(inChanged){
+      for(size_t end = i + run; i < end; ++i){
+        uint32_t token;
+        depthIn = readVarint(depthIn, depthEnd, &token);
+        if(!depthIn){
+          return 0;
+        }
+        const uint32_t zigzag = token >> 1;
+        const int residual = (int)(zigzag >> 1) ^ -(int)(zigzag & 1);
+        const int prediction = decoder->depth[i] ? decoder->depth[i] : lastDepth;
+        const int d = prediction + residual;
+        decoder->depth[i] = (uint16_t)d;
+        if(d != 0){
+          lastDepth = d;
+        }
+        if(token & 1){
+          if(colorIn + 2 > colorEnd){
+            return 0;
+          }
+          decoder->color[i] = (uint16_t)(colorIn[0] | (colorIn[1] << 8));
+          colorIn += 2;
+        }
+      }
+    }else{
+      i += run;
+    }
+    inChanged = !inChanged;
+  }
+  return 1;
+}
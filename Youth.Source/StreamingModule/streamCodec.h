@@ -0,0 +1,99 @@
+#ifndef STREAM_CODEC_H
+#define STREAM_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 센서 격자 포인트 클라우드 코덱
+// 포인트를 XYZ 대신 (격자 픽셀 위치, 깊이) 로 보내고 좌표는 디코더가 광선으로 복원
+// 이전 프레임 (디코더가 복원한 값) 과 비교해 바뀌지 않은 영역은 run 길이만 보내고, 바뀐 픽셀만 깊이 잔차를 보냄
+// 색상 (RGB565) 은 색상이 바뀌었거나 새로 유효해진 픽셀만 보냄
+//
+// 인코딩 결과 (little-endian)
+//   GridFrameHeader
+//   runs  : varint 를 번갈아 (건너뛸 픽셀 수, 바뀐 픽셀 수, ...) 격자 끝까지
+//   depth : 바뀐 픽셀마다 varint (zigzag 잔차 << 1 | 색상 포함 여부)
+//           예측값은 기준 깊이, 기준이 0 (무효) 이면 이번 프레임에서 직전에 보낸 유효 깊이
+//   color : 색상 포함 표시된 픽셀마다 uint16 RGB565
+
+#define GRID_FRAME_KEY 0x1  // 기준 없이 인코딩한 프레임 (디코더 상태 초기화)
+
+typedef struct{
+  uint16_t width;       // 격자 크기
+  uint16_t height;
+  uint16_t flags;       // GRID_FRAME_*
+  uint16_t reserved;
+  uint32_t changed;     // 바뀐 픽셀 수
+  uint32_t runBytes;
+  uint32_t depthBytes;
+  uint32_t colorBytes;
+} GridFrameHeader;
+
+// 인코더 상태 (클라이언트마다 하나, 기준은 그 클라이언트의 디코더가 가진 값과 같음)
+typedef struct{
+  int width, height;
+  uint16_t* depth;        // 기준 깊이 (width * height, 16바이트 정렬)
+  uint16_t* color;        // 기준 RGB565
+  uint8_t* changeMask;    // 8 픽셀당 1 바이트 변화 비트 (깊이 또는 색상)
+  uint8_t* colorMask;     // 8 픽셀당 1 바이트 색상 변화 비트
+  uint8_t* scratch;       // 깊이 잔차 / 색상 작업 버퍼
+  int hasReference;
+  int depthTolerance;       // 이 이하의 깊이 변화는 무시 (깊이 단위, 기본 2)
+  int depthToleranceShift;  // 기준 깊이 >> shift 만큼 허용 오차 추가 (먼 거리 노이즈, 기본 8), 0 이면 사용 안 함
+  int colorTolerance;       // RGB565 채널별 허용 오차 (R/B 5비트 단위, G 는 2배, 기본 1)
+} GridEncoder;
+
+// 인코딩 통계
+typedef struct{
+  size_t bytes;           // 헤더 포함 전체 바이트
+  uint32_t changed;
+  uint32_t runs;
+  int keyFrame;
+} GridEncodeStats;
+
+// 허용 오차는 기본값으로 초기화되므로 필요하면 호출 후 변경
+// 반환값: 성공 시 1, 실패 시 0
+int initGridEncoder(GridEncoder* encoder, int width, int height);
+void freeGridEncoder(GridEncoder* encoder);
+
+// 다음 프레임을 키 프레임으로 인코딩
+void resetGridEncoder(GridEncoder* encoder);
+
+// 같은 허용 오차로 인코딩한 키 프레임 (여러 클라이언트가 공유하는 캐시) 을 보낸 뒤 기준 설정
+// encodeGridFrame 으로 그 키 프레임을 직접 인코딩했을 때와 같은 상태가 됨
+void primeGridEncoder(GridEncoder* encoder, const uint16_t* depth, const uint16_t* color);
+
+// 인코딩 결과 최대 크기
+size_t maxGridFrameBytes(int width, int height);
+
+// RGB 를 RGB565 로 변환 (프레임마다 한 번, 클라이언트별 인코딩 전에)
+void packRGB565(const uint8_t* rgb, uint16_t* out, size_t count);
+
+// 격자 프레임 인코딩 (격자 크기가 바뀌었으면 initGridEncoder 로 다시 초기화해야 함)
+// depth: 무효 픽셀은 0, color: RGB565 (packRGB565)
+// 반환값: out 에 쓴 바이트 수, 용량 부족 시 0
+size_t encodeGridFrame(GridEncoder* encoder, const uint16_t* depth, const uint16_t* color, uint8_t* out,
+                       size_t capacity, GridEncodeStats* stats);
+
+// 디코더 (검증 / 벤치마크용, 브라우저 디코더와 같은 동작)
+typedef struct{
+  int width, height;
+  uint16_t* depth;
+  uint16_t* color;        // RGB565
+} GridDecoder;
+
+void initGridDecoder(GridDecoder* decoder);
+void freeGridDecoder(GridDecoder* decoder);
+
+// 반환값: 성공 시 1, 형식 오류 또는 키 프레임 없이 델타 프레임이 오면 0
+int decodeGridFrame(GridDecoder* decoder, const uint8_t* data, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // STREAM_CODEC_H
@@ -0,0 +1,281 @@
+// 스트리밍 서버 부하 테스트 (루프백)
+// 사용법: StreamLoadTest [clients] [seconds] [slow clients] [port]
+// 서버를 이 프로세스에서 띄우고 합성 프레임을 30 FPS 로 발행하면서 클라이언트 여러 개가 동시에 /stream 을 받음
+// 클라이언트는 형식 (격자 / xyz16) 과 해상도 단계를 돌아가며 고르고, 느린 클라이언트는 프레임마다 100 ms 쉼
+// 클라이언트별 수신 FPS, 건너뛴 프레임, 프레임당 바이트, 지연 시간 (발행 -> 수신), 격자 디코딩 오류를 출력
+
+#include "streamingModule.h"
+#include "streamCodec.h"
+#include "../KernelModule/benchmarkUtil.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define SOURCE_WIDTH 640
+#define SOURCE_HEIGHT 480
+#define SLOW_CLIENT_DELAY_US 100000
+
+static double startTime;
+static uint32_t elapsedMs(){
+  return (uint32_t)((benchmarkNow() - startTime) * 1000.0);
+}
+
+typedef struct{
+  int id;
+  int port;
+  int xyz16;          // 0 이면 격자 코덱
+  int level;
+  int slow;
+
+  // 결과
+  int connected;
+  uint64_t frames;
+  uint64_t skipped;   // frameId 가 건너뛴 수
+  uint64_t bytes;
+  uint64_t decodeErrors;
+  double latencySum;  // ms
+  uint32_t latencyMax;
+  double firstFrame, lastFrame;
+} LoadClient;
+
+// 소켓 버퍼 읽기
+typedef struct{
+  int fd;
+  uint8_t buffer[65536];
+  size_t pos, len;
+} SocketReader;
+
+static int fillReader(SocketReader* r){
+  ssize_t n = recv(r->fd, r->buffer, sizeof(r->buffer), 0);
+  if(n <= 0){
+    return 0;
+  }
+  r->pos = 0;
+  r->len = (size_t)n;
+  return 1;
+}
+
+static int readExact(SocketReader* r, uint8_t* out, size_t size){
+  while(size > 0){
+    if(r->pos == r->len && !fillReader(r)){
+      return 0;
+    }
+    size_t n = r->len - r->pos < size ? r->len - r->pos : size;
+    memcpy(out, r->buffer + r->pos, n);
+    r->pos += n;
+    out += n;
+    size -= n;
+  }
+  return 1;
+}
+
+// CRLF 로 끝나는 한 줄 (CRLF 제외)
+static int readLine(SocketReader* r, char* line, size_t size){
+  size_t used = 0;
+  for(;;){
+    uint8_t c;
+    if(!readExact(r, &c, 1)){
+      return 0;
+    }
+    if(c == '\n'){
+      if(used > 0 && line[used - 1] == '\r') used--;
+      line[used] = '\0';
+      return 1;
+    }
+    if(used + 1 < size){
+      line[used++] = (char)c;
+    }
+  }
+}
+
+static void* clientThread(void* arg){
+  LoadClient* client = (LoadClient*)arg;
+  SocketReader* reader = (SocketReader*)malloc(sizeof(SocketReader));
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if(!reader || fd < 0){
+    free(reader);
+    return NULL;
+  }
+
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons((uint16_t)client->port);
+  // 느린 클라이언트는 수신 버퍼를 작게 잡아 느린 링크처럼 서버 쪽에 밀리게 함
+  // (루프백 수신 버퍼는 수 MB 까지 늘어나 서버가 건너뛰기 전에 거기 프레임이 쌓임)
+  if(client->slow){
+    int receiveBuffer = 16 * 1024;
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &receiveBuffer, sizeof(receiveBuffer));
+  }
+  if(connect(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0){
+    close(fd);
+    free(reader);
+    return NULL;
+  }
+
+  char request[128];
+  snprintf(request, sizeof(request), "GET /stream?format=%s&level=%d HTTP/1.1\r\nHost: localhost\r\n\r\n",
+           client->xyz16 ? "xyz16" : "grid", client->level);
+  send(fd, request, strlen(request), 0);
+
+  reader->fd = fd;
+  reader->pos = reader->len = 0;
+  char line[256];
+  if(!readLine(reader, line, sizeof(line)) || strstr(line, " 200 ") == NULL){
+    close(fd);
+    free(reader);
+    return NULL;
+  }
+  while(readLine(reader, line, sizeof(line)) && line[0] != '\0'){
+  }
+  client->connected = 1;
+
+  GridDecoder decoder;
+  initGridDecoder(&decoder);
+  size_t capacity = 0;
+  uint8_t* frame = NULL;
+  uint32_t lastId = 0;
+
+  // HTTP 청크 하나가 프레임 하나
+  while(readLine(reader, line, sizeof(line))){
+    size_t size = strtoul(line, NULL, 16);
+    if(size == 0){
+      break;
+    }
+    if(size > capacity){
+      uint8_t* grown = (uint8_t*)realloc(frame, size);
+      if(!grown) break;
+      frame = grown;
+      capacity = size;
+    }
+    if(!readExact(reader, frame, size) || !readLine(reader, line, sizeof(line))){
+      break;
+    }
+
+    StreamFrameHeader header;
+    if(size < sizeof(header)){
+      client->decodeErrors++;
+      continue;
+    }
+    memcpy(&header, frame, sizeof(header));
+    uint32_t latency = elapsedMs() - header.timestamp;
+    if(header.magic != STREAM_FRAME_MAGIC || sizeof(header) + header.payloadBytes != size){
+      client->decodeErrors++;
+    }else if(header.format == STREAM_FORMAT_GRID_DELTA){
+      const size_t offset = sizeof(header) + sizeof(StreamGridInfo);
+      if(!decodeGridFrame(&decoder, frame + offset, size - offset)){
+        client->decodeErrors++;
+      }
+    }
+
+    double now = benchmarkNow();
+    if(client->frames == 0){
+      client->firstFrame = now;
+    }else if(header.frameId > lastId + 1){
+      client->skipped += header.frameId - lastId - 1;
+    }
+    client->lastFrame = now;
+    lastId = header.frameId;
+    client->frames++;
+    client->bytes += size;
+    client->latencySum += latency;
+    if(latency > client->latencyMax) client->latencyMax = latency;
+
+    if(client->slow){
+      usleep(SLOW_CLIENT_DELAY_US);
+    }
+  }
+
+  freeGridDecoder(&decoder);
+  free(frame);
+  free(reader);
+  close(fd);
+  return NULL;
+}
+
+int main(int argc, char** argv){
+  int clientCount = argc > 1 ? atoi(argv[1]) : 16;
+  int seconds = argc > 2 ? atoi(argv[2]) : 10;
+  int slowCount = argc > 3 ? atoi(argv[3]) : clientCount / 4;
+  int port = argc > 4 ? atoi(argv[4]) : 18091;
+  if(clientCount < 1) clientCount = 1;
+  if(seconds < 1) seconds = 1;
+
+  StreamingOptions options;
+  setDefaultStreamingOptions(&options);
+  options.port = port;
+  options.maxClients = clientCount;
+  if(!initStreamingModule(&options)){
+    return 1;
+  }
+
+  int16_t* depth = (int16_t*)malloc(SOURCE_WIDTH * SOURCE_HEIGHT * sizeof(int16_t));
+  uint8_t* rgb = (uint8_t*)malloc(SOURCE_WIDTH * SOURCE_HEIGHT * 3);
+  LoadClient* clients = (LoadClient*)calloc(clientCount, sizeof(LoadClient));
+  pthread_t* threads = (pthread_t*)malloc(clientCount * sizeof(pthread_t));
+  if(!depth || !rgb || !clients || !threads){
+    fprintf(stderr, "Allocation failed\n");
+    return 1;
+  }
+
+  startTime = benchmarkNow();
+  for(int k = 0; k < clientCount; ++k){
+    clients[k].id = k;
+    clients[k].port = port;
+    clients[k].xyz16 = k % 2;
+    clients[k].level = (k / 2) % 3;
+    clients[k].slow = k < slowCount;
+    pthread_create(&threads[k], NULL, clientThread, &clients[k]);
+  }
+
+  // 30 FPS 발행 (렌더링 시간을 빼고 대기)
+  const int frames = seconds * 30;
+  double publishSeconds = 0.0;
+  for(int f = 0; f < frames; ++f){
+    renderBenchmarkWaveScene((uint32_t)f, SOURCE_WIDTH, SOURCE_HEIGHT, 4, 0, depth, rgb);
+    double publishStart = benchmarkNow();
+    publishStreamingFrame(depth, rgb, SOURCE_WIDTH, SOURCE_HEIGHT, (uint32_t)f + 1, elapsedMs());
+    publishSeconds += benchmarkNow() - publishStart;
+    double wait = startTime + (f + 1) / 30.0 - benchmarkNow();
+    if(wait > 0.0){
+      usleep((useconds_t)(wait * 1e6));
+    }
+  }
+
+  stopStreamingModule();
+  for(int k = 0; k < clientCount; ++k){
+    pthread_join(threads[k], NULL);
+  }
+
+  printf("\n%d clients (%d slow), %d frames published at 30 FPS, publish %.0f us/frame\n", clientCount, slowCount,
+         frames, publishSeconds * 1e6 / frames);
+  printf("client format level slow    fps  skipped  KB/frame  latency avg/max ms  errors\n");
+  uint64_t totalBytes = 0, totalErrors = 0;
+  int connected = 0;
+  for(int k = 0; k < clientCount; ++k){
+    LoadClient* c = &clients[k];
+    double span = c->lastFrame - c->firstFrame;
+    printf("%6d %-6s %5d %4s %6.1f %8llu %9.1f %9.1f / %-6u %6llu%s\n", c->id, c->xyz16 ? "xyz16" : "grid",
+           c->level, c->slow ? "yes" : "no", span > 0.0 ? (c->frames - 1) / span : 0.0,
+           (unsigned long long)c->skipped, c->frames ? c->bytes / 1024.0 / c->frames : 0.0,
+           c->frames ? c->latencySum / c->frames : 0.0, c->latencyMax, (unsigned long long)c->decodeErrors,
+           c->connected ? "" : "  (not connected)");
+    totalBytes += c->bytes;
+    totalErrors += c->decodeErrors;
+    connected += c->connected;
+  }
+  printf("connected %d/%d, total %.1f Mbit/s, decode errors %llu\n", connected, clientCount,
+         totalBytes * 8.0 / seconds / 1e6, (unsigned long long)totalErrors);
+
+  free(depth);
+  free(rgb);
+  free(clients);
+  free(threads);
+  return totalErrors == 0 && connected == clientCount ? 0 : 1;
+}
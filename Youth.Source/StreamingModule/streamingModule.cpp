@@ -0,0 +1,767 @@
+#include "streamingModule.h"
+#include "streamCodec.h"
+#include <arpa/inet.h>
+#include <linux/sockios.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static const float kStreamScale = 0.001f;  // XYZ 형식 좌표 단위 (mm)
+static const int kSendTimeoutSec = 2;      // 이 시간 안에 보내지 못하면 느린 클라이언트로 보고 끊음
+static const size_t kMaxQueuedBytes = 256 * 1024;  // 소켓에 쌓아 둘 수 있는 (확인 안 된) 바이트 상한
+static const size_t kMaxQueuedFrames = 2;          // 소켓에 쌓아 둘 수 있는 프레임 수 (작은 프레임용 상한)
+
+// 격자 광선 테이블 (내부 파라미터나 해상도가 바뀔 때까지 스냅샷끼리 공유)
+struct GridRays{
+  RayTable table;
+  StreamGridInfo info;
+  GridRays(){
+    memset(&table, 0, sizeof(table));
+  }
+  ~GridRays(){
+    destroyRayTable(&table);
+  }
+};
+
+// 스냅샷의 해상도 단계 하나 (단계 n 은 기본 격자를 2^n 간격으로 샘플링)
+// 형식별 인코딩 결과는 처음 요청한 클라이언트가 한 번 만들고 같은 단계를 받는 클라이언트가 공유
+struct StreamLevel{
+  int width = 0, height = 0;          // 격자 크기
+  std::vector<uint16_t> depth;        // 유효 범위 밖은 0
+  std::vector<uint8_t> rgb;
+  std::vector<uint16_t> color;        // RGB565 (격자 코덱용)
+  std::shared_ptr<const GridRays> rays;
+
+  std::once_flag xyzOnce, keyOnce;
+  std::vector<uint8_t> xyz16;         // 양자화 XYZ 프레임 (헤더 포함)
+  std::vector<uint8_t> gridKey;       // 격자 키 프레임 (헤더 + StreamGridInfo 포함), 새 클라이언트용
+};
+
+// 프레임 스냅샷, 한 번 만들어 모든 클라이언트가 참조 카운트로 공유
+// 단계 0 은 발행할 때 만들고, 나머지 단계와 인코딩 결과는 필요할 때 만듦
+struct StreamSnapshot{
+  uint32_t frameId;
+  uint32_t timestamp;
+  int sourceWidth, sourceHeight;      // 센서 프레임 크기
+  mutable StreamLevel levels[STREAM_MAX_LEVELS];
+  mutable std::once_flag levelOnce[STREAM_MAX_LEVELS];
+};
+
+static StreamingOptions stream_options;
+static std::atomic<bool> stream_running(false);
+static int listen_fd = -1;
+static std::thread accept_thread;
+
+// 최신 스냅샷 (클라이언트는 자신이 보낸 것보다 새 sequence 가 있을 때만 보냄)
+static std::mutex frame_mutex;
+static std::condition_variable frame_cv;
+static std::shared_ptr<const StreamSnapshot> latest_frame;
+static uint64_t latest_sequence = 0;
+
+// 프레임을 기다리는 클라이언트 수 (0 이면 샘플링 생략)
+static std::atomic<int> stream_demand(0);
+
+// 내부 파라미터 / 광선 상태 (snapshot_mutex 로 보호)
+static std::mutex snapshot_mutex;
+static CameraIntrinsics stream_intrinsics;
+static bool has_intrinsics = false;
+static std::shared_ptr<const GridRays> grid_rays[STREAM_MAX_LEVELS];
+
+// 클라이언트 연결
+struct StreamClient{
+  int fd = -1;
+  std::thread thread;
+  std::atomic<bool> done{false};
+};
+
+// 인코딩 캐시 통계 (서버 종료 시 출력)
+static std::atomic<uint64_t> cache_builds(0);  // 스냅샷의 인코딩 결과를 만든 횟수
+static std::atomic<uint64_t> cache_hits(0);    // 다른 클라이언트가 만든 결과를 재사용한 횟수
+
+static std::list<std::unique_ptr<StreamClient>> clients;  // 수신 스레드 전용
+
+void setDefaultStreamingOptions(StreamingOptions* options){
+  options->port = 8090;
+  options->pixelStride = 2;
+  options->minDepth = 0.3f;
+  options->maxDepth = 8.0f;
+  options->maxClients = 8;
+  options->depthTolerance = 2;
+  options->depthToleranceShift = 8;
+  options->colorTolerance = 1;
+}
+
+// 격자 해상도 광선 테이블 (내부 파라미터를 프레임 해상도 -> 격자 해상도로 스케일 조정)
+static std::shared_ptr<const GridRays> createGridRays(int width, int height, int grid_width, int grid_height){
+  CameraIntrinsics K;
+  if(has_intrinsics){
+    scaleCameraIntrinsics(&stream_intrinsics, width, height, &K);
+  }else{
+    setDefaultCameraIntrinsics(&K, width, height);
+  }
+
+  auto rays = std::make_shared<GridRays>();
+  if(!createRayTable(&rays->table, &K, grid_width, grid_height)){
+    return nullptr;
+  }
+
+  CameraIntrinsics gridK;
+  scaleCameraIntrinsics(&K, grid_width, grid_height, &gridK);
+  rays->info.fx = gridK.fx;
+  rays->info.fy = gridK.fy;
+  rays->info.cx = gridK.cx;
+  rays->info.cy = gridK.cy;
+  return rays;
+}
+
+// 단계별 광선 테이블 (해상도나 내부 파라미터가 바뀔 때만 재생성)
+static std::shared_ptr<const GridRays> levelRays(int level, int width, int height, int grid_width, int grid_height){
+  std::lock_guard<std::mutex> lock(snapshot_mutex);
+  std::shared_ptr<const GridRays>& rays = grid_rays[level];
+  if(!rays || rays->table.width != grid_width || rays->table.height != grid_height){
+    rays = createGridRays(width, height, grid_width, grid_height);
+    if(!rays){
+      fprintf(stderr, "Streaming: failed to create ray table\n");
+    }
+  }
+  return rays;
+}
+
+void publishStreamingFrame(const int16_t* depth, const uint8_t* color, int width, int height, uint32_t frame_id,
+                           uint32_t timestamp){
+  if(!stream_running.load(std::memory_order_relaxed) || stream_demand.load(std::memory_order_relaxed) == 0){
+    return;
+  }
+  if(!depth || width <= 0 || height <= 0){
+    return;
+  }
+
+  const int stride = stream_options.pixelStride;
+  const int gridWidth = (width + stride - 1) / stride;
+  const int gridHeight = (height + stride - 1) / stride;
+
+  auto snapshot = std::make_shared<StreamSnapshot>();
+  StreamLevel& base = snapshot->levels[0];
+  base.rays = levelRays(0, width, height, gridWidth, gridHeight);
+  if(!base.rays){
+    return;
+  }
+
+  // 격자 샘플링 + 유효 깊이 범위 마스크 (깊이 단위로 비교)
+  const float depthScale = base.rays->table.depthScale;
+  const uint16_t minRaw = (uint16_t)std::min(65535.0f, ceilf(stream_options.minDepth / depthScale));
+  const uint16_t maxRaw = (uint16_t)std::min(65535.0f, floorf(stream_options.maxDepth / depthScale));
+  const size_t gridPixels = (size_t)gridWidth * gridHeight;
+
+  snapshot->frameId = frame_id;
+  snapshot->timestamp = timestamp;
+  snapshot->sourceWidth = width;
+  snapshot->sourceHeight = height;
+  base.width = gridWidth;
+  base.height = gridHeight;
+  base.depth.resize(gridPixels);
+  base.rgb.resize(gridPixels * 3);
+  base.color.resize(gridPixels);
+
+  const uint16_t* src = (const uint16_t*)depth;
+  for(int v = 0; v < gridHeight; ++v){
+    const size_t row = (size_t)v * stride * width;
+    uint16_t* dst = base.depth.data() + (size_t)v * gridWidth;
+    uint8_t* rgb = base.rgb.data() + (size_t)v * gridWidth * 3;
+    for(int u = 0; u < gridWidth; ++u){
+      const size_t i = row + (size_t)u * stride;
+      const uint16_t d = src[i];
+      dst[u] = d >= minRaw && d <= maxRaw ? d : 0;
+      if(color){
+        memcpy(rgb + u * 3, color + i * 3, 3);
+      }else{
+        memset(rgb + u * 3, 255, 3);
+      }
+    }
+  }
+  packRGB565(base.rgb.data(), base.color.data(), gridPixels);
+
+  {
+    std::lock_guard<std::mutex> lock(frame_mutex);
+    latest_frame = std::move(snapshot);
+    latest_sequence++;
+  }
+  frame_cv.notify_all();
+}
+
+// 스냅샷의 해상도 단계 (처음 요청한 클라이언트가 단계 0 에서 샘플링, 실패하면 NULL)
+static StreamLevel* snapshotLevel(const StreamSnapshot& snapshot, int level){
+  StreamLevel* target = &snapshot.levels[level];
+  if(level == 0){
+    return target;
+  }
+
+  std::call_once(snapshot.levelOnce[level], [&]{
+    const StreamLevel& base = snapshot.levels[0];
+    const int step = 1 << level;
+    const int gridWidth = (base.width + step - 1) / step;
+    const int gridHeight = (base.height + step - 1) / step;
+    target->rays = levelRays(level, snapshot.sourceWidth, snapshot.sourceHeight, gridWidth, gridHeight);
+    if(!target->rays){
+      return;
+    }
+
+    const size_t pixels = (size_t)gridWidth * gridHeight;
+    target->depth.resize(pixels);
+    target->rgb.resize(pixels * 3);
+    target->color.resize(pixels);
+    for(int v = 0, j = 0; v < gridHeight; ++v){
+      const size_t row = (size_t)v * step * base.width;
+      for(int u = 0; u < gridWidth; ++u, ++j){
+        const size_t i = row + (size_t)u * step;
+        target->depth[j] = base.depth[i];
+        target->color[j] = base.color[i];
+        memcpy(target->rgb.data() + (size_t)j * 3, base.rgb.data() + i * 3, 3);
+      }
+    }
+    target->width = gridWidth;
+    target->height = gridHeight;
+  });
+  return target->width > 0 ? target : nullptr;
+}
+
+void setStreamingIntrinsics(const CameraIntrinsics* intrinsics){
+  std::lock_guard<std::mutex> lock(snapshot_mutex);
+  stream_intrinsics = *intrinsics;
+  has_intrinsics = true;
+  for(auto& rays : grid_rays){
+    rays.reset();
+  }
+}
+
+static void fillFrameHeader(StreamFrameHeader* header, const StreamSnapshot& snapshot, int format, uint32_t points,
+                            float scale, size_t payload_bytes){
+  header->magic = STREAM_FRAME_MAGIC;
+  header->version = STREAM_FRAME_VERSION;
+  header->format = (uint16_t)format;
+  header->frameId = snapshot.frameId;
+  header->timestamp = snapshot.timestamp;
+  header->pointCount = points;
+  header->scale = scale;
+  header->payloadBytes = (uint32_t)payload_bytes;
+  header->reserved = 0;
+}
+
+// 양자화 XYZ 프레임 인코딩 (헤더 포함)
+static void encodeXYZ16(const StreamSnapshot& snapshot, const StreamLevel& level, std::vector<uint8_t>* out){
+  const RayTable* rays = &level.rays->table;
+  const size_t pixels = level.depth.size();
+  const float toUnits = rays->depthScale / kStreamScale;
+
+  out->resize(sizeof(StreamFrameHeader) + pixels * 9);
+  int16_t* xyz = (int16_t*)(out->data() + sizeof(StreamFrameHeader));
+  uint8_t* colors = out->data() + sizeof(StreamFrameHeader) + pixels * 6;
+
+  size_t count = 0;
+  for(size_t i = 0; i < pixels; ++i){
+    const uint16_t d = level.depth[i];
+    if(d == 0){
+      continue;
+    }
+    const float z = d * toUnits;
+    xyz[count * 3] = (int16_t)lrintf(rays->rayX[i] * z);
+    xyz[count * 3 + 1] = (int16_t)lrintf(rays->rayY[i] * z);
+    xyz[count * 3 + 2] = (int16_t)lrintf(z);
+    memcpy(colors + count * 3, level.rgb.data() + i * 3, 3);
+    count++;
+  }
+
+  // 색상을 유효 포인트 수에 맞춰 앞으로 당김
+  memmove(out->data() + sizeof(StreamFrameHeader) + count * 6, colors, count * 3);
+  out->resize(sizeof(StreamFrameHeader) + count * 9);
+
+  StreamFrameHeader header;
+  fillFrameHeader(&header, snapshot, STREAM_FORMAT_XYZ16_RGB8, (uint32_t)count, kStreamScale, count * 9);
+  memcpy(out->data(), &header, sizeof(header));
+}
+
+static void applyCodecOptions(GridEncoder* encoder){
+  encoder->depthTolerance = stream_options.depthTolerance;
+  encoder->depthToleranceShift = stream_options.depthToleranceShift;
+  encoder->colorTolerance = stream_options.colorTolerance;
+}
+
+static void countCacheAccess(bool built){
+  (built ? cache_builds : cache_hits).fetch_add(1, std::memory_order_relaxed);
+}
+
+// 단계의 양자화 XYZ 프레임 (처음 요청한 클라이언트가 인코딩, 이후 공유)
+static const std::vector<uint8_t>& cachedXYZ16(const StreamSnapshot& snapshot, StreamLevel* level){
+  bool built = false;
+  std::call_once(level->xyzOnce, [&]{
+    encodeXYZ16(snapshot, *level, &level->xyz16);
+    built = true;
+  });
+  countCacheAccess(built);
+  return level->xyz16;
+}
+
+// 단계의 격자 키 프레임 (이 프레임에서 시작하는 클라이언트가 공유), 실패 시 비어 있음
+static const std::vector<uint8_t>& cachedGridKey(const StreamSnapshot& snapshot, StreamLevel* level){
+  bool built = false;
+  std::call_once(level->keyOnce, [&]{
+    built = true;
+    GridEncoder encoder;
+    if(!initGridEncoder(&encoder, level->width, level->height)){
+      return;
+    }
+    applyCodecOptions(&encoder);
+
+    const size_t prefix = sizeof(StreamFrameHeader) + sizeof(StreamGridInfo);
+    std::vector<uint8_t>& out = level->gridKey;
+    out.resize(prefix + maxGridFrameBytes(level->width, level->height));
+    GridEncodeStats stats;
+    size_t bytes = encodeGridFrame(&encoder, level->depth.data(), level->color.data(), out.data() + prefix,
+                                   out.size() - prefix, &stats);
+    freeGridEncoder(&encoder);
+    if(!bytes){
+      out.clear();
+      return;
+    }
+
+    StreamFrameHeader header;
+    fillFrameHeader(&header, snapshot, STREAM_FORMAT_GRID_DELTA, stats.changed, level->rays->table.depthScale,
+                    sizeof(StreamGridInfo) + bytes);
+    memcpy(out.data(), &header, sizeof(header));
+    memcpy(out.data() + sizeof(header), &level->rays->info, sizeof(StreamGridInfo));
+    out.resize(prefix + bytes);
+  });
+  countCacheAccess(built);
+  return level->gridKey;
+}
+
+// 부분 전송을 이어서 모두 보냄 (SIGPIPE 없이, 시간 초과 시 실패)
+static bool sendAll(int fd, struct iovec* iov, int count){
+  while(count > 0){
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = count;
+
+    ssize_t sent = sendmsg(fd, &msg, MSG_NOSIGNAL);
+    if(sent < 0){
+      if(errno == EINTR){
+        continue;
+      }
+      return false;
+    }
+
+    while(count > 0 && (size_t)sent >= iov->iov_len){
+      sent -= iov->iov_len;
+      iov++;
+      count--;
+    }
+    if(count > 0){
+      iov->iov_base = (char*)iov->iov_base + sent;
+      iov->iov_len -= sent;
+    }
+  }
+  return true;
+}
+
+static bool sendText(int fd, const char* text){
+  struct iovec iov = {(void*)text, strlen(text)};
+  return sendAll(fd, &iov, 1);
+}
+
+// 요청 헤더 끝 (빈 줄) 까지 읽기
+static bool readRequest(int fd, char* buffer, size_t size){
+  size_t used = 0;
+  while(used + 1 < size){
+    ssize_t n = recv(fd, buffer + used, size - 1 - used, 0);
+    if(n <= 0){
+      if(n < 0 && errno == EINTR){
+        continue;
+      }
+      return false;
+    }
+    used += n;
+    buffer[used] = '\0';
+    if(strstr(buffer, "\r\n\r\n")){
+      return true;
+    }
+  }
+  return false;
+}
+
+static const char* kCorsHeaders = "Access-Control-Allow-Origin: *\r\n"
+                                  "Cache-Control: no-cache\r\n"
+                                  "Connection: close\r\n";
+
+// 클라이언트별 인코딩 상태 (격자 코덱은 이 클라이언트가 마지막으로 받은 프레임이 기준)
+// 스냅샷에 캐시된 결과를 보낼 때는 iovec 가 스냅샷 버퍼를 가리키므로 전송이 끝날 때까지 스냅샷을 잡고 있어야 함
+struct ClientEncoder{
+  int format = STREAM_FORMAT_GRID_DELTA;
+  int level = 0;
+  GridEncoder grid;
+  std::vector<uint8_t> buffer;
+  StreamFrameHeader header;
+  StreamGridInfo info;
+
+  ClientEncoder(){
+    memset(&grid, 0, sizeof(grid));
+  }
+  ~ClientEncoder(){
+    freeGridEncoder(&grid);
+  }
+
+  // 헤더 + 페이로드를 iovec 로 반환 (복사 없이 전송), 실패 시 0
+  int encode(const StreamSnapshot& snapshot, struct iovec* iov){
+    StreamLevel* frame = snapshotLevel(snapshot, level);
+    if(!frame){
+      return 0;
+    }
+
+    if(format == STREAM_FORMAT_XYZ16_RGB8){
+      const std::vector<uint8_t>& xyz = cachedXYZ16(snapshot, frame);
+      iov[0] = {(void*)xyz.data(), xyz.size()};
+      return 1;
+    }
+
+    // 격자 크기가 바뀌면 키 프레임부터 다시 시작
+    if(grid.width != frame->width || grid.height != frame->height){
+      if(!initGridEncoder(&grid, frame->width, frame->height)){
+        return 0;
+      }
+      applyCodecOptions(&grid);
+      buffer.resize(maxGridFrameBytes(frame->width, frame->height));
+    }
+
+    // 키 프레임은 스냅샷마다 한 번만 인코딩해 공유하고 기준만 맞춤
+    if(!grid.hasReference){
+      const std::vector<uint8_t>& key = cachedGridKey(snapshot, frame);
+      if(key.empty()){
+        return 0;
+      }
+      primeGridEncoder(&grid, frame->depth.data(), frame->color.data());
+      iov[0] = {(void*)key.data(), key.size()};
+      return 1;
+    }
+
+    GridEncodeStats stats;
+    size_t bytes = encodeGridFrame(&grid, frame->depth.data(), frame->color.data(), buffer.data(), buffer.size(),
+                                   &stats);
+    if(!bytes){
+      return 0;
+    }
+
+    info = frame->rays->info;
+    fillFrameHeader(&header, snapshot, STREAM_FORMAT_GRID_DELTA, stats.changed, frame->rays->table.depthScale,
+                    sizeof(info) + bytes);
+    iov[0] = {&header, sizeof(header)};
+    iov[1] = {&info, sizeof(info)};
+    iov[2] = {buffer.data(), bytes};
+    return 3;
+  }
+};
+
+static double nowSeconds(){
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// GET /stream: 새 프레임이 올 때마다 HTTP 청크 하나로 전송
+static void serveStream(int fd, int format, int level){
+  char head[256];
+  snprintf(head, sizeof(head), "HTTP/1.1 200 OK\r\nContent-Type: application/octet-stream\r\n"
+                               "Transfer-Encoding: chunked\r\n%s\r\n", kCorsHeaders);
+  if(!sendText(fd, head)){
+    return;
+  }
+
+  // 접속 전에 만든 스냅샷은 오래되었을 수 있으므로 다음 프레임부터 보냄
+  uint64_t sentSequence, sentFrames = 0, skippedFrames = 0, sentBytes = 0;
+  {
+    std::lock_guard<std::mutex> lock(frame_mutex);
+    sentSequence = latest_sequence;
+  }
+
+  ClientEncoder encoder;
+  encoder.format = format;
+  encoder.level = level;
+  double encodeSeconds = 0.0, lastSend = nowSeconds();
+  size_t lastFrameBytes = 0;
+  bool slow = false;
+  while(stream_running.load()){
+    std::shared_ptr<const StreamSnapshot> snapshot;
+    {
+      std::unique_lock<std::mutex> lock(frame_mutex);
+      frame_cv.wait_for(lock, std::chrono::seconds(1),
+                        [&]{ return !stream_running.load() || latest_sequence != sentSequence; });
+      if(!stream_running.load() || latest_sequence == sentSequence || !latest_frame){
+        continue;
+      }
+
+      // 보내는 동안 도착한 프레임은 최신 하나만 남기고 건너뜀
+      if(sentFrames > 0){
+        skippedFrames += latest_sequence - sentSequence - 1;
+      }
+      snapshot = latest_frame;
+      sentSequence = latest_sequence;
+    }
+
+    // 앞 프레임들이 아직 소켓에 쌓여 있으면 보내지 않고 다음 프레임을 기다림 (커널 버퍼에 오래된 프레임이 밀리지 않게)
+    int queued = 0;
+    const size_t queueLimit = std::min(kMaxQueuedBytes, lastFrameBytes * kMaxQueuedFrames);
+    if(sentFrames > 0 && ioctl(fd, SIOCOUTQ, &queued) == 0 && (size_t)queued > queueLimit){
+      skippedFrames++;
+      if(nowSeconds() - lastSend > kSendTimeoutSec){
+        slow = true;
+        break;
+      }
+      continue;
+    }
+
+    struct iovec iov[5];
+    double start = nowSeconds();
+    int parts = encoder.encode(*snapshot, iov + 1);
+    encodeSeconds += nowSeconds() - start;
+    if(!parts){
+      break;
+    }
+
+    size_t frameBytes = 0;
+    for(int i = 1; i <= parts; ++i){
+      frameBytes += iov[i].iov_len;
+    }
+    char sizeLine[32];
+    int sizeLength = snprintf(sizeLine, sizeof(sizeLine), "%zx\r\n", frameBytes);
+    iov[0] = {sizeLine, (size_t)sizeLength};
+    iov[parts + 1] = {(void*)"\r\n", 2};
+    if(!sendAll(fd, iov, parts + 2)){
+      slow = errno == EAGAIN || errno == EWOULDBLOCK;
+      break;
+    }
+    sentFrames++;
+    sentBytes += frameBytes;
+    lastSend = nowSeconds();
+    lastFrameBytes = frameBytes;
+  }
+
+  if(!stream_running.load()){
+    sendText(fd, "0\r\n\r\n");
+  }
+  printf("Streaming client %s: %llu frames sent, %llu skipped, %.1f KB/frame, encode %.0f us/frame\n",
+         slow ? "dropped (send timeout)" : "disconnected", (unsigned long long)sentFrames,
+         (unsigned long long)skippedFrames, sentFrames ? sentBytes / 1024.0 / sentFrames : 0.0,
+         sentFrames ? encodeSeconds * 1e6 / sentFrames : 0.0);
+}
+
+// GET /frame: 다음 프레임 하나 (1 초 안에 오지 않으면 마지막 프레임)
+static void serveFrame(int fd, int level){
+  std::shared_ptr<const StreamSnapshot> snapshot;
+  {
+    std::unique_lock<std::mutex> lock(frame_mutex);
+    uint64_t start = latest_sequence;
+    frame_cv.wait_for(lock, std::chrono::seconds(1),
+                      [&]{ return !stream_running.load() || latest_sequence != start; });
+    snapshot = latest_frame;
+  }
+
+  char head[256];
+  if(!snapshot){
+    snprintf(head, sizeof(head), "HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\n%s\r\n", kCorsHeaders);
+    sendText(fd, head);
+    return;
+  }
+
+  StreamLevel* frame = snapshotLevel(*snapshot, level);
+  if(!frame){
+    return;
+  }
+  const std::vector<uint8_t>& xyz = cachedXYZ16(*snapshot, frame);
+  snprintf(head, sizeof(head), "HTTP/1.1 200 OK\r\nContent-Type: application/octet-stream\r\nContent-Length: %zu\r\n%s\r\n",
+           xyz.size(), kCorsHeaders);
+  struct iovec iov[2] = {
+    {head, strlen(head)},
+    {(void*)xyz.data(), xyz.size()},
+  };
+  sendAll(fd, iov, 2);
+}
+
+static void serveClient(StreamClient* client){
+  char request[2048];
+  if(readRequest(client->fd, request, sizeof(request))){
+    char method[16] = {0}, path[256] = {0};
+    sscanf(request, "%15s %255s", method, path);
+    char* query = strchr(path, '?');
+    if(query){
+      *query++ = '\0';
+    }
+    int format = query && strstr(query, "format=xyz16") ? STREAM_FORMAT_XYZ16_RGB8 : STREAM_FORMAT_GRID_DELTA;
+    const char* levelParam = query ? strstr(query, "level=") : NULL;
+    int level = levelParam ? std::max(0, std::min(STREAM_MAX_LEVELS - 1, atoi(levelParam + 6))) : 0;
+
+    char head[256];
+    if(strcmp(method, "OPTIONS") == 0){
+      snprintf(head, sizeof(head), "HTTP/1.1 204 No Content\r\nAccess-Control-Allow-Methods: GET\r\n%s\r\n",
+               kCorsHeaders);
+      sendText(client->fd, head);
+    }else if(strcmp(method, "GET") != 0){
+      snprintf(head, sizeof(head), "HTTP/1.1 405 Method Not Allowed\r\nContent-Length: 0\r\n%s\r\n", kCorsHeaders);
+      sendText(client->fd, head);
+    }else if(strcmp(path, "/stream") == 0 || strcmp(path, "/frame") == 0){
+      stream_demand.fetch_add(1);
+      if(path[1] == 's'){
+        serveStream(client->fd, format, level);
+      }else{
+        serveFrame(client->fd, level);
+      }
+      stream_demand.fetch_sub(1);
+    }else{
+      snprintf(head, sizeof(head), "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n%s\r\n", kCorsHeaders);
+      sendText(client->fd, head);
+    }
+  }
+
+  shutdown(client->fd, SHUT_RDWR);
+  client->done = true;
+}
+
+// 종료된 클라이언트 정리 (all 이면 모두 끊고 정리)
+static void reapClients(bool all){
+  for(auto it = clients.begin(); it != clients.end();){
+    StreamClient* client = it->get();
+    if(all){
+      shutdown(client->fd, SHUT_RDWR);
+    }else if(!client->done){
+      ++it;
+      continue;
+    }
+
+    client->thread.join();
+    close(client->fd);
+    it = clients.erase(it);
+  }
+}
+
+static void acceptLoop(){
+  while(stream_running.load()){
+    struct pollfd pfd = {listen_fd, POLLIN, 0};
+    int ready = poll(&pfd, 1, 200);
+    reapClients(false);
+    if(ready <= 0){
+      continue;
+    }
+
+    int fd = accept(listen_fd, NULL, NULL);
+    if(fd < 0){
+      continue;
+    }
+
+    // 보내기 시간 제한으로 느린 클라이언트가 서버를 붙잡지 않도록 함
+    struct timeval timeout = {kSendTimeoutSec, 0};
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    int noDelay = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+    if((int)clients.size() >= stream_options.maxClients){
+      char head[256];
+      snprintf(head, sizeof(head), "HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\n%s\r\n", kCorsHeaders);
+      sendText(fd, head);
+      close(fd);
+      continue;
+    }
+
+    std::unique_ptr<StreamClient> client(new StreamClient());
+    client->fd = fd;
+    client->thread = std::thread(serveClient, client.get());
+    clients.push_back(std::move(client));
+  }
+
+  reapClients(true);
+}
+
+int initStreamingModule(const StreamingOptions* options){
+  if(stream_running.load()){
+    return 1;
+  }
+
+  if(options){
+    stream_options = *options;
+  }else{
+    setDefaultStreamingOptions(&stream_options);
+  }
+  if(stream_options.pixelStride < 1) stream_options.pixelStride = 1;
+  if(stream_options.maxClients < 1) stream_options.maxClients = 1;
+
+  listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+  if(listen_fd < 0){
+    perror("Streaming socket");
+    return 0;
+  }
+
+  int reuse = 1;
+  setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons((uint16_t)stream_options.port);
+  if(bind(listen_fd, (struct sockaddr*)&addr, sizeof(addr)) < 0 || listen(listen_fd, SOMAXCONN) < 0){
+    perror("Streaming bind");
+    close(listen_fd);
+    listen_fd = -1;
+    return 0;
+  }
+
+  stream_running = true;
+  accept_thread = std::thread(acceptLoop);
+  printf("Point cloud streaming on http://0.0.0.0:%d/stream (stride %d)\n", stream_options.port,
+         stream_options.pixelStride);
+  return 1;
+}
+
+void stopStreamingModule(void){
+  if(!stream_running.exchange(false)){
+    return;
+  }
+
+  frame_cv.notify_all();
+  accept_thread.join();
+  close(listen_fd);
+  listen_fd = -1;
+
+  {
+    std::lock_guard<std::mutex> lock(frame_mutex);
+    latest_frame.reset();
+    latest_sequence = 0;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(snapshot_mutex);
+    for(auto& rays : grid_rays){
+      rays.reset();
+    }
+  }
+  printf("Streaming module stopped (encoded frames %llu built, %llu shared)\n",
+         (unsigned long long)cache_builds.exchange(0), (unsigned long long)cache_hits.exchange(0));
+}
+
+int isStreamingModuleRunning(void){
+  return stream_running.load() ? 1 : 0;
+}
@@ -0,0 +1,81 @@
+#ifndef STREAMING_MODULE_H
+#define STREAMING_MODULE_H
+
+#include <stdint.h>
+#include "../KernelModule/kernelModule.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 실행 중인 파이프라인의 포인트 클라우드를 HTTP 로 내보내는 스트리밍 서버
+// GET /stream              : chunked 전송, HTTP 청크 하나가 포인트 프레임 하나 (격자 코덱)
+// GET /stream?format=xyz16 : 같은 방식, 양자화 XYZ 형식
+// GET /frame               : 최신 프레임 하나 (양자화 XYZ, Content-Length)
+// ?level=n                 : 격자를 2^n 간격으로 다시 샘플링한 해상도 단계 (0 ~ STREAM_MAX_LEVELS - 1)
+// 클라이언트는 항상 최신 프레임을 받고, 느린 클라이언트는 프레임을 건너뜀
+// 프레임 스냅샷은 참조 카운트로 공유하며, 단계별 샘플링 / 양자화 XYZ / 격자 키 프레임은 프레임마다 한 번만 만듦
+//
+// 포인트 프레임 (little-endian), StreamFrameHeader (32 바이트) 뒤에 format 에 따라
+//   STREAM_FORMAT_XYZ16_RGB8 : int16 xyz[pointCount * 3] 카메라 좌표 (scale 단위, 기본 mm) + uint8 rgb[pointCount * 3]
+//   STREAM_FORMAT_GRID_DELTA : StreamGridInfo + 격자 코덱 프레임 (streamCodec.h)
+//                              pointCount 는 바뀐 픽셀 수, scale 은 깊이 단위 (m)
+//                              클라이언트는 격자 (u, v) 의 광선 ((u - cx) / fx, (v - cy) / fy) 에 깊이를 곱해 좌표 복원
+
+#define STREAM_FRAME_MAGIC 0x31435059u  // "YPC1"
+#define STREAM_FRAME_VERSION 1
+#define STREAM_FORMAT_XYZ16_RGB8 1
+#define STREAM_FORMAT_GRID_DELTA 2
+#define STREAM_MAX_LEVELS 4
+
+typedef struct{
+  uint32_t magic;
+  uint16_t version;
+  uint16_t format;
+  uint32_t frameId;
+  uint32_t timestamp;     // 프레임 타임스템프 (ms)
+  uint32_t pointCount;
+  float scale;            // 좌표 단위 (m), xyz * scale = 미터 (격자 형식은 깊이 단위)
+  uint32_t payloadBytes;  // 헤더 뒤에 오는 바이트 수
+  uint32_t reserved;
+} StreamFrameHeader;
+
+// 격자 내부 파라미터 (격자 픽셀 단위)
+typedef struct{
+  float fx, fy;
+  float cx, cy;
+} StreamGridInfo;
+
+// 스트리밍 옵션
+typedef struct{
+  int port;           // 수신 포트
+  int pixelStride;    // 격자 샘플링 픽셀 간격 (2 이면 1/4 포인트)
+  float minDepth;     // 유효 깊이 범위 (m)
+  float maxDepth;
+  int maxClients;     // 동시 접속 수 제한
+  int depthTolerance; // 격자 코덱 허용 오차 (GridEncoder 와 같은 의미)
+  int depthToleranceShift;
+  int colorTolerance;
+} StreamingOptions;
+
+void setDefaultStreamingOptions(StreamingOptions* options);
+
+// 스트리밍 서버 시작 / 종료
+// 반환값: 성공 시 1, 실패 시 0 (포트 사용 중 등)
+int initStreamingModule(const StreamingOptions* options);
+void stopStreamingModule(void);
+int isStreamingModuleRunning(void);
+
+// 역투영 내부 파라미터 (임의의 스레드, 설정하지 않으면 Astra 기본값)
+void setStreamingIntrinsics(const CameraIntrinsics* intrinsics);
+
+// 완성된 프레임 전달 (로거 / 재생 스레드)
+// 접속한 클라이언트가 없으면 바로 반환, 있으면 격자 샘플링 결과를 한 번 만들어 모든 클라이언트가 공유
+void publishStreamingFrame(const int16_t* depth, const uint8_t* color, int width, int height, uint32_t frame_id,
+                           uint32_t timestamp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // STREAMING_MODULE_H
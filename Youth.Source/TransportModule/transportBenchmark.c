@@ -0,0 +1,170 @@
+// 프레임 전송 벤치마크 (프로세스 두 개, 루프백 또는 LAN)
+// 사용법: TransportBenchmark receive [port] [work ms]
+//         TransportBenchmark send <host> [port] [seconds] [raw]
+// 수신 측은 SLAM 대신 프레임마다 work ms 동안 처리하는 척하고 단위 행렬 자세를 돌려줌
+// 합성 프레임은 타임스템프로 결정되므로 수신 측이 같은 프레임을 만들어 무손실 복원을 확인
+// 송신 측은 30 FPS 로 프레임을 넣고 보낸 / 버린 프레임, 프레임당 바이트, ACK / 자세 왕복 시간을 출력
+
+#include "transportModule.h"
+#include "../KernelModule/benchmarkUtil.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define SOURCE_WIDTH 640
+#define SOURCE_HEIGHT 480
+
+// 합성 장면: 물결 벽 + 센서 노이즈 + 군데군데 무효 픽셀, 왼쪽 아래는 무효 영역 (깊이 mm)
+// 수신 측도 타임스템프로 같은 영상을 만들어 무손실 복원을 확인
+static void renderFrame(uint32_t timestamp, int16_t* depth, uint8_t* rgb){
+  renderBenchmarkWaveScene(timestamp / 33, SOURCE_WIDTH, SOURCE_HEIGHT, 8, 97, depth, rgb);
+  for(int v = 401; v < SOURCE_HEIGHT; ++v){
+    memset(depth + (size_t)v * SOURCE_WIDTH, 0, 24 * sizeof(int16_t));
+  }
+}
+
+// ---------------------------------------------------------------------------
+// 수신 측
+
+static int workMs = 0;
+static int16_t* expectedDepth = NULL;
+static uint8_t* expectedColor = NULL;
+static uint64_t receivedFrames = 0, mismatchedFrames = 0;
+
+static void onFrame(const int16_t* depth, const uint8_t* color, int width, int height, uint32_t frame_id,
+                    uint32_t timestamp, void* user_data){
+  (void)user_data;
+  receivedFrames++;
+  renderFrame(timestamp, expectedDepth, expectedColor);
+  if(width != SOURCE_WIDTH || height != SOURCE_HEIGHT || !color ||
+     memcmp(depth, expectedDepth, (size_t)width * height * sizeof(int16_t)) != 0 ||
+     memcmp(color, expectedColor, (size_t)width * height * 3) != 0){
+    mismatchedFrames++;
+    fprintf(stderr, "Frame %u differs from the sent frame\n", frame_id);
+  }
+
+  // 추적 시간 흉내 (콜백이 끝나야 ACK 가 나가므로 느린 수신 측이 됨)
+  if(workMs > 0){
+    usleep(workMs * 1000);
+  }
+  static const float identity[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+  sendReceiverPose(timestamp / 1000.0, 2, identity, (float)workMs);
+}
+
+static int runReceiver(int port){
+  expectedDepth = (int16_t*)malloc(SOURCE_WIDTH * SOURCE_HEIGHT * sizeof(int16_t));
+  expectedColor = (uint8_t*)malloc(SOURCE_WIDTH * SOURCE_HEIGHT * 3);
+  if(!expectedDepth || !expectedColor || !initFrameReceiver(port, onFrame, NULL)){
+    return 1;
+  }
+
+  // 송신 측이 한 번 연결했다가 끊을 때까지
+  uint64_t last = 0;
+  int idle = 0;
+  while(idle < 3 || receivedFrames == 0){
+    sleep(1);
+    idle = receivedFrames == last ? idle + 1 : 0;
+    last = receivedFrames;
+  }
+  stopFrameReceiver();
+  printf("Received %llu frames, %llu mismatched\n", (unsigned long long)receivedFrames,
+         (unsigned long long)mismatchedFrames);
+  free(expectedDepth);
+  free(expectedColor);
+  return mismatchedFrames == 0 ? 0 : 1;
+}
+
+// ---------------------------------------------------------------------------
+// 송신 측
+
+#define SUBMIT_SLOTS 256
+static pthread_mutex_t poseMutex = PTHREAD_MUTEX_INITIALIZER;
+static double submitTimes[SUBMIT_SLOTS];  // 타임스템프 / 33 으로 색인
+static double poseSeconds = 0.0, poseMax = 0.0;
+static uint64_t poseCount = 0;
+
+static void onPose(double timestamp, int tracking_state, const float* Twc, float track_ms, void* user_data){
+  (void)tracking_state;
+  (void)Twc;
+  (void)track_ms;
+  (void)user_data;
+  uint32_t ms = (uint32_t)(timestamp * 1000.0 + 0.5);
+  pthread_mutex_lock(&poseMutex);
+  double latency = benchmarkNow() - submitTimes[(ms / 33) % SUBMIT_SLOTS];
+  poseSeconds += latency;
+  if(latency > poseMax) poseMax = latency;
+  poseCount++;
+  pthread_mutex_unlock(&poseMutex);
+}
+
+static int runSender(const char* host, int port, int seconds, int raw){
+  FrameSenderOptions options;
+  setDefaultFrameSenderOptions(&options);
+  options.compressDepth = !raw;
+  if(!initFrameSender(host, port, &options)){
+    return 1;
+  }
+  setSenderPoseCallback(onPose, NULL);
+
+  int16_t* depth = (int16_t*)malloc(SOURCE_WIDTH * SOURCE_HEIGHT * sizeof(int16_t));
+  uint8_t* rgb = (uint8_t*)malloc(SOURCE_WIDTH * SOURCE_HEIGHT * 3);
+  if(!depth || !rgb){
+    return 1;
+  }
+
+  const double start = benchmarkNow();
+  const int frames = seconds * 30;
+  for(int f = 0; f < frames && isFrameSenderRunning(); ++f){
+    const uint32_t timestamp = (uint32_t)f * 33;
+    renderFrame(timestamp, depth, rgb);
+    pthread_mutex_lock(&poseMutex);
+    submitTimes[(timestamp / 33) % SUBMIT_SLOTS] = benchmarkNow();
+    pthread_mutex_unlock(&poseMutex);
+    submitSenderFrame(depth, rgb, SOURCE_WIDTH, SOURCE_HEIGHT, timestamp);
+
+    double wait = start + (f + 1) / 30.0 - benchmarkNow();
+    if(wait > 0.0){
+      usleep((useconds_t)(wait * 1e6));
+    }
+  }
+  usleep(300000);  // 마지막 자세 대기
+
+  FrameSenderStats stats;
+  getFrameSenderStats(&stats);
+  stopFrameSender();
+
+  const double elapsed = benchmarkNow() - start;
+  printf("\nDepth %s: %llu submitted, %llu sent (%.1f FPS), %llu dropped\n", raw ? "raw" : "compressed",
+         (unsigned long long)stats.submitted, (unsigned long long)stats.sent, stats.sent / elapsed,
+         (unsigned long long)stats.dropped);
+  printf("%.1f KB/frame (raw %.1f KB, %.0f%%), %.1f Mbit/s, compress %.2f ms/frame\n",
+         stats.sent ? stats.bytes / 1024.0 / stats.sent : 0.0, stats.sent ? stats.rawBytes / 1024.0 / stats.sent : 0.0,
+         stats.rawBytes ? 100.0 * stats.bytes / stats.rawBytes : 0.0, stats.bytes * 8.0 / elapsed / 1e6,
+         stats.compressMs);
+  printf("ack %.2f ms, pose %llu received, latency %.2f ms avg / %.2f ms max (submit -> pose)\n", stats.ackMs,
+         (unsigned long long)poseCount, poseCount ? poseSeconds * 1000.0 / poseCount : 0.0, poseMax * 1000.0);
+
+  free(depth);
+  free(rgb);
+  return stats.sent > 0 && poseCount > 0 ? 0 : 1;
+}
+
+int main(int argc, char** argv){
+  if(argc > 1 && strcmp(argv[1], "receive") == 0){
+    int port = argc > 2 ? atoi(argv[2]) : TRANSPORT_DEFAULT_PORT;
+    workMs = argc > 3 ? atoi(argv[3]) : 0;
+    return runReceiver(port);
+  }
+  if(argc > 2 && strcmp(argv[1], "send") == 0){
+    int port = argc > 3 ? atoi(argv[3]) : TRANSPORT_DEFAULT_PORT;
+    int seconds = argc > 4 ? atoi(argv[4]) : 10;
+    int raw = argc > 5 && strcmp(argv[5], "raw") == 0;
+    return runSender(argv[2], port, seconds > 0 ? seconds : 1, raw);
+  }
+
+  fprintf(stderr, "Usage: %s receive [port] [work ms]\n       %s send <host> [port] [seconds] [raw]\n", argv[0],
+          argv[0]);
+  return 1;
+}
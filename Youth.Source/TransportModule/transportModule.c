@@ -0,0 +1,740 @@
+#include "transportModule.h"
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SEND_TIME_SLOTS 64    // ACK 왕복 시간 측정용 (frameId 로 색인)
+#define RECENT_FRAME_SLOTS 64 // 자세 -> frameId 대응용 최근 프레임 타임스템프
+
+static double nowSeconds(){
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// ---------------------------------------------------------------------------
+// 깊이 무손실 압축
+// 토큰 (varint): 유효 깊이는 zigzag(잔차) << 1, 0 이 n 개 이어지면 (n << 1) | 1
+// 예측값은 왼쪽 / 위 / 왼쪽 위 이웃이 모두 유효하면 MED (LOCO-I), 아니면 유효한 이웃이나 직전 유효 깊이
+
+static inline uint8_t* writeVarint(uint8_t* out, uint32_t value){
+  while(value >= 0x80){
+    *out++ = (uint8_t)(value | 0x80);
+    value >>= 7;
+  }
+  *out++ = (uint8_t)value;
+  return out;
+}
+
+static inline const uint8_t* readVarint(const uint8_t* in, const uint8_t* end, uint32_t* value){
+  uint32_t result = 0;
+  for(int shift = 0; in < end && shift < 35; shift += 7){
+    uint8_t byte = *in++;
+    result |= (uint32_t)(byte & 0x7f) << shift;
+    if(byte < 0x80){
+      *value = result;
+      return in;
+    }
+  }
+  return NULL;
+}
+
+static inline int predictDepth(const uint16_t* row, const uint16_t* above, int u, int last){
+  const int a = u > 0 ? row[u - 1] : 0;
+  const int b = above ? above[u] : 0;
+  const int c = above && u > 0 ? above[u - 1] : 0;
+  if(a && b && c){
+    const int hi = a > b ? a : b, lo = a < b ? a : b;
+    return c >= hi ? lo : c <= lo ? hi : a + b - c;
+  }
+  return a ? a : b ? b : last;
+}
+
+size_t maxCompressedDepthBytes(int width, int height){
+  // 유효 깊이 토큰은 최대 3 바이트 (18 비트), 0 run 토큰은 덮는 픽셀 수보다 길지 않음
+  return (size_t)width * height * 3 + 8;
+}
+
+size_t compressDepthPlane(const uint16_t* depth, int width, int height, uint8_t* out){
+  uint8_t* p = out;
+  uint32_t zeros = 0;
+  int last = 0;
+  for(int v = 0; v < height; ++v){
+    const uint16_t* row = depth + (size_t)v * width;
+    const uint16_t* above = v > 0 ? row - width : NULL;
+    for(int u = 0; u < width; ++u){
+      const int d = row[u];
+      if(d == 0){
+        zeros++;
+        continue;
+      }
+      if(zeros){
+        p = writeVarint(p, (zeros << 1) | 1u);
+        zeros = 0;
+      }
+      const int residual = d - predictDepth(row, above, u, last);
+      p = writeVarint(p, (uint32_t)((residual << 1) ^ (residual >> 31)) << 1);
+      last = d;
+    }
+  }
+  if(zeros){
+    p = writeVarint(p, (zeros << 1) | 1u);
+  }
+  return (size_t)(p - out);
+}
+
+int decompressDepthPlane(const uint8_t* data, size_t size, int width, int height, uint16_t* depth){
+  const uint8_t* in = data;
+  const uint8_t* end = data + size;
+  const size_t pixels = (size_t)width * height;
+  size_t i = 0;
+  int u = 0, v = 0;
+  int last = 0;
+  while(i < pixels){
+    uint32_t token;
+    if(!(in = readVarint(in, end, &token))){
+      return 0;
+    }
+    if(token & 1u){
+      uint32_t run = token >> 1;
+      if(run > pixels - i){
+        return 0;
+      }
+      memset(depth + i, 0, run * sizeof(uint16_t));
+      i += run;
+      v = (int)(i / width);
+      u = (int)(i % width);
+      continue;
+    }
+
+    const uint16_t* row = depth + (size_t)v * width;
+    const uint32_t zigzag = token >> 1;
+    const int residual = (int)(zigzag >> 1) ^ -(int)(zigzag & 1);
+    const int d = predictDepth(row, v > 0 ? row - width : NULL, u, last) + residual;
+    if(d <= 0 || d > 65535){
+      return 0;
+    }
+    depth[i++] = (uint16_t)d;
+    last = d;
+    if(++u == width){
+      u = 0;
+      v++;
+    }
+  }
+  return in == end;
+}
+
+// ---------------------------------------------------------------------------
+// 소켓 도우미
+
+// 부분 전송을 이어서 모두 보냄 (SIGPIPE 없이)
+static int sendAll(int fd, struct iovec* iov, int count){
+  while(count > 0){
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = count;
+
+    ssize_t sent = sendmsg(fd, &msg, MSG_NOSIGNAL);
+    if(sent < 0){
+      if(errno == EINTR){
+        continue;
+      }
+      return 0;
+    }
+
+    while(count > 0 && (size_t)sent >= iov->iov_len){
+      sent -= iov->iov_len;
+      iov++;
+      count--;
+    }
+    if(count > 0){
+      iov->iov_base = (char*)iov->iov_base + sent;
+      iov->iov_len -= sent;
+    }
+  }
+  return 1;
+}
+
+static int recvAll(int fd, void* buffer, size_t size){
+  uint8_t* p = (uint8_t*)buffer;
+  while(size > 0){
+    ssize_t n = recv(fd, p, size, 0);
+    if(n <= 0){
+      if(n < 0 && errno == EINTR){
+        continue;
+      }
+      return 0;
+    }
+    p += n;
+    size -= n;
+  }
+  return 1;
+}
+
+// 필요 없는 페이로드 건너뛰기
+static int skipBytes(int fd, size_t size){
+  uint8_t scratch[4096];
+  while(size > 0){
+    size_t n = size < sizeof(scratch) ? size : sizeof(scratch);
+    if(!recvAll(fd, scratch, n)){
+      return 0;
+    }
+    size -= n;
+  }
+  return 1;
+}
+
+static void setNoDelay(int fd){
+  int noDelay = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+}
+
+static void fillHeader(TransportHeader* header, int type, uint32_t frame_id, uint32_t timestamp){
+  memset(header, 0, sizeof(*header));
+  header->magic = TRANSPORT_MAGIC;
+  header->type = (uint16_t)type;
+  header->frameId = frame_id;
+  header->timestamp = timestamp;
+}
+
+// 크기가 모자랄 때만 다시 할당
+static int ensureBuffer(void** buffer, size_t* capacity, size_t size){
+  if(*capacity >= size){
+    return 1;
+  }
+  void* grown = realloc(*buffer, size);
+  if(!grown){
+    return 0;
+  }
+  *buffer = grown;
+  *capacity = size;
+  return 1;
+}
+
+// ---------------------------------------------------------------------------
+// 송신 측
+
+// 프레임 한 칸 (mailbox 와 송신 중인 프레임이 번갈아 사용)
+typedef struct{
+  int16_t* depth;
+  uint8_t* color;
+  size_t depthCapacity, colorCapacity;
+  int width, height;
+  int hasColor;
+  uint32_t timestamp;
+} SenderSlot;
+
+static FrameSenderOptions senderOptions;
+static int senderFd = -1;
+static volatile int senderRunning = 0;
+static pthread_t senderThreadId;
+static pthread_t senderReceiveThreadId;
+
+// mailbox (senderMutex 로 보호)
+static pthread_mutex_t senderMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t senderCond = PTHREAD_COND_INITIALIZER;
+static SenderSlot mailbox, outgoing;
+static int mailboxFull = 0;
+static int inFlight = 0;
+static uint32_t nextFrameId = 0;
+static double sendTimes[SEND_TIME_SLOTS];
+static FrameSenderStats senderStats;
+static double ackSeconds = 0.0, compressSeconds = 0.0;
+
+static TransportPoseCallback poseCallback = NULL;
+static void* poseCallbackUser = NULL;
+
+void setDefaultFrameSenderOptions(FrameSenderOptions* options){
+  options->compressDepth = 1;
+  options->maxInFlight = 2;
+}
+
+static void freeSlot(SenderSlot* slot){
+  free(slot->depth);
+  free(slot->color);
+  memset(slot, 0, sizeof(*slot));
+}
+
+// 송신 스레드: mailbox 의 최신 프레임을 꺼내 헤더 + 깊이 + 색상을 sendmsg 한 번으로 전송
+static void* senderThread(void* arg){
+  (void)arg;
+  uint8_t* compressed = NULL;
+  size_t compressedCapacity = 0;
+
+  while(senderRunning){
+    pthread_mutex_lock(&senderMutex);
+    while(senderRunning && (!mailboxFull || inFlight >= senderOptions.maxInFlight)){
+      pthread_cond_wait(&senderCond, &senderMutex);
+    }
+    if(!senderRunning){
+      pthread_mutex_unlock(&senderMutex);
+      break;
+    }
+    SenderSlot swap = outgoing;
+    outgoing = mailbox;
+    mailbox = swap;
+    mailboxFull = 0;
+    inFlight++;
+    const uint32_t frameId = ++nextFrameId;
+    pthread_mutex_unlock(&senderMutex);
+
+    const SenderSlot* frame = &outgoing;
+    const size_t pixels = (size_t)frame->width * frame->height;
+    const size_t colorBytes = frame->hasColor ? pixels * 3 : 0;
+    TransportHeader header;
+    fillHeader(&header, TRANSPORT_MSG_FRAME, frameId, frame->timestamp);
+    header.width = (uint16_t)frame->width;
+    header.height = (uint16_t)frame->height;
+
+    struct iovec iov[3];
+    iov[0].iov_base = &header;
+    iov[0].iov_len = sizeof(header);
+    double compressTime = 0.0;
+    if(senderOptions.compressDepth &&
+       ensureBuffer((void**)&compressed, &compressedCapacity, maxCompressedDepthBytes(frame->width, frame->height))){
+      double start = nowSeconds();
+      header.depthBytes = (uint32_t)compressDepthPlane((const uint16_t*)frame->depth, frame->width, frame->height,
+                                                       compressed);
+      compressTime = nowSeconds() - start;
+      header.flags |= TRANSPORT_FLAG_DEPTH_COMPRESSED;
+      iov[1].iov_base = compressed;
+    }else{
+      header.depthBytes = (uint32_t)(pixels * sizeof(int16_t));
+      iov[1].iov_base = frame->depth;
+    }
+    iov[1].iov_len = header.depthBytes;
+    iov[2].iov_base = frame->color;
+    iov[2].iov_len = colorBytes;
+    header.payloadBytes = header.depthBytes + (uint32_t)colorBytes;
+
+    pthread_mutex_lock(&senderMutex);
+    sendTimes[frameId % SEND_TIME_SLOTS] = nowSeconds();
+    pthread_mutex_unlock(&senderMutex);
+
+    if(!sendAll(senderFd, iov, colorBytes ? 3 : 2)){
+      if(senderRunning){
+        fprintf(stderr, "Frame sender: connection lost (%s)\n", strerror(errno));
+      }
+      senderRunning = 0;
+      break;
+    }
+
+    pthread_mutex_lock(&senderMutex);
+    senderStats.sent++;
+    senderStats.bytes += sizeof(header) + header.payloadBytes;
+    senderStats.rawBytes += sizeof(header) + pixels * sizeof(int16_t) + colorBytes;
+    compressSeconds += compressTime;
+    pthread_mutex_unlock(&senderMutex);
+  }
+
+  free(compressed);
+  return NULL;
+}
+
+// 응답 수신 스레드: ACK 로 보낼 수 있는 프레임 수를 늘리고, 자세는 콜백으로 전달
+static void* senderReceiveThread(void* arg){
+  (void)arg;
+  TransportHeader header;
+  while(senderRunning && recvAll(senderFd, &header, sizeof(header))){
+    if(header.magic != TRANSPORT_MAGIC){
+      fprintf(stderr, "Frame sender: invalid message from receiver\n");
+      break;
+    }
+
+    if(header.type == TRANSPORT_MSG_ACK){
+      pthread_mutex_lock(&senderMutex);
+      if(inFlight > 0) inFlight--;
+      senderStats.acked++;
+      ackSeconds += nowSeconds() - sendTimes[header.frameId % SEND_TIME_SLOTS];
+      pthread_cond_signal(&senderCond);
+      pthread_mutex_unlock(&senderMutex);
+    }else if(header.type == TRANSPORT_MSG_POSE && header.payloadBytes == sizeof(TransportPose)){
+      TransportPose pose;
+      if(!recvAll(senderFd, &pose, sizeof(pose))){
+        break;
+      }
+      pthread_mutex_lock(&senderMutex);
+      senderStats.poses++;
+      TransportPoseCallback callback = poseCallback;
+      void* user = poseCallbackUser;
+      pthread_mutex_unlock(&senderMutex);
+      if(callback){
+        callback(pose.timestamp, pose.trackingState, pose.Twc, pose.trackMs, user);
+      }
+    }else if(!skipBytes(senderFd, header.payloadBytes)){
+      break;
+    }
+  }
+
+  if(senderRunning){
+    fprintf(stderr, "Frame sender: receiver disconnected\n");
+  }
+  pthread_mutex_lock(&senderMutex);
+  senderRunning = 0;
+  pthread_cond_broadcast(&senderCond);
+  pthread_mutex_unlock(&senderMutex);
+  return NULL;
+}
+
+int initFrameSender(const char* host, int port, const FrameSenderOptions* options){
+  if(senderFd >= 0){
+    return 1;
+  }
+
+  if(options){
+    senderOptions = *options;
+  }else{
+    setDefaultFrameSenderOptions(&senderOptions);
+  }
+  if(senderOptions.maxInFlight < 1) senderOptions.maxInFlight = 1;
+
+  char service[16];
+  snprintf(service, sizeof(service), "%d", port);
+  struct addrinfo hints, *result = NULL;
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  int error = getaddrinfo(host, service, &hints, &result);
+  if(error != 0){
+    fprintf(stderr, "Frame sender: cannot resolve %s (%s)\n", host, gai_strerror(error));
+    return 0;
+  }
+
+  int fd = -1;
+  for(struct addrinfo* ai = result; ai && fd < 0; ai = ai->ai_next){
+    fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+    if(fd >= 0 && connect(fd, ai->ai_addr, ai->ai_addrlen) < 0){
+      close(fd);
+      fd = -1;
+    }
+  }
+  freeaddrinfo(result);
+  if(fd < 0){
+    fprintf(stderr, "Frame sender: cannot connect to %s:%d\n", host, port);
+    return 0;
+  }
+  setNoDelay(fd);
+
+  senderFd = fd;
+  mailboxFull = 0;
+  inFlight = 0;
+  nextFrameId = 0;
+  memset(&senderStats, 0, sizeof(senderStats));
+  ackSeconds = compressSeconds = 0.0;
+  senderRunning = 1;
+  pthread_create(&senderThreadId, NULL, senderThread, NULL);
+  pthread_create(&senderReceiveThreadId, NULL, senderReceiveThread, NULL);
+  printf("Frame sender connected to %s:%d (depth %s, %d frames in flight)\n", host, port,
+         senderOptions.compressDepth ? "compressed" : "raw", senderOptions.maxInFlight);
+  return 1;
+}
+
+void stopFrameSender(void){
+  if(senderFd < 0){
+    return;
+  }
+
+  pthread_mutex_lock(&senderMutex);
+  senderRunning = 0;
+  pthread_cond_broadcast(&senderCond);
+  pthread_mutex_unlock(&senderMutex);
+
+  shutdown(senderFd, SHUT_RDWR);
+  pthread_join(senderThreadId, NULL);
+  pthread_join(senderReceiveThreadId, NULL);
+  close(senderFd);
+  senderFd = -1;
+
+  FrameSenderStats stats;
+  getFrameSenderStats(&stats);
+  printf("Frame sender stopped: %llu sent, %llu dropped, %llu poses, %.1f KB/frame (%.0f%% of raw), ack %.1f ms\n",
+         (unsigned long long)stats.sent, (unsigned long long)stats.dropped, (unsigned long long)stats.poses,
+         stats.sent ? stats.bytes / 1024.0 / stats.sent : 0.0,
+         stats.rawBytes ? 100.0 * stats.bytes / stats.rawBytes : 0.0, stats.ackMs);
+
+  pthread_mutex_lock(&senderMutex);
+  freeSlot(&mailbox);
+  freeSlot(&outgoing);
+  pthread_mutex_unlock(&senderMutex);
+}
+
+int isFrameSenderRunning(void){
+  return senderRunning;
+}
+
+void setSenderPoseCallback(TransportPoseCallback callback, void* user_data){
+  pthread_mutex_lock(&senderMutex);
+  poseCallback = callback;
+  poseCallbackUser = user_data;
+  pthread_mutex_unlock(&senderMutex);
+}
+
+void submitSenderFrame(const int16_t* depth, const uint8_t* color, int width, int height, uint32_t timestamp){
+  if(!senderRunning || !depth || width <= 0 || height <= 0){
+    return;
+  }
+
+  const size_t pixels = (size_t)width * height;
+  pthread_mutex_lock(&senderMutex);
+  senderStats.submitted++;
+  if(!ensureBuffer((void**)&mailbox.depth, &mailbox.depthCapacity, pixels * sizeof(int16_t)) ||
+     (color && !ensureBuffer((void**)&mailbox.color, &mailbox.colorCapacity, pixels * 3))){
+    pthread_mutex_unlock(&senderMutex);
+    return;
+  }
+
+  // 아직 보내지 못한 프레임은 새 프레임으로 교체 (최신 프레임 우선)
+  if(mailboxFull){
+    senderStats.dropped++;
+  }
+  memcpy(mailbox.depth, depth, pixels * sizeof(int16_t));
+  if(color){
+    memcpy(mailbox.color, color, pixels * 3);
+  }
+  mailbox.width = width;
+  mailbox.height = height;
+  mailbox.hasColor = color != NULL;
+  mailbox.timestamp = timestamp;
+  mailboxFull = 1;
+  pthread_cond_signal(&senderCond);
+  pthread_mutex_unlock(&senderMutex);
+}
+
+void getFrameSenderStats(FrameSenderStats* stats){
+  pthread_mutex_lock(&senderMutex);
+  *stats = senderStats;
+  stats->ackMs = senderStats.acked ? ackSeconds * 1000.0 / senderStats.acked : 0.0;
+  stats->compressMs = senderStats.sent ? compressSeconds * 1000.0 / senderStats.sent : 0.0;
+  pthread_mutex_unlock(&senderMutex);
+}
+
+// ---------------------------------------------------------------------------
+// 수신 측
+
+static int listenFd = -1;
+static int connectionFd = -1;  // 현재 송신 측 연결 (receiverSendMutex 로 보호)
+static volatile int receiverRunning = 0;
+static pthread_t receiverThreadId;
+static pthread_mutex_t receiverSendMutex = PTHREAD_MUTEX_INITIALIZER;
+static TransportFrameCallback frameCallback = NULL;
+static void* frameCallbackUser = NULL;
+
+// 최근 받은 프레임 (타임스템프 -> frameId, receiverSendMutex 로 보호)
+static uint32_t recentTimestamps[RECENT_FRAME_SLOTS];
+static uint32_t recentFrameIds[RECENT_FRAME_SLOTS];
+static uint32_t recentCount = 0;
+
+// 연결 하나 처리 (송신 측이 끊을 때까지)
+static void serveSender(int fd){
+  void* depth = NULL;
+  void* color = NULL;
+  void* compressed = NULL;
+  size_t depthCapacity = 0, colorCapacity = 0, compressedCapacity = 0;
+  uint64_t frames = 0, bytes = 0;
+  double decodeSeconds = 0.0, callbackSeconds = 0.0;
+
+  TransportHeader header;
+  while(receiverRunning && recvAll(fd, &header, sizeof(header))){
+    if(header.magic != TRANSPORT_MAGIC){
+      fprintf(stderr, "Frame receiver: invalid message\n");
+      break;
+    }
+    if(header.type != TRANSPORT_MSG_FRAME){
+      if(!skipBytes(fd, header.payloadBytes)) break;
+      continue;
+    }
+
+    const size_t pixels = (size_t)header.width * header.height;
+    const size_t colorBytes = header.payloadBytes - header.depthBytes;
+    const int isCompressed = (header.flags & TRANSPORT_FLAG_DEPTH_COMPRESSED) != 0;
+    if(header.depthBytes > header.payloadBytes || (colorBytes != 0 && colorBytes != pixels * 3) ||
+       (!isCompressed && header.depthBytes != pixels * sizeof(int16_t))){
+      fprintf(stderr, "Frame receiver: invalid frame size\n");
+      break;
+    }
+    if(!ensureBuffer(&depth, &depthCapacity, pixels * sizeof(int16_t)) ||
+       !ensureBuffer(&color, &colorCapacity, pixels * 3) ||
+       (isCompressed && !ensureBuffer(&compressed, &compressedCapacity, header.depthBytes))){
+      break;
+    }
+
+    // 깊이 / 색상 평면을 각자의 버퍼로 바로 받음
+    if(!recvAll(fd, isCompressed ? compressed : depth, header.depthBytes) ||
+       (colorBytes && !recvAll(fd, color, colorBytes))){
+      break;
+    }
+    double start = nowSeconds();
+    if(isCompressed &&
+       !decompressDepthPlane((const uint8_t*)compressed, header.depthBytes, header.width, header.height,
+                             (uint16_t*)depth)){
+      fprintf(stderr, "Frame receiver: corrupt depth plane in frame %u\n", header.frameId);
+      break;
+    }
+    double decoded = nowSeconds();
+
+    pthread_mutex_lock(&receiverSendMutex);
+    recentTimestamps[recentCount % RECENT_FRAME_SLOTS] = header.timestamp;
+    recentFrameIds[recentCount % RECENT_FRAME_SLOTS] = header.frameId;
+    recentCount++;
+    pthread_mutex_unlock(&receiverSendMutex);
+
+    if(frameCallback){
+      frameCallback((const int16_t*)depth, colorBytes ? (const uint8_t*)color : NULL, header.width, header.height,
+                    header.frameId, header.timestamp, frameCallbackUser);
+    }
+    callbackSeconds += nowSeconds() - decoded;
+    decodeSeconds += decoded - start;
+    frames++;
+    bytes += sizeof(header) + header.payloadBytes;
+
+    // 처리가 끝났음을 알려 송신 측이 다음 프레임을 보내게 함
+    TransportHeader ack;
+    fillHeader(&ack, TRANSPORT_MSG_ACK, header.frameId, header.timestamp);
+    struct iovec iov = {&ack, sizeof(ack)};
+    pthread_mutex_lock(&receiverSendMutex);
+    int ok = sendAll(fd, &iov, 1);
+    pthread_mutex_unlock(&receiverSendMutex);
+    if(!ok){
+      break;
+    }
+  }
+
+  printf("Frame receiver: sender disconnected, %llu frames, %.1f KB/frame, decode %.2f ms, callback %.2f ms\n",
+         (unsigned long long)frames, frames ? bytes / 1024.0 / frames : 0.0,
+         frames ? decodeSeconds * 1000.0 / frames : 0.0, frames ? callbackSeconds * 1000.0 / frames : 0.0);
+  free(depth);
+  free(color);
+  free(compressed);
+}
+
+static void* receiverThread(void* arg){
+  (void)arg;
+  while(receiverRunning){
+    struct pollfd pfd = {listenFd, POLLIN, 0};
+    if(poll(&pfd, 1, 200) <= 0){
+      continue;
+    }
+
+    int fd = accept(listenFd, NULL, NULL);
+    if(fd < 0){
+      continue;
+    }
+    setNoDelay(fd);
+
+    pthread_mutex_lock(&receiverSendMutex);
+    connectionFd = fd;
+    recentCount = 0;
+    pthread_mutex_unlock(&receiverSendMutex);
+    printf("Frame receiver: sender connected\n");
+
+    serveSender(fd);
+
+    pthread_mutex_lock(&receiverSendMutex);
+    connectionFd = -1;
+    pthread_mutex_unlock(&receiverSendMutex);
+    close(fd);
+  }
+  return NULL;
+}
+
+int initFrameReceiver(int port, TransportFrameCallback callback, void* user_data){
+  if(receiverRunning){
+    return 1;
+  }
+
+  listenFd = socket(AF_INET, SOCK_STREAM, 0);
+  if(listenFd < 0){
+    perror("Frame receiver socket");
+    return 0;
+  }
+
+  int reuse = 1;
+  setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons((uint16_t)port);
+  if(bind(listenFd, (struct sockaddr*)&addr, sizeof(addr)) < 0 || listen(listenFd, 1) < 0){
+    perror("Frame receiver bind");
+    close(listenFd);
+    listenFd = -1;
+    return 0;
+  }
+
+  frameCallback = callback;
+  frameCallbackUser = user_data;
+  receiverRunning = 1;
+  pthread_create(&receiverThreadId, NULL, receiverThread, NULL);
+  printf("Frame receiver listening on port %d\n", port);
+  return 1;
+}
+
+void stopFrameReceiver(void){
+  if(!receiverRunning){
+    return;
+  }
+
+  receiverRunning = 0;
+  pthread_mutex_lock(&receiverSendMutex);
+  if(connectionFd >= 0){
+    shutdown(connectionFd, SHUT_RDWR);
+  }
+  pthread_mutex_unlock(&receiverSendMutex);
+
+  pthread_join(receiverThreadId, NULL);
+  close(listenFd);
+  listenFd = -1;
+  printf("Frame receiver stopped\n");
+}
+
+int isFrameReceiverRunning(void){
+  return receiverRunning;
+}
+
+int sendReceiverPose(double timestamp, int tracking_state, const float* Twc, float track_ms){
+  TransportPose pose;
+  pose.timestamp = timestamp;
+  pose.trackingState = tracking_state;
+  pose.trackMs = track_ms;
+  memcpy(pose.Twc, Twc, sizeof(pose.Twc));
+
+  const uint32_t timestampMs = (uint32_t)(timestamp * 1000.0 + 0.5);
+  TransportHeader header;
+  fillHeader(&header, TRANSPORT_MSG_POSE, 0, timestampMs);
+  header.payloadBytes = sizeof(pose);
+
+  pthread_mutex_lock(&receiverSendMutex);
+  if(connectionFd < 0){
+    pthread_mutex_unlock(&receiverSendMutex);
+    return 0;
+  }
+  const uint32_t slots = recentCount < RECENT_FRAME_SLOTS ? recentCount : RECENT_FRAME_SLOTS;
+  for(uint32_t k = 1; k <= slots; ++k){
+    const uint32_t slot = (recentCount - k) % RECENT_FRAME_SLOTS;
+    if(recentTimestamps[slot] == timestampMs){
+      header.frameId = recentFrameIds[slot];
+      break;
+    }
+  }
+  struct iovec iov[2] = {
+    {&header, sizeof(header)},
+    {&pose, sizeof(pose)},
+  };
+  int ok = sendAll(connectionFd, iov, 2);
+  pthread_mutex_unlock(&receiverSendMutex);
+  return ok;
+}
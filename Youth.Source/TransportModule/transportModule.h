@@ -0,0 +1,116 @@
+#ifndef TRANSPORT_MODULE_H
+#define TRANSPORT_MODULE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// RGB-D 프레임 원격 전송 (캡처 보드 -> 같은 LAN 의 SLAM 처리 머신)
+// 송신 측은 완성된 프레임을 최신 프레임 한 칸 (mailbox) 에 넣고, 송신 스레드가 헤더 + 깊이 + 색상 평면을
+// sendmsg 한 번으로 보냄. 수신 측이 처리한 프레임마다 ACK 를 돌려주고, 응답을 받지 않은 프레임이
+// maxInFlight 개이면 보내지 않고 기다리는 동안 새 프레임이 오면 오래된 프레임을 버림
+// 수신 측의 SLAM 자세는 같은 연결로 송신 측에 돌아옴
+//
+// 메세지 (little-endian): TransportHeader 뒤에 payloadBytes 바이트
+//   TRANSPORT_MSG_FRAME : 깊이 평면 (depthBytes, 원본 int16 또는 압축) + 색상 평면 (RGB)
+//   TRANSPORT_MSG_ACK   : 페이로드 없음, frameId 는 처리한 프레임
+//   TRANSPORT_MSG_POSE  : TransportPose, frameId 는 자세를 구한 프레임
+
+#define TRANSPORT_MAGIC 0x31465259u  // "YRF1"
+#define TRANSPORT_DEFAULT_PORT 8091
+
+#define TRANSPORT_MSG_FRAME 1
+#define TRANSPORT_MSG_ACK 2
+#define TRANSPORT_MSG_POSE 3
+
+#define TRANSPORT_FLAG_DEPTH_COMPRESSED 0x1  // 깊이 평면이 compressDepthPlane 형식
+
+typedef struct{
+  uint32_t magic;
+  uint16_t type;          // TRANSPORT_MSG_*
+  uint16_t flags;         // TRANSPORT_FLAG_*
+  uint32_t frameId;
+  uint32_t timestamp;     // 프레임 타임스템프 (ms)
+  uint16_t width;
+  uint16_t height;
+  uint32_t depthBytes;    // 프레임: 깊이 평면 바이트
+  uint32_t payloadBytes;  // 헤더 뒤에 오는 바이트 수
+} TransportHeader;
+
+typedef struct{
+  double timestamp;       // 프레임 타임스템프 (초, SlamPoseCallback 과 같은 의미)
+  int32_t trackingState;  // SLAM.h 추적 상태
+  float trackMs;
+  float Twc[16];          // 카메라 -> 월드 (column-major 4x4)
+} TransportPose;
+
+// 송신 측 자세 콜백 (수신 스레드에서 호출, SlamPoseCallback 과 같은 형태)
+typedef void (*TransportPoseCallback)(double timestamp, int tracking_state, const float* Twc, float track_ms,
+                                      void* user_data);
+
+// 수신 측 프레임 콜백 (수신 스레드에서 호출, depth / color 는 호출 중에만 유효)
+// 콜백이 끝나면 ACK 를 보내므로 콜백이 오래 걸리면 송신 측이 프레임을 건너뜀
+typedef void (*TransportFrameCallback)(const int16_t* depth, const uint8_t* color, int width, int height,
+                                       uint32_t frame_id, uint32_t timestamp, void* user_data);
+
+// 송신 옵션
+typedef struct{
+  int compressDepth;  // 1 이면 깊이 무손실 압축 (기본 1)
+  int maxInFlight;    // ACK 를 받지 않은 프레임 최대 수 (기본 2)
+} FrameSenderOptions;
+
+// 송신 통계
+typedef struct{
+  uint64_t submitted;     // submitSenderFrame 호출 수
+  uint64_t sent;
+  uint64_t dropped;       // 보내기 전에 새 프레임으로 교체된 프레임
+  uint64_t acked;
+  uint64_t poses;
+  uint64_t bytes;         // 보낸 바이트 (헤더 포함)
+  uint64_t rawBytes;      // 압축 전 바이트
+  double ackMs;           // 평균 왕복 시간 (보냄 -> ACK)
+  double compressMs;      // 평균 깊이 압축 시간
+} FrameSenderStats;
+
+void setDefaultFrameSenderOptions(FrameSenderOptions* options);
+
+// 수신 측에 연결하고 송신 / 수신 스레드 시작
+// 반환값: 성공 시 1, 실패 시 0
+int initFrameSender(const char* host, int port, const FrameSenderOptions* options);
+void stopFrameSender(void);
+int isFrameSenderRunning(void);
+
+// 자세 콜백 등록 (NULL 이면 해제)
+void setSenderPoseCallback(TransportPoseCallback callback, void* user_data);
+
+// 프레임 전달 (임의의 스레드, 복사 후 바로 반환)
+void submitSenderFrame(const int16_t* depth, const uint8_t* color, int width, int height, uint32_t timestamp);
+
+void getFrameSenderStats(FrameSenderStats* stats);
+
+// 수신 측: port 에서 송신 측 연결을 기다리고 (한 번에 하나) 받은 프레임을 콜백으로 전달
+// 반환값: 성공 시 1, 실패 시 0
+int initFrameReceiver(int port, TransportFrameCallback callback, void* user_data);
+void stopFrameReceiver(void);
+int isFrameReceiverRunning(void);
+
+// 연결된 송신 측으로 자세 전송 (임의의 스레드, SLAM 자세 콜백에서 호출)
+// frameId 는 최근 받은 프레임 중 타임스템프가 같은 프레임으로 채움
+// 반환값: 보냈으면 1, 연결이 없으면 0
+int sendReceiverPose(double timestamp, int tracking_state, const float* Twc, float track_ms);
+
+// 깊이 무손실 압축 (0 은 run 으로, 유효 깊이는 이웃 예측 잔차를 zigzag varint 로)
+size_t maxCompressedDepthBytes(int width, int height);
+size_t compressDepthPlane(const uint16_t* depth, int width, int height, uint8_t* out);
+
+// 반환값: 성공 시 1, 형식 오류 시 0
+int decompressDepthPlane(const uint8_t* data, size_t size, int width, int height, uint16_t* depth);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TRANSPORT_MODULE_H
@@ -0,0 +1,351 @@
+#include "viewerHud.h"
+#include "../AlgorithmModule/SLAM.h"
+#include <GL/glew.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#define HUD_GLYPH_HEIGHT 7
+#define HUD_CELL_WIDTH 6      // 글자 폭 5 + 간격 1
+#define HUD_CELL_HEIGHT 9     // 글자 높이 7 + 줄 간격 2
+#define HUD_FIRST_CHAR 32
+#define HUD_CHAR_COUNT 95     // 출력 가능한 ASCII (32 ~ 126)
+#define HUD_MAX_LINES 8
+#define HUD_MAX_COLUMNS 64
+
+// 5x7 비트맵 글꼴 (행마다 하위 5비트, 최상위 비트가 왼쪽 픽셀)
+static const uint8_t hudFont[HUD_CHAR_COUNT][HUD_GLYPH_HEIGHT] = {
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // ' '
+  {0x04, 0x04, 0x04, 0x04, 0x00, 0x00, 0x04}, // '!'
+  {0x0A, 0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00}, // '"'
+  {0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A}, // '#'
+  {0x04, 0x0F, 0x14, 0x0E, 0x05, 0x1E, 0x04}, // '$'
+  {0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03}, // '%'
+  {0x0C, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0D}, // '&'
+  {0x0C, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00}, // '\''
+  {0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02}, // '('
+  {0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08}, // ')'
+  {0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00}, // '*'
+  {0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00}, // '+'
+  {0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08}, // ','
+  {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00}, // '-'
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C}, // '.'
+  {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00}, // '/'
+  {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E}, // '0'
+  {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E}, // '1'
+  {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F}, // '2'
+  {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E}, // '3'
+  {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02}, // '4'
+  {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E}, // '5'
+  {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E}, // '6'
+  {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08}, // '7'
+  {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E}, // '8'
+  {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C}, // '9'
+  {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00}, // ':'
+  {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x04, 0x08}, // ';'
+  {0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02}, // '<'
+  {0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00}, // '='
+  {0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08}, // '>'
+  {0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04}, // '?'
+  {0x0E, 0x11, 0x01, 0x0D, 0x15, 0x15, 0x0E}, // '@'
+  {0x0E, 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11}, // 'A'
+  {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E}, // 'B'
+  {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E}, // 'C'
+  {0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C}, // 'D'
+  {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F}, // 'E'
+  {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10}, // 'F'
+  {0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F}, // 'G'
+  {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}, // 'H'
+  {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E}, // 'I'
+  {0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C}, // 'J'
+  {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11}, // 'K'
+  {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F}, // 'L'
+  {0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11}, // 'M'
+  {0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11}, // 'N'
+  {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}, // 'O'
+  {0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10}, // 'P'
+  {0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D}, // 'Q'
+  {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11}, // 'R'
+  {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E}, // 'S'
+  {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04}, // 'T'
+  {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}, // 'U'
+  {0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04}, // 'V'
+  {0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A}, // 'W'
+  {0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11}, // 'X'
+  {0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04}, // 'Y'
+  {0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F}, // 'Z'
+  {0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E}, // '['
+  {0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00}, // '\\'
+  {0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E}, // ']'
+  {0x04, 0x0A, 0x11, 0x00, 0x00, 0x00, 0x00}, // '^'
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F}, // '_'
+  {0x08, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00}, // '`'
+  {0x00, 0x00, 0x0E, 0x01, 0x0F, 0x11, 0x0F}, // 'a'
+  {0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x1E}, // 'b'
+  {0x00, 0x00, 0x0E, 0x10, 0x10, 0x11, 0x0E}, // 'c'
+  {0x01, 0x01, 0x0D, 0x13, 0x11, 0x11, 0x0F}, // 'd'
+  {0x00, 0x00, 0x0E, 0x11, 0x1F, 0x10, 0x0E}, // 'e'
+  {0x06, 0x09, 0x08, 0x1C, 0x08, 0x08, 0x08}, // 'f'
+  {0x00, 0x0F, 0x11, 0x11, 0x0F, 0x01, 0x0E}, // 'g'
+  {0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x11}, // 'h'
+  {0x04, 0x00, 0x0C, 0x04, 0x04, 0x04, 0x0E}, // 'i'
+  {0x02, 0x00, 0x06, 0x02, 0x02, 0x12, 0x0C}, // 'j'
+  {0x10, 0x10, 0x12, 0x14, 0x18, 0x14, 0x12}, // 'k'
+  {0x0C, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E}, // 'l'
+  {0x00, 0x00, 0x1A, 0x15, 0x15, 0x11, 0x11}, // 'm'
+  {0x00, 0x00, 0x16, 0x19, 0x11, 0x11, 0x11}, // 'n'
+  {0x00, 0x00, 0x0E, 0x11, 0x11, 0x11, 0x0E}, // 'o'
+  {0x00, 0x00, 0x1E, 0x11, 0x1E, 0x10, 0x10}, // 'p'
+  {0x00, 0x00, 0x0D, 0x13, 0x0F, 0x01, 0x01}, // 'q'
+  {0x00, 0x00, 0x16, 0x19, 0x10, 0x10, 0x10}, // 'r'
+  {0x00, 0x00, 0x0E, 0x10, 0x0E, 0x01, 0x1E}, // 's'
+  {0x08, 0x08, 0x1C, 0x08, 0x08, 0x09, 0x06}, // 't'
+  {0x00, 0x00, 0x11, 0x11, 0x11, 0x13, 0x0D}, // 'u'
+  {0x00, 0x00, 0x11, 0x11, 0x11, 0x0A, 0x04}, // 'v'
+  {0x00, 0x00, 0x11, 0x11, 0x15, 0x15, 0x0A}, // 'w'
+  {0x00, 0x00, 0x11, 0x0A, 0x04, 0x0A, 0x11}, // 'x'
+  {0x00, 0x00, 0x11, 0x11, 0x0F, 0x01, 0x0E}, // 'y'
+  {0x00, 0x00, 0x1F, 0x02, 0x04, 0x08, 0x1F}, // 'z'
+  {0x02, 0x04, 0x04, 0x08, 0x04, 0x04, 0x02}, // '{'
+  {0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04}, // '|'
+  {0x08, 0x04, 0x04, 0x02, 0x04, 0x04, 0x08}, // '}'
+  {0x00, 0x00, 0x08, 0x15, 0x02, 0x00, 0x00}, // '~'
+};
+
+// HUD 영상 (글꼴 픽셀 단위 RGBA, 통계가 바뀔 때만 CPU 에서 다시 그려 업로드)
+// 매 프레임에는 확대한 사각형 하나만 그리므로 글자 수와 무관하게 비용이 일정함
+#define HUD_IMAGE_WIDTH (HUD_MAX_COLUMNS * HUD_CELL_WIDTH + 3)
+#define HUD_IMAGE_HEIGHT (HUD_MAX_LINES * HUD_CELL_HEIGHT + 2)
+static uint8_t hudImage[HUD_IMAGE_HEIGHT][HUD_IMAGE_WIDTH][4];
+static GLuint hudTexture = 0;
+static int softwareRenderer = 0;  // llvmpipe 등은 채움 비용이 커서 확대하지 않음 (0.5 ms 이하 유지)
+static int hudLines = 0;
+static int hudColumns = 0;
+
+// 이전 갱신의 누적 드롭 수 (늘어났으면 경고 색)
+static uint64_t lastCaptureDropped = 0;
+static uint64_t lastLoggerDropped = 0;
+static uint64_t lastViewerDropped = 0;
+
+static const uint8_t hudNormal[4] = {220, 220, 220, 255};
+static const uint8_t hudWarning[4] = {255, 200, 60, 255};
+static const uint8_t hudError[4] = {255, 90, 90, 255};
+static const uint8_t hudBackground[4] = {0, 0, 0, 160};
+
+int createViewerHud(void){
+  glGenTextures(1, &hudTexture);
+  if(!hudTexture){
+    return 0;
+  }
+  glBindTexture(GL_TEXTURE_2D, hudTexture);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, HUD_IMAGE_WIDTH, HUD_IMAGE_HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  const char* renderer = (const char*)glGetString(GL_RENDERER);
+  softwareRenderer = renderer && (strstr(renderer, "llvmpipe") || strstr(renderer, "softpipe") ||
+                                  strstr(renderer, "SWR"));
+  hudLines = hudColumns = 0;
+  return 1;
+}
+
+void destroyViewerHud(void){
+  if(hudTexture){
+    glDeleteTextures(1, &hudTexture);
+    hudTexture = 0;
+  }
+  hudLines = hudColumns = 0;
+}
+
+// 한 줄을 HUD 영상에 그림 (왼쪽 위 여백 1 픽셀)
+static void addHudLine(const uint8_t color[4], const char* format, ...){
+  if(hudLines >= HUD_MAX_LINES){
+    return;
+  }
+
+  char line[HUD_MAX_COLUMNS + 1];
+  va_list args;
+  va_start(args, format);
+  vsnprintf(line, sizeof(line), format, args);
+  va_end(args);
+
+  int top = 1 + hudLines * HUD_CELL_HEIGHT;
+  int length = (int)strlen(line);
+  for(int i = 0; i < length; ++i){
+    int c = (unsigned char)line[i] - HUD_FIRST_CHAR;
+    if(c <= 0 || c >= HUD_CHAR_COUNT){
+      continue; // 공백 및 범위 밖 문자
+    }
+    int left = 1 + i * HUD_CELL_WIDTH;
+    for(int row = 0; row < HUD_GLYPH_HEIGHT; ++row){
+      uint8_t bits = hudFont[c][row];
+      for(int col = 0; col < 5; ++col){
+        if(bits & (0x10 >> col)){
+          memcpy(hudImage[top + row][left + col], color, 4);
+        }
+      }
+    }
+  }
+
+  if(length > hudColumns){
+    hudColumns = length;
+  }
+  hudLines++;
+}
+
+static const char* slamStateName(int state){
+  switch(state){
+    case SLAM_TRACKING_NOT_INITIALIZED: return "init";
+    case SLAM_TRACKING_OK: return "ok";
+    case SLAM_TRACKING_RECENTLY_LOST: return "recently lost";
+    case SLAM_TRACKING_LOST: return "lost";
+    case SLAM_TRACKING_ICP_FALLBACK: return "icp fallback";
+    default: return "no images";
+  }
+}
+
+// 큐가 거의 가득 차면 (생산자가 막히기 직전) 경고
+static const uint8_t* queueColor(int depth, int capacity){
+  if(depth < 0 || capacity <= 0){
+    return hudNormal;
+  }
+  if(depth >= capacity){
+    return hudError;
+  }
+  return depth * 2 >= capacity ? hudWarning : hudNormal;
+}
+
+static void formatCpu(char* out, size_t size, const char* name, float percent){
+  if(percent < 0.0f){
+    snprintf(out, size, "%s    -", name);
+  }else{
+    snprintf(out, size, "%s %4.0f", name, percent);
+  }
+}
+
+void updateViewerHud(const MonitorStats* stats){
+  if(!hudTexture){
+    return;
+  }
+  for(int y = 0; y < HUD_IMAGE_HEIGHT; ++y){
+    for(int x = 0; x < HUD_IMAGE_WIDTH; ++x){
+      memcpy(hudImage[y][x], hudBackground, 4);
+    }
+  }
+  hudLines = hudColumns = 0;
+
+  int captureDrop = stats->captureDropped > lastCaptureDropped;
+  int loggerDrop = stats->loggerDropped > lastLoggerDropped;
+  int viewerDrop = stats->viewerDropped > lastViewerDropped;
+  lastCaptureDropped = stats->captureDropped;
+  lastLoggerDropped = stats->loggerDropped;
+  lastViewerDropped = stats->viewerDropped;
+
+  addHudLine(captureDrop ? hudWarning : hudNormal, "capture %5.1f fps   drop %llu", stats->captureFps,
+             (unsigned long long)stats->captureDropped);
+  addHudLine(viewerDrop ? hudWarning : hudNormal, "viewer  %5.1f fps   draw %5.1f fps   drop %llu", stats->viewerFps,
+             stats->renderFps, (unsigned long long)stats->viewerDropped);
+
+  // 두 큐 중 더 찬 쪽 기준으로 색 결정
+  int fuller = stats->sensorQueueDepth > stats->viewerQueueDepth ? stats->sensorQueueDepth : stats->viewerQueueDepth;
+  const uint8_t* color = loggerDrop ? hudWarning : queueColor(fuller, stats->queueCapacity);
+  char sensorQueue[16], viewerQueue[16];
+  if(stats->sensorQueueDepth < 0){
+    snprintf(sensorQueue, sizeof(sensorQueue), "  -");
+  }else{
+    snprintf(sensorQueue, sizeof(sensorQueue), "%2d/%d", stats->sensorQueueDepth, stats->queueCapacity);
+  }
+  if(stats->viewerQueueDepth < 0){
+    snprintf(viewerQueue, sizeof(viewerQueue), "  -");
+  }else{
+    snprintf(viewerQueue, sizeof(viewerQueue), "%2d/%d", stats->viewerQueueDepth, stats->queueCapacity);
+  }
+  addHudLine(color, "queue   sensor>log %s   log>viewer %s   drop %llu", sensorQueue, viewerQueue,
+             (unsigned long long)stats->loggerDropped);
+
+  addHudLine(hudNormal, "MB/s    sensor>log %6.2f   log>viewer %6.2f   record %6.2f", stats->sensorMBps,
+             stats->viewerMBps, stats->recordMBps);
+
+  if(stats->slamState < 0){
+    addHudLine(hudNormal, "slam    off");
+  }else{
+    color = stats->slamState == SLAM_TRACKING_OK ? hudNormal
+          : stats->slamState == SLAM_TRACKING_LOST ? hudError : hudWarning;
+    addHudLine(color, "slam    %-13s %6.1f ms  %5.1f fps", slamStateName(stats->slamState), stats->slamTrackMs,
+               stats->slamFps);
+  }
+
+  char cpu[MONITOR_THREAD_COUNT][24];
+  formatCpu(cpu[MONITOR_THREAD_SENSOR], sizeof(cpu[0]), "sensor", stats->threadCpu[MONITOR_THREAD_SENSOR]);
+  formatCpu(cpu[MONITOR_THREAD_LOGGER], sizeof(cpu[0]), "logger", stats->threadCpu[MONITOR_THREAD_LOGGER]);
+  formatCpu(cpu[MONITOR_THREAD_PLAYBACK], sizeof(cpu[0]), "play", stats->threadCpu[MONITOR_THREAD_PLAYBACK]);
+  formatCpu(cpu[MONITOR_THREAD_VIEWER], sizeof(cpu[0]), "viewer", stats->threadCpu[MONITOR_THREAD_VIEWER]);
+  formatCpu(cpu[MONITOR_THREAD_VIEWER_RECEIVE], sizeof(cpu[0]), "recv",
+            stats->threadCpu[MONITOR_THREAD_VIEWER_RECEIVE]);
+  formatCpu(cpu[MONITOR_THREAD_SLAM], sizeof(cpu[0]), "slam", stats->threadCpu[MONITOR_THREAD_SLAM]);
+  addHudLine(hudNormal, "cpu %%   %s  %s  %s", cpu[MONITOR_THREAD_SENSOR], cpu[MONITOR_THREAD_LOGGER],
+             cpu[MONITOR_THREAD_PLAYBACK]);
+  addHudLine(hudNormal, "        %s  %s  %s", cpu[MONITOR_THREAD_VIEWER], cpu[MONITOR_THREAD_VIEWER_RECEIVE],
+             cpu[MONITOR_THREAD_SLAM]);
+
+  // 사용한 영역만 업로드 (4 Hz)
+  glBindTexture(GL_TEXTURE_2D, hudTexture);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, HUD_IMAGE_WIDTH);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, hudColumns * HUD_CELL_WIDTH + 1, hudLines * HUD_CELL_HEIGHT + 1, GL_RGBA,
+                  GL_UNSIGNED_BYTE, hudImage);
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+  glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void drawViewerHud(int width, int height){
+  if(!hudTexture || hudLines == 0 || width <= 0 || height <= 0){
+    return;
+  }
+  float scale = softwareRenderer ? 1.0f : (height >= 1000 ? 3.0f : 2.0f);
+  float imageWidth = (float)(hudColumns * HUD_CELL_WIDTH + 1);
+  float imageHeight = (float)(hudLines * HUD_CELL_HEIGHT + 1);
+  float u = imageWidth / HUD_IMAGE_WIDTH;
+  float v = imageHeight / HUD_IMAGE_HEIGHT;
+
+  glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_VIEWPORT_BIT | GL_TEXTURE_BIT | GL_CURRENT_BIT);
+  glViewport(0, 0, width, height);
+  glMatrixMode(GL_PROJECTION);
+  glPushMatrix();
+  glLoadIdentity();
+  glOrtho(0.0, width, height, 0.0, -1.0, 1.0); // 왼쪽 위 원점, 픽셀 단위
+  glMatrixMode(GL_MODELVIEW);
+  glPushMatrix();
+  glLoadIdentity();
+  glTranslatef(8.0f, 8.0f, 0.0f);
+  glScalef(scale, scale, 1.0f);
+
+  glDisable(GL_DEPTH_TEST);
+  glEnable(GL_BLEND);
+  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  glActiveTexture(GL_TEXTURE0);
+  glEnable(GL_TEXTURE_2D);
+  glBindTexture(GL_TEXTURE_2D, hudTexture);
+  glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+
+  glBegin(GL_QUADS);
+  glTexCoord2f(0.0f, 0.0f);
+  glVertex2f(0.0f, 0.0f);
+  glTexCoord2f(u, 0.0f);
+  glVertex2f(imageWidth, 0.0f);
+  glTexCoord2f(u, v);
+  glVertex2f(imageWidth, imageHeight);
+  glTexCoord2f(0.0f, v);
+  glVertex2f(0.0f, imageHeight);
+  glEnd();
+
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glMatrixMode(GL_PROJECTION);
+  glPopMatrix();
+  glMatrixMode(GL_MODELVIEW);
+  glPopMatrix();
+  glPopAttrib();
+}
@@ -0,0 +1,19 @@
+#ifndef VIEWER_HUD_H
+#define VIEWER_HUD_H
+
+#include "../MonitorModule/monitorModule.h"
+
+// 뷰어 성능 HUD (렌더링 스레드 전용, GL 컨텍스트가 current 인 상태에서 호출)
+// 5x7 비트맵 글꼴로 통계가 바뀔 때만 CPU 에서 작은 텍스처에 글자를 그리고, 매 프레임에는 사각형 하나만 그림
+
+// 반환값: 성공 시 1, 실패 시 0
+int createViewerHud(void);
+void destroyViewerHud(void);
+
+// 통계로 HUD 문자열을 만들어 텍스처 갱신
+void updateViewerHud(const MonitorStats* stats);
+
+// 화면 왼쪽 위에 HUD 그리기 (투영/뷰포트 상태는 복원됨)
+void drawViewerHud(int width, int height);
+
+#endif // VIEWER_HUD_H
@@ -0,0 +1,479 @@
+#include "viewerMap.h"
+#include <GL/glew.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAP_FRAME_SLOTS 4                      // 자세를 기다리는 프레임 (SLAM 지연 몇 프레임까지)
+#define MAP_POSE_SLOTS 16
+#define MAP_UPLOAD_CHUNKS_PER_FRAME 16         // 프레임당 업로드 제한 (렌더링 시간 유지)
+#define MAP_UPLOAD_BYTES_PER_FRAME (4 << 20)
+#define MAP_SOFTWARE_RENDER_BUDGET 300000      // llvmpipe 등은 초당 수백만 포인트 정도만 그림
+
+// 자세를 기다리는 수신 프레임 복사본
+typedef struct{
+  int16_t* depth;
+  uint8_t* color;
+  int width;
+  int height;
+  uint32_t timestamp;
+  uint32_t sequence;   // 덮어쓸 순서
+  int valid;
+  int busy;            // 지도 스레드가 누적 중
+} MapFrame;
+
+typedef struct{
+  uint32_t timestamp;
+  float Twc[16];
+} MapPose;
+
+static PointMapOptions mapOptions;
+static PointMap* pointMap = NULL;     // 지도 스레드 전용 (비우기는 mapMutex 아래에서)
+static MapOctree* mapOctree = NULL;   // 렌더링 스레드 전용
+static void (*mapNotify)(void) = NULL;
+
+// 아래 상태는 모두 mapMutex 로 보호
+static pthread_mutex_t mapMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t mapCond = PTHREAD_COND_INITIALIZER;
+static pthread_t mapThreadId;
+static int mapRunning = 0;
+static MapFrame mapFrames[MAP_FRAME_SLOTS];
+static uint32_t mapFrameSequence = 0;
+static MapPose mapPoses[MAP_POSE_SLOTS];   // 오래된 순서
+static int mapPoseCount = 0;
+static float latestPose[16];
+static int hasLatestPose = 0;
+static CameraIntrinsics mapIntrinsics = {570.3f, 570.3f, 320.0f, 240.0f, 1000.0f, 640, 480};
+static uint32_t mapIntrinsicsVersion = 1;
+static int clearRequested = 0;             // 지도 스레드가 지도를 비움
+static int octreeClearRequested = 0;       // 렌더링 스레드가 GPU 버퍼를 비움
+
+// 렌더링 스레드로 넘길 청크 (올리기 전에 같은 청크가 다시 바뀌면 교체)
+static PointMapChunkData* pendingChunks = NULL;
+static size_t pendingCount = 0;
+static size_t pendingCapacity = 0;
+
+void setViewerMapIntrinsics(const CameraIntrinsics* intrinsics){
+  pthread_mutex_lock(&mapMutex);
+  mapIntrinsics = *intrinsics;
+  mapIntrinsicsVersion++;
+  pthread_mutex_unlock(&mapMutex);
+}
+
+void pushViewerMapFrame(const int16_t* depth, const uint8_t* color, int width, int height, uint32_t timestamp){
+  pthread_mutex_lock(&mapMutex);
+  if(!mapRunning){
+    pthread_mutex_unlock(&mapMutex);
+    return;
+  }
+
+  // 빈 슬롯, 없으면 가장 오래된 슬롯 (누적 중인 슬롯 제외)
+  MapFrame* slot = NULL;
+  for(int i = 0; i < MAP_FRAME_SLOTS; ++i){
+    MapFrame* frame = &mapFrames[i];
+    if(frame->busy){
+      continue;
+    }
+    if(!frame->valid){
+      slot = frame;
+      break;
+    }
+    if(!slot || (int32_t)(frame->sequence - slot->sequence) < 0){
+      slot = frame;
+    }
+  }
+  if(!slot){
+    pthread_mutex_unlock(&mapMutex);
+    return;
+  }
+
+  size_t pixels = (size_t)width * height;
+  if(slot->width != width || slot->height != height){
+    free(slot->depth);
+    free(slot->color);
+    slot->depth = (int16_t*)malloc(pixels * sizeof(int16_t));
+    slot->color = (uint8_t*)malloc(pixels * 3);
+    if(!slot->depth || !slot->color){
+      free(slot->depth);
+      free(slot->color);
+      memset(slot, 0, sizeof(*slot));
+      pthread_mutex_unlock(&mapMutex);
+      return;
+    }
+    slot->width = width;
+    slot->height = height;
+  }
+  memcpy(slot->depth, depth, pixels * sizeof(int16_t));
+  memcpy(slot->color, color, pixels * 3);
+  slot->timestamp = timestamp;
+  slot->sequence = ++mapFrameSequence;
+  slot->valid = 1;
+
+  // 자세가 먼저 도착했을 수 있음
+  if(mapPoseCount > 0){
+    pthread_cond_signal(&mapCond);
+  }
+  pthread_mutex_unlock(&mapMutex);
+}
+
+void pushViewerMapPose(uint32_t timestamp, const float* Twc){
+  pthread_mutex_lock(&mapMutex);
+  memcpy(latestPose, Twc, sizeof(latestPose));
+  hasLatestPose = 1;
+
+  if(mapRunning){
+    if(mapPoseCount == MAP_POSE_SLOTS){
+      memmove(&mapPoses[0], &mapPoses[1], (MAP_POSE_SLOTS - 1) * sizeof(MapPose));
+      mapPoseCount--;
+    }
+    mapPoses[mapPoseCount].timestamp = timestamp;
+    memcpy(mapPoses[mapPoseCount].Twc, Twc, sizeof(mapPoses[mapPoseCount].Twc));
+    mapPoseCount++;
+    pthread_cond_signal(&mapCond);
+  }
+  pthread_mutex_unlock(&mapMutex);
+}
+
+void clearViewerMap(void){
+  pthread_mutex_lock(&mapMutex);
+  clearRequested = 1;
+  pthread_cond_signal(&mapCond);
+  pthread_mutex_unlock(&mapMutex);
+}
+
+int getViewerMapPose(float* Twc){
+  pthread_mutex_lock(&mapMutex);
+  int valid = hasLatestPose;
+  if(valid){
+    memcpy(Twc, latestPose, sizeof(latestPose));
+  }
+  pthread_mutex_unlock(&mapMutex);
+  return valid;
+}
+
+static void removeMapPoses(int count){
+  memmove(&mapPoses[0], &mapPoses[count], (mapPoseCount - count) * sizeof(MapPose));
+  mapPoseCount -= count;
+}
+
+// 가장 오래된 자세와 타임스템프가 같은 프레임 찾기 (mapMutex 보유)
+// 프레임이 이미 덮어써진 자세는 버리고, 아직 오지 않은 프레임의 자세는 남겨 둠
+static MapFrame* findPosedFrame(MapPose* pose){
+  while(mapPoseCount > 0){
+    const MapPose* oldest = &mapPoses[0];
+    int newerFrame = 0;
+    for(int i = 0; i < MAP_FRAME_SLOTS; ++i){
+      MapFrame* frame = &mapFrames[i];
+      if(!frame->valid || frame->busy){
+        continue;
+      }
+      if(frame->timestamp == oldest->timestamp){
+        *pose = *oldest;
+        removeMapPoses(1);
+
+        // 이보다 오래된 프레임은 자세를 받을 수 없음
+        for(int j = 0; j < MAP_FRAME_SLOTS; ++j){
+          if(mapFrames[j].valid && !mapFrames[j].busy && (int32_t)(mapFrames[j].timestamp - pose->timestamp) < 0){
+            mapFrames[j].valid = 0;
+          }
+        }
+        return frame;
+      }
+      if((int32_t)(frame->timestamp - oldest->timestamp) > 0){
+        newerFrame = 1;
+      }
+    }
+    if(!newerFrame){
+      return NULL; // 프레임이 아직 도착하지 않음
+    }
+    removeMapPoses(1);
+  }
+  return NULL;
+}
+
+// 바뀐 청크를 업로드 대기열에 넣음 (mapMutex 보유)
+static void queuePendingChunks(PointMapChunkData* updates, size_t count){
+  for(size_t i = 0; i < count; ++i){
+    size_t j = 0;
+    while(j < pendingCount && memcmp(pendingChunks[j].key, updates[i].key, sizeof(updates[i].key)) != 0){
+      j++;
+    }
+    if(j < pendingCount){
+      freePointMapChunkData(&pendingChunks[j]);
+      pendingChunks[j] = updates[i];
+      continue;
+    }
+    if(pendingCount == pendingCapacity){
+      size_t capacity = pendingCapacity ? pendingCapacity * 2 : 64;
+      PointMapChunkData* chunks = (PointMapChunkData*)realloc(pendingChunks, capacity * sizeof(PointMapChunkData));
+      if(!chunks){
+        freePointMapChunkData(&updates[i]);
+        continue;
+      }
+      pendingChunks = chunks;
+      pendingCapacity = capacity;
+    }
+    pendingChunks[pendingCount++] = updates[i];
+  }
+}
+
+static void clearPendingChunks(void){
+  for(size_t i = 0; i < pendingCount; ++i){
+    freePointMapChunkData(&pendingChunks[i]);
+  }
+  pendingCount = 0;
+}
+
+// 지도 스레드: 자세가 붙은 프레임을 누적하고 바뀐 청크를 정점 배열로 만듦
+static void* viewerMapThread(void* arg){
+  (void)arg;
+  RayTable rays = {0};
+  uint32_t raysVersion = 0;
+  size_t integrated = 0;
+
+  pthread_mutex_lock(&mapMutex);
+  while(mapRunning){
+    if(clearRequested){
+      clearRequested = 0;
+      resetPointMap(pointMap);
+      clearPendingChunks();
+      octreeClearRequested = 1;
+      pthread_mutex_unlock(&mapMutex);
+      if(mapNotify) mapNotify();
+      pthread_mutex_lock(&mapMutex);
+      continue;
+    }
+
+    MapPose pose;
+    MapFrame* frame = findPosedFrame(&pose);
+    if(!frame){
+      pthread_cond_wait(&mapCond, &mapMutex);
+      continue;
+    }
+    frame->busy = 1;
+    CameraIntrinsics intrinsics = mapIntrinsics;
+    uint32_t version = mapIntrinsicsVersion;
+    pthread_mutex_unlock(&mapMutex);
+
+    if(!rays.rayX || rays.width != frame->width || rays.height != frame->height || raysVersion != version){
+      destroyRayTable(&rays);
+      if(createRayTable(&rays, &intrinsics, frame->width, frame->height)){
+        raysVersion = version;
+      }
+    }
+
+    PointMapChunkData* updates = NULL;
+    size_t count = 0;
+    if(rays.rayX){
+      integratePointMap(pointMap, &rays, (const uint16_t*)frame->depth, frame->color, pose.Twc);
+      count = takePointMapUpdates(pointMap, &updates);
+      if(++integrated % 300 == 0){
+        printf("Viewer map: %zu points in %zu chunks (%zu frames)\n", getPointMapSize(pointMap),
+               getPointMapChunkCount(pointMap), integrated);
+      }
+    }
+
+    pthread_mutex_lock(&mapMutex);
+    frame->busy = 0;
+    frame->valid = 0;
+    if(clearRequested){
+      for(size_t i = 0; i < count; ++i){
+        freePointMapChunkData(&updates[i]);
+      }
+    }else{
+      queuePendingChunks(updates, count);
+    }
+    free(updates);
+
+    if(count > 0 && mapNotify){
+      pthread_mutex_unlock(&mapMutex);
+      mapNotify();
+      pthread_mutex_lock(&mapMutex);
+    }
+  }
+  pthread_mutex_unlock(&mapMutex);
+
+  destroyRayTable(&rays);
+  return NULL;
+}
+
+int createViewerMap(const PointMapOptions* options, void (*notify)(void)){
+  mapOptions = *options;
+
+  // 소프트웨어 렌더러는 포인트 처리량이 낮으므로 렌더링 예산을 줄임
+  const char* renderer = (const char*)glGetString(GL_RENDERER);
+  if(renderer && (strstr(renderer, "llvmpipe") || strstr(renderer, "softpipe") || strstr(renderer, "SWR")) &&
+     (mapOptions.renderBudget == 0 || mapOptions.renderBudget > MAP_SOFTWARE_RENDER_BUDGET)){
+    mapOptions.renderBudget = MAP_SOFTWARE_RENDER_BUDGET;
+  }
+
+  pointMap = createPointMap(&mapOptions);
+  mapOctree = createMapOctree(mapOptions.chunkSize);
+  if(!pointMap || !mapOctree){
+    destroyPointMap(pointMap);
+    destroyMapOctree(mapOctree);
+    pointMap = NULL;
+    mapOctree = NULL;
+    return 0;
+  }
+  mapNotify = notify;
+
+  pthread_mutex_lock(&mapMutex);
+  mapRunning = 1;
+  mapPoseCount = 0;
+  clearRequested = octreeClearRequested = 0;
+  pthread_mutex_unlock(&mapMutex);
+
+  if(pthread_create(&mapThreadId, NULL, viewerMapThread, NULL) != 0){
+    fprintf(stderr, "Failed to create viewer map thread\n");
+    pthread_mutex_lock(&mapMutex);
+    mapRunning = 0;
+    pthread_mutex_unlock(&mapMutex);
+    destroyPointMap(pointMap);
+    destroyMapOctree(mapOctree);
+    pointMap = NULL;
+    mapOctree = NULL;
+    return 0;
+  }
+  return 1;
+}
+
+static void deleteLeafBuffer(MapOctreeLeaf* leaf, void* user_data){
+  (void)user_data;
+  if(leaf->buffer){
+    GLuint buffer = leaf->buffer;
+    glDeleteBuffers(1, &buffer);
+    leaf->buffer = 0;
+  }
+  leaf->count = 0;
+}
+
+void destroyViewerMap(void){
+  if(!mapOctree){
+    return;
+  }
+
+  pthread_mutex_lock(&mapMutex);
+  mapRunning = 0;
+  pthread_cond_broadcast(&mapCond);
+  pthread_mutex_unlock(&mapMutex);
+  pthread_join(mapThreadId, NULL);
+
+  pthread_mutex_lock(&mapMutex);
+  clearPendingChunks();
+  free(pendingChunks);
+  pendingChunks = NULL;
+  pendingCapacity = 0;
+  for(int i = 0; i < MAP_FRAME_SLOTS; ++i){
+    free(mapFrames[i].depth);
+    free(mapFrames[i].color);
+  }
+  memset(mapFrames, 0, sizeof(mapFrames));
+  mapPoseCount = 0;
+  hasLatestPose = 0;
+  pthread_mutex_unlock(&mapMutex);
+
+  forEachMapOctreeLeaf(mapOctree, deleteLeafBuffer, NULL);
+  destroyMapOctree(mapOctree);
+  destroyPointMap(pointMap);
+  mapOctree = NULL;
+  pointMap = NULL;
+  mapNotify = NULL;
+}
+
+int uploadViewerMap(void){
+  if(!mapOctree){
+    return 0;
+  }
+
+  PointMapChunkData batch[MAP_UPLOAD_CHUNKS_PER_FRAME];
+  size_t count = 0, bytes = 0;
+
+  pthread_mutex_lock(&mapMutex);
+  int clear = octreeClearRequested;
+  octreeClearRequested = 0;
+  while(count < MAP_UPLOAD_CHUNKS_PER_FRAME && count < pendingCount && bytes < MAP_UPLOAD_BYTES_PER_FRAME){
+    batch[count] = pendingChunks[count];
+    bytes += batch[count].count * sizeof(PointMapVertex);
+    count++;
+  }
+  memmove(pendingChunks, pendingChunks + count, (pendingCount - count) * sizeof(PointMapChunkData));
+  pendingCount -= count;
+  int remaining = pendingCount > 0;
+  pthread_mutex_unlock(&mapMutex);
+
+  if(clear){
+    forEachMapOctreeLeaf(mapOctree, deleteLeafBuffer, NULL);
+    resetMapOctree(mapOctree);
+  }
+
+  for(size_t i = 0; i < count; ++i){
+    PointMapChunkData* chunk = &batch[i];
+    MapOctreeLeaf* leaf = findMapOctreeLeaf(mapOctree, chunk->key, chunk->count > 0);
+    if(leaf && chunk->count == 0){
+      deleteLeafBuffer(leaf, NULL); // 예산 때문에 비워진 청크
+    }else if(leaf){
+      if(!leaf->buffer){
+        GLuint buffer;
+        glGenBuffers(1, &buffer);
+        leaf->buffer = buffer;
+      }
+      glBindBuffer(GL_ARRAY_BUFFER, leaf->buffer);
+      glBufferData(GL_ARRAY_BUFFER, chunk->count * sizeof(PointMapVertex), chunk->vertices, GL_STATIC_DRAW);
+      leaf->count = chunk->count;
+    }
+    freePointMapChunkData(chunk);
+  }
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  return remaining;
+}
+
+size_t drawViewerMap(void){
+  if(!mapOctree){
+    return 0;
+  }
+
+  float modelview[16], projection[16], viewProj[16];
+  glGetFloatv(GL_MODELVIEW_MATRIX, modelview);
+  glGetFloatv(GL_PROJECTION_MATRIX, projection);
+  for(int col = 0; col < 4; ++col){
+    for(int row = 0; row < 4; ++row){
+      float sum = 0.0f;
+      for(int k = 0; k < 4; ++k){
+        sum += projection[k * 4 + row] * modelview[col * 4 + k];
+      }
+      viewProj[col * 4 + row] = sum;
+    }
+  }
+
+  // 모델뷰는 회전 * 균일 스케일 + 이동이므로 역행렬은 전치 / 스케일 제곱
+  float scale2 = modelview[0] * modelview[0] + modelview[1] * modelview[1] + modelview[2] * modelview[2];
+  float eye[3];
+  for(int i = 0; i < 3; ++i){
+    eye[i] = -(modelview[i * 4] * modelview[12] + modelview[i * 4 + 1] * modelview[13] +
+               modelview[i * 4 + 2] * modelview[14]) / (scale2 > 0.0f ? scale2 : 1.0f);
+  }
+
+  size_t itemCount = 0, points = 0;
+  const MapDrawItem* items = cullMapOctree(mapOctree, viewProj, eye, mapOptions.lodDistance, mapOptions.renderBudget,
+                                           &itemCount, &points);
+  if(itemCount == 0){
+    return 0;
+  }
+
+  // 청크 정점은 LOD 순서이므로 앞쪽 count 개만 그림
+  glEnableClientState(GL_VERTEX_ARRAY);
+  glEnableClientState(GL_COLOR_ARRAY);
+  for(size_t i = 0; i < itemCount; ++i){
+    glBindBuffer(GL_ARRAY_BUFFER, items[i].leaf->buffer);
+    glVertexPointer(3, GL_FLOAT, sizeof(PointMapVertex), (const void*)0);
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(PointMapVertex), (const void*)offsetof(PointMapVertex, r));
+    glDrawArrays(GL_POINTS, 0, (GLsizei)items[i].count);
+  }
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glDisableClientState(GL_COLOR_ARRAY);
+  glDisableClientState(GL_VERTEX_ARRAY);
+  return points;
+}
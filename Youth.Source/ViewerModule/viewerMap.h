@@ -0,0 +1,41 @@
+#ifndef VIEWER_MAP_H
+#define VIEWER_MAP_H
+
+#include <stdint.h>
+#include "../KernelModule/kernelModule.h"
+#include "../MapModule/mapModule.h"
+
+// 뷰어 누적 지도
+// 수신 스레드가 프레임을 복사해 두면 자세가 도착했을 때 지도 스레드가 같은 타임스템프의 프레임을 월드 좌표로 누적하고,
+// 바뀐 청크만 렌더링 스레드가 GPU 버퍼로 올려 옥트리 컬링 + 거리 LOD 로 그림
+
+// 지도 스레드 시작 / 종료 (렌더링 스레드, GL 컨텍스트가 current 인 상태에서 호출)
+// notify: 새 청크가 준비되면 지도 스레드에서 호출 (다시 그리기 요청)
+// 반환값: 성공 시 1, 실패 시 0
+int createViewerMap(const PointMapOptions* options, void (*notify)(void));
+void destroyViewerMap(void);
+
+// 내부 파라미터 변경 (임의의 스레드)
+void setViewerMapIntrinsics(const CameraIntrinsics* intrinsics);
+
+// 수신 프레임 보관 (수신 스레드, 자세가 올 때까지 최근 몇 프레임만 유지)
+void pushViewerMapFrame(const int16_t* depth, const uint8_t* color, int width, int height, uint32_t timestamp);
+
+// 카메라 자세 전달 (임의의 스레드), timestamp 는 프레임 헤더 타임스템프 (ms)
+void pushViewerMapPose(uint32_t timestamp, const float* Twc);
+
+// 지도 비우기 (임의의 스레드)
+void clearViewerMap(void);
+
+// 마지막 자세 (렌더링 스레드), 자세가 없으면 0
+int getViewerMapPose(float* Twc);
+
+// 준비된 청크를 GPU 버퍼로 업로드 (렌더링 스레드, 프레임당 업로드 양 제한)
+// 반환값: 아직 올리지 못한 청크가 남아 있으면 1
+int uploadViewerMap(void);
+
+// 현재 모델뷰 (월드 좌표) / 투영 행렬로 컬링 후 그리기 (렌더링 스레드)
+// 반환값: 그린 포인트 수
+size_t drawViewerMap(void);
+
+#endif // VIEWER_MAP_H
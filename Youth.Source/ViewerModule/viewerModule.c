@@ -1,8 +1,13 @@
 #include "viewerModule.h"
+#include "viewerHud.h"
+#include "viewerMap.h"
 #include "../frameDefinitions.h"
+#include "../KernelModule/kernelModule.h"
+#include "../MonitorModule/monitorModule.h"
 #include <pthread.h>
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
+#include <stdatomic.h>
 #include <stdlib.h>
 #include <string.h>
 #include <mqueue.h>
@@ -10,6 +15,7 @@
 #include <sys/stat.h>
 #include <errno.h>
 #include <stdio.h>
+#include <time.h>
 #include <unistd.h>
 
 // Monitor Resolution Information
@@ -22,6 +28,51 @@
 // Viewer Status Variables
 GLuint depthTexture;
 GLuint colorTexture;
+GLuint pointCloudProgram = 0;
+int textureWidth = 0;
+int textureHeight = 0;
+
+GLuint rayTexture;
+GLuint depthLutTexture;     // 깊이 컬러맵 (256x1 RGB)
+GLuint paneProgram = 0;     // RGB / 깊이 영상 화면 셰이더
+
+// 프레임 업로드용 PBO (깊이 + 색상을 한 버퍼에 담아 번갈아 사용)
+// 매핑한 버퍼에 복사한 뒤 glTexSubImage2D 는 PBO 에서 읽으므로 전송이 렌더링과 겹침
+#define UPLOAD_PBO_COUNT 2
+static GLuint uploadPbo[UPLOAD_PBO_COUNT];
+static size_t uploadPboSize[UPLOAD_PBO_COUNT];
+static int uploadPboIndex = 0;
+
+// 화면 분할: 왼쪽 3D, 오른쪽 위 RGB / 아래 깊이 (P 키로 전환)
+typedef struct{
+  int x, y, width, height;
+} ViewerPane;
+static atomic_int panesEnabled = 1;
+#define PANE_DEPTH_MIN_M 0.3f     // 컬러맵 범위 (미터)
+#define PANE_DEPTH_MAX_M 5.0f
+
+// 성능 HUD (H 키로 전환), 통계는 HUD_SAMPLE_SEC 마다 공유 카운터에서 읽음
+#define HUD_SAMPLE_SEC 0.25
+static atomic_int hudEnabled = 0;
+static int hudReady = 0;                 // 렌더링 스레드 전용
+static MonitorSampler hudSampler;
+static double nextHudSample = 0.0;
+
+// 누적 지도 (M 키로 전환, C 키로 비우기), 자세는 submitViewerPose 로 받음
+#define MAP_FAR_PLANE 500.0       // 건물 단위 지도를 위해 먼 평면을 늘림
+static atomic_int mapEnabled = 0;
+static int mapReady = 0;                 // 렌더링 스레드 전용
+static PointMapOptions viewerMapOptions;
+static int viewerMapOptionsSet = 0;
+
+// 카메라 내부 파라미터 (Astra 기본값, loadViewerIntrinsics 로 설정 파일 값 사용)
+static CameraIntrinsics cameraIntrinsics = {570.3f, 570.3f, 320.0f, 240.0f, 1000.0f, 640, 480};
+static uint32_t intrinsicsVersion = 1;  // 내부 파라미터가 바뀔 때마다 증가
+
+// 렌더링 스레드 전용 광선 테이블 (프레임 해상도에 맞춰 재생성)
+static RayTable viewerRays;
+static uint32_t viewerRaysVersion = 0;
+static PointBuffer viewerPoints;        // 즉시 모드 렌더링용 역투영 결과
 
 float angleX = 0.0f;
 float angleY = 0.0f;
@@ -39,17 +90,60 @@ GLFWwindow* window;
 // 종료 콜백 함수 포인터
 static ExitCallbackFunc exitCallback = NULL;
 
-// Data Buffer
-int16_t* depthDataBuffer = NULL;
-uint8_t* colorDataBuffer = NULL;
-int currentWidth = 0;
-int currentHeight = 0;
-int hasNewData = 0;
-// int currentFrameId = 0;
+// 프레임 버퍼 (풀에서 할당, 수신 -> 삼중 버퍼 -> 풀 순으로 포인터만 이동)
+typedef struct{
+  int16_t* depth;
+  uint8_t* color;
+  int width;
+  int height;
+  int frameId;
+  uint32_t timestamp;
+} ViewerFrame;
+
+// 수신 스레드 -> 렌더링 스레드 락 없는 삼중 버퍼
+// 수신 스레드는 backSlot 을 채운 뒤 middleSlot 과 교환해 게시하고,
+// 렌더링 스레드는 새 프레임이 있을 때만 frontSlot 과 middleSlot 을 교환함 (양쪽 모두 대기 없음)
+#define FRAME_SLOT_MASK 0x3
+#define FRAME_SLOT_NEW 0x4
+
+static ViewerFrame* frameSlots[3];    // 슬롯이 가리키는 프레임 (NULL 이면 비어 있음)
+static int backSlot = 0;              // 수신 스레드 전용
+static int frontSlot = 1;             // 렌더링 스레드 전용
+static atomic_int middleSlot = 2;     // 최신 완성 프레임 인덱스 | FRAME_SLOT_NEW
+
+// 해상도별 프레임 버퍼 풀 (수신 스레드 전용이므로 락 불필요)
+#define FRAME_POOL_SIZE 4
+static ViewerFrame* framePool[FRAME_POOL_SIZE];
+static int framePoolCount = 0;
+
+// 필요할 때만 다시 그리기 (새 프레임, 입력 이벤트, 창 크기 변경)
+// 다른 스레드는 requestRedraw() 로 플래그를 세우고 glfwPostEmptyEvent 로 대기 중인 렌더링 루프를 깨움
+#define VIEWER_IDLE_WAIT_SEC 0.5   // 이벤트가 없을 때 최대 대기 시간 (종료 플래그 확인 주기)
+static atomic_int redrawRequested = 1;
+static atomic_int viewerEventsReady = 0; // glfwInit ~ glfwTerminate 구간에서만 1 (glfwPostEmptyEvent 호출 가능)
+static atomic_int viewerMaxFps = 0;      // 0 이면 제한 없음
+static int immediateMode = -1;           // 1 즉시 모드, 0 셰이더, -1 이면 렌더러에 따라 결정
+
+// 오프스크린 렌더링 (디스플레이 없이 EGL 컨텍스트의 FBO 에 그리고 PBO 로 비동기 읽기)
+// 오프스크린 모드에서는 GLFW 이벤트 대신 redrawCond 로 렌더링 루프를 깨움
+static char viewerPipeline[MAX_PIPELINE_NAME] = ""; // 수신할 파이프라인 (빈 문자열이면 기본 큐)
+static int viewerCamera = 0; // 표시할 카메라 번호
+static int offscreenWidth = 0;           // 0 이면 창 모드
+static int offscreenHeight = 0;
+static OffscreenContext offscreenContext;
+static OffscreenTarget offscreenTarget;  // 렌더링 스레드 전용
+static int readbackEnabled = 0;          // 읽기 링 생성 여부 (렌더링 스레드 전용)
+static OffscreenImageCallback imageCallback = NULL;
+static void* imageCallbackData = NULL;
+static ViewerFrameCallback frameCallback = NULL;
+static void* frameCallbackData = NULL;
+static uint32_t renderedFrames = 0;
+static pthread_mutex_t redrawMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t redrawCond = PTHREAD_COND_INITIALIZER;
 
 // Thread Control Variable
 int viewerIsRunning = 1;
-pthread_mutex_t dataMutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_mutex_t intrinsicsMutex = PTHREAD_MUTEX_INITIALIZER; // 카메라 내부 파라미터 보호
 
 // 청크 수신 상태 구조체
 typedef struct{
@@ -61,13 +155,164 @@ typedef struct{
   int totalDepthChunks;
   int receivedColorChunks;
   int totalColorChunks;
-  char* depthDataBuffer;
-  char* colorDataBuffer;
+  ViewerFrame* frame;   // 청크를 직접 복사하는 풀 버퍼
   int isComplete;
 } FrameReceiveStatus;
 
 FrameReceiveStatus receiveStatus = {0}; // 정적 초기화 추가
 
+// 포인트 클라우드 버텍스 셰이더
+// gl_VertexID 로 픽셀 위치를 구하고 깊이 텍스처(GL_R16UI)에서 직접 역투영 (버텍스 버퍼 없음)
+static const char* pointCloudVertexShader =
+  "#version 130\n"
+  "uniform usampler2D depthTex;\n"
+  "uniform sampler2D colorTex;\n"
+  "uniform sampler2D rayTex;\n" // 픽셀별 광선 (KernelModule 광선 테이블)
+  "uniform float depthScale;\n"
+  "uniform int imageWidth;\n"
+  "out vec3 pointColor;\n"
+  "void main(){\n"
+  "  ivec2 pixel = ivec2(gl_VertexID % imageWidth, gl_VertexID / imageWidth);\n"
+  "  uint depth = texelFetch(depthTex, pixel, 0).r;\n"
+  "  pointColor = texelFetch(colorTex, pixel, 0).rgb;\n"
+  "  if(depth == 0u){\n"
+  "    gl_Position = vec4(2.0, 2.0, 2.0, 1.0);\n" // 클리핑 영역 밖으로 보내 버림
+  "    return;\n"
+  "  }\n"
+  "  float z = float(depth) * depthScale;\n"
+  "  vec2 ray = texelFetch(rayTex, pixel, 0).rg;\n"
+  "  float x = ray.x * z;\n"
+  "  float y = ray.y * z;\n"
+  "  gl_Position = gl_ModelViewProjectionMatrix * vec4(-x, -y, -z, 1.0);\n"
+  "}\n";
+
+static const char* pointCloudFragmentShader =
+  "#version 130\n"
+  "in vec3 pointColor;\n"
+  "void main(){\n"
+  "  gl_FragColor = vec4(pointColor, 1.0);\n"
+  "}\n";
+
+// RGB / 깊이 영상 화면 (텍스처 사각형, 버텍스 버퍼 없음)
+// 깊이는 미터로 변환해 컬러맵 텍스처에서 색을 찾음 (깊이 0 은 검정)
+static const char* paneVertexShader =
+  "#version 130\n"
+  "out vec2 texCoord;\n"
+  "void main(){\n"
+  "  vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);\n"
+  "  texCoord = vec2(corner.x, 1.0 - corner.y);\n" // 영상 0 행이 위쪽
+  "  gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);\n"
+  "}\n";
+
+static const char* paneFragmentShader =
+  "#version 130\n"
+  "uniform usampler2D depthTex;\n"
+  "uniform sampler2D colorTex;\n"
+  "uniform sampler2D lutTex;\n"
+  "uniform int paneMode;\n"     // 0: RGB, 1: 깊이
+  "uniform float depthScale;\n"
+  "uniform vec2 depthRange;\n"  // 미터
+  "in vec2 texCoord;\n"
+  "void main(){\n"
+  "  if(paneMode == 0){\n"
+  "    gl_FragColor = vec4(texture(colorTex, texCoord).rgb, 1.0);\n"
+  "    return;\n"
+  "  }\n"
+  "  ivec2 size = textureSize(depthTex, 0);\n"
+  "  ivec2 pixel = min(ivec2(texCoord * vec2(size)), size - 1);\n"
+  "  uint depth = texelFetch(depthTex, pixel, 0).r;\n"
+  "  if(depth == 0u){\n"
+  "    gl_FragColor = vec4(0.0, 0.0, 0.0, 1.0);\n"
+  "    return;\n"
+  "  }\n"
+  "  float t = clamp((float(depth) * depthScale - depthRange.x) / (depthRange.y - depthRange.x), 0.0, 1.0);\n"
+  "  gl_FragColor = vec4(texture(lutTex, vec2(t, 0.5)).rgb, 1.0);\n"
+  "}\n";
+
+// 셰이더 컴파일 헬퍼
+static GLuint compileShader(GLenum type, const char* source){
+  GLuint shader = glCreateShader(type);
+  glShaderSource(shader, 1, &source, NULL);
+  glCompileShader(shader);
+
+  GLint status = GL_FALSE;
+  glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+  if(status != GL_TRUE){
+    char log[1024];
+    glGetShaderInfoLog(shader, sizeof(log), NULL, log);
+    fprintf(stderr, "Shader compile error: %s\n", log);
+    glDeleteShader(shader);
+    return 0;
+  }
+  return shader;
+}
+
+// 셰이더 프로그램 링크 헬퍼 (실패 시 0)
+static GLuint createProgram(const char* vertexSource, const char* fragmentSource){
+  GLuint vs = compileShader(GL_VERTEX_SHADER, vertexSource);
+  GLuint fs = compileShader(GL_FRAGMENT_SHADER, fragmentSource);
+  if(!vs || !fs){
+    if(vs) glDeleteShader(vs);
+    if(fs) glDeleteShader(fs);
+    return 0;
+  }
+
+  GLuint program = glCreateProgram();
+  glAttachShader(program, vs);
+  glAttachShader(program, fs);
+  glLinkProgram(program);
+  glDeleteShader(vs);
+  glDeleteShader(fs);
+
+  GLint status = GL_FALSE;
+  glGetProgramiv(program, GL_LINK_STATUS, &status);
+  if(status != GL_TRUE){
+    char log[1024];
+    glGetProgramInfoLog(program, sizeof(log), NULL, log);
+    fprintf(stderr, "Shader link error: %s\n", log);
+    glDeleteProgram(program);
+    return 0;
+  }
+
+  // 텍스처 유닛: 0 깊이, 1 색상, 2 광선, 3 컬러맵 (사용하지 않는 이름은 무시됨)
+  glUseProgram(program);
+  glUniform1i(glGetUniformLocation(program, "depthTex"), 0);
+  glUniform1i(glGetUniformLocation(program, "colorTex"), 1);
+  glUniform1i(glGetUniformLocation(program, "rayTex"), 2);
+  glUniform1i(glGetUniformLocation(program, "lutTex"), 3);
+  glUseProgram(0);
+  return program;
+}
+
+// Turbo 컬러맵 다항식 근사로 256 단계 조회 텍스처 생성 (가까움: 파랑 -> 멂: 빨강)
+static void createDepthLutTexture(){
+  static const float red[6] = {0.13572138f, 4.61539260f, -42.66032258f, 132.13108234f, -152.94239396f, 59.28637943f};
+  static const float green[6] = {0.09140261f, 2.19418839f, 4.84296658f, -14.18503333f, 4.27729857f, 2.82956604f};
+  static const float blue[6] = {0.10667330f, 12.64194608f, -60.58204836f, 110.36276771f, -89.90310912f, 27.34824973f};
+  const float* coefficients[3] = {red, green, blue};
+
+  uint8_t lut[256 * 3];
+  for(int i = 0; i < 256; ++i){
+    float x = i / 255.0f;
+    for(int c = 0; c < 3; ++c){
+      const float* k = coefficients[c];
+      float v = k[0] + x * (k[1] + x * (k[2] + x * (k[3] + x * (k[4] + x * k[5]))));
+      v = v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+      lut[i * 3 + c] = (uint8_t)(v * 255.0f + 0.5f);
+    }
+  }
+
+  glGenTextures(1, &depthLutTexture);
+  glBindTexture(GL_TEXTURE_2D, depthLutTexture);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, 256, 1, 0, GL_RGB, GL_UNSIGNED_BYTE, lut);
+  glBindTexture(GL_TEXTURE_2D, 0);
+}
+
 // Initialize OpenGL
 void initOpenGL()
 {
@@ -76,6 +321,317 @@ void initOpenGL()
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenTextures(1, &colorTexture);
+    glBindTexture(GL_TEXTURE_2D, colorTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenTextures(1, &rayTexture);
+    glBindTexture(GL_TEXTURE_2D, rayTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // llvmpipe 등 소프트웨어 렌더러는 정점 셰이더를 CPU 에서 포인트마다 실행해 즉시 모드보다 느림
+    // (640x480, 1 코어 기준 redraw 114 ms vs 89 ms) -> 따로 지정하지 않았으면 즉시 모드 사용
+    if(immediateMode < 0){
+      const char* renderer = (const char*)glGetString(GL_RENDERER);
+      immediateMode = renderer && (strstr(renderer, "llvmpipe") || strstr(renderer, "softpipe") ||
+                                   strstr(renderer, "SWR"));
+      if(immediateMode){
+        printf("Point cloud rendered in immediate mode (software renderer %s)\n", renderer);
+      }
+    }else if(immediateMode){
+      printf("Point cloud rendered in immediate mode (requested)\n");
+    }
+    if(immediateMode){
+      return;
+    }
+
+    // GLSL 1.30 (OpenGL 3.0) 이상 필요, 실패 시 즉시 모드 렌더링 사용
+    if(GLEW_VERSION_3_0){
+      pointCloudProgram = createProgram(pointCloudVertexShader, pointCloudFragmentShader);
+    }
+    if(!pointCloudProgram){
+      fprintf(stderr, "Point cloud shader unavailable, falling back to immediate mode\n");
+      return;
+    }
+
+    // 영상 화면은 포인트 클라우드와 같은 텍스처를 사용하므로 셰이더 경로에서만 지원
+    paneProgram = createProgram(paneVertexShader, paneFragmentShader);
+    if(paneProgram){
+      createDepthLutTexture();
+    }else{
+      fprintf(stderr, "Pane shader unavailable, showing 3D view only\n");
+    }
+
+    // PBO 는 OpenGL 2.1 부터 기본 지원 (GL 3.0 이상이므로 항상 사용 가능)
+    glGenBuffers(UPLOAD_PBO_COUNT, uploadPbo);
+}
+
+// 다시 그리기 요청 (임의의 스레드에서 호출 가능)
+static void requestRedraw(void){
+  atomic_store_explicit(&redrawRequested, 1, memory_order_release);
+  if(offscreenWidth > 0){
+    pthread_mutex_lock(&redrawMutex);
+    pthread_cond_signal(&redrawCond);
+    pthread_mutex_unlock(&redrawMutex);
+  }else if(atomic_load_explicit(&viewerEventsReady, memory_order_acquire)){
+    glfwPostEmptyEvent();
+  }
+}
+
+// 단조 시계 (초)
+static double viewerNow(void){
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// 다시 그리기 요청이나 입력 이벤트를 최대 timeout 초 동안 대기
+static void waitForViewerEvents(double timeout){
+  if(offscreenWidth <= 0){
+    glfwWaitEventsTimeout(timeout);
+    return;
+  }
+
+  struct timespec deadline;
+  clock_gettime(CLOCK_REALTIME, &deadline);
+  double nsec = deadline.tv_nsec + timeout * 1e9;
+  deadline.tv_sec += (time_t)(nsec / 1e9);
+  deadline.tv_nsec = (long)(nsec - (double)(time_t)(nsec / 1e9) * 1e9);
+
+  pthread_mutex_lock(&redrawMutex);
+  while(viewerIsRunning && !atomic_load_explicit(&redrawRequested, memory_order_acquire)){
+    if(pthread_cond_timedwait(&redrawCond, &redrawMutex, &deadline) == ETIMEDOUT){
+      break;
+    }
+  }
+  pthread_mutex_unlock(&redrawMutex);
+}
+
+// 현재 렌더 타깃 크기
+static void getViewerFramebufferSize(int* width, int* height){
+  if(offscreenWidth > 0){
+    *width = offscreenWidth;
+    *height = offscreenHeight;
+  }else{
+    glfwGetFramebufferSize(window, width, height);
+  }
+}
+
+// 수신 파이프라인 설정 (initViewerModule 이전에 호출)
+void setViewerPipeline(const char* pipeline){
+  snprintf(viewerPipeline, sizeof(viewerPipeline), "%s", pipeline ? pipeline : "");
+}
+
+// 표시할 카메라 설정 (initViewerModule 이전에 호출)
+void setViewerCamera(int camera_id){
+  viewerCamera = camera_id;
+}
+
+// 오프스크린 모드 설정 (initViewerModule 이전에 호출)
+void setViewerOffscreen(int width, int height){
+  offscreenWidth = width > 0 && height > 0 ? width : 0;
+  offscreenHeight = width > 0 && height > 0 ? height : 0;
+}
+
+// 렌더링 영상 콜백 설정 (initViewerModule 이전에 호출)
+void setViewerImageCallback(OffscreenImageCallback callback, void* user_data){
+  imageCallback = callback;
+  imageCallbackData = user_data;
+}
+
+// 수신 프레임 콜백 설정
+void setViewerFrameCallback(ViewerFrameCallback callback, void* user_data){
+  frameCallbackData = user_data;
+  frameCallback = callback;
+}
+
+// 포인트 클라우드 그리기 경로 지정 (initViewerModule 이전에 호출)
+void setViewerImmediateMode(int mode){
+  immediateMode = mode < 0 ? -1 : (mode ? 1 : 0);
+}
+
+// 성능 HUD 표시 여부 설정 (임의의 스레드에서 호출 가능)
+void setViewerHud(int enabled){
+  atomic_store(&hudEnabled, enabled ? 1 : 0);
+  requestRedraw();
+}
+
+// RGB / 깊이 영상 화면 분할 여부 설정
+void setViewerPanes(int enabled){
+  atomic_store(&panesEnabled, enabled ? 1 : 0);
+  requestRedraw();
+}
+
+// 누적 지도 표시 여부 설정
+void setViewerMap(int enabled){
+  atomic_store(&mapEnabled, enabled ? 1 : 0);
+  requestRedraw();
+}
+
+// 누적 지도 옵션 설정 (initViewerModule 이전에 호출)
+void setViewerMapOptions(const PointMapOptions* options){
+  viewerMapOptions = *options;
+  viewerMapOptionsSet = 1;
+}
+
+// 카메라 자세 전달 (지도 누적용)
+void submitViewerPose(uint32_t timestamp, const float* Twc){
+  pushViewerMapPose(timestamp, Twc);
+  if(atomic_load_explicit(&mapEnabled, memory_order_relaxed)){
+    requestRedraw(); // 카메라를 따라가며 그림
+  }
+}
+
+// 누적 지도 비우기
+void resetViewerMap(void){
+  clearViewerMap();
+  requestRedraw();
+}
+
+// 최대 화면 갱신율 설정 (0 이면 제한 없음)
+void setViewerMaxFps(int max_fps){
+  atomic_store(&viewerMaxFps, max_fps > 0 ? max_fps : 0);
+}
+
+// 카메라 내부 파라미터 설정
+void setViewerIntrinsics(const CameraIntrinsics* intrinsics){
+  pthread_mutex_lock(&intrinsicsMutex);
+  cameraIntrinsics = *intrinsics;
+  intrinsicsVersion++;
+  pthread_mutex_unlock(&intrinsicsMutex);
+  setViewerMapIntrinsics(intrinsics);
+  requestRedraw();
+}
+
+int loadViewerIntrinsics(const char* yaml_file){
+  CameraIntrinsics intrinsics;
+  pthread_mutex_lock(&intrinsicsMutex);
+  intrinsics = cameraIntrinsics;
+  pthread_mutex_unlock(&intrinsicsMutex);
+
+  if(!loadCameraIntrinsics(yaml_file, &intrinsics)){
+    return 0;
+  }
+
+  printf("Viewer intrinsics: fx %.2f fy %.2f cx %.2f cy %.2f (%dx%d)\n", intrinsics.fx, intrinsics.fy, intrinsics.cx,
+         intrinsics.cy, intrinsics.width, intrinsics.height);
+  setViewerIntrinsics(&intrinsics);
+  return 1;
+}
+
+// 프레임 버퍼 해제
+static void freeFrame(ViewerFrame* frame){
+  if(!frame) return;
+  free(frame->depth);
+  free(frame->color);
+  free(frame);
+}
+
+// 풀에서 해상도가 같은 프레임 버퍼를 꺼냄 (없으면 새로 할당, 0 으로 채우지 않음)
+static ViewerFrame* acquirePoolFrame(int width, int height){
+  for(int i = 0; i < framePoolCount; ++i){
+    if(framePool[i]->width == width && framePool[i]->height == height){
+      ViewerFrame* frame = framePool[i];
+      framePool[i] = framePool[--framePoolCount];
+      return frame;
+    }
+  }
+
+  // 해상도가 바뀌었으면 이전 해상도 버퍼는 더 이상 쓰이지 않으므로 해제
+  for(int i = 0; i < framePoolCount; ++i){
+    freeFrame(framePool[i]);
+  }
+  framePoolCount = 0;
+
+  size_t pixels = (size_t)width * height;
+  ViewerFrame* frame = (ViewerFrame*)calloc(1, sizeof(ViewerFrame));
+  if(!frame){
+    perror("calloc frame");
+    return NULL;
+  }
+  frame->depth = (int16_t*)malloc(pixels * sizeof(int16_t));
+  frame->color = (uint8_t*)malloc(pixels * 3 * sizeof(uint8_t));
+  if(!frame->depth || !frame->color){
+    perror("malloc frame buffers");
+    freeFrame(frame);
+    return NULL;
+  }
+  frame->width = width;
+  frame->height = height;
+  return frame;
+}
+
+// 프레임 버퍼를 풀에 반환
+static void releasePoolFrame(ViewerFrame* frame){
+  if(!frame) return;
+  if(framePoolCount < FRAME_POOL_SIZE){
+    framePool[framePoolCount++] = frame;
+  }else{
+    freeFrame(frame);
+  }
+}
+
+// 완성된 수신 프레임을 back 슬롯에 넘겨 게시 (수신 스레드)
+// 복사 없이 포인터만 교환하고, back 슬롯에 있던 이전 프레임은 풀로 반환
+static void requestRedraw(void);
+
+static void publishFrame(FrameReceiveStatus* status){
+  // 지도가 켜져 있으면 자세가 올 때까지 복사본 보관
+  ViewerFrame* frame = status->frame;
+  if(atomic_load_explicit(&mapEnabled, memory_order_relaxed)){
+    pushViewerMapFrame(frame->depth, frame->color, frame->width, frame->height, frame->timestamp);
+  }
+  if(frameCallback){
+    frameCallback(frame->depth, frame->color, frame->width, frame->height, frame->timestamp, frameCallbackData);
+  }
+
+  releasePoolFrame(frameSlots[backSlot]);
+  frameSlots[backSlot] = status->frame;
+  status->frame = NULL;
+
+  int previous = atomic_exchange_explicit(&middleSlot, backSlot | FRAME_SLOT_NEW, memory_order_acq_rel);
+  backSlot = previous & FRAME_SLOT_MASK;
+
+  // 렌더링 스레드가 가져가기 전에 덮어쓴 프레임은 버려진 것으로 집계
+  monitorAdd(MONITOR_VIEWER_FRAMES, 1);
+  if(previous & FRAME_SLOT_NEW){
+    monitorAdd(MONITOR_VIEWER_DROPPED, 1);
+  }
+
+  // 대기 중인 렌더링 루프 깨우기 (재생 시 화면 갱신율이 데이터 속도를 따라감)
+  requestRedraw();
+}
+
+// 최신 완성 프레임 획득 (렌더링 스레드)
+// 반환값: 새 프레임이면 1, 이전 프레임을 그대로 쓰면 0 (*frame 은 NULL 일 수 있음)
+static int acquireLatestFrame(ViewerFrame** frame){
+  int isNew = 0;
+  if(atomic_load_explicit(&middleSlot, memory_order_relaxed) & FRAME_SLOT_NEW){
+    frontSlot = atomic_exchange_explicit(&middleSlot, frontSlot, memory_order_acq_rel) & FRAME_SLOT_MASK;
+    isNew = 1;
+  }
+  *frame = frameSlots[frontSlot];
+  return isNew;
+}
+
+// 삼중 버퍼와 풀 해제 (두 스레드 모두 종료된 뒤 호출)
+static void releaseFrameSlots(){
+  for(int i = 0; i < 3; ++i){
+    freeFrame(frameSlots[i]);
+    frameSlots[i] = NULL;
+  }
+  for(int i = 0; i < framePoolCount; ++i){
+    freeFrame(framePool[i]);
+  }
+  framePoolCount = 0;
+  backSlot = 0;
+  frontSlot = 1;
+  atomic_store(&middleSlot, 2);
 }
 
 // 콜백 설정 함수
@@ -95,28 +651,21 @@ static void* safe_malloc(size){
 }
 
 // Frame Receive Status Initialization
+// 수신 중이던 버퍼의 해상도가 같으면 그대로 재사용하고, 다르면 풀과 교환
 void initFrameReceiveStatus(FrameReceiveStatus* status, int frameId, uint32_t timestamp, int width, int height){
-  // 기존 버퍼를 해제하기 전에 새 버퍼 할당
-  int depthDataSize = width * height * sizeof(int16_t);
-  int colorDataSize = width * height * 3 * sizeof(uint8_t);
-
-  char* newDepthBuffer = safe_malloc(depthDataSize);
-  char* newColorBuffer = safe_malloc(colorDataSize);
-
-  if(!newDepthBuffer || !newColorBuffer){
-    if(newDepthBuffer) free(newDepthBuffer);
-    if(newColorBuffer) free(newColorBuffer);
-
-    // 실패 시 기준 버퍼 유지
-    return;
+  // 청크를 받던 프레임이 완성되기 전에 다음 프레임이 시작됨
+  if(status->frame && !status->isComplete && (status->receivedDepthChunks || status->receivedColorChunks)){
+    monitorAdd(MONITOR_VIEWER_DROPPED, 1);
   }
 
-  // 이전 버퍼 해제
-  if(status->depthDataBuffer){
-    free(status->depthDataBuffer);
-  }
-  if(status->colorDataBuffer){
-    free(status->colorDataBuffer);
+  if(!status->frame || status->frame->width != width || status->frame->height != height){
+    ViewerFrame* newFrame = acquirePoolFrame(width, height);
+    if(!newFrame){
+      // 실패 시 기준 버퍼 유지
+      return;
+    }
+    releasePoolFrame(status->frame);
+    status->frame = newFrame;
   }
 
   status->frameId = frameId;
@@ -128,49 +677,22 @@ void initFrameReceiveStatus(FrameReceiveStatus* status, int frameId, uint32_t ti
   status->receivedColorChunks = 0;
   status->totalColorChunks = 0;
   status->isComplete = 0;
-  status->depthDataBuffer = newDepthBuffer;
-  status->colorDataBuffer = newColorBuffer;
-
-  // // 이전 버퍼 해제
-  // if(status->depthDataBuffer){
-  //   free(status->depthDataBuffer);
-  // }
-  //
-  // if(status->colorDataBuffer){
-  //   free(status->colorDataBuffer);
-  // }
-  //
-  // // Allocate new buffer
-  // int depthDataSize = width * height * sizeof(int16_t);
-  // int colorDataSize = width * height * 3 * sizeof(uint8_t);
-  //
-  // status->depthDataBuffer = (char*)malloc(depthDataSize);
-  // status->colorDataBuffer = (char*)malloc(colorDataSize);
-  //
-  // if(!status->depthDataBuffer || !status->colorDataBuffer){
-  //   perror("malloc frame buffers");
-  //   if(status->depthDataBuffer) free(status->depthDataBuffer);
-  //   if(status->colorDataBuffer) free(status->colorDataBuffer);
-  //   status->depthDataBuffer = NULL;
-  //   status->colorDataBuffer = NULL;
-  // }
+  status->frame->frameId = frameId;
+  status->frame->timestamp = timestamp;
 }
 
 // Data Receiving Thread
 void* dataReceiveThread(void* arg){
   printf("Viewer data receive thread started...\n");
+  monitorRegisterThread(MONITOR_THREAD_VIEWER_RECEIVE);
 
-  // Message Queue Feature Setting
-  struct mq_attr attr;
-  attr.mq_flags = 0;
-  attr.mq_maxmsg = 10;
-  attr.mq_msgsize = MAX_MSG_SIZE;
-  attr.mq_curmsgs = 0;
-
-  // Open Message Queue
-  mqReceive = mq_open(MQ_LOGGER_TO_VIEWER, O_RDONLY, 0644, &attr);
+  // Open Message Queue (로깅 모듈이 만든 파이프라인 큐)
+  PipelineQueueNames queues;
+  makePipelineQueueNames(&queues, viewerPipeline);
+  mqReceive = mq_open(queues.loggerToViewer, O_RDONLY);
   if(mqReceive == (mqd_t) - 1){
     perror("mq_open receive");
+    monitorUnregisterThread(MONITOR_THREAD_VIEWER_RECEIVE);
     return NULL;
   }
 
@@ -178,13 +700,13 @@ void* dataReceiveThread(void* arg){
   char* msgBuffer = safe_malloc(MAX_MSG_SIZE);
   if(!msgBuffer){
     mq_close(mqReceive);
+    monitorUnregisterThread(MONITOR_THREAD_VIEWER_RECEIVE);
     return NULL;
   }
 
   // Initialize Receive status - 구조체 필드 명시적 초기화
   memset(&receiveStatus, 0, sizeof(FrameReceiveStatus));
-  receiveStatus.depthDataBuffer = NULL;
-  receiveStatus.colorDataBuffer = NULL;
+  receiveStatus.frame = NULL;
 
   // Main Loop
   while(viewerIsRunning){
@@ -193,26 +715,27 @@ void* dataReceiveThread(void* arg){
     if(byteRead > 0){
       MessageHeader* header = (MessageHeader*)msgBuffer;
 
+      // 다른 카메라의 프레임은 건너뜀 (묶음 안의 카메라들은 frameId 가 같음)
+      if(header->cameraId != viewerCamera){
+        continue;
+      }
+
       // 메세지 타입에 따라 처리
       switch(header->msgType){
         case MSG_TYPE_METADATA:
           // 새 프레임 정보 수신
-          pthread_mutex_lock(&dataMutex);
           initFrameReceiveStatus(&receiveStatus, header->frameId, header->timestamp, header->width, header->height);
-          pthread_mutex_unlock(&dataMutex);
           break;
 
         case MSG_TYPE_DEPTH_DATA:
           // 깊이 데이터 청크 수신
-          pthread_mutex_lock(&dataMutex);
-
-          if(header->frameId == receiveStatus.frameId && receiveStatus.depthDataBuffer){
+          if(header->frameId == receiveStatus.frameId && receiveStatus.frame){
             int maxDataPerMsg = MAX_MSG_SIZE - sizeof(MessageHeader);
             int offset = header->chunkIndex * maxDataPerMsg;
 
             // 범위 체크 추가
             if(offset + header->dataSize <= receiveStatus.width * receiveStatus.height * sizeof(int16_t)){
-              memcpy(receiveStatus.depthDataBuffer + offset, msgBuffer + sizeof(MessageHeader), header->dataSize);
+              memcpy((char*)receiveStatus.frame->depth + offset, msgBuffer + sizeof(MessageHeader), header->dataSize);
 
               receiveStatus.receivedDepthChunks++;
               receiveStatus.totalDepthChunks = header->totalChunks;
@@ -220,21 +743,17 @@ void* dataReceiveThread(void* arg){
               printf("Warning: Depth data chunk exceeds buffer size, ignoring\n");
             }
           }
-
-          pthread_mutex_unlock(&dataMutex);
           break;
 
         case MSG_TYPE_COLOR_DATA:
           // 색상 데이터 청크 수신
-          pthread_mutex_lock(&dataMutex);
-
-          if(header->frameId == receiveStatus.frameId && receiveStatus.colorDataBuffer){
+          if(header->frameId == receiveStatus.frameId && receiveStatus.frame){
             int maxDataPerMsg = MAX_MSG_SIZE - sizeof(MessageHeader);
             int offset = header->chunkIndex * maxDataPerMsg;
 
             // 범위 체크 추가
             if(offset + header->dataSize <= receiveStatus.width * receiveStatus.height * 3 * sizeof(uint8_t)){
-              memcpy(receiveStatus.colorDataBuffer + offset, msgBuffer + sizeof(MessageHeader), header->dataSize);
+              memcpy((char*)receiveStatus.frame->color + offset, msgBuffer + sizeof(MessageHeader), header->dataSize);
 
               receiveStatus.receivedColorChunks++;
               receiveStatus.totalColorChunks = header->totalChunks;
@@ -242,53 +761,17 @@ void* dataReceiveThread(void* arg){
               printf("Warning: Color data chunk exceeds buffer size, lgnoring\n");
             }
           }
-
-          pthread_mutex_unlock(&dataMutex);
           break;
       }
 
-      // 프레임 완성 여부 확인
-      pthread_mutex_lock(&dataMutex);
-
-      if(receiveStatus.totalDepthChunks > 0 && receiveStatus.totalColorChunks > 0 && receiveStatus.receivedDepthChunks == receiveStatus.totalDepthChunks && receiveStatus.receivedColorChunks == receiveStatus.totalColorChunks){
-        // 프레임이 완성됨 - 메인 버퍼로 복사
-
-        if(currentWidth != receiveStatus.width || currentHeight != receiveStatus.height){
-          // 버퍼 크기 변경 필요
-          uint16_t* newDepthBuffer = (int16_t*)safe_malloc(receiveStatus.width * receiveStatus.height * sizeof(int16_t));
-          uint8_t* newColorBuffer = (uint8_t*)safe_malloc(receiveStatus.width * receiveStatus.height * 3 * sizeof(uint8_t));
-
-          if(!newDepthBuffer || !newColorBuffer){
-            if(newDepthBuffer) free(newDepthBuffer);
-            if(newColorBuffer) free(newColorBuffer);
-            pthread_mutex_unlock(&dataMutex);
-            continue;
-          }
-
-          // 이전 버퍼 해제
-          if(depthDataBuffer) free(depthDataBuffer);
-          if(colorDataBuffer) free(colorDataBuffer);
-
-          depthDataBuffer = newDepthBuffer;
-          colorDataBuffer = newColorBuffer;
-          currentWidth = receiveStatus.width;
-          currentHeight = receiveStatus.height;
-        }
-
-        if(depthDataBuffer && colorDataBuffer){
-          // 데이터 복사
-          memcpy(depthDataBuffer, receiveStatus.depthDataBuffer, currentWidth * currentHeight * sizeof(int16_t));
-          memcpy(colorDataBuffer, receiveStatus.colorDataBuffer, currentWidth * currentHeight * 3 * sizeof(uint8_t));
-
-          // currentFrameId = receiveStatus.frameId;
-          hasNewData = 1;
-        }
+      // 프레임 완성 여부 확인 (수신 상태는 수신 스레드 전용이므로 락 불필요)
+      if(!receiveStatus.isComplete && receiveStatus.totalDepthChunks > 0 && receiveStatus.totalColorChunks > 0 && receiveStatus.receivedDepthChunks == receiveStatus.totalDepthChunks && receiveStatus.receivedColorChunks == receiveStatus.totalColorChunks){
+        // 프레임이 완성됨 - 버퍼 포인터를 삼중 버퍼로 넘김
+        publishFrame(&receiveStatus);
 
         // 상태 초기화를 위한 플래그
         receiveStatus.isComplete = 1;
       }
-
-      pthread_mutex_unlock(&dataMutex);
     }else{
       // 에러 발생 시 짧은 대기 후 재시도
       usleep(10000); // 10ms 
@@ -299,28 +782,257 @@ void* dataReceiveThread(void* arg){
   // 정리
   free(msgBuffer);
 
-  pthread_mutex_lock(&dataMutex);
-  if(receiveStatus.depthDataBuffer){
-    free(receiveStatus.depthDataBuffer);
-    receiveStatus.depthDataBuffer = NULL;
-  }
-
-  if(receiveStatus.colorDataBuffer){
-    free(receiveStatus.colorDataBuffer);
-    receiveStatus.colorDataBuffer = NULL;
-  }
-  pthread_mutex_unlock(&dataMutex);
+  releasePoolFrame(receiveStatus.frame);
+  receiveStatus.frame = NULL;
 
   mq_close(mqReceive);
 
+  monitorUnregisterThread(MONITOR_THREAD_VIEWER_RECEIVE);
   printf("Data receive thread terminated\n");
   return NULL;
 }
 
+// 새 프레임을 깊이/색상 텍스처로 업로드 (3D 및 영상 화면이 모두 이 텍스처를 사용)
+// 프레임을 PBO 에 복사하고 텍스처 갱신은 PBO 에서 비동기로 수행, PBO 가 없으면 직접 업로드
+static void uploadFrameTextures(const ViewerFrame* frame){
+  size_t depthBytes = (size_t)frame->width * frame->height * sizeof(uint16_t);
+  size_t colorBytes = (size_t)frame->width * frame->height * 3;
+  const void* depthSource = frame->depth;
+  const void* colorSource = frame->color;
+
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  if(textureWidth != frame->width || textureHeight != frame->height){
+    // 해상도가 바뀐 경우에만 텍스처 저장소 재할당
+    glBindTexture(GL_TEXTURE_2D, depthTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R16UI, frame->width, frame->height, 0, GL_RED_INTEGER, GL_UNSIGNED_SHORT, NULL);
+    glBindTexture(GL_TEXTURE_2D, colorTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, frame->width, frame->height, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+    textureWidth = frame->width;
+    textureHeight = frame->height;
+  }
+
+  // 직전 프레임의 전송이 끝나지 않았을 수 있으므로 PBO 를 번갈아 사용하고 매핑 시 내용을 버림
+  GLuint pbo = uploadPbo[uploadPboIndex];
+  if(pbo){
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+    if(uploadPboSize[uploadPboIndex] != depthBytes + colorBytes){
+      glBufferData(GL_PIXEL_UNPACK_BUFFER, depthBytes + colorBytes, NULL, GL_STREAM_DRAW);
+      uploadPboSize[uploadPboIndex] = depthBytes + colorBytes;
+    }
+    uint8_t* mapped = (uint8_t*)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, depthBytes + colorBytes,
+                                                 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if(mapped){
+      memcpy(mapped, frame->depth, depthBytes);
+      memcpy(mapped + depthBytes, frame->color, colorBytes);
+      glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+      depthSource = (const void*)0;                 // PBO 내 오프셋
+      colorSource = (const void*)(uintptr_t)depthBytes;
+      uploadPboIndex = (uploadPboIndex + 1) % UPLOAD_PBO_COUNT;
+    }else{
+      glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+  }
+
+  glBindTexture(GL_TEXTURE_2D, depthTexture);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, frame->width, frame->height, GL_RED_INTEGER, GL_UNSIGNED_SHORT,
+                  depthSource);
+  glBindTexture(GL_TEXTURE_2D, colorTexture);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, frame->width, frame->height, GL_RGB, GL_UNSIGNED_BYTE, colorSource);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+// 프레임 해상도와 내부 파라미터에 맞게 광선 테이블 갱신 (렌더링 스레드)
+// 반환값: 사용 가능한 광선 테이블이 있으면 1
+static int updateViewerRays(int width, int height){
+  pthread_mutex_lock(&intrinsicsMutex);
+  CameraIntrinsics intrinsics = cameraIntrinsics;
+  uint32_t version = intrinsicsVersion;
+  pthread_mutex_unlock(&intrinsicsMutex);
+
+  if(viewerRays.rayX && viewerRays.width == width && viewerRays.height == height && viewerRaysVersion == version){
+    return 1;
+  }
+
+  destroyRayTable(&viewerRays);
+  if(!createRayTable(&viewerRays, &intrinsics, width, height)){
+    return 0;
+  }
+  viewerRaysVersion = version;
+
+  // 셰이더용 광선 텍스처 (RG32F)
+  if(pointCloudProgram){
+    size_t pixels = (size_t)width * height;
+    float* rays = (float*)malloc(pixels * 2 * sizeof(float));
+    if(rays){
+      for(size_t i = 0; i < pixels; ++i){
+        rays[i * 2] = viewerRays.rayX[i];
+        rays[i * 2 + 1] = viewerRays.rayY[i];
+      }
+      glBindTexture(GL_TEXTURE_2D, rayTexture);
+      glTexImage2D(GL_TEXTURE_2D, 0, GL_RG32F, width, height, 0, GL_RG, GL_FLOAT, rays);
+      glBindTexture(GL_TEXTURE_2D, 0);
+      free(rays);
+    }
+  }
+  return 1;
+}
+
+// 즉시 모드 렌더링 (셰이더를 사용할 수 없는 경우)
+// KernelModule 로 유효 깊이만 역투영한 뒤 그림
+static void drawPointCloudImmediate(const ViewerFrame* frame){
+  if(!frame || !frame->depth || !frame->color || frame->width <= 0 || frame->height <= 0){
+    return;
+  }
+  if(!updateViewerRays(frame->width, frame->height)){
+    return;
+  }
+
+  size_t pixels = (size_t)frame->width * frame->height;
+  if(viewerPoints.capacity < pixels){
+    freePointBuffer(&viewerPoints);
+    if(!allocPointBuffer(&viewerPoints, pixels)){
+      return;
+    }
+  }
+
+  unprojectDepth(&viewerRays, (const uint16_t*)frame->depth, frame->color, 0.001f, 65.0f, KERNEL_UNPROJECT_COMPACT,
+                 &viewerPoints);
+
+  glBegin(GL_POINTS);
+  for(size_t i = 0; i < viewerPoints.count; ++i){
+    glColor3ub(viewerPoints.r[i], viewerPoints.g[i], viewerPoints.b[i]);
+    glVertex3f(-viewerPoints.x[i], -viewerPoints.y[i], -viewerPoints.z[i]);
+  }
+  glEnd();
+}
+
+// 셰이더 렌더링 (픽셀당 버텍스 하나, 역투영은 GPU 에서 수행)
+static void drawPointCloudShader(){
+  if(textureWidth <= 0 || textureHeight <= 0 || !updateViewerRays(textureWidth, textureHeight)){
+    return;
+  }
+
+  glUseProgram(pointCloudProgram);
+  glUniform1f(glGetUniformLocation(pointCloudProgram, "depthScale"), viewerRays.depthScale);
+  glUniform1i(glGetUniformLocation(pointCloudProgram, "imageWidth"), textureWidth);
+
+  glActiveTexture(GL_TEXTURE0);
+  glBindTexture(GL_TEXTURE_2D, depthTexture);
+  glActiveTexture(GL_TEXTURE1);
+  glBindTexture(GL_TEXTURE_2D, colorTexture);
+  glActiveTexture(GL_TEXTURE2);
+  glBindTexture(GL_TEXTURE_2D, rayTexture);
+
+  glDrawArrays(GL_POINTS, 0, textureWidth * textureHeight);
+
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glActiveTexture(GL_TEXTURE1);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glActiveTexture(GL_TEXTURE0);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glUseProgram(0);
+}
+
+// 영상 비율을 유지하며 칸 안에 맞춤
+static ViewerPane fitPane(ViewerPane cell, int imageWidth, int imageHeight){
+  ViewerPane pane = cell;
+  if((long)cell.width * imageHeight > (long)cell.height * imageWidth){
+    pane.width = (int)((long)cell.height * imageWidth / imageHeight);
+    pane.x += (cell.width - pane.width) / 2;
+  }else{
+    pane.height = (int)((long)cell.width * imageHeight / imageWidth);
+    pane.y += (cell.height - pane.height) / 2;
+  }
+  return pane;
+}
+
+// 화면 배치 계산, 영상 화면을 그릴 수 없으면 3D 가 전체를 차지
+// 반환값: 영상 화면을 그리면 1
+static int computePaneLayout(int width, int height, ViewerPane* view3d, ViewerPane* rgbPane, ViewerPane* depthPane){
+  ViewerPane full = {0, 0, width, height};
+  *view3d = full;
+  if(!atomic_load_explicit(&panesEnabled, memory_order_relaxed) || !paneProgram || textureWidth <= 0 ||
+     textureHeight <= 0 || width < 3 || height < 2){
+    return 0;
+  }
+
+  int side = width / 3;
+  view3d->width = width - side;
+  ViewerPane top = {width - side, height / 2, side, height - height / 2};
+  ViewerPane bottom = {width - side, 0, side, height / 2};
+  *rgbPane = fitPane(top, textureWidth, textureHeight);
+  *depthPane = fitPane(bottom, textureWidth, textureHeight);
+  return 1;
+}
+
+// RGB 또는 컬러맵 깊이 영상 화면 그리기 (업로드된 텍스처 재사용, 추가 CPU 작업 없음)
+static void drawImagePane(const ViewerPane* pane, int mode){
+  glViewport(pane->x, pane->y, pane->width, pane->height);
+
+  glUseProgram(paneProgram);
+  glUniform1i(glGetUniformLocation(paneProgram, "paneMode"), mode);
+  glUniform1f(glGetUniformLocation(paneProgram, "depthScale"), viewerRays.depthScale);
+  glUniform2f(glGetUniformLocation(paneProgram, "depthRange"), PANE_DEPTH_MIN_M, PANE_DEPTH_MAX_M);
+
+  glActiveTexture(GL_TEXTURE0);
+  glBindTexture(GL_TEXTURE_2D, depthTexture);
+  glActiveTexture(GL_TEXTURE1);
+  glBindTexture(GL_TEXTURE_2D, colorTexture);
+  glActiveTexture(GL_TEXTURE3);
+  glBindTexture(GL_TEXTURE_2D, depthLutTexture);
+
+  glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glActiveTexture(GL_TEXTURE1);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glActiveTexture(GL_TEXTURE0);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glUseProgram(0);
+}
+
 // 3D Rendring Function
 void display_3d_color(){
+  static double redrawTotalMs = 0.0;
+  static double hudTotalMs = 0.0;
+  static double mapTotalPoints = 0.0;
+  static int redrawFrames = 0;
+  static double statsStartTime = 0.0;
+
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  // 최신 완성 프레임 획득 (수신 스레드를 기다리지 않음)
+  ViewerFrame* frame;
+  int isNew = acquireLatestFrame(&frame);
+  if(pointCloudProgram && isNew && frame && frame->depth && frame->color && frame->width > 0 && frame->height > 0){
+    uploadFrameTextures(frame);
+  }
+
+  // 지도: 준비된 청크를 나눠 올리고 (남으면 다음 프레임에 계속), 자세가 있으면 카메라를 따라감
+  float Twc[16];
+  int showMap = mapReady && atomic_load_explicit(&mapEnabled, memory_order_relaxed);
+  int posed = showMap && getViewerMapPose(Twc);
+  if(showMap && uploadViewerMap()){
+    requestRedraw();
+  }
+
+  int width, height;
+  getViewerFramebufferSize(&width, &height);
+  ViewerPane view3d, rgbPane, depthPane;
+  int showPanes = computePaneLayout(width, height, &view3d, &rgbPane, &depthPane);
+
+  glViewport(0, 0, width, height);
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+  // 3D 화면 (칸 비율에 맞춘 투영)
+  glViewport(view3d.x, view3d.y, view3d.width, view3d.height);
+  glMatrixMode(GL_PROJECTION);
+  glLoadIdentity();
+  gluPerspective(45.0, (double)view3d.width / (double)(view3d.height > 0 ? view3d.height : 1), 0.1, showMap ? MAP_FAR_PLANE : 100.0);
+  glMatrixMode(GL_MODELVIEW);
+
   glLoadIdentity();
   glTranslatef(0.0f, 0.0f, -distance);
   glRotatef(angleX, 1.0f, 0.0f, 0.0f);
@@ -328,41 +1040,75 @@ void display_3d_color(){
 
   glScalef(zoom, zoom, zoom);
 
-  pthread_mutex_lock(&dataMutex);
-  
-  if(hasNewData && depthDataBuffer && colorDataBuffer && currentWidth > 0 && currentHeight > 0){
-    glBegin(GL_POINTS);
-
-    for(int y = 0; y < currentHeight; ++y){
-      for(int x = 0; x < currentWidth; ++x){
-        int index = y * currentWidth + x;
-        int depthValue = depthDataBuffer[index];
-
-        if(depthValue > 0){
-          // Calculate 3D Coordinate (Using Simple Camera Model)
-          float z_pos = depthValue / 1000.0f; // from mm to m
-          float x_pos = (x - currentWidth / 2) * z_pos  / 570.3f; // 570.3f is focal distance of Astra camera
-          float y_pos = (y - currentHeight / 2) * z_pos / 570.3f;
-
-          // Set color using color data (RGB order)
-          int colorIndex = index * 3; // RGB consist of 3 values.
-          float r = colorDataBuffer[colorIndex] / 255.0f;
-          float g = colorDataBuffer[colorIndex + 1] / 255.0f;
-          float b = colorDataBuffer[colorIndex + 2] / 255.0f;
-
-          glColor3f(r, g, b);
-          glVertex3f(-x_pos, -y_pos, -z_pos);
-        }
-      }
-    }
+  if(posed){
+    // 월드 좌표 지도: 현재 카메라 위치를 회전 중심으로 두고 포인트 클라우드와 같은 축 반전 (-x, -y, -z) 적용
+    glScalef(-1.0f, -1.0f, -1.0f);
+    glTranslatef(-Twc[12], -Twc[13], -Twc[14]);
+    mapTotalPoints += drawViewerMap();
 
-    glEnd();
+    // 현재 프레임은 카메라 좌표를 반전해서 내보내므로 Twc 앞뒤로 반전
+    glMultMatrixf(Twc);
+    glScalef(-1.0f, -1.0f, -1.0f);
   }
 
-  pthread_mutex_unlock(&dataMutex);
+  if(pointCloudProgram){
+    drawPointCloudShader();
+  }else{
+    drawPointCloudImmediate(frame);
+  }
+
+  if(showPanes){
+    glDisable(GL_DEPTH_TEST);
+    drawImagePane(&rgbPane, 0);
+    drawImagePane(&depthPane, 1);
+    glEnable(GL_DEPTH_TEST);
+  }
+
+  // 성능 HUD (통계 샘플링과 글자 정점 생성은 HUD_SAMPLE_SEC 마다 한 번)
+  if(hudReady && atomic_load_explicit(&hudEnabled, memory_order_relaxed)){
+    struct timespec hudStart, hudEnd;
+    clock_gettime(CLOCK_MONOTONIC, &hudStart);
+    double now = hudStart.tv_sec + hudStart.tv_nsec / 1e9;
+    if(now >= nextHudSample){
+      MonitorStats stats;
+      sampleMonitor(&hudSampler, &stats);
+      updateViewerHud(&stats);
+      nextHudSample = now + HUD_SAMPLE_SEC;
+    }
+    drawViewerHud(width, height);
+    clock_gettime(CLOCK_MONOTONIC, &hudEnd);
+    hudTotalMs += (hudEnd.tv_sec - hudStart.tv_sec) * 1000.0 + (hudEnd.tv_nsec - hudStart.tv_nsec) / 1000000.0;
+  }
+  monitorAdd(MONITOR_RENDERED_FRAMES, 1);
+
+  // 렌더링 명령 제출에 걸린 CPU 시간 측정 (버퍼 스왑 대기 제외)
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  redrawTotalMs += (end.tv_sec - start.tv_sec) * 1000.0 + (end.tv_nsec - start.tv_nsec) / 1000000.0;
+  double now = end.tv_sec + end.tv_nsec / 1e9;
+  if(redrawFrames == 0){
+    statsStartTime = now;
+  }
+  if(++redrawFrames == 300){
+    printf("Viewer redraw (%s): %.3f ms/frame (hud %.3f ms, map %.0f points), %.1f fps\n",
+           pointCloudProgram ? "shader" : "immediate", redrawTotalMs / redrawFrames, hudTotalMs / redrawFrames,
+           mapTotalPoints / redrawFrames, (redrawFrames - 1) / (now - statsStartTime));
+    redrawTotalMs = 0.0;
+    hudTotalMs = 0.0;
+    mapTotalPoints = 0.0;
+    redrawFrames = 0;
+  }
+
+  // 렌더링 결과를 PBO 로 비동기 읽기 (완료된 이전 프레임만 콜백으로 전달, 렌더링 루프는 대기하지 않음)
+  if(readbackEnabled){
+    queueOffscreenReadback(&offscreenTarget, width, height, renderedFrames);
+    collectOffscreenReadbacks(&offscreenTarget, 0, imageCallback, imageCallbackData);
+  }
+  renderedFrames++;
 
   if(window){
     glfwSwapBuffers(window);
+  }else{
+    glFlush();
   }
 }
 
@@ -390,6 +1136,19 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
     printf("ESC key pressed, setting window should close\n");
     glfwSetWindowShouldClose(window, GLFW_TRUE);
   }
+  if(key == GLFW_KEY_P && action == GLFW_PRESS){
+    atomic_store(&panesEnabled, !atomic_load(&panesEnabled));
+  }
+  if(key == GLFW_KEY_H && action == GLFW_PRESS){
+    atomic_store(&hudEnabled, !atomic_load(&hudEnabled));
+  }
+  if(key == GLFW_KEY_M && action == GLFW_PRESS){
+    atomic_store(&mapEnabled, !atomic_load(&mapEnabled));
+  }
+  if(key == GLFW_KEY_C && action == GLFW_PRESS){
+    clearViewerMap();
+  }
+  requestRedraw();
 
   /* 외부 프로그램에 종료 신호 보내기는 window_close_callback 에서 처리됨
    * 여기에서는 중복 호출하지 않음. */
@@ -424,6 +1183,7 @@ void cursor_position_callback(GLFWwindow* window, double xpos, double ypos)
 
         lastMouseX = xpos;
         lastMouseY = ypos;
+        requestRedraw();
     }
 }
 
@@ -437,6 +1197,7 @@ void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
         // Zoom out
         zoom *= 0.9f;
     }
+    requestRedraw();
 }
 
 // Window Size Change Callback
@@ -444,24 +1205,22 @@ void framebuffer_size_callback(GLFWwindow* window, int width, int height)
 {
   if(width <= 0 || height <= 0) return;
 
-  glViewport(0, 0, width, height);
-  glMatrixMode(GL_PROJECTION);
-  glLoadIdentity();
-  gluPerspective(45.0, (double)width / (double)height, 0.1, 100.0);
-  glMatrixMode(GL_MODELVIEW);
+  // 화면 배치와 투영은 매 프레임 display_3d_color 에서 계산
+  requestRedraw();
 }
 
-// Viewer Thread Function
-void* viewerThread(void* id){
+// GLFW 창과 GL 컨텍스트 생성
+// 반환값: 성공 시 1, 실패 시 0
+static int createViewerWindow(){
   printf("Initializing GLFW...\n");
 
   if (!glfwInit()) {
     fprintf(stderr, "Failed to initialize GLFW\n");
-    viewerIsRunning = 0; // 초기화 실패 시 바로 실행 중지 플래그 설정
-    return NULL;
+    return 0;
   }
     
   glfwSetErrorCallback(error_callback);
+  atomic_store(&viewerEventsReady, 1);
     
   // Get Monitor Resolution
   int screenWidth = 800; // Set default value.
@@ -472,10 +1231,12 @@ void* viewerThread(void* id){
   screenHeight = GetSystemMetrics(SM_CYSCREEN);
 #elif __linux__
   Display* d = XOpenDisplay(NULL);
-  Screen* s = DefaultScreenOfDisplay(d);
-  screenWidth = s->width;
-  screenHeight = s->height;
-  XCloseDisplay(d);
+  if(d){
+    Screen* s = DefaultScreenOfDisplay(d);
+    screenWidth = s->width;
+    screenHeight = s->height;
+    XCloseDisplay(d);
+  }
 #endif
 
   // // 너무 큰 창 크기 방지
@@ -494,9 +1255,9 @@ void* viewerThread(void* id){
   window = glfwCreateWindow(screenWidth, screenHeight, "3D Viewer", NULL, NULL);
   if (!window) {
       fprintf(stderr, "Failed to create GLFW window\n");
+      atomic_store(&viewerEventsReady, 0);
       glfwTerminate();
-      viewerIsRunning = 0;
-      return NULL;
+      return 0;
   }
     
   glfwMakeContextCurrent(window);
@@ -511,65 +1272,199 @@ void* viewerThread(void* id){
   GLenum err = glewInit();
   if (err != GLEW_OK) {
       fprintf(stderr, "GLEW initialization error: %s\n", glewGetErrorString(err));
+      atomic_store(&viewerEventsReady, 0);
       glfwDestroyWindow(window);
+      window = NULL;
       glfwTerminate();
-      viewerIsRunning = 0;
-      return NULL;
+      return 0;
   }
-    
+  return 1;
+}
+
+static void destroyViewerWindow(){
+  atomic_store(&viewerEventsReady, 0);
+  if(window){
+    glfwDestroyWindow(window);
+    window = NULL;
+  }
+  
+  glfwTerminate();
+}
+
+// EGL 오프스크린 컨텍스트와 FBO 생성 (X 서버 불필요)
+// 반환값: 성공 시 1, 실패 시 0
+static int createViewerOffscreen(){
+  printf("Initializing offscreen viewer (%dx%d)...\n", offscreenWidth, offscreenHeight);
+
+  // 고정 파이프라인을 사용하므로 호환 프로파일 (드라이버 기본값)
+  if(!createOffscreenContext(&offscreenContext, 0, 0, OFFSCREEN_PROFILE_COMPAT)){
+    return 0;
+  }
+
+  // GLX 디스플레이가 없어 GLEW 가 GLX 확장 초기화에 실패해도 GL 함수는 로드됨
+  GLenum err = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+  if(err == GLEW_ERROR_NO_GLX_DISPLAY){
+    err = GLEW_OK;
+  }
+#endif
+  if(err != GLEW_OK){
+    fprintf(stderr, "GLEW initialization error: %s\n", glewGetErrorString(err));
+    destroyOffscreenContext(&offscreenContext);
+    return 0;
+  }
+
+  if(!createOffscreenTarget(&offscreenTarget, offscreenWidth, offscreenHeight)){
+    destroyOffscreenContext(&offscreenContext);
+    return 0;
+  }
+  bindOffscreenTarget(&offscreenTarget);
+  readbackEnabled = 1;
+  return 1;
+}
+
+// Viewer Thread Function
+void* viewerThread(void* id){
+  int created = offscreenWidth > 0 ? createViewerOffscreen() : createViewerWindow();
+  if(!created){
+    viewerIsRunning = 0; // 초기화 실패 시 바로 실행 중지 플래그 설정
+    return NULL;
+  }
+
+  // 창 모드에서도 영상 콜백이 있으면 백 버퍼를 비동기로 읽음
+  if(!readbackEnabled && imageCallback){
+    readbackEnabled = createOffscreenTarget(&offscreenTarget, 0, 0);
+  }
+
   initOpenGL();
+  monitorRegisterThread(MONITOR_THREAD_VIEWER);
+  hudReady = createViewerHud();
+  initMonitorSampler(&hudSampler);
+  setMonitorSamplerPipeline(&hudSampler, viewerPipeline);
+  nextHudSample = 0.0;
+
+  if(!viewerMapOptionsSet){
+    setDefaultPointMapOptions(&viewerMapOptions);
+  }
+  mapReady = createViewerMap(&viewerMapOptions, requestRedraw);
 
   // OpenGL 상태 설정
   glEnable(GL_DEPTH_TEST);
   glEnable(GL_POINT_SMOOTH);
   glPointSize(2.0f);
 
-  // Set up initial perspective
-  int width, height;
-  glfwGetFramebufferSize(window, &width, &height);
-  framebuffer_size_callback(window, width, height);
-
   // Start Data Receiving Thread
   pthread_t receiveThreadId;
-  if(pthread_create(&receiveThreadId, NULL, dataReceiveThread, NULL) != 0){
+  int receiverStarted = pthread_create(&receiveThreadId, NULL, dataReceiveThread, NULL) == 0;
+  if(!receiverStarted){
     fprintf(stderr, "Failed to create data receive thread\n");
-    glfwDestroyWindow(window);
-    glfwTerminate();
     viewerIsRunning = 0;
-    return NULL;
   }
 
   // Main loop
-  while (viewerIsRunning && window && !glfwWindowShouldClose(window)) {
+  // 새 프레임이나 입력이 있을 때만 다시 그리고, 그 외에는 이벤트 대기 (유휴 시 CPU 사용 없음)
+  double nextDrawTime = 0.0;
+  while (viewerIsRunning && (offscreenWidth > 0 || (window && !glfwWindowShouldClose(window)))) {
+    if(!atomic_load_explicit(&redrawRequested, memory_order_acquire)){
+      // HUD 가 켜져 있으면 새 프레임이 없어도 통계 주기마다 다시 그림
+      double idleWait = VIEWER_IDLE_WAIT_SEC;
+      if(hudReady && atomic_load_explicit(&hudEnabled, memory_order_relaxed)){
+        idleWait = nextHudSample - viewerNow();
+        if(idleWait <= 0.0){
+          atomic_store_explicit(&redrawRequested, 1, memory_order_relaxed);
+          continue;
+        }
+        if(idleWait > VIEWER_IDLE_WAIT_SEC){
+          idleWait = VIEWER_IDLE_WAIT_SEC;
+        }
+      }
+
+      // 마지막 프레임의 읽기가 남아 있으면 짧게 대기하며 회수
+      if(readbackEnabled && offscreenTarget.pending > 0){
+        collectOffscreenReadbacks(&offscreenTarget, 0, imageCallback, imageCallbackData);
+        waitForViewerEvents(idleWait < 0.005 ? idleWait : 0.005);
+      }else{
+        waitForViewerEvents(idleWait);
+      }
+      continue;
+    }
+
+    // 최대 화면 갱신율 제한 (남은 시간 동안에도 입력 이벤트는 처리)
+    double now = viewerNow();
+    if(now < nextDrawTime){
+      waitForViewerEvents(nextDrawTime - now);
+      continue;
+    }
+
+    // 그리는 도중 들어온 요청은 다음 반복에서 처리되도록 먼저 플래그 해제
+    atomic_store_explicit(&redrawRequested, 0, memory_order_relaxed);
     display_3d_color();
-    glfwPollEvents();
+    if(window){
+      glfwPollEvents();
+    }
 
-    // 약간의 CPU 시간 양보
-    usleep(10000); // 10ms
+    int maxFps = atomic_load(&viewerMaxFps);
+    nextDrawTime = maxFps > 0 ? now + 1.0 / maxFps : 0.0;
   }
 
   printf("Exited viewer main loop, viewerIsRunning=%d, window=%p\n", viewerIsRunning, window);
 
   // 정리
   viewerIsRunning = 0;
-  pthread_join(receiveThreadId, NULL);
+  if(receiverStarted){
+    pthread_join(receiveThreadId, NULL);
+  }
+
+  if(readbackEnabled){
+    collectOffscreenReadbacks(&offscreenTarget, 1, imageCallback, imageCallbackData);
+    if(offscreenTarget.dropped){
+      printf("Viewer readback skipped %u frames\n", offscreenTarget.dropped);
+    }
+    destroyOffscreenTarget(&offscreenTarget);
+    readbackEnabled = 0;
+  }
   
-  pthread_mutex_lock(&dataMutex);
-  if(depthDataBuffer){
-    free(depthDataBuffer);
-    depthDataBuffer = NULL;
+  if(hudReady){
+    destroyViewerHud();
+    hudReady = 0;
   }
-  if(colorDataBuffer){
-    free(colorDataBuffer);
-    colorDataBuffer = NULL;
+  closeMonitorSampler(&hudSampler);
+  monitorUnregisterThread(MONITOR_THREAD_VIEWER);
+
+  if(mapReady){
+    destroyViewerMap();
+    mapReady = 0;
   }
 
-  if(window){
-    glfwDestroyWindow(window);
-    window = NULL;
+  if(pointCloudProgram){
+    glDeleteProgram(pointCloudProgram);
+    pointCloudProgram = 0;
+  }
+  glDeleteTextures(1, &depthTexture);
+  glDeleteTextures(1, &colorTexture);
+  glDeleteTextures(1, &rayTexture);
+  if(paneProgram){
+    glDeleteProgram(paneProgram);
+    paneProgram = 0;
+    glDeleteTextures(1, &depthLutTexture);
+  }
+  if(uploadPbo[0]){
+    glDeleteBuffers(UPLOAD_PBO_COUNT, uploadPbo);
+    memset(uploadPbo, 0, sizeof(uploadPbo));
+    memset(uploadPboSize, 0, sizeof(uploadPboSize));
+  }
+  destroyRayTable(&viewerRays);
+  freePointBuffer(&viewerPoints);
+  viewerRaysVersion = 0;
+  textureWidth = textureHeight = 0;
+
+  releaseFrameSlots();
+
+  if(offscreenWidth > 0){
+    destroyOffscreenContext(&offscreenContext);
+  }else{
+    destroyViewerWindow();
   }
-  
-  glfwTerminate();
 
   printf("Viewer thread terminated\n");
   return NULL;
@@ -585,6 +1480,7 @@ void initViewerModule(){
 void stopViewerModule(){
   printf("Stopping viewer module...\n");
   viewerIsRunning = 0;
+  requestRedraw(); // 이벤트 대기 중인 렌더링 루프 깨우기
 
   // 윈도우가 열려있다면 닫기 요청
   if(window){
@@ -604,4 +1500,5 @@ int isViewerModuleRunning(void){
 
 void requestStopViewerModule(){
   viewerIsRunning = 0;
+  requestRedraw();
 }
@@ -3,11 +3,76 @@
 
 #include <GL/glew.h>
 #include <GL/glut.h>
+#include "../KernelModule/kernelModule.h"
+#include "../OffscreenModule/offscreenModule.h"
+#include "../MapModule/mapModule.h"
 
 // viewerModule.h 에 콜백 타입 및 설정 함수 추가
 typedef void (*ExitCallbackFunc)(void);
 void setExitCallback(ExitCallbackFunc callback);
 
+// 카메라 내부 파라미터 설정 (프레임 해상도가 다르면 자동으로 스케일 조정)
+void setViewerIntrinsics(const CameraIntrinsics* intrinsics);
+
+// ORB-SLAM3 YAML 설정 파일에서 내부 파라미터 읽어 설정
+// 반환값: 성공 시 1, 실패 시 0 (기존 값 유지)
+int loadViewerIntrinsics(const char* yaml_file);
+
+// 화면 분할 사용 여부 (기본값 1, 실행 중 P 키로 전환)
+// 왼쪽 3D, 오른쪽 위 RGB / 아래 컬러맵 깊이 영상 (셰이더 경로에서만 지원)
+void setViewerPanes(int enabled);
+
+// 포인트 클라우드 그리기 경로 (initViewerModule 이전에 호출)
+// 1: 즉시 모드 (glBegin, 영상 화면 없음), 0: 셰이더, -1 (기본값): GL_RENDERER 가 llvmpipe 등 소프트웨어 렌더러면
+// 즉시 모드, 아니면 셰이더. 같은 장치에서 두 경로의 "Viewer redraw" 시간을 비교할 때 0 / 1 로 고정
+void setViewerImmediateMode(int mode);
+
+// 성능 HUD 표시 여부 (기본값 0, 실행 중 H 키로 전환)
+// 캡처/뷰어 FPS, 큐 길이, 드롭 프레임, 녹화 속도, SLAM 상태, 스레드별 CPU 사용률 (MonitorModule 카운터)
+void setViewerHud(int enabled);
+
+// 누적 지도 표시 여부 (기본값 0, 실행 중 M 키로 전환, C 키로 비우기)
+// 켜져 있는 동안 받은 프레임을 submitViewerPose 로 받은 자세로 월드 좌표에 누적하고 카메라를 따라가며 그림
+// 지도는 청크 단위 옥트리로 GPU 에 올려 절두체 컬링 + 거리 LOD 로 렌더링 예산 안에서 그림
+void setViewerMap(int enabled);
+
+// 누적 지도 옵션 (initViewerModule 이전에 호출, 기본값은 setDefaultPointMapOptions)
+void setViewerMapOptions(const PointMapOptions* options);
+
+// 카메라 자세 전달 (임의의 스레드, 예: SLAM 포즈 콜백)
+// timestamp: 프레임 헤더 타임스템프 (ms), Twc: 카메라 -> 월드 변환 (column-major 4x4)
+void submitViewerPose(uint32_t timestamp, const float* Twc);
+
+// 누적 지도 비우기
+void resetViewerMap(void);
+
+// 수신 프레임 콜백 (수신 스레드에서 프레임이 완성될 때마다 호출, NULL 이면 해제)
+// 버퍼는 콜백 안에서만 유효하므로 필요하면 복사
+typedef void (*ViewerFrameCallback)(const int16_t* depth, const uint8_t* color, int width, int height,
+                                    uint32_t timestamp, void* user_data);
+void setViewerFrameCallback(ViewerFrameCallback callback, void* user_data);
+
+// 최대 화면 갱신율 설정 (0 이면 제한 없음, 기본값)
+// 뷰어는 새 프레임이나 입력이 있을 때만 다시 그리므로 재생 중에는 데이터 속도를 따라감
+void setViewerMaxFps(int max_fps);
+
+// 수신할 파이프라인 이름 (initViewerModule 이전에 호출, NULL 또는 "" 이면 기본 큐)
+// 창과 GL 컨텍스트가 프로세스에 하나이므로 뷰어는 파이프라인 하나만 표시
+void setViewerPipeline(const char* pipeline);
+
+// 표시할 카메라 번호 (다중 카메라 파이프라인에서 다른 카메라 프레임은 건너뜀, 기본 0)
+// 뷰어 프레임 콜백과 누적 지도도 이 카메라 프레임만 사용
+void setViewerCamera(int camera_id);
+
+// 오프스크린 렌더링 모드 (initViewerModule 이전에 호출)
+// X 서버 없이 EGL 컨텍스트의 width x height FBO 에 렌더링, 0 이면 창 모드 (기본값)
+void setViewerOffscreen(int width, int height);
+
+// 렌더링된 영상 콜백 (initViewerModule 이전에 호출, NULL 이면 해제)
+// PBO 로 비동기로 읽어 몇 프레임 뒤에 렌더링 스레드에서 호출됨 (RGBA, 아래 행부터)
+// 창 모드에서도 사용 가능 (백 버퍼를 읽음)
+void setViewerImageCallback(OffscreenImageCallback callback, void* user_data);
+
 void initViewerModule();
 void stopViewerModule();
 void* viewerModule(void* id);
@@ -2,6 +2,7 @@
 #define FRAME_DEFINITIONS_H
 
 #include <stdint.h>
+#include <stdio.h>
 
 // 프레임 타입 정의
 #define FRAME_TYPE_DEPTH_COLOR 1
@@ -16,7 +17,8 @@ typedef struct{
   uint16_t height;    // 이미지 높이
   uint32_t depthDataSize; // 깊이 데이터 크기
   uint32_t colorDataSize; // 색상 데이터 크기
-  uint32_t reserved;      // 추가 정보를 위한 예약 필드
+  uint16_t cameraId;      // 카메라 번호 (다중 카메라, 이전 녹화 파일은 예약 필드였던 0)
+  uint16_t reserved;      // 추가 정보를 위한 예약 필드
 } FrameHeader;
 
 // 센서 데이터 메세지 구조체 (메세지 공유)
@@ -51,15 +53,47 @@ typedef struct{
   int dataSize; // 이 메세지의 데이터 크기
   int frameId;  // 프레임 식별자
   uint32_t timestamp; // 타임스템프
+  int cameraId; // 카메라 번호 (다중 카메라 묶음에서는 frameId 가 묶음 번호)
   int ctrlCommand;  // 제어 명령 (MSG_TYPE_CONTROL 에서 사용)
   char filename[256]; // 파일명 (제어 명령에서 사용)
 }MessageHeader;
 
-// 메세지 큐 이름 정의
+// 메세지 큐 이름 정의 (이름 없는 기본 파이프라인)
 #define MQ_SENSOR_TO_LOGGER "/sensor_logger_queue"
 #define MQ_LOGGER_TO_VIEWER "/logger_viewer_queue"
 #define MQ_CONTROL_QUEUE "/control_queue"
 
+// 파이프라인별 메세지 큐 이름
+// 파이프라인 (센서 -> 로거 -> 뷰어) 여러 개를 한 프로세스나 여러 프로세스에서 나란히 돌릴 때
+// 파이프라인 이름을 큐 이름 뒤에 붙여 구분 (예: "/sensor_logger_queue_cam1")
+#define MAX_PIPELINE_NAME 32
+#define MAX_QUEUE_NAME 64
+
+typedef struct{
+  char sensorToLogger[MAX_QUEUE_NAME];
+  char loggerToViewer[MAX_QUEUE_NAME];
+  char control[MAX_QUEUE_NAME];
+} PipelineQueueNames;
+
+// pipeline 이 NULL 이거나 빈 문자열이면 기본 큐 이름 (MQ_*)
+// 큐 이름에 쓸 수 없는 문자는 '_' 로 바꾸고 MAX_PIPELINE_NAME - 1 자까지만 사용
+static inline void makePipelineQueueNames(PipelineQueueNames* names, const char* pipeline){
+  char suffix[MAX_PIPELINE_NAME + 1] = "";
+  if(pipeline && pipeline[0]){
+    suffix[0] = '_';
+    int n = 0;
+    for(; pipeline[n] && n < MAX_PIPELINE_NAME - 1; ++n){
+      char c = pipeline[n];
+      int valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '_';
+      suffix[n + 1] = valid ? c : '_';
+    }
+    suffix[n + 1] = '\0';
+  }
+  snprintf(names->sensorToLogger, sizeof(names->sensorToLogger), "%s%s", MQ_SENSOR_TO_LOGGER, suffix);
+  snprintf(names->loggerToViewer, sizeof(names->loggerToViewer), "%s%s", MQ_LOGGER_TO_VIEWER, suffix);
+  snprintf(names->control, sizeof(names->control), "%s%s", MQ_CONTROL_QUEUE, suffix);
+}
+
 // 메세지 최대 크기
 #define MAX_MSG_SIZE 8192
 
@@ -15,6 +15,9 @@
 #include "SensorModule/sensorModule.h"
 #include "ViewerModule/viewerModule.h"
 #include "LoggingModule/loggingModule.h"
+#include "AlgorithmModule/SLAM.h"
+#include "StreamingModule/streamingModule.h"
+#include "TransportModule/transportModule.h"
 
 // 종료 시그널 핸들링
 volatile int keepRunning = 1;
@@ -44,6 +47,143 @@ void exitHandler(void){
   fflush(stdout);
 }
 
+// 오프스크린 모드 스냅샷 (렌더링 스레드에서 호출, 1초에 한 번 저장)
+static const char* snapshotFile = "viewer_snapshot.ppm";
+static void saveViewerSnapshot(const uint8_t* rgba, int width, int height, uint32_t frame_id, void* user_data){
+  static time_t lastSaved = 0;
+  time_t now = time(NULL);
+  if(now == lastSaved){
+    return;
+  }
+  lastSaved = now;
+  writeOffscreenImagePPM((const char*)user_data, rgba, width, height);
+}
+
+// --slam 모드: 뷰어가 받은 프레임으로 SLAM 추적, 추적된 자세로 뷰어 누적 지도 갱신
+static const char* slamConfigFile = "config/astra_orb_slam3_rgbd.yaml";
+static const char* slamVocabularyFile = NULL;
+
+static void forwardFrameToSlam(const int16_t* depth, const uint8_t* color, int width, int height, uint32_t timestamp,
+                               void* user_data){
+  processSlamFrame(depth, color, width, height, timestamp);
+}
+
+static void forwardSlamPose(double timestamp, int tracking_state, const float* Twc, float track_ms, void* user_data){
+  // 추적을 잃은 동안의 자세는 지도를 어지럽히므로 제외
+  if(tracking_state == SLAM_TRACKING_OK || tracking_state == SLAM_TRACKING_ICP_FALLBACK){
+    submitViewerPose((uint32_t)(timestamp * 1000.0 + 0.5), Twc);
+  }
+}
+
+// --stream 모드: 로거가 완성한 프레임을 포인트 클라우드 스트리밍 서버로 전달
+static int streamPort = 0;
+
+// --cameras 모드: 카메라 여러 대를 시간 맞춤 묶음으로 캡처 (녹화는 모든 카메라, 뷰어 / SLAM / 스트리밍은 주 카메라)
+static int cameraCount = 1;
+static int syntheticCameras = 0;
+static int primaryCamera = 0;
+
+// --depth-filter 모드: 캡처 직후 깊이 필터 체인 (설정 파일의 DepthFilter.xxx 항목으로 조정)
+static int depthFilterEnabled = 0;
+static const char* depthFilterStages = NULL;
+
+// --register 모드: 깊이를 색상 카메라 시점으로 정합 (설정 파일의 Depth.xx, DepthToColor.xx 항목)
+static int registerDepth = 0;
+
+// --undistort 모드: 캡처 직후 깊이 / 색상 렌즈 왜곡 보정 (설정 파일의 Camera.k1 ~ p2, Depth.k1 ~ p2 항목)
+static int undistortFrames = 0;
+
+// --capture / --roi / --decimate: Astra 스트림 모드, 전송 전 관심 영역 / 해상도 줄임
+// --record-decimate / --viewer-decimate / --stream-decimate: 소비자별 해상도 (로거가 한 번 줄여 나눠 줌)
+static const char* captureProfileName = NULL;
+static FrameRoi sensorRoi = {0, 0, 0, 0};
+static int sensorDecimation = 1;
+static int recordDecimation = 1;
+static int viewerDecimation = 1;
+static int streamDecimation = 1;
+static SensorCaptureProfile captureProfile;
+
+// 관심 영역을 잘라 보내면 주점이 옮겨지므로 소비자 내부 파라미터를 전송 해상도 기준으로 맞춤
+// (해상도 줄임만 있으면 소비자가 영상 크기 비율로 스케일 조정하므로 그대로 둠)
+static void transmittedIntrinsics(CameraIntrinsics* intrinsics){
+  if(sensorRoi.width <= 0 || sensorRoi.height <= 0){
+    return;
+  }
+  cropCameraIntrinsics(intrinsics, captureProfile.width, captureProfile.height, &sensorRoi, sensorDecimation,
+                       intrinsics);
+  printf("Transmitted intrinsics: fx %.2f fy %.2f cx %.2f cy %.2f (%dx%d)\n", intrinsics->fx, intrinsics->fy,
+         intrinsics->cx, intrinsics->cy, intrinsics->width, intrinsics->height);
+}
+
+// 배율 옵션 검사 (잘못된 값을 원본 해상도로 바꿔 계속하지 않고 시작 전에 멈춤)
+static int checkDecimationOption(const char* option, int factor){
+  if(decimationLevel(factor) < 0){
+    printf("Invalid %s %d, expected 1, 2, 4 or 8\n", option, factor);
+    return 0;
+  }
+  return 1;
+}
+
+// ORB-SLAM3 는 설정 파일의 내부 파라미터를 영상 크기와 상관없이 그대로 쓰므로
+// 캡처 모드 / 관심 영역 / 줄임으로 SLAM 이 받는 프레임 해상도가 설정 파일과 다르면 시작하지 않음
+// consumer_decimation: 로거가 SLAM 쪽 소비자 (뷰어 또는 원격 전송) 에 적용하는 배율
+static int checkSlamResolution(const char* mode, int consumer_decimation){
+  CameraIntrinsics config;
+  setDefaultCameraIntrinsics(&config, 640, 480);
+  loadCameraIntrinsics(slamConfigFile, &config);
+  CameraIntrinsics frame;
+  cropCameraIntrinsics(&config, captureProfile.width, captureProfile.height, &sensorRoi,
+                       sensorDecimation * consumer_decimation, &frame);
+  if(frame.width == config.width && frame.height == config.height){
+    return 1;
+  }
+  printf("%s tracks %dx%d frames but %s is for %dx%d\n", mode, frame.width, frame.height, slamConfigFile, config.width,
+         config.height);
+  printf("Use a SLAM config with Camera.fx %.2f fy %.2f cx %.2f cy %.2f width %d height %d, "
+         "or drop --capture / --roi / --decimate options for SLAM\n", frame.fx, frame.fy, frame.cx, frame.cy,
+         frame.width, frame.height);
+  return 0;
+}
+
+// --undistort 프레임은 이미 핀홀 영상인데 ORB-SLAM3 는 설정 파일의 Camera.k1 ~ k3 / p1 / p2 로 다시 왜곡 보정하므로
+// SLAM 설정 파일의 왜곡 계수가 0 이 아니면 시작하지 않음 (보정 후 내부 파라미터는 그대로)
+static int checkSlamDistortion(const char* mode){
+  DepthColorCalibration calibration;
+  setDefaultDepthColorCalibration(&calibration, 640, 480);
+  loadDepthColorCalibration(slamConfigFile, &calibration);
+  const LensDistortion* d = &calibration.colorDistortion;
+  if(d->k1 == 0.0f && d->k2 == 0.0f && d->p1 == 0.0f && d->p2 == 0.0f && d->k3 == 0.0f){
+    return 1;
+  }
+  const CameraIntrinsics* c = &calibration.color;
+  printf("%s with --undistort: %s has Camera.k1 %.4f k2 %.4f p1 %.4f p2 %.4f k3 %.4f, "
+         "SLAM would correct the undistorted frames again\n", mode, slamConfigFile, d->k1, d->k2, d->p1, d->p2, d->k3);
+  printf("Use a SLAM config with Camera.fx %.2f fy %.2f cx %.2f cy %.2f k1 0 k2 0 p1 0 p2 0 k3 0, "
+         "or drop --undistort for SLAM\n", c->fx, c->fy, c->cx, c->cy);
+  return 0;
+}
+
+// --offload 모드: 로거가 완성한 프레임을 원격 SlamReceiver 로 보내고, 돌아온 자세로 뷰어 누적 지도 갱신
+static char offloadHost[256] = "";
+static int offloadPort = TRANSPORT_DEFAULT_PORT;
+
+static void forwardLoggerFrame(const int16_t* depth, const uint8_t* color, int width, int height, uint32_t frame_id,
+                               uint32_t timestamp, int camera_id, void* user_data){
+  // 카메라 하나만 보는 소비자는 주 카메라 프레임만 사용
+  if(camera_id != primaryCamera){
+    return;
+  }
+  if(streamPort){
+    publishStreamingFrame(depth, color, width, height, frame_id, timestamp);
+  }
+  if(offloadHost[0]){
+    submitSenderFrame(depth, color, width, height, timestamp);
+  }
+}
+
+// --pipeline 모드: 메세지 큐 이름에 파이프라인 이름을 붙여 같은 머신에서 Youth 여러 개를 나란히 실행
+static const char* pipelineName = NULL;
+
 // 타이머 만료 시 호출될 함수
 void timer_handler(union sigval sv){
   printf("\nShutdown timeout occurred! Forcing exit...\n");
@@ -189,24 +329,28 @@ void setupShutdownTimer(int seconds){
 // 모든 메세지 큐 정리 - 안전한 버전
 void cleanupMessageQueues(){
   printf("Clean up all Message Queues\n");
+
+  // 이 프로세스 파이프라인의 큐만 제거 (다른 파이프라인 큐는 그대로)
+  PipelineQueueNames queues;
+  makePipelineQueueNames(&queues, pipelineName);
   
   // 각 메시지 큐를 안전하게 제거
   // 이미 제거된 큐에 대한 unlink는 에러를 반환하지만 무시함
-  if(mq_unlink(MQ_SENSOR_TO_LOGGER) == -1) {
+  if(mq_unlink(queues.sensorToLogger) == -1) {
     if(errno != ENOENT) { // ENOENT는 "존재하지 않음" 에러
-      perror("mq_unlink MQ_SENSOR_TO_LOGGER failed");
+      perror("mq_unlink sensor -> logger queue failed");
     }
   }
   
-  if(mq_unlink(MQ_LOGGER_TO_VIEWER) == -1) {
+  if(mq_unlink(queues.loggerToViewer) == -1) {
     if(errno != ENOENT) {
-      perror("mq_unlink MQ_LOGGER_TO_VIEWER failed");
+      perror("mq_unlink logger -> viewer queue failed");
     }
   }
   
-  if(mq_unlink(MQ_CONTROL_QUEUE) == -1) {
+  if(mq_unlink(queues.control) == -1) {
     if(errno != ENOENT) {
-      perror("mq_unlink MQ_CONTROL_QUEUE failed");
+      perror("mq_unlink control queue failed");
     }
   }
   
@@ -231,8 +375,21 @@ void safeShutdown(){
   // 모듈 종료 요청 (역순)
   stopViewerModule();
 
+  if(slamVocabularyFile){
+    stopSlamModule();
+  }
+
   stopLoggingModule();  // 원래 코드에서는 잘못된 stopSensorModule()을 호출함
 
+  // 로거 / 재생 스레드가 끝난 뒤 스트리밍 서버 / 원격 전송 종료
+  setLoggerFrameCallback(NULL, NULL);
+  if(streamPort){
+    stopStreamingModule();
+  }
+  if(offloadHost[0]){
+    stopFrameSender();
+  }
+
   stopSensorModule();
 
   // 타이머 취소
@@ -247,6 +404,174 @@ void safeShutdown(){
 int main(int argc, char** argv)
 {
   printf("Starting Youth\n");
+
+  // --offscreen [snapshot.ppm]: 디스플레이 없이 렌더링하고 스냅샷 저장
+  for(int i = 1; i < argc; ++i){
+    if(strcmp(argv[i], "--offscreen") == 0){
+      if(i + 1 < argc && argv[i + 1][0] != '-'){
+        snapshotFile = argv[++i];
+      }
+      setViewerOffscreen(1280, 720);
+      setViewerImageCallback(saveViewerSnapshot, (void*)snapshotFile);
+      printf("Offscreen viewer, snapshots to %s\n", snapshotFile);
+    }else if(strcmp(argv[i], "--immediate") == 0){
+      // --immediate: 포인트 클라우드를 즉시 모드로 그림 (셰이더 경로와 redraw 시간 비교용)
+      setViewerImmediateMode(1);
+    }else if(strcmp(argv[i], "--shader") == 0){
+      // --shader: 소프트웨어 렌더러에서도 셰이더 경로로 그림 (기본은 렌더러에 따라 결정)
+      setViewerImmediateMode(0);
+    }else if(strcmp(argv[i], "--slam") == 0 && i + 1 < argc){
+      // --slam <ORBvoc.txt>: SLAM 추적 자세로 누적 지도 표시
+      slamVocabularyFile = argv[++i];
+    }else if(strcmp(argv[i], "--stream") == 0){
+      // --stream [port]: 브라우저용 바이너리 포인트 클라우드 스트리밍 (기본 8090)
+      streamPort = 8090;
+      if(i + 1 < argc && argv[i + 1][0] != '-'){
+        streamPort = atoi(argv[++i]);
+      }
+    }else if(strcmp(argv[i], "--offload") == 0 && i + 1 < argc){
+      // --offload <host[:port]>: SLAM 을 원격 SlamReceiver 에서 실행 (기본 포트 8091)
+      snprintf(offloadHost, sizeof(offloadHost), "%s", argv[++i]);
+      char* port = strrchr(offloadHost, ':');
+      if(port){
+        *port = '\0';
+        offloadPort = atoi(port + 1);
+      }
+    }else if(strcmp(argv[i], "--pipeline") == 0 && i + 1 < argc){
+      // --pipeline <name>: 파이프라인 이름 (메세지 큐 이름 구분)
+      pipelineName = argv[++i];
+    }else if(strcmp(argv[i], "--cameras") == 0 && i + 1 < argc){
+      // --cameras <n>: Astra 여러 대 동시 캡처 (device/sensor0 ...)
+      cameraCount = atoi(argv[++i]);
+    }else if(strcmp(argv[i], "--synthetic") == 0){
+      // --synthetic: Astra 대신 합성 카메라
+      syntheticCameras = 1;
+    }else if(strcmp(argv[i], "--camera") == 0 && i + 1 < argc){
+      // --camera <id>: 뷰어 / SLAM / 스트리밍에 쓸 주 카메라 (기본 0)
+      primaryCamera = atoi(argv[++i]);
+    }else if(strcmp(argv[i], "--depth-filter") == 0){
+      // --depth-filter [range,speckle,spatial,temporal,holes]: 센서 깊이 필터 (기본 전체 또는 설정 파일 값)
+      depthFilterEnabled = 1;
+      if(i + 1 < argc && argv[i + 1][0] != '-'){
+        depthFilterStages = argv[++i];
+      }
+    }else if(strcmp(argv[i], "--register") == 0){
+      // --register: 깊이 -> 색상 정합 (뷰어 색상 / SLAM RGB-D 쌍의 경계 어긋남 보정)
+      registerDepth = 1;
+    }else if(strcmp(argv[i], "--undistort") == 0){
+      // --undistort: 렌즈 왜곡 보정 (이후 역투영 / 정합 / SLAM 이 핀홀 모델로 계산)
+      undistortFrames = 1;
+    }else if(strcmp(argv[i], "--capture") == 0 && i + 1 < argc){
+      // --capture <vga|qvga|qvga60>: Astra 깊이 / 색상 스트림 모드
+      captureProfileName = argv[++i];
+    }else if(strcmp(argv[i], "--roi") == 0 && i + 1 < argc){
+      // --roi <x,y,w,h>: 캡처 해상도 기준 관심 영역만 전송
+      if(sscanf(argv[++i], "%d,%d,%d,%d", &sensorRoi.x, &sensorRoi.y, &sensorRoi.width, &sensorRoi.height) != 4 ||
+         sensorRoi.width <= 0 || sensorRoi.height <= 0){
+        printf("Invalid --roi %s, expected x,y,w,h with positive size\n", argv[i]);
+        return 1;
+      }
+    }else if(strcmp(argv[i], "--decimate") == 0 && i + 1 < argc){
+      // --decimate <1|2|4|8>: 센서에서 줄여 전송 (모든 소비자의 최대 해상도)
+      sensorDecimation = atoi(argv[++i]);
+    }else if(strcmp(argv[i], "--record-decimate") == 0 && i + 1 < argc){
+      recordDecimation = atoi(argv[++i]);
+    }else if(strcmp(argv[i], "--viewer-decimate") == 0 && i + 1 < argc){
+      viewerDecimation = atoi(argv[++i]);
+    }else if(strcmp(argv[i], "--stream-decimate") == 0 && i + 1 < argc){
+      // --stream-decimate <n>: 스트리밍 / 원격 SLAM 으로 보내는 프레임 해상도
+      streamDecimation = atoi(argv[++i]);
+    }
+  }
+  if(!checkDecimationOption("--decimate", sensorDecimation) ||
+     !checkDecimationOption("--record-decimate", recordDecimation) ||
+     !checkDecimationOption("--viewer-decimate", viewerDecimation) ||
+     !checkDecimationOption("--stream-decimate", streamDecimation)){
+    return 1;
+  }
+
+  LoggingOptions loggingOptions;
+  setDefaultLoggingOptions(&loggingOptions);
+  loggingOptions.pipeline = pipelineName;
+  loggingOptions.recordDecimation = recordDecimation;
+  loggingOptions.viewerDecimation = viewerDecimation;
+  loggingOptions.callbackDecimation = streamDecimation;
+  setLoggingModuleOptions(&loggingOptions);
+  if(pipelineName){
+    setViewerPipeline(pipelineName);
+    printf("Pipeline %s\n", pipelineName);
+  }
+  if(recordDecimation > 1 || viewerDecimation > 1 || streamDecimation > 1){
+    printf("Consumer decimation: record 1/%d, viewer 1/%d, stream 1/%d\n", recordDecimation, viewerDecimation,
+           streamDecimation);
+  }
+
+  SensorOptions sensorOptions;
+  setDefaultSensorOptions(&sensorOptions);
+  sensorOptions.pipeline = pipelineName;
+  sensorOptions.cameraCount = cameraCount;
+  sensorOptions.synthetic = syntheticCameras;
+  if(captureProfileName && !findSensorCaptureProfile(captureProfileName, &sensorOptions.capture)){
+    printf("Unknown capture profile %s, expected vga, qvga or qvga60\n", captureProfileName);
+    return 1;
+  }
+  captureProfile = sensorOptions.capture;
+  FrameRoi clampedRoi;
+  if(sensorRoi.width > 0 && !clampFrameRoi(&sensorRoi, captureProfile.width, captureProfile.height, &clampedRoi)){
+    printf("--roi %d,%d %dx%d is outside the %dx%d capture\n", sensorRoi.x, sensorRoi.y, sensorRoi.width,
+           sensorRoi.height, captureProfile.width, captureProfile.height);
+    return 1;
+  }
+
+  // 원격 SLAM 은 스트리밍 배율, 같은 프로세스 SLAM 은 뷰어 배율의 프레임을 받음 (--offload 가 --slam 보다 우선)
+  // 원격 SlamReceiver 도 같은 설정 파일 (--config 기본값) 을 쓴다고 보고 검사
+  if(offloadHost[0] && !checkSlamResolution("--offload", streamDecimation)){
+    return 1;
+  }
+  if(!offloadHost[0] && slamVocabularyFile && !checkSlamResolution("--slam", viewerDecimation)){
+    return 1;
+  }
+  if(undistortFrames && (offloadHost[0] || slamVocabularyFile) &&
+     !checkSlamDistortion(offloadHost[0] ? "--offload" : "--slam")){
+    return 1;
+  }
+  sensorOptions.roi = sensorRoi;
+  sensorOptions.decimation = sensorDecimation;
+  printf("Capture %s %dx%d@%d", sensorOptions.capture.name, sensorOptions.capture.width, sensorOptions.capture.height,
+         sensorOptions.capture.fps);
+  if(sensorRoi.width > 0 || sensorDecimation > 1){
+    printf(", roi %d,%d %dx%d, 1/%d", sensorRoi.x, sensorRoi.y, sensorRoi.width, sensorRoi.height, sensorDecimation);
+  }
+  printf("\n");
+  if(depthFilterEnabled){
+    setDefaultDepthFilterOptions(&sensorOptions.depthFilter);
+    loadDepthFilterOptions(slamConfigFile, &sensorOptions.depthFilter);
+    if(depthFilterStages){
+      sensorOptions.depthFilter.stages = parseDepthFilterStages(depthFilterStages);
+    }
+    printf("Depth filter stages 0x%02x, range %d~%d mm\n", sensorOptions.depthFilter.stages,
+           sensorOptions.depthFilter.minDepth, sensorOptions.depthFilter.maxDepth);
+  }
+  if(registerDepth || undistortFrames){
+    if(!loadDepthColorCalibration(slamConfigFile, &sensorOptions.calibration)){
+      printf("Using default depth / color calibration\n");
+    }
+  }
+  if(undistortFrames){
+    const DepthColorCalibration* calibration = &sensorOptions.calibration;
+    sensorOptions.undistort = 1;
+    printf("Undistort: color k1 %.4f k2 %.4f p1 %.4f p2 %.4f, depth k1 %.4f k2 %.4f p1 %.4f p2 %.4f\n",
+           calibration->colorDistortion.k1, calibration->colorDistortion.k2, calibration->colorDistortion.p1,
+           calibration->colorDistortion.p2, calibration->depthDistortion.k1, calibration->depthDistortion.k2,
+           calibration->depthDistortion.p1, calibration->depthDistortion.p2);
+  }
+  if(registerDepth){
+    sensorOptions.registerDepth = 1;
+    printf("Depth registration: t %.4f %.4f %.4f m\n", sensorOptions.calibration.translation[0],
+           sensorOptions.calibration.translation[1], sensorOptions.calibration.translation[2]);
+  }
+  setSensorModuleOptions(&sensorOptions);
+  setViewerCamera(primaryCamera);
   
   // 종료 시그널 핸들러 등록
   struct sigaction sa;
@@ -262,6 +587,42 @@ int main(int argc, char** argv)
   // 로깅 모듈 초기화 (먼저 초기화하여 메세지 큐 생성)
   initLoggingModule();
 
+  if(streamPort){
+    StreamingOptions streamOptions;
+    setDefaultStreamingOptions(&streamOptions);
+    streamOptions.port = streamPort;
+
+    CameraIntrinsics intrinsics;
+    setDefaultCameraIntrinsics(&intrinsics, 640, 480);
+    if(loadCameraIntrinsics("config/astra_orb_slam3_rgbd.yaml", &intrinsics)){
+      transmittedIntrinsics(&intrinsics);
+      setStreamingIntrinsics(&intrinsics);
+    }
+
+    if(!initStreamingModule(&streamOptions)){
+      printf("Point cloud streaming failed to start, continuing without it\n");
+      streamPort = 0;
+    }
+  }
+
+  if(offloadHost[0]){
+    if(slamVocabularyFile){
+      printf("--offload runs SLAM remotely, ignoring --slam\n");
+      slamVocabularyFile = NULL;
+    }
+    if(initFrameSender(offloadHost, offloadPort, NULL)){
+      setSenderPoseCallback(forwardSlamPose, NULL);
+      setViewerMap(1);
+    }else{
+      printf("SLAM receiver unreachable, running without map\n");
+      offloadHost[0] = '\0';
+    }
+  }
+
+  if(streamPort || offloadHost[0]){
+    setLoggerFrameCallback(forwardLoggerFrame, NULL);
+  }
+
   // 약간의 지연 후 다른 모듈 초기화
   usleep(200000); // 0.1초
 
@@ -284,6 +645,31 @@ int main(int argc, char** argv)
   // 약간의 지연 후 뷰어 모듈 초기화 (센서가 준비되도록)
   usleep(200000);
 
+  // 보정된 카메라 내부 파라미터 사용 (파일이 없으면 Astra 기본값)
+  if(!loadViewerIntrinsics("config/astra_orb_slam3_rgbd.yaml")) {
+    printf("Using default viewer intrinsics\n");
+  }
+  if(sensorRoi.width > 0){
+    CameraIntrinsics intrinsics;
+    setDefaultCameraIntrinsics(&intrinsics, 640, 480);
+    loadCameraIntrinsics("config/astra_orb_slam3_rgbd.yaml", &intrinsics);
+    transmittedIntrinsics(&intrinsics);
+    setViewerIntrinsics(&intrinsics);
+  }
+
+  if(slamVocabularyFile){
+    setSlamVisualization(0);
+    initSlamModule(slamConfigFile, slamVocabularyFile);
+    if(isSlamModuleRunning()){
+      setSlamPoseCallback(forwardSlamPose, NULL);
+      setViewerFrameCallback(forwardFrameToSlam, NULL);
+      setViewerMap(1);
+    }else{
+      printf("SLAM failed to initialize, running without map\n");
+      slamVocabularyFile = NULL;
+    }
+  }
+
   initViewerModule();
 
   // 종료 콜백 설정
@@ -0,0 +1,82 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace Youth {
+
+// One depth + color frame as produced by the Youth.Source pipeline.
+// The pointers are only valid for the duration of the callback.
+struct DepthColorFrame {
+    uint32_t frame_id = 0;
+    uint32_t timestamp = 0;  // ms
+    int width = 0;
+    int height = 0;
+    const uint16_t* depth = nullptr;
+    const uint8_t* rgb = nullptr;
+};
+
+using FrameCallback = std::function<void(const DepthColorFrame&)>;
+
+// Delivers frames on a background thread until stopped.
+class FrameSource {
+public:
+    virtual ~FrameSource();
+
+    FrameSource(const FrameSource&) = delete;
+    FrameSource& operator=(const FrameSource&) = delete;
+
+    bool start(FrameCallback callback);
+    void stop();
+    bool running() const noexcept { return running_.load(); }
+
+protected:
+    FrameSource() = default;
+
+    // Runs on the source thread; returns when running_ is cleared or the source ends.
+    virtual void loop() = 0;
+    virtual bool open() = 0;
+
+    std::atomic<bool> running_{false};
+    FrameCallback callback_;
+
+private:
+    std::thread thread_;
+};
+
+// Plays back a recording written by LoggingModule (.bin), paced by the recorded timestamps.
+class RecordingSource : public FrameSource {
+public:
+    explicit RecordingSource(std::string path, bool loop_playback = true);
+    ~RecordingSource() override;
+
+private:
+    bool open() override;
+    void loop() override;
+
+    std::string path_;
+    bool loop_playback_;
+    std::FILE* file_ = nullptr;
+};
+
+// Attaches to the logger -> viewer message queue of a running pipeline and reassembles chunked frames.
+// pipeline selects the queue the same way as Youth.Source --pipeline (empty for the default queue).
+// The legacy viewer reads the same queue, so only one of them should run per pipeline.
+class QueueSource : public FrameSource {
+public:
+    explicit QueueSource(std::string pipeline = {});
+    ~QueueSource() override;
+
+private:
+    bool open() override;
+    void loop() override;
+
+    std::string pipeline_;
+    int queue_ = -1;
+};
+
+} // namespace Youth
@@ -0,0 +1,82 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "kernelModule.h"
+
+namespace Youth {
+
+// Renders an RGB-D stream as a colored point cloud.
+//
+// Frames are unprojected and compacted on the submitting thread (KernelModule
+// SIMD kernel), so the render thread only streams the valid points into a
+// vertex buffer and issues a single draw. On software rasterizers (llvmpipe)
+// per-point setup dominates, so frames are decimated to a point budget.
+class PointCloudLayer {
+public:
+    struct Options {
+        float min_depth = 0.2f;   // meters
+        float max_depth = 8.0f;   // meters
+        float point_size = 1.0f;  // pixels
+        // Upper bound on pixels unprojected per frame; larger frames are decimated
+        // by an integer stride. 0 = no limit (the default on hardware renderers).
+        std::size_t max_points = 0;
+        bool visible = true;
+    };
+
+    // Requires the owning viewer's GL context to be current.
+    PointCloudLayer();
+    ~PointCloudLayer();
+
+    PointCloudLayer(const PointCloudLayer&) = delete;
+    PointCloudLayer& operator=(const PointCloudLayer&) = delete;
+
+    // Thread-safe. Takes effect from the next submitted frame.
+    void setIntrinsics(const CameraIntrinsics& intrinsics);
+    void setOptions(const Options& options);
+    Options options() const;
+
+    // Thread-safe. depth: 16-bit depth (depthFactor units), rgb: 3 bytes per pixel
+    // (may be null). The data is consumed before returning.
+    void submitFrame(const uint16_t* depth, const uint8_t* rgb, int width, int height);
+
+    // Render thread only. view_proj: column-major 4x4.
+    void draw(const float* view_proj);
+
+    // Points in the frame currently on the GPU.
+    std::size_t pointCount() const noexcept { return gpu_count_; }
+
+private:
+    void upload(const PointBuffer& points);
+
+    mutable std::mutex config_mutex_;
+    CameraIntrinsics intrinsics_;
+    Options options_;
+    unsigned intrinsics_version_ = 1;
+
+    // Producer side (serialized by submit_mutex_).
+    std::mutex submit_mutex_;
+    RayTable rays_ = {};
+    unsigned rays_version_ = 0;
+    int rays_stride_ = 0;
+    PointBuffer back_ = {};
+    std::vector<uint16_t> decimated_depth_;
+    std::vector<uint8_t> decimated_rgb_;
+
+    // Hand-off between producer and render thread; only the swap is locked.
+    std::mutex pending_mutex_;
+    PointBuffer pending_ = {};
+    bool pending_new_ = false;
+
+    // Render thread only.
+    PointBuffer front_ = {};
+    unsigned vao_ = 0, vbo_ = 0;
+    unsigned program_ = 0;
+    int view_proj_loc_ = -1;
+    std::size_t gpu_capacity_ = 0;
+    std::size_t gpu_count_ = 0;
+};
+
+} // namespace Youth
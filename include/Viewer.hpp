@@ -1,11 +1,20 @@
 #pragma once
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <string>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 struct GLFWwindow;
 
 namespace Youth{
 
+class PointCloudLayer;
+
 struct ClearColor {
     float r = 0.1f, g = 0.1f, b = 0.12f, a = 1.0f;
 };
@@ -17,31 +26,98 @@ public:
         int height = 720;
         std::string title = "Youth Viewer";
         bool vsync = true;
+        // Redraw only after requestRedraw() or input instead of every vsync.
+        bool redraw_on_demand = true;
+        // Render into a width x height FBO on an EGL surfaceless context (no display needed).
+        bool offscreen = false;
         ClearColor clear;
     };
 
+    // Orbit camera around a pivot in front of the sensor.
+    struct Camera {
+        float yaw = 0.0f;       // degrees
+        float pitch = 0.0f;     // degrees
+        float distance = 1.5f;  // meters from the pivot
+        float pivot = 1.5f;     // meters in front of the sensor
+        float fov_y = 45.0f;    // degrees
+    };
+
     explicit Viewer(const Config& cfg);
     ~Viewer();
 
     Viewer(const Viewer&) = delete;
     Viewer& operator=(const Viewer&) = delete;
 
-    bool ok( )const noexcept { return window_ != nullptr;}
+    // Rendered image, RGBA with rows bottom-to-top; pointer valid only during the call.
+    using FrameCallback = std::function<void(const uint8_t* rgba, int width, int height, uint32_t frame)>;
+
+    bool ok( )const noexcept { return window_ != nullptr || offscreen_ != nullptr;}
     void run();
 
+    // Renders one frame now (run() calls this). Render thread only.
+    void renderFrame();
+
+    // Thread-safe. Makes run() return (offscreen mode has no window to close).
+    void requestClose();
+
+    // Receive rendered frames through an asynchronous PBO readback ring; frames arrive a
+    // few renders late and are skipped rather than stalling when the ring is full.
+    void setFrameCallback(FrameCallback callback);
+    // Blocks until all queued readbacks have been delivered. Render thread only.
+    void finishReadbacks();
+    uint32_t droppedReadbacks() const noexcept;
+
     void setDrawCallback(std::function<void()> callback) { draw_callback_ = std::move(callback); }
 
+    // Creates a point-cloud layer owned by the viewer (GPU buffers live as long as the viewer).
+    // Frames may be submitted to the layer from any thread; call requestRedraw() afterwards.
+    PointCloudLayer& addPointCloudLayer();
+
+    // Thread-safe. Wakes the render loop when redraw_on_demand is set.
+    void requestRedraw();
+
+    // Column-major view-projection of the current camera and framebuffer.
+    const std::array<float, 16>& viewProjection() const noexcept { return view_proj_; }
+
+    Camera& camera() noexcept { return camera_; }
+
 private:
+    struct Offscreen;
+
     bool initGLFW();
+    bool initOffscreen();
     bool initGLEW();
+    bool shouldClose();
+    void waitEvents(double timeout);
+    void framebufferSize(int& width, int& height);
     void drawTriangle();
     void poll();
+    void updateViewProjection(int fbw, int fbh);
+
+    static void cursorPosCallback(GLFWwindow* window, double x, double y);
+    static void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
+    static void scrollCallback(GLFWwindow* window, double dx, double dy);
 
     Config cfg_;
     GLFWwindow* window_ = nullptr;
     unsigned vao_ = 0, vbo_ = 0;
     unsigned shader_prog_ = 0;
     std::function<void()> draw_callback_ = {};
+
+    std::vector<std::unique_ptr<PointCloudLayer>> layers_;
+    Camera camera_;
+    std::array<float, 16> view_proj_ = {};
+    std::atomic<bool> redraw_requested_{true};
+    std::atomic<bool> close_requested_{false};
+    std::mutex redraw_mutex_;
+    std::condition_variable redraw_cv_;
+
+    std::unique_ptr<Offscreen> offscreen_;   // EGL context + FBO (offscreen mode)
+    std::unique_ptr<Offscreen> readback_;    // PBO ring for the window back buffer
+    FrameCallback frame_callback_ = {};
+    uint32_t frame_index_ = 0;
+    bool dragging_ = false;
+    double last_x_ = 0.0, last_y_ = 0.0;
 };
 
 } // namespace Youth
\ No newline at end of file
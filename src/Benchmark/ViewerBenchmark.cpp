@@ -0,0 +1,112 @@
+// Headless render benchmark: synthetic RGB-D frames through PointCloudLayer into an
+// offscreen Viewer (EGL surfaceless + FBO), with PBO readback. Runs without a display,
+// e.g. on CI under Mesa llvmpipe.
+#include "Viewer.hpp"
+#include "PointCloudLayer.hpp"
+#include "offscreenModule.h"
+
+#include <GL/glew.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+double seconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Tilted wavy wall with a hole pattern (~15% invalid pixels), changing every frame.
+void makeFrame(int frame, int width, int height, std::vector<uint16_t>& depth, std::vector<uint8_t>& rgb) {
+    const float phase = frame * 0.1f;
+    for (int v = 0; v < height; ++v) {
+        for (int u = 0; u < width; ++u) {
+            const std::size_t i = static_cast<std::size_t>(v) * width + u;
+            const bool hole = ((u / 24 + v / 24 + frame / 10) % 7) == 0;
+            const float z = 1.5f + 0.3f * std::sin(u * 0.02f + phase) + 0.001f * v;
+            depth[i] = hole ? 0 : static_cast<uint16_t>(z * 1000.0f);
+            rgb[i * 3] = static_cast<uint8_t>(u * 255 / width);
+            rgb[i * 3 + 1] = static_cast<uint8_t>(v * 255 / height);
+            rgb[i * 3 + 2] = static_cast<uint8_t>(128 + 127 * std::sin(phase));
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 200;
+    const int width = argc > 2 ? std::atoi(argv[2]) : 1280;
+    const int height = argc > 3 ? std::atoi(argv[3]) : 720;
+    const std::string output = argc > 4 ? argv[4] : "";
+    const int depth_width = 640, depth_height = 480;
+
+    try {
+        Youth::Viewer::Config config;
+        config.width = width;
+        config.height = height;
+        config.offscreen = true;
+        Youth::Viewer viewer(config);
+        if (!viewer.ok()) {
+            std::fprintf(stderr, "Failed to create offscreen viewer\n");
+            return 1;
+        }
+
+        Youth::PointCloudLayer& cloud = viewer.addPointCloudLayer();
+
+        int delivered = 0;
+        long latency_total = 0;
+        uint32_t rendered = 0;
+        viewer.setFrameCallback([&](const uint8_t* rgba, int w, int h, uint32_t frame) {
+            ++delivered;
+            latency_total += static_cast<long>(rendered - frame);
+            if (!output.empty() && frame + 1 == static_cast<uint32_t>(frames)) {
+                writeOffscreenImagePPM(output.c_str(), rgba, w, h);
+            }
+        });
+
+        std::vector<uint16_t> depth(static_cast<std::size_t>(depth_width) * depth_height);
+        std::vector<uint8_t> rgb(depth.size() * 3);
+
+        double submit_seconds = 0.0, render_seconds = 0.0;
+        std::size_t points = 0;
+        const double start = seconds();
+        for (int i = 0; i < frames; ++i) {
+            makeFrame(i, depth_width, depth_height, depth, rgb);
+
+            double t0 = seconds();
+            cloud.submitFrame(depth.data(), rgb.data(), depth_width, depth_height);
+            double t1 = seconds();
+            viewer.camera().yaw = 20.0f * std::sin(i * 0.05f);
+            viewer.renderFrame();
+            ++rendered;
+            double t2 = seconds();
+
+            submit_seconds += t1 - t0;
+            render_seconds += t2 - t1;
+            points += cloud.pointCount();
+        }
+        viewer.finishReadbacks();
+        const double total = seconds() - start;
+
+        std::printf("Renderer       : %s\n", glGetString(GL_RENDERER));
+        std::printf("Target         : %dx%d, depth %dx%d, %d frames\n", width, height, depth_width, depth_height,
+                    frames);
+        std::printf("Points/frame   : %.0f\n", frames ? static_cast<double>(points) / frames : 0.0);
+        std::printf("Submit         : %.2f ms/frame (unproject + compact)\n", submit_seconds * 1000.0 / frames);
+        std::printf("Render         : %.2f ms/frame (upload + draw + readback issue)\n",
+                    render_seconds * 1000.0 / frames);
+        std::printf("Throughput     : %.1f fps\n", frames / total);
+        std::printf("Readback       : %d delivered, %u skipped, %.1f frames latency\n", delivered,
+                    viewer.droppedReadbacks(), delivered ? static_cast<double>(latency_total) / delivered : 0.0);
+
+        return delivered > 0 ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "Fatal: %s\n", e.what());
+        return 2;
+    }
+}
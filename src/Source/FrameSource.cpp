@@ -0,0 +1,224 @@
+#include "FrameSource.hpp"
+#include "frameDefinitions.h"
+
+#include <fcntl.h>
+#include <mqueue.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <utility>
+#include <vector>
+
+namespace Youth {
+
+FrameSource::~FrameSource() = default;
+
+bool FrameSource::start(FrameCallback callback) {
+    if (running_.load()) return true;
+    if (!open()) return false;
+    callback_ = std::move(callback);
+    running_.store(true);
+    thread_ = std::thread([this] {
+        loop();
+        running_.store(false);
+    });
+    return true;
+}
+
+void FrameSource::stop() {
+    running_.store(false);
+    if (thread_.joinable()) thread_.join();
+}
+
+// RecordingSource ------------------------------------------------------------
+
+RecordingSource::RecordingSource(std::string path, bool loop_playback)
+    : path_(std::move(path)), loop_playback_(loop_playback) {}
+
+RecordingSource::~RecordingSource() {
+    stop();
+    if (file_) std::fclose(file_);
+}
+
+bool RecordingSource::open() {
+    if (file_) std::fclose(file_);
+    file_ = std::fopen(path_.c_str(), "rb");
+    if (!file_) {
+        std::fprintf(stderr, "[RecordingSource] Failed to open %s: %s\n", path_.c_str(), std::strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+void RecordingSource::loop() {
+    using Clock = std::chrono::steady_clock;
+    std::vector<uint16_t> depth;
+    std::vector<uint8_t> rgb;
+
+    bool have_base = false;
+    uint32_t base_timestamp = 0;
+    Clock::time_point base_time;
+    uint32_t frames = 0;
+
+    while (running_.load()) {
+        FrameHeader header;
+        if (std::fread(&header, sizeof(header), 1, file_) != 1 || header.frameType == FRAME_TYPE_END_OF_FILE) {
+            std::fprintf(stdout, "[RecordingSource] End of %s (%u frames)\n", path_.c_str(), frames);
+            if (!loop_playback_ || frames == 0) break;
+            std::rewind(file_);
+            have_base = false;
+            frames = 0;
+            continue;
+        }
+
+        const std::size_t pixels = static_cast<std::size_t>(header.width) * header.height;
+        if (header.frameType != FRAME_TYPE_DEPTH_COLOR || header.depthDataSize < pixels * sizeof(uint16_t) ||
+            header.colorDataSize < pixels * 3) {
+            std::fprintf(stderr, "[RecordingSource] Skipping malformed frame %u\n", header.frameId);
+            if (std::fseek(file_, static_cast<long>(header.depthDataSize) + header.colorDataSize, SEEK_CUR) != 0) break;
+            continue;
+        }
+
+        // Multi-camera recordings interleave cameras; this source replays the first camera only.
+        if (header.cameraId != 0) {
+            if (std::fseek(file_, static_cast<long>(header.depthDataSize) + header.colorDataSize, SEEK_CUR) != 0) break;
+            continue;
+        }
+
+        depth.resize((header.depthDataSize + 1) / 2);
+        rgb.resize(header.colorDataSize);
+        if (std::fread(depth.data(), 1, header.depthDataSize, file_) != header.depthDataSize ||
+            std::fread(rgb.data(), 1, header.colorDataSize, file_) != header.colorDataSize) {
+            std::fprintf(stderr, "[RecordingSource] Truncated frame %u\n", header.frameId);
+            if (loop_playback_ && frames > 0) {
+                std::rewind(file_);
+                have_base = false;
+                frames = 0;
+                continue;
+            }
+            break;
+        }
+
+        // Pace by recorded timestamps; re-anchor on wrap-around or long gaps.
+        const Clock::time_point now = Clock::now();
+        if (!have_base || header.timestamp < base_timestamp ||
+            header.timestamp - base_timestamp > 1000u + std::chrono::duration_cast<std::chrono::milliseconds>(
+                                                            now - base_time).count()) {
+            have_base = true;
+            base_timestamp = header.timestamp;
+            base_time = now;
+        }
+        const Clock::time_point due = base_time + std::chrono::milliseconds(header.timestamp - base_timestamp);
+        while (running_.load() && Clock::now() < due) {
+            std::this_thread::sleep_for(std::min<Clock::duration>(due - Clock::now(), std::chrono::milliseconds(50)));
+        }
+        if (!running_.load()) break;
+
+        DepthColorFrame frame;
+        frame.frame_id = header.frameId;
+        frame.timestamp = header.timestamp;
+        frame.width = header.width;
+        frame.height = header.height;
+        frame.depth = depth.data();
+        frame.rgb = rgb.data();
+        callback_(frame);
+        ++frames;
+    }
+}
+
+// QueueSource ----------------------------------------------------------------
+
+QueueSource::QueueSource(std::string pipeline) : pipeline_(std::move(pipeline)) {}
+
+QueueSource::~QueueSource() {
+    stop();
+    if (queue_ != -1) mq_close(queue_);
+}
+
+bool QueueSource::open() {
+    // The logging module creates the queue; a missing queue means the pipeline is not running.
+    PipelineQueueNames queues;
+    makePipelineQueueNames(&queues, pipeline_.c_str());
+    if (queue_ != -1) mq_close(queue_);
+    queue_ = mq_open(queues.loggerToViewer, O_RDONLY);
+    if (queue_ == -1) {
+        std::fprintf(stderr, "[QueueSource] mq_open %s: %s (is the pipeline running?)\n", queues.loggerToViewer,
+                     std::strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+void QueueSource::loop() {
+    std::vector<char> message(MAX_MSG_SIZE);
+    std::vector<uint16_t> depth;
+    std::vector<uint8_t> rgb;
+    const std::size_t max_payload = MAX_MSG_SIZE - sizeof(MessageHeader);
+
+    DepthColorFrame frame;
+    int depth_received = 0, depth_total = 0;
+    int color_received = 0, color_total = 0;
+    bool assembling = false;
+
+    while (running_.load()) {
+        // Short timeout so stop() is honoured while the pipeline is idle.
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += 100 * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec += 1;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        const ssize_t bytes = mq_timedreceive(queue_, message.data(), message.size(), nullptr, &deadline);
+        if (bytes < static_cast<ssize_t>(sizeof(MessageHeader))) continue;
+
+        const auto* header = reinterpret_cast<const MessageHeader*>(message.data());
+        const char* payload = message.data() + sizeof(MessageHeader);
+
+        if (header->msgType == MSG_TYPE_METADATA) {
+            if (header->width <= 0 || header->height <= 0) continue;
+            const std::size_t pixels = static_cast<std::size_t>(header->width) * header->height;
+            depth.resize(pixels);
+            rgb.resize(pixels * 3);
+            frame.frame_id = header->frameId;
+            frame.timestamp = header->timestamp;
+            frame.width = header->width;
+            frame.height = header->height;
+            depth_received = depth_total = color_received = color_total = 0;
+            assembling = true;
+            continue;
+        }
+
+        if (!assembling || static_cast<uint32_t>(header->frameId) != frame.frame_id || header->dataSize < 0 ||
+            header->chunkIndex < 0 || static_cast<std::size_t>(header->dataSize) > bytes - sizeof(MessageHeader)) {
+            continue;
+        }
+
+        const std::size_t offset = static_cast<std::size_t>(header->chunkIndex) * max_payload;
+        if (header->msgType == MSG_TYPE_DEPTH_DATA) {
+            if (offset + header->dataSize > depth.size() * sizeof(uint16_t)) continue;
+            std::memcpy(reinterpret_cast<char*>(depth.data()) + offset, payload, header->dataSize);
+            ++depth_received;
+            depth_total = header->totalChunks;
+        } else if (header->msgType == MSG_TYPE_COLOR_DATA) {
+            if (offset + header->dataSize > rgb.size()) continue;
+            std::memcpy(rgb.data() + offset, payload, header->dataSize);
+            ++color_received;
+            color_total = header->totalChunks;
+        } else {
+            continue;
+        }
+
+        if (depth_total > 0 && color_total > 0 && depth_received == depth_total && color_received == color_total) {
+            frame.depth = depth.data();
+            frame.rgb = rgb.data();
+            callback_(frame);
+            assembling = false;  // ignore stray chunks until the next metadata message
+        }
+    }
+}
+
+} // namespace Youth
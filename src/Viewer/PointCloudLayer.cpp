@@ -0,0 +1,281 @@
+#include "PointCloudLayer.hpp"
+
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+
+// Camera frame (x right, y down, z forward) to GL (y up, looking down -z).
+static const char* kVert = R"(#version 330 core
+layout(location = 0) in float aX;
+layout(location = 1) in float aY;
+layout(location = 2) in float aZ;
+layout(location = 3) in float aR;
+layout(location = 4) in float aG;
+layout(location = 5) in float aB;
+uniform mat4 uViewProj;
+out vec3 vColor;
+void main() {
+    gl_Position = uViewProj * vec4(aX, -aY, -aZ, 1.0);
+    vColor = vec3(aR, aG, aB);
+}
+)";
+
+static const char* kFrag = R"(#version 330 core
+in vec3 vColor;
+out vec4 FragColor;
+void main() {
+    FragColor = vec4(vColor, 1.0);
+}
+)";
+
+GLuint compile(GLenum type, const char* src) {
+    GLuint s = glCreateShader(type);
+    glShaderSource(s, 1, &src, nullptr);
+    glCompileShader(s);
+    GLint ok = GL_FALSE;
+    glGetShaderiv(s, GL_COMPILE_STATUS, &ok);
+    if (!ok) {
+        GLint len = 0;
+        glGetShaderiv(s, GL_INFO_LOG_LENGTH, &len);
+        std::string log(len, '\0');
+        glGetShaderInfoLog(s, len, nullptr, log.data());
+        glDeleteShader(s);
+        throw std::runtime_error("Point cloud shader compile error: " + log);
+    }
+    return s;
+}
+
+GLuint link(GLuint vs, GLuint fs) {
+    GLuint p = glCreateProgram();
+    glAttachShader(p, vs);
+    glAttachShader(p, fs);
+    glLinkProgram(p);
+    GLint ok = GL_FALSE;
+    glGetProgramiv(p, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        GLint len = 0;
+        glGetProgramiv(p, GL_INFO_LOG_LENGTH, &len);
+        std::string log(len, '\0');
+        glGetProgramInfoLog(p, len, nullptr, log.data());
+        glDeleteProgram(p);
+        throw std::runtime_error("Point cloud program link error: " + log);
+    }
+    return p;
+}
+
+// Grow a point buffer to at least `capacity` points (contents are discarded).
+bool reserve(PointBuffer& buffer, std::size_t capacity) {
+    if (buffer.capacity >= capacity) return true;
+    freePointBuffer(&buffer);
+    return allocPointBuffer(&buffer, capacity) != 0;
+}
+
+// llvmpipe renders ~2.5M points/s per core; keep a frame well under 33 ms.
+constexpr std::size_t kSoftwarePointBudget = 80000;
+
+bool isSoftwareRenderer() {
+    const char* renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+    if (!renderer) return false;
+    const std::string name(renderer);
+    return name.find("llvmpipe") != std::string::npos || name.find("softpipe") != std::string::npos ||
+           name.find("SWR") != std::string::npos;
+}
+
+} // namespace
+
+namespace Youth {
+
+PointCloudLayer::PointCloudLayer() {
+    setDefaultCameraIntrinsics(&intrinsics_, 640, 480);
+    if (isSoftwareRenderer()) {
+        options_.max_points = kSoftwarePointBudget;
+        std::fprintf(stdout, "[PointCloudLayer] Software renderer, point budget %zu\n", options_.max_points);
+    }
+
+    GLuint vs = 0, fs = 0;
+    try {
+        vs = compile(GL_VERTEX_SHADER, kVert);
+        fs = compile(GL_FRAGMENT_SHADER, kFrag);
+        program_ = link(vs, fs);
+    } catch (...) {
+        if (vs) glDeleteShader(vs);
+        if (fs) glDeleteShader(fs);
+        throw;
+    }
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+    view_proj_loc_ = glGetUniformLocation(program_, "uViewProj");
+
+    glGenVertexArrays(1, &vao_);
+    glGenBuffers(1, &vbo_);
+    glBindVertexArray(vao_);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+    for (GLuint i = 0; i < 6; ++i) glEnableVertexAttribArray(i);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+PointCloudLayer::~PointCloudLayer() {
+    if (program_) glDeleteProgram(program_);
+    if (vbo_) glDeleteBuffers(1, &vbo_);
+    if (vao_) glDeleteVertexArrays(1, &vao_);
+    destroyRayTable(&rays_);
+    freePointBuffer(&back_);
+    freePointBuffer(&pending_);
+    freePointBuffer(&front_);
+}
+
+void PointCloudLayer::setIntrinsics(const CameraIntrinsics& intrinsics) {
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    intrinsics_ = intrinsics;
+    ++intrinsics_version_;
+}
+
+void PointCloudLayer::setOptions(const Options& options) {
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    options_ = options;
+}
+
+PointCloudLayer::Options PointCloudLayer::options() const {
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    return options_;
+}
+
+void PointCloudLayer::submitFrame(const uint16_t* depth, const uint8_t* rgb, int width, int height) {
+    if (!depth || width <= 0 || height <= 0) return;
+
+    CameraIntrinsics intrinsics;
+    Options options;
+    unsigned version;
+    {
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        intrinsics = intrinsics_;
+        options = options_;
+        version = intrinsics_version_;
+    }
+
+    std::lock_guard<std::mutex> submit(submit_mutex_);
+
+    // Integer-stride decimation to the point budget. Decimated pixel (u, v) samples source
+    // pixel (u * stride, v * stride), so its intrinsics are the full-frame ones divided by
+    // the stride. Rescaling to the decimated size instead would shift the principal point
+    // by the pixel-centre offset and, when the size is not a multiple of the stride, skew
+    // the focal length.
+    scaleCameraIntrinsics(&intrinsics, width, height, &intrinsics);
+    int stride = 1;
+    const std::size_t full_pixels = static_cast<std::size_t>(width) * height;
+    while (options.max_points && full_pixels / (stride * stride) > options.max_points) ++stride;
+    if (stride > 1) {
+        const int dw = width / stride, dh = height / stride;
+        decimated_depth_.resize(static_cast<std::size_t>(dw) * dh);
+        decimated_rgb_.resize(rgb ? decimated_depth_.size() * 3 : 0);
+        for (int v = 0; v < dh; ++v) {
+            const std::size_t src_row = static_cast<std::size_t>(v) * stride * width;
+            for (int u = 0; u < dw; ++u) {
+                const std::size_t src = src_row + static_cast<std::size_t>(u) * stride;
+                const std::size_t dst = static_cast<std::size_t>(v) * dw + u;
+                decimated_depth_[dst] = depth[src];
+                if (rgb) std::memcpy(&decimated_rgb_[dst * 3], rgb + src * 3, 3);
+            }
+        }
+        depth = decimated_depth_.data();
+        rgb = rgb ? decimated_rgb_.data() : nullptr;
+        width = dw;
+        height = dh;
+        intrinsics.fx /= stride;
+        intrinsics.fy /= stride;
+        intrinsics.cx /= stride;
+        intrinsics.cy /= stride;
+        intrinsics.width = dw;
+        intrinsics.height = dh;
+    }
+
+    if (!rays_.rayX || rays_.width != width || rays_.height != height || rays_version_ != version ||
+        rays_stride_ != stride) {
+        destroyRayTable(&rays_);
+        if (!createRayTable(&rays_, &intrinsics, width, height)) {
+            std::fprintf(stderr, "[PointCloudLayer] Failed to create ray table\n");
+            return;
+        }
+        rays_version_ = version;
+        rays_stride_ = stride;
+    }
+
+    std::size_t pixels = static_cast<std::size_t>(width) * height;
+    if (!reserve(back_, pixels)) {
+        std::fprintf(stderr, "[PointCloudLayer] Failed to allocate %zu points\n", pixels);
+        return;
+    }
+
+    unprojectDepth(&rays_, depth, rgb, options.min_depth, options.max_depth,
+                   KERNEL_UNPROJECT_COMPACT | (rgb ? 0 : KERNEL_UNPROJECT_NO_COLOR), &back_);
+    if (!rgb) {
+        std::fill_n(back_.r, back_.count, uint8_t(255));
+        std::fill_n(back_.g, back_.count, uint8_t(255));
+        std::fill_n(back_.b, back_.count, uint8_t(255));
+    }
+
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    std::swap(back_, pending_);
+    pending_new_ = true;
+}
+
+void PointCloudLayer::upload(const PointBuffer& points) {
+    const std::size_t n = points.count;
+    const std::size_t bytes = n * (3 * sizeof(float) + 3);
+
+    glBindVertexArray(vao_);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+    if (bytes > gpu_capacity_) gpu_capacity_ = bytes + bytes / 4;
+    // Orphan so the driver does not stall on the previous frame's draw.
+    glBufferData(GL_ARRAY_BUFFER, gpu_capacity_, nullptr, GL_STREAM_DRAW);
+
+    // Structure-of-arrays layout: [x..][y..][z..][r..][g..][b..]
+    const void* sections[6] = {points.x, points.y, points.z, points.r, points.g, points.b};
+    std::size_t offset = 0;
+    for (GLuint i = 0; i < 6; ++i) {
+        const bool is_float = i < 3;
+        const std::size_t size = n * (is_float ? sizeof(float) : 1);
+        if (size) glBufferSubData(GL_ARRAY_BUFFER, offset, size, sections[i]);
+        glVertexAttribPointer(i, 1, is_float ? GL_FLOAT : GL_UNSIGNED_BYTE, is_float ? GL_FALSE : GL_TRUE, 0,
+                              reinterpret_cast<void*>(offset));
+        offset += size;
+    }
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    gpu_count_ = n;
+}
+
+void PointCloudLayer::draw(const float* view_proj) {
+    bool fresh = false;
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        if (pending_new_) {
+            std::swap(front_, pending_);
+            pending_new_ = false;
+            fresh = true;
+        }
+    }
+    if (fresh) upload(front_);
+
+    Options options = this->options();
+    if (!options.visible || gpu_count_ == 0) return;
+
+    glUseProgram(program_);
+    glUniformMatrix4fv(view_proj_loc_, 1, GL_FALSE, view_proj);
+    glPointSize(options.point_size);
+    glBindVertexArray(vao_);
+    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(gpu_count_));
+    glBindVertexArray(0);
+    glUseProgram(0);
+}
+
+} // namespace Youth
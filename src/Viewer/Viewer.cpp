@@ -1,9 +1,13 @@
 #include "Viewer.hpp"
+#include "PointCloudLayer.hpp"
+#include "offscreenModule.h"
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 
 #include <array>
+#include <chrono>
+#include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <stdexcept>
@@ -64,6 +68,64 @@ GLuint link(GLuint vs, GLuint fs) {
     return p;
 }
 
+using Mat4 = std::array<float, 16>;  // column-major
+
+Mat4 multiply(const Mat4& a, const Mat4& b) {
+    Mat4 r{};
+    for (int c = 0; c < 4; ++c)
+        for (int row = 0; row < 4; ++row)
+            for (int k = 0; k < 4; ++k)
+                r[c * 4 + row] += a[k * 4 + row] * b[c * 4 + k];
+    return r;
+}
+
+Mat4 identity() {
+    Mat4 m{};
+    m[0] = m[5] = m[10] = m[15] = 1.0f;
+    return m;
+}
+
+Mat4 translation(float x, float y, float z) {
+    Mat4 m = identity();
+    m[12] = x; m[13] = y; m[14] = z;
+    return m;
+}
+
+Mat4 rotationX(float deg) {
+    const float r = deg * 3.14159265f / 180.0f, c = std::cos(r), s = std::sin(r);
+    Mat4 m = identity();
+    m[5] = c; m[6] = s; m[9] = -s; m[10] = c;
+    return m;
+}
+
+Mat4 rotationY(float deg) {
+    const float r = deg * 3.14159265f / 180.0f, c = std::cos(r), s = std::sin(r);
+    Mat4 m = identity();
+    m[0] = c; m[2] = -s; m[8] = s; m[10] = c;
+    return m;
+}
+
+Mat4 perspective(float fov_y_deg, float aspect, float near_z, float far_z) {
+    const float f = 1.0f / std::tan(fov_y_deg * 3.14159265f / 360.0f);
+    Mat4 m{};
+    m[0] = f / aspect;
+    m[5] = f;
+    m[10] = (far_z + near_z) / (near_z - far_z);
+    m[11] = -1.0f;
+    m[14] = 2.0f * far_z * near_z / (near_z - far_z);
+    return m;
+}
+
+double seconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// OffscreenImageCallback -> Viewer::FrameCallback
+void deliverFrame(const uint8_t* rgba, int width, int height, uint32_t frame, void* user_data) {
+    auto* callback = static_cast<Youth::Viewer::FrameCallback*>(user_data);
+    if (*callback) (*callback)(rgba, width, height, frame);
+}
+
 void glfwErrorCallback(int code, const char* desc) {
     std::fprintf(stderr, "[GLFW] Error %d: %s\n", code, desc);
 }
@@ -72,14 +134,25 @@ void glfwErrorCallback(int code, const char* desc) {
 
 namespace Youth {
 
+struct Viewer::Offscreen {
+    OffscreenContext context = {};
+    OffscreenTarget target = {};
+};
+
 Viewer::Viewer(const Config& cfg) : cfg_(cfg) {
-    if (!initGLFW()) return;
-    if (!initGLEW()) return;
+    if (cfg_.offscreen) {
+        if (!initOffscreen()) return;
+    } else {
+        if (!initGLFW()) return;
+        if (!initGLEW()) return;
+    }
 
     std::fprintf(stdout, "GL Vendor  : %s\n", glGetString(GL_VENDOR));
     std::fprintf(stdout, "GL Renderer: %s\n", glGetString(GL_RENDERER));
     std::fprintf(stdout, "GL Version : %s\n", glGetString(GL_VERSION));
 
+    glEnable(GL_DEPTH_TEST);
+
     const std::array<float, 18> verts = {
          0.0f, 0.5f, 0.0f, 1.0f, 0.2f, 0.2f,
         -0.5f,-0.5f, 0.0f, 0.2f, 1.0f, 0.2f,
@@ -116,9 +189,18 @@ Viewer::Viewer(const Config& cfg) : cfg_(cfg) {
 }
 
 Viewer::~Viewer() {
+    if (!ok()) return;
+    finishReadbacks();
+    if (readback_) destroyOffscreenTarget(&readback_->target);
+    layers_.clear();  // GL objects go before the context
     if (shader_prog_) glDeleteProgram(shader_prog_);
     if (vbo_) glDeleteBuffers(1, &vbo_);
     if (vao_) glDeleteVertexArrays(1, &vao_);
+    if (offscreen_) {
+        destroyOffscreenTarget(&offscreen_->target);
+        destroyOffscreenContext(&offscreen_->context);
+        offscreen_.reset();
+    }
     if (window_) {
         glfwDestroyWindow(window_);
         glfwTerminate();
@@ -148,6 +230,32 @@ bool Viewer::initGLFW() {
     }
     glfwMakeContextCurrent(window_);
     glfwSwapInterval(cfg_.vsync ? 1 : 0);
+
+    glfwSetWindowUserPointer(window_, this);
+    glfwSetCursorPosCallback(window_, cursorPosCallback);
+    glfwSetMouseButtonCallback(window_, mouseButtonCallback);
+    glfwSetScrollCallback(window_, scrollCallback);
+    glfwSetFramebufferSizeCallback(window_, [](GLFWwindow* w, int, int) {
+        static_cast<Viewer*>(glfwGetWindowUserPointer(w))->requestRedraw();
+    });
+    glfwSetWindowRefreshCallback(window_, [](GLFWwindow* w) {
+        static_cast<Viewer*>(glfwGetWindowUserPointer(w))->requestRedraw();
+    });
+    return true;
+}
+
+bool Viewer::initOffscreen() {
+    auto offscreen = std::make_unique<Offscreen>();
+    if (!createOffscreenContext(&offscreen->context, 3, 3, OFFSCREEN_PROFILE_CORE)) {
+        std::fprintf(stderr, "[Viewer] Failed to create offscreen context\n");
+        return false;
+    }
+    if (!initGLEW() || !createOffscreenTarget(&offscreen->target, cfg_.width, cfg_.height)) {
+        destroyOffscreenContext(&offscreen->context);
+        return false;
+    }
+    bindOffscreenTarget(&offscreen->target);
+    offscreen_ = std::move(offscreen);
     return true;
 }
 
@@ -155,6 +263,10 @@ bool Viewer::initGLEW() {
     glewExperimental = GL_TRUE;
     GLenum err = glewInit();
     glGetError(); // clear benign error
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+    // EGL contexts have no GLX display; GL entry points are loaded regardless.
+    if (err == GLEW_ERROR_NO_GLX_DISPLAY) err = GLEW_OK;
+#endif
     if (err != GLEW_OK) {
         std::fprintf(stderr, "[Viewer] Failed to init GLEW: %s\n", glewGetErrorString(err));
         return false;
@@ -171,30 +283,178 @@ void Viewer::drawTriangle() {
 }
 
 void Viewer::poll() {
-    glfwPollEvents();
+    if (!window_) return;
     if (glfwGetKey(window_, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
         glfwSetWindowShouldClose(window_, GLFW_TRUE);
     }
 }
 
+PointCloudLayer& Viewer::addPointCloudLayer() {
+    layers_.push_back(std::make_unique<PointCloudLayer>());
+    requestRedraw();
+    return *layers_.back();
+}
+
+void Viewer::requestRedraw() {
+    redraw_requested_.store(true, std::memory_order_release);
+    if (window_) {
+        glfwPostEmptyEvent();
+    } else {
+        std::lock_guard<std::mutex> lock(redraw_mutex_);
+        redraw_cv_.notify_one();
+    }
+}
+
+void Viewer::requestClose() {
+    close_requested_.store(true);
+    requestRedraw();
+}
+
+bool Viewer::shouldClose() {
+    return close_requested_.load() || (window_ && glfwWindowShouldClose(window_));
+}
+
+void Viewer::waitEvents(double timeout) {
+    if (window_) {
+        glfwWaitEventsTimeout(timeout);
+        return;
+    }
+    std::unique_lock<std::mutex> lock(redraw_mutex_);
+    redraw_cv_.wait_for(lock, std::chrono::duration<double>(timeout), [this] {
+        return redraw_requested_.load(std::memory_order_acquire) || close_requested_.load();
+    });
+}
+
+void Viewer::framebufferSize(int& width, int& height) {
+    if (offscreen_) {
+        width = offscreen_->target.width;
+        height = offscreen_->target.height;
+    } else {
+        glfwGetFramebufferSize(window_, &width, &height);
+    }
+}
+
+void Viewer::setFrameCallback(FrameCallback callback) {
+    frame_callback_ = std::move(callback);
+    // Windowed mode reads the back buffer through a ring without an FBO.
+    if (frame_callback_ && !offscreen_ && !readback_ && window_) {
+        auto readback = std::make_unique<Offscreen>();
+        if (createOffscreenTarget(&readback->target, 0, 0)) readback_ = std::move(readback);
+    }
+}
+
+void Viewer::finishReadbacks() {
+    OffscreenTarget* target = offscreen_ ? &offscreen_->target : readback_ ? &readback_->target : nullptr;
+    if (target) collectOffscreenReadbacks(target, 1, deliverFrame, &frame_callback_);
+}
+
+uint32_t Viewer::droppedReadbacks() const noexcept {
+    const Offscreen* ring = offscreen_ ? offscreen_.get() : readback_.get();
+    return ring ? ring->target.dropped : 0;
+}
+
+void Viewer::updateViewProjection(int fbw, int fbh) {
+    const float aspect = fbh > 0 ? static_cast<float>(fbw) / fbh : 1.0f;
+    const Mat4 view = multiply(translation(0.0f, 0.0f, -camera_.distance),
+                               multiply(rotationX(camera_.pitch),
+                                        multiply(rotationY(camera_.yaw), translation(0.0f, 0.0f, camera_.pivot))));
+    view_proj_ = multiply(perspective(camera_.fov_y, aspect, 0.05f, 100.0f), view);
+}
+
+void Viewer::cursorPosCallback(GLFWwindow* window, double x, double y) {
+    auto* self = static_cast<Viewer*>(glfwGetWindowUserPointer(window));
+    if (self->dragging_) {
+        self->camera_.yaw += static_cast<float>(x - self->last_x_) * 0.25f;
+        self->camera_.pitch += static_cast<float>(y - self->last_y_) * 0.25f;
+        self->requestRedraw();
+    }
+    self->last_x_ = x;
+    self->last_y_ = y;
+}
+
+void Viewer::mouseButtonCallback(GLFWwindow* window, int button, int action, int) {
+    auto* self = static_cast<Viewer*>(glfwGetWindowUserPointer(window));
+    if (button == GLFW_MOUSE_BUTTON_LEFT) {
+        self->dragging_ = action == GLFW_PRESS;
+        glfwGetCursorPos(window, &self->last_x_, &self->last_y_);
+    }
+}
+
+void Viewer::scrollCallback(GLFWwindow* window, double, double dy) {
+    auto* self = static_cast<Viewer*>(glfwGetWindowUserPointer(window));
+    self->camera_.distance *= dy > 0 ? 0.9f : 1.1f;
+    self->requestRedraw();
+}
+
+void Viewer::renderFrame() {
+    int fbw = 0, fbh = 0;
+    framebufferSize(fbw, fbh);
+    glViewport(0, 0, fbw, fbh);
+    updateViewProjection(fbw, fbh);
+
+    glClearColor(cfg_.clear.r, cfg_.clear.g, cfg_.clear.b, cfg_.clear.a);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    for (auto& layer : layers_) {
+        layer->draw(view_proj_.data());
+    }
+
+    if (draw_callback_) {
+        draw_callback_();
+    } else if (layers_.empty()) {
+        drawTriangle();
+    }
+
+    // Start this frame's readback and hand over whichever earlier ones have completed.
+    OffscreenTarget* target = offscreen_ ? &offscreen_->target : readback_ ? &readback_->target : nullptr;
+    if (target && frame_callback_) {
+        queueOffscreenReadback(target, fbw, fbh, frame_index_);
+        collectOffscreenReadbacks(target, 0, deliverFrame, &frame_callback_);
+    }
+    ++frame_index_;
+
+    if (window_) {
+        glfwSwapBuffers(window_);
+    } else {
+        glFlush();
+    }
+}
+
 void Viewer::run() {
-    while (!glfwWindowShouldClose(window_)) {
-        int fbw = 0, fbh = 0;
-        glfwGetFramebufferSize(window_, &fbw, &fbh);
-        glViewport(0, 0, fbw, fbh);
-
-        glClearColor(cfg_.clear.r, cfg_.clear.g, cfg_.clear.b, cfg_.clear.a);
-        glClear(GL_COLOR_BUFFER_BIT);
-
-        if (draw_callback_) {
-            draw_callback_();
-        } else {
-            drawTriangle();
+    double stats_start = seconds();
+    double draw_seconds = 0.0;
+    int frames = 0;
+
+    while (!shouldClose()) {
+        // Sleep until new data or input arrives; resize/expose events also land here.
+        if (cfg_.redraw_on_demand && !redraw_requested_.exchange(false, std::memory_order_acq_rel)) {
+            if (offscreen_ && offscreen_->target.pending > 0) {
+                collectOffscreenReadbacks(&offscreen_->target, 0, deliverFrame, &frame_callback_);
+                waitEvents(0.005);
+            } else {
+                waitEvents(0.5);
+            }
+            poll();
+            continue;
         }
 
-        glfwSwapBuffers(window_);
+        const double draw_start = seconds();
+        renderFrame();
+        draw_seconds += seconds() - draw_start;
+
+        if (++frames == 300) {
+            const double now = seconds();
+            std::fprintf(stdout, "[Viewer] %.1f fps, %.2f ms/frame draw\n", frames / (now - stats_start),
+                         draw_seconds * 1000.0 / frames);
+            stats_start = now;
+            draw_seconds = 0.0;
+            frames = 0;
+        }
+
+        if (window_) glfwPollEvents();
         poll();
     }
+    finishReadbacks();
 }
 
-} // namespace Youth
\ No newline at end of file
+} // namespace Youth
@@ -1,23 +1,109 @@
 #include "Viewer.hpp"
+#include "PointCloudLayer.hpp"
+#include "FrameSource.hpp"
+#include "offscreenModule.h"
+
+#include <chrono>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <string>
+
+namespace {
+
+void usage(const char* argv0) {
+    std::cerr << "Usage: " << argv0
+              << " [--live | --play <recording.bin>] [--once] [--pipeline <name>] [--config <camera.yaml>]"
+                 " [--offscreen <image.ppm>]\n"
+              << "  --live    render the logger -> viewer queue of a running pipeline (default)\n"
+              << "  --pipeline  pipeline name given to Youth.Source --pipeline (selects the queue for --live)\n"
+              << "  --play    play back a LoggingModule recording\n"
+              << "  --once    stop at the end of the recording instead of looping\n"
+              << "  --config  ORB-SLAM3 camera settings for the intrinsics\n"
+              << "  --offscreen  render without a display, writing the latest frame once per second\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv){
+    std::string recording;
+    std::string pipeline;
+    std::string camera_config = "config/astra_orb_slam3_rgbd.yaml";
+    bool loop_playback = true;
+    std::string snapshot;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--live")) {
+            recording.clear();
+        } else if (!std::strcmp(argv[i], "--play") && i + 1 < argc) {
+            recording = argv[++i];
+        } else if (!std::strcmp(argv[i], "--pipeline") && i + 1 < argc) {
+            pipeline = argv[++i];
+        } else if (!std::strcmp(argv[i], "--once")) {
+            loop_playback = false;
+        } else if (!std::strcmp(argv[i], "--config") && i + 1 < argc) {
+            camera_config = argv[++i];
+        } else if (!std::strcmp(argv[i], "--offscreen") && i + 1 < argc) {
+            snapshot = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
 
-int main(){
     try {
         Youth::Viewer::Config config;
         config.width = 1280;
         config.height = 720;
         config.title = "Youth Viewer";
         config.vsync = true;
+        config.offscreen = !snapshot.empty();
 
         Youth::Viewer viewer(config);
         if(!viewer.ok()) {
             std::cerr << "Failed to create viewer.\n";
             return 1;
         }
+
+        CameraIntrinsics intrinsics;
+        setDefaultCameraIntrinsics(&intrinsics, 640, 480);
+        if (!loadCameraIntrinsics(camera_config.c_str(), &intrinsics)) {
+            std::cerr << "Using default intrinsics (" << camera_config << " not readable)\n";
+        }
+
+        Youth::PointCloudLayer& cloud = viewer.addPointCloudLayer();
+        cloud.setIntrinsics(intrinsics);
+
+        if (!snapshot.empty()) {
+            auto last_write = std::chrono::steady_clock::time_point{};
+            viewer.setFrameCallback([&, last_write](const uint8_t* rgba, int w, int h, uint32_t) mutable {
+                const auto now = std::chrono::steady_clock::now();
+                if (now - last_write < std::chrono::seconds(1)) return;
+                last_write = now;
+                writeOffscreenImagePPM(snapshot.c_str(), rgba, w, h);
+            });
+        }
+
+        std::unique_ptr<Youth::FrameSource> source;
+        if (recording.empty()) {
+            source = std::make_unique<Youth::QueueSource>(pipeline);
+        } else {
+            source = std::make_unique<Youth::RecordingSource>(recording, loop_playback);
+        }
+
+        // Unprojection runs on the source thread; the render loop only uploads and draws.
+        if (!source->start([&](const Youth::DepthColorFrame& frame) {
+                cloud.submitFrame(frame.depth, frame.rgb, frame.width, frame.height);
+                viewer.requestRedraw();
+            })) {
+            return 1;
+        }
+
         viewer.run();
+        source->stop();
     }catch (const std::exception& e) {
         std::cerr << "Fatal: " << e.what() << '\n';
         return 2;
     }
     return 0;
-}
\ No newline at end of file
+}